@@ -7,14 +7,18 @@
 #include <fcntl.h>
 #include <grp.h>
 #include <limits.h>
+#include <linux/futex.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/eventfd.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
 #include <sys/types.h>
+#include <time.h>
 #include <unistd.h>
 
 #ifndef SOUND_GROUP_NAME
@@ -26,6 +30,47 @@
 #define DEFAULT_BUFFER_FRAMES 4096U
 #define DEFAULT_FORMAT SND_PCM_FORMAT_S16_LE
 
+#define SR_RING_MAGIC 0x47525253U /* "SRRG" */
+#define SR_RING_VERSION 1U
+/* Ring holds this many ALSA buffers so a briefly descheduled engine doesn't drop audio. */
+#define SR_RING_BUFFERS 4U
+/* Stop writing to the ring once the engine has been quiet for this long. */
+#define SR_RING_READER_TIMEOUT_NS 1000000000ULL
+
+/*
+ * Shared ring published next to each playback FIFO as "<dir>/.<fifo name>.ring".
+ * Must stay identical to ScreamrouterShmRingHeader in
+ * src/audio_engine/receivers/system/screamrouter_shm_ring.h.
+ */
+struct sr_ring_header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t data_offset;
+    uint32_t frame_bytes;
+    uint32_t capacity_frames;
+    uint32_t rate;
+    uint32_t channels;
+    uint32_t bit_depth;
+    uint8_t reserved0[32];
+
+    /* Written by the plugin. */
+    uint64_t write_frames;
+    uint64_t write_time_ns;
+    uint32_t doorbell;
+    uint32_t writer_pid;
+    uint64_t dropped_frames;
+    uint8_t reserved1[32];
+
+    /* Written by the engine. */
+    uint64_t read_frames;
+    uint64_t reader_heartbeat_ns;
+    uint32_t reader_waiting;
+    uint32_t reader_pid;
+    uint8_t reserved2[40];
+};
+
+_Static_assert(sizeof(struct sr_ring_header) == 192, "ring header layout is shared with the engine");
+
 struct sr_runtime {
     snd_pcm_ioplug_t io;
     char name[64];
@@ -37,6 +82,11 @@ struct sr_runtime {
     int fifo_fd;
     int poll_fd;
     snd_pcm_uframes_t hw_ptr;
+    char ring_path[PATH_MAX];
+    struct sr_ring_header *ring;
+    size_t ring_size;
+    uint8_t capture_carry[256];
+    size_t capture_carry_len;
 };
 
 struct snd_dlsym_link *snd_dlsym_start __attribute__((visibility("default"))) = NULL;
@@ -246,6 +296,140 @@ static int sr_fifo_open(struct sr_runtime *rt, snd_pcm_stream_t stream)
     return 0;
 }
 
+static uint64_t monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void ring_path_for(const char *fifo_path, char *out, size_t out_size)
+{
+    const char *slash = strrchr(fifo_path, '/');
+    if (slash)
+        snprintf(out, out_size, "%.*s/.%s.ring", (int)(slash - fifo_path), fifo_path, slash + 1);
+    else
+        snprintf(out, out_size, ".%s.ring", fifo_path);
+}
+
+/*
+ * Creates the shared ring under a temporary name and renames it into place, so the engine
+ * never maps a half-initialised header and a reopened stream replaces (not reuses) the inode
+ * an old reader may still hold.
+ */
+static int sr_ring_create(struct sr_runtime *rt, size_t frame_bytes)
+{
+    char tmp_path[PATH_MAX + 8];
+    ring_path_for(rt->fifo_path, rt->ring_path, sizeof(rt->ring_path));
+    snprintf(tmp_path, sizeof(tmp_path), "%s.new", rt->ring_path);
+
+    uint32_t capacity = (uint32_t)(rt->buffer_frames * SR_RING_BUFFERS);
+    size_t size = sizeof(struct sr_ring_header) + (size_t)capacity * frame_bytes;
+
+    int fd = open(tmp_path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0660);
+    if (fd < 0)
+        return -errno;
+    if (ftruncate(fd, (off_t)size) < 0) {
+        int err = -errno;
+        close(fd);
+        unlink(tmp_path);
+        return err;
+    }
+    void *mapped = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        int err = -errno;
+        unlink(tmp_path);
+        return err;
+    }
+
+    struct sr_ring_header *h = mapped;
+    h->magic = SR_RING_MAGIC;
+    h->version = SR_RING_VERSION;
+    h->data_offset = sizeof(*h);
+    h->frame_bytes = (uint32_t)frame_bytes;
+    h->capacity_frames = capacity;
+    h->rate = rt->rate;
+    h->channels = rt->channels;
+    h->bit_depth = (uint32_t)snd_pcm_format_physical_width(rt->format);
+    h->writer_pid = (uint32_t)getpid();
+
+    maybe_assign_group(tmp_path);
+    if (rename(tmp_path, rt->ring_path) < 0) {
+        int err = -errno;
+        munmap(mapped, size);
+        unlink(tmp_path);
+        return err;
+    }
+
+    rt->ring = h;
+    rt->ring_size = size;
+    return 0;
+}
+
+static void sr_ring_destroy(struct sr_runtime *rt)
+{
+    if (!rt->ring)
+        return;
+    munmap(rt->ring, rt->ring_size);
+    rt->ring = NULL;
+    unlink(rt->ring_path);
+}
+
+static bool sr_ring_reader_live(const struct sr_runtime *rt)
+{
+    if (!rt->ring)
+        return false;
+    uint64_t heartbeat = __atomic_load_n(&rt->ring->reader_heartbeat_ns, __ATOMIC_ACQUIRE);
+    if (!heartbeat)
+        return false;
+    uint64_t now = monotonic_ns();
+    return now < heartbeat || now - heartbeat < SR_RING_READER_TIMEOUT_NS;
+}
+
+static snd_pcm_uframes_t sr_ring_queued(const struct sr_runtime *rt)
+{
+    uint64_t written = __atomic_load_n(&rt->ring->write_frames, __ATOMIC_ACQUIRE);
+    uint64_t read = __atomic_load_n(&rt->ring->read_frames, __ATOMIC_ACQUIRE);
+    return written > read ? (snd_pcm_uframes_t)(written - read) : 0;
+}
+
+/*
+ * Copies frames into the ring and rings the doorbell. Frames that don't fit are dropped
+ * and added to dropped_frames so the engine can report the overrun.
+ */
+static snd_pcm_uframes_t sr_ring_write(struct sr_runtime *rt, const uint8_t *src, snd_pcm_uframes_t frames)
+{
+    struct sr_ring_header *h = rt->ring;
+    uint8_t *data = (uint8_t *)h + h->data_offset;
+    uint64_t written = h->write_frames;
+    snd_pcm_uframes_t space = h->capacity_frames - sr_ring_queued(rt);
+    snd_pcm_uframes_t count = frames < space ? frames : space;
+    if (count < frames)
+        __atomic_add_fetch(&h->dropped_frames, (uint64_t)(frames - count), __ATOMIC_RELAXED);
+    if (!count)
+        return 0;
+
+    snd_pcm_uframes_t done = 0;
+    while (done < count) {
+        uint32_t index = (uint32_t)((written + done) % h->capacity_frames);
+        snd_pcm_uframes_t chunk = h->capacity_frames - index;
+        if (chunk > count - done)
+            chunk = count - done;
+        memcpy(data + (size_t)index * h->frame_bytes, src + (size_t)done * h->frame_bytes,
+               (size_t)chunk * h->frame_bytes);
+        done += chunk;
+    }
+
+    __atomic_store_n(&h->write_time_ns, monotonic_ns(), __ATOMIC_RELEASE);
+    /* Pairs with the engine setting reader_waiting and then re-checking write_frames. */
+    __atomic_store_n(&h->write_frames, written + count, __ATOMIC_SEQ_CST);
+    __atomic_add_fetch(&h->doorbell, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&h->reader_waiting, __ATOMIC_SEQ_CST))
+        syscall(SYS_futex, &h->doorbell, FUTEX_WAKE, 1, NULL, NULL, 0);
+    return count;
+}
+
 static int sr_runtime_close(snd_pcm_ioplug_t *io)
 {
     struct sr_runtime *rt = io->private_data;
@@ -256,6 +440,7 @@ static int sr_runtime_close(snd_pcm_ioplug_t *io)
         close(rt->fifo_fd);
     if (rt->poll_fd >= 0 && rt->poll_fd != rt->fifo_fd)
         close(rt->poll_fd);
+    sr_ring_destroy(rt);
     unlink(rt->fifo_path);
 
     free(rt);
@@ -280,6 +465,28 @@ static snd_pcm_sframes_t sr_runtime_pointer(snd_pcm_ioplug_t *io)
     return rt->hw_ptr % io->buffer_size;
 }
 
+/*
+ * Playback frames are accepted immediately, so the ALSA buffer itself is never the
+ * latency; report what is still queued in the shared ring for the engine instead.
+ */
+static int sr_runtime_delay(snd_pcm_ioplug_t *io, snd_pcm_sframes_t *delayp)
+{
+    struct sr_runtime *rt = io->private_data;
+    snd_pcm_sframes_t delay = 0;
+
+    if (io->stream == SND_PCM_STREAM_PLAYBACK) {
+        if (io->appl_ptr > io->hw_ptr)
+            delay = (snd_pcm_sframes_t)(io->appl_ptr - io->hw_ptr);
+        if (sr_ring_reader_live(rt))
+            delay += (snd_pcm_sframes_t)sr_ring_queued(rt);
+    } else if (io->hw_ptr > io->appl_ptr) {
+        delay = (snd_pcm_sframes_t)(io->hw_ptr - io->appl_ptr);
+    }
+
+    *delayp = delay;
+    return 0;
+}
+
 static snd_pcm_sframes_t sr_runtime_transfer(snd_pcm_ioplug_t *io,
                                              const snd_pcm_channel_area_t *areas,
                                              snd_pcm_uframes_t offset,
@@ -291,6 +498,13 @@ static snd_pcm_sframes_t sr_runtime_transfer(snd_pcm_ioplug_t *io,
     if (frame_bytes == 0)
         return -EINVAL;
 
+    if (io->stream == SND_PCM_STREAM_PLAYBACK && sr_ring_reader_live(rt)) {
+        const uint8_t *src = (const uint8_t *)areas[0].addr + offset * frame_bytes;
+        sr_ring_write(rt, src, frames);
+        rt->hw_ptr = (rt->hw_ptr + frames) % io->buffer_size;
+        return frames;
+    }
+
     if (io->stream == SND_PCM_STREAM_PLAYBACK) {
         for (snd_pcm_uframes_t f = 0; f < frames; ++f) {
             if (rt->fifo_fd < 0)
@@ -308,24 +522,37 @@ static snd_pcm_sframes_t sr_runtime_transfer(snd_pcm_ioplug_t *io,
         return frames;
     }
 
-    uint8_t *tmp = alloca(frame_bytes);
-    for (snd_pcm_uframes_t f = 0; f < frames; ++f) {
-        if (rt->fifo_fd < 0) {
-            if (sr_fifo_open(rt, io->stream) < 0)
-                rt->fifo_fd = -1;
-        }
-        ssize_t r = rt->fifo_fd >= 0 ? read(rt->fifo_fd, tmp, frame_bytes) : 0;
-        uint8_t *dst = (uint8_t *)areas[0].addr + (offset + f) * frame_bytes;
-        if (r <= 0) {
-            memset(dst, 0, frame_bytes);
-            if (r < 0 && (errno == EPIPE || errno == ENXIO))
-                sr_fifo_open(rt, io->stream);
-        } else if ((size_t)r < frame_bytes) {
-            memset(dst, 0, frame_bytes);
-        } else {
-            memcpy(dst, tmp, frame_bytes);
-        }
+    /*
+     * Capture: one read() for the whole request instead of one per frame. A frame split
+     * across reads is carried into the next transfer; whatever is missing plays as silence.
+     */
+    uint8_t *dst = (uint8_t *)areas[0].addr + offset * frame_bytes;
+    size_t want = (size_t)frames * frame_bytes;
+    size_t have = 0;
+    if (rt->capture_carry_len) {
+        memcpy(dst, rt->capture_carry, rt->capture_carry_len);
+        have = rt->capture_carry_len;
+        rt->capture_carry_len = 0;
     }
+
+    if (rt->fifo_fd < 0) {
+        if (sr_fifo_open(rt, io->stream) < 0)
+            rt->fifo_fd = -1;
+    }
+    if (rt->fifo_fd >= 0 && have < want) {
+        ssize_t r = read(rt->fifo_fd, dst + have, want - have);
+        if (r > 0)
+            have += (size_t)r;
+        else if (r < 0 && (errno == EPIPE || errno == ENXIO))
+            sr_fifo_open(rt, io->stream);
+    }
+
+    size_t whole = have - have % frame_bytes;
+    if (have > whole && have - whole <= sizeof(rt->capture_carry)) {
+        memcpy(rt->capture_carry, dst + whole, have - whole);
+        rt->capture_carry_len = have - whole;
+    }
+    memset(dst + whole, 0, want - whole);
     rt->hw_ptr = (rt->hw_ptr + frames) % io->buffer_size;
     return frames;
 }
@@ -336,6 +563,7 @@ static const snd_pcm_ioplug_callback_t sr_callbacks = {
     .stop = sr_runtime_stop,
     .pointer = sr_runtime_pointer,
     .transfer = sr_runtime_transfer,
+    .delay = sr_runtime_delay,
 };
 
 static int screamrouter_pcm_open(snd_pcm_t **pcmp, const char *name,
@@ -415,6 +643,13 @@ static int screamrouter_pcm_open(snd_pcm_t **pcmp, const char *name,
         return fifo_status;
     }
 
+    /* Best effort: without a ring the engine keeps reading the FIFO. */
+    if (stream == SND_PCM_STREAM_PLAYBACK) {
+        size_t ring_frame_bytes = (snd_pcm_format_physical_width(rt->format) / 8) * rt->channels;
+        if (ring_frame_bytes)
+            sr_ring_create(rt, ring_frame_bytes);
+    }
+
     snd_pcm_ioplug_t *io = &rt->io;
     memset(io, 0, sizeof(*io));
     io->version = SND_PCM_IOPLUG_VERSION;
@@ -345,6 +345,8 @@ export interface MixerTuning {
 export interface SourceProcessorTuning {
   command_loop_sleep_ms: number;
   discontinuity_threshold_ms: number;
+  silence_gate_enabled: boolean;
+  silence_gate_tail_ms: number;
 }
 
 export interface ProcessorTuning {
@@ -372,6 +374,9 @@ export interface SystemAudioTuning {
   alsa_latency_reconfig_cooldown_ms: number;
   alsa_latency_xrun_boost_ms: number;
   alsa_latency_low_step_ms: number;
+  alsa_mmap_enabled: boolean;
+  alsa_timer_scheduling_enabled: boolean;
+  alsa_timer_target_fill_ms: number;
 }
 
 export interface RtpReceiverTuning {
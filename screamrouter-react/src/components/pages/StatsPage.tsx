@@ -612,6 +612,8 @@ const StatsPage: React.FC = () => {
                   <SimpleGrid columns={{ base: 1, md: 3 }} spacing={4}>
                     {renderTuningControl('source_processor_tuning', 'command_loop_sleep_ms', 'Command Loop Sleep (ms)')}
                     {renderTuningControl('source_processor_tuning', 'discontinuity_threshold_ms', 'Discontinuity Threshold (ms)')}
+                    {renderTuningControl('source_processor_tuning', 'silence_gate_enabled', 'Skip DSP on Digital Silence', 1, true)}
+                    {renderTuningControl('source_processor_tuning', 'silence_gate_tail_ms', 'Silence Gate Tail (ms)')}
                   </SimpleGrid>
                 </Box>
 
@@ -645,6 +647,9 @@ const StatsPage: React.FC = () => {
                     {renderTuningControl('system_audio_tuning', 'alsa_latency_reconfig_cooldown_ms', 'Reconfigure Cooldown (ms)', 10)}
                     {renderTuningControl('system_audio_tuning', 'alsa_latency_xrun_boost_ms', 'X-run Boost (ms)', 0.5)}
                     {renderTuningControl('system_audio_tuning', 'alsa_latency_low_step_ms', 'Low Buffer Step (ms)', 0.5)}
+                    {renderTuningControl('system_audio_tuning', 'alsa_mmap_enabled', 'Use mmap Access', 1, true)}
+                    {renderTuningControl('system_audio_tuning', 'alsa_timer_scheduling_enabled', 'Device-Clocked Mixing', 1, true)}
+                    {renderTuningControl('system_audio_tuning', 'alsa_timer_target_fill_ms', 'Device-Clocked Target Fill (ms)', 0.5)}
                   </SimpleGrid>
                 </Box>
 
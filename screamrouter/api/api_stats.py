@@ -12,6 +12,12 @@ def buffer_to_dict(buf):
         "pop_rate_per_second": getattr(buf, "pop_rate_per_second", 0.0),
     }
 
+def resampler_quality_name(quality):
+    """Returns the lowercase tier name of a ResamplerQuality enum value."""
+    if quality is None:
+        return "sinc_medium"
+    return getattr(quality, "name", str(quality)).lower()
+
 def stats_to_dict(stats):
     """Converts the AudioEngineStats pybind11 object to a dictionary."""
     
@@ -67,6 +73,12 @@ def stats_to_dict(stats):
                 "discarded_packets": getattr(source_stat, "discarded_packets", 0),
                 "avg_processing_ms": getattr(source_stat, "avg_processing_ms", 0.0),
                 "peak_process_buffer_samples": getattr(source_stat, "peak_process_buffer_samples", 0),
+                "resampler_quality": resampler_quality_name(getattr(source_stat, "resampler_quality", None)),
+                "resampler_cpu_ms": getattr(source_stat, "resampler_cpu_ms", 0.0),
+                "resampler_cpu_percent": getattr(source_stat, "resampler_cpu_percent", 0.0),
+                "silent_chunks_gated": getattr(source_stat, "silent_chunks_gated", 0),
+                "silence_cpu_saved_ms": getattr(source_stat, "silence_cpu_saved_ms", 0.0),
+                "silence_cpu_saved_percent": getattr(source_stat, "silence_cpu_saved_percent", 0.0),
             })
 
     def sink_input_to_dict(lane):
@@ -110,6 +122,11 @@ def stats_to_dict(stats):
                 "avg_chunk_dwell_ms": getattr(sink_stat, "avg_chunk_dwell_ms", 0.0),
                 "last_send_gap_ms": getattr(sink_stat, "last_send_gap_ms", 0.0),
                 "avg_send_gap_ms": getattr(sink_stat, "avg_send_gap_ms", 0.0),
+                "resampler_quality": resampler_quality_name(getattr(sink_stat, "resampler_quality", None)),
+                "resampler_cpu_ms": getattr(sink_stat, "resampler_cpu_ms", 0.0),
+                "resampler_cpu_percent": getattr(sink_stat, "resampler_cpu_percent", 0.0),
+                "silent_inputs_skipped": getattr(sink_stat, "silent_inputs_skipped", 0),
+                "mix_group_leader": getattr(sink_stat, "mix_group_leader", ""),
                 "inputs": [sink_input_to_dict(l) for l in getattr(sink_stat, "inputs", [])],
                 "webrtc_listeners": webrtc_listeners_list
             })
@@ -147,6 +164,8 @@ def settings_to_dict(settings: AudioEngineSettings):
         "source_processor_tuning": {
             "command_loop_sleep_ms": settings.source_processor_tuning.command_loop_sleep_ms,
             "discontinuity_threshold_ms": settings.source_processor_tuning.discontinuity_threshold_ms,
+            "silence_gate_enabled": settings.source_processor_tuning.silence_gate_enabled,
+            "silence_gate_tail_ms": settings.source_processor_tuning.silence_gate_tail_ms,
         },
         "processor_tuning": {
             "oversampling_factor": settings.processor_tuning.oversampling_factor,
@@ -185,6 +204,9 @@ def settings_to_dict(settings: AudioEngineSettings):
             "alsa_latency_reconfig_cooldown_ms": settings.system_audio_tuning.alsa_latency_reconfig_cooldown_ms,
             "alsa_latency_xrun_boost_ms": settings.system_audio_tuning.alsa_latency_xrun_boost_ms,
             "alsa_latency_low_step_ms": settings.system_audio_tuning.alsa_latency_low_step_ms,
+            "alsa_mmap_enabled": settings.system_audio_tuning.alsa_mmap_enabled,
+            "alsa_timer_scheduling_enabled": settings.system_audio_tuning.alsa_timer_scheduling_enabled,
+            "alsa_timer_target_fill_ms": settings.system_audio_tuning.alsa_timer_target_fill_ms,
         }
     }
 
@@ -1,6 +1,7 @@
 """API endpoints for exporting raw PCM from the timeshift buffer."""
 from __future__ import annotations
 
+import asyncio
 import re
 import time
 
@@ -38,13 +39,29 @@ class APITimeshift:
             le=600.0,
             description="How far back in seconds to export from the timeshift buffer.",
         ),
+        end_seconds_ago: float = Query(
+            default=0.0,
+            ge=0.0,
+            le=600.0,
+            description="End of the exported window in seconds before now (0 = up to now).",
+        ),
+        float32: bool = Query(
+            default=False,
+            description="Convert samples to little-endian float32 in [-1, 1].",
+        ),
     ) -> Response:
         """Return a binary PCM dump for the requested source."""
         audio_manager = self._configuration_manager.cpp_audio_manager
         if not audio_manager:
             raise HTTPException(status_code=503, detail="C++ audio manager not available")
+        if end_seconds_ago >= lookback_seconds:
+            raise HTTPException(status_code=400, detail="end_seconds_ago must be smaller than lookback_seconds")
+
+        def _export(tag: str):
+            # The engine releases the GIL while it assembles the window; run it off the event loop.
+            return audio_manager.export_timeshift_buffer(tag, lookback_seconds, end_seconds_ago, float32)
 
-        export = audio_manager.export_timeshift_buffer(source_tag, lookback_seconds)
+        export = await asyncio.to_thread(_export, source_tag)
 
         if not export:
 
@@ -55,7 +72,7 @@ class APITimeshift:
                     source_tag,
                     resolved_tag,
                 )
-                export = audio_manager.export_timeshift_buffer(resolved_tag, lookback_seconds)
+                export = await asyncio.to_thread(_export, resolved_tag)
 
         if not export:
             logger.debug(
@@ -68,8 +85,9 @@ class APITimeshift:
                 detail="No PCM data found for the requested source/tag",
             )
 
-        pcm_bytes: bytes = export.pcm_data
-        if not pcm_bytes:
+        # Zero-copy view of the engine's buffer; it keeps the export object alive.
+        pcm_view = memoryview(export).cast("B")
+        if not pcm_view.nbytes:
             raise HTTPException(
                 status_code=404,
                 detail="No PCM data found for the requested source/tag",
@@ -79,6 +97,7 @@ class APITimeshift:
             "X-Audio-Sample-Rate": str(export.sample_rate),
             "X-Audio-Channels": str(export.channels),
             "X-Audio-Bit-Depth": str(export.bit_depth),
+            "X-Audio-Sample-Format": "f32le" if export.float32 else f"s{export.bit_depth}le",
             "X-Audio-Duration-Seconds": f"{export.duration_seconds:.6f}",
             "X-Audio-Earliest-Packet-Age-Seconds": f"{export.earliest_packet_age_seconds:.6f}",
             "X-Audio-Latest-Packet-Age-Seconds": f"{export.latest_packet_age_seconds:.6f}",
@@ -92,7 +111,7 @@ class APITimeshift:
         )
 
         return Response(
-            content=pcm_bytes,
+            content=pcm_view,
             media_type="application/octet-stream",
             headers=headers,
         )
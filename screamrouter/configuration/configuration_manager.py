@@ -95,6 +95,15 @@ except ImportError as e:
     screamrouter_audio_engine = None
 # --- End C++ Engine Import ---
 
+
+def _resolve_resampler_quality(name: Optional[str]):
+    """Maps a SinkDescription resampler_quality string onto the C++ ResamplerQuality enum."""
+    quality_enum = screamrouter_audio_engine.ResamplerQuality
+    if not name:
+        return quality_enum.SINC_MEDIUM
+    return getattr(quality_enum, str(name).upper(), quality_enum.SINC_MEDIUM)
+
+
 class ConfigurationManager(threading.Thread):
     """Tracks configuration and loading the main receiver/sinks based off of it"""
     @staticmethod
@@ -2312,6 +2321,9 @@ class ConfigurationManager(threading.Thread):
             cpp_sink_engine_config.time_sync_enabled = py_sink_desc.time_sync
             cpp_sink_engine_config.time_sync_delay_ms = py_sink_desc.time_sync_delay
 
+            cpp_resampler_quality = _resolve_resampler_quality(getattr(py_sink_desc, "resampler_quality", None))
+            cpp_sink_engine_config.resampler_quality = cpp_resampler_quality
+
             # Handle multi-device RTP mode
             cpp_sink_engine_config.multi_device_mode = py_sink_desc.multi_device_mode
             cpp_sink_engine_config.rtp_receivers = []
@@ -2508,6 +2520,7 @@ class ConfigurationManager(threading.Thread):
                     # Get target format from the *sink* description
                     cpp_source_path.target_output_channels = py_sink_desc.channels
                     cpp_source_path.target_output_samplerate = py_sink_desc.sample_rate
+                    cpp_source_path.resampler_quality = cpp_resampler_quality
 
                     preferred_input_channels = py_source_desc.channels
                     if preferred_input_channels is None:
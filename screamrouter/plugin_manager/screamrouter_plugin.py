@@ -198,64 +198,86 @@ class ScreamRouterPlugin(threading.Thread):
             self.permanent_sources.append(source)
         self.wants_reload = True
 
+    def _layout_byte(self, value) -> int:
+        """Normalizes a channel layout byte given as int, 1-char str or 1-byte bytes."""
+        if isinstance(value, str) and len(value) == 1:
+            return ord(value)
+        if isinstance(value, bytes) and len(value) == 1:
+            return value[0]
+        if not isinstance(value, int):
+            logger.error(f"Plugin {self.name}: Unexpected type for channel layout: {type(value)}, value: {value}. Passing original.")
+        return value
+
+    def _engine_available(self, source_instance_id: str) -> bool:
+        if not self.audio_manager_instance:
+            logger.error(f"[Plugin {self.name}] AudioManager instance not available. Cannot write data for {source_instance_id}.")
+            return False
+        if AudioManager is None: # Check if the import failed
+            logger.error(f"[Plugin {self.name}] screamrouter_audio_engine module not imported. Cannot write data.")
+            return False
+        return True
+
     def write_data(self,
                      source_instance_id: str,
-                     pcm_data: bytes,
+                     pcm_data,
                      channels: int,
                      sample_rate: int,
                      bit_depth: int,
                      chlayout1: int, # Assuming these are uint8_t in C++
                      chlayout2: int):
-        """Writes PCM data to ScreamRouter via the C++ audio engine."""
-        if not self.audio_manager_instance:
-            logger.error(f"[Plugin {self.name}] AudioManager instance not available. Cannot write data for {source_instance_id}.")
-            return
-        if AudioManager is None: # Check if the import failed
-            logger.error(f"[Plugin {self.name}] screamrouter_audio_engine module not imported. Cannot write data.")
+        """Writes PCM data to ScreamRouter via the C++ audio engine.
+
+        pcm_data may be any C-contiguous buffer (bytes, bytearray, memoryview, numpy array);
+        the engine copies it once into the packet and releases the GIL while dispatching."""
+        if not self._engine_available(source_instance_id):
             return
 
         try:
-            # Ensure audio_payload is bytes
-            if not isinstance(pcm_data, bytes):
-                logger.error(f"[Plugin {self.name}] pcm_data must be bytes for {source_instance_id}.")
-                return
-
-            # logger.debug(f"[Plugin {self.name}] Writing data for {source_instance_id}: "
-            #              f"{len(pcm_data)} bytes, CH={channels}, SR={sample_rate}, BD={bit_depth}")
-            
-            # Ensure chlayout1 and chlayout2 are integers for the C++ binding.
-            # C++ expects uint8_t, for which pybind11 expects Python integers.
-            
-            _chlayout1_int = chlayout1
-            if isinstance(chlayout1, str) and len(chlayout1) == 1:
-                _chlayout1_int = ord(chlayout1)
-            elif isinstance(chlayout1, bytes) and len(chlayout1) == 1:
-                _chlayout1_int = chlayout1[0]  # This results in an int
-            elif not isinstance(chlayout1, int):
-                logger.error(f"Plugin {self.name}: Unexpected type for chlayout1: {type(chlayout1)}, value: {chlayout1}. Passing original.")
-            
-            _chlayout2_int = chlayout2
-            if isinstance(chlayout2, str) and len(chlayout2) == 1:
-                _chlayout2_int = ord(chlayout2)
-            elif isinstance(chlayout2, bytes) and len(chlayout2) == 1:
-                _chlayout2_int = chlayout2[0]  # This results in an int
-            elif not isinstance(chlayout2, int):
-                logger.error(f"Plugin {self.name}: Unexpected type for chlayout2: {type(chlayout2)}, value: {chlayout2}. Passing original.")
-
             success = self.audio_manager_instance.write_plugin_packet(
                 source_instance_id,
                 pcm_data,
                 channels,
                 sample_rate,
                 bit_depth,
-                _chlayout1_int,
-                _chlayout2_int
+                self._layout_byte(chlayout1),
+                self._layout_byte(chlayout2)
             )
             if not success:
                 logger.warning(f"[Plugin {self.name}] audio_manager.write_plugin_packet for {source_instance_id} reported failure.")
         except Exception as e:
             logger.error(f"[Plugin {self.name}] Error writing data for {source_instance_id} via C++ engine: {e}", exc_info=True)
 
+    def write_data_batch(self,
+                         source_instance_id: str,
+                         pcm_chunks: List[Any],
+                         channels: int,
+                         sample_rate: int,
+                         bit_depth: int,
+                         chlayout1: int,
+                         chlayout2: int) -> int:
+        """Writes several consecutive PCM chunks of one format in a single engine call.
+        Returns the number of chunks the engine accepted."""
+        if not self._engine_available(source_instance_id):
+            return 0
+
+        try:
+            written = self.audio_manager_instance.write_plugin_packets(
+                source_instance_id,
+                pcm_chunks,
+                channels,
+                sample_rate,
+                bit_depth,
+                self._layout_byte(chlayout1),
+                self._layout_byte(chlayout2)
+            )
+            if written != len(pcm_chunks):
+                logger.warning(f"[Plugin {self.name}] audio_manager.write_plugin_packets for {source_instance_id} "
+                               f"accepted {written} of {len(pcm_chunks)} chunks.")
+            return written
+        except Exception as e:
+            logger.error(f"[Plugin {self.name}] Error writing batch for {source_instance_id} via C++ engine: {e}", exc_info=True)
+            return 0
+
     def get_chunk_size_bytes(self, channels: int, bit_depth: int) -> int:
         """Returns the current engine chunk size for a given format."""
         default_size = self.default_chunk_size_bytes
@@ -295,6 +295,8 @@ class SinkDescription(BaseModel):
     """Enable multi-device RTP output mode"""
     rtp_receiver_mappings: List[RtpReceiverMapping] = Field(default_factory=list)
     """RTP receiver mappings for multi-device mode"""
+    resampler_quality: Literal["linear", "sinc_fastest", "sinc_medium", "sinc_best"] = "sinc_medium"
+    """Resampler quality tier used by this sink and every source path routed to it"""
     is_temporary: bool = Field(default=False, exclude=True)
     """Indicates if this sink is temporary and should not be persisted"""
 
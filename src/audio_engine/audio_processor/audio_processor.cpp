@@ -1,6 +1,7 @@
 #include "audio_processor.h"
 #include "../utils/cpp_logger.h"
 #include "../utils/profiler.h"
+#include "../utils/realtime_scope.h"
 #include "biquad/biquad.h"
 #include <algorithm>
 #include <stdexcept>
@@ -28,9 +29,51 @@
 #include <emmintrin.h>
 #endif
 #include <limits>
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <ctime>
+#endif
 
 using namespace screamrouter::audio;
 
+namespace {
+
+/// CPU time consumed by the calling thread; unlike steady_clock it excludes time spent preempted.
+uint64_t thread_cpu_now_ns() {
+#if defined(_WIN32)
+    FILETIME creation{}, exit{}, kernel{}, user{};
+    if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+        return 0;
+    }
+    const auto to_100ns = [](const FILETIME& ft) {
+        return (static_cast<uint64_t>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+    };
+    return (to_100ns(kernel) + to_100ns(user)) * 100u;
+#else
+    struct timespec ts {};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+#endif
+}
+
+int to_src_converter_type(ResamplerQuality quality) {
+    switch (quality) {
+        case ResamplerQuality::LINEAR: return SRC_LINEAR;
+        case ResamplerQuality::SINC_FASTEST: return SRC_SINC_FASTEST;
+        case ResamplerQuality::SINC_BEST: return SRC_SINC_BEST_QUALITY;
+        case ResamplerQuality::SINC_MEDIUM:
+        default: return SRC_SINC_MEDIUM_QUALITY;
+    }
+}
+
+} // namespace
+
 // Undefine min and max macros to prevent conflicts with std::min and std::max
 #ifdef min
 
@@ -43,7 +86,8 @@ AudioProcessor::AudioProcessor(int inputChannels, int outputChannels, int inputB
                                int inputSampleRate, int outputSampleRate, float volume,
                                const std::map<int, screamrouter::audio::CppSpeakerLayout>& initial_layouts_config,
                                std::shared_ptr<screamrouter::audio::AudioEngineSettings> settings,
-                               std::size_t input_chunk_size_bytes)
+                               std::size_t input_chunk_size_bytes,
+                               ResamplerQuality resampler_quality)
     : m_settings(settings),
       chunk_size_bytes_(input_chunk_size_bytes > 0
                             ? input_chunk_size_bytes
@@ -57,13 +101,14 @@ AudioProcessor::AudioProcessor(int inputChannels, int outputChannels, int inputB
       remixed_interleaved_buffer_(chunk_size_bytes_ * 8 * m_settings->processor_tuning.oversampling_factor),  // NEW: Pre-allocate interleaved buffer
       volume_normalization_enabled_(false), eq_normalization_enabled_(false),
       playback_rate_(1.0),
-      m_upsampler(nullptr), m_downsampler(nullptr)
+      m_upsampler(nullptr), m_downsampler(nullptr),
+      resampler_quality_(resampler_quality)
 {
     smoothing_factor_ = m_settings->processor_tuning.volume_smoothing_factor;
     target_volume_.store(volume);
     current_volume_.store(volume);
-    LOG_CPP_INFO("[AudioProc] Constructor: inputChannels=%d, outputChannels=%d, inputSampleRate=%d, outputSampleRate=%d",
-                 inputChannels, outputChannels, inputSampleRate, outputSampleRate);
+    LOG_CPP_INFO("[AudioProc] Constructor: inputChannels=%d, outputChannels=%d, inputSampleRate=%d, outputSampleRate=%d, resampler=%s",
+                 inputChannels, outputChannels, inputSampleRate, outputSampleRate, resampler_quality_name(resampler_quality));
     LOG_CPP_INFO("[AudioProc] Constructor: Initial speaker_layouts_config_ has %zu entries.", initial_layouts_config.size());
 
     for (const auto& pair : initial_layouts_config) {
@@ -164,6 +209,7 @@ void AudioProcessor::swap_active_buffers() {
 
 int AudioProcessor::processAudio(const uint8_t* inputBuffer, int32_t* outputBuffer) {
     PROFILE_FUNCTION();
+    SR_RT_SCOPE("AudioProcessor::processAudio");
     // Playback rate is applied dynamically within resample() and downsample() via src_ratio.
     // No re-initialization is needed for minor clock drift adjustments.
 
@@ -200,6 +246,7 @@ int AudioProcessor::processAudio(const uint8_t* inputBuffer, int32_t* outputBuff
         static std::atomic<uint32_t> profile_counter{0};
         const uint32_t current = profile_counter.fetch_add(1, std::memory_order_relaxed) + 1;
         if ((current % 500u) == 0u) {
+            SR_RT_ALLOW("profiling: periodic stats dump formats strings");
             utils::FunctionProfiler::instance().log_stats();
             utils::FunctionProfiler::instance().reset();
         }
@@ -315,14 +362,16 @@ void AudioProcessor::initializeSampler() {
         return;
     }
 
+    const int converter_type = to_src_converter_type(resampler_quality_);
+
     // Create upsampler
-    m_upsampler = src_new(SRC_SINC_MEDIUM_QUALITY, inputChannels, &error);
+    m_upsampler = src_new(converter_type, inputChannels, &error);
     if (m_upsampler == nullptr) {
         LOG_CPP_ERROR("[AudioProc] Error creating libsamplerate upsampler: %s", src_strerror(error));
     }
 
     // Create downsampler
-    m_downsampler = src_new(SRC_SINC_MEDIUM_QUALITY, outputChannels, &error);
+    m_downsampler = src_new(converter_type, outputChannels, &error);
     if (m_downsampler == nullptr) {
         LOG_CPP_ERROR("[AudioProc] Error creating libsamplerate downsampler: %s", src_strerror(error));
     }
@@ -555,6 +604,7 @@ void AudioProcessor::resample() {
     size_t output_frames_generated = 0;
     float* out_base = active_output_buffer_->data();
     const float* in_base = active_input_buffer_->data();
+    const uint64_t src_t0 = thread_cpu_now_ns();
     while (input_frames_consumed < total_input_frames) {
         size_t available_output_frames = active_output_buffer_->size() / static_cast<size_t>(inputChannels) - output_frames_generated;
         if (available_output_frames == 0) {
@@ -595,6 +645,8 @@ void AudioProcessor::resample() {
         }
     }
 
+    resampler_cpu_ns_.fetch_add(thread_cpu_now_ns() - src_t0, std::memory_order_relaxed);
+
     size_t output_samples = output_frames_generated * static_cast<size_t>(inputChannels);
     active_output_buffer_->resize(output_samples);
     active_samples_ = output_samples;
@@ -624,6 +676,7 @@ size_t AudioProcessor::resample_to_fixed_output(
     
     size_t input_frames_consumed = 0;
     size_t output_frames_generated = 0;
+    const uint64_t src_t0 = thread_cpu_now_ns();
     
     // Loop until we have exactly target_output_frames of output
     while (output_frames_generated < target_output_frames && input_frames_consumed < max_input_frames) {
@@ -651,6 +704,8 @@ size_t AudioProcessor::resample_to_fixed_output(
         }
     }
     
+    resampler_cpu_ns_.fetch_add(thread_cpu_now_ns() - src_t0, std::memory_order_relaxed);
+
     // Zero-fill any remaining output if we ran out of input
     if (output_frames_generated < target_output_frames) {
         size_t missing_samples = (target_output_frames - output_frames_generated) * channels;
@@ -740,6 +795,7 @@ void AudioProcessor::downsample(int32_t* outputBuffer) {
 
     size_t input_frames_consumed = 0;
     size_t output_frames_generated = 0;
+    const uint64_t src_t0 = thread_cpu_now_ns();
     while (input_frames_consumed < frame_count) {
         size_t available_output_frames = downsample_float_out_buffer_.size() / static_cast<size_t>(outputChannels) - output_frames_generated;
         if (available_output_frames == 0) {
@@ -779,6 +835,8 @@ void AudioProcessor::downsample(int32_t* outputBuffer) {
         }
     }
 
+    resampler_cpu_ns_.fetch_add(thread_cpu_now_ns() - src_t0, std::memory_order_relaxed);
+
     size_t output_samples = output_frames_generated * static_cast<size_t>(outputChannels);
     if (downsample_float_out_buffer_.size() < output_samples) {
         LOG_CPP_ERROR("[AudioProc] Error: downsample_float_out_buffer_ smaller than produced sample count (%zu vs %zu).", downsample_float_out_buffer_.size(), output_samples);
@@ -1199,6 +1257,16 @@ void AudioProcessor::rebuild_mix_taps_locked() {
             }
         }
     }
+
+    mix_kernel_ = select_speaker_mix_kernel(inputChannels, outputChannels);
+    if (mix_kernel_) {
+        for (int oc = 0; oc < outputChannels; ++oc) {
+            for (int ic = 0; ic < inputChannels; ++ic) {
+                const float gain = speaker_mix[ic][oc];
+                mix_kernel_gains_[oc * inputChannels + ic] = std::fabs(gain) > epsilon ? gain : 0.0f;
+            }
+        }
+    }
 }
 
 // --- End New/Updated Methods ---
@@ -1257,8 +1325,20 @@ void AudioProcessor::mixSpeakers() {
         return;
     }
 
-    // Clear the interleaved buffer (only the portion we'll use)
     float* mixed_out = active_output_buffer_->data();
+
+    // Specialized kernel for common channel pairs; it writes every output sample,
+    // so no clear is needed. The deprecated planar buffers are not refreshed here.
+    const auto& first_view = input_channel_views_[0];
+    if (mix_kernel_ && first_view.data && first_view.stride == static_cast<size_t>(inputChannels)) {
+        mix_kernel_(first_view.data, mixed_out, channel_buffer_pos, mix_kernel_gains_);
+        active_samples_ = required_samples;
+        active_output_buffer_->resize(required_samples);
+        swap_active_buffers();
+        return;
+    }
+
+    // Clear the interleaved buffer (only the portion we'll use)
     std::fill_n(mixed_out, required_samples, 0.0f);
 
     // Process each output channel
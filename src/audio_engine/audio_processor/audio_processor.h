@@ -18,6 +18,7 @@
 #include "../audio_constants.h"
 #include "../configuration/audio_engine_config_types.h"
 #include "../configuration/audio_engine_settings.h"
+#include "speaker_mix_kernels.h"
 
 // libsamplerate include
 #include <samplerate.h>
@@ -42,12 +43,14 @@ public:
      * @param outputSampleRate Sample rate of the output audio.
      * @param volume Initial volume level.
      * @param initial_layouts_config Initial map of speaker layouts keyed by input channel count.
+     * @param resampler_quality libsamplerate converter tier used by both resamplers.
      */
     AudioProcessor(int inputChannels, int outputChannels, int inputBitDepth,
                    int inputSampleRate, int outputSampleRate, float volume,
                    const std::map<int, screamrouter::audio::CppSpeakerLayout>& initial_layouts_config,
                    std::shared_ptr<screamrouter::audio::AudioEngineSettings> settings,
-                   std::size_t input_chunk_size_bytes);
+                   std::size_t input_chunk_size_bytes,
+                   screamrouter::audio::ResamplerQuality resampler_quality = screamrouter::audio::ResamplerQuality::SINC_MEDIUM);
     /**
      * @brief Destructor for the AudioProcessor.
      */
@@ -132,6 +135,15 @@ public:
         int channels
     );
 
+    /** @brief Gets the converter tier this processor's resamplers were created with. */
+    screamrouter::audio::ResamplerQuality get_resampler_quality() const { return resampler_quality_; }
+
+    /**
+     * @brief Gets the cumulative thread CPU time spent inside libsamplerate.
+     * @return CPU nanoseconds spent in src_process() across both resamplers since construction.
+     */
+    uint64_t get_resampler_cpu_ns() const { return resampler_cpu_ns_.load(std::memory_order_relaxed); }
+
 private:
     std::shared_ptr<screamrouter::audio::AudioEngineSettings> m_settings;
     const std::size_t chunk_size_bytes_;
@@ -189,6 +201,8 @@ private:
     // --- libsamplerate Resampler Members ---
     SRC_STATE* m_upsampler;
     SRC_STATE* m_downsampler;
+    screamrouter::audio::ResamplerQuality resampler_quality_;
+    std::atomic<uint64_t> resampler_cpu_ns_{0};
 
     // --- Filters ---
     Biquad* filters[screamrouter::audio::MAX_CHANNELS][screamrouter::audio::EQ_BANDS];
@@ -198,6 +212,10 @@ private:
         float gain_scaled;
     };
     std::vector<MixTap> mix_taps_[screamrouter::audio::MAX_CHANNELS];
+    /** @brief Specialized kernel for the current channel pair, or nullptr to use mix_taps_. */
+    screamrouter::audio::SpeakerMixKernel mix_kernel_ = nullptr;
+    /** @brief Mix matrix for mix_kernel_, laid out as [oc * inputChannels + ic]. */
+    float mix_kernel_gains_[screamrouter::audio::MAX_CHANNELS * screamrouter::audio::MAX_CHANNELS] = {};
 
     // --- Private Methods for Audio Pipeline Stages ---
     void setupBiquad();
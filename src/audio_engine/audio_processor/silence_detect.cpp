@@ -0,0 +1,44 @@
+#include "silence_detect.h"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SCREAMROUTER_SILENCE_SSE2 1
+#else
+#define SCREAMROUTER_SILENCE_SSE2 0
+#endif
+
+namespace screamrouter {
+namespace audio {
+
+bool is_digital_silence(const uint8_t* data, std::size_t bytes) {
+    std::size_t i = 0;
+#if SCREAMROUTER_SILENCE_SSE2
+    // OR 64 bytes per iteration and test once; non-silent audio usually exits on the first block.
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 64 <= bytes; i += 64) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 16));
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 32));
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 48));
+        const __m128i acc = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(acc, zero)) != 0xFFFF) {
+            return false;
+        }
+    }
+#endif
+    uint64_t acc = 0;
+    for (; i + sizeof(uint64_t) <= bytes; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        acc |= word;
+    }
+    for (; i < bytes; ++i) {
+        acc |= data[i];
+    }
+    return acc == 0;
+}
+
+} // namespace audio
+} // namespace screamrouter
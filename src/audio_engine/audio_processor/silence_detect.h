@@ -0,0 +1,31 @@
+/**
+ * @file silence_detect.h
+ * @brief Vectorized digital-silence detection for PCM buffers.
+ * @details Idle clients (e.g. a paused Scream sender) keep streaming all-zero payloads.
+ *          These helpers let the source processors and mixers recognise such buffers
+ *          cheaply so the DSP chain and the mix accumulation can be skipped.
+ */
+#ifndef SILENCE_DETECT_H
+#define SILENCE_DETECT_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace screamrouter {
+namespace audio {
+
+/**
+ * @brief Returns true if every byte in the buffer is zero.
+ * @details Exact digital silence for integer PCM of any bit depth. An empty buffer counts as silent.
+ */
+bool is_digital_silence(const uint8_t* data, std::size_t bytes);
+
+/** @brief Returns true if every sample in the buffer is zero. */
+inline bool is_digital_silence(const int32_t* samples, std::size_t count) {
+    return is_digital_silence(reinterpret_cast<const uint8_t*>(samples), count * sizeof(int32_t));
+}
+
+} // namespace audio
+} // namespace screamrouter
+
+#endif // SILENCE_DETECT_H
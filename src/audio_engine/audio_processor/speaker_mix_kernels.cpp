@@ -0,0 +1,177 @@
+#include "speaker_mix_kernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SCREAMROUTER_MIX_SSE2 1
+#else
+#define SCREAMROUTER_MIX_SSE2 0
+#endif
+
+namespace screamrouter {
+namespace audio {
+
+namespace {
+
+// Portable kernel: the matrix is copied into a fixed-size local array so the
+// compiler fully unrolls both channel loops and keeps the gains in registers.
+template <int In, int Out>
+void mix_fixed(const float* in, float* out, std::size_t frames, const float* gains) {
+    float g[Out][In];
+    for (int oc = 0; oc < Out; ++oc) {
+        for (int ic = 0; ic < In; ++ic) {
+            g[oc][ic] = gains[oc * In + ic];
+        }
+    }
+    for (std::size_t f = 0; f < frames; ++f) {
+        const float* src = in + f * In;
+        float* dst = out + f * Out;
+        for (int oc = 0; oc < Out; ++oc) {
+            float acc = 0.0f;
+            for (int ic = 0; ic < In; ++ic) {
+                acc += src[ic] * g[oc][ic];
+            }
+            dst[oc] = acc;
+        }
+    }
+}
+
+#if SCREAMROUTER_MIX_SSE2
+
+template <int In, int Out>
+inline void mix_tail(const float* in, float* out, std::size_t start, std::size_t frames, const float* gains) {
+    if (start < frames) {
+        mix_fixed<In, Out>(in + start * In, out + start * Out, frames - start, gains);
+    }
+}
+
+// 1->2: four mono frames per iteration, duplicated into L/R pairs.
+void mix_1_to_2(const float* in, float* out, std::size_t frames, const float* gains) {
+    const __m128 g = _mm_setr_ps(gains[0], gains[1], gains[0], gains[1]);
+    std::size_t f = 0;
+    for (; f + 4 <= frames; f += 4) {
+        const __m128 x = _mm_loadu_ps(in + f);
+        _mm_storeu_ps(out + f * 2, _mm_mul_ps(_mm_unpacklo_ps(x, x), g));
+        _mm_storeu_ps(out + f * 2 + 4, _mm_mul_ps(_mm_unpackhi_ps(x, x), g));
+    }
+    mix_tail<1, 2>(in, out, f, frames, gains);
+}
+
+// 2->2: two frames per vector; out = x * diag + swap(x) * cross.
+void mix_2_to_2(const float* in, float* out, std::size_t frames, const float* gains) {
+    const __m128 diag = _mm_setr_ps(gains[0], gains[3], gains[0], gains[3]);
+    const __m128 cross = _mm_setr_ps(gains[1], gains[2], gains[1], gains[2]);
+    std::size_t f = 0;
+    for (; f + 2 <= frames; f += 2) {
+        const __m128 x = _mm_loadu_ps(in + f * 2);
+        const __m128 swapped = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1));
+        _mm_storeu_ps(out + f * 2, _mm_add_ps(_mm_mul_ps(x, diag), _mm_mul_ps(swapped, cross)));
+    }
+    mix_tail<2, 2>(in, out, f, frames, gains);
+}
+
+// 2->6 / 2->8: broadcast L and R, multiply by the matrix columns.
+template <int Out>
+void mix_2_to_n(const float* in, float* out, std::size_t frames, const float* gains) {
+    static_assert(Out == 6 || Out == 8, "mix_2_to_n supports 6 or 8 outputs");
+    alignas(16) float col_l[8] = {};
+    alignas(16) float col_r[8] = {};
+    for (int oc = 0; oc < Out; ++oc) {
+        col_l[oc] = gains[oc * 2];
+        col_r[oc] = gains[oc * 2 + 1];
+    }
+    const __m128 l_lo = _mm_load_ps(col_l);
+    const __m128 l_hi = _mm_load_ps(col_l + 4);
+    const __m128 r_lo = _mm_load_ps(col_r);
+    const __m128 r_hi = _mm_load_ps(col_r + 4);
+    for (std::size_t f = 0; f < frames; ++f) {
+        const __m128 l = _mm_set1_ps(in[f * 2]);
+        const __m128 r = _mm_set1_ps(in[f * 2 + 1]);
+        float* dst = out + f * Out;
+        _mm_storeu_ps(dst, _mm_add_ps(_mm_mul_ps(l, l_lo), _mm_mul_ps(r, r_lo)));
+        const __m128 hi = _mm_add_ps(_mm_mul_ps(l, l_hi), _mm_mul_ps(r, r_hi));
+        if (Out == 8) {
+            _mm_storeu_ps(dst + 4, hi);
+        } else {
+            _mm_storel_pi(reinterpret_cast<__m64*>(dst + 4), hi);
+        }
+    }
+}
+
+// 6->2 / 8->2: dot each frame against the L and R rows, then reduce both at once.
+template <int In>
+void mix_n_to_2(const float* in, float* out, std::size_t frames, const float* gains) {
+    static_assert(In == 6 || In == 8, "mix_n_to_2 supports 6 or 8 inputs");
+    alignas(16) float row_l[8] = {};
+    alignas(16) float row_r[8] = {};
+    for (int ic = 0; ic < In; ++ic) {
+        row_l[ic] = gains[ic];
+        row_r[ic] = gains[In + ic];
+    }
+    const __m128 l_lo = _mm_load_ps(row_l);
+    const __m128 l_hi = _mm_load_ps(row_l + 4);
+    const __m128 r_lo = _mm_load_ps(row_r);
+    const __m128 r_hi = _mm_load_ps(row_r + 4);
+    for (std::size_t f = 0; f < frames; ++f) {
+        const float* src = in + f * In;
+        const __m128 lo = _mm_loadu_ps(src);
+        const __m128 hi = (In == 8)
+            ? _mm_loadu_ps(src + 4)
+            : _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(src + 4)));
+        const __m128 l = _mm_add_ps(_mm_mul_ps(lo, l_lo), _mm_mul_ps(hi, l_hi));
+        const __m128 r = _mm_add_ps(_mm_mul_ps(lo, r_lo), _mm_mul_ps(hi, r_hi));
+        // [l0+l2, r0+r2, l1+l3, r1+r3] -> [sum_l, sum_r, ...]
+        const __m128 t = _mm_add_ps(_mm_unpacklo_ps(l, r), _mm_unpackhi_ps(l, r));
+        const __m128 s = _mm_add_ps(t, _mm_movehl_ps(t, t));
+        _mm_storel_pi(reinterpret_cast<__m64*>(out + f * 2), s);
+    }
+}
+
+// 8->8: accumulate broadcast inputs against the eight matrix columns.
+void mix_8_to_8(const float* in, float* out, std::size_t frames, const float* gains) {
+    __m128 col_lo[8];
+    __m128 col_hi[8];
+    for (int ic = 0; ic < 8; ++ic) {
+        col_lo[ic] = _mm_setr_ps(gains[0 * 8 + ic], gains[1 * 8 + ic], gains[2 * 8 + ic], gains[3 * 8 + ic]);
+        col_hi[ic] = _mm_setr_ps(gains[4 * 8 + ic], gains[5 * 8 + ic], gains[6 * 8 + ic], gains[7 * 8 + ic]);
+    }
+    for (std::size_t f = 0; f < frames; ++f) {
+        const float* src = in + f * 8;
+        __m128 acc_lo = _mm_mul_ps(_mm_set1_ps(src[0]), col_lo[0]);
+        __m128 acc_hi = _mm_mul_ps(_mm_set1_ps(src[0]), col_hi[0]);
+        for (int ic = 1; ic < 8; ++ic) {
+            const __m128 x = _mm_set1_ps(src[ic]);
+            acc_lo = _mm_add_ps(acc_lo, _mm_mul_ps(x, col_lo[ic]));
+            acc_hi = _mm_add_ps(acc_hi, _mm_mul_ps(x, col_hi[ic]));
+        }
+        _mm_storeu_ps(out + f * 8, acc_lo);
+        _mm_storeu_ps(out + f * 8 + 4, acc_hi);
+    }
+}
+
+#endif // SCREAMROUTER_MIX_SSE2
+
+} // namespace
+
+SpeakerMixKernel select_speaker_mix_kernel(int input_channels, int output_channels) {
+#if SCREAMROUTER_MIX_SSE2
+    if (input_channels == 1 && output_channels == 2) return &mix_1_to_2;
+    if (input_channels == 2 && output_channels == 2) return &mix_2_to_2;
+    if (input_channels == 2 && output_channels == 6) return &mix_2_to_n<6>;
+    if (input_channels == 2 && output_channels == 8) return &mix_2_to_n<8>;
+    if (input_channels == 6 && output_channels == 2) return &mix_n_to_2<6>;
+    if (input_channels == 8 && output_channels == 2) return &mix_n_to_2<8>;
+    if (input_channels == 8 && output_channels == 8) return &mix_8_to_8;
+#else
+    if (input_channels == 1 && output_channels == 2) return &mix_fixed<1, 2>;
+    if (input_channels == 2 && output_channels == 2) return &mix_fixed<2, 2>;
+    if (input_channels == 2 && output_channels == 6) return &mix_fixed<2, 6>;
+    if (input_channels == 2 && output_channels == 8) return &mix_fixed<2, 8>;
+    if (input_channels == 6 && output_channels == 2) return &mix_fixed<6, 2>;
+    if (input_channels == 8 && output_channels == 2) return &mix_fixed<8, 2>;
+    if (input_channels == 8 && output_channels == 8) return &mix_fixed<8, 8>;
+#endif
+    return nullptr;
+}
+
+} // namespace audio
+} // namespace screamrouter
@@ -0,0 +1,36 @@
+/**
+ * @file speaker_mix_kernels.h
+ * @brief Channel-count-specialized speaker mix kernels used by AudioProcessor.
+ * @details The generic mix walks per-output tap lists with strided reads. For the
+ *          common (input, output) channel pairs the mix matrix size is known at
+ *          compile time, so these kernels keep the gains in registers and process
+ *          interleaved frames directly, using SSE where available.
+ */
+#ifndef SPEAKER_MIX_KERNELS_H
+#define SPEAKER_MIX_KERNELS_H
+
+#include <cstddef>
+
+namespace screamrouter {
+namespace audio {
+
+/**
+ * @brief Signature of a specialized mix kernel.
+ * @param in Interleaved input samples (frames * input channels).
+ * @param out Interleaved output samples (frames * output channels). Overwritten, not accumulated.
+ * @param frames Number of frames to mix.
+ * @param gains Mix matrix laid out by output channel: gains[oc * input_channels + ic].
+ */
+using SpeakerMixKernel = void (*)(const float* in, float* out, std::size_t frames, const float* gains);
+
+/**
+ * @brief Returns the specialized kernel for a channel pair, or nullptr if none exists.
+ * @details Specialized pairs: 1->2, 2->2, 2->6, 2->8, 6->2, 8->2, 8->8.
+ *          Callers fall back to the generic tap-based mix on nullptr.
+ */
+SpeakerMixKernel select_speaker_mix_kernel(int input_channels, int output_channels);
+
+} // namespace audio
+} // namespace screamrouter
+
+#endif // SPEAKER_MIX_KERNELS_H
@@ -22,6 +22,8 @@
 #include <pybind11/operators.h> // For operator overloads
 #endif
 #include "utils/thread_safe_queue.h"
+#include "utils/mpsc_queue.h"
+#include "utils/packet_ring.h"
 
 namespace screamrouter {
 
@@ -112,6 +114,8 @@ struct TaggedAudioPacket {
     double playback_rate = 1.0;
     /** @brief Marks packets that should trigger sentinel logging. */
     bool is_sentinel = false;
+    /** @brief Span-tracer flow id, assigned by the receiver or else at timeshift ingress; 0 when tracing is off. */
+    uint64_t trace_flow_id = 0;
 };
 
 /**
@@ -132,6 +136,10 @@ struct ProcessedAudioChunk {
     double playback_rate = 1.0;
     /** @brief Sentinel flag propagated from the originating packet. */
     bool is_sentinel = false;
+    /** @brief True if every sample is zero; mixers can skip accumulating it. */
+    bool is_silent = false;
+    /** @brief Flow id of the packet that completed this chunk; 0 when tracing is off. */
+    uint64_t trace_flow_id = 0;
 };
 
 /**
@@ -173,6 +181,32 @@ struct ControlCommand {
     ControlCommand() : type(CommandType::SET_VOLUME), float_value(0.0f), int_value(0), input_channel_key(0) {}
 };
 
+/**
+ * @enum ResamplerQuality
+ * @brief Selects the libsamplerate converter used by a processing path.
+ * @details Tiers are ordered by cost. SINC_MEDIUM matches the converter every
+ *          path used before the setting existed.
+ */
+enum class ResamplerQuality {
+    LINEAR,         ///< Linear interpolation. Cheapest, audible aliasing on wideband material.
+    SINC_FASTEST,   ///< Band-limited sinc, ~80% passband.
+    SINC_MEDIUM,    ///< Band-limited sinc, ~90% passband.
+    SINC_BEST       ///< Band-limited sinc, ~97% passband. Most expensive.
+};
+
+/**
+ * @brief Returns a short, stable name for a resampler quality tier (used in logs).
+ */
+inline const char* resampler_quality_name(ResamplerQuality quality) {
+    switch (quality) {
+        case ResamplerQuality::LINEAR: return "linear";
+        case ResamplerQuality::SINC_FASTEST: return "sinc_fastest";
+        case ResamplerQuality::SINC_MEDIUM: return "sinc_medium";
+        case ResamplerQuality::SINC_BEST: return "sinc_best";
+    }
+    return "unknown";
+}
+
 /**
  * @enum DeviceDirection
  * @brief Indicates whether a system device is an input (capture) or output (playback).
@@ -319,6 +353,12 @@ struct SourceStats {
     uint64_t discarded_packets = 0;
     double avg_processing_ms = 0.0;
     size_t peak_process_buffer_samples = 0;
+    ResamplerQuality resampler_quality = ResamplerQuality::SINC_MEDIUM;
+    double resampler_cpu_ms = 0.0;
+    double resampler_cpu_percent = 0.0;
+    uint64_t silent_chunks_gated = 0;
+    double silence_cpu_saved_ms = 0.0;
+    double silence_cpu_saved_percent = 0.0;
 };
 
 struct WebRtcListenerStats {
@@ -355,6 +395,11 @@ struct SinkStats {
     double avg_chunk_dwell_ms = 0.0;
     double last_send_gap_ms = 0.0;
     double avg_send_gap_ms = 0.0;
+    ResamplerQuality resampler_quality = ResamplerQuality::SINC_MEDIUM;
+    double resampler_cpu_ms = 0.0;
+    double resampler_cpu_percent = 0.0;
+    uint64_t silent_inputs_skipped = 0;
+    std::string mix_group_leader; // Set when this sink is served by another sink's mixer
     std::vector<SinkInputLaneStats> inputs;
     std::vector<WebRtcListenerStats> webrtc_listeners;
 };
@@ -394,6 +439,8 @@ struct SourceConfig {
     int target_output_channels = 2;
     /** @brief Required output sample rate for this source's processing path. */
     int target_output_samplerate = 48000;
+    /** @brief Resampler converter used by this source's processing path. */
+    ResamplerQuality resampler_quality = ResamplerQuality::SINC_MEDIUM;
 };
 
 /**
@@ -439,6 +486,8 @@ struct SinkConfig {
     std::vector<config::RtpReceiverConfig> rtp_receivers;
     /** @brief Enable multi-device RTP mode. */
     bool multi_device_mode = false;
+    /** @brief Resampler converter used by this sink's output processors. */
+    ResamplerQuality resampler_quality = ResamplerQuality::SINC_MEDIUM;
 };
 
 /**
@@ -497,6 +546,21 @@ struct PerProcessScreamReceiverConfig {
     int listen_port = 16402;
 };
 
+/**
+ * @struct PcapReplayConfig
+ * @brief Configuration for replaying a capture file into the receivers.
+ */
+struct PcapReplayConfig {
+    /** @brief Path to a pcap or pcapng file. */
+    std::string file_path;
+    /** @brief 1.0 keeps the captured inter-arrival times, 2.0 replays twice as fast, 0 sends as fast as possible. */
+    double speed = 1.0;
+    /** @brief Number of passes over the file; 0 repeats until stopped. */
+    int loop_count = 1;
+    /** @brief Receiver port that gets every datagram; 0 routes by the captured destination port. */
+    int target_port = 0;
+};
+
 /**
  * @struct SourceProcessorConfig
  * @brief Configuration for a SourceInputProcessor component.
@@ -524,6 +588,8 @@ struct SourceProcessorConfig {
     std::vector<std::vector<float>> speaker_mix_matrix;
     /** @brief True to use dynamic mixing logic, false to use the matrix. */
     bool use_auto_speaker_mix;
+    /** @brief Resampler converter used by this processor's AudioProcessor. */
+    ResamplerQuality resampler_quality = ResamplerQuality::SINC_MEDIUM;
 
     /**
      * @brief Default constructor.
@@ -611,6 +677,8 @@ struct SinkMixerConfig {
     bool multi_device_mode = false;
     /** @brief Adaptive playback parameters for local system sinks. */
     AdaptivePlaybackSettings adaptive_playback;
+    /** @brief Resampler converter used by the mixer's output processors. */
+    ResamplerQuality resampler_quality = ResamplerQuality::SINC_MEDIUM;
 };
 
 
@@ -641,10 +709,12 @@ struct SourceParameterUpdates {
 using PacketQueue = utils::ThreadSafeQueue<TaggedAudioPacket>;
 /** @brief A thread-safe queue for passing processed audio chunks between threads. */
 using ChunkQueue = utils::ThreadSafeQueue<ProcessedAudioChunk>;
+/** @brief A single-producer ring carrying processed chunks from a deduplicated source processor to an extra sink. */
+using ProcessedChunkRing = utils::PacketRing<ProcessedAudioChunk>;
 /** @brief A thread-safe queue for sending control commands to audio processors. */
 using CommandQueue = utils::ThreadSafeQueue<ControlCommand>;
-/** @brief A thread-safe queue for passing encoded MP3 data. */
-using Mp3Queue = utils::ThreadSafeQueue<EncodedMP3Data>;
+/** @brief A lock-free queue for passing encoded MP3 data from a mixer to the API reader. */
+using Mp3Queue = utils::MpscQueue<EncodedMP3Data>;
 /** @brief Registry mapping device tags to their metadata. */
 using SystemDeviceRegistry = std::map<std::string, SystemDeviceInfo>;
 /** @brief A thread-safe queue for system device discovery notifications. */
@@ -680,13 +750,21 @@ using ListenerRemovalQueue = utils::ThreadSafeQueue<ListenerRemovalRequest>;
             .def_readwrite("time_sync_enabled", &SinkConfig::time_sync_enabled, "Enable time synchronization for RTP streams")
             .def_readwrite("time_sync_delay_ms", &SinkConfig::time_sync_delay_ms, "Time synchronization delay in milliseconds")
             .def_readwrite("rtp_receivers", &SinkConfig::rtp_receivers, "List of RTP receivers for multi-device mode")
-            .def_readwrite("multi_device_mode", &SinkConfig::multi_device_mode, "Enable multi-device RTP mode");
+            .def_readwrite("multi_device_mode", &SinkConfig::multi_device_mode, "Enable multi-device RTP mode")
+            .def_readwrite("resampler_quality", &SinkConfig::resampler_quality, "Resampler quality tier for this sink's output processing");
 
         py::class_<CppSpeakerLayout>(m, "CppSpeakerLayout", "C++ structure for speaker layout configuration")
             .def(py::init<>()) // Default constructor
             .def_readwrite("auto_mode", &CppSpeakerLayout::auto_mode, "True for auto mix, false for custom matrix")
             .def_readwrite("matrix", &CppSpeakerLayout::matrix, "8x8 speaker mix matrix");
 
+        py::enum_<ResamplerQuality>(m, "ResamplerQuality", "libsamplerate converter tier for a processing path")
+            .value("LINEAR", ResamplerQuality::LINEAR)
+            .value("SINC_FASTEST", ResamplerQuality::SINC_FASTEST)
+            .value("SINC_MEDIUM", ResamplerQuality::SINC_MEDIUM)
+            .value("SINC_BEST", ResamplerQuality::SINC_BEST)
+            .export_values();
+
         py::enum_<DeviceDirection>(m, "DeviceDirection", "Direction for system audio devices")
             .value("CAPTURE", DeviceDirection::CAPTURE)
             .value("PLAYBACK", DeviceDirection::PLAYBACK)
@@ -786,7 +864,13 @@ using ListenerRemovalQueue = utils::ThreadSafeQueue<ListenerRemovalRequest>;
             .def_readwrite("chunks_pushed", &SourceStats::chunks_pushed)
             .def_readwrite("discarded_packets", &SourceStats::discarded_packets)
             .def_readwrite("avg_processing_ms", &SourceStats::avg_processing_ms)
-            .def_readwrite("peak_process_buffer_samples", &SourceStats::peak_process_buffer_samples);
+            .def_readwrite("peak_process_buffer_samples", &SourceStats::peak_process_buffer_samples)
+            .def_readwrite("resampler_quality", &SourceStats::resampler_quality)
+            .def_readwrite("resampler_cpu_ms", &SourceStats::resampler_cpu_ms)
+            .def_readwrite("resampler_cpu_percent", &SourceStats::resampler_cpu_percent)
+            .def_readwrite("silent_chunks_gated", &SourceStats::silent_chunks_gated)
+            .def_readwrite("silence_cpu_saved_ms", &SourceStats::silence_cpu_saved_ms)
+            .def_readwrite("silence_cpu_saved_percent", &SourceStats::silence_cpu_saved_percent);
 
         py::class_<WebRtcListenerStats>(m, "WebRtcListenerStats", "Statistics for a single WebRTC listener")
             .def(py::init<>())
@@ -823,6 +907,11 @@ using ListenerRemovalQueue = utils::ThreadSafeQueue<ListenerRemovalRequest>;
             .def_readwrite("avg_chunk_dwell_ms", &SinkStats::avg_chunk_dwell_ms)
             .def_readwrite("last_send_gap_ms", &SinkStats::last_send_gap_ms)
             .def_readwrite("avg_send_gap_ms", &SinkStats::avg_send_gap_ms)
+            .def_readwrite("resampler_quality", &SinkStats::resampler_quality)
+            .def_readwrite("resampler_cpu_ms", &SinkStats::resampler_cpu_ms)
+            .def_readwrite("resampler_cpu_percent", &SinkStats::resampler_cpu_percent)
+            .def_readwrite("silent_inputs_skipped", &SinkStats::silent_inputs_skipped)
+            .def_readwrite("mix_group_leader", &SinkStats::mix_group_leader)
             .def_readwrite("inputs", &SinkStats::inputs)
             .def_readwrite("webrtc_listeners", &SinkStats::webrtc_listeners);
 
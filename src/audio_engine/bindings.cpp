@@ -16,6 +16,8 @@
 #include "configuration/audio_engine_config_applier.h"
 #include "configuration/audio_engine_config_types.h"
 #include "utils/cpp_logger.h"
+#include "utils/profiler.h"
+#include "utils/span_tracer.h"
 #include "audio_types.h"
 // Initialize tracing early so the JSON file is created as soon as the module
 // is imported when SCREAMROUTER_TRACE is set.
@@ -63,6 +65,36 @@ PYBIND11_MODULE(screamrouter_audio_engine, m) {
     // 1. Logger has no dependencies on other bound types
     audio::logging::bind_logger(m);
 
+    // Profiler controls are plain functions with no bound types.
+    m.def("set_profiler_enabled", [](bool enabled) {
+        audio::utils::FunctionProfiler::instance().set_enabled(enabled);
+    }, py::arg("enabled"), "Enables or disables PROFILE_FUNCTION timing at runtime.");
+    m.def("set_profiler_sample_interval", [](uint32_t interval) {
+        audio::utils::FunctionProfiler::instance().set_sample_interval(interval);
+    }, py::arg("interval"), "Times one in every N executions of each profiled scope (1 = all). Resets collected stats.");
+    m.def("log_profiler_stats", []() {
+        audio::utils::FunctionProfiler::instance().log_stats();
+    }, py::call_guard<py::gil_scoped_release>(), "Logs aggregated profiler timings through the C++ logger.");
+    m.def("reset_profiler_stats", []() {
+        audio::utils::FunctionProfiler::instance().reset();
+    }, "Clears aggregated profiler timings.");
+
+    // Span tracing controls (Perfetto / Chrome trace JSON).
+    m.def("start_span_trace", [](size_t events_per_thread) {
+        audio::utils::SpanTracer::instance().start(events_per_thread);
+    }, py::arg("events_per_thread") = audio::utils::SpanTracer::kDefaultEventsPerThread,
+       "Starts recording pipeline spans into per-thread ring buffers (newest events win).");
+    m.def("stop_span_trace", []() {
+        audio::utils::SpanTracer::instance().stop();
+    }, "Stops recording pipeline spans; recorded events remain available for dumping.");
+    m.def("is_span_trace_enabled", []() {
+        return audio::utils::SpanTracer::instance().is_enabled();
+    }, "Returns True while pipeline spans are being recorded.");
+    m.def("dump_span_trace", [](const std::string& path) {
+        return audio::utils::SpanTracer::instance().dump(path);
+    }, py::arg("path"), py::call_guard<py::gil_scoped_release>(),
+       "Writes the current trace session as Chrome Trace Event JSON (open in ui.perfetto.dev). Returns False on I/O failure.");
+
     // 2. Audio types are fundamental and used by other bindings
     audio::bind_audio_types(m);
 
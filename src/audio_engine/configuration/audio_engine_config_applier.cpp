@@ -274,6 +274,7 @@ bool AudioEngineConfigApplier::apply_state(DesiredEngineState desired_state) {
         const auto t_rem_start = clock::now();
         LOG_CPP_INFO("[ConfigApplier] Removing: paths=%zu, sinks=%zu",
                      path_ids_to_remove.size(), sink_ids_to_remove.size());
+        restore_groups_touched_by(sink_ids_to_remove, sinks_to_update, path_ids_to_remove, paths_to_update);
         process_source_path_removals(path_ids_to_remove);
         process_sink_removals(sink_ids_to_remove);
         const auto t_rem_end = clock::now();
@@ -327,6 +328,13 @@ bool AudioEngineConfigApplier::apply_state(DesiredEngineState desired_state) {
         LOG_CPP_INFO("[ConfigApplier] Updates: %lld ms", (long long)std::chrono::duration_cast<std::chrono::milliseconds>(t_upd_end - t_upd_start).count());
     }
 
+    // 5) Sinks with identical inputs and output format share one mixer
+    {
+        PhaseLogger phase("apply_state::sink_groups");
+        ApplyStateWatchdog watchdog("sink_groups", 500);
+        reconcile_sink_groups();
+    }
+
     const auto t_end = clock::now();
     LOG_CPP_INFO("[ConfigApplier] Finished apply_state in %lld ms",
                  (long long)std::chrono::duration_cast<std::chrono::milliseconds>(t_end - t_start).count());
@@ -361,7 +369,8 @@ bool compare_sink_configs(const audio::SinkConfig& a, const audio::SinkConfig& b
            a.enable_mp3 == b.enable_mp3 &&
            a.protocol == b.protocol &&
            a.sap_target_sink == b.sap_target_sink &&
-           a.sap_target_host == b.sap_target_host;
+           a.sap_target_host == b.sap_target_host &&
+           a.resampler_quality == b.resampler_quality;
 }
 
 /**
@@ -468,6 +477,13 @@ void AudioEngineConfigApplier::process_sink_removals(const std::vector<std::stri
     for (const auto& sink_id : sink_ids_to_remove) {
         const auto t0 = std::chrono::steady_clock::now();
         LOG_CPP_DEBUG("[ConfigApplier]   - Removing sink: %s", sink_id.c_str());
+        if (sink_group_leaders_.erase(sink_id) > 0) {
+            // A grouped sink has no mixer of its own; detaching it from the leader removes it.
+            audio_manager_.remove_sink_from_group(sink_id);
+            active_sinks_.erase(sink_id);
+            LOG_CPP_INFO("[ConfigApplier]     Grouped sink %s removed", sink_id.c_str());
+            continue;
+        }
         if (audio_manager_.remove_sink(sink_id)) {
             active_sinks_.erase(sink_id);
             const auto t1 = std::chrono::steady_clock::now();
@@ -632,9 +648,28 @@ bool compare_applied_source_path_params(const AppliedSourcePathParams& a, const
            a.source_input_channels == b.source_input_channels &&
            a.source_input_samplerate == b.source_input_samplerate &&
            a.source_input_bitdepth == b.source_input_bitdepth &&
+           a.resampler_quality == b.resampler_quality &&
            layouts_equal;
 }
 
+/**
+ * @brief Checks whether two source paths are identical apart from their target sink.
+ *
+ * Same checks as compare_applied_source_path_params() apart from the target sink, plus the
+ * source tag and normalization flags. Identical paths are deduplicated onto one
+ * SourceInputProcessor. Paths that differ anywhere, even only in the speaker matrix, are not:
+ * AudioProcessor runs EQ and the output resample after the speaker mix, so no common prefix
+ * can be split off.
+ */
+bool source_paths_are_identical(const AppliedSourcePathParams& a, const AppliedSourcePathParams& b) {
+    AppliedSourcePathParams b_on_same_sink = b;
+    b_on_same_sink.target_sink_id = a.target_sink_id;
+    return a.source_tag == b.source_tag &&
+           a.eq_normalization == b.eq_normalization &&
+           a.volume_normalization == b.volume_normalization &&
+           compare_applied_source_path_params(a, b_on_same_sink);
+}
+
 /**
  * @brief Reconciles the desired source path state with the active state.
  *
@@ -719,7 +754,11 @@ void AudioEngineConfigApplier::process_source_path_removals(const std::vector<st
         if (it != active_source_paths_.end()) {
             const std::string source_tag = it->second.params.source_tag;
             const std::string& instance_id = it->second.params.generated_instance_id;
-            if (!instance_id.empty()) {
+            if (!instance_id.empty() && instance_has_other_paths(instance_id, path_id)) {
+                // Other sinks still consume this processor; only drop this path's sink.
+                audio_manager_.disconnect_source_sink(instance_id, it->second.params.target_sink_id);
+                LOG_CPP_INFO("[ConfigApplier]     Source instance %s kept; still used by identical paths on other sinks.", instance_id.c_str());
+            } else if (!instance_id.empty()) {
                 if (audio_manager_.remove_source(instance_id)) {
                     LOG_CPP_INFO("[ConfigApplier]     Source instance %s removed from AudioManager.", instance_id.c_str());
                 } else {
@@ -823,6 +862,7 @@ AudioEngineConfigApplier::SourcePathAddResult AudioEngineConfigApplier::process_
     cpp_source_config.initial_timeshift_sec = path_param_to_add.timeshift_sec;
     cpp_source_config.target_output_channels = path_param_to_add.target_output_channels;
     cpp_source_config.target_output_samplerate = path_param_to_add.target_output_samplerate;
+    cpp_source_config.resampler_quality = path_param_to_add.resampler_quality;
 
     bool added_capture_reference = false;
 
@@ -881,6 +921,17 @@ AudioEngineConfigApplier::SourcePathAddResult AudioEngineConfigApplier::process_
         }
     }
 
+    // Identical-path dedup: reuse the processor of an identical path to another sink.
+    const std::string dedup_instance_id = find_identical_path_instance(path_param_to_add, filter_tag);
+    if (!dedup_instance_id.empty()) {
+        path_param_to_add.generated_instance_id = dedup_instance_id;
+        const auto t1 = clock::now();
+        LOG_CPP_INFO("[ConfigApplier] +Path complete id='%s' deduplicated onto instance %s (total %lld ms)",
+                     path_param_to_add.path_id.c_str(), dedup_instance_id.c_str(),
+                     (long long)std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count());
+        return SourcePathAddResult::Added;
+    }
+
     // 2. Call AudioManager to configure the source and get an instance ID.
     const auto t_cfg0 = clock::now();
     std::string instance_id = audio_manager_.configure_source(cpp_source_config);
@@ -934,6 +985,10 @@ AudioEngineConfigApplier::SourcePathAddResult AudioEngineConfigApplier::process_
  */
 void AudioEngineConfigApplier::process_source_path_updates(const std::vector<AppliedSourcePathParams>& paths_to_update) {
     LOG_CPP_INFO("[ConfigApplier] Updating %zu source path(s)...", paths_to_update.size());
+    std::map<std::string, const AppliedSourcePathParams*> pending_updates;
+    for (const auto& path : paths_to_update) {
+        pending_updates[path.path_id] = &path;
+    }
     for (const auto& desired_path_param : paths_to_update) {
         const std::string& path_id = desired_path_param.path_id;
         LOG_CPP_DEBUG("[ConfigApplier]   - Updating path: %s", path_id.c_str());
@@ -962,20 +1017,20 @@ void AudioEngineConfigApplier::process_source_path_updates(const std::vector<App
             LOG_CPP_INFO("    Path %s remains wildcard-bound to filter '%s'", path_id.c_str(), filter_tag.c_str());
         }
 
-        // Check for fundamental changes requiring re-creation of the source processor.
-        bool fundamental_change =
-            current_path_state.params.source_tag != desired_params.source_tag ||
-            current_path_state.params.target_output_channels != desired_params.target_output_channels ||
-            current_path_state.params.target_output_samplerate != desired_params.target_output_samplerate ||
-            current_path_state.params.source_input_channels != desired_params.source_input_channels ||
-            current_path_state.params.source_input_samplerate != desired_params.source_input_samplerate ||
-            current_path_state.params.source_input_bitdepth != desired_params.source_input_bitdepth;
+        const PathUpdateKind update_kind =
+            classify_path_update(path_id, current_path_state, desired_params, pending_updates);
+        const bool dedup_instance = instance_has_other_paths(instance_id, path_id);
 
-        if (fundamental_change) {
+        if (update_kind != PathUpdateKind::InPlace) {
             const auto t_recreate0 = std::chrono::steady_clock::now();
-            LOG_CPP_DEBUG("[ConfigApplier]     Fundamental change detected for %s. Re-creating instance.", path_id.c_str());
-            // Remove the old instance.
-            if (!audio_manager_.remove_source(instance_id)) {
+            LOG_CPP_DEBUG("[ConfigApplier]     %s for %s. Re-creating instance.",
+                          update_kind == PathUpdateKind::Fundamental ? "Fundamental change detected"
+                                                                     : "Path no longer identical to its deduplicated paths",
+                          path_id.c_str());
+            if (dedup_instance) {
+                // Other paths keep the instance; detach only this path's sink.
+                audio_manager_.disconnect_source_sink(instance_id, current_path_state.params.target_sink_id);
+            } else if (!audio_manager_.remove_source(instance_id)) {
                  LOG_CPP_ERROR("[ConfigApplier]     Failed to remove old instance %s. Aborting this path.", instance_id.c_str());
                  continue; // Skip to the next path.
             }
@@ -993,6 +1048,10 @@ void AudioEngineConfigApplier::process_source_path_updates(const std::vector<App
                 active_source_paths_[temp_param_for_add.path_id] = std::move(state);
                 LOG_CPP_DEBUG("[ConfigApplier]     Re-created %s with new instance_id: %s",
                              path_id.c_str(), temp_param_for_add.generated_instance_id.c_str());
+                if (dedup_instance) {
+                    // The sink still lists this path, so its reconcile will not reconnect it.
+                    reconnect_path_to_sink(temp_param_for_add);
+                }
                 // Connections for this new instance_id will be re-established by the sink update logic.
             } else if (recreate_result == SourcePathAddResult::PendingStream) {
                 LOG_CPP_INFO("[ConfigApplier]     Re-create of %s pending stream match for filter '%s'",
@@ -1043,6 +1102,321 @@ void AudioEngineConfigApplier::process_source_path_updates(const std::vector<App
     }
 }
 
+AudioEngineConfigApplier::PathUpdateKind AudioEngineConfigApplier::classify_path_update(
+    const std::string& path_id,
+    const InternalSourcePathState& current,
+    const AppliedSourcePathParams& desired_params,
+    const std::map<std::string, const AppliedSourcePathParams*>& pending_updates) const {
+    // Check for fundamental changes requiring re-creation of the source processor.
+    const bool fundamental_change =
+        current.params.source_tag != desired_params.source_tag ||
+        current.params.target_output_channels != desired_params.target_output_channels ||
+        current.params.target_output_samplerate != desired_params.target_output_samplerate ||
+        current.params.source_input_channels != desired_params.source_input_channels ||
+        current.params.source_input_samplerate != desired_params.source_input_samplerate ||
+        current.params.source_input_bitdepth != desired_params.source_input_bitdepth ||
+        current.params.resampler_quality != desired_params.resampler_quality;
+    if (fundamental_change) {
+        return PathUpdateKind::Fundamental;
+    }
+
+    // A deduplicated instance can only take the update if every path using it stays identical.
+    const std::string& instance_id = current.params.generated_instance_id;
+    for (const auto& [other_path_id, other_state] : active_source_paths_) {
+        if (other_path_id == path_id || other_state.params.generated_instance_id != instance_id) {
+            continue;
+        }
+        auto pending_it = pending_updates.find(other_path_id);
+        AppliedSourcePathParams other_desired =
+            pending_it != pending_updates.end() ? *pending_it->second : other_state.params;
+        other_desired.source_tag = desired_params.source_tag;
+        if (!source_paths_are_identical(desired_params, other_desired)) {
+            return PathUpdateKind::LeavesDedupInstance;
+        }
+    }
+    return PathUpdateKind::InPlace;
+}
+
+std::string AudioEngineConfigApplier::find_identical_path_instance(const AppliedSourcePathParams& path,
+                                                                   const std::string& filter_tag) const {
+    std::set<std::string> instances_on_sink;
+    for (const auto& [path_id, state] : active_source_paths_) {
+        if (state.params.target_sink_id == path.target_sink_id) {
+            instances_on_sink.insert(state.params.generated_instance_id);
+        }
+    }
+    for (const auto& [path_id, state] : active_source_paths_) {
+        const std::string& instance_id = state.params.generated_instance_id;
+        if (instance_id.empty() || path_id == path.path_id || state.filter_tag != filter_tag) {
+            continue;
+        }
+        // A sink mixes each instance once, so never deduplicate with a path on the same sink.
+        if (instances_on_sink.count(instance_id) != 0) {
+            continue;
+        }
+        if (source_paths_are_identical(path, state.params)) {
+            return instance_id;
+        }
+    }
+    return {};
+}
+
+bool AudioEngineConfigApplier::instance_has_other_paths(const std::string& instance_id, const std::string& path_id) const {
+    for (const auto& [other_path_id, state] : active_source_paths_) {
+        if (other_path_id != path_id && state.params.generated_instance_id == instance_id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AudioEngineConfigApplier::reconnect_path_to_sink(const AppliedSourcePathParams& path) {
+    auto sink_it = active_sinks_.find(path.target_sink_id);
+    if (sink_it == active_sinks_.end()) {
+        return;
+    }
+    const auto& connected = sink_it->second.params.connected_source_path_ids;
+    if (std::find(connected.begin(), connected.end(), path.path_id) == connected.end()) {
+        return;
+    }
+    if (!audio_manager_.connect_source_sink(path.generated_instance_id, path.target_sink_id)) {
+        LOG_CPP_WARNING("[ConfigApplier]     Failed to reconnect path %s to sink %s on instance %s",
+                        path.path_id.c_str(), path.target_sink_id.c_str(), path.generated_instance_id.c_str());
+    }
+}
+
+// --- Sink Groups ---
+
+namespace {
+
+/**
+ * @brief Returns true if a sink's output can be produced by another sink's mixer.
+ * @details Limited to plain network senders. MP3 queues are drained by a single consumer,
+ *          time-synced and multi-device sinks carry per-sink timing state, and system audio
+ *          devices need their own playback clock.
+ */
+bool sink_supports_shared_mix(const audio::SinkConfig& config) {
+    return (config.protocol == "scream" || config.protocol == "rtp" || config.protocol == "rtp_opus") &&
+           !config.enable_mp3 && !config.time_sync_enabled && !config.multi_device_mode;
+}
+
+/**
+ * @brief sinks_share_mix() for explicit sink params.
+ * @param instance_of Maps a connected path ID to the instance feeding it, or an empty string
+ *                    if that is not known.
+ */
+template <typename InstanceOf>
+bool sink_params_share_mix(const AppliedSinkParams& a, const AppliedSinkParams& b, InstanceOf instance_of) {
+    const audio::SinkConfig& a_config = a.sink_engine_config;
+    if (!sink_supports_shared_mix(a_config) || !sink_supports_shared_mix(b.sink_engine_config)) {
+        return false;
+    }
+    // Everything but the destination has to match for the mixed bytes to be interchangeable.
+    audio::SinkConfig b_config = b.sink_engine_config;
+    b_config.id = a_config.id;
+    b_config.friendly_name = a_config.friendly_name;
+    b_config.system_device_tag = a_config.system_device_tag;
+    b_config.output_ip = a_config.output_ip;
+    b_config.output_port = a_config.output_port;
+    if (!compare_sink_configs(a_config, b_config) || !(a_config.speaker_layout == b_config.speaker_layout)) {
+        return false;
+    }
+
+    auto collect_instances = [&instance_of](const AppliedSinkParams& params, std::set<std::string>& instances) {
+        for (const auto& path_id : params.connected_source_path_ids) {
+            std::string instance_id = instance_of(path_id);
+            if (instance_id.empty()) {
+                return false;
+            }
+            instances.insert(std::move(instance_id));
+        }
+        return !instances.empty();
+    };
+    std::set<std::string> a_instances;
+    std::set<std::string> b_instances;
+    return collect_instances(a, a_instances) &&
+           collect_instances(b, b_instances) &&
+           a_instances == b_instances;
+}
+
+} // namespace
+
+bool AudioEngineConfigApplier::sinks_share_mix(const std::string& sink_a, const std::string& sink_b) const {
+    auto a_it = active_sinks_.find(sink_a);
+    auto b_it = active_sinks_.find(sink_b);
+    if (a_it == active_sinks_.end() || b_it == active_sinks_.end()) {
+        return false;
+    }
+    return sink_params_share_mix(a_it->second.params, b_it->second.params, [this](const std::string& path_id) {
+        auto path_it = active_source_paths_.find(path_id);
+        return path_it != active_source_paths_.end() ? path_it->second.params.generated_instance_id : std::string();
+    });
+}
+
+bool AudioEngineConfigApplier::collapse_sink_into_group(const std::string& member_id, const std::string& leader_id) {
+    auto sink_it = active_sinks_.find(member_id);
+    if (sink_it == active_sinks_.end()) {
+        return false;
+    }
+    const AppliedSinkParams member_params = sink_it->second.params;
+
+    if (!audio_manager_.remove_sink(member_id)) {
+        LOG_CPP_ERROR("[ConfigApplier] Failed to remove sink %s before grouping it with %s",
+                      member_id.c_str(), leader_id.c_str());
+        return false;
+    }
+    if (!audio_manager_.add_sink_to_group(leader_id, member_params.sink_engine_config)) {
+        LOG_CPP_WARNING("[ConfigApplier] Could not serve sink %s from %s's mix; restoring its own mixer",
+                        member_id.c_str(), leader_id.c_str());
+        if (audio_manager_.add_sink(member_params.sink_engine_config)) {
+            sink_it->second.params.connected_source_path_ids.clear();
+            reconcile_connections_for_sink(member_params);
+        } else {
+            LOG_CPP_ERROR("[ConfigApplier] Failed to re-add sink %s after grouping failed", member_id.c_str());
+            active_sinks_.erase(sink_it);
+        }
+        return false;
+    }
+
+    // The member keeps its logical connections in the shadow state so the group can be
+    // validated and the sink restored later; the engine only wires up the leader.
+    sink_group_leaders_[member_id] = leader_id;
+    LOG_CPP_INFO("[ConfigApplier] Sink %s now shares the mix of sink %s", member_id.c_str(), leader_id.c_str());
+    return true;
+}
+
+void AudioEngineConfigApplier::restore_grouped_sink(const std::string& member_id) {
+    auto group_it = sink_group_leaders_.find(member_id);
+    if (group_it == sink_group_leaders_.end()) {
+        return;
+    }
+    const std::string leader_id = group_it->second;
+    audio_manager_.remove_sink_from_group(member_id);
+    sink_group_leaders_.erase(group_it);
+
+    auto sink_it = active_sinks_.find(member_id);
+    if (sink_it == active_sinks_.end()) {
+        return;
+    }
+    const AppliedSinkParams member_params = sink_it->second.params;
+    if (!audio_manager_.add_sink(member_params.sink_engine_config)) {
+        LOG_CPP_ERROR("[ConfigApplier] Failed to give sink %s its own mixer after leaving %s's group",
+                      member_id.c_str(), leader_id.c_str());
+        active_sinks_.erase(sink_it);
+        return;
+    }
+    sink_it->second.params.connected_source_path_ids.clear();
+    reconcile_connections_for_sink(member_params);
+    LOG_CPP_INFO("[ConfigApplier] Sink %s left the mix group of sink %s", member_id.c_str(), leader_id.c_str());
+}
+
+void AudioEngineConfigApplier::restore_groups_touched_by(const std::vector<std::string>& sink_ids_to_remove,
+                                                         const std::vector<AppliedSinkParams>& sinks_to_update,
+                                                         const std::vector<std::string>& path_ids_to_remove,
+                                                         const std::vector<AppliedSourcePathParams>& paths_to_update) {
+    if (sink_group_leaders_.empty()) {
+        return;
+    }
+    std::set<std::string> removing(sink_ids_to_remove.begin(), sink_ids_to_remove.end());
+    // Sink updates re-create or rewire the engine sink, which a grouped member does not have.
+    std::set<std::string> updating;
+    for (const auto& sink : sinks_to_update) {
+        updating.insert(sink.sink_id);
+    }
+    std::set<std::string> removed_paths(path_ids_to_remove.begin(), path_ids_to_remove.end());
+    std::map<std::string, const AppliedSourcePathParams*> pending_updates;
+    for (const auto& path : paths_to_update) {
+        pending_updates[path.path_id] = &path;
+    }
+
+    // The instance each path will feed once the updates are applied. Updates that re-create
+    // the instance, and removed paths, have none yet, which keeps the sinks apart.
+    auto instance_after_updates = [&](const std::string& path_id) {
+        auto path_it = active_source_paths_.find(path_id);
+        if (path_it == active_source_paths_.end() || removed_paths.count(path_id)) {
+            return std::string();
+        }
+        auto pending_it = pending_updates.find(path_id);
+        if (pending_it != pending_updates.end()) {
+            AppliedSourcePathParams desired_params = *pending_it->second;
+            if (!desired_params.source_tag.empty() && desired_params.source_tag.back() == '*') {
+                desired_params.source_tag = get_filter_for_path_id(path_id, desired_params.source_tag);
+            }
+            if (classify_path_update(path_id, path_it->second, desired_params, pending_updates) !=
+                PathUpdateKind::InPlace) {
+                return std::string();
+            }
+        }
+        return path_it->second.params.generated_instance_id;
+    };
+
+    // Removed members are simply detached by process_sink_removals. Path parameter updates
+    // that every grouped path takes alike are applied in place to the instances the leader
+    // mixes, so those groups stay as they are.
+    std::vector<std::string> to_restore;
+    for (const auto& [member_id, leader_id] : sink_group_leaders_) {
+        if (removing.count(member_id)) {
+            continue;
+        }
+        if (removing.count(leader_id) || updating.count(member_id) || updating.count(leader_id)) {
+            to_restore.push_back(member_id);
+            continue;
+        }
+        auto member_it = active_sinks_.find(member_id);
+        auto leader_it = active_sinks_.find(leader_id);
+        if (member_it == active_sinks_.end() || leader_it == active_sinks_.end() ||
+            !sink_params_share_mix(member_it->second.params, leader_it->second.params, instance_after_updates)) {
+            to_restore.push_back(member_id);
+        }
+    }
+    for (const auto& member_id : to_restore) {
+        restore_grouped_sink(member_id);
+    }
+}
+
+void AudioEngineConfigApplier::reconcile_sink_groups() {
+    std::vector<std::string> stale;
+    for (const auto& [member_id, leader_id] : sink_group_leaders_) {
+        if (sink_group_leaders_.count(leader_id) || !sinks_share_mix(member_id, leader_id)) {
+            stale.push_back(member_id);
+        }
+    }
+    for (const auto& member_id : stale) {
+        restore_grouped_sink(member_id);
+    }
+
+    std::set<std::string> current_leaders;
+    for (const auto& [member_id, leader_id] : sink_group_leaders_) {
+        (void)member_id;
+        current_leaders.insert(leader_id);
+    }
+    std::vector<std::string> candidates;
+    for (const auto& [sink_id, state] : active_sinks_) {
+        (void)state;
+        if (!sink_group_leaders_.count(sink_id)) {
+            candidates.push_back(sink_id);
+        }
+    }
+
+    // First matching sink in ID order leads; sinks that already lead keep their own mixer.
+    std::vector<std::string> leaders;
+    for (const auto& sink_id : candidates) {
+        bool grouped = false;
+        // Grouping replaces the sink's mixer, which would drop its listeners.
+        if (!current_leaders.count(sink_id) && !audio_manager_.sink_has_listeners(sink_id)) {
+            for (const auto& leader_id : leaders) {
+                if (sinks_share_mix(sink_id, leader_id)) {
+                    grouped = collapse_sink_into_group(sink_id, leader_id);
+                    break;
+                }
+            }
+        }
+        if (!grouped && active_sinks_.count(sink_id)) {
+            leaders.push_back(sink_id);
+        }
+    }
+}
+
 // --- Connection Management ---
 
 /**
@@ -95,6 +95,8 @@ private:
     };
     /** @brief Map storing active sinks, keyed by sink_id. */
     std::map<std::string, InternalSinkState> active_sinks_;
+    /** @brief Sinks currently served by another sink's mixer: member sink_id -> leader sink_id. */
+    std::map<std::string, std::string> sink_group_leaders_;
 
     // --- Private Helper Methods ---
 
@@ -132,6 +134,57 @@ private:
     SourcePathAddResult process_source_path_addition(AppliedSourcePathParams& path_to_add, const std::string& filter_tag);
     void process_source_path_updates(const std::vector<AppliedSourcePathParams>& paths_to_update);
 
+    /**
+     * @brief Identical-path dedup: finds the instance of an active path identical to @p path.
+     * @details Paths to different sinks that match in every processing parameter run on one
+     *          SourceInputProcessor, whose output is fanned out to every connected sink. Paths
+     *          that differ in any stage, including only the speaker matrix, get their own.
+     * @return The instance ID to reuse, or an empty string if none matches.
+     */
+    std::string find_identical_path_instance(const AppliedSourcePathParams& path, const std::string& filter_tag) const;
+    /** @brief How an update to an active source path has to be applied. */
+    enum class PathUpdateKind {
+        InPlace,            ///< Parameter update on the path's current instance.
+        Fundamental,        ///< Format or source changed; the instance is re-created.
+        LeavesDedupInstance ///< No longer identical to the paths sharing its instance.
+    };
+    /**
+     * @brief Classifies an update of @p current to @p desired_params.
+     * @param desired_params Desired parameters with a wildcard source tag already resolved.
+     * @param pending_updates Every path update of this apply cycle, keyed by path ID.
+     */
+    PathUpdateKind classify_path_update(const std::string& path_id,
+                                        const InternalSourcePathState& current,
+                                        const AppliedSourcePathParams& desired_params,
+                                        const std::map<std::string, const AppliedSourcePathParams*>& pending_updates) const;
+    /** @brief Returns true if any active path other than @p path_id uses @p instance_id. */
+    bool instance_has_other_paths(const std::string& instance_id, const std::string& path_id) const;
+    /** @brief Re-establishes a path's connection to its sink if the sink lists it as connected. */
+    void reconnect_path_to_sink(const AppliedSourcePathParams& path);
+
+    // --- Sink Groups ---
+
+    /**
+     * @brief Returns true if two active sinks can be served by one mixer.
+     * @details Both sinks must use a plain network protocol, produce the same output format
+     *          and be connected to the same, non-empty set of source instances.
+     */
+    bool sinks_share_mix(const std::string& sink_a, const std::string& sink_b) const;
+    /** @brief Tears down a sink's own mixer and serves it from @p leader_id's mix instead. */
+    bool collapse_sink_into_group(const std::string& member_id, const std::string& leader_id);
+    /** @brief Gives a grouped sink its own mixer again and re-establishes its connections. */
+    void restore_grouped_sink(const std::string& member_id);
+    /**
+     * @brief Restores grouped sinks that this apply cycle would split, before changes are made.
+     * @details Groups survive path updates that keep every path on its current instance.
+     */
+    void restore_groups_touched_by(const std::vector<std::string>& sink_ids_to_remove,
+                                   const std::vector<AppliedSinkParams>& sinks_to_update,
+                                   const std::vector<std::string>& path_ids_to_remove,
+                                   const std::vector<AppliedSourcePathParams>& paths_to_update);
+    /** @brief Re-evaluates group membership against the current connections. */
+    void reconcile_sink_groups();
+
     /**
      * @brief Reconciles the connections for a specific sink.
      * @param desired_sink_params The desired parameters for the sink, including its connections.
@@ -78,6 +78,8 @@ struct AppliedSourcePathParams {
     int source_input_samplerate;
     /** @brief Preferred input bit depth for the capture/source side. */
     int source_input_bitdepth;
+    /** @brief Resampler converter used by this path's source processor. */
+    screamrouter::audio::ResamplerQuality resampler_quality = screamrouter::audio::ResamplerQuality::SINC_MEDIUM;
     
     /** @brief A unique ID for the processor instance, generated by the C++ backend. */
     std::string generated_instance_id;
@@ -162,6 +164,7 @@ inline void bind_config_types(pybind11::module_ &m) {
         .def_readwrite("source_input_channels", &AppliedSourcePathParams::source_input_channels, "Preferred input channel count for capture")
         .def_readwrite("source_input_samplerate", &AppliedSourcePathParams::source_input_samplerate, "Preferred input sample rate for capture")
         .def_readwrite("source_input_bitdepth", &AppliedSourcePathParams::source_input_bitdepth, "Preferred input bit depth for capture")
+        .def_readwrite("resampler_quality", &AppliedSourcePathParams::resampler_quality, "Resampler quality tier for this path")
         .def_readwrite("generated_instance_id", &AppliedSourcePathParams::generated_instance_id, "(Read-only from Python perspective) Instance ID generated by C++")
         .def_readwrite("speaker_layouts_map", &AppliedSourcePathParams::speaker_layouts_map, "Map of input channel counts to CppSpeakerLayout objects");
 
@@ -97,6 +97,9 @@ struct MixerTuning {
 struct SourceProcessorTuning {
     long command_loop_sleep_ms = 20;
     long discontinuity_threshold_ms = 100;
+    // Skip the DSP chain for all-zero input once filter tails have had this long to decay.
+    bool silence_gate_enabled = true;
+    long silence_gate_tail_ms = 250;
 };
 
 struct ProcessorTuning {
@@ -142,6 +145,9 @@ struct SystemAudioTuning {
     double alsa_latency_reconfig_cooldown_ms = 4000.0;
     double alsa_latency_xrun_boost_ms = 5.0;
     double alsa_latency_low_step_ms = 3.0;            // step added immediately when buffer dips low
+    bool alsa_mmap_enabled = true;                    // move PCM straight between packets/mixer and the device ring when mmap access is available
+    bool alsa_timer_scheduling_enabled = false;       // clock mix ticks from the device's hw pointer instead of the system timer
+    double alsa_timer_target_fill_ms = 4.0;           // audio left queued in the device when a device-clocked tick runs
 };
 
 class AudioEngineSettings {
@@ -8,6 +8,10 @@
 #include "../utils/profiler.h"
 #include "../utils/thread_priority.h"
 #include "../utils/sentinel_logging.h"
+#include "../utils/span_tracer.h"
+#include "../utils/audio_clock.h"
+#include "../utils/realtime_scope.h"
+#include "../audio_processor/silence_detect.h"
 
 #ifdef min
 
@@ -24,6 +28,10 @@ namespace {
 constexpr double kMinPlaybackRate = 0.5;
 constexpr double kMaxPlaybackRate = 2.0;
 constexpr double kPlaybackRateEpsilon = 1e-6;  // Allow rate changes as small as 1 ppm
+// A mixer holds one chunk per source and queues a few more; spares beyond that are just freed.
+constexpr size_t kMaxSpareChunks = 8;
+// Fragments waiting for a chunk are usually a handful of packets; the ring grows past this if not.
+constexpr size_t kInitialFragmentSlots = 32;
 }
 
 const std::chrono::milliseconds TIMESIFT_CLEANUP_INTERVAL(1000);
@@ -56,6 +64,9 @@ SourceInputProcessor::SourceInputProcessor(
         current_eq_.assign(EQ_BANDS, 1.0f);
         config_.initial_eq = current_eq_; // Update config_ member
     }
+    sentinel_context_ = " [instance=" + config_.instance_id + "]";
+    spare_chunks_.reserve(kMaxSpareChunks);
+    input_fragments_.resize(kInitialFragmentSlots);
 
     audio_processor_ = nullptr; // Set audio_processor_ to nullptr initially
     LOG_CPP_INFO("[SourceProc:%s] Initialization complete.", config_.instance_id.c_str());
@@ -121,13 +132,21 @@ SourceInputProcessorStats SourceInputProcessor::get_stats() {
     } else {
         stats.resample_ratio = 0.0;
     }
+    stats.resampler_quality = config_.resampler_quality;
+    {
+        std::lock_guard<std::mutex> lock(processor_config_mutex_);
+        stats.resampler_cpu_ns = m_retired_resampler_cpu_ns +
+            (audio_processor_ ? audio_processor_->get_resampler_cpu_ns() : 0);
+    }
+    stats.silent_chunks_gated = m_silent_chunks_gated.load();
+    stats.silence_saved_ns = m_silence_saved_ns.load();
 
     if (profiling_processing_samples_ > 0) {
         stats.avg_loop_ms = (static_cast<double>(profiling_processing_ns_) / 1'000'000.0) /
             static_cast<double>(profiling_processing_samples_);
     }
 
-    auto now = std::chrono::steady_clock::now();
+    auto now = utils::AudioClock::now();
     if (m_last_packet_time.time_since_epoch().count() != 0) {
         stats.last_packet_age_ms = std::chrono::duration<double, std::milli>(now - m_last_packet_time).count();
         if (stats.last_packet_age_ms < 0.0) {
@@ -292,13 +311,16 @@ void SourceInputProcessor::apply_control_command(const ControlCommand& cmd) {
 
 void SourceInputProcessor::ingest_packet(const TaggedAudioPacket& timed_packet, std::vector<ProcessedAudioChunk>& out_chunks) {
     PROFILE_FUNCTION();
+    SR_TRACE_SPAN_FLOW("sip_process", timed_packet.trace_flow_id);
+    SR_RT_SCOPE("SourceInputProcessor::ingest_packet");
     m_total_packets_processed++;
     profiling_packets_received_++;
     auto loop_start = std::chrono::steady_clock::now();
-    utils::log_sentinel("sip_ingest", timed_packet, " [instance=" + config_.instance_id + "]");
+    const size_t first_new_chunk = out_chunks.size();
+    utils::log_sentinel("sip_ingest", timed_packet, sentinel_context_);
 
     // --- Discontinuity Detection ---
-    auto now = std::chrono::steady_clock::now();
+    auto now = utils::AudioClock::now();
     const long configured_discontinuity_ms =
         (m_settings && m_settings->source_processor_tuning.discontinuity_threshold_ms > 0)
             ? m_settings->source_processor_tuning.discontinuity_threshold_ms
@@ -359,31 +381,29 @@ void SourceInputProcessor::ingest_packet(const TaggedAudioPacket& timed_packet,
     if (packet_ok_for_processing && audio_processor_) {
         append_to_input_accumulator(timed_packet);
 
-        std::vector<uint8_t> chunk_data_for_processing;
         std::chrono::steady_clock::time_point chunk_origin{};
         std::optional<uint32_t> chunk_rtp;
-        std::vector<uint32_t> chunk_ssrcs;
         bool chunk_is_sentinel = false;
 
         while (try_dequeue_input_chunk(
-            chunk_data_for_processing,
+            chunk_scratch_,
             chunk_origin,
             chunk_rtp,
-            chunk_ssrcs,
+            chunk_ssrcs_scratch_,
             chunk_is_sentinel)) {
-            current_packet_ssrcs_ = chunk_ssrcs.empty() ? timed_packet.ssrcs : chunk_ssrcs;
+            current_packet_ssrcs_ = chunk_ssrcs_scratch_.empty() ? timed_packet.ssrcs : chunk_ssrcs_scratch_;
             m_last_packet_origin_time = chunk_origin;
 
             if (chunk_is_sentinel) {
                 ProcessedAudioChunk marker{};
                 marker.is_sentinel = true;
                 marker.origin_time = chunk_origin;
-                utils::log_sentinel("sip_chunk_dequeued", marker, " [instance=" + config_.instance_id + "]");
+                utils::log_sentinel("sip_chunk_dequeued", marker, sentinel_context_);
             }
 
-            process_audio_chunk(chunk_data_for_processing, chunk_is_sentinel);
+            process_audio_chunk(chunk_scratch_, chunk_is_sentinel);
             push_output_chunk_if_ready(out_chunks);
-            chunk_data_for_processing.clear();
+            chunk_scratch_.clear();
         }
         (void)chunk_rtp;
     } else {
@@ -392,6 +412,11 @@ void SourceInputProcessor::ingest_packet(const TaggedAudioPacket& timed_packet,
         LOG_CPP_WARNING("[SourceProc:%s] Packet discarded by ingest_packet due to format/size issues or no audio processor.", config_.instance_id.c_str());
     }
 
+    for (size_t i = first_new_chunk; i < out_chunks.size(); ++i) {
+        out_chunks[i].trace_flow_id = timed_packet.trace_flow_id;
+    }
+    fan_out_chunks(out_chunks, first_new_chunk);
+
     auto loop_end = std::chrono::steady_clock::now();
     profiling_processing_ns_ += std::chrono::duration_cast<std::chrono::nanoseconds>(loop_end - loop_start).count();
     profiling_processing_samples_++;
@@ -399,6 +424,50 @@ void SourceInputProcessor::ingest_packet(const TaggedAudioPacket& timed_packet,
     maybe_log_telemetry(loop_end);
 }
 
+void SourceInputProcessor::add_dedup_output(const std::string& sink_id, std::weak_ptr<ProcessedChunkRing> ring) {
+    std::lock_guard<std::mutex> lock(dedup_outputs_mutex_);
+    dedup_outputs_[sink_id] = std::move(ring);
+    LOG_CPP_INFO("[SourceProc:%s] Fanning processed output out to sink %s (%zu deduplicated paths).",
+                 config_.instance_id.c_str(), sink_id.c_str(), dedup_outputs_.size());
+}
+
+void SourceInputProcessor::remove_dedup_output(const std::string& sink_id) {
+    std::lock_guard<std::mutex> lock(dedup_outputs_mutex_);
+    if (dedup_outputs_.erase(sink_id) > 0) {
+        LOG_CPP_INFO("[SourceProc:%s] Stopped fanning processed output out to sink %s.",
+                     config_.instance_id.c_str(), sink_id.c_str());
+    }
+}
+
+size_t SourceInputProcessor::get_dedup_output_count() const {
+    std::lock_guard<std::mutex> lock(dedup_outputs_mutex_);
+    return dedup_outputs_.size();
+}
+
+void SourceInputProcessor::recycle_chunk(ProcessedAudioChunk&& chunk) {
+    if (spare_chunks_.size() < kMaxSpareChunks && chunk.audio_data.capacity() > 0) {
+        spare_chunks_.push_back(std::move(chunk));
+    }
+}
+
+void SourceInputProcessor::fan_out_chunks(const std::vector<ProcessedAudioChunk>& out_chunks, size_t first_new) {
+    if (first_new >= out_chunks.size()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(dedup_outputs_mutex_);
+    for (auto it = dedup_outputs_.begin(); it != dedup_outputs_.end();) {
+        auto ring = it->second.lock();
+        if (!ring) {
+            it = dedup_outputs_.erase(it);
+            continue;
+        }
+        for (size_t i = first_new; i < out_chunks.size(); ++i) {
+            ring->push(out_chunks[i]);
+        }
+        ++it;
+    }
+}
+
 void SourceInputProcessor::process_audio_chunk(const std::vector<uint8_t>& input_chunk_data, bool is_sentinel_chunk) {
     PROFILE_FUNCTION();
     if (!audio_processor_) {
@@ -409,11 +478,21 @@ void SourceInputProcessor::process_audio_chunk(const std::vector<uint8_t>& input
     LOG_CPP_DEBUG("[SourceProc:%s] ProcessAudio: Processing chunk. Input Size=%zu bytes (variable input resampling).",
                   config_.instance_id.c_str(), input_bytes);
     // Variable input resampling: input size varies based on playback_rate, no fixed size check
-    
-    // Allocate a temporary output buffer large enough to hold the maximum possible output
-    // Size based on input bytes with safety margin (x2) to handle any resampling expansion
+
+    if (try_gate_silent_chunk(input_chunk_data, is_sentinel_chunk)) {
+        return;
+    }
+
+    // Output scratch large enough to hold the maximum possible output.
+    // Size based on input bytes with safety margin (x2) to handle any resampling expansion;
+    // it only grows, so steady state reuses the same storage.
     size_t alloc_size_bytes = std::max(current_input_chunk_bytes_, input_bytes) * 2;
-    std::vector<int32_t> processor_output_buffer(alloc_size_bytes * MAX_CHANNELS * 4 / sizeof(int32_t));
+    const size_t required_output_samples = alloc_size_bytes * MAX_CHANNELS * 4 / sizeof(int32_t);
+    if (processor_output_scratch_.size() < required_output_samples) {
+        // Headroom covers the ±10% input-size swing from rate control without regrowing.
+        processor_output_scratch_.resize(required_output_samples + required_output_samples / 4);
+    }
+    std::vector<int32_t>& processor_output_buffer = processor_output_scratch_;
 
     int actual_samples_processed = 0;
     { // Lock mutex for accessing AudioProcessor
@@ -424,7 +503,18 @@ void SourceInputProcessor::process_audio_chunk(const std::vector<uint8_t>& input
         }
         // Pass the data pointer and size (current_input_chunk_bytes_)
         // processAudio now returns the actual number of samples written to processor_output_buffer.data()
+        const auto t_dsp0 = std::chrono::steady_clock::now();
         actual_samples_processed = audio_processor_->processAudio(input_chunk_data.data(), processor_output_buffer.data());
+        const auto t_dsp1 = std::chrono::steady_clock::now();
+        if (input_bytes_per_frame_ > 0 && input_bytes >= input_bytes_per_frame_) {
+            // Running per-frame DSP cost, used to report what silence gating saves.
+            const double ns_per_frame =
+                static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(t_dsp1 - t_dsp0).count()) /
+                static_cast<double>(input_bytes / input_bytes_per_frame_);
+            avg_process_ns_per_input_frame_ = (avg_process_ns_per_input_frame_ == 0.0)
+                ? ns_per_frame
+                : avg_process_ns_per_input_frame_ * 0.95 + ns_per_frame * 0.05;
+        }
     }
 
     if (actual_samples_processed > 0) {
@@ -433,6 +523,12 @@ void SourceInputProcessor::process_audio_chunk(const std::vector<uint8_t>& input
         
         // Append the correctly processed samples to the internal process_buffer_
         try {
+            // Grow geometrically: a range insert only grows to fit, so a slowly creeping
+            // peak would otherwise reallocate on the audio path again and again.
+            const size_t needed_samples = process_buffer_.size() + samples_to_insert;
+            if (process_buffer_.capacity() < needed_samples) {
+                process_buffer_.reserve(needed_samples * 2);
+            }
             process_buffer_.insert(process_buffer_.end(),
                                    processor_output_buffer.begin(),
                                    processor_output_buffer.begin() + samples_to_insert);
@@ -462,6 +558,46 @@ void SourceInputProcessor::process_audio_chunk(const std::vector<uint8_t>& input
     }
 }
 
+bool SourceInputProcessor::try_gate_silent_chunk(const std::vector<uint8_t>& input_chunk_data, bool is_sentinel_chunk) {
+    if (input_bytes_per_frame_ == 0 || !is_digital_silence(input_chunk_data.data(), input_chunk_data.size())) {
+        silent_input_frames_run_ = 0;
+        silence_output_frame_remainder_ = 0.0;
+        return false;
+    }
+    const size_t input_frames = input_chunk_data.size() / input_bytes_per_frame_;
+    const bool gate_enabled = !m_settings || m_settings->source_processor_tuning.silence_gate_enabled;
+    const long tail_ms = m_settings ? std::max(0L, m_settings->source_processor_tuning.silence_gate_tail_ms) : 250L;
+    const size_t tail_frames = static_cast<size_t>(
+        (static_cast<double>(tail_ms) * static_cast<double>(std::max(1, m_current_ap_input_samplerate))) / 1000.0);
+
+    // Keep running the DSP until EQ, DC filter and resampler state have flushed to zero;
+    // sentinel chunks always take the full path so their markers are tracked normally.
+    if (!gate_enabled || is_sentinel_chunk || silent_input_frames_run_ < tail_frames ||
+        m_current_ap_input_samplerate <= 0 || config_.output_samplerate <= 0) {
+        silent_input_frames_run_ += input_frames;
+        return false;
+    }
+    silent_input_frames_run_ += input_frames;
+
+    // Emit exactly the number of frames the resampler would have produced so chunk
+    // cadence, timestamps and rate control are unaffected.
+    const double exact_frames =
+        (static_cast<double>(input_frames) * static_cast<double>(config_.output_samplerate)) /
+            (static_cast<double>(m_current_ap_input_samplerate) * current_playback_rate_) +
+        silence_output_frame_remainder_;
+    const size_t output_frames = static_cast<size_t>(exact_frames);
+    silence_output_frame_remainder_ = exact_frames - static_cast<double>(output_frames);
+    process_buffer_.insert(process_buffer_.end(),
+                           output_frames * static_cast<size_t>(std::max(1, config_.output_channels)),
+                           0);
+
+    m_silent_chunks_gated.fetch_add(1, std::memory_order_relaxed);
+    m_silence_saved_ns.fetch_add(
+        static_cast<uint64_t>(avg_process_ns_per_input_frame_ * static_cast<double>(input_frames)),
+        std::memory_order_relaxed);
+    return true;
+}
+
 void SourceInputProcessor::push_output_chunk_if_ready(std::vector<ProcessedAudioChunk>& out_chunks) {
     PROFILE_FUNCTION();
     // Check if we have enough samples for a full output chunk
@@ -472,10 +608,16 @@ void SourceInputProcessor::push_output_chunk_if_ready(std::vector<ProcessedAudio
 
     while (current_buffer_size >= required_samples) {
         ProcessedAudioChunk output_chunk;
+        if (!spare_chunks_.empty()) {
+            // Reuse a recycled chunk's buffers; without one, handing a chunk downstream allocates.
+            output_chunk.audio_data = std::move(spare_chunks_.back().audio_data);
+            output_chunk.ssrcs = std::move(spare_chunks_.back().ssrcs);
+            spare_chunks_.pop_back();
+        }
         // Copy the required number of samples
          output_chunk.audio_data.assign(process_buffer_.begin(), process_buffer_.begin() + required_samples);
          output_chunk.ssrcs = current_packet_ssrcs_;
-         output_chunk.produced_time = std::chrono::steady_clock::now();
+         output_chunk.produced_time = utils::AudioClock::now();
          
          // Adjust origin_time for playback rate dilation
          // When rate > 1.0, we're consuming audio faster than real-time
@@ -494,12 +636,13 @@ void SourceInputProcessor::push_output_chunk_if_ready(std::vector<ProcessedAudio
          
          output_chunk.playback_rate = current_playback_rate_;
          output_chunk.is_sentinel = pending_sentinel_samples_ > 0;
+         output_chunk.is_silent = is_digital_silence(output_chunk.audio_data.data(), output_chunk.audio_data.size());
          size_t pushed_samples = output_chunk.audio_data.size();
          if (pending_sentinel_samples_ > 0) {
              const std::size_t consumed = std::min<std::size_t>(pending_sentinel_samples_, pushed_samples);
              pending_sentinel_samples_ -= consumed;
          }
-         utils::log_sentinel("sip_output_chunk", output_chunk, " [instance=" + config_.instance_id + "]");
+         utils::log_sentinel("sip_output_chunk", output_chunk, sentinel_context_);
 
          out_chunks.emplace_back(std::move(output_chunk));
          profiling_chunks_pushed_++;
@@ -518,7 +661,8 @@ void SourceInputProcessor::reset_input_accumulator() {
     PROFILE_FUNCTION();
     input_ring_buffer_.clear();
     input_ring_base_offset_ = 0;
-    input_fragments_.clear();
+    input_fragments_head_ = 0;
+    input_fragments_count_ = 0;
     input_chunk_active_ = false;
     first_fragment_time_ = {};
     first_fragment_rtp_timestamp_.reset();
@@ -555,15 +699,34 @@ void SourceInputProcessor::append_to_input_accumulator(const TaggedAudioPacket&
 
     input_ring_buffer_.write(packet.audio_data.data(), packet.audio_data.size());
 
-    InputFragmentMetadata meta;
+    InputFragmentMetadata& meta = push_input_fragment();
     meta.bytes = packet.audio_data.size();
     meta.consumed_bytes = 0;
     meta.received_time = packet.received_time;
     meta.rtp_timestamp = packet.rtp_timestamp;
-    meta.ssrcs = packet.ssrcs;
+    meta.ssrcs.assign(packet.ssrcs.begin(), packet.ssrcs.end());
     meta.is_sentinel = packet.is_sentinel;
-    input_fragments_.push_back(std::move(meta));
-    utils::log_sentinel("sip_append", packet, " [instance=" + config_.instance_id + "]");
+    utils::log_sentinel("sip_append", packet, sentinel_context_);
+}
+
+SourceInputProcessor::InputFragmentMetadata& SourceInputProcessor::push_input_fragment() {
+    if (input_fragments_count_ == input_fragments_.size()) {
+        SR_RT_ALLOW("sip: fragment ring grows past its previous peak");
+        std::vector<InputFragmentMetadata> grown(std::max(input_fragments_.size() * 2, kInitialFragmentSlots));
+        for (std::size_t i = 0; i < input_fragments_count_; ++i) {
+            grown[i] = std::move(input_fragments_[(input_fragments_head_ + i) % input_fragments_.size()]);
+        }
+        input_fragments_.swap(grown);
+        input_fragments_head_ = 0;
+    }
+    const std::size_t slot = (input_fragments_head_ + input_fragments_count_) % input_fragments_.size();
+    ++input_fragments_count_;
+    return input_fragments_[slot];
+}
+
+void SourceInputProcessor::pop_input_fragment() {
+    input_fragments_head_ = (input_fragments_head_ + 1) % input_fragments_.size();
+    --input_fragments_count_;
 }
 
 bool SourceInputProcessor::try_dequeue_input_chunk(std::vector<uint8_t>& chunk_data,
@@ -615,10 +778,10 @@ bool SourceInputProcessor::try_dequeue_input_chunk(std::vector<uint8_t>& chunk_d
 
     // Track fragment consumption based on actual variable bytes popped
     std::size_t remaining = bytes_popped;  // Use actual bytes, not fixed chunk size
-    while (remaining > 0 && !input_fragments_.empty()) {
-        auto& fragment = input_fragments_.front();
+    while (remaining > 0 && input_fragments_count_ > 0) {
+        auto& fragment = input_fragments_[input_fragments_head_];
         if (fragment.consumed_bytes >= fragment.bytes) {
-            input_fragments_.pop_front();
+            pop_input_fragment();
             continue;
         }
         if (fragment.is_sentinel) {
@@ -643,20 +806,20 @@ bool SourceInputProcessor::try_dequeue_input_chunk(std::vector<uint8_t>& chunk_d
         remaining -= take;
 
         if (fragment.consumed_bytes == fragment.bytes) {
-            input_fragments_.pop_front();
+            pop_input_fragment();
         }
     }
 
     if (chunk_time == std::chrono::steady_clock::time_point{}) {
         chunk_time = first_fragment_time_;
         if (chunk_time == std::chrono::steady_clock::time_point{}) {
-            chunk_time = std::chrono::steady_clock::now();
+            chunk_time = utils::AudioClock::now();
         }
     }
 
-    if (!input_fragments_.empty()) {
+    if (input_fragments_count_ > 0) {
         input_chunk_active_ = true;
-        const auto& head = input_fragments_.front();
+        const auto& head = input_fragments_[input_fragments_head_];
         first_fragment_time_ = head.received_time;
         if (head.rtp_timestamp.has_value()) {
             const std::size_t frame_offset = head.consumed_bytes / input_bytes_per_frame_;
@@ -850,6 +1013,9 @@ bool SourceInputProcessor::check_format_and_reconfigure(
                      config_.instance_id.c_str(), target_ap_input_channels, target_ap_input_samplerate, target_ap_input_bitdepth,
                      config_.output_channels, config_.output_samplerate);
         try {
+            if (audio_processor_) {
+                m_retired_resampler_cpu_ns += audio_processor_->get_resampler_cpu_ns();
+            }
             audio_processor_ = std::make_unique<AudioProcessor>(
                 target_ap_input_channels,
                 config_.output_channels,
@@ -859,9 +1025,12 @@ bool SourceInputProcessor::check_format_and_reconfigure(
                 current_volume_,
                 current_speaker_layouts_map_,
                 m_settings,
-                expected_chunk_bytes);
+                expected_chunk_bytes,
+                config_.resampler_quality);
 
             audio_processor_->setEqualizer(current_eq_.data());
+            silent_input_frames_run_ = 0;
+            silence_output_frame_remainder_ = 0.0;
             const double safe_rate = std::clamp(current_playback_rate_, kMinPlaybackRate, kMaxPlaybackRate);
             audio_processor_->set_playback_rate(safe_rate);
 
@@ -18,7 +18,6 @@
 
 #include <string>
 #include <vector>
-#include <deque>
 #include <chrono>
 #include <memory>
 #include <mutex>
@@ -55,6 +54,10 @@ struct SourceInputProcessorStats {
     double input_samplerate = 0.0;
     double output_samplerate = 0.0;
     double resample_ratio = 0.0;
+    ResamplerQuality resampler_quality = ResamplerQuality::SINC_MEDIUM;
+    uint64_t resampler_cpu_ns = 0;
+    uint64_t silent_chunks_gated = 0;
+    uint64_t silence_saved_ns = 0;
 };
 
 /** @brief The size of the raw Scream protocol header in bytes. */
@@ -125,6 +128,27 @@ public:
      */
     void ingest_packet(const TaggedAudioPacket& packet, std::vector<ProcessedAudioChunk>& out_chunks);
 
+    /**
+     * @brief Registers an extra sink that receives a copy of every chunk this processor produces.
+     * @details Identical-path dedup: when identical paths target different sinks, one
+     *          sink's mixer drives ingest_packet(), the others read from their own ring.
+     * @param sink_id The sink the ring feeds.
+     * @param ring The ring to push produced chunks into. Held weakly.
+     */
+    void add_dedup_output(const std::string& sink_id, std::weak_ptr<ProcessedChunkRing> ring);
+    /** @brief Stops fanning chunks out to the given sink. */
+    void remove_dedup_output(const std::string& sink_id);
+    /** @brief Returns the number of extra sinks currently fed by this processor. */
+    size_t get_dedup_output_count() const;
+
+    /**
+     * @brief Hands back a chunk this processor produced once the consumer is done with it.
+     * @details Its sample and SSRC buffers back a later chunk, so a driver that recycles what it
+     *          consumes keeps ingest_packet() free of allocations. Call from the thread that
+     *          drives ingest_packet(). Chunks beyond the spare pool's capacity are freed.
+     */
+    void recycle_chunk(ProcessedAudioChunk&& chunk);
+
     // --- setters (formerly command queue driven) ---
     void set_volume(float vol);
     void set_eq(const std::vector<float>& eq_values);
@@ -161,6 +185,14 @@ private:
 
     std::vector<int32_t> process_buffer_;
     std::vector<uint32_t> current_packet_ssrcs_;
+    /** @brief Per-chunk scratch reused across ingest_packet() calls so steady state does not allocate. */
+    std::vector<uint8_t> chunk_scratch_;
+    std::vector<uint32_t> chunk_ssrcs_scratch_;
+    std::vector<int32_t> processor_output_scratch_;
+    /** @brief Consumed chunks returned through recycle_chunk(), reused by the next output chunks. */
+    std::vector<ProcessedAudioChunk> spare_chunks_;
+    /** @brief " [instance=<id>]" suffix for sentinel logs, built once. */
+    std::string sentinel_context_;
     double m_current_input_chunk_ms = 0.0;
     double m_current_output_chunk_ms = 0.0;
 
@@ -179,6 +211,8 @@ private:
     std::atomic<uint64_t> m_total_chunks_pushed{0};
     std::atomic<uint64_t> m_total_discarded_packets{0};
     std::atomic<size_t> m_process_buffer_high_water{0};
+    /** @brief Resampler time accumulated by AudioProcessor instances replaced on reconfiguration. */
+    uint64_t m_retired_resampler_cpu_ns = 0;
     std::chrono::steady_clock::time_point m_last_packet_time;
     std::chrono::steady_clock::time_point m_last_packet_origin_time;
     bool m_is_first_packet_after_discontinuity = true;
@@ -196,6 +230,12 @@ private:
     void process_audio_chunk(const std::vector<uint8_t>& input_chunk_data, bool is_sentinel_chunk);
     
     void push_output_chunk_if_ready(std::vector<ProcessedAudioChunk>& out_chunks);
+    /**
+     * @brief Appends the zero output a silent input chunk would have produced, without running DSP.
+     * @return true if the chunk was gated, false if it must go through the AudioProcessor.
+     */
+    bool try_gate_silent_chunk(const std::vector<uint8_t>& input_chunk_data, bool is_sentinel_chunk);
+    void fan_out_chunks(const std::vector<ProcessedAudioChunk>& out_chunks, size_t first_new);
 
     /**
      * @brief Checks packet format, reconfigures AudioProcessor if needed, and returns audio payload.
@@ -243,13 +283,30 @@ private:
         bool is_sentinel = false;
     };
 
+    /// Appends a slot to the fragment ring, growing it only past its previous peak.
+    InputFragmentMetadata& push_input_fragment();
+    void pop_input_fragment();
+
     utils::ByteRingBuffer input_ring_buffer_;
-    std::deque<InputFragmentMetadata> input_fragments_;
+    /** @brief Ring of fragment slots; slots keep their SSRC list capacity when reused. */
+    std::vector<InputFragmentMetadata> input_fragments_;
+    std::size_t input_fragments_head_ = 0;
+    std::size_t input_fragments_count_ = 0;
     uint64_t input_ring_base_offset_ = 0;
     bool input_chunk_active_ = false;
     std::chrono::steady_clock::time_point first_fragment_time_{};
     std::optional<uint32_t> first_fragment_rtp_timestamp_;
     size_t input_bytes_per_frame_ = 0;
+
+    // --- Silence gating ---
+    size_t silent_input_frames_run_ = 0;       ///< Consecutive all-zero input frames seen.
+    double silence_output_frame_remainder_ = 0.0;
+    double avg_process_ns_per_input_frame_ = 0.0;
+    std::atomic<uint64_t> m_silent_chunks_gated{0};
+    std::atomic<uint64_t> m_silence_saved_ns{0};
+
+    mutable std::mutex dedup_outputs_mutex_;
+    std::map<std::string, std::weak_ptr<ProcessedChunkRing>> dedup_outputs_;
 };
 
 } // namespace audio
@@ -11,6 +11,8 @@
 #include "../audio_types.h"
 #include "../utils/sentinel_logging.h"
 #include "../utils/lock_guard_profiler.h"
+#include "../utils/span_tracer.h"
+#include "../utils/audio_clock.h"
 
 #include <iostream>
 #include <array>
@@ -153,6 +155,52 @@ struct HolderTracker {
 
 namespace {
 constexpr double kProcessingBudgetAlpha = 0.2;
+// Payload bytes copied per data_mutex_ hold during an export (~1.3 s of 48 kHz stereo 16-bit).
+constexpr std::size_t kExportSliceBytes = 256 * 1024;
+// Packets inspected per hold, matching or not, so other sources' traffic cannot stretch a slice.
+constexpr std::size_t kExportSlicePackets = 2048;
+
+// Rewrites little-endian integer PCM as float32 in [-1, 1], using the same scaling as
+// AudioProcessor::scaleBuffer. Returns false for bit depths it does not understand.
+bool convert_pcm_to_float32(std::vector<uint8_t>& pcm, int bit_depth) {
+    if (bit_depth != 16 && bit_depth != 24 && bit_depth != 32) {
+        return false;
+    }
+    const std::size_t bytes_per_sample = static_cast<std::size_t>(bit_depth) / 8;
+    const std::size_t samples = pcm.size() / bytes_per_sample;
+    std::vector<uint8_t> converted(samples * sizeof(float));
+    const float inv_int32 = 1.0f / static_cast<float>(INT32_MAX);
+
+    const uint8_t* src = pcm.data();
+    uint8_t* dst = converted.data();
+    for (std::size_t idx = 0; idx < samples; ++idx) {
+        int32_t sample32 = 0;
+        switch (bit_depth) {
+        case 16:
+            sample32 = static_cast<int32_t>(static_cast<int16_t>(static_cast<uint16_t>(src[0] | (static_cast<uint16_t>(src[1]) << 8)))) << 16;
+            break;
+        case 24: {
+            int32_t raw = static_cast<int32_t>(src[0]) |
+                          (static_cast<int32_t>(src[1]) << 8) |
+                          (static_cast<int32_t>(src[2]) << 16);
+            if (raw & 0x00800000) {
+                raw |= ~0x00FFFFFF;
+            }
+            sample32 = raw << 8;
+            break;
+        }
+        default:
+            std::memcpy(&sample32, src, sizeof(int32_t));
+            break;
+        }
+        const float value = static_cast<float>(sample32) * inv_int32;
+        std::memcpy(dst, &value, sizeof(float));
+        src += bytes_per_sample;
+        dst += sizeof(float);
+    }
+    pcm.swap(converted);
+    return true;
+}
 constexpr int kDataMutexProcessingBudgetMs = 10;
 constexpr double kPlaybackDriftGain = 1.0 / 1'000'000.0; // Convert ppm to ratio
 constexpr double kRatioToPpm = 1'000'000.0;
@@ -229,7 +277,7 @@ uint32_t rtp_timestamp_diff(uint32_t current, uint32_t previous) {
 TimeshiftManager::TimeshiftManager(std::chrono::seconds max_buffer_duration, std::shared_ptr<screamrouter::audio::AudioEngineSettings> settings)
     : max_buffer_duration_sec_(max_buffer_duration),
       m_settings(settings),
-      last_cleanup_time_(std::chrono::steady_clock::now()),
+      last_cleanup_time_(utils::AudioClock::now()),
       profiling_last_log_time_(std::chrono::steady_clock::now()) {
     LOG_CPP_INFO("[TimeshiftManager] Initializing with max buffer duration: %llds", (long long)max_buffer_duration_sec_.count());
 }
@@ -358,6 +406,16 @@ void TimeshiftManager::add_packet(TaggedAudioPacket&& packet) {
     }
 
     utils::log_sentinel("timeshift_ingress", packet);
+    if (packet.trace_flow_id == 0) {
+        // Receivers that trace arrival start the flow themselves; start it here for the rest.
+        packet.trace_flow_id = utils::SpanTracer::instance().next_flow_id();
+    }
+    SR_TRACE_SPAN_FLOW("timeshift_ingress", packet.trace_flow_id);
+#if defined(SCREAMROUTER_TESTING)
+    if (ingress_hook_) {
+        ingress_hook_(packet);
+    }
+#endif
 
     if (!is_running()) {
         std::optional<HolderTracker> holder_tracker;
@@ -369,7 +427,7 @@ void TimeshiftManager::add_packet(TaggedAudioPacket&& packet) {
     }
 
     const std::string source_tag_copy = packet.source_tag;
-    using PushResult = utils::ThreadSafeQueue<TaggedAudioPacket>::PushResult;
+    using PushResult = utils::MpscQueue<TaggedAudioPacket>::PushResult;
     const PushResult result =
         inbound_queue_.push_bounded(std::move(packet), kInboundQueueMaxSize, false);
 
@@ -567,59 +625,105 @@ void TimeshiftManager::ingest_packet_locked(TaggedAudioPacket&& packet, std::uni
 std::optional<TimeshiftBufferExport> TimeshiftManager::export_recent_buffer(
     const std::string& source_tag,
     std::chrono::milliseconds lookback_duration) {
+    return export_buffer_range(source_tag, lookback_duration, std::chrono::milliseconds(0), false);
+}
+
+std::optional<TimeshiftBufferExport> TimeshiftManager::export_buffer_range(
+    const std::string& source_tag,
+    std::chrono::milliseconds start_ago,
+    std::chrono::milliseconds end_ago,
+    bool as_float32) {
     if (source_tag.empty()) {
         return std::nullopt;
     }
 
-    if (lookback_duration.count() <= 0) {
-        lookback_duration = std::chrono::milliseconds(1);
+    if (start_ago.count() <= 0) {
+        start_ago = std::chrono::milliseconds(1);
+    }
+    if (end_ago.count() < 0) {
+        end_ago = std::chrono::milliseconds(0);
+    }
+    if (end_ago >= start_ago) {
+        return std::nullopt;
     }
 
     TimeshiftBufferExport export_data;
-    export_data.lookback_seconds_requested = std::chrono::duration<double>(lookback_duration).count();
+    export_data.lookback_seconds_requested = std::chrono::duration<double>(start_ago).count();
 
-    const auto now = std::chrono::steady_clock::now();
-    const auto cutoff_time = now - lookback_duration;
+    const auto now = utils::AudioClock::now();
+    const auto cutoff_time = now - start_ago;
+    const auto end_time = now - end_ago;
 
-    std::vector<const TaggedAudioPacket*> selected_packets;
     std::chrono::steady_clock::time_point first_packet_time{};
     std::chrono::steady_clock::time_point last_packet_time{};
-    std::size_t total_bytes = 0;
     bool metadata_initialized = false;
+    std::size_t expected_bytes = 0;
+
+    // Absolute packet positions; the end is fixed by the first slice so a live stream cannot
+    // keep extending the export.
+    uint64_t next_position = 0;
+    uint64_t end_position = 0;
+    uint64_t evicted_during_export = 0;
+    bool bounds_set = false;
+    bool done = false;
+    // Capacity the output needs before the next packet fits. pcm_data is only ever grown with
+    // data_mutex_ released, so a burst beyond the estimate never reallocates under the lock.
+    std::size_t reserve_target = 0;
+
+    while (!done) {
+        {
+            std::optional<HolderTracker> holder_tracker;
+            std::lock_guard<std::mutex> lock(data_mutex_);
+            holder_tracker.emplace(__FILE__, __LINE__);
 
-    {
-        std::optional<HolderTracker> holder_tracker;
-        std::lock_guard<std::mutex> lock(data_mutex_);
-        holder_tracker.emplace(__FILE__, __LINE__);
-        selected_packets.reserve(global_timeshift_buffer_.size());
-
-        for (const auto& packet : global_timeshift_buffer_) {
-            if (packet.source_tag != source_tag) {
-                continue;
+            if (!bounds_set) {
+                bounds_set = true;
+                next_position = evicted_packet_count_;
+                end_position = evicted_packet_count_ + global_timeshift_buffer_.size();
             }
-            if (packet.received_time < cutoff_time) {
-                continue;
-            }
-            if (packet.audio_data.empty()) {
-                continue;
-            }
-            if (packet.sample_rate <= 0 || packet.channels <= 0 || packet.bit_depth <= 0) {
-                LOG_CPP_WARNING("[TimeshiftManager] Skipping packet with invalid audio parameters for export: sample_rate=%d channels=%d bit_depth=%d",
-                                packet.sample_rate, packet.channels, packet.bit_depth);
-                continue;
+            if (next_position < evicted_packet_count_) {
+                evicted_during_export += evicted_packet_count_ - next_position;
+                next_position = evicted_packet_count_;
             }
 
-            if (!metadata_initialized) {
-                metadata_initialized = true;
-                export_data.sample_rate = packet.sample_rate;
-                export_data.channels = packet.channels;
-                export_data.bit_depth = packet.bit_depth;
-                export_data.chunk_size_bytes = packet.audio_data.size();
-                first_packet_time = packet.received_time;
-            } else {
-                if (packet.sample_rate != export_data.sample_rate ||
-                    packet.channels != export_data.channels ||
-                    packet.bit_depth != export_data.bit_depth) {
+            std::size_t slice_bytes = 0;
+            std::size_t slice_packets = 0;
+            while (next_position < end_position && slice_bytes < kExportSliceBytes &&
+                   slice_packets < kExportSlicePackets) {
+                const auto& packet = global_timeshift_buffer_[static_cast<std::size_t>(next_position - evicted_packet_count_)];
+                ++slice_packets;
+
+                if (packet.source_tag != source_tag ||
+                    packet.received_time < cutoff_time || packet.received_time > end_time ||
+                    packet.audio_data.empty()) {
+                    ++next_position;
+                    continue;
+                }
+                if (packet.sample_rate <= 0 || packet.channels <= 0 || packet.bit_depth <= 0) {
+                    LOG_CPP_WARNING("[TimeshiftManager] Skipping packet with invalid audio parameters for export: sample_rate=%d channels=%d bit_depth=%d",
+                                    packet.sample_rate, packet.channels, packet.bit_depth);
+                    ++next_position;
+                    continue;
+                }
+
+                if (!metadata_initialized) {
+                    metadata_initialized = true;
+                    export_data.sample_rate = packet.sample_rate;
+                    export_data.channels = packet.channels;
+                    export_data.bit_depth = packet.bit_depth;
+                    export_data.chunk_size_bytes = packet.audio_data.size();
+
+                    // Estimate the whole window so a steady stream needs a single reservation.
+                    const double window_seconds =
+                        std::chrono::duration<double>(end_time - std::max(cutoff_time, packet.received_time)).count();
+                    const double bytes_per_second = static_cast<double>(packet.sample_rate) *
+                                                    static_cast<double>(packet.channels) *
+                                                    static_cast<double>(packet.bit_depth) / 8.0;
+                    expected_bytes = packet.audio_data.size() +
+                                     static_cast<std::size_t>(std::max(0.0, window_seconds) * bytes_per_second);
+                } else if (packet.sample_rate != export_data.sample_rate ||
+                           packet.channels != export_data.channels ||
+                           packet.bit_depth != export_data.bit_depth) {
                     LOG_CPP_WARNING("[TimeshiftManager] Dropping packet with mismatched format during export (expected sr=%d ch=%d bit_depth=%d, got sr=%d ch=%d bit_depth=%d)",
                                     export_data.sample_rate,
                                     export_data.channels,
@@ -627,26 +731,46 @@ std::optional<TimeshiftBufferExport> TimeshiftManager::export_recent_buffer(
                                     packet.sample_rate,
                                     packet.channels,
                                     packet.bit_depth);
+                    ++next_position;
                     continue;
                 }
-            }
 
-            selected_packets.push_back(&packet);
-            total_bytes += packet.audio_data.size();
-            last_packet_time = packet.received_time;
-        }
+                auto& pcm = export_data.pcm_data;
+                const std::size_t needed = pcm.size() + packet.audio_data.size();
+                if (needed > pcm.capacity()) {
+                    // End the slice here and revisit this packet once the buffer has grown.
+                    reserve_target = std::max({needed, expected_bytes, pcm.capacity() * 2});
+                    break;
+                }
 
-        if (!metadata_initialized || selected_packets.empty()) {
-            return std::nullopt;
+                if (pcm.empty()) {
+                    first_packet_time = packet.received_time;
+                }
+                pcm.insert(pcm.end(), packet.audio_data.begin(), packet.audio_data.end());
+                slice_bytes += packet.audio_data.size();
+                last_packet_time = packet.received_time;
+                ++next_position;
+            }
+            done = next_position >= end_position;
         }
 
-        export_data.pcm_data.reserve(total_bytes);
-        for (const auto* packet_ptr : selected_packets) {
-            const auto& packet = *packet_ptr;
-            export_data.pcm_data.insert(export_data.pcm_data.end(),
-                                        packet.audio_data.begin(),
-                                        packet.audio_data.end());
+        if (reserve_target > 0) {
+            export_data.pcm_data.reserve(reserve_target);
+            reserve_target = 0;
         }
+#if defined(SCREAMROUTER_TESTING)
+        if (!done && export_slice_hook_) {
+            export_slice_hook_();
+        }
+#endif
+    }
+
+    if (!metadata_initialized || export_data.pcm_data.empty()) {
+        return std::nullopt;
+    }
+    if (evicted_during_export > 0) {
+        LOG_CPP_DEBUG("[TimeshiftManager] Export for %s skipped %llu packets evicted while it ran.",
+                      source_tag.c_str(), static_cast<unsigned long long>(evicted_during_export));
     }
 
     // Calculate timing metadata outside the lock.
@@ -664,6 +788,16 @@ std::optional<TimeshiftBufferExport> TimeshiftManager::export_recent_buffer(
         }
     }
 
+    if (as_float32) {
+        if (!convert_pcm_to_float32(export_data.pcm_data, export_data.bit_depth)) {
+            LOG_CPP_WARNING("[TimeshiftManager] Cannot convert %d-bit PCM to float32 for export; returning native samples.",
+                            export_data.bit_depth);
+        } else {
+            export_data.bit_depth = 32;
+            export_data.float32 = true;
+        }
+    }
+
     return export_data;
 }
 
@@ -845,7 +979,7 @@ void TimeshiftManager::register_processor(
         std::lock_guard<std::mutex> lock(data_mutex_);
         holder_tracker.emplace(__FILE__, __LINE__);
         if (initial_timeshift_sec > 0.0f && !global_timeshift_buffer_.empty()) {
-            auto now = std::chrono::steady_clock::now();
+            auto now = utils::AudioClock::now();
             auto target_past_time = now - std::chrono::milliseconds(initial_delay_ms) - std::chrono::duration<double>(initial_timeshift_sec);
             
             size_t found_idx = global_timeshift_buffer_.size();
@@ -991,7 +1125,7 @@ void TimeshiftManager::update_processor_timeshift(const std::string& instance_id
                 proc_it->second.next_packet_read_index = 0;
                  LOG_CPP_INFO("[TimeshiftManager] Timeshift updated for %s, buffer empty. Read index set to 0.", instance_id.c_str());
             } else {
-                auto now = std::chrono::steady_clock::now();
+                auto now = utils::AudioClock::now();
                 auto target_past_time = now - std::chrono::milliseconds(proc_it->second.current_delay_ms) - std::chrono::duration<double>(timeshift_sec);
                 
                 size_t new_read_idx = global_timeshift_buffer_.size();
@@ -1129,7 +1263,7 @@ void TimeshiftManager::run() {
         }
 
         wildcard_matches.clear();
-        auto next_wakeup_time = std::chrono::steady_clock::now();
+        auto next_wakeup_time = utils::AudioClock::now();
         {
             auto lock_start = std::chrono::steady_clock::now();
             std::optional<HolderTracker> holder_tracker;
@@ -1140,7 +1274,7 @@ void TimeshiftManager::run() {
             processing_loop_iteration_unlocked(wildcard_matches);
 
             // Perform cleanup if needed.
-            auto now = std::chrono::steady_clock::now();
+            auto now = utils::AudioClock::now();
             if (now - last_cleanup_time_ > std::chrono::milliseconds(m_settings->timeshift_tuning.cleanup_interval_ms)) {
                 cleanup_global_buffer_unlocked();
                 last_cleanup_time_ = now;
@@ -1197,6 +1331,36 @@ void TimeshiftManager::run() {
     LOG_CPP_INFO("[TimeshiftManager] Run loop exiting.");
 }
 
+void TimeshiftManager::run_once() {
+    if (is_running()) {
+        return;
+    }
+    std::vector<WildcardMatchEvent> wildcard_matches;
+    {
+        std::optional<HolderTracker> holder_tracker;
+        std::unique_lock<std::mutex> lock(data_mutex_);
+        holder_tracker.emplace(__FILE__, __LINE__);
+        processing_loop_iteration_unlocked(wildcard_matches);
+        const auto now = utils::AudioClock::now();
+        if (now - last_cleanup_time_ > std::chrono::milliseconds(m_settings->timeshift_tuning.cleanup_interval_ms)) {
+            cleanup_global_buffer_unlocked();
+            last_cleanup_time_ = now;
+        }
+    }
+    std::function<void(const WildcardMatchEvent&)> callback;
+    {
+        std::lock_guard<std::mutex> cb_lock(wildcard_callback_mutex_);
+        callback = wildcard_match_callback_;
+    }
+    if (callback) {
+        for (const auto& evt : wildcard_matches) {
+            if (!evt.processor_instance_id.empty() && !evt.concrete_tag.empty()) {
+                callback(evt);
+            }
+        }
+    }
+}
+
 /**
  * @brief A single iteration of the processing loop to dispatch ready packets. Assumes data_mutex_ is held.
  */
@@ -1205,7 +1369,7 @@ void TimeshiftManager::processing_loop_iteration_unlocked(std::vector<WildcardMa
         return;
     }
 
-    const auto iteration_start = std::chrono::steady_clock::now();
+    const auto iteration_start = utils::AudioClock::now();
     const auto budget_deadline = iteration_start + std::chrono::milliseconds(kDataMutexProcessingBudgetMs);
     bool budget_exhausted = false;
     auto now = iteration_start;
@@ -1225,7 +1389,7 @@ void TimeshiftManager::processing_loop_iteration_unlocked(std::vector<WildcardMa
             }
             while (target_info.next_packet_read_index < global_timeshift_buffer_.size()) {
                 update_data_mutex_holder_site(__FILE__, __LINE__);
-                if (std::chrono::steady_clock::now() >= budget_deadline) {
+                if (utils::AudioClock::now() >= budget_deadline) {
                     budget_exhausted = true;
                     break;
                 }
@@ -1257,7 +1421,7 @@ void TimeshiftManager::processing_loop_iteration_unlocked(std::vector<WildcardMa
 
                 StreamTimingState& ts = *timing_access.state;
 
-                now = std::chrono::steady_clock::now();
+                now = utils::AudioClock::now();
 
                 // --- Playout Time Calculation ---
                 auto expected_arrival_time =
@@ -1506,6 +1670,7 @@ void TimeshiftManager::processing_loop_iteration_unlocked(std::vector<WildcardMa
                         continue;
                     }
 
+                    SR_TRACE_SPAN_FLOW("timeshift_dispatch", candidate_packet.trace_flow_id);
                     TaggedAudioPacket packet_to_send = candidate_packet;
                     utils::log_sentinel("timeshift_ready", packet_to_send);
                     ts.last_system_delay_ms = lateness_ms;
@@ -1556,7 +1721,7 @@ void TimeshiftManager::processing_loop_iteration_unlocked(std::vector<WildcardMa
 
                     target_info.next_packet_read_index++;
 
-                    now = std::chrono::steady_clock::now();
+                    now = utils::AudioClock::now();
                     if (now >= budget_deadline) {
                         budget_exhausted = true;
                         break;
@@ -1574,7 +1739,7 @@ void TimeshiftManager::processing_loop_iteration_unlocked(std::vector<WildcardMa
         }
     }
 
-    const auto iteration_end = std::chrono::steady_clock::now();
+    const auto iteration_end = utils::AudioClock::now();
     last_iteration_finish_time_ = iteration_end;
 
     if (budget_exhausted) {
@@ -1605,7 +1770,7 @@ void TimeshiftManager::processing_loop_iteration_unlocked(std::vector<WildcardMa
     }
 
     if (m_settings->profiler.enabled) {
-        maybe_log_profiler_unlocked(iteration_end);
+        maybe_log_profiler_unlocked(std::chrono::steady_clock::now());
     }
 }
 
@@ -1753,7 +1918,7 @@ void TimeshiftManager::cleanup_global_buffer_unlocked() {
         return; // Nothing to do
     }
 
-    auto oldest_allowed_time_by_duration = std::chrono::steady_clock::now() - max_buffer_duration_sec_;
+    auto oldest_allowed_time_by_duration = utils::AudioClock::now() - max_buffer_duration_sec_;
     
     size_t remove_count = 0;
     for (const auto& packet : global_timeshift_buffer_) {
@@ -1812,6 +1977,7 @@ void TimeshiftManager::cleanup_global_buffer_unlocked() {
         }
         while (remove_count-- > 0 && !global_timeshift_buffer_.empty()) {
             global_timeshift_buffer_.pop_front();
+            ++evicted_packet_count_;
         }
     } else {
         LOG_CPP_DEBUG("[TimeshiftManager] Cleanup: No packets older than max duration to remove.");
@@ -1825,7 +1991,7 @@ void TimeshiftManager::cleanup_global_buffer_unlocked() {
  * @note This function assumes the caller holds the data_mutex.
  */
 std::chrono::steady_clock::time_point TimeshiftManager::calculate_next_wakeup_time() {
-    const auto now = std::chrono::steady_clock::now();
+    const auto now = utils::AudioClock::now();
     const auto reference_now = (last_iteration_finish_time_.time_since_epoch().count() != 0)
                                    ? std::max(now, last_iteration_finish_time_)
                                    : now;
@@ -13,6 +13,7 @@
 #include "../audio_types.h"
 #include "../configuration/audio_engine_settings.h"
 #include "../utils/packet_ring.h"
+#include "../utils/mpsc_queue.h"
 
 #include <string>
 #include <vector>
@@ -43,7 +44,8 @@ struct TimeshiftBufferExport {
     std::vector<uint8_t> pcm_data;               ///< Raw PCM payload concatenated from packets.
     int sample_rate = 0;                         ///< Sample rate in Hz.
     int channels = 0;                            ///< Channel count.
-    int bit_depth = 0;                           ///< Bits per sample per channel.
+    int bit_depth = 0;                           ///< Bits per sample per channel (32 when float32 is set).
+    bool float32 = false;                        ///< pcm_data holds float32 samples in [-1, 1] instead of integer PCM.
     std::size_t chunk_size_bytes = 0;            ///< Size of the originating packet chunks.
     double duration_seconds = 0.0;               ///< Approximate duration of the exported audio.
     double earliest_packet_age_seconds = 0.0;    ///< Age of the oldest packet relative to export time.
@@ -272,6 +274,31 @@ public:
         const std::string& source_tag,
         std::chrono::milliseconds lookback_duration);
 
+    /**
+     * @brief Export the PCM received between start_ago and end_ago before now for a source.
+     * @details Payloads are copied in short slices, bounded in bytes and in packets visited, so
+     *          data_mutex_ is released between them and packet ingestion never waits on a whole
+     *          export; packets evicted mid-export are skipped. The output buffer only grows
+     *          between slices. Float conversion runs after the last slice, outside the lock.
+     * @param source_tag The source identifier to filter packets by.
+     * @param start_ago Oldest edge of the window, measured back from now.
+     * @param end_ago Newest edge of the window, measured back from now (0 = up to now).
+     * @param as_float32 Convert the integer PCM to float32 samples.
+     * @return Populated export data on success, std::nullopt if no data found.
+     */
+    std::optional<TimeshiftBufferExport> export_buffer_range(
+        const std::string& source_tag,
+        std::chrono::milliseconds start_ago,
+        std::chrono::milliseconds end_ago,
+        bool as_float32);
+
+#if defined(SCREAMROUTER_TESTING)
+    /** @brief Runs @p hook between export slices, with data_mutex_ released, so tests can evict mid-export. */
+    void set_export_slice_hook(std::function<void()> hook) { export_slice_hook_ = std::move(hook); }
+    /** @brief Runs @p hook on every packet accepted by add_packet(), before it is buffered. */
+    void set_ingress_hook(std::function<void(const TaggedAudioPacket&)> hook) { ingress_hook_ = std::move(hook); }
+#endif
+
     /**
      * @brief Registers a new processor as a consumer of the buffer.
      * @param instance_id A unique ID for the processor instance.
@@ -338,6 +365,14 @@ public:
      */
     void reset_stream_state(const std::string& source_tag);
 
+    /**
+     * @brief Runs one dispatch pass on the calling thread instead of the manager's thread.
+     * @details For offline rendering: with the manager not started, add_packet() ingests
+     *          inline and the caller drives dispatch with this, usually under a VirtualClock.
+     *          Does nothing while the manager's own thread is running.
+     */
+    void run_once();
+
 protected:
     /** @brief The main loop for the manager's thread. */
     void run() override;
@@ -353,6 +388,9 @@ private:
     };
 
     std::deque<TaggedAudioPacket> global_timeshift_buffer_;
+    /// Packets popped from the front of global_timeshift_buffer_ so far; with the deque index it
+    /// gives each packet a stable absolute position. Guarded by data_mutex_.
+    uint64_t evicted_packet_count_ = 0;
     // Map: source_tag -> instance_id -> ProcessorTargetInfo
     std::map<std::string, std::map<std::string, ProcessorTargetInfo>> processor_targets_;
     std::mutex data_mutex_;
@@ -373,7 +411,8 @@ private:
     std::atomic<size_t> m_inbound_high_water{0};
 
     // Inbound decoupling to avoid blocking capture threads on the main data mutex.
-    utils::ThreadSafeQueue<TaggedAudioPacket> inbound_queue_;
+    // Lock-free so receiver threads never contend with each other on the hand-off.
+    utils::MpscQueue<TaggedAudioPacket> inbound_queue_{kInboundQueueMaxSize};
     static constexpr std::size_t kInboundQueueMaxSize = 1024;
     std::chrono::steady_clock::time_point last_inbound_drop_log_{};
 
@@ -389,6 +428,11 @@ private:
     PipelineStateProvider pipeline_state_provider_;
     mutable std::mutex pipeline_state_mutex_;
 
+#if defined(SCREAMROUTER_TESTING)
+    std::function<void()> export_slice_hook_;
+    std::function<void(const TaggedAudioPacket&)> ingress_hook_;
+#endif
+
     /** @brief A single iteration of the processing loop. Collects ready packets while data_mutex_ is held. */
     void processing_loop_iteration_unlocked(std::vector<WildcardMatchEvent>& wildcard_matches);
     /** @brief Periodically cleans up old packets from the global buffer. Assumes data_mutex_ is held. */
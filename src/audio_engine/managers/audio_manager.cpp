@@ -490,6 +490,10 @@ bool AudioManager::remove_sink(const std::string& sink_id) {
     if (!m_sink_manager) {
         return false;
     }
+    if (!m_sink_manager->get_group_leader(sink_id).empty()) {
+        // Grouped sinks own no mixer or connections; SinkManager detaches them and closes their listeners.
+        return m_sink_manager->remove_sink(sink_id);
+    }
     
     // First, disable and remove the coordinator if it exists
     auto coord_it = sink_coordinators_.find(sink_id);
@@ -504,6 +508,13 @@ bool AudioManager::remove_sink(const std::string& sink_id) {
                      sink_id.c_str());
     }
     
+    // Disconnect sources first so a processor deduplicated across sinks is handed to one of the others.
+    if (m_connection_manager) {
+        for (const auto& instance_id : m_connection_manager->list_sources_for_sink(sink_id)) {
+            disconnect_source_sink(instance_id, sink_id);
+        }
+    }
+
     // Now remove the sink through SinkManager
     const bool ok = m_sink_manager->remove_sink(sink_id);
     const auto t1 = std::chrono::steady_clock::now();
@@ -513,6 +524,21 @@ bool AudioManager::remove_sink(const std::string& sink_id) {
     return ok;
 }
 
+bool AudioManager::add_sink_to_group(const std::string& leader_sink_id, SinkConfig member_config) {
+    if (!m_sink_manager || !m_running) {
+        return false;
+    }
+    return m_sink_manager->add_sink_to_group(leader_sink_id, member_config);
+}
+
+bool AudioManager::remove_sink_from_group(const std::string& member_sink_id) {
+    return m_sink_manager ? m_sink_manager->remove_sink_from_group(member_sink_id) : false;
+}
+
+bool AudioManager::sink_has_listeners(const std::string& sink_id) {
+    return m_sink_manager ? m_sink_manager->sink_has_listeners(sink_id) : false;
+}
+
 std::string AudioManager::configure_source(SourceConfig config) {
     const auto t0 = std::chrono::steady_clock::now();
     if (!m_source_manager) {
@@ -542,6 +568,12 @@ bool AudioManager::remove_source(const std::string& instance_id) {
 
 bool AudioManager::connect_source_sink(const std::string& source_instance_id, const std::string& sink_id) {
     const auto t0 = std::chrono::steady_clock::now();
+    if (m_sink_manager && !m_sink_manager->get_group_leader(sink_id).empty()) {
+        // A grouped sink has no mixer of its own; its leader carries the mix.
+        LOG_CPP_DEBUG("[AudioManager] connect %s -> %s skipped: sink is grouped",
+                      source_instance_id.c_str(), sink_id.c_str());
+        return false;
+    }
     bool ok = m_connection_manager ? m_connection_manager->connect_source_sink(source_instance_id, sink_id, m_running) : false;
     const auto t1 = std::chrono::steady_clock::now();
     LOG_CPP_INFO("[AudioManager] connect %s -> %s : %s (%lld ms)",
@@ -552,6 +584,9 @@ bool AudioManager::connect_source_sink(const std::string& source_instance_id, co
 
 bool AudioManager::disconnect_source_sink(const std::string& source_instance_id, const std::string& sink_id) {
     const auto t0 = std::chrono::steady_clock::now();
+    if (m_sink_manager && !m_sink_manager->get_group_leader(sink_id).empty()) {
+        return true;
+    }
     bool ok = m_connection_manager ? m_connection_manager->disconnect_source_sink(source_instance_id, sink_id, m_running) : false;
     const auto t1 = std::chrono::steady_clock::now();
     LOG_CPP_INFO("[AudioManager] disconnect %s -/-> %s : %s (%lld ms)",
@@ -576,7 +611,9 @@ std::vector<uint8_t> AudioManager::get_mp3_data_by_ip(const std::string& ip_addr
 
 std::optional<TimeshiftBufferExport> AudioManager::export_timeshift_buffer(
     const std::string& source_tag,
-    double lookback_seconds) {
+    double lookback_seconds,
+    double end_seconds_ago,
+    bool as_float32) {
     if (!m_timeshift_manager) {
         LOG_CPP_WARNING("[AudioManager] export_timeshift_buffer called without an active TimeshiftManager.");
         return std::nullopt;
@@ -592,7 +629,13 @@ std::optional<TimeshiftBufferExport> AudioManager::export_timeshift_buffer(
         lookback_ms = std::chrono::milliseconds(1);
     }
 
-    return m_timeshift_manager->export_recent_buffer(source_tag, lookback_ms);
+    if (!std::isfinite(end_seconds_ago) || end_seconds_ago < 0.0) {
+        end_seconds_ago = 0.0;
+    }
+    const auto end_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::duration<double>(end_seconds_ago));
+
+    return m_timeshift_manager->export_buffer_range(source_tag, lookback_ms, end_ms, as_float32);
 }
 
 std::vector<std::string> AudioManager::get_rtp_receiver_seen_tags() {
@@ -649,6 +692,24 @@ std::vector<std::string> AudioManager::get_pulse_receiver_seen_tags() {
 }
 #endif
 
+bool AudioManager::start_pcap_replay(const PcapReplayConfig& config) {
+    if (!m_running || !m_receiver_manager) {
+        LOG_CPP_ERROR("AudioManager not running. Cannot start capture replay.");
+        return false;
+    }
+    return m_receiver_manager->start_pcap_replay(config);
+}
+
+void AudioManager::stop_pcap_replay() {
+    if (m_receiver_manager) {
+        m_receiver_manager->stop_pcap_replay();
+    }
+}
+
+std::optional<PcapReplayStats> AudioManager::get_pcap_replay_stats() {
+    return m_receiver_manager ? m_receiver_manager->get_pcap_replay_stats() : std::nullopt;
+}
+
 std::optional<std::string> AudioManager::resolve_stream_tag(const std::string& tag) {
     LOG_CPP_DEBUG("[AudioManager] resolve_stream_tag('%s')", tag.c_str());
     if (!m_receiver_manager) {
@@ -931,7 +992,7 @@ std::size_t AudioManager::get_chunk_size_bytes_for_format(int channels, int bit_
 
 bool AudioManager::write_plugin_packet(
     const std::string& source_instance_tag,
-    const std::vector<uint8_t>& audio_payload,
+    std::vector<uint8_t> audio_payload,
     int channels,
     int sample_rate,
     int bit_depth,
@@ -939,11 +1000,26 @@ bool AudioManager::write_plugin_packet(
     uint8_t chlayout2)
     {
         if (m_control_api_manager) {
-            return m_control_api_manager->write_plugin_packet(source_instance_tag, audio_payload, channels, sample_rate, bit_depth, chlayout1, chlayout2, m_running);
+            return m_control_api_manager->write_plugin_packet(source_instance_tag, std::move(audio_payload), channels, sample_rate, bit_depth, chlayout1, chlayout2, m_running);
         }
         return false;
     }
 
+std::size_t AudioManager::write_plugin_packets(
+    const std::string& source_instance_tag,
+    std::vector<std::vector<uint8_t>> audio_payloads,
+    int channels,
+    int sample_rate,
+    int bit_depth,
+    uint8_t chlayout1,
+    uint8_t chlayout2)
+    {
+        if (m_control_api_manager) {
+            return m_control_api_manager->write_plugin_packets(source_instance_tag, std::move(audio_payloads), channels, sample_rate, bit_depth, chlayout1, chlayout2, m_running);
+        }
+        return 0;
+    }
+
 bool AudioManager::add_webrtc_listener(
     const std::string& sink_id,
     const std::string& listener_id,
@@ -96,6 +96,30 @@ public:
      */
     bool remove_sink(const std::string& sink_id);
 
+    /**
+     * @brief Serves a sink from an existing sink's mix instead of running its own mixer.
+     * @details Only valid when both sinks receive the same source instances in the same
+     *          output format; the leader then sends its output to both destinations.
+     * @param leader_sink_id The ID of the running sink whose mix is shared.
+     * @param member_config Configuration of the sink joining the group. It must not exist as a sink.
+     * @return true if the sink joined the group, false otherwise.
+     */
+    bool add_sink_to_group(const std::string& leader_sink_id, SinkConfig member_config);
+
+    /**
+     * @brief Stops serving a grouped sink from its leader's mix.
+     * @details The sink's listeners are held until add_sink() gives it its own mixer again.
+     * @param member_sink_id The ID of the grouped sink.
+     * @return true if the sink was grouped and has been detached.
+     */
+    bool remove_sink_from_group(const std::string& member_sink_id);
+    /**
+     * @brief Checks whether network listeners (e.g. WebRTC peers) are attached to a sink.
+     * @param sink_id The ID of the sink.
+     * @return true if the sink has listeners of its own.
+     */
+    bool sink_has_listeners(const std::string& sink_id);
+
     /**
      * @brief Creates and configures a new source processing path.
      * @param config Configuration settings for the source path.
@@ -151,12 +175,16 @@ public:
     /**
      * @brief Export a raw PCM window from the timeshift buffer for a given source.
      * @param source_tag Identifier of the source stream.
-     * @param lookback_seconds Length of history to include, defaults to 300 seconds.
+     * @param lookback_seconds Start of the window in seconds before now, defaults to 300 seconds.
+     * @param end_seconds_ago End of the window in seconds before now, defaults to now.
+     * @param as_float32 Convert the samples to float32 in [-1, 1].
      * @return Export payload with PCM data and metadata, or std::nullopt if unavailable.
      */
     std::optional<TimeshiftBufferExport> export_timeshift_buffer(
         const std::string& source_tag,
-        double lookback_seconds = 300.0);
+        double lookback_seconds = 300.0,
+        double end_seconds_ago = 0.0,
+        bool as_float32 = false);
 
     // --- Receiver Info API ---
     /**
@@ -192,6 +220,24 @@ public:
 #endif
 #endif
 
+    /**
+     * @brief Replays a pcap/pcapng capture into the receivers.
+     * @param config The capture file, pacing and port routing.
+     * @return true if the replay started.
+     */
+    bool start_pcap_replay(const PcapReplayConfig& config);
+
+    /**
+     * @brief Stops the running capture replay, if any.
+     */
+    void stop_pcap_replay();
+
+    /**
+     * @brief Gets progress counters of the current or last capture replay.
+     * @return The stats, or std::nullopt if no replay has been started.
+     */
+    std::optional<PcapReplayStats> get_pcap_replay_stats();
+
     /**
      * @brief Adds a reference to a system capture device, creating the receiver if needed.
      * @param device_tag Platform-specific capture tag.
@@ -219,7 +265,7 @@ public:
     /**
      * @brief Injects a plugin-generated audio packet into a specific source processor.
      * @param source_instance_tag The unique ID of the target SourceInputProcessor.
-     * @param audio_payload The raw audio data.
+     * @param audio_payload The raw audio data; becomes the packet payload without another copy.
      * @param channels Number of audio channels.
      * @param sample_rate Sample rate in Hz.
      * @param bit_depth Bit depth.
@@ -229,7 +275,21 @@ public:
      */
     bool write_plugin_packet(
         const std::string& source_instance_tag,
-        const std::vector<uint8_t>& audio_payload,
+        std::vector<uint8_t> audio_payload,
+        int channels,
+        int sample_rate,
+        int bit_depth,
+        uint8_t chlayout1,
+        uint8_t chlayout2
+    );
+
+    /**
+     * @brief Injects consecutive plugin-generated packets of one format in a single call.
+     * @return The number of packets injected.
+     */
+    std::size_t write_plugin_packets(
+        const std::string& source_instance_tag,
+        std::vector<std::vector<uint8_t>> audio_payloads,
         int channels,
         int sample_rate,
         int bit_depth,
@@ -331,6 +391,11 @@ public:
                                  std::function<void(const std::string&)> on_removed);
     void clear_stream_tag_listener();
 
+#if defined(SCREAMROUTER_TESTING)
+    /** @brief The engine's sink manager, so tests can inspect mixers and attach listeners. */
+    SinkManager* sink_manager_for_testing() { return m_sink_manager.get(); }
+#endif
+
 private:
     std::atomic<bool> m_running{false};
     mutable std::recursive_mutex m_manager_mutex;
@@ -386,6 +451,25 @@ private:
  * @brief Binds the AudioManager class and its methods to a Python module.
  * @param m The pybind11 module to which the class will be bound.
  */
+/**
+ * @brief Copies a Python buffer-protocol object straight into a packet payload.
+ * @details Accepts bytes, bytearray, memoryview or numpy arrays without an intermediate bytes
+ *          object; non-contiguous views are rejected by Python with BufferError.
+ */
+inline std::vector<uint8_t> copy_plugin_payload(const pybind11::handle& buffer) {
+    Py_buffer view;
+    if (PyObject_GetBuffer(buffer.ptr(), &view, PyBUF_C_CONTIGUOUS) != 0) {
+        throw pybind11::error_already_set();
+    }
+    // Released on every exit, including a bad_alloc from the copy below.
+    struct ViewRelease {
+        Py_buffer* view;
+        ~ViewRelease() { PyBuffer_Release(view); }
+    } release{&view};
+    const auto* data = static_cast<const uint8_t*>(view.buf);
+    return std::vector<uint8_t>(data, data + view.len);
+}
+
 inline void bind_audio_manager(pybind11::module_ &m) {
     namespace py = pybind11;
 
@@ -435,7 +519,9 @@ inline void bind_audio_manager(pybind11::module_ &m) {
     py::class_<SourceProcessorTuning>(m, "SourceProcessorTuning")
         .def(py::init<>())
         .def_readwrite("command_loop_sleep_ms", &SourceProcessorTuning::command_loop_sleep_ms)
-        .def_readwrite("discontinuity_threshold_ms", &SourceProcessorTuning::discontinuity_threshold_ms);
+        .def_readwrite("discontinuity_threshold_ms", &SourceProcessorTuning::discontinuity_threshold_ms)
+        .def_readwrite("silence_gate_enabled", &SourceProcessorTuning::silence_gate_enabled)
+        .def_readwrite("silence_gate_tail_ms", &SourceProcessorTuning::silence_gate_tail_ms);
 
     py::class_<ProcessorTuning>(m, "ProcessorTuning")
         .def(py::init<>())
@@ -473,13 +559,35 @@ inline void bind_audio_manager(pybind11::module_ &m) {
         .def_readwrite("alsa_latency_apply_hysteresis_ms", &SystemAudioTuning::alsa_latency_apply_hysteresis_ms)
         .def_readwrite("alsa_latency_reconfig_cooldown_ms", &SystemAudioTuning::alsa_latency_reconfig_cooldown_ms)
         .def_readwrite("alsa_latency_xrun_boost_ms", &SystemAudioTuning::alsa_latency_xrun_boost_ms)
-        .def_readwrite("alsa_latency_low_step_ms", &SystemAudioTuning::alsa_latency_low_step_ms);
+        .def_readwrite("alsa_latency_low_step_ms", &SystemAudioTuning::alsa_latency_low_step_ms)
+        .def_readwrite("alsa_mmap_enabled", &SystemAudioTuning::alsa_mmap_enabled)
+        .def_readwrite("alsa_timer_scheduling_enabled", &SystemAudioTuning::alsa_timer_scheduling_enabled)
+        .def_readwrite("alsa_timer_target_fill_ms", &SystemAudioTuning::alsa_timer_target_fill_ms);
 
     py::class_<RtpReceiverTuning>(m, "RtpReceiverTuning")
         .def(py::init<>())
         .def_readwrite("format_probe_duration_ms", &RtpReceiverTuning::format_probe_duration_ms)
         .def_readwrite("format_probe_min_bytes", &RtpReceiverTuning::format_probe_min_bytes);
 
+    py::class_<PcapReplayConfig>(m, "PcapReplayConfig")
+        .def(py::init<>())
+        .def_readwrite("file_path", &PcapReplayConfig::file_path)
+        .def_readwrite("speed", &PcapReplayConfig::speed)
+        .def_readwrite("loop_count", &PcapReplayConfig::loop_count)
+        .def_readwrite("target_port", &PcapReplayConfig::target_port);
+
+    py::class_<PcapReplayStats>(m, "PcapReplayStats")
+        .def(py::init<>())
+        .def_readonly("datagrams_injected", &PcapReplayStats::datagrams_injected)
+        .def_readonly("bytes_injected", &PcapReplayStats::bytes_injected)
+        .def_readonly("datagrams_unrouted", &PcapReplayStats::datagrams_unrouted)
+        .def_readonly("records_skipped", &PcapReplayStats::records_skipped)
+        .def_readonly("loops_completed", &PcapReplayStats::loops_completed)
+        .def_readonly("max_lateness_ms", &PcapReplayStats::max_lateness_ms)
+        .def_readonly("capture_seconds", &PcapReplayStats::capture_seconds)
+        .def_readonly("wall_seconds", &PcapReplayStats::wall_seconds)
+        .def_readonly("finished", &PcapReplayStats::finished);
+
     py::class_<AudioEngineSettings>(m, "AudioEngineSettings")
         .def(py::init<>())
         .def_readwrite("chunk_size_bytes", &AudioEngineSettings::chunk_size_bytes)
@@ -494,17 +602,39 @@ inline void bind_audio_manager(pybind11::module_ &m) {
         .def_readwrite("rtp_receiver_tuning", &AudioEngineSettings::rtp_receiver_tuning)
         .def_readwrite("system_audio_tuning", &AudioEngineSettings::system_audio_tuning);
 
-    py::class_<TimeshiftBufferExport>(m, "TimeshiftBufferExport")
+    py::class_<TimeshiftBufferExport>(m, "TimeshiftBufferExport", py::buffer_protocol())
         .def(py::init<>())
+        // memoryview(export) / numpy.asarray(export) view the C++ storage without copying:
+        // a (frames, channels) array of float32, int16 or int32, or flat bytes for 24-bit PCM.
+        .def_buffer([](TimeshiftBufferExport& self) -> py::buffer_info {
+            const py::ssize_t channels = std::max(self.channels, 1);
+            const py::ssize_t sample_bytes = self.bit_depth / 8;
+            std::string format;
+            if (self.float32) {
+                format = py::format_descriptor<float>::format();
+            } else if (self.bit_depth == 16) {
+                format = py::format_descriptor<int16_t>::format();
+            } else if (self.bit_depth == 32) {
+                format = py::format_descriptor<int32_t>::format();
+            }
+            if (format.empty()) {
+                return py::buffer_info(self.pcm_data.data(), 1, py::format_descriptor<uint8_t>::format(), 1,
+                                       {static_cast<py::ssize_t>(self.pcm_data.size())}, {py::ssize_t(1)}, true);
+            }
+            const py::ssize_t frames = static_cast<py::ssize_t>(self.pcm_data.size()) / (sample_bytes * channels);
+            return py::buffer_info(self.pcm_data.data(), sample_bytes, format, 2,
+                                   {frames, channels}, {sample_bytes * channels, sample_bytes}, true);
+        })
         .def_property_readonly(
             "pcm_data",
             [](const TimeshiftBufferExport& self) {
                 return py::bytes(reinterpret_cast<const char*>(self.pcm_data.data()), self.pcm_data.size());
             },
-            "Raw PCM payload as bytes.")
+            "Raw PCM payload as a bytes copy; use memoryview(export) to avoid the copy.")
         .def_readonly("sample_rate", &TimeshiftBufferExport::sample_rate)
         .def_readonly("channels", &TimeshiftBufferExport::channels)
         .def_readonly("bit_depth", &TimeshiftBufferExport::bit_depth)
+        .def_readonly("float32", &TimeshiftBufferExport::float32)
         .def_readonly("chunk_size_bytes", &TimeshiftBufferExport::chunk_size_bytes)
         .def_readonly("duration_seconds", &TimeshiftBufferExport::duration_seconds)
         .def_readonly("earliest_packet_age_seconds", &TimeshiftBufferExport::earliest_packet_age_seconds)
@@ -532,8 +662,12 @@ inline void bind_audio_manager(pybind11::module_ &m) {
              &AudioManager::export_timeshift_buffer,
              py::arg("source_tag"),
              py::arg("lookback_seconds") = 300.0,
-             "Exports a raw PCM window from the timeshift buffer for the specified source. "
-             "Returns a TimeshiftBufferExport instance or None if data is unavailable.")
+             py::arg("end_seconds_ago") = 0.0,
+             py::arg("as_float32") = false,
+             py::call_guard<py::gil_scoped_release>(),
+             "Exports the PCM received between lookback_seconds and end_seconds_ago before now for the "
+             "specified source, optionally as float32. Returns a TimeshiftBufferExport instance (which "
+             "supports the buffer protocol) or None if data is unavailable.")
         .def("get_rtp_receiver_seen_tags", &AudioManager::get_rtp_receiver_seen_tags,
              "Retrieves the list of seen source tags from the main RTP receiver.")
         .def("get_rtp_sap_announcements", &AudioManager::get_rtp_sap_announcements,
@@ -548,22 +682,29 @@ inline void bind_audio_manager(pybind11::module_ &m) {
         .def("get_pulse_receiver_seen_tags", &AudioManager::get_pulse_receiver_seen_tags,
              "Retrieves the list of seen source tags from the PulseAudio receiver.")
 #endif
+        .def("start_pcap_replay", &AudioManager::start_pcap_replay,
+             py::arg("config"),
+             py::call_guard<py::gil_scoped_release>(),
+             "Replays a pcap/pcapng capture into the UDP receivers. Returns True if the replay started.")
+        .def("stop_pcap_replay", &AudioManager::stop_pcap_replay,
+             py::call_guard<py::gil_scoped_release>(),
+             "Stops the running capture replay, if any.")
+        .def("get_pcap_replay_stats", &AudioManager::get_pcap_replay_stats,
+             "Returns PcapReplayStats for the current or last capture replay, or None.")
         .def("write_plugin_packet",
              [](AudioManager &self,
                 const std::string& source_instance_id,
-                py::bytes audio_payload_bytes,
+                const py::buffer& audio_payload,
                 int channels,
                 int sample_rate,
                 int bit_depth,
                 uint8_t chlayout1,
                 uint8_t chlayout2) -> bool {
-                 py::buffer_info info = py::buffer(audio_payload_bytes).request();
-                 const uint8_t* ptr = static_cast<const uint8_t*>(info.ptr);
-                 std::vector<uint8_t> audio_payload_vec(ptr, ptr + info.size);
-                 
+                 std::vector<uint8_t> payload = copy_plugin_payload(audio_payload);
+                 py::gil_scoped_release release;
                  return self.write_plugin_packet(
                      source_instance_id,
-                     audio_payload_vec,
+                     std::move(payload),
                      channels,
                      sample_rate,
                      bit_depth,
@@ -578,7 +719,39 @@ inline void bind_audio_manager(pybind11::module_ &m) {
              py::arg("bit_depth"),
              py::arg("chlayout1"),
              py::arg("chlayout2"),
-             "Allows a plugin to inject a pre-formed audio packet (as bytes) into a SourceInputProcessor instance. Returns true on success.")
+             "Allows a plugin to inject a pre-formed audio packet (any C-contiguous buffer: bytes, memoryview, numpy) into a SourceInputProcessor instance. Returns true on success.")
+        .def("write_plugin_packets",
+             [](AudioManager &self,
+                const std::string& source_instance_id,
+                const py::iterable& audio_payloads,
+                int channels,
+                int sample_rate,
+                int bit_depth,
+                uint8_t chlayout1,
+                uint8_t chlayout2) -> std::size_t {
+                 std::vector<std::vector<uint8_t>> payloads;
+                 for (const py::handle item : audio_payloads) {
+                     payloads.push_back(copy_plugin_payload(item));
+                 }
+                 py::gil_scoped_release release;
+                 return self.write_plugin_packets(
+                     source_instance_id,
+                     std::move(payloads),
+                     channels,
+                     sample_rate,
+                     bit_depth,
+                     chlayout1,
+                     chlayout2
+                 );
+             },
+             py::arg("source_instance_id"),
+             py::arg("audio_payloads"),
+             py::arg("channels"),
+             py::arg("sample_rate"),
+             py::arg("bit_depth"),
+             py::arg("chlayout1"),
+             py::arg("chlayout2"),
+             "Injects consecutive packets of one format (an iterable of C-contiguous buffers) in a single call. Returns the number of packets injected.")
        .def("add_webrtc_listener", &AudioManager::add_webrtc_listener,
             py::arg("sink_id"),
             py::arg("listener_id"),
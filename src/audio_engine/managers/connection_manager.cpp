@@ -6,6 +6,22 @@
 namespace screamrouter {
 namespace audio {
 
+namespace {
+// Processed chunks are small and the consuming mixer drains every tick; this covers
+// roughly as much audio as the packet ring ahead of the ingest sink.
+constexpr std::size_t kDedupChunkRingCapacity = 128;
+
+bool split_ring_key(const std::string& key, std::string& sink_id, std::string& source_id) {
+    auto delimiter = key.find('|');
+    if (delimiter == std::string::npos) {
+        return false;
+    }
+    sink_id = key.substr(0, delimiter);
+    source_id = key.substr(delimiter + 1);
+    return true;
+}
+} // namespace
+
 ConnectionManager::ConnectionManager(
     std::recursive_mutex& manager_mutex,
     SourceManager* source_manager,
@@ -42,18 +58,28 @@ bool ConnectionManager::connect_source_sink(const std::string& source_instance_i
         return false;
     }
 
-    auto ring = std::make_shared<utils::PacketRing<TaggedAudioPacket>>(128);
-    std::string ring_key = sink_id + "|" + source_instance_id;
-    m_ready_rings[ring_key] = ring;
+    const std::string ring_key = sink_id + "|" + source_instance_id;
+    if (m_dedup_rings.count(ring_key) != 0) {
+        LOG_CPP_DEBUG("Source instance %s already fans its output out to sink %s", source_instance_id.c_str(), sink_id.c_str());
+        return true;
+    }
 
     const auto t_add0 = std::chrono::steady_clock::now();
-    m_sink_manager->add_input_queue_to_sink(sink_id, source_instance_id, ring, sip);
-    if (auto* ts = m_source_manager ? m_source_manager->get_timeshift_manager() : nullptr) {
-        ts->attach_sink_ring(source_instance_id, sip->get_source_tag(), sink_id, ring);
+    auto ingest_it = m_ingest_sinks.find(source_instance_id);
+    const bool deduplicated = ingest_it != m_ingest_sinks.end() && ingest_it->second != sink_id;
+    if (deduplicated) {
+        // The processor is already driven by another sink; feed this one its chunks.
+        auto chunk_ring = std::make_shared<ProcessedChunkRing>(kDedupChunkRingCapacity);
+        m_dedup_rings[ring_key] = chunk_ring;
+        m_sink_manager->add_dedup_input_to_sink(sink_id, source_instance_id, chunk_ring);
+        sip->add_dedup_output(sink_id, chunk_ring);
+    } else {
+        attach_ingest_sink(source_instance_id, sink_id, sip);
     }
     const auto t_add1 = std::chrono::steady_clock::now();
-    LOG_CPP_INFO("Connection successful: Source instance %s -> Sink %s (enqueue=%lld ms total=%lld ms)",
+    LOG_CPP_INFO("Connection successful: Source instance %s -> Sink %s%s (enqueue=%lld ms total=%lld ms)",
                  source_instance_id.c_str(), sink_id.c_str(),
+                 deduplicated ? " (identical-path dedup)" : "",
                  (long long)std::chrono::duration_cast<std::chrono::milliseconds>(t_add1 - t_add0).count(),
                  (long long)std::chrono::duration_cast<std::chrono::milliseconds>(t_add1 - t0).count());
     return true;
@@ -72,17 +98,28 @@ bool ConnectionManager::disconnect_source_sink(const std::string& source_instanc
         LOG_CPP_WARNING("Source processor instance not found for disconnection: %s. Assuming already disconnected.", source_instance_id.c_str());
         return true;
     }
+    auto* sip = source_it->second.get();
 
     const auto t_rm0 = std::chrono::steady_clock::now();
     m_sink_manager->remove_input_queue_from_sink(sink_id, source_instance_id);
     std::string ring_key = sink_id + "|" + source_instance_id;
+    auto dedup_it = m_dedup_rings.find(ring_key);
+    if (dedup_it != m_dedup_rings.end()) {
+        sip->remove_dedup_output(sink_id);
+        m_dedup_rings.erase(dedup_it);
+    }
     auto ring_it = m_ready_rings.find(ring_key);
     if (ring_it != m_ready_rings.end()) {
         if (auto* ts = m_source_manager ? m_source_manager->get_timeshift_manager() : nullptr) {
-            ts->detach_sink_ring(source_instance_id, source_it->second->get_source_tag(), sink_id);
+            ts->detach_sink_ring(source_instance_id, sip->get_source_tag(), sink_id);
         }
         m_ready_rings.erase(ring_it);
     }
+    auto ingest_it = m_ingest_sinks.find(source_instance_id);
+    if (ingest_it != m_ingest_sinks.end() && ingest_it->second == sink_id) {
+        m_ingest_sinks.erase(ingest_it);
+        promote_dedup_sink(source_instance_id, sip);
+    }
     const auto t_rm1 = std::chrono::steady_clock::now();
     LOG_CPP_INFO("Disconnection successful: Source instance %s -x Sink %s (remove=%lld ms total=%lld ms)",
                  source_instance_id.c_str(), sink_id.c_str(),
@@ -91,22 +128,67 @@ bool ConnectionManager::disconnect_source_sink(const std::string& source_instanc
     return true;
 }
 
+void ConnectionManager::attach_ingest_sink(const std::string& source_instance_id, const std::string& sink_id, SourceInputProcessor* sip) {
+    auto ring = std::make_shared<utils::PacketRing<TaggedAudioPacket>>(128);
+    m_ready_rings[sink_id + "|" + source_instance_id] = ring;
+    m_ingest_sinks[source_instance_id] = sink_id;
+
+    m_sink_manager->add_input_queue_to_sink(sink_id, source_instance_id, ring, sip);
+    if (auto* ts = m_source_manager ? m_source_manager->get_timeshift_manager() : nullptr) {
+        ts->attach_sink_ring(source_instance_id, sip->get_source_tag(), sink_id, ring);
+    }
+}
+
+void ConnectionManager::promote_dedup_sink(const std::string& source_instance_id, SourceInputProcessor* sip) {
+    std::string sink_id;
+    std::string source_id;
+    for (auto it = m_dedup_rings.begin(); it != m_dedup_rings.end(); ++it) {
+        if (!split_ring_key(it->first, sink_id, source_id) || source_id != source_instance_id) {
+            continue;
+        }
+        sip->remove_dedup_output(sink_id);
+        m_dedup_rings.erase(it);
+        attach_ingest_sink(source_instance_id, sink_id, sip);
+        LOG_CPP_INFO("Source instance %s now ingested by sink %s", source_instance_id.c_str(), sink_id.c_str());
+        return;
+    }
+}
+
 std::vector<std::string> ConnectionManager::list_sinks_for_source(const std::string& source_instance_id) const {
     std::vector<std::string> sinks;
     std::scoped_lock lock(m_manager_mutex);
+    std::string sink_id;
+    std::string source_id;
     for (const auto& [key, _] : m_ready_rings) {
-        auto delimiter = key.find('|');
-        if (delimiter == std::string::npos) {
-            continue;
+        if (split_ring_key(key, sink_id, source_id) && source_id == source_instance_id) {
+            sinks.push_back(sink_id);
         }
-        const std::string sink_id = key.substr(0, delimiter);
-        const std::string source_id = key.substr(delimiter + 1);
-        if (source_id == source_instance_id) {
+    }
+    for (const auto& [key, _] : m_dedup_rings) {
+        if (split_ring_key(key, sink_id, source_id) && source_id == source_instance_id) {
             sinks.push_back(sink_id);
         }
     }
     return sinks;
 }
 
+std::vector<std::string> ConnectionManager::list_sources_for_sink(const std::string& sink_id) const {
+    std::vector<std::string> sources;
+    std::scoped_lock lock(m_manager_mutex);
+    std::string key_sink;
+    std::string source_id;
+    for (const auto& [key, _] : m_ready_rings) {
+        if (split_ring_key(key, key_sink, source_id) && key_sink == sink_id) {
+            sources.push_back(source_id);
+        }
+    }
+    for (const auto& [key, _] : m_dedup_rings) {
+        if (split_ring_key(key, key_sink, source_id) && key_sink == sink_id) {
+            sources.push_back(source_id);
+        }
+    }
+    return sources;
+}
+
 } // namespace audio
 } // namespace screamrouter
@@ -3,6 +3,8 @@
  * @brief Defines the ConnectionManager class for handling source-to-sink connections.
  * @details This class encapsulates the logic for connecting and disconnecting
  *          source processors to sink mixers, managing the underlying queue subscriptions.
+ *          A processor connected to several sinks is processed once and its output is
+ *          fanned out to the additional sinks.
  */
 #ifndef CONNECTION_MANAGER_H
 #define CONNECTION_MANAGER_H
@@ -65,13 +67,28 @@ public:
     bool disconnect_source_sink(const std::string& source_instance_id, const std::string& sink_id, bool running);
 
     std::vector<std::string> list_sinks_for_source(const std::string& source_instance_id) const;
+    /** @brief Lists the source instances currently connected to a sink. */
+    std::vector<std::string> list_sources_for_sink(const std::string& sink_id) const;
 
 private:
+    /** @brief Makes @p sink_id the sink whose mixer feeds packets into the processor. */
+    void attach_ingest_sink(const std::string& source_instance_id, const std::string& sink_id, SourceInputProcessor* sip);
+    /** @brief Hands ingest to one of the processor's deduplicated sinks after its ingest sink disconnects. */
+    void promote_dedup_sink(const std::string& source_instance_id, SourceInputProcessor* sip);
+
     std::recursive_mutex& m_manager_mutex;
     SourceManager* m_source_manager;
     SinkManager* m_sink_manager;
     std::map<std::string, std::unique_ptr<SourceInputProcessor>>& m_sources;
     std::map<std::string, std::shared_ptr<utils::PacketRing<TaggedAudioPacket>>> m_ready_rings;
+    /**
+     * @brief Processed-chunk rings for sinks whose identical path is deduplicated onto a processor another sink drives.
+     * @details A processor connected to several sinks is run once, by its ingest sink; every
+     *          other sink receives copies of its chunks. Keyed like m_ready_rings.
+     */
+    std::map<std::string, std::shared_ptr<ProcessedChunkRing>> m_dedup_rings;
+    /** @brief Source instance ID -> sink whose mixer calls ingest_packet() on it. */
+    std::map<std::string, std::string> m_ingest_sinks;
 };
 
 } // namespace audio
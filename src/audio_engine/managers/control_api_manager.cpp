@@ -1,4 +1,5 @@
 #include "control_api_manager.h"
+#include "../utils/audio_clock.h"
 #include "../utils/cpp_logger.h"
 #include "../utils/lock_guard_profiler.h"
 #include "../input_processor/timeshift_manager.h"
@@ -160,7 +161,7 @@ void ControlApiManager::update_source_speaker_layouts_map_nolock(const std::stri
 
 bool ControlApiManager::write_plugin_packet(
     const std::string& source_instance_tag,
-    const std::vector<uint8_t>& audio_payload,
+    std::vector<uint8_t> audio_payload,
     int channels,
     int sample_rate,
     int bit_depth,
@@ -168,67 +169,128 @@ bool ControlApiManager::write_plugin_packet(
     uint8_t chlayout2,
     bool running)
 {
-    if (!running) {
-        LOG_CPP_ERROR("ControlApiManager not running. Cannot write plugin packet.");
+    if (!plugin_target_ready(source_instance_tag, running)) {
         return false;
     }
 
-    // Find the SourceInputProcessor by its original tag (passed as source_instance_tag parameter)
-    SourceInputProcessor* target_processor_ptr = nullptr;
-    // Iterate over the sources map to find a processor whose configured tag matches source_instance_tag (with wildcard tolerance)
-    for (const auto& pair : m_sources) {
-        if (pair.second) { // Check if the unique_ptr is valid
-            if (pair.second->matches_source_tag(source_instance_tag)) {
-                target_processor_ptr = pair.second.get();
-                break;
-            }
-        }
+    const uint32_t frame_count = plugin_frame_count(audio_payload.size(), channels, bit_depth);
+    uint32_t rtp_timestamp = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_plugin_rtp_mutex);
+        uint32_t& counter = m_plugin_rtp_counters[source_instance_tag];
+        counter += frame_count;
+        rtp_timestamp = counter;
     }
 
-    if (!target_processor_ptr) {
-        LOG_CPP_ERROR("SourceInputProcessor instance not found for tag: %s", source_instance_tag.c_str());
-        return false;
+    // The 'source_instance_tag' passed to write_plugin_packet is the 'source_tag'
+    // that TimeshiftManager will use for filtering.
+    inject_plugin_packet(source_instance_tag, std::move(audio_payload), channels, sample_rate, bit_depth,
+                         chlayout1, chlayout2, rtp_timestamp, utils::AudioClock::now());
+    return true;
+}
+
+std::size_t ControlApiManager::write_plugin_packets(
+    const std::string& source_instance_tag,
+    std::vector<std::vector<uint8_t>> audio_payloads,
+    int channels,
+    int sample_rate,
+    int bit_depth,
+    uint8_t chlayout1,
+    uint8_t chlayout2,
+    bool running)
+{
+    if (audio_payloads.empty() || !plugin_target_ready(source_instance_tag, running)) {
+        return 0;
     }
 
-    uint32_t assigned_rtp_timestamp = 0;
+    // Reserve the batch's whole RTP range at once; per-packet values are derived from it below.
+    uint64_t batch_frames = 0;
+    for (const auto& payload : audio_payloads) {
+        batch_frames += plugin_frame_count(payload.size(), channels, bit_depth);
+    }
+    uint32_t batch_base = 0;
     {
         std::lock_guard<std::mutex> lock(m_plugin_rtp_mutex);
-        const int bytes_per_sample = (bit_depth > 0 && (bit_depth % 8) == 0) ? (bit_depth / 8) : 0;
-        const int bytes_per_frame = (channels > 0 && bytes_per_sample > 0) ? (channels * bytes_per_sample) : 0;
+        uint32_t& counter = m_plugin_rtp_counters[source_instance_tag];
+        batch_base = counter;
+        counter += static_cast<uint32_t>(batch_frames);
+    }
 
-        uint32_t frame_count = 0;
-        if (bytes_per_frame > 0) {
-            frame_count = static_cast<uint32_t>(audio_payload.size() / static_cast<size_t>(bytes_per_frame));
+    // The batch is consecutive audio that had all arrived by now. Stamp each packet with the time
+    // its last frame would have arrived, so the timeshift buffer sees the same spacing as for one
+    // write per packet and jitter and lateness estimates stay meaningful.
+    const auto batch_end = utils::AudioClock::now();
+    uint64_t frames_done = 0;
+    for (auto& payload : audio_payloads) {
+        frames_done += plugin_frame_count(payload.size(), channels, bit_depth);
+        auto received_time = batch_end;
+        if (sample_rate > 0) {
+            received_time -= std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(static_cast<double>(batch_frames - frames_done) /
+                                              static_cast<double>(sample_rate)));
         }
-        if (frame_count == 0) {
-            frame_count = 1; // Fallback to ensure timestamp advances even on malformed packets.
-        }
-
-        uint32_t& counter = m_plugin_rtp_counters[source_instance_tag];
-        counter += frame_count;
-        assigned_rtp_timestamp = counter;
+        inject_plugin_packet(source_instance_tag, std::move(payload), channels, sample_rate, bit_depth,
+                             chlayout1, chlayout2, batch_base + static_cast<uint32_t>(frames_done), received_time);
     }
 
-    // The 'source_instance_tag' passed to write_plugin_packet is the 'source_tag'
-    // that TimeshiftManager will use for filtering.
-    if (m_timeshift_manager) {
-        TaggedAudioPacket packet;
-        packet.source_tag = source_instance_tag;
-        packet.received_time = std::chrono::steady_clock::now();
-        packet.sample_rate = sample_rate;
-        packet.bit_depth = bit_depth;
-        packet.channels = channels;
-        packet.chlayout1 = chlayout1;
-        packet.chlayout2 = chlayout2;
-        packet.audio_data = audio_payload;
-        packet.rtp_timestamp = assigned_rtp_timestamp;
-        m_timeshift_manager->add_packet(std::move(packet));
-    } else {
+    return audio_payloads.size();
+}
+
+bool ControlApiManager::plugin_target_ready(const std::string& source_instance_tag, bool running) {
+    if (!running) {
+        LOG_CPP_ERROR("ControlApiManager not running. Cannot write plugin packet.");
+        return false;
+    }
+    if (!m_timeshift_manager) {
         LOG_CPP_ERROR("TimeshiftManager is null. Cannot inject plugin packet.");
         return false;
     }
 
-    return true; // Assume success if the call is made.
+    // Find a SourceInputProcessor whose configured tag matches source_instance_tag (with wildcard
+    // tolerance). Callers no longer hold the GIL, so the map is guarded like every other lookup.
+    {
+        std::scoped_lock lock(m_manager_mutex);
+        for (const auto& pair : m_sources) {
+            if (pair.second && pair.second->matches_source_tag(source_instance_tag)) {
+                return true;
+            }
+        }
+    }
+    LOG_CPP_ERROR("SourceInputProcessor instance not found for tag: %s", source_instance_tag.c_str());
+    return false;
+}
+
+uint32_t ControlApiManager::plugin_frame_count(std::size_t payload_bytes, int channels, int bit_depth) {
+    const int bytes_per_sample = (bit_depth > 0 && (bit_depth % 8) == 0) ? (bit_depth / 8) : 0;
+    const int bytes_per_frame = (channels > 0 && bytes_per_sample > 0) ? (channels * bytes_per_sample) : 0;
+    uint32_t frame_count = 0;
+    if (bytes_per_frame > 0) {
+        frame_count = static_cast<uint32_t>(payload_bytes / static_cast<size_t>(bytes_per_frame));
+    }
+    // Fallback to ensure timestamp advances even on malformed packets.
+    return frame_count == 0 ? 1 : frame_count;
+}
+
+void ControlApiManager::inject_plugin_packet(const std::string& source_instance_tag,
+                                             std::vector<uint8_t>&& audio_payload,
+                                             int channels,
+                                             int sample_rate,
+                                             int bit_depth,
+                                             uint8_t chlayout1,
+                                             uint8_t chlayout2,
+                                             uint32_t rtp_timestamp,
+                                             std::chrono::steady_clock::time_point received_time) {
+    TaggedAudioPacket packet;
+    packet.source_tag = source_instance_tag;
+    packet.received_time = received_time;
+    packet.sample_rate = sample_rate;
+    packet.bit_depth = bit_depth;
+    packet.channels = channels;
+    packet.chlayout1 = chlayout1;
+    packet.chlayout2 = chlayout2;
+    packet.audio_data = std::move(audio_payload);
+    packet.rtp_timestamp = rtp_timestamp;
+    m_timeshift_manager->add_packet(std::move(packet));
 }
 
 } // namespace audio
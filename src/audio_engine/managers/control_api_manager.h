@@ -16,6 +16,7 @@
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <chrono>
 #include <cstdint>
 
 namespace screamrouter {
@@ -62,7 +63,7 @@ public:
     /**
      * @brief Injects a plugin-generated audio packet into a source processor.
      * @param source_instance_tag The tag of the target source processor.
-     * @param audio_payload The raw audio data.
+     * @param audio_payload The raw audio data; moved into the packet without another copy.
      * @param channels Number of audio channels.
      * @param sample_rate Sample rate in Hz.
      * @param bit_depth Bit depth.
@@ -73,7 +74,25 @@ public:
      */
     bool write_plugin_packet(
         const std::string& source_instance_tag,
-        const std::vector<uint8_t>& audio_payload,
+        std::vector<uint8_t> audio_payload,
+        int channels,
+        int sample_rate,
+        int bit_depth,
+        uint8_t chlayout1,
+        uint8_t chlayout2,
+        bool running
+    );
+
+    /**
+     * @brief Injects several consecutive plugin packets of one format into a source processor.
+     * @details The target is resolved and the RTP counter advanced once for the whole batch.
+     *          Receive times are spaced by packet duration, the last packet stamped with
+     *          AudioClock::now() at the time of the call.
+     * @return The number of packets injected (all of them, or 0 if the target is missing).
+     */
+    std::size_t write_plugin_packets(
+        const std::string& source_instance_tag,
+        std::vector<std::vector<uint8_t>> audio_payloads,
         int channels,
         int sample_rate,
         int bit_depth,
@@ -83,6 +102,20 @@ public:
     );
 
 private:
+    /// Logs and returns false unless the engine runs and a processor matches the tag.
+    bool plugin_target_ready(const std::string& source_instance_tag, bool running);
+    /// Frames in a payload, at least 1 so the RTP counter always advances.
+    static uint32_t plugin_frame_count(std::size_t payload_bytes, int channels, int bit_depth);
+    void inject_plugin_packet(const std::string& source_instance_tag,
+                              std::vector<uint8_t>&& audio_payload,
+                              int channels,
+                              int sample_rate,
+                              int bit_depth,
+                              uint8_t chlayout1,
+                              uint8_t chlayout2,
+                              uint32_t rtp_timestamp,
+                              std::chrono::steady_clock::time_point received_time);
+
     SourceInputProcessor* find_source_nolock(const std::string& instance_id);
     void update_source_volume_nolock(const std::string& instance_id, float volume);
     void update_source_equalizer_nolock(const std::string& instance_id, const std::vector<float>& eq_values);
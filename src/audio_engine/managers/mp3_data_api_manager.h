@@ -10,6 +10,7 @@
 #include "../audio_types.h"
 #include "../configuration/audio_engine_config_types.h"
 #include "../utils/thread_safe_queue.h"
+#include "../utils/mpsc_queue.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -19,7 +20,7 @@
 
 namespace screamrouter {
 namespace audio {
-using Mp3Queue = utils::ThreadSafeQueue<EncodedMP3Data>;
+using Mp3Queue = utils::MpscQueue<EncodedMP3Data>;
 using ChunkQueue = utils::ThreadSafeQueue<ProcessedAudioChunk>;
 
 /**
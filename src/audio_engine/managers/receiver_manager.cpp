@@ -29,6 +29,7 @@ bool ReceiverManager::initialize_receivers(int rtp_listen_port, std::shared_ptr<
         m_notification_queue = notification_queue;
         RtpReceiverConfig rtp_config;
         rtp_config.listen_port = rtp_listen_port;
+        m_rtp_listen_port = rtp_listen_port;
         m_rtp_receiver = std::make_unique<RtpReceiver>(rtp_config, notification_queue, m_timeshift_manager);
 
         RawScreamReceiverConfig raw_config_1;
@@ -82,6 +83,7 @@ void ReceiverManager::start_receivers() {
 }
 
 void ReceiverManager::stop_receivers() {
+    stop_pcap_replay();
     if (m_rtp_receiver) {
         m_rtp_receiver->stop();
     }
@@ -104,6 +106,7 @@ void ReceiverManager::stop_receivers() {
 }
 
 void ReceiverManager::cleanup_receivers() {
+    m_pcap_replay.reset();
     m_rtp_receiver.reset();
     m_raw_scream_receivers.clear();
     m_per_process_scream_receivers.clear();
@@ -348,6 +351,72 @@ void ReceiverManager::set_format_probe_min_bytes(size_t min_bytes) {
     }
 }
 
+NetworkAudioReceiver* ReceiverManager::find_udp_receiver(int port) {
+    if (m_rtp_receiver && port == m_rtp_listen_port) {
+        return m_rtp_receiver.get();
+    }
+    auto raw_it = m_raw_scream_receivers.find(port);
+    if (raw_it != m_raw_scream_receivers.end()) {
+        return raw_it->second.get();
+    }
+    auto per_process_it = m_per_process_scream_receivers.find(port);
+    if (per_process_it != m_per_process_scream_receivers.end()) {
+        return per_process_it->second.get();
+    }
+    return nullptr;
+}
+
+bool ReceiverManager::start_pcap_replay(const PcapReplayConfig& config) {
+    std::scoped_lock lock(m_manager_mutex);
+    if (m_pcap_replay) {
+        m_pcap_replay->stop();
+        m_pcap_replay.reset();
+    }
+
+    try {
+        auto replay = std::make_unique<PcapReplayReceiver>(config);
+        if (config.target_port > 0) {
+            NetworkAudioReceiver* target = find_udp_receiver(config.target_port);
+            if (!target) {
+                LOG_CPP_ERROR("[ReceiverManager] No UDP receiver on port %d for capture replay.", config.target_port);
+                return false;
+            }
+            replay->add_target(0, target);
+        } else {
+            if (m_rtp_receiver) {
+                replay->add_target(static_cast<uint16_t>(m_rtp_listen_port), m_rtp_receiver.get());
+            }
+            for (auto const& [port, receiver] : m_raw_scream_receivers) {
+                replay->add_target(static_cast<uint16_t>(port), receiver.get());
+            }
+            for (auto const& [port, receiver] : m_per_process_scream_receivers) {
+                replay->add_target(static_cast<uint16_t>(port), receiver.get());
+            }
+        }
+        replay->start();
+        m_pcap_replay = std::move(replay);
+    } catch (const std::exception& e) {
+        LOG_CPP_ERROR("[ReceiverManager] Failed to start capture replay of %s: %s", config.file_path.c_str(), e.what());
+        return false;
+    }
+    return true;
+}
+
+void ReceiverManager::stop_pcap_replay() {
+    std::scoped_lock lock(m_manager_mutex);
+    if (m_pcap_replay) {
+        m_pcap_replay->stop();
+    }
+}
+
+std::optional<PcapReplayStats> ReceiverManager::get_pcap_replay_stats() {
+    std::scoped_lock lock(m_manager_mutex);
+    if (!m_pcap_replay) {
+        return std::nullopt;
+    }
+    return m_pcap_replay->get_stats();
+}
+
 void ReceiverManager::log_status() {
     // RTP
     if (m_rtp_receiver) {
@@ -18,6 +18,7 @@
 #include "../receivers/system/alsa_capture_receiver.h"
 #include "../receivers/system/screamrouter_fifo_receiver.h"
 #include "../receivers/system/wasapi_capture_receiver.h"
+#include "../receivers/replay/pcap_replay_receiver.h"
 #include "../system_audio/system_audio_tags.h"
 #include "../utils/thread_safe_queue.h"
 #include "../input_processor/timeshift_manager.h"
@@ -134,17 +135,41 @@ public:
      */
     void set_format_probe_min_bytes(size_t min_bytes);
 
+    /**
+     * @brief Replays a capture file into the running receivers.
+     * @details Datagrams go to the receiver listening on their captured destination port,
+     *          or all to config.target_port when it is set. Any previous replay is stopped.
+     * @param config The capture file, pacing and routing to use.
+     * @return true if the capture was opened and the replay started.
+     */
+    bool start_pcap_replay(const PcapReplayConfig& config);
+
+    /**
+     * @brief Stops the current capture replay, if any.
+     */
+    void stop_pcap_replay();
+
+    /**
+     * @brief Gets the counters of the current or last capture replay.
+     * @return The stats, or std::nullopt if no replay has been started.
+     */
+    std::optional<PcapReplayStats> get_pcap_replay_stats();
+
     /**
      * @brief Logs the current status of receivers for debugging.
      */
     void log_status();
 
 private:
+    /** @brief Finds the UDP receiver listening on @p port, or nullptr. */
+    NetworkAudioReceiver* find_udp_receiver(int port);
+
     std::recursive_mutex& m_manager_mutex;
     TimeshiftManager* m_timeshift_manager;
     std::unique_ptr<ClockManager> m_clock_manager;
 
     std::unique_ptr<RtpReceiver> m_rtp_receiver;
+    int m_rtp_listen_port = 0;
     std::map<int, std::unique_ptr<RawScreamReceiver>> m_raw_scream_receivers;
     std::map<int, std::unique_ptr<PerProcessScreamReceiver>> m_per_process_scream_receivers;
 #if !defined(_WIN32)
@@ -152,6 +177,7 @@ private:
 #endif
     std::unordered_map<std::string, std::unique_ptr<NetworkAudioReceiver>> capture_receivers_;
     std::unordered_map<std::string, size_t> capture_receiver_usage_;
+    std::unique_ptr<PcapReplayReceiver> m_pcap_replay;
     std::shared_ptr<NotificationQueue> m_notification_queue;
 
     std::function<void(const std::string&, const std::string&)> stream_tag_resolved_cb_;
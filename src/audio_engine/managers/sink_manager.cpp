@@ -5,6 +5,32 @@
 namespace screamrouter {
 namespace audio {
 
+namespace {
+SinkMixerConfig make_mixer_config(const SinkConfig& config) {
+    SinkMixerConfig mixer_config;
+    mixer_config.sink_id = config.id;
+    mixer_config.friendly_name = config.friendly_name;
+    mixer_config.system_device_tag = config.system_device_tag;
+    mixer_config.protocol = config.protocol;
+    mixer_config.sap_target_sink = config.sap_target_sink;
+    mixer_config.sap_target_host = config.sap_target_host;
+    mixer_config.output_ip = config.output_ip;
+    mixer_config.output_port = config.output_port;
+    mixer_config.output_bitdepth = config.bitdepth;
+    mixer_config.output_samplerate = config.samplerate;
+    mixer_config.output_channels = config.channels;
+    mixer_config.output_chlayout1 = config.chlayout1;
+    mixer_config.output_chlayout2 = config.chlayout2;
+    mixer_config.speaker_layout = config.speaker_layout;
+    mixer_config.time_sync_enabled = config.time_sync_enabled;
+    mixer_config.time_sync_delay_ms = config.time_sync_delay_ms;
+    mixer_config.rtp_receivers = config.rtp_receivers;
+    mixer_config.multi_device_mode = config.multi_device_mode;
+    mixer_config.resampler_quality = config.resampler_quality;
+    return mixer_config;
+}
+} // namespace
+
 SinkManager::SinkManager(std::recursive_mutex& manager_mutex,
                          std::shared_ptr<screamrouter::audio::AudioEngineSettings> settings,
                          TimeshiftManager* timeshift_manager)
@@ -31,26 +57,7 @@ bool SinkManager::add_sink(const SinkConfig& config, bool running) {
     auto mp3_queue = std::make_shared<Mp3Queue>();
 
     try {
-        SinkMixerConfig mixer_config;
-        mixer_config.sink_id = config.id;
-        mixer_config.friendly_name = config.friendly_name;
-        mixer_config.system_device_tag = config.system_device_tag;
-        mixer_config.protocol = config.protocol;
-        mixer_config.sap_target_sink = config.sap_target_sink;
-        mixer_config.sap_target_host = config.sap_target_host;
-        mixer_config.output_ip = config.output_ip;
-        mixer_config.output_port = config.output_port;
-        mixer_config.output_bitdepth = config.bitdepth;
-        mixer_config.output_samplerate = config.samplerate;
-        mixer_config.output_channels = config.channels;
-        mixer_config.output_chlayout1 = config.chlayout1;
-        mixer_config.output_chlayout2 = config.chlayout2;
-        mixer_config.speaker_layout = config.speaker_layout;
-        mixer_config.time_sync_enabled = config.time_sync_enabled;
-        mixer_config.time_sync_delay_ms = config.time_sync_delay_ms;
-        mixer_config.rtp_receivers = config.rtp_receivers;
-        mixer_config.multi_device_mode = config.multi_device_mode;
-        new_sink = std::make_unique<SinkAudioMixer>(mixer_config, mp3_queue, m_settings);
+        new_sink = std::make_unique<SinkAudioMixer>(make_mixer_config(config), mp3_queue, m_settings);
     } catch (const std::exception& e) {
         LOG_CPP_ERROR("Failed to create SinkAudioMixer for %s: %s", config.id.c_str(), e.what());
         return false;
@@ -58,13 +65,21 @@ bool SinkManager::add_sink(const SinkConfig& config, bool running) {
 
     {
         std::scoped_lock lock(m_manager_mutex);
-        if (m_sinks.count(config.id)) {
+        if (m_sinks.count(config.id) || m_group_leaders.count(config.id)) {
             LOG_CPP_ERROR("Sink ID already exists: %s", config.id.c_str());
             return false;
         }
         m_mp3_output_queues[config.id] = mp3_queue;
         m_sinks[config.id] = std::move(new_sink);
         m_sink_configs[config.id] = config;
+        // A sink leaving a mix group takes back the listeners it had on the leader's mixer.
+        auto detached_it = m_detached_listeners.find(config.id);
+        if (detached_it != m_detached_listeners.end()) {
+            for (auto& [listener_id, sender] : detached_it->second) {
+                m_sinks[config.id]->adopt_listener(listener_id, std::move(sender));
+            }
+            m_detached_listeners.erase(detached_it);
+        }
     }
 
     const auto t_make1 = std::chrono::steady_clock::now();
@@ -81,18 +96,55 @@ bool SinkManager::add_sink(const SinkConfig& config, bool running) {
 bool SinkManager::remove_sink(const std::string& sink_id) {
     LOG_CPP_INFO("Removing sink: %s", sink_id.c_str());
     std::unique_ptr<SinkAudioMixer> sink_to_remove;
+    std::vector<std::unique_ptr<INetworkSender>> listeners_to_close;
+    bool found = true;
 
     {
         std::scoped_lock lock(m_manager_mutex);
         auto it = m_sinks.find(sink_id);
         if (it == m_sinks.end()) {
-            LOG_CPP_ERROR("Sink not found: %s", sink_id.c_str());
-            return false;
+            auto member_it = m_group_leaders.find(sink_id);
+            if (member_it != m_group_leaders.end()) {
+                // A grouped sink has no mixer of its own; stop mirroring and drop its listeners.
+                auto leader_it = m_sinks.find(member_it->second);
+                SinkAudioMixer* leader = leader_it != m_sinks.end() ? leader_it->second.get() : nullptr;
+                if (leader) {
+                    leader->remove_mirror_sink(sink_id);
+                }
+                detach_listeners(sink_id, leader);
+                m_group_leaders.erase(member_it);
+                listeners_to_close = release_listeners(sink_id);
+            } else {
+                listeners_to_close = release_listeners(sink_id);
+                LOG_CPP_ERROR("Sink not found: %s", sink_id.c_str());
+                found = false;
+            }
+        } else {
+            // Members fed by this mixer lose their output with it, but keep their listeners
+            // until they get a mixer of their own or are removed.
+            for (auto member_it = m_group_leaders.begin(); member_it != m_group_leaders.end();) {
+                if (member_it->second == sink_id) {
+                    LOG_CPP_WARNING("[SinkManager] Sink %s removed while still feeding grouped sink %s",
+                                    sink_id.c_str(), member_it->first.c_str());
+                    detach_listeners(member_it->first, it->second.get());
+                    member_it = m_group_leaders.erase(member_it);
+                } else {
+                    ++member_it;
+                }
+            }
+            m_sink_listeners.erase(sink_id);
+            sink_to_remove = std::move(it->second);
+            m_sinks.erase(it);
+            m_sink_configs.erase(sink_id);
+            m_mp3_output_queues.erase(sink_id);
         }
-        sink_to_remove = std::move(it->second);
-        m_sinks.erase(it);
-        m_sink_configs.erase(sink_id);
-        m_mp3_output_queues.erase(sink_id);
+    }
+
+    for (auto& listener : listeners_to_close) {
+        listener->close();
+    }
+    if (!found) {
+        return false;
     }
 
     if (sink_to_remove) {
@@ -104,6 +156,102 @@ bool SinkManager::remove_sink(const std::string& sink_id) {
     return true;
 }
 
+bool SinkManager::add_sink_to_group(const std::string& leader_sink_id, const SinkConfig& member_config) {
+    std::scoped_lock lock(m_manager_mutex);
+    if (m_sinks.count(member_config.id) || m_group_leaders.count(member_config.id)) {
+        LOG_CPP_ERROR("[SinkManager] Cannot group sink %s: ID already in use", member_config.id.c_str());
+        return false;
+    }
+    auto leader_it = m_sinks.find(leader_sink_id);
+    if (leader_it == m_sinks.end() || !leader_it->second) {
+        LOG_CPP_ERROR("[SinkManager] Cannot group sink %s: leader %s not found",
+                      member_config.id.c_str(), leader_sink_id.c_str());
+        return false;
+    }
+    if (!leader_it->second->add_mirror_sink(make_mixer_config(member_config))) {
+        return false;
+    }
+    m_group_leaders[member_config.id] = leader_sink_id;
+    LOG_CPP_INFO("[SinkManager] Sink %s now shares the mix of sink %s", member_config.id.c_str(), leader_sink_id.c_str());
+    return true;
+}
+
+bool SinkManager::remove_sink_from_group(const std::string& member_sink_id) {
+    std::scoped_lock lock(m_manager_mutex);
+    auto member_it = m_group_leaders.find(member_sink_id);
+    if (member_it == m_group_leaders.end()) {
+        return false;
+    }
+    auto leader_it = m_sinks.find(member_it->second);
+    SinkAudioMixer* leader = leader_it != m_sinks.end() ? leader_it->second.get() : nullptr;
+    if (leader) {
+        leader->remove_mirror_sink(member_sink_id);
+    }
+    // Held until add_sink() gives the sink its own mixer again.
+    detach_listeners(member_sink_id, leader);
+    LOG_CPP_INFO("[SinkManager] Sink %s no longer shares the mix of sink %s",
+                 member_sink_id.c_str(), member_it->second.c_str());
+    m_group_leaders.erase(member_it);
+    return true;
+}
+
+std::string SinkManager::get_group_leader(const std::string& sink_id) const {
+    std::scoped_lock lock(m_manager_mutex);
+    auto it = m_group_leaders.find(sink_id);
+    return it != m_group_leaders.end() ? it->second : std::string();
+}
+
+SinkAudioMixer* SinkManager::find_mixer(const std::string& sink_id) {
+    auto sink_it = m_sinks.find(sink_id);
+    if (sink_it == m_sinks.end()) {
+        // A grouped sink is served by its leader's mixer.
+        auto member_it = m_group_leaders.find(sink_id);
+        if (member_it != m_group_leaders.end()) {
+            sink_it = m_sinks.find(member_it->second);
+        }
+    }
+    return sink_it != m_sinks.end() ? sink_it->second.get() : nullptr;
+}
+
+void SinkManager::detach_listeners(const std::string& sink_id, SinkAudioMixer* mixer) {
+    auto owned_it = m_sink_listeners.find(sink_id);
+    if (owned_it == m_sink_listeners.end()) {
+        return;
+    }
+    auto& detached = m_detached_listeners[sink_id];
+    auto& owned = owned_it->second;
+    for (auto id_it = owned.begin(); id_it != owned.end();) {
+        auto sender = mixer ? mixer->take_listener(*id_it) : nullptr;
+        if (sender) {
+            detached[*id_it] = std::move(sender);
+            ++id_it;
+        } else {
+            // Already closed and cleaned up by the mixer.
+            id_it = owned.erase(id_it);
+        }
+    }
+    if (detached.empty()) {
+        m_detached_listeners.erase(sink_id);
+    }
+    if (owned.empty()) {
+        m_sink_listeners.erase(owned_it);
+    }
+}
+
+std::vector<std::unique_ptr<INetworkSender>> SinkManager::release_listeners(const std::string& sink_id) {
+    std::vector<std::unique_ptr<INetworkSender>> released;
+    m_sink_listeners.erase(sink_id);
+    auto detached_it = m_detached_listeners.find(sink_id);
+    if (detached_it != m_detached_listeners.end()) {
+        for (auto& [listener_id, sender] : detached_it->second) {
+            LOG_CPP_INFO("[SinkManager] Closing listener %s of removed sink %s", listener_id.c_str(), sink_id.c_str());
+            released.push_back(std::move(sender));
+        }
+        m_detached_listeners.erase(detached_it);
+    }
+    return released;
+}
+
 void SinkManager::add_input_queue_to_sink(const std::string& sink_id,
                                           const std::string& source_instance_id,
                                           std::shared_ptr<ReadyPacketRing> ready_ring,
@@ -117,6 +265,18 @@ void SinkManager::add_input_queue_to_sink(const std::string& sink_id,
     }
 }
 
+void SinkManager::add_dedup_input_to_sink(const std::string& sink_id,
+                                          const std::string& source_instance_id,
+                                          std::shared_ptr<ProcessedChunkRing> chunk_ring) {
+    std::scoped_lock lock(m_manager_mutex);
+    auto sink_it = m_sinks.find(sink_id);
+    if (sink_it != m_sinks.end() && sink_it->second) {
+        sink_it->second->add_dedup_input(source_instance_id, std::move(chunk_ring));
+    } else {
+        LOG_CPP_ERROR("Sink not found or invalid: %s", sink_id.c_str());
+    }
+}
+
 void SinkManager::remove_input_queue_from_sink(const std::string& sink_id, const std::string& source_instance_id) {
     std::scoped_lock lock(m_manager_mutex);
     auto sink_it = m_sinks.find(sink_id);
@@ -129,33 +289,101 @@ void SinkManager::remove_input_queue_from_sink(const std::string& sink_id, const
 
 void SinkManager::add_listener_to_sink(const std::string& sink_id, const std::string& listener_id, std::unique_ptr<INetworkSender> sender) {
     std::scoped_lock lock(m_manager_mutex);
-    auto sink_it = m_sinks.find(sink_id);
-    if (sink_it != m_sinks.end() && sink_it->second) {
-        sink_it->second->add_listener(listener_id, std::move(sender));
+    if (auto* mixer = find_mixer(sink_id)) {
+        mixer->add_listener(listener_id, std::move(sender));
+        // Recorded against the requested sink so it follows that sink in and out of mix groups.
+        m_sink_listeners[sink_id].insert(listener_id);
     } else {
         LOG_CPP_ERROR("[SinkManager] Sink not found for WebRTC listener: %s", sink_id.c_str());
     }
 }
 
 void SinkManager::remove_listener_from_sink(const std::string& sink_id, const std::string& listener_id) {
-    std::scoped_lock lock(m_manager_mutex);
-    auto sink_it = m_sinks.find(sink_id);
-    if (sink_it != m_sinks.end() && sink_it->second) {
-        sink_it->second->remove_listener(listener_id);
-    } else {
-        LOG_CPP_WARNING("[SinkManager] Sink not found for WebRTC listener removal: %s", sink_id.c_str());
+    std::unique_ptr<INetworkSender> detached_sender;
+    {
+        std::scoped_lock lock(m_manager_mutex);
+        auto owned_it = m_sink_listeners.find(sink_id);
+        if (owned_it != m_sink_listeners.end()) {
+            owned_it->second.erase(listener_id);
+            if (owned_it->second.empty()) {
+                m_sink_listeners.erase(owned_it);
+            }
+        }
+        auto detached_it = m_detached_listeners.find(sink_id);
+        if (detached_it != m_detached_listeners.end()) {
+            auto listener_it = detached_it->second.find(listener_id);
+            if (listener_it != detached_it->second.end()) {
+                detached_sender = std::move(listener_it->second);
+                detached_it->second.erase(listener_it);
+                if (detached_it->second.empty()) {
+                    m_detached_listeners.erase(detached_it);
+                }
+            }
+        }
+        if (!detached_sender) {
+            if (auto* mixer = find_mixer(sink_id)) {
+                mixer->remove_listener(listener_id);
+            } else {
+                LOG_CPP_WARNING("[SinkManager] Sink not found for WebRTC listener removal: %s", sink_id.c_str());
+            }
+        }
+    }
+    if (detached_sender) {
+        detached_sender->close();
     }
 }
 
 INetworkSender* SinkManager::get_listener_from_sink(const std::string& sink_id, const std::string& listener_id) {
     std::scoped_lock lock(m_manager_mutex);
-    auto sink_it = m_sinks.find(sink_id);
-    if (sink_it != m_sinks.end() && sink_it->second) {
-        return sink_it->second->get_listener(listener_id);
+    auto detached_it = m_detached_listeners.find(sink_id);
+    if (detached_it != m_detached_listeners.end()) {
+        auto listener_it = detached_it->second.find(listener_id);
+        if (listener_it != detached_it->second.end()) {
+            return listener_it->second.get();
+        }
+    }
+    if (auto* mixer = find_mixer(sink_id)) {
+        return mixer->get_listener(listener_id);
     }
     return nullptr;
 }
 
+bool SinkManager::sink_has_listeners(const std::string& sink_id) const {
+    std::scoped_lock lock(m_manager_mutex);
+    if (m_detached_listeners.count(sink_id)) {
+        return true;
+    }
+    auto owned_it = m_sink_listeners.find(sink_id);
+    if (owned_it == m_sink_listeners.end()) {
+        return false;
+    }
+    // Ownership entries outlive listeners the mixer cleaned up after they closed.
+    auto sink_it = m_sinks.find(sink_id);
+    if (sink_it == m_sinks.end() || !sink_it->second) {
+        return !owned_it->second.empty();
+    }
+    for (const auto& listener_id : owned_it->second) {
+        if (sink_it->second->get_listener(listener_id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string SinkManager::get_listener_owner(const std::string& mixer_sink_id, const std::string& listener_id) const {
+    std::scoped_lock lock(m_manager_mutex);
+    for (const auto& [member_id, leader_id] : m_group_leaders) {
+        if (leader_id != mixer_sink_id) {
+            continue;
+        }
+        auto owned_it = m_sink_listeners.find(member_id);
+        if (owned_it != m_sink_listeners.end() && owned_it->second.count(listener_id)) {
+            return member_id;
+        }
+    }
+    return mixer_sink_id;
+}
+
 std::map<std::string, SinkConfig>& SinkManager::get_sink_configs() {
     return m_sink_configs;
 }
@@ -183,6 +411,7 @@ std::vector<SinkAudioMixer*> SinkManager::get_all_mixers() {
 
 void SinkManager::stop_all() {
     std::vector<std::unique_ptr<SinkAudioMixer>> to_stop;
+    std::vector<std::unique_ptr<INetworkSender>> listeners_to_close;
     {
         std::scoped_lock lock(m_manager_mutex);
         LOG_CPP_INFO("[SinkManager] stop_all(): stopping %zu sinks", m_sinks.size());
@@ -192,6 +421,19 @@ void SinkManager::stop_all() {
         m_sinks.clear();
         m_sink_configs.clear();
         m_mp3_output_queues.clear();
+        m_group_leaders.clear();
+        m_sink_listeners.clear();
+        for (auto &[sink_id, listeners] : m_detached_listeners) {
+            (void)sink_id;
+            for (auto &[listener_id, sender] : listeners) {
+                (void)listener_id;
+                listeners_to_close.push_back(std::move(sender));
+            }
+        }
+        m_detached_listeners.clear();
+    }
+    for (auto &listener : listeners_to_close) {
+        listener->close();
     }
     for (auto &mixer : to_stop) {
         if (mixer) {
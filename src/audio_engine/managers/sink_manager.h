@@ -11,16 +11,18 @@
 #include "../configuration/audio_engine_settings.h"
 #include "../output_mixer/sink_audio_mixer.h"
 #include "../utils/thread_safe_queue.h"
+#include "../utils/mpsc_queue.h"
 #include "../audio_types.h"
 #include <string>
 #include <memory>
 #include <map>
 #include <mutex>
+#include <set>
 
 namespace screamrouter {
 namespace audio {
 class TimeshiftManager;
-using Mp3Queue = utils::ThreadSafeQueue<EncodedMP3Data>;
+using Mp3Queue = utils::MpscQueue<EncodedMP3Data>;
 
 /**
  * @class SinkManager
@@ -57,6 +59,24 @@ public:
      */
     bool remove_sink(const std::string& sink_id);
 
+    /**
+     * @brief Serves a sink from another sink's mixer instead of creating its own.
+     * @details For sinks whose inputs and output format match the leader's exactly. The
+     *          leader mixes once and also sends each chunk to the member's destination.
+     * @param leader_sink_id The ID of the running sink whose mix is shared.
+     * @param member_config The configuration of the sink joining the group.
+     * @return true if the member was attached, false otherwise.
+     */
+    bool add_sink_to_group(const std::string& leader_sink_id, const SinkConfig& member_config);
+    /**
+     * @brief Detaches a grouped sink from its leader's mixer.
+     * @param member_sink_id The ID of the grouped sink.
+     * @return true if the sink was grouped and has been detached.
+     */
+    bool remove_sink_from_group(const std::string& member_sink_id);
+    /** @brief Returns the leader serving a grouped sink, or an empty string if not grouped. */
+    std::string get_group_leader(const std::string& sink_id) const;
+
     /**
      * @brief Subscribes a sink to a source's output queue.
      * @param sink_id The ID of the sink.
@@ -67,6 +87,15 @@ public:
                                  const std::string& source_instance_id,
                                  std::shared_ptr<ReadyPacketRing> ready_ring,
                                  SourceInputProcessor* sip);
+    /**
+     * @brief Subscribes a sink to processed chunks from a source processor another sink drives.
+     * @param sink_id The ID of the sink.
+     * @param source_instance_id The ID of the deduplicated source instance.
+     * @param chunk_ring The ring the processor fans its chunks out into.
+     */
+    void add_dedup_input_to_sink(const std::string& sink_id,
+                                 const std::string& source_instance_id,
+                                 std::shared_ptr<ProcessedChunkRing> chunk_ring);
     /**
      * @brief Unsubscribes a sink from a source's output queue.
      * @param sink_id The ID of the sink.
@@ -93,6 +122,16 @@ public:
      * @return A pointer to the network sender, or nullptr if not found.
      */
     INetworkSender* get_listener_from_sink(const std::string& sink_id, const std::string& listener_id);
+    /** @brief Returns true if listeners are attached to the sink itself (not to sinks grouped with it). */
+    bool sink_has_listeners(const std::string& sink_id) const;
+    /**
+     * @brief Returns the sink a listener was added to.
+     * @details A leader's mixer also carries the listeners of its grouped sinks.
+     * @param mixer_sink_id The ID of the sink whose mixer carries the listener.
+     * @param listener_id The listener ID.
+     * @return The owning sink ID, or mixer_sink_id if no grouped sink owns the listener.
+     */
+    std::string get_listener_owner(const std::string& mixer_sink_id, const std::string& listener_id) const;
 
     /** @brief Gets a reference to the map of sink configurations. */
     std::map<std::string, SinkConfig>& get_sink_configs();
@@ -122,6 +161,19 @@ private:
     std::map<std::string, std::unique_ptr<SinkAudioMixer>> m_sinks;
     std::map<std::string, SinkConfig> m_sink_configs;
     std::map<std::string, std::shared_ptr<Mp3Queue>> m_mp3_output_queues;
+    /** @brief Grouped sink ID -> ID of the sink whose mixer serves it. */
+    std::map<std::string, std::string> m_group_leaders;
+    /** @brief Sink ID -> IDs of the listeners added to it, wherever its mix is produced. */
+    std::map<std::string, std::set<std::string>> m_sink_listeners;
+    /** @brief Listeners of a grouped sink between leaving its leader's mixer and getting its own. */
+    std::map<std::string, std::map<std::string, std::unique_ptr<INetworkSender>>> m_detached_listeners;
+
+    /** @brief Finds the mixer serving a sink, following group membership. Caller holds the lock. */
+    SinkAudioMixer* find_mixer(const std::string& sink_id);
+    /** @brief Moves a grouped sink's listeners off the mixer serving it. Caller holds the lock. */
+    void detach_listeners(const std::string& sink_id, SinkAudioMixer* mixer);
+    /** @brief Drops all listener state for a sink, returning detached senders to close. Caller holds the lock. */
+    std::vector<std::unique_ptr<INetworkSender>> release_listeners(const std::string& sink_id);
 };
 
 } // namespace audio
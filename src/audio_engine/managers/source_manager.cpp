@@ -70,6 +70,7 @@ std::string SourceManager::configure_source(const SourceConfig& config, bool run
         proc_config.initial_eq = validated_config.initial_eq;
         proc_config.initial_delay_ms = validated_config.initial_delay_ms;
         proc_config.initial_timeshift_sec = validated_config.initial_timeshift_sec;
+        proc_config.resampler_quality = validated_config.resampler_quality;
 
         new_source = std::make_unique<SourceInputProcessor>(proc_config, m_settings);
     } catch (const std::exception& e) {
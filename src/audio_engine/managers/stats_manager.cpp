@@ -2,6 +2,7 @@
 #include "../utils/cpp_logger.h"
 #include "../senders/webrtc/webrtc_sender.h"
 #include <algorithm>
+#include <map>
 
 namespace screamrouter {
 namespace audio {
@@ -257,6 +258,24 @@ void StatsManager::collect_stats() {
             }
             m_last_source_chunks_pushed[s_stats.instance_id] = chunks_now;
 
+            s_stats.resampler_quality = raw_stats.resampler_quality;
+            s_stats.resampler_cpu_ms = static_cast<double>(raw_stats.resampler_cpu_ns) / 1'000'000.0;
+            auto last_resampler_it = m_last_source_resampler_ns.find(s_stats.instance_id);
+            if (last_resampler_it != m_last_source_resampler_ns.end() && raw_stats.resampler_cpu_ns >= last_resampler_it->second) {
+                const double delta_seconds = static_cast<double>(raw_stats.resampler_cpu_ns - last_resampler_it->second) / 1e9;
+                s_stats.resampler_cpu_percent = (delta_seconds / elapsed_seconds) * 100.0;
+            }
+            m_last_source_resampler_ns[s_stats.instance_id] = raw_stats.resampler_cpu_ns;
+
+            s_stats.silent_chunks_gated = raw_stats.silent_chunks_gated;
+            s_stats.silence_cpu_saved_ms = static_cast<double>(raw_stats.silence_saved_ns) / 1'000'000.0;
+            auto last_silence_it = m_last_source_silence_saved_ns.find(s_stats.instance_id);
+            if (last_silence_it != m_last_source_silence_saved_ns.end() && raw_stats.silence_saved_ns >= last_silence_it->second) {
+                const double delta_seconds = static_cast<double>(raw_stats.silence_saved_ns - last_silence_it->second) / 1e9;
+                s_stats.silence_cpu_saved_percent = (delta_seconds / elapsed_seconds) * 100.0;
+            }
+            m_last_source_silence_saved_ns[s_stats.instance_id] = raw_stats.silence_saved_ns;
+
             s_stats.input_buffer.pop_rate_per_second = s_stats.packets_processed_per_second;
 
             if (have_tm_stats) {
@@ -319,6 +338,16 @@ void StatsManager::collect_stats() {
                 s_stats.packets_mixed_per_second = (mixed_now - m_last_sink_chunks_mixed[s_stats.sink_id]) / elapsed_seconds;
             }
             m_last_sink_chunks_mixed[s_stats.sink_id] = mixed_now;
+
+            s_stats.resampler_quality = raw_stats.resampler_quality;
+            s_stats.resampler_cpu_ms = static_cast<double>(raw_stats.resampler_cpu_ns) / 1'000'000.0;
+            auto last_resampler_it = m_last_sink_resampler_ns.find(s_stats.sink_id);
+            if (last_resampler_it != m_last_sink_resampler_ns.end() && raw_stats.resampler_cpu_ns >= last_resampler_it->second) {
+                const double delta_seconds = static_cast<double>(raw_stats.resampler_cpu_ns - last_resampler_it->second) / 1e9;
+                s_stats.resampler_cpu_percent = (delta_seconds / elapsed_seconds) * 100.0;
+            }
+            m_last_sink_resampler_ns[s_stats.sink_id] = raw_stats.resampler_cpu_ns;
+            s_stats.silent_inputs_skipped = raw_stats.silent_inputs_skipped;
             s_stats.payload_buffer.pop_rate_per_second = s_stats.packets_mixed_per_second;
             s_stats.payload_buffer.push_rate_per_second = s_stats.packets_mixed_per_second;
 
@@ -338,6 +367,8 @@ void StatsManager::collect_stats() {
                 s_stats.inputs.push_back(std::move(lane));
             }
 
+            // The mixer also carries listeners added to sinks grouped with it; report each under its own sink.
+            std::map<std::string, std::vector<WebRtcListenerStats>> member_listeners;
             for (const auto& listener_id : raw_stats.listener_ids) {
                 INetworkSender* sender = sink->get_listener(listener_id);
                 if (sender) {
@@ -354,11 +385,25 @@ void StatsManager::collect_stats() {
                         }
                         m_last_webrtc_packets_sent[listener_id] = sent_now;
                         
-                        s_stats.webrtc_listeners.push_back(l_stats);
+                        const std::string owner_id = m_sink_manager->get_listener_owner(s_stats.sink_id, listener_id);
+                        if (owner_id == s_stats.sink_id) {
+                            s_stats.webrtc_listeners.push_back(l_stats);
+                        } else {
+                            member_listeners[owner_id].push_back(l_stats);
+                        }
                     }
                 }
             }
             new_stats.sink_stats.push_back(s_stats);
+
+            // Grouped sinks share this mixer; report them with the leader's mix stats.
+            for (const auto& member_id : raw_stats.mirror_sink_ids) {
+                SinkStats member_stats = s_stats;
+                member_stats.sink_id = member_id;
+                member_stats.mix_group_leader = s_stats.sink_id;
+                member_stats.webrtc_listeners = std::move(member_listeners[member_id]);
+                new_stats.sink_stats.push_back(std::move(member_stats));
+            }
         }
     }
 
@@ -50,6 +50,9 @@ private:
     std::map<std::string, uint64_t> m_last_processor_dispatched;
     std::map<std::string, uint64_t> m_last_processor_dropped;
     std::map<std::string, uint64_t> m_last_sink_chunks_mixed;
+    std::map<std::string, uint64_t> m_last_source_resampler_ns;
+    std::map<std::string, uint64_t> m_last_source_silence_saved_ns;
+    std::map<std::string, uint64_t> m_last_sink_resampler_ns;
     std::map<std::string, uint64_t> m_last_ready_chunks_popped;
     std::map<std::string, uint64_t> m_last_ready_chunks_received;
     std::map<std::string, uint64_t> m_last_webrtc_packets_sent;
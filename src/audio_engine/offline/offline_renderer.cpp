@@ -0,0 +1,473 @@
+#include "offline_renderer.h"
+
+#include "../audio_constants.h"
+#include "../audio_types.h"
+#include "../input_processor/source_input_processor.h"
+#include "../input_processor/timeshift_manager.h"
+#include "../output_mixer/sink_audio_mixer.h"
+#include "../senders/i_network_sender.h"
+#include "../utils/audio_clock.h"
+#include "../utils/cpp_logger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+
+namespace screamrouter {
+namespace audio {
+namespace offline {
+
+namespace {
+
+constexpr uint64_t kFnvOffsetBasis = 1469598103934665603ull;
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+constexpr std::size_t kLaneRingCapacity = 1024;
+constexpr int kTimeshiftBufferSec = 30;
+
+bool is_supported_format(int sample_rate, int channels, int bit_depth) {
+    return sample_rate > 0 && channels >= 1 && channels <= MAX_CHANNELS &&
+           (bit_depth == 16 || bit_depth == 24 || bit_depth == 32);
+}
+
+uint16_t read_le16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+uint32_t read_le32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+void write_le16(uint8_t* p, uint16_t v) { p[0] = v & 0xFF; p[1] = (v >> 8) & 0xFF; }
+void write_le32(uint8_t* p, uint32_t v) {
+    p[0] = v & 0xFF; p[1] = (v >> 8) & 0xFF; p[2] = (v >> 16) & 0xFF; p[3] = (v >> 24) & 0xFF;
+}
+
+/**
+ * @brief Loads @p path as PCM. WAV headers set the format; anything else is read as raw
+ *        little-endian PCM in the format already in @p source.
+ */
+std::vector<uint8_t> load_pcm_file(OfflineSourceConfig& source) {
+    std::ifstream in(source.input_file, std::ios::binary);
+    if (!in) {
+        throw std::invalid_argument("cannot open input file '" + source.input_file + "'");
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (bytes.size() < 12 || std::memcmp(bytes.data(), "RIFF", 4) != 0 || std::memcmp(bytes.data() + 8, "WAVE", 4) != 0) {
+        return bytes;
+    }
+
+    size_t pos = 12;
+    bool have_format = false;
+    while (pos + 8 <= bytes.size()) {
+        const uint8_t* chunk = bytes.data() + pos;
+        const uint32_t chunk_size = read_le32(chunk + 4);
+        const size_t body = pos + 8;
+        const size_t available = std::min<size_t>(chunk_size, bytes.size() - body);
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && available >= 16) {
+            const uint16_t format_tag = read_le16(chunk + 8);
+            if (format_tag != 1 && format_tag != 0xFFFE) {
+                throw std::invalid_argument("'" + source.input_file + "' is not integer PCM");
+            }
+            source.channels = read_le16(chunk + 10);
+            source.sample_rate = static_cast<int>(read_le32(chunk + 12));
+            source.bit_depth = read_le16(chunk + 22);
+            have_format = true;
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            if (!have_format) {
+                throw std::invalid_argument("'" + source.input_file + "' has no fmt chunk before its data");
+            }
+            return std::vector<uint8_t>(bytes.begin() + body, bytes.begin() + body + available);
+        }
+        pos = body + chunk_size + (chunk_size & 1);
+    }
+    throw std::invalid_argument("'" + source.input_file + "' has no data chunk");
+}
+
+/** @brief Writes a canonical 44-byte PCM WAV header; sizes are patched in finish_wav(). */
+void write_wav_header(FILE* fp, int sample_rate, int channels, int bit_depth, uint32_t data_bytes) {
+    uint8_t header[44];
+    const uint32_t block_align = static_cast<uint32_t>(channels * bit_depth / 8);
+    std::memcpy(header, "RIFF", 4);
+    write_le32(header + 4, 36 + data_bytes);
+    std::memcpy(header + 8, "WAVEfmt ", 8);
+    write_le32(header + 16, 16);
+    write_le16(header + 20, 1);
+    write_le16(header + 22, static_cast<uint16_t>(channels));
+    write_le32(header + 24, static_cast<uint32_t>(sample_rate));
+    write_le32(header + 28, static_cast<uint32_t>(sample_rate) * block_align);
+    write_le16(header + 32, static_cast<uint16_t>(block_align));
+    write_le16(header + 34, static_cast<uint16_t>(bit_depth));
+    std::memcpy(header + 36, "data", 4);
+    write_le32(header + 40, data_bytes);
+    std::fwrite(header, 1, sizeof(header), fp);
+}
+
+/** @brief xorshift64*: small, fast and identical on every platform. */
+uint64_t next_random(uint64_t& state) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 2685821657736338717ull;
+}
+
+double random_unit(uint64_t& state) {
+    return static_cast<double>(next_random(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+std::chrono::steady_clock::duration seconds_to_duration(double seconds) {
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+/** @brief Primary sender of a driven mixer: hands every output chunk to the renderer. */
+class CaptureSender : public INetworkSender {
+public:
+    using Consumer = std::function<void(const uint8_t*, size_t)>;
+
+    explicit CaptureSender(Consumer consumer) : consumer_(std::move(consumer)) {}
+
+    bool setup() override { return true; }
+    void close() override {}
+    void send_payload(const uint8_t* payload_data, size_t payload_size, const std::vector<uint32_t>&) override {
+        consumer_(payload_data, payload_size);
+    }
+
+private:
+    Consumer consumer_;
+};
+
+} // namespace
+
+struct OfflineRenderer::SourceState {
+    OfflineSourceConfig config;
+    std::vector<uint8_t> file_pcm;
+    size_t file_pos = 0;
+    size_t frames_per_packet = 0;
+    size_t bytes_per_frame = 0;
+    double packet_period_sec = 0.0;
+    uint64_t packets_sent = 0;
+    uint32_t rtp_timestamp = 0;
+    double phase = 0.0;
+    uint64_t noise_state = 0;
+    uint64_t jitter_state = 0;
+    std::chrono::steady_clock::time_point start_time{};
+    std::chrono::steady_clock::time_point next_arrival{};
+
+    void schedule_next() {
+        const double nominal = config.start_sec + static_cast<double>(packets_sent) * packet_period_sec /
+                                                      (1.0 + config.clock_drift_ppm * 1e-6);
+        const double jitter = config.jitter_ms > 0.0 ? random_unit(jitter_state) * config.jitter_ms / 1000.0 : 0.0;
+        // Arrivals never go backwards: a jittered packet holds back the ones behind it.
+        next_arrival = std::max(next_arrival, start_time + seconds_to_duration(nominal + jitter));
+    }
+
+    void write_sample(uint8_t* out, double value) const {
+        value = std::clamp(value, -1.0, 1.0);
+        switch (config.bit_depth) {
+            case 16: {
+                const auto s = static_cast<int16_t>(std::lrint(value * 32767.0));
+                write_le16(out, static_cast<uint16_t>(s));
+                break;
+            }
+            case 24: {
+                const auto s = static_cast<int32_t>(std::lrint(value * 8388607.0));
+                out[0] = s & 0xFF;
+                out[1] = (s >> 8) & 0xFF;
+                out[2] = (s >> 16) & 0xFF;
+                break;
+            }
+            default: {
+                const auto s = static_cast<int32_t>(std::llrint(value * 2147483647.0));
+                write_le32(out, static_cast<uint32_t>(s));
+                break;
+            }
+        }
+    }
+
+    TaggedAudioPacket make_packet() {
+        TaggedAudioPacket packet;
+        packet.source_tag = config.tag;
+        packet.received_time = next_arrival;
+        packet.rtp_timestamp = rtp_timestamp;
+        packet.rtp_sequence_number = static_cast<uint16_t>(packets_sent & 0xFFFF);
+        packet.channels = config.channels;
+        packet.sample_rate = config.sample_rate;
+        packet.bit_depth = config.bit_depth;
+        packet.chlayout1 = config.channels == 1 ? 0x04 : 0x03;
+        packet.chlayout2 = 0x00;
+        packet.audio_data.resize(frames_per_packet * bytes_per_frame, 0);
+
+        if (!file_pcm.empty()) {
+            size_t written = 0;
+            while (written < packet.audio_data.size()) {
+                if (file_pos >= file_pcm.size()) {
+                    if (!config.loop_input) {
+                        break;
+                    }
+                    file_pos = 0;
+                }
+                const size_t n = std::min(packet.audio_data.size() - written, file_pcm.size() - file_pos);
+                std::memcpy(packet.audio_data.data() + written, file_pcm.data() + file_pos, n);
+                written += n;
+                file_pos += n;
+            }
+        } else if (config.generator != GeneratorType::SILENCE) {
+            const size_t bytes_per_sample = static_cast<size_t>(config.bit_depth / 8);
+            const double step = 2.0 * M_PI * config.frequency_hz / config.sample_rate;
+            for (size_t frame = 0; frame < frames_per_packet; ++frame) {
+                for (int ch = 0; ch < config.channels; ++ch) {
+                    double value;
+                    if (config.generator == GeneratorType::NOISE) {
+                        value = (random_unit(noise_state) * 2.0 - 1.0) * config.amplitude;
+                    } else {
+                        value = std::sin(phase + ch * (M_PI / 4.0)) * config.amplitude;
+                    }
+                    write_sample(packet.audio_data.data() + (frame * config.channels + ch) * bytes_per_sample, value);
+                }
+                phase += step;
+            }
+            phase = std::fmod(phase, 2.0 * M_PI);
+        }
+
+        ++packets_sent;
+        rtp_timestamp += static_cast<uint32_t>(frames_per_packet);
+        schedule_next();
+        return packet;
+    }
+};
+
+struct OfflineRenderer::LaneState {
+    std::string instance_id;
+    SourceState* source = nullptr;
+    int delay_ms = 0;
+    std::shared_ptr<PacketRing> ring;
+    std::unique_ptr<SourceInputProcessor> processor;
+};
+
+struct OfflineRenderer::SinkState {
+    OfflineSinkConfig config;
+    std::vector<std::unique_ptr<LaneState>> lanes;
+    // Declared after the lanes so it is destroyed before the processors it points at.
+    std::unique_ptr<SinkAudioMixer> mixer;
+    size_t frame_bytes = 0;
+    FILE* wav = nullptr;
+    uint64_t wav_data_bytes = 0;
+    OfflineSinkResult result;
+
+    /** @brief Receives the mixer's converted output, one chunk at a time. */
+    void capture(const uint8_t* data, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            result.checksum = (result.checksum ^ data[i]) * kFnvPrime;
+        }
+        if (wav) {
+            std::fwrite(data, 1, size, wav);
+            wav_data_bytes += size;
+        }
+        result.frames_rendered += size / frame_bytes;
+    }
+
+    void finish_wav() {
+        if (!wav) {
+            return;
+        }
+        std::fseek(wav, 0, SEEK_SET);
+        write_wav_header(wav, config.sample_rate, config.channels, config.bit_depth,
+                         static_cast<uint32_t>(std::min<uint64_t>(wav_data_bytes, 0xFFFFFFFFull - 36)));
+        std::fclose(wav);
+        wav = nullptr;
+    }
+};
+
+OfflineRenderer::OfflineRenderer(OfflineRenderConfig config) : config_(std::move(config)) {
+    if (!config_.settings) {
+        config_.settings = std::make_shared<AudioEngineSettings>();
+    }
+    if (config_.duration_sec <= 0.0 || config_.tick.count() <= 0) {
+        throw std::invalid_argument("offline render needs a positive duration and tick");
+    }
+    const size_t base_frames = resolve_base_frames_per_chunk(config_.settings);
+
+    std::map<std::string, SourceState*> sources_by_tag;
+    for (const auto& source_config : config_.sources) {
+        auto state = std::make_unique<SourceState>();
+        state->config = source_config;
+        if (!state->config.input_file.empty()) {
+            state->file_pcm = load_pcm_file(state->config);
+        }
+        const auto& c = state->config;
+        if (c.tag.empty() || sources_by_tag.count(c.tag)) {
+            throw std::invalid_argument("source tags must be unique and non-empty ('" + c.tag + "')");
+        }
+        if (!is_supported_format(c.sample_rate, c.channels, c.bit_depth)) {
+            throw std::invalid_argument("unsupported format for source '" + c.tag + "'");
+        }
+        state->frames_per_packet = base_frames;
+        state->bytes_per_frame = static_cast<size_t>(c.channels * (c.bit_depth / 8));
+        state->packet_period_sec = static_cast<double>(base_frames) / c.sample_rate;
+        state->noise_state = 0x9E3779B97F4A7C15ull ^ c.seed;
+        state->jitter_state = 0xD1B54A32D192ED03ull ^ (static_cast<uint64_t>(c.seed) << 1);
+        if (state->noise_state == 0) state->noise_state = 1;
+        if (state->jitter_state == 0) state->jitter_state = 1;
+        sources_by_tag[c.tag] = state.get();
+        sources_.push_back(std::move(state));
+    }
+
+    std::map<std::string, SinkState*> sinks_by_id;
+    for (const auto& sink_config : config_.sinks) {
+        if (sink_config.id.empty() || sinks_by_id.count(sink_config.id)) {
+            throw std::invalid_argument("sink ids must be unique and non-empty ('" + sink_config.id + "')");
+        }
+        if (!is_supported_format(sink_config.sample_rate, sink_config.channels, sink_config.bit_depth)) {
+            throw std::invalid_argument("unsupported format for sink '" + sink_config.id + "'");
+        }
+        auto state = std::make_unique<SinkState>();
+        state->config = sink_config;
+        state->frame_bytes = static_cast<size_t>(sink_config.channels * (sink_config.bit_depth / 8));
+        state->result.sink_id = sink_config.id;
+        state->result.checksum = kFnvOffsetBasis;
+        sinks_by_id[sink_config.id] = state.get();
+        sinks_.push_back(std::move(state));
+    }
+
+    for (const auto& connection : config_.connections) {
+        auto source_it = sources_by_tag.find(connection.source_tag);
+        auto sink_it = sinks_by_id.find(connection.sink_id);
+        if (source_it == sources_by_tag.end() || sink_it == sinks_by_id.end()) {
+            throw std::invalid_argument("connection " + connection.source_tag + " -> " + connection.sink_id +
+                                        " refers to an unknown source or sink");
+        }
+        if (!connection.eq.empty() && connection.eq.size() != EQ_BANDS) {
+            throw std::invalid_argument("connection EQ must have EQ_BANDS values");
+        }
+        SinkState& sink = *sink_it->second;
+        auto lane = std::make_unique<LaneState>();
+        lane->instance_id = "offline:" + connection.source_tag + "->" + connection.sink_id + "#" +
+                            std::to_string(sink.lanes.size());
+        lane->source = source_it->second;
+        lane->delay_ms = connection.delay_ms;
+        lane->ring = std::make_shared<PacketRing>(kLaneRingCapacity);
+
+        SourceProcessorConfig processor_config;
+        processor_config.instance_id = lane->instance_id;
+        processor_config.source_tag = connection.source_tag;
+        processor_config.output_channels = sink.config.channels;
+        processor_config.output_samplerate = sink.config.sample_rate;
+        processor_config.initial_volume = connection.volume;
+        if (!connection.eq.empty()) {
+            processor_config.initial_eq = connection.eq;
+        }
+        processor_config.initial_delay_ms = connection.delay_ms;
+        lane->processor = std::make_unique<SourceInputProcessor>(processor_config, config_.settings);
+        sink.lanes.push_back(std::move(lane));
+    }
+}
+
+OfflineRenderer::~OfflineRenderer() {
+    for (auto& sink : sinks_) {
+        sink->finish_wav();
+    }
+}
+
+OfflineRenderResult OfflineRenderer::render() {
+    OfflineRenderResult result;
+    if (rendered_) {
+        LOG_CPP_WARNING("[OfflineRenderer] render() called twice; the graph has already been rendered.");
+        return result;
+    }
+    rendered_ = true;
+
+    utils::VirtualClock clock;
+    utils::ScopedVirtualClock clock_scope(clock);
+    const auto start = clock.now();
+    const auto end = start + seconds_to_duration(config_.duration_sec);
+
+    // Created under the virtual clock so its internal timestamps share the timeline.
+    TimeshiftManager timeshift(std::chrono::seconds(kTimeshiftBufferSec), config_.settings);
+
+    for (auto& source : sources_) {
+        source->start_time = start;
+        source->next_arrival = start;
+        source->schedule_next();
+    }
+    for (auto& sink : sinks_) {
+        if (!sink->config.output_wav.empty()) {
+            sink->wav = std::fopen(sink->config.output_wav.c_str(), "wb");
+            if (!sink->wav) {
+                LOG_CPP_ERROR("[OfflineRenderer] Cannot open '%s' for writing; rendering without it.",
+                              sink->config.output_wav.c_str());
+            } else {
+                write_wav_header(sink->wav, sink->config.sample_rate, sink->config.channels,
+                                 sink->config.bit_depth, 0);
+            }
+        }
+
+        // Built under the virtual clock: the mixer's ClockManager then leaves ticking to
+        // run_due_ticks() and its rate controller measures intervals in media time.
+        SinkMixerConfig mixer_config;
+        mixer_config.sink_id = sink->config.id;
+        mixer_config.output_port = 0;
+        mixer_config.output_samplerate = sink->config.sample_rate;
+        mixer_config.output_channels = sink->config.channels;
+        mixer_config.output_bitdepth = sink->config.bit_depth;
+        mixer_config.output_chlayout1 = sink->config.channels == 1 ? 0x04 : 0x03;
+        mixer_config.output_chlayout2 = 0x00;
+        mixer_config.protocol = "web_receiver";
+        sink->mixer = std::make_unique<SinkAudioMixer>(mixer_config, nullptr, config_.settings);
+        SinkState* sink_state = sink.get();
+        sink->mixer->set_output_sender(std::make_unique<CaptureSender>(
+            [sink_state](const uint8_t* data, size_t size) { sink_state->capture(data, size); }));
+
+        for (auto& lane : sink->lanes) {
+            lane->processor->start();
+            timeshift.register_processor(lane->instance_id, lane->source->config.tag, lane->delay_ms, 0.0f);
+            timeshift.attach_sink_ring(lane->instance_id, lane->source->config.tag, sink->config.id, lane->ring);
+            sink->mixer->add_input_queue(lane->instance_id, lane->ring, lane->processor.get());
+        }
+        if (!sink->mixer->start_driven()) {
+            throw std::runtime_error("failed to start the mixer for sink '" + sink->config.id + "'");
+        }
+    }
+
+    const auto wall_start = std::chrono::steady_clock::now();
+    for (auto now = start; now <= end; now += config_.tick) {
+        clock.advance_to(now);
+
+        for (auto& source : sources_) {
+            while (source->next_arrival <= now) {
+                timeshift.add_packet(source->make_packet());
+            }
+        }
+        timeshift.run_once();
+
+        for (auto& sink : sinks_) {
+            sink->mixer->run_due_ticks();
+        }
+    }
+    const double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+
+    for (auto& sink : sinks_) {
+        sink->result.input_underruns = sink->mixer->get_stats().buffer_underruns;
+        sink->mixer->stop();
+        sink->mixer.reset();
+        for (auto& lane : sink->lanes) {
+            timeshift.detach_sink_ring(lane->instance_id, lane->source->config.tag, sink->config.id);
+            timeshift.unregister_processor(lane->instance_id, lane->source->config.tag);
+            lane->processor->stop();
+        }
+        sink->finish_wav();
+        result.sinks.push_back(sink->result);
+    }
+
+    result.media_seconds = config_.duration_sec;
+    result.wall_seconds = wall_seconds;
+    result.speed_factor = wall_seconds > 0.0 ? config_.duration_sec / wall_seconds : 0.0;
+    LOG_CPP_INFO("[OfflineRenderer] Rendered %.1fs of media for %zu sink(s) in %.3fs (%.1fx real time).",
+                 result.media_seconds, result.sinks.size(), result.wall_seconds, result.speed_factor);
+    return result;
+}
+
+} // namespace offline
+} // namespace audio
+} // namespace screamrouter
@@ -0,0 +1,165 @@
+/**
+ * @file offline_renderer.h
+ * @brief Renders an audio graph faster than real time under a virtual clock.
+ * @details OfflineRenderer wires the same TimeshiftManager, SourceInputProcessor and
+ *          SinkAudioMixer instances the engine uses, but drives them from the calling
+ *          thread: a VirtualClock is advanced in fixed ticks, sources generate packets with
+ *          their simulated arrival times, the timeshift manager dispatches whatever is due
+ *          and each mixer runs the cycles its ClockManager has due (see
+ *          SinkAudioMixer::start_driven()). No sockets, sleeps or worker threads are
+ *          involved, so a render is bit-exact for a given configuration and build.
+ *
+ *          Each mixer's output goes to an optional WAV file and a 64-bit FNV-1a checksum in
+ *          place of a network sender. Mixing, rate control and output conversion are the
+ *          mixer's own; MP3 encoding and listeners are not part of the render.
+ */
+#ifndef SCREAMROUTER_AUDIO_OFFLINE_RENDERER_H
+#define SCREAMROUTER_AUDIO_OFFLINE_RENDERER_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../configuration/audio_engine_settings.h"
+
+namespace screamrouter {
+namespace audio {
+namespace offline {
+
+/** @brief Signal produced by a generated source. */
+enum class GeneratorType {
+    SINE,     ///< Sine at frequency_hz, phase-shifted per channel.
+    NOISE,    ///< Seeded white noise.
+    SILENCE,  ///< Digital silence.
+};
+
+/**
+ * @struct OfflineSourceConfig
+ * @brief One simulated input stream.
+ */
+struct OfflineSourceConfig {
+    /** @brief Source tag, as a receiver would report it. */
+    std::string tag;
+    /** @brief Format of the packets; overridden by the header when input_file is a WAV file. */
+    int sample_rate = 48000;
+    int channels = 2;
+    int bit_depth = 16;
+    /** @brief Signal used when input_file is empty. */
+    GeneratorType generator = GeneratorType::SINE;
+    double frequency_hz = 440.0;
+    /** @brief Peak level, 0.0 to 1.0. */
+    double amplitude = 0.5;
+    /** @brief Seed for noise and arrival jitter. */
+    uint32_t seed = 1;
+    /** @brief Optional WAV (PCM) or raw little-endian interleaved PCM file to play instead of the generator. */
+    std::string input_file;
+    /** @brief Restart input_file at its end; otherwise the source goes quiet. */
+    bool loop_input = true;
+    /** @brief Sender clock error: positive values make packets arrive faster than nominal. */
+    double clock_drift_ppm = 0.0;
+    /** @brief Maximum extra arrival delay per packet, uniformly distributed from the seed. */
+    double jitter_ms = 0.0;
+    /** @brief Media time at which the source starts sending. */
+    double start_sec = 0.0;
+};
+
+/**
+ * @struct OfflineSinkConfig
+ * @brief One simulated output.
+ */
+struct OfflineSinkConfig {
+    std::string id;
+    int sample_rate = 48000;
+    int channels = 2;
+    int bit_depth = 16;
+    /** @brief Optional WAV file receiving the rendered output. */
+    std::string output_wav;
+};
+
+/**
+ * @struct OfflineConnection
+ * @brief Routes a source to a sink through its own SourceInputProcessor.
+ */
+struct OfflineConnection {
+    std::string source_tag;
+    std::string sink_id;
+    float volume = 1.0f;
+    /** @brief EQ_BANDS gains; empty for flat. */
+    std::vector<float> eq;
+    int delay_ms = 0;
+};
+
+/**
+ * @struct OfflineRenderConfig
+ * @brief A complete graph and how long to render it.
+ */
+struct OfflineRenderConfig {
+    std::vector<OfflineSourceConfig> sources;
+    std::vector<OfflineSinkConfig> sinks;
+    std::vector<OfflineConnection> connections;
+    /** @brief Media time to render. */
+    double duration_sec = 10.0;
+    /** @brief Virtual clock step; timeshift dispatch runs once per tick. */
+    std::chrono::microseconds tick{1000};
+    /** @brief Engine tuning; defaults are used when null. */
+    std::shared_ptr<AudioEngineSettings> settings;
+};
+
+/** @brief Per-sink outcome of a render. */
+struct OfflineSinkResult {
+    std::string sink_id;
+    uint64_t frames_rendered = 0;
+    /** @brief Times a connected input ran dry after it had started (the mixer's buffer_underruns). */
+    uint64_t input_underruns = 0;
+    /** @brief FNV-1a 64 over every output byte; equal checksums mean bit-identical output. */
+    uint64_t checksum = 0;
+};
+
+/** @brief Outcome of a render. */
+struct OfflineRenderResult {
+    std::vector<OfflineSinkResult> sinks;
+    double media_seconds = 0.0;
+    double wall_seconds = 0.0;
+    /** @brief media_seconds / wall_seconds. */
+    double speed_factor = 0.0;
+};
+
+/**
+ * @class OfflineRenderer
+ * @brief Builds the graph from an OfflineRenderConfig and renders it on the calling thread.
+ * @details Installs a VirtualClock as the process-wide AudioClock for the duration of
+ *          render(), so no live engine should run in the same process at the same time.
+ */
+class OfflineRenderer {
+public:
+    /**
+     * @brief Validates @p config and opens input files.
+     * @throws std::invalid_argument for unknown tags, bad formats or unreadable files.
+     */
+    explicit OfflineRenderer(OfflineRenderConfig config);
+    ~OfflineRenderer();
+
+    OfflineRenderer(const OfflineRenderer&) = delete;
+    OfflineRenderer& operator=(const OfflineRenderer&) = delete;
+
+    /** @brief Renders config.duration_sec of media time. Can be called once. */
+    OfflineRenderResult render();
+
+private:
+    struct SourceState;
+    struct LaneState;
+    struct SinkState;
+
+    OfflineRenderConfig config_;
+    std::vector<std::unique_ptr<SourceState>> sources_;
+    std::vector<std::unique_ptr<SinkState>> sinks_;
+    bool rendered_ = false;
+};
+
+} // namespace offline
+} // namespace audio
+} // namespace screamrouter
+
+#endif // SCREAMROUTER_AUDIO_OFFLINE_RENDERER_H
@@ -95,6 +95,34 @@ INetworkSender* ListenerDispatcher::get_listener(const std::string& listener_id)
     return nullptr;
 }
 
+std::unique_ptr<INetworkSender> ListenerDispatcher::take_listener(const std::string& listener_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = listeners_.find(listener_id);
+    if (it == listeners_.end()) {
+        return nullptr;
+    }
+    std::unique_ptr<INetworkSender> sender = std::move(it->second);
+    listeners_.erase(it);
+    LOG_CPP_INFO("[ListenerDispatcher:%s] Detached listener: %s", sink_id_.c_str(), listener_id.c_str());
+    return sender;
+}
+
+void ListenerDispatcher::adopt_listener(const std::string& listener_id, std::unique_ptr<INetworkSender> sender) {
+    if (!sender) {
+        return;
+    }
+    // The previous dispatcher's cleanup callback captured that dispatcher; point it here.
+    if (WebRtcSender* webrtc_sender = dynamic_cast<WebRtcSender*>(sender.get())) {
+        webrtc_sender->set_cleanup_callback(listener_id, [this](const std::string& id) {
+            LOG_CPP_INFO("[ListenerDispatcher:%s] Cleanup callback triggered for listener: %s",
+                         sink_id_.c_str(), id.c_str());
+        });
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    listeners_[listener_id] = std::move(sender);
+    LOG_CPP_INFO("[ListenerDispatcher:%s] Adopted listener: %s", sink_id_.c_str(), listener_id.c_str());
+}
+
 void ListenerDispatcher::dispatch_to_listeners(const ListenerAudioBuffer& stereo_buffer,
                                                const ListenerAudioBuffer& multichannel_buffer) {
     PROFILE_FUNCTION();
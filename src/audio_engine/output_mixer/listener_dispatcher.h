@@ -65,6 +65,20 @@ public:
      */
     INetworkSender* get_listener(const std::string& listener_id);
     
+    /**
+     * @brief Detaches a listener without closing it so it can move to another dispatcher.
+     * @param listener_id The ID of the listener to detach.
+     * @return The listener's sender, or nullptr if not found.
+     */
+    std::unique_ptr<INetworkSender> take_listener(const std::string& listener_id);
+    
+    /**
+     * @brief Attaches a listener that was already set up by another dispatcher.
+     * @param listener_id The listener ID.
+     * @param sender The sender returned by take_listener().
+     */
+    void adopt_listener(const std::string& listener_id, std::unique_ptr<INetworkSender> sender);
+    
     /**
      * @brief Dispatches audio payload to all active listeners.
      * @param stereo_buffer Preprocessed stereo buffer metadata.
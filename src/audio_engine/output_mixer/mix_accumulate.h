@@ -0,0 +1,32 @@
+/**
+ * @file mix_accumulate.h
+ * @brief Saturating accumulation used by SinkAudioMixer::mix_buffers.
+ * @details Split out so the mix inner loop can be benchmarked without a full mixer.
+ */
+#ifndef MIX_ACCUMULATE_H
+#define MIX_ACCUMULATE_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace screamrouter {
+namespace audio {
+
+/** @brief Adds @p src into @p dest sample by sample, clamping to the int32 range. */
+inline void mix_accumulate_saturating(int32_t* dest, const int32_t* src, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        const int64_t sum = static_cast<int64_t>(dest[i]) + src[i];
+        if (sum > INT32_MAX) {
+            dest[i] = INT32_MAX;
+        } else if (sum < INT32_MIN) {
+            dest[i] = INT32_MIN;
+        } else {
+            dest[i] = static_cast<int32_t>(sum);
+        }
+    }
+}
+
+} // namespace audio
+} // namespace screamrouter
+
+#endif // MIX_ACCUMULATE_H
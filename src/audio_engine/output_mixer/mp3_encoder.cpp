@@ -5,6 +5,7 @@
 #include "mp3_encoder.h"
 #include "../utils/cpp_logger.h"
 #include "../utils/profiler.h"
+#include "../utils/span_tracer.h"
 #include "../configuration/audio_engine_settings.h"
 #include <cstring>
 #include <chrono>
@@ -199,6 +200,7 @@ void Mp3Encoder::thread_loop() {
 
 void Mp3Encoder::encode_and_push(const int32_t* samples, size_t sample_count) {
     PROFILE_FUNCTION();
+    SR_TRACE_SPAN("mp3_encode");
     auto t0 = std::chrono::steady_clock::now();
     
     if (!output_queue_ || !lame_flags_ || sample_count == 0 || !samples) {
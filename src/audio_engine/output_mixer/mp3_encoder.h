@@ -7,7 +7,7 @@
 #define MP3_ENCODER_H
 
 #include "../audio_types.h"
-#include "../utils/thread_safe_queue.h"
+#include "../utils/mpsc_queue.h"
 #include <lame/lame.h>
 #include <vector>
 #include <deque>
@@ -24,7 +24,7 @@ namespace audio {
 
 class AudioEngineSettings;
 
-using Mp3OutputQueue = utils::ThreadSafeQueue<EncodedMP3Data>;
+using Mp3OutputQueue = utils::MpscQueue<EncodedMP3Data>;
 
 /**
  * @class Mp3Encoder
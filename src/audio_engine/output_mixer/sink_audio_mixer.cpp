@@ -6,6 +6,7 @@
  *          mixing it, and dispatching it to various network senders.
  */
 #include "sink_audio_mixer.h"
+#include "mix_accumulate.h"
 #include "../utils/cpp_logger.h"
 #include "../configuration/audio_engine_settings.h"
 #include "../input_processor/source_input_processor.h"
@@ -32,7 +33,10 @@
 #include "../senders/webrtc/webrtc_sender.h"
 #include "../senders/system/alsa_playback_sender.h"
 #include "../utils/thread_priority.h"
+#include "../utils/audio_clock.h"
 #include "../utils/profiler.h"
+#include "../utils/span_tracer.h"
+#include "../utils/realtime_scope.h"
 #if defined(__linux__)
 #include "../senders/system/screamrouter_fifo_sender.h"
 #include "../system_audio/runtime_paths.h"
@@ -54,6 +58,34 @@ using namespace screamrouter::audio::utils;
     #endif
 #endif
 
+namespace {
+
+/// Quantizes 32-bit mix samples to little-endian PCM at bit_depth into a contiguous buffer.
+void quantize_samples(const int32_t* src, size_t count, int bit_depth, uint8_t* dst) {
+    switch (bit_depth) {
+        case 16:
+            for (size_t i = 0; i < count; ++i, dst += 2) {
+                dst[0] = static_cast<uint8_t>((src[i] >> 16) & 0xFF);
+                dst[1] = static_cast<uint8_t>((src[i] >> 24) & 0xFF);
+            }
+            break;
+        case 24:
+            for (size_t i = 0; i < count; ++i, dst += 3) {
+                dst[0] = static_cast<uint8_t>((src[i] >> 8) & 0xFF);
+                dst[1] = static_cast<uint8_t>((src[i] >> 16) & 0xFF);
+                dst[2] = static_cast<uint8_t>((src[i] >> 24) & 0xFF);
+            }
+            break;
+        case 32:
+            std::memcpy(dst, src, count * sizeof(int32_t));
+            break;
+        default:
+            break;
+    }
+}
+
+} // namespace
+
 /** @brief Default bitrate for MP3 encoding if enabled. */
 /**
  * @brief Constructs a SinkAudioMixer.
@@ -200,7 +232,7 @@ SinkAudioMixer::SinkAudioMixer(
 
     stereo_preprocessor_ = std::make_unique<AudioProcessor>(
         config_.output_channels, 2, 32, config_.output_samplerate, config_.output_samplerate, 1.0f,
-        std::map<int, CppSpeakerLayout>(), m_settings, chunk_size_bytes_);
+        std::map<int, CppSpeakerLayout>(), m_settings, chunk_size_bytes_, config_.resampler_quality);
 
     if (!stereo_preprocessor_) {
         LOG_CPP_ERROR("[SinkMixer:%s] Failed to create stereo preprocessor.", config_.sink_id.c_str());
@@ -226,8 +258,6 @@ SinkAudioMixer::SinkAudioMixer(
             send_playback_rate_command(instance_id, ratio);
         });
 
-    last_drain_check_ = std::chrono::steady_clock::now();
-
     LOG_CPP_INFO("[SinkMixer:%s] Initialization complete.", config_.sink_id.c_str());
 }
 
@@ -343,6 +373,7 @@ void SinkAudioMixer::add_input_queue(const std::string& instance_id,
         std::lock_guard<std::mutex> lock(queues_mutex_);
         ready_rings_[instance_id] = ready_ring;
         source_processors_[instance_id] = sip;
+        dedup_chunk_rings_.erase(instance_id);
         input_active_state_[instance_id] = false;
         source_buffers_[instance_id].audio_data.assign(mixing_buffer_samples_, 0);
         processed_ready_[instance_id].clear();
@@ -350,6 +381,30 @@ void SinkAudioMixer::add_input_queue(const std::string& instance_id,
     }
 }
 
+/**
+ * @brief Adds an input whose chunks are produced by a processor another sink drives.
+ * @param instance_id The unique ID of the deduplicated source processor instance.
+ * @param chunk_ring Ring of processed chunks fanned out by that processor.
+ */
+void SinkAudioMixer::add_dedup_input(const std::string& instance_id,
+                                     std::shared_ptr<ProcessedChunkRing> chunk_ring) {
+    if (!chunk_ring) {
+        LOG_CPP_ERROR("[SinkMixer:%s] Attempted to add null dedup input for instance: %s", config_.sink_id.c_str(), instance_id.c_str());
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues_mutex_);
+        // An idle ready ring keeps the input visible to stats and underrun accounting.
+        ready_rings_[instance_id] = std::make_shared<ReadyPacketRing>(2);
+        source_processors_.erase(instance_id);
+        dedup_chunk_rings_[instance_id] = std::move(chunk_ring);
+        input_active_state_[instance_id] = false;
+        source_buffers_[instance_id].audio_data.assign(mixing_buffer_samples_, 0);
+        processed_ready_[instance_id].clear();
+        LOG_CPP_INFO("[SinkMixer:%s] Added deduplicated processed input for source instance: %s", config_.sink_id.c_str(), instance_id.c_str());
+    }
+}
+
 /**
  * @brief Removes an input queue associated with a source processor.
  * @param instance_id The unique ID of the source processor instance.
@@ -362,13 +417,12 @@ void SinkAudioMixer::remove_input_queue(const std::string& instance_id) {
         input_active_state_.erase(instance_id);
         source_buffers_.erase(instance_id);
         processed_ready_.erase(instance_id);
+        dedup_chunk_rings_.erase(instance_id);
         LOG_CPP_INFO("[SinkMixer:%s] Removed ready ring for source instance: %s", config_.sink_id.c_str(), instance_id.c_str());
     }
 
-    {
-        std::lock_guard<std::mutex> lock(drain_control_mutex_);
-        per_source_smoothed_buffer_ms_.erase(instance_id);
-        source_last_rate_command_.erase(instance_id);
+    if (rate_controller_) {
+        rate_controller_->remove_source(instance_id);
     }
 }
 
@@ -404,6 +458,110 @@ INetworkSender* SinkAudioMixer::get_listener(const std::string& listener_id) {
     return listener_dispatcher_ ? listener_dispatcher_->get_listener(listener_id) : nullptr;
 }
 
+/**
+ * @brief Detaches a listener without closing it.
+ * @param listener_id The ID of the listener.
+ * @return The listener's sender, or `nullptr` if not found.
+ */
+std::unique_ptr<INetworkSender> SinkAudioMixer::take_listener(const std::string& listener_id) {
+    return listener_dispatcher_ ? listener_dispatcher_->take_listener(listener_id) : nullptr;
+}
+
+/**
+ * @brief Attaches a listener detached from another mixer.
+ * @param listener_id The ID of the listener.
+ * @param sender The already set up network sender.
+ */
+void SinkAudioMixer::adopt_listener(const std::string& listener_id, std::unique_ptr<INetworkSender> sender) {
+    if (listener_dispatcher_) {
+        listener_dispatcher_->adopt_listener(listener_id, std::move(sender));
+    } else {
+        LOG_CPP_ERROR("[SinkMixer:%s] ListenerDispatcher not initialized", config_.sink_id.c_str());
+    }
+}
+
+/**
+ * @brief Adds a member sink whose destination receives a copy of this mixer's output.
+ * @param member_config Configuration of the member sink.
+ * @return true if the member's sender was created and set up.
+ */
+bool SinkAudioMixer::add_mirror_sink(SinkMixerConfig member_config) {
+    // The member shares this mix, so it must also share the effective output format.
+    member_config.output_bitdepth = config_.output_bitdepth;
+    member_config.output_samplerate = config_.output_samplerate;
+    member_config.output_channels = config_.output_channels;
+    member_config.output_chlayout1 = config_.output_chlayout1;
+    member_config.output_chlayout2 = config_.output_chlayout2;
+
+    std::unique_ptr<INetworkSender> sender;
+    if (member_config.multi_device_mode) {
+        sender = nullptr;
+    } else if (member_config.protocol == "scream") {
+        sender = std::make_unique<ScreamSender>(member_config);
+    } else if (member_config.protocol == "rtp") {
+        sender = std::make_unique<RtpSender>(member_config);
+    } else if (member_config.protocol == "rtp_opus") {
+        sender = std::make_unique<RtpOpusSender>(member_config);
+    }
+    if (!sender) {
+        LOG_CPP_ERROR("[SinkMixer:%s] Cannot mirror output to sink %s using protocol '%s'.",
+                      config_.sink_id.c_str(), member_config.sink_id.c_str(), member_config.protocol.c_str());
+        return false;
+    }
+    if (!sender->setup()) {
+        LOG_CPP_ERROR("[SinkMixer:%s] Failed to set up mirror sender for sink %s.",
+                      config_.sink_id.c_str(), member_config.sink_id.c_str());
+        return false;
+    }
+
+    std::unique_ptr<INetworkSender> replaced;
+    {
+        std::lock_guard<std::mutex> lock(mirror_senders_mutex_);
+        auto& slot = mirror_senders_[member_config.sink_id];
+        replaced = std::move(slot);
+        slot = std::move(sender);
+    }
+    if (replaced) {
+        replaced->close();
+    }
+    LOG_CPP_INFO("[SinkMixer:%s] Mirroring output to sink %s (%s:%d).",
+                 config_.sink_id.c_str(), member_config.sink_id.c_str(),
+                 member_config.output_ip.c_str(), member_config.output_port);
+    return true;
+}
+
+/**
+ * @brief Removes a member sink added with add_mirror_sink().
+ * @param sink_id The ID of the member sink.
+ */
+void SinkAudioMixer::remove_mirror_sink(const std::string& sink_id) {
+    std::unique_ptr<INetworkSender> sender;
+    {
+        std::lock_guard<std::mutex> lock(mirror_senders_mutex_);
+        auto it = mirror_senders_.find(sink_id);
+        if (it == mirror_senders_.end()) {
+            return;
+        }
+        sender = std::move(it->second);
+        mirror_senders_.erase(it);
+    }
+    if (sender) {
+        sender->close();
+    }
+    LOG_CPP_INFO("[SinkMixer:%s] Stopped mirroring output to sink %s.", config_.sink_id.c_str(), sink_id.c_str());
+}
+
+std::vector<std::string> SinkAudioMixer::get_mirror_sink_ids() const {
+    std::lock_guard<std::mutex> lock(mirror_senders_mutex_);
+    std::vector<std::string> ids;
+    ids.reserve(mirror_senders_.size());
+    for (const auto& [sink_id, sender] : mirror_senders_) {
+        (void)sender;
+        ids.push_back(sink_id);
+    }
+    return ids;
+}
+
 SinkAudioMixerStats SinkAudioMixer::get_stats() {
     SinkAudioMixerStats stats;
     stats.total_chunks_mixed = m_total_chunks_mixed.load();
@@ -419,6 +577,17 @@ SinkAudioMixerStats SinkAudioMixer::get_stats() {
         ? profiling_send_gap_sum_ms_ / static_cast<double>(profiling_send_gap_samples_)
         : profiling_last_send_gap_ms_;
 
+    stats.resampler_quality = config_.resampler_quality;
+    stats.silent_inputs_skipped = silent_inputs_skipped_.load(std::memory_order_relaxed);
+    stats.resampler_cpu_ns = stereo_preprocessor_ ? stereo_preprocessor_->get_resampler_cpu_ns() : 0;
+    {
+        std::lock_guard<std::mutex> lock(output_processor_mutex_);
+        stats.resampler_cpu_ns += retired_resampler_cpu_ns_;
+        if (output_post_processor_) {
+            stats.resampler_cpu_ns += output_post_processor_->get_resampler_cpu_ns();
+        }
+    }
+
     const double chunk_ms = (playback_sample_rate_ > 0)
         ? (static_cast<double>(frames_per_chunk_) * 1000.0) / static_cast<double>(playback_sample_rate_)
         : 0.0;
@@ -514,6 +683,7 @@ SinkAudioMixerStats SinkAudioMixer::get_stats() {
         auto listener_ids = listener_dispatcher_->get_listener_ids();
         stats.listener_ids.insert(stats.listener_ids.end(), listener_ids.begin(), listener_ids.end());
     }
+    stats.mirror_sink_ids = get_mirror_sink_ids();
 
     return stats;
 }
@@ -723,6 +893,15 @@ void SinkAudioMixer::stop() {
         log_elapsed("network_sender closed");
     }
 
+    {
+        std::lock_guard<std::mutex> lock(mirror_senders_mutex_);
+        for (auto& [member_id, mirror_sender] : mirror_senders_) {
+            (void)member_id;
+            mirror_sender->close();
+        }
+        mirror_senders_.clear();
+    }
+
     if (listener_dispatcher_) {
         listener_dispatcher_->close_all();
         LOG_CPP_INFO("[SinkMixer:%s] All listener senders closed and cleared.", config_.sink_id.c_str());
@@ -748,7 +927,7 @@ void SinkAudioMixer::start_async() {
     startup_in_progress_.store(false, std::memory_order_release);
 }
 
-bool SinkAudioMixer::start_internal() {
+bool SinkAudioMixer::start_internal(bool spawn_threads) {
     LOG_CPP_INFO("[SinkMixer:%s] Starting...", config_.sink_id.c_str());
     const auto t0 = std::chrono::steady_clock::now();
 
@@ -792,6 +971,12 @@ bool SinkAudioMixer::start_internal() {
         return false;
     }
 
+    if (!spawn_threads) {
+        LOG_CPP_INFO("[SinkMixer:%s] Started without threads; ticks are driven by the caller.",
+                     config_.sink_id.c_str());
+        return true;
+    }
+
     start_mp3_thread();
 
     try {
@@ -829,6 +1014,126 @@ void SinkAudioMixer::join_startup_thread() {
     startup_in_progress_.store(false, std::memory_order_release);
 }
 
+bool SinkAudioMixer::start_driven() {
+    if (is_running() || startup_in_progress_.load(std::memory_order_acquire) ||
+        clock_manager_enabled_.load(std::memory_order_acquire)) {
+        LOG_CPP_ERROR("[SinkMixer:%s] start_driven() called on a mixer that is already started.",
+                      config_.sink_id.c_str());
+        return false;
+    }
+    if (!utils::AudioClock::is_virtual()) {
+        LOG_CPP_ERROR("[SinkMixer:%s] start_driven() requires a virtual AudioClock.", config_.sink_id.c_str());
+        return false;
+    }
+    bool started = false;
+    try {
+        started = start_internal(false);
+    } catch (const std::exception& ex) {
+        LOG_CPP_ERROR("[SinkMixer:%s] Exception during driven startup: %s", config_.sink_id.c_str(), ex.what());
+    }
+    if (!started) {
+        stop_flag_ = true;
+    }
+    return started;
+}
+
+std::size_t SinkAudioMixer::run_due_ticks() {
+    if (stop_flag_ || !clock_manager_ || !clock_manager_->is_manually_ticked()) {
+        return 0;
+    }
+    auto condition = clock_condition_handle_.condition;
+    if (!condition) {
+        return 0;
+    }
+
+    clock_manager_->fire_due_ticks();
+    {
+        std::lock_guard<std::mutex> condition_lock(condition->mutex);
+        if (condition->sequence > clock_last_sequence_) {
+            clock_pending_ticks_ += condition->sequence - clock_last_sequence_;
+            clock_last_sequence_ = condition->sequence;
+        }
+    }
+
+    std::size_t cycles = 0;
+    while (clock_pending_ticks_ > 0) {
+        --clock_pending_ticks_;
+        if (!run_mix_cycle()) {
+            break;
+        }
+        ++cycles;
+    }
+    return cycles;
+}
+
+void SinkAudioMixer::set_output_sender(std::unique_ptr<INetworkSender> sender) {
+    if (is_running() || clock_manager_enabled_.load(std::memory_order_acquire)) {
+        LOG_CPP_ERROR("[SinkMixer:%s] Output sender can only be replaced while the mixer is stopped.",
+                      config_.sink_id.c_str());
+        return;
+    }
+    network_sender_ = std::move(sender);
+}
+
+void SinkAudioMixer::enqueue_processed_chunks_locked(const std::string& instance_id,
+                                                     std::vector<ProcessedAudioChunk>& produced,
+                                                     std::size_t max_queued_chunks) {
+    constexpr double ready_queue_catchup_seconds = 5.0;
+    auto& queue = processed_ready_[instance_id];
+    for (auto& chunk : produced) {
+        const std::string context = " [sink=" + config_.sink_id + " instance=" + instance_id +
+                                    " queued_depth=" + std::to_string(queue.size() + 1) + "]";
+        utils::log_sentinel("sink_chunk_received", chunk, context);
+        queue.push_back(std::move(chunk));
+        ready_total_received_[instance_id]++;
+        auto& ready_hw = ready_queue_high_water_[instance_id];
+        if (queue.size() > ready_hw) {
+            ready_hw = queue.size();
+        }
+        if (queue.size() > max_queued_chunks) {
+            const auto now = utils::AudioClock::now();
+            auto& drop_state = ready_queue_drop_state_[instance_id];
+            if (drop_state.last_update.time_since_epoch().count() == 0) {
+                drop_state.last_update = now;
+                drop_state.drop_credit = 0.0;
+            }
+            double elapsed_sec = std::chrono::duration<double>(now - drop_state.last_update).count();
+            if (elapsed_sec < 0.0) {
+                elapsed_sec = 0.0;
+            }
+            drop_state.last_update = now;
+            const size_t overage = queue.size() - max_queued_chunks;
+            if (ready_queue_catchup_seconds > 0.0) {
+                const double drop_rate = static_cast<double>(overage) / ready_queue_catchup_seconds;
+                drop_state.drop_credit += drop_rate * elapsed_sec;
+            }
+            const double max_credit = static_cast<double>(queue.size() - max_queued_chunks);
+            if (drop_state.drop_credit > max_credit) {
+                drop_state.drop_credit = max_credit;
+            }
+            while (queue.size() > max_queued_chunks && drop_state.drop_credit >= 1.0) {
+                if (queue.front().is_sentinel) {
+                    utils::log_sentinel("sink_chunk_dropped", queue.front(), " [sink=" + config_.sink_id + " instance=" + instance_id + " due_to_backlog]");
+                }
+                queue.pop_front();
+                ready_total_dropped_[instance_id]++;
+                drop_state.drop_credit -= 1.0;
+                if (queue.size() > max_queued_chunks) {
+                    const double remaining_overage = static_cast<double>(queue.size() - max_queued_chunks);
+                    if (drop_state.drop_credit > remaining_overage) {
+                        drop_state.drop_credit = remaining_overage;
+                    }
+                } else {
+                    drop_state.drop_credit = 0.0;
+                    break;
+                }
+            }
+        } else {
+            ready_queue_drop_state_.erase(instance_id);
+        }
+    }
+}
+
 /**
  * @brief Waits for data from input queues and determines which sources are active.
  * @param ignored_timeout A timeout value (currently ignored in implementation).
@@ -839,7 +1144,6 @@ bool SinkAudioMixer::wait_for_source_data() {
     bool data_actually_popped_this_cycle = false;
     const std::size_t max_queued_chunks =
         m_settings ? std::max<std::size_t>(1, m_settings->mixer_tuning.max_queued_chunks) : 3;
-    constexpr double ready_queue_catchup_seconds = 5.0;
     bool had_any_active_sources = false;
     {
         std::lock_guard<std::mutex> lock(queues_mutex_);
@@ -873,6 +1177,10 @@ bool SinkAudioMixer::wait_for_source_data() {
         if (!ring || !sip) {
             continue;
         }
+        if (const std::size_t lost = ring->take_overflow()) {
+            LOG_CPP_DEBUG("[SinkMixer:%s] Ready ring for %s overflowed; %zu packets lost before this batch.",
+                          config_.sink_id.c_str(), instance_id.c_str(), lost);
+        }
         TaggedAudioPacket pkt;
         while (ring->pop(pkt)) {
             utils::log_sentinel("sink_ring_pop", pkt, " [sink=" + config_.sink_id + " instance=" + instance_id + "]");
@@ -880,64 +1188,28 @@ bool SinkAudioMixer::wait_for_source_data() {
             sip->ingest_packet(pkt, produced);
             if (!produced.empty()) {
                 std::lock_guard<std::mutex> lock(queues_mutex_);
-                auto& queue = processed_ready_[instance_id];
-                for (auto& chunk : produced) {
-                    const std::string context = " [sink=" + config_.sink_id + " instance=" + instance_id +
-                                                " queued_depth=" + std::to_string(queue.size() + 1) + "]";
-                    utils::log_sentinel("sink_chunk_received", chunk, context);
-                    queue.push_back(std::move(chunk));
-                    ready_total_received_[instance_id]++;
-                    auto& ready_hw = ready_queue_high_water_[instance_id];
-                    if (queue.size() > ready_hw) {
-                        ready_hw = queue.size();
-                    }
-                    if (queue.size() > max_queued_chunks) {
-                        const auto now = std::chrono::steady_clock::now();
-                        auto& drop_state = ready_queue_drop_state_[instance_id];
-                        if (drop_state.last_update.time_since_epoch().count() == 0) {
-                            drop_state.last_update = now;
-                            drop_state.drop_credit = 0.0;
-                        }
-                        double elapsed_sec = std::chrono::duration<double>(now - drop_state.last_update).count();
-                        if (elapsed_sec < 0.0) {
-                            elapsed_sec = 0.0;
-                        }
-                        drop_state.last_update = now;
-                        const size_t overage = queue.size() - max_queued_chunks;
-                        if (ready_queue_catchup_seconds > 0.0) {
-                            const double drop_rate = static_cast<double>(overage) / ready_queue_catchup_seconds;
-                            drop_state.drop_credit += drop_rate * elapsed_sec;
-                        }
-                        const double max_credit = static_cast<double>(queue.size() - max_queued_chunks);
-                        if (drop_state.drop_credit > max_credit) {
-                            drop_state.drop_credit = max_credit;
-                        }
-                        while (queue.size() > max_queued_chunks && drop_state.drop_credit >= 1.0) {
-                            if (queue.front().is_sentinel) {
-                                utils::log_sentinel("sink_chunk_dropped", queue.front(), " [sink=" + config_.sink_id + " instance=" + instance_id + " due_to_backlog]");
-                            }
-                            queue.pop_front();
-                            ready_total_dropped_[instance_id]++;
-                            drop_state.drop_credit -= 1.0;
-                            if (queue.size() > max_queued_chunks) {
-                                const double remaining_overage = static_cast<double>(queue.size() - max_queued_chunks);
-                                if (drop_state.drop_credit > remaining_overage) {
-                                    drop_state.drop_credit = remaining_overage;
-                                }
-                            } else {
-                                drop_state.drop_credit = 0.0;
-                                break;
-                            }
-                        }
-                    } else {
-                        ready_queue_drop_state_.erase(instance_id);
-                    }
-                }
+                enqueue_processed_chunks_locked(instance_id, produced, max_queued_chunks);
             }
             data_actually_popped_this_cycle = true;
         }
     }
 
+    // Inputs whose processor is driven by another sink arrive as processed chunks.
+    std::vector<std::pair<std::string, std::shared_ptr<ProcessedChunkRing>>> dedup_sources;
+    {
+        std::lock_guard<std::mutex> lock(queues_mutex_);
+        dedup_sources.assign(dedup_chunk_rings_.begin(), dedup_chunk_rings_.end());
+    }
+    for (auto& [instance_id, chunk_ring] : dedup_sources) {
+        std::vector<ProcessedAudioChunk> produced;
+        chunk_ring->pop_bulk(std::back_inserter(produced), chunk_ring->capacity());
+        if (!produced.empty()) {
+            std::lock_guard<std::mutex> lock(queues_mutex_);
+            enqueue_processed_chunks_locked(instance_id, produced, max_queued_chunks);
+            data_actually_popped_this_cycle = true;
+        }
+    }
+
     // Local speedups removed; timeshift manager drives rate.
 
     {
@@ -958,7 +1230,14 @@ bool SinkAudioMixer::wait_for_source_data() {
             }
 
                 m_total_chunks_mixed++;
-                source_buffers_[instance_id] = std::move(chunk);
+                auto& current = source_buffers_[instance_id];
+                // Chunks from a processor this mixer drives go back to it for reuse; this is the
+                // thread that calls its ingest_packet().
+                auto sip_it = source_processors_.find(instance_id);
+                if (sip_it != source_processors_.end() && sip_it->second) {
+                    sip_it->second->recycle_chunk(std::move(current));
+                }
+                current = std::move(chunk);
                 const std::string ready_context = " [sink=" + config_.sink_id + " instance=" + instance_id +
                                                   " remaining_depth=" + std::to_string(queue.size()) + "]";
                 utils::log_sentinel("sink_chunk_ready", source_buffers_[instance_id], ready_context);
@@ -986,6 +1265,8 @@ bool SinkAudioMixer::wait_for_source_data() {
         }
 
         auto now = std::chrono::steady_clock::now();
+        // The hold window is media time; the profiling counters below stay on the wall clock.
+        const auto media_now = utils::AudioClock::now();
         bool was_holding_silence = underrun_silence_active_;
         bool hold_window_expired = false;
 
@@ -993,7 +1274,7 @@ bool SinkAudioMixer::wait_for_source_data() {
             long hold_ms = std::max<long>(0, m_settings->mixer_tuning.underrun_hold_timeout_ms);
 
             if (underrun_silence_active_) {
-                if (hold_ms <= 0 || now >= underrun_silence_deadline_) {
+                if (hold_ms <= 0 || media_now >= underrun_silence_deadline_) {
                     hold_window_expired = true;
                     underrun_silence_active_ = false;
                 }
@@ -1002,7 +1283,7 @@ bool SinkAudioMixer::wait_for_source_data() {
             if (!underrun_silence_active_ && hold_ms > 0 && !ready_rings_.empty() && had_any_active_sources &&
                 !has_active_sources_now) {
                 underrun_silence_active_ = true;
-                underrun_silence_deadline_ = now + std::chrono::milliseconds(hold_ms);
+                underrun_silence_deadline_ = media_now + std::chrono::milliseconds(hold_ms);
             }
         } else {
             underrun_silence_active_ = false;
@@ -1056,10 +1337,13 @@ bool SinkAudioMixer::wait_for_source_data() {
  */
 void SinkAudioMixer::mix_buffers() {
     PROFILE_FUNCTION();
+    SR_TRACE_SPAN("mix");
+    SR_RT_SCOPE("SinkAudioMixer::mix_buffers");
     auto t0 = std::chrono::steady_clock::now();
     std::fill(mixing_buffer_.begin(), mixing_buffer_.end(), 0);
     
-    std::vector<uint32_t> collected_csrcs;
+    std::vector<uint32_t>& collected_csrcs = mix_csrcs_scratch_;
+    collected_csrcs.clear();
     size_t active_source_count = 0;
     const size_t channel_count = static_cast<size_t>(std::max(playback_channels_, 1));
     if (last_sample_frame_.size() != channel_count) {
@@ -1078,9 +1362,15 @@ void SinkAudioMixer::mix_buffers() {
                  LOG_CPP_ERROR("[SinkMixer:%s] Mixing error: Source buffer not found for active instance %s", config_.sink_id.c_str(), instance_id.c_str());
                  continue;
             }
+            SR_TRACE_FLOW(buf_it->second.trace_flow_id);
             const auto& source_data = buf_it->second.audio_data;
             const auto& ssrcs = buf_it->second.ssrcs;
             collected_csrcs.insert(collected_csrcs.end(), ssrcs.begin(), ssrcs.end());
+            if (buf_it->second.is_silent) {
+                // Still counted as active so underrun/hold and rate control behave as before.
+                silent_inputs_skipped_.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
  
              size_t samples_in_source = source_data.size();
              LOG_CPP_DEBUG("[SinkMixer:%s] MixBuffers: Mixing instance %s. Source samples=%zu. Expected=%zu.", config_.sink_id.c_str(), instance_id.c_str(), samples_in_source, total_samples_to_mix);
@@ -1092,16 +1382,7 @@ void SinkAudioMixer::mix_buffers() {
 
             LOG_CPP_DEBUG("[SinkMixer:%s] MixBuffers: Accumulating %zu samples from instance %s", config_.sink_id.c_str(), total_samples_to_mix, instance_id.c_str());
 
-            for (size_t i = 0; i < total_samples_to_mix; ++i) {
-                int64_t sum = static_cast<int64_t>(mixing_buffer_[i]) + source_data[i];
-                if (sum > INT32_MAX) {
-                    mixing_buffer_[i] = INT32_MAX;
-                } else if (sum < INT32_MIN) {
-                    mixing_buffer_[i] = INT32_MIN;
-                } else {
-                    mixing_buffer_[i] = static_cast<int32_t>(sum);
-                }
-            }
+            mix_accumulate_saturating(mixing_buffer_.data(), source_data.data(), total_samples_to_mix);
         }
     }
 
@@ -1141,7 +1422,16 @@ void SinkAudioMixer::mix_buffers() {
  */
 void SinkAudioMixer::downscale_buffer() {
     PROFILE_FUNCTION();
+    SR_TRACE_SPAN("downscale");
     auto t0 = std::chrono::steady_clock::now();
+    auto record_downscale_time = [this, t0]() {
+        auto t1 = std::chrono::steady_clock::now();
+        uint64_t dt = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+        profiling_downscale_calls_++;
+        profiling_downscale_ns_sum_ += static_cast<long double>(dt);
+        if (dt > profiling_downscale_ns_max_) profiling_downscale_ns_max_ = dt;
+        if (dt < profiling_downscale_ns_min_) profiling_downscale_ns_min_ = dt;
+    };
     int target_bit_depth = playback_bit_depth_ > 0 ? playback_bit_depth_ : config_.output_bitdepth;
     if (target_bit_depth <= 0) {
         target_bit_depth = 16;
@@ -1182,7 +1472,18 @@ void SinkAudioMixer::downscale_buffer() {
         }
     }
 
+    if (target_bit_depth != 16 && target_bit_depth != 24 && target_bit_depth != 32) {
+        LOG_CPP_ERROR("[SinkMixer:%s] Unsupported target bit depth %d during downscale.",
+                      config_.sink_id.c_str(), target_bit_depth);
+        return;
+    }
+
     size_t expected_bytes_to_write = samples_to_convert * output_byte_depth;
+    if (config_.protocol == "system_audio" && payload_buffer_fill_bytes_ == 0 &&
+        downscale_direct(read_ptr, samples_to_convert, target_bit_depth)) {
+        record_downscale_time();
+        return;
+    }
     LOG_CPP_DEBUG("[SinkMixer:%s] Downscale: Converting %zu samples (int32) to %d-bit. Expected output bytes=%zu.",
                   config_.sink_id.c_str(), samples_to_convert, target_bit_depth, expected_bytes_to_write);
 
@@ -1208,49 +1509,100 @@ void SinkAudioMixer::downscale_buffer() {
 
     size_t write_index = (payload_buffer_read_pos_ + payload_buffer_fill_bytes_) % capacity;
 
-    for (size_t i = 0; i < samples_to_convert; ++i) {
-        int32_t sample = read_ptr[i];
-        switch (target_bit_depth) {
-            case 16:
-                payload_buffer_[write_index] = static_cast<uint8_t>((sample >> 16) & 0xFF);
-                if (++write_index == capacity) write_index = 0;
-                payload_buffer_[write_index] = static_cast<uint8_t>((sample >> 24) & 0xFF);
-                if (++write_index == capacity) write_index = 0;
-                break;
-            case 24:
-                payload_buffer_[write_index] = static_cast<uint8_t>((sample >> 8) & 0xFF);
-                if (++write_index == capacity) write_index = 0;
-                payload_buffer_[write_index] = static_cast<uint8_t>((sample >> 16) & 0xFF);
-                if (++write_index == capacity) write_index = 0;
-                payload_buffer_[write_index] = static_cast<uint8_t>((sample >> 24) & 0xFF);
-                if (++write_index == capacity) write_index = 0;
-                break;
-            case 32:
-                payload_buffer_[write_index] = static_cast<uint8_t>((sample) & 0xFF);
-                if (++write_index == capacity) write_index = 0;
-                payload_buffer_[write_index] = static_cast<uint8_t>((sample >> 8) & 0xFF);
-                if (++write_index == capacity) write_index = 0;
-                payload_buffer_[write_index] = static_cast<uint8_t>((sample >> 16) & 0xFF);
-                if (++write_index == capacity) write_index = 0;
-                payload_buffer_[write_index] = static_cast<uint8_t>((sample >> 24) & 0xFF);
-                if (++write_index == capacity) write_index = 0;
-                break;
-            default:
-                LOG_CPP_ERROR("[SinkMixer:%s] Unsupported target bit depth %d during downscale.",
-                              config_.sink_id.c_str(), target_bit_depth);
-                return;
-        }
-    }
+    // The ring wraps at most once per chunk: quantize the span up to the end of payload_buffer_,
+    // then the remainder from the start.
+    const size_t head_bytes = std::min(expected_bytes_to_write, capacity - write_index);
+    size_t samples_done = head_bytes / output_byte_depth;
+    quantize_samples(read_ptr, samples_done, target_bit_depth, payload_buffer_.data() + write_index);
+    write_index += samples_done * output_byte_depth;
+    if (write_index == capacity) {
+        write_index = 0;
+    }
+    if (samples_done < samples_to_convert && (head_bytes % output_byte_depth) != 0) {
+        // Only reachable when capacity is not a whole number of samples: split the straddling one.
+        uint8_t straddle[sizeof(int32_t)];
+        quantize_samples(read_ptr + samples_done, 1, target_bit_depth, straddle);
+        for (size_t b = 0; b < output_byte_depth; ++b) {
+            payload_buffer_[write_index] = straddle[b];
+            if (++write_index == capacity) write_index = 0;
+        }
+        ++samples_done;
+    }
+    quantize_samples(read_ptr + samples_done, samples_to_convert - samples_done, target_bit_depth,
+                     payload_buffer_.data() + write_index);
     const size_t bytes_written = expected_bytes_to_write;
     payload_buffer_fill_bytes_ += bytes_written;
     profiling_max_payload_buffer_bytes_ = std::max(profiling_max_payload_buffer_bytes_, payload_buffer_fill_bytes_);
     LOG_CPP_DEBUG("[SinkMixer:%s] Downscale complete. bytes_written=%zu fill=%zu", config_.sink_id.c_str(), bytes_written, payload_buffer_fill_bytes_);
-    auto t1 = std::chrono::steady_clock::now();
-    uint64_t dt = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
-    profiling_downscale_calls_++;
-    profiling_downscale_ns_sum_ += static_cast<long double>(dt);
-    if (dt > profiling_downscale_ns_max_) profiling_downscale_ns_max_ = dt;
-    if (dt < profiling_downscale_ns_min_) profiling_downscale_ns_min_ = dt;
+    record_downscale_time();
+}
+
+/**
+ * @brief Quantizes the processed mix straight into an mmap'd ALSA ring.
+ * @details Only taken when nothing is queued in payload_buffer_ and no mirror sender needs
+ *          the bytes, so ordering and fan-out stay identical to the buffered path.
+ * @return false if the buffered path must handle this tick.
+ */
+bool SinkAudioMixer::downscale_direct(const int32_t* samples, size_t sample_count, int bit_depth) {
+#if defined(__linux__)
+    const size_t channels = static_cast<size_t>(std::max(playback_channels_, 1));
+    if (sample_count == 0 || (sample_count % channels) != 0 ||
+        (bit_depth != 16 && bit_depth != 24 && bit_depth != 32)) {
+        return false;
+    }
+    auto* alsa_sender = dynamic_cast<AlsaPlaybackSender*>(network_sender_.get());
+    if (!alsa_sender ||
+        !alsa_sender->accepts_direct_writes(static_cast<unsigned int>(channels), static_cast<unsigned int>(bit_depth))) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> mirror_lock(mirror_senders_mutex_);
+    if (!mirror_senders_.empty()) {
+        return false;
+    }
+
+    SR_TRACE_SPAN("send");
+    const size_t frames = sample_count / channels;
+    const auto result = alsa_sender->write_direct(
+        frames, static_cast<unsigned int>(channels), static_cast<unsigned int>(bit_depth),
+        [samples, channels, bit_depth](uint8_t* dst, size_t first_frame, size_t count) {
+            quantize_samples(samples + first_frame * channels, count * channels, bit_depth, dst);
+        });
+    switch (result) {
+        case AlsaPlaybackSender::DirectWriteResult::Written:
+            direct_frames_written_ += frames;
+            return true;
+        case AlsaPlaybackSender::DirectWriteResult::Declined:
+            // The device reopened in another format since accepts_direct_writes(); nothing was
+            // filled, so the buffered path can still queue this chunk.
+            return false;
+        case AlsaPlaybackSender::DirectWriteResult::Failed:
+            break;
+    }
+    return true; // dropped by the sender, as a failed send_payload() would be
+#else
+    (void)samples;
+    (void)sample_count;
+    (void)bit_depth;
+    return false;
+#endif
+}
+
+void SinkAudioMixer::record_send_gap(std::chrono::steady_clock::time_point send_time) {
+    if (profiling_last_chunk_send_time_.time_since_epoch().count() != 0) {
+        double gap_ms = std::chrono::duration<double, std::milli>(send_time - profiling_last_chunk_send_time_).count();
+        profiling_last_send_gap_ms_ = gap_ms;
+        profiling_send_gap_sum_ms_ += gap_ms;
+        profiling_send_gap_samples_++;
+        if (profiling_send_gap_samples_ == 1) {
+            profiling_send_gap_min_ms_ = gap_ms;
+            profiling_send_gap_max_ms_ = gap_ms;
+        } else {
+            profiling_send_gap_min_ms_ = std::min(profiling_send_gap_min_ms_, gap_ms);
+            profiling_send_gap_max_ms_ = std::max(profiling_send_gap_max_ms_, gap_ms);
+        }
+    }
+    profiling_last_chunk_send_time_ = send_time;
 }
 
 /**
@@ -1347,6 +1699,7 @@ void SinkAudioMixer::enqueue_mp3_pcm(const int32_t* samples, size_t sample_count
  */
 void SinkAudioMixer::encode_and_push_mp3(const int32_t* samples, size_t sample_count) {
     PROFILE_FUNCTION();
+    SR_TRACE_SPAN("mp3_encode");
     auto t0 = std::chrono::steady_clock::now();
     if (!mp3_output_queue_ || !lame_global_flags_ || sample_count == 0 || !samples) {
         return;
@@ -1888,6 +2241,9 @@ void SinkAudioMixer::setup_output_post_processor() {
         sizeof(int32_t);
     const std::size_t effective_chunk_bytes = post_chunk_bytes > 0 ? post_chunk_bytes : chunk_size_bytes_;
     try {
+        if (output_post_processor_) {
+            retired_resampler_cpu_ns_ += output_post_processor_->get_resampler_cpu_ns();
+        }
         output_post_processor_ = std::make_unique<AudioProcessor>(
             playback_channels_,
             playback_channels_,
@@ -1897,7 +2253,8 @@ void SinkAudioMixer::setup_output_post_processor() {
             1.0f,
             std::map<int, CppSpeakerLayout>(),
             m_settings,
-            effective_chunk_bytes);
+            effective_chunk_bytes,
+            config_.resampler_quality);
         output_post_buffer_.clear();
         output_playback_rate_.store(1.0);
         LOG_CPP_INFO("[SinkMixer:%s] Output post-processor initialized (rate=%d Hz, ch=%d).",
@@ -2042,6 +2399,17 @@ bool SinkAudioMixer::wait_for_mix_tick() {
         return false;
     }
 
+#if defined(__linux__)
+    // A device-clocked ALSA sink schedules ticks from its hardware pointer; the ClockManager
+    // timer only takes over while the device has no clock to offer (closed, paused, suspended).
+    if (auto alsa_sender = dynamic_cast<AlsaPlaybackSender*>(network_sender_.get())) {
+        std::chrono::steady_clock::time_point deadline;
+        if (alsa_sender->next_mix_deadline(deadline)) {
+            return wait_for_device_tick(deadline);
+        }
+    }
+#endif
+
     while (clock_pending_ticks_ == 0) {
         if (stop_flag_) {
             return false;
@@ -2098,6 +2466,28 @@ bool SinkAudioMixer::wait_for_mix_tick() {
     return true;
 }
 
+/**
+ * @brief Sleeps until a device-provided tick deadline.
+ * @details Waits on the mix timer's condition so stop() still wakes the loop promptly. Timer
+ *          ticks that fire meanwhile are discarded so a later fallback to the timer does not
+ *          replay them as a burst.
+ */
+bool SinkAudioMixer::wait_for_device_tick(std::chrono::steady_clock::time_point deadline) {
+    constexpr auto kMaxDeviceWait = std::chrono::milliseconds(100);
+    deadline = std::min(deadline, std::chrono::steady_clock::now() + kMaxDeviceWait);
+
+    auto condition = clock_condition_handle_.condition;
+    if (condition) {
+        std::unique_lock<std::mutex> condition_lock(condition->mutex);
+        condition->cv.wait_until(condition_lock, deadline, [this]() { return stop_flag_.load(); });
+        clock_last_sequence_ = condition->sequence;
+    } else {
+        std::this_thread::sleep_until(deadline);
+    }
+    clock_pending_ticks_ = 0;
+    return !stop_flag_;
+}
+
 void SinkAudioMixer::cleanup_closed_listeners() {
     PROFILE_FUNCTION();
     if (listener_dispatcher_) {
@@ -2137,246 +2527,225 @@ void SinkAudioMixer::run() {
             break;
         }
 
-        if (stop_flag_) {
-            break;
-        }
-
-        profiling_cycles_++;
-        cleanup_closed_listeners();
-
-        bool data_available = wait_for_source_data();
-        LOG_CPP_DEBUG("[SinkMixer:%s] RunLoop: Poll complete. Data available this cycle: %s",
-                      config_.sink_id.c_str(), data_available ? "true" : "false");
-
-        if (stop_flag_) {
+        if (!run_mix_cycle()) {
             break;
         }
+    }
 
-        std::unique_lock<std::mutex> lock(queues_mutex_);
-        bool has_active_sources = false;
-        for (const auto& [instance_id, is_active] : input_active_state_) {
-            (void)instance_id;
-            if (is_active) {
-                has_active_sources = true;
-                break;
-            }
-        }
-
-        bool should_mix = has_active_sources || underrun_silence_active_;
+    LOG_CPP_INFO("[SinkMixer:%s] Exiting run loop.", config_.sink_id.c_str());
+}
 
-        if (!should_mix) {
-            LOG_CPP_DEBUG("[SinkMixer:%s] RunLoop: No active sources and no underrun hold. Repeating last sample if available.",
-                          config_.sink_id.c_str());
-        }
+/**
+ * @brief Ingests, mixes and dispatches one chunk.
+ * @return false once the mixer is stopping.
+ */
+bool SinkAudioMixer::run_mix_cycle() {
+    PROFILE_FUNCTION();
+    if (stop_flag_) {
+        return false;
+    }
 
-        const bool coordination_active = coordination_mode_ && coordinator_;
-        std::optional<SinkSynchronizationCoordinator::DispatchTimingInfo> dispatch_timing;
+    profiling_cycles_++;
+    cleanup_closed_listeners();
 
-        if (coordination_active) {
-            LOG_CPP_DEBUG("[SinkMixer:%s] RunLoop: Coordination enabled, waiting on barrier...", config_.sink_id.c_str());
-            if (!coordinator_->begin_dispatch()) {
-                LOG_CPP_DEBUG("[SinkMixer:%s] RunLoop: Coordinator requested skip, yielding cycle.",
-                              config_.sink_id.c_str());
-                lock.unlock();
-                auto telemetry_now = std::chrono::steady_clock::now();
-                maybe_log_profiler();
-                maybe_log_telemetry(telemetry_now);
-                continue;
-            }
+    bool data_available = wait_for_source_data();
+    LOG_CPP_DEBUG("[SinkMixer:%s] RunLoop: Poll complete. Data available this cycle: %s",
+                  config_.sink_id.c_str(), data_available ? "true" : "false");
 
-            dispatch_timing.emplace();
-            dispatch_timing->dispatch_start = std::chrono::steady_clock::now();
-            dispatch_timing->dispatch_end = dispatch_timing->dispatch_start;
+    if (stop_flag_) {
+        return false;
+    }
 
-            LOG_CPP_DEBUG("[SinkMixer:%s] RunLoop: Barrier cleared, proceeding with mix.", config_.sink_id.c_str());
+    std::unique_lock<std::mutex> lock(queues_mutex_);
+    bool has_active_sources = false;
+    for (const auto& [instance_id, is_active] : input_active_state_) {
+        (void)instance_id;
+        if (is_active) {
+            has_active_sources = true;
+            break;
         }
+    }
 
-        LOG_CPP_DEBUG("[SinkMixer:%s] RunLoop: Mixing buffers...", config_.sink_id.c_str());
-        mix_buffers();
-        LOG_CPP_DEBUG("[SinkMixer:%s] RunLoop: Mixing complete.", config_.sink_id.c_str());
-
-        lock.unlock();
-
-        // Adaptive buffer draining: evaluate backlog to inform rate control.
-        update_drain_ratio();
-
-        downscale_buffer();
+    bool should_mix = has_active_sources || underrun_silence_active_;
 
-        const int effective_bit_depth = (playback_bit_depth_ > 0 && (playback_bit_depth_ % 8) == 0)
-                                            ? playback_bit_depth_
-                                            : 16;
-        const std::size_t bytes_per_sample = static_cast<std::size_t>(effective_bit_depth) / 8;
-        const int effective_channels = std::max(playback_channels_, 1);
-        const std::size_t frame_bytes = bytes_per_sample * static_cast<std::size_t>(effective_channels);
-        const bool frame_metrics_valid = frame_bytes > 0 && (chunk_size_bytes_ % frame_bytes) == 0;
-        const std::size_t frames_per_chunk = frame_metrics_valid ? (chunk_size_bytes_ / frame_bytes) : 0;
-        uint64_t frames_dispatched = 0;
+    if (!should_mix) {
+        LOG_CPP_DEBUG("[SinkMixer:%s] RunLoop: No active sources and no underrun hold. Repeating last sample if available.",
+                      config_.sink_id.c_str());
+    }
 
-        // Pipeline backlog update moved to AFTER send loop for accurate buffer level
+    const bool coordination_active = coordination_mode_ && coordinator_;
+    std::optional<SinkSynchronizationCoordinator::DispatchTimingInfo> dispatch_timing;
 
-        if (!frame_metrics_valid && coordination_active) {
-            LOG_CPP_WARNING("[SinkMixer:%s] RunLoop: Unable to derive frames_per_chunk (bit_depth=%d, channels=%d).",
-                            config_.sink_id.c_str(), playback_bit_depth_, playback_channels_);
-        }
-
-        size_t chunks_dispatched = 0;
-        while (payload_buffer_fill_bytes_ >= chunk_size_bytes_) {
-            auto send_time = std::chrono::steady_clock::now();
-            if (profiling_last_chunk_send_time_.time_since_epoch().count() != 0) {
-                double gap_ms = std::chrono::duration<double, std::milli>(send_time - profiling_last_chunk_send_time_).count();
-                profiling_last_send_gap_ms_ = gap_ms;
-                profiling_send_gap_sum_ms_ += gap_ms;
-                profiling_send_gap_samples_++;
-                if (profiling_send_gap_samples_ == 1) {
-                    profiling_send_gap_min_ms_ = gap_ms;
-                    profiling_send_gap_max_ms_ = gap_ms;
-                } else {
-                    profiling_send_gap_min_ms_ = std::min(profiling_send_gap_min_ms_, gap_ms);
-                    profiling_send_gap_max_ms_ = std::max(profiling_send_gap_max_ms_, gap_ms);
+    if (coordination_active) {
+        LOG_CPP_DEBUG("[SinkMixer:%s] RunLoop: Coordination enabled, waiting on barrier...", config_.sink_id.c_str());
+        if (!coordinator_->begin_dispatch()) {
+            LOG_CPP_DEBUG("[SinkMixer:%s] RunLoop: Coordinator requested skip, yielding cycle.",
+                          config_.sink_id.c_str());
+            lock.unlock();
+            auto telemetry_now = std::chrono::steady_clock::now();
+            maybe_log_profiler();
+            maybe_log_telemetry(telemetry_now);
+            return true;
+        }
+
+        dispatch_timing.emplace();
+        dispatch_timing->dispatch_start = std::chrono::steady_clock::now();
+        dispatch_timing->dispatch_end = dispatch_timing->dispatch_start;
+
+        LOG_CPP_DEBUG("[SinkMixer:%s] RunLoop: Barrier cleared, proceeding with mix.", config_.sink_id.c_str());
+    }
+
+    LOG_CPP_DEBUG("[SinkMixer:%s] RunLoop: Mixing buffers...", config_.sink_id.c_str());
+    mix_buffers();
+    LOG_CPP_DEBUG("[SinkMixer:%s] RunLoop: Mixing complete.", config_.sink_id.c_str());
+
+    lock.unlock();
+
+    // Adaptive buffer draining: evaluate backlog to inform rate control.
+    update_drain_ratio();
+
+    downscale_buffer();
+
+    const int effective_bit_depth = (playback_bit_depth_ > 0 && (playback_bit_depth_ % 8) == 0)
+                                        ? playback_bit_depth_
+                                        : 16;
+    const std::size_t bytes_per_sample = static_cast<std::size_t>(effective_bit_depth) / 8;
+    const int effective_channels = std::max(playback_channels_, 1);
+    const std::size_t frame_bytes = bytes_per_sample * static_cast<std::size_t>(effective_channels);
+    const bool frame_metrics_valid = frame_bytes > 0 && (chunk_size_bytes_ % frame_bytes) == 0;
+    const std::size_t frames_per_chunk = frame_metrics_valid ? (chunk_size_bytes_ / frame_bytes) : 0;
+    uint64_t frames_dispatched = 0;
+
+    // Pipeline backlog update moved to AFTER send loop for accurate buffer level
+
+    if (!frame_metrics_valid && coordination_active) {
+        LOG_CPP_WARNING("[SinkMixer:%s] RunLoop: Unable to derive frames_per_chunk (bit_depth=%d, channels=%d).",
+                        config_.sink_id.c_str(), playback_bit_depth_, playback_channels_);
+    }
+
+    size_t chunks_dispatched = 0;
+    if (direct_frames_written_ > 0) {
+        // downscale_buffer() already committed this tick to the device ring.
+        record_send_gap(std::chrono::steady_clock::now());
+        profiling_chunks_sent_++;
+        profiling_payload_bytes_sent_ += direct_frames_written_ * frame_bytes;
+        frames_dispatched += direct_frames_written_;
+        chunks_dispatched++;
+        direct_frames_written_ = 0;
+    }
+    while (payload_buffer_fill_bytes_ >= chunk_size_bytes_) {
+        record_send_gap(std::chrono::steady_clock::now());
+        SR_TRACE_SPAN("send");
+        std::unique_lock<std::mutex> mirror_lock(mirror_senders_mutex_);
+        if (network_sender_ || !mirror_senders_.empty()) {
+            const size_t capacity = payload_buffer_.size();
+            const size_t contiguous = std::min(chunk_size_bytes_, capacity - payload_buffer_read_pos_);
+            const uint8_t* send_ptr = payload_buffer_.data() + payload_buffer_read_pos_;
+            if (contiguous != chunk_size_bytes_) {
+                if (payload_chunk_temp_.size() < chunk_size_bytes_) {
+                    payload_chunk_temp_.resize(chunk_size_bytes_);
                 }
+                std::memcpy(payload_chunk_temp_.data(), send_ptr, contiguous);
+                std::memcpy(payload_chunk_temp_.data() + contiguous, payload_buffer_.data(), chunk_size_bytes_ - contiguous);
+                send_ptr = payload_chunk_temp_.data();
             }
-            profiling_last_chunk_send_time_ = send_time;
+            std::lock_guard<std::mutex> lock(csrc_mutex_);
             if (network_sender_) {
-                const size_t capacity = payload_buffer_.size();
-                const size_t contiguous = std::min(chunk_size_bytes_, capacity - payload_buffer_read_pos_);
-                const uint8_t* send_ptr = payload_buffer_.data() + payload_buffer_read_pos_;
-                if (contiguous == chunk_size_bytes_) {
-                    std::lock_guard<std::mutex> lock(csrc_mutex_);
-                    network_sender_->send_payload(send_ptr, chunk_size_bytes_, current_csrcs_);
-                } else {
-                    if (payload_chunk_temp_.size() < chunk_size_bytes_) {
-                        payload_chunk_temp_.resize(chunk_size_bytes_);
-                    }
-                    std::memcpy(payload_chunk_temp_.data(), send_ptr, contiguous);
-                    std::memcpy(payload_chunk_temp_.data() + contiguous, payload_buffer_.data(), chunk_size_bytes_ - contiguous);
-                    std::lock_guard<std::mutex> lock(csrc_mutex_);
-                    network_sender_->send_payload(payload_chunk_temp_.data(), chunk_size_bytes_, current_csrcs_);
-                }
+                network_sender_->send_payload(send_ptr, chunk_size_bytes_, current_csrcs_);
             }
-            profiling_chunks_sent_++;
-            profiling_payload_bytes_sent_ += chunk_size_bytes_;
-
-            if (frame_metrics_valid) {
-                frames_dispatched += frames_per_chunk;
+            for (auto& [member_id, mirror_sender] : mirror_senders_) {
+                (void)member_id;
+                mirror_sender->send_payload(send_ptr, chunk_size_bytes_, current_csrcs_);
             }
-            chunks_dispatched++;
-
-            payload_buffer_read_pos_ = (payload_buffer_read_pos_ + chunk_size_bytes_) % payload_buffer_.size();
-            payload_buffer_fill_bytes_ -= chunk_size_bytes_;
+        }
+        mirror_lock.unlock();
+        profiling_chunks_sent_++;
+        profiling_payload_bytes_sent_ += chunk_size_bytes_;
 
-            LOG_CPP_DEBUG("[SinkMixer:%s] RunLoop: Sent chunk, remaining bytes in buffer: %zu",
-                          config_.sink_id.c_str(), payload_buffer_fill_bytes_);
+        if (frame_metrics_valid) {
+            frames_dispatched += frames_per_chunk;
         }
+        chunks_dispatched++;
+
+        payload_buffer_read_pos_ = (payload_buffer_read_pos_ + chunk_size_bytes_) % payload_buffer_.size();
+        payload_buffer_fill_bytes_ -= chunk_size_bytes_;
 
-        // Update pipeline backlog AFTER send loop so upstream_frames reflects actual remaining bytes
-        if (config_.protocol == "system_audio" && frame_metrics_valid) {
-            const double upstream_frames = static_cast<double>(payload_buffer_fill_bytes_) / static_cast<double>(frame_bytes);
-            const double upstream_target_frames = static_cast<double>(frames_per_chunk);
+        LOG_CPP_DEBUG("[SinkMixer:%s] RunLoop: Sent chunk, remaining bytes in buffer: %zu",
+                      config_.sink_id.c_str(), payload_buffer_fill_bytes_);
+    }
+
+    // Update pipeline backlog AFTER send loop so upstream_frames reflects actual remaining bytes
+    if (config_.protocol == "system_audio" && frame_metrics_valid) {
+        const double upstream_frames = static_cast<double>(payload_buffer_fill_bytes_) / static_cast<double>(frame_bytes);
+        const double upstream_target_frames = static_cast<double>(frames_per_chunk);
 #if defined(__linux__)
-            if (auto alsa_sender = dynamic_cast<AlsaPlaybackSender*>(network_sender_.get())) {
-                alsa_sender->update_pipeline_backlog(upstream_frames, upstream_target_frames);
-            }
+        if (auto alsa_sender = dynamic_cast<AlsaPlaybackSender*>(network_sender_.get())) {
+            alsa_sender->update_pipeline_backlog(upstream_frames, upstream_target_frames);
+        }
 #elif defined(_WIN32)
-            if (auto wasapi_sender = dynamic_cast<screamrouter::audio::system_audio::WasapiPlaybackSender*>(network_sender_.get())) {
-                wasapi_sender->update_pipeline_backlog(upstream_frames, upstream_target_frames);
-            }
-#endif
+        if (auto wasapi_sender = dynamic_cast<screamrouter::audio::system_audio::WasapiPlaybackSender*>(network_sender_.get())) {
+            wasapi_sender->update_pipeline_backlog(upstream_frames, upstream_target_frames);
         }
+#endif
+    }
 
-        if (coordination_active && dispatch_timing) {
-            dispatch_timing->dispatch_end = std::chrono::steady_clock::now();
-            if (!frame_metrics_valid) {
-                if (chunks_dispatched > 0 && playback_sample_rate_ > 0) {
-                    const double period_seconds = std::chrono::duration<double>(mix_period_).count();
-                    const double frames_per_chunk_estimate = period_seconds > 0.0
-                                                                 ? static_cast<double>(playback_sample_rate_) * period_seconds
-                                                                 : 0.0;
-                    frames_dispatched = static_cast<uint64_t>(
-                        std::llround(frames_per_chunk_estimate * static_cast<double>(chunks_dispatched)));
-                } else {
-                    frames_dispatched = 0;
-                }
+    if (coordination_active && dispatch_timing) {
+        dispatch_timing->dispatch_end = std::chrono::steady_clock::now();
+        if (!frame_metrics_valid) {
+            if (chunks_dispatched > 0 && playback_sample_rate_ > 0) {
+                const double period_seconds = std::chrono::duration<double>(mix_period_).count();
+                const double frames_per_chunk_estimate = period_seconds > 0.0
+                                                             ? static_cast<double>(playback_sample_rate_) * period_seconds
+                                                             : 0.0;
+                frames_dispatched = static_cast<uint64_t>(
+                    std::llround(frames_per_chunk_estimate * static_cast<double>(chunks_dispatched)));
+            } else {
+                frames_dispatched = 0;
             }
-            coordinator_->complete_dispatch(frames_dispatched, *dispatch_timing);
         }
+        coordinator_->complete_dispatch(frames_dispatched, *dispatch_timing);
+    }
 
-        // Check stop_flag_ before acquiring mutex to avoid blocking stop()
-        if (stop_flag_) {
-            break;
-        }
-        
-        bool has_listeners = listener_dispatcher_ && listener_dispatcher_->count() > 0;
-        bool mp3_enabled = mp3_output_queue_ && mp3_thread_running_.load(std::memory_order_acquire);
-
-        if (has_listeners || mp3_enabled) {
-            size_t processed_samples = preprocess_for_listeners_and_mp3();
-            if (processed_samples > 0) {
-                if (has_listeners) {
-                    LOG_CPP_DEBUG("[SinkMixer:%s] Dispatching %zu stereo samples to %zu listeners",
-                                  config_.sink_id.c_str(), processed_samples,
-                                  listener_dispatcher_ ? listener_dispatcher_->count() : 0);
-                    dispatch_to_listeners(processed_samples);
-                }
-                if (mp3_enabled) {
-                    enqueue_mp3_pcm(stereo_buffer_.data(), processed_samples);
-                }
+    // Check stop_flag_ before acquiring mutex to avoid blocking stop()
+    if (stop_flag_) {
+        return false;
+    }
+    
+    bool has_listeners = listener_dispatcher_ && listener_dispatcher_->count() > 0;
+    bool mp3_enabled = mp3_output_queue_ && mp3_thread_running_.load(std::memory_order_acquire);
+
+    if (has_listeners || mp3_enabled) {
+        size_t processed_samples = preprocess_for_listeners_and_mp3();
+        if (processed_samples > 0) {
+            if (has_listeners) {
+                LOG_CPP_DEBUG("[SinkMixer:%s] Dispatching %zu stereo samples to %zu listeners",
+                              config_.sink_id.c_str(), processed_samples,
+                              listener_dispatcher_ ? listener_dispatcher_->count() : 0);
+                dispatch_to_listeners(processed_samples);
+            }
+            if (mp3_enabled) {
+                enqueue_mp3_pcm(stereo_buffer_.data(), processed_samples);
             }
         }
-
-        auto telemetry_now = std::chrono::steady_clock::now();
-        maybe_log_profiler();
-        maybe_log_telemetry(telemetry_now);
     }
 
-    LOG_CPP_INFO("[SinkMixer:%s] Exiting run loop.", config_.sink_id.c_str());
+    auto telemetry_now = std::chrono::steady_clock::now();
+    maybe_log_profiler();
+    maybe_log_telemetry(telemetry_now);
+
+    return true;
 }
 
 void SinkAudioMixer::update_drain_ratio() {
     PROFILE_FUNCTION();
-    auto now = std::chrono::steady_clock::now();
-
-    // Only update periodically
-    auto elapsed = std::chrono::duration<double, std::milli>(
-        now - last_drain_check_).count();
-
-    if (elapsed < m_settings->mixer_tuning.buffer_measurement_interval_ms) {
-        // Log periodically to avoid spam
-        static int skip_counter = 0;
-        if (++skip_counter % 100 == 0) {
-            LOG_CPP_DEBUG("[BufferDrain:%s] Skipping update - only %.1fms elapsed (interval=%.1fms) [skipped %d times]",
-                          config_.sink_id.c_str(), elapsed,
-                          m_settings->mixer_tuning.buffer_measurement_interval_ms, skip_counter);
-        }
-        return;
-    }
-
-    last_drain_check_ = now;
-
-    InputBufferMetrics metrics = compute_input_buffer_metrics();
-    if (!metrics.valid) {
-        LOG_CPP_WARNING("[BufferDrain:%s] Unable to evaluate input buffer backlog (invalid timing parameters).",
-                        config_.sink_id.c_str());
+    if (!rate_controller_) {
         return;
     }
-
-    double buffer_ms = metrics.total_ms;
-
-    LOG_CPP_DEBUG("[BufferDrain:%s] Input backlog: total=%.2fms avg=%.2fms max=%.2fms blocks=%zu sources=%zu block_dur=%.2fms",
-                  config_.sink_id.c_str(), buffer_ms, metrics.avg_per_source_ms, metrics.max_per_source_ms,
-                  metrics.queued_blocks, metrics.active_sources, metrics.block_duration_ms);
-
-    double alpha = 1.0 - m_settings->mixer_tuning.drain_smoothing_factor;
-    double prev_smoothed = smoothed_buffer_level_ms_.load();
-    double smoothed = prev_smoothed * (1.0 - alpha) + buffer_ms * alpha;
-    smoothed_buffer_level_ms_.store(smoothed);
-
-    LOG_CPP_DEBUG("[BufferDrain:%s] Smoothing: prev=%.2fms, raw=%.2fms, alpha=%.3f -> new_smoothed=%.2fms",
-                  config_.sink_id.c_str(), prev_smoothed, buffer_ms, alpha, smoothed);
-
-    dispatch_drain_adjustments(metrics, alpha);
+    rate_controller_->update_drain_ratio(playback_sample_rate_, frames_per_chunk_,
+                                         [this]() { return compute_input_buffer_metrics(); });
 }
 
-SinkAudioMixer::InputBufferMetrics SinkAudioMixer::compute_input_buffer_metrics() {
+InputBufferMetrics SinkAudioMixer::compute_input_buffer_metrics() {
     PROFILE_FUNCTION();
     InputBufferMetrics metrics;
 
@@ -2418,101 +2787,6 @@ SinkAudioMixer::InputBufferMetrics SinkAudioMixer::compute_input_buffer_metrics(
     return metrics;
 }
 
-void SinkAudioMixer::dispatch_drain_adjustments(const InputBufferMetrics& metrics, double alpha) {
-    PROFILE_FUNCTION();
-    if (!m_settings) {
-        return;
-    }
-
-    const auto& tuning = m_settings->mixer_tuning;
-    if (!tuning.enable_adaptive_buffer_drain) {
-        return;
-    }
-
-    struct PendingDrainCommand {
-        std::string instance_id;
-        double ratio;
-        double smoothed_ms;
-    };
-    std::vector<PendingDrainCommand> pending;
-
-    {
-        std::lock_guard<std::mutex> lock(drain_control_mutex_);
-
-        for (auto it = per_source_smoothed_buffer_ms_.begin(); it != per_source_smoothed_buffer_ms_.end();) {
-            if (!metrics.per_source_ms.count(it->first)) {
-                it = per_source_smoothed_buffer_ms_.erase(it);
-            } else {
-                ++it;
-            }
-        }
-
-        for (const auto& [instance_id, backlog_ms] : metrics.per_source_ms) {
-            double prev_smoothed = backlog_ms;
-            auto it = per_source_smoothed_buffer_ms_.find(instance_id);
-            if (it != per_source_smoothed_buffer_ms_.end()) {
-                prev_smoothed = it->second;
-            }
-            double smoothed = prev_smoothed * (1.0 - alpha) + backlog_ms * alpha;
-            per_source_smoothed_buffer_ms_[instance_id] = smoothed;
-
-            double new_ratio = calculate_drain_ratio_for_level(smoothed, metrics.block_duration_ms);
-            double prev_ratio = 1.0;
-            auto ratio_it = source_last_rate_command_.find(instance_id);
-            if (ratio_it != source_last_rate_command_.end()) {
-                prev_ratio = ratio_it->second;
-            }
-
-        LOG_CPP_DEBUG("[BufferDrain:%s] Source %s backlog_raw=%.2fms smoothed=%.2fms prev_ratio=%.6f new_ratio=%.6f",
-                      config_.sink_id.c_str(), instance_id.c_str(), backlog_ms, smoothed, prev_ratio, new_ratio);
-
-        if (std::abs(new_ratio - prev_ratio) <= 0.0001) {
-            continue;
-        }
-
-            source_last_rate_command_[instance_id] = new_ratio;
-            pending.push_back(PendingDrainCommand{instance_id, new_ratio, smoothed});
-        }
-    }
-
-    for (const auto& cmd : pending) {
-        send_playback_rate_command(cmd.instance_id, cmd.ratio);
-        if (cmd.ratio > 1.0) {
-            LOG_CPP_INFO("[BufferDrain:%s] Source %s backlog=%.2fms -> rate scale=%.6f",
-                         config_.sink_id.c_str(), cmd.instance_id.c_str(), cmd.smoothed_ms, cmd.ratio);
-        } else {
-            LOG_CPP_INFO("[BufferDrain:%s] Source %s backlog settled (smoothed=%.2fms), resetting rate scale to 1.0",
-                         config_.sink_id.c_str(), cmd.instance_id.c_str(), cmd.smoothed_ms);
-        }
-    }
-}
-
-double SinkAudioMixer::calculate_drain_ratio_for_level(double buffer_ms, double block_duration_ms) const {
-    PROFILE_FUNCTION();
-    if (!m_settings || block_duration_ms <= 0.0) {
-        return 1.0;
-    }
-    const auto& tuning = m_settings->mixer_tuning;
-    if (!tuning.enable_adaptive_buffer_drain) {
-        return 1.0;
-    }
-
-    const double blocks = buffer_ms / block_duration_ms;
-    // Derive targets in blocks so we're tolerant to bursty arrivals.
-    const double target_blocks = std::max(2.0, tuning.target_buffer_level_ms / block_duration_ms);
-    const double tolerance_blocks = std::max(1.0, tuning.buffer_tolerance_ms / block_duration_ms);
-    const double upper_band = target_blocks + tolerance_blocks;
-
-    if (blocks <= upper_band) {
-        return 1.0;
-    }
-
-    // Bump ~1% per block over the upper band, capped.
-    const double excess_blocks = blocks - upper_band;
-    double ratio = 1.0 + (0.01 * excess_blocks);
-    return std::min(ratio, tuning.max_speedup_factor);
-}
-
 void SinkAudioMixer::send_playback_rate_command(const std::string& instance_id, double ratio) {
     PROFILE_FUNCTION();
     SourceInputProcessor* sip = nullptr;
@@ -2520,6 +2794,10 @@ void SinkAudioMixer::send_playback_rate_command(const std::string& instance_id,
     std::size_t ready_depth = 0;
     {
         std::lock_guard<std::mutex> lock(queues_mutex_);
+        if (dedup_chunk_rings_.count(instance_id) != 0) {
+            // The sink that drives the deduplicated processor owns its playback rate.
+            return;
+        }
         auto sip_it = source_processors_.find(instance_id);
         if (sip_it != source_processors_.end()) {
             sip = sip_it->second;
@@ -58,6 +58,7 @@ struct SinkAudioMixerStats {
     size_t active_input_streams = 0;
     size_t total_input_streams = 0;
     std::vector<std::string> listener_ids;
+    std::vector<std::string> mirror_sink_ids;
     uint64_t buffer_underruns = 0;
     uint64_t buffer_overflows = 0;
     uint64_t mp3_buffer_overflows = 0;
@@ -68,6 +69,9 @@ struct SinkAudioMixerStats {
     double avg_chunk_dwell_ms = 0.0;
     double last_send_gap_ms = 0.0;
     double avg_send_gap_ms = 0.0;
+    ResamplerQuality resampler_quality = ResamplerQuality::SINC_MEDIUM;
+    uint64_t resampler_cpu_ns = 0;
+    uint64_t silent_inputs_skipped = 0;
     std::vector<SinkInputLaneStats> input_lanes;
 };
 
@@ -82,7 +86,7 @@ struct PipelineState {
     double mixer_target_ms = 0.0; ///< Mixer target queue level
 };
 
-using Mp3OutputQueue = utils::ThreadSafeQueue<EncodedMP3Data>;
+using Mp3OutputQueue = utils::MpscQueue<EncodedMP3Data>;
 using ReadyPacketRing = utils::PacketRing<TaggedAudioPacket>;
 
 /**
@@ -135,6 +139,16 @@ public:
      */
     void remove_input_queue(const std::string& instance_id);
 
+    /**
+     * @brief Adds an input fed by a source processor that another sink drives.
+     * @details The processor's chunks arrive already processed through @p chunk_ring, so
+     *          this mixer never calls ingest_packet() or adjusts the processor's rate for it.
+     * @param instance_id The unique ID of the deduplicated source processor instance.
+     * @param chunk_ring Ring the processor pushes copies of its chunks into.
+     */
+    void add_dedup_input(const std::string& instance_id,
+                         std::shared_ptr<ProcessedChunkRing> chunk_ring);
+
     /** @brief Gets the MP3 output queue. */
     std::shared_ptr<Mp3OutputQueue> get_mp3_queue() const { return mp3_output_queue_; }
 
@@ -155,6 +169,35 @@ public:
      * @return A pointer to the `INetworkSender`, or `nullptr` if not found.
      */
     INetworkSender* get_listener(const std::string& listener_id);
+    /**
+     * @brief Detaches a listener without closing it, e.g. to move it to another sink's mixer.
+     * @param listener_id The ID of the listener.
+     * @return The listener's sender, or `nullptr` if not found.
+     */
+    std::unique_ptr<INetworkSender> take_listener(const std::string& listener_id);
+    /**
+     * @brief Attaches a listener previously detached from another mixer with take_listener().
+     * @param listener_id The ID of the listener.
+     * @param sender The already set up network sender.
+     */
+    void adopt_listener(const std::string& listener_id, std::unique_ptr<INetworkSender> sender);
+
+    /**
+     * @brief Sends this mixer's output to another sink's destination as well.
+     * @details Sinks with identical inputs and output format are served by one mixer. The
+     *          member sink gets its own network sender, built from @p member_config with this
+     *          mixer's effective output format, and receives every payload chunk sent here.
+     * @param member_config Configuration of the member sink (id and destination are used).
+     * @return true if the sender was created and set up, false otherwise.
+     */
+    bool add_mirror_sink(SinkMixerConfig member_config);
+    /**
+     * @brief Stops sending this mixer's output to a member sink's destination.
+     * @param sink_id The ID of the member sink.
+     */
+    void remove_mirror_sink(const std::string& sink_id);
+    /** @brief Gets the IDs of member sinks currently fed by this mixer. */
+    std::vector<std::string> get_mirror_sink_ids() const;
 
     /**
      * @brief Retrieves the current statistics from the mixer.
@@ -185,6 +228,29 @@ public:
      * @return PipelineState containing hardware and mixer queue levels.
      */
     PipelineState get_pipeline_state() const;
+
+    /**
+     * @brief Starts the mixer without its mix or MP3 threads, for callers that own the clock.
+     * @details Requires a utils::VirtualClock to be installed, so the ClockManager created
+     *          here leaves ticking to run_due_ticks(). Used by the offline renderer to run the
+     *          real mix, rate control and output conversion faster than real time.
+     * @return false if no virtual clock is installed or startup fails.
+     */
+    bool start_driven();
+
+    /**
+     * @brief Runs one mix cycle for every clock tick due at utils::AudioClock::now().
+     * @details Only meaningful after start_driven().
+     * @return Number of mix cycles run.
+     */
+    std::size_t run_due_ticks();
+
+    /**
+     * @brief Replaces the primary output sender.
+     * @details Must be called before the mixer is started, e.g. to capture a driven mixer's
+     *          output with the "web_receiver" protocol, which creates no sender of its own.
+     */
+    void set_output_sender(std::unique_ptr<INetworkSender> sender);
  
  protected:
      /** @brief The main processing loop for the mixer thread. */
@@ -203,11 +269,14 @@ private:
     // Helper classes for modular functionality
     std::unique_ptr<Mp3Encoder> mp3_encoder_;
     std::unique_ptr<ListenerDispatcher> listener_dispatcher_;
+    std::map<std::string, std::unique_ptr<INetworkSender>> mirror_senders_;
+    mutable std::mutex mirror_senders_mutex_;
     std::unique_ptr<SinkRateController> rate_controller_;
 
     ReadyRingMap ready_rings_;
     std::mutex queues_mutex_;
     std::map<std::string, SourceInputProcessor*> source_processors_;
+    std::map<std::string, std::shared_ptr<ProcessedChunkRing>> dedup_chunk_rings_;
 
     std::map<std::string, bool> input_active_state_;
     std::map<std::string, ProcessedAudioChunk> source_buffers_;
@@ -241,6 +310,9 @@ private:
     std::unique_ptr<AudioProcessor> output_post_processor_;
     std::vector<int32_t> output_post_buffer_;
     std::mutex output_processor_mutex_;
+    /** @brief Resampler time accumulated by output post-processors replaced on format changes. */
+    uint64_t retired_resampler_cpu_ns_{0};
+    std::atomic<uint64_t> silent_inputs_skipped_{0};
     std::atomic<double> output_playback_rate_{1.0};
     
     // Hardware buffer state from ALSA/WASAPI for unified rate control
@@ -253,11 +325,13 @@ private:
     size_t payload_buffer_read_pos_ = 0;
     size_t payload_buffer_fill_bytes_ = 0;
     std::vector<uint8_t> payload_chunk_temp_;
+    size_t direct_frames_written_ = 0; ///< Frames downscale_direct() committed to the device this tick.
     std::vector<int32_t> last_sample_frame_;
     bool last_sample_valid_ = false;
     
     std::vector<uint32_t> current_csrcs_;
     std::mutex csrc_mutex_;
+    std::vector<uint32_t> mix_csrcs_scratch_; ///< Reused by mix_buffers() so mixing does not allocate.
 
     lame_t lame_global_flags_ = nullptr;  // TODO: Remove after full Mp3Encoder integration
     std::unique_ptr<AudioProcessor> stereo_preprocessor_;
@@ -306,6 +380,8 @@ private:
     bool wait_for_source_data();
     void mix_buffers();
     void downscale_buffer();
+    bool downscale_direct(const int32_t* samples, size_t sample_count, int bit_depth);
+    void record_send_gap(std::chrono::steady_clock::time_point send_time);
     size_t preprocess_for_listeners_and_mp3();
     void dispatch_to_listeners(size_t samples_to_dispatch);
     void enqueue_mp3_pcm(const int32_t* samples, size_t sample_count);
@@ -313,7 +389,9 @@ private:
     void cleanup_closed_listeners();
     void clear_pending_audio();
     void start_async();
-    bool start_internal();
+    bool start_internal(bool spawn_threads = true);
+    /** @brief One iteration of run() after its tick; returns false when the mixer is stopping. */
+    bool run_mix_cycle();
     void join_startup_thread();
     // --- Profiling ---
     void reset_profiler_counters();
@@ -375,25 +453,6 @@ private:
     std::map<std::string, uint64_t> profiling_source_underruns_;
     std::map<std::string, size_t> input_queue_high_water_;
 
-    // Buffer drain control members
-    std::atomic<double> smoothed_buffer_level_ms_{0.0};
-    std::chrono::steady_clock::time_point last_drain_check_;
-    std::mutex drain_control_mutex_;
-    std::unordered_map<std::string, double> per_source_smoothed_buffer_ms_;
-    std::unordered_map<std::string, double> source_last_rate_command_;
-
-    struct InputBufferMetrics {
-        double total_ms = 0.0;
-        double avg_per_source_ms = 0.0;
-        double max_per_source_ms = 0.0;
-        std::size_t queued_blocks = 0;
-        std::size_t active_sources = 0;
-        double block_duration_ms = 0.0;
-        bool valid = false;
-        std::map<std::string, std::size_t> per_source_blocks;
-        std::map<std::string, double> per_source_ms;
-    };
-
     void set_playback_format(int sample_rate, int channels, int bit_depth);
     void update_playback_format_from_sender();
     void setup_output_post_processor();
@@ -402,13 +461,17 @@ private:
     void register_mix_timer();
     void unregister_mix_timer();
     bool wait_for_mix_tick();
+    bool wait_for_device_tick(std::chrono::steady_clock::time_point deadline);
 
-    // Buffer drain control methods
+    // Buffer drain control methods; the policy lives in rate_controller_.
     void update_drain_ratio();
     InputBufferMetrics compute_input_buffer_metrics();
-    void dispatch_drain_adjustments(const InputBufferMetrics& metrics, double alpha);
-    double calculate_drain_ratio_for_level(double buffer_ms, double block_duration_ms) const;
     void send_playback_rate_command(const std::string& instance_id, double ratio);
+
+    /** @brief Appends produced chunks to an input's ready queue, trimming backlog. Caller holds queues_mutex_. */
+    void enqueue_processed_chunks_locked(const std::string& instance_id,
+                                         std::vector<ProcessedAudioChunk>& produced,
+                                         std::size_t max_queued_chunks);
 };
 
 } // namespace audio
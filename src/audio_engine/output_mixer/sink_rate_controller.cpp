@@ -5,6 +5,7 @@
 #include "sink_rate_controller.h"
 #include "../utils/cpp_logger.h"
 #include "../utils/profiler.h"
+#include "../utils/audio_clock.h"
 #include <algorithm>
 #include <cmath>
 
@@ -15,7 +16,7 @@ SinkRateController::SinkRateController(const std::string& sink_id,
                                        std::shared_ptr<AudioEngineSettings> settings)
     : sink_id_(sink_id),
       settings_(settings),
-      last_drain_check_(std::chrono::steady_clock::now())
+      last_drain_check_(utils::AudioClock::now())
 {
 }
 
@@ -26,7 +27,7 @@ void SinkRateController::set_rate_command_callback(RateCommandCallback callback)
 void SinkRateController::update_drain_ratio(int sample_rate, std::size_t frames_per_chunk,
                                             std::function<InputBufferMetrics()> get_metrics) {
     PROFILE_FUNCTION();
-    auto now = std::chrono::steady_clock::now();
+    auto now = utils::AudioClock::now();
     
     if (!settings_) {
         return;
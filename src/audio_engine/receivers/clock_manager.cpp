@@ -4,6 +4,7 @@
 #include <cerrno>
 #include <optional>
 #include <stdexcept>
+#include "../utils/audio_clock.h"
 #include "../utils/thread_priority.h"
 
 #if defined(__linux__)
@@ -300,9 +301,14 @@ std::unique_ptr<ClockManager::PlatformTimer> create_platform_timer() {
 }
 
 ClockManager::ClockManager(std::size_t chunk_size_bytes)
-    : platform_timer_(create_platform_timer()),
-      chunk_size_bytes_(sanitize_chunk_size_bytes(chunk_size_bytes)) {
-    worker_thread_ = std::thread([this]() { run(); });
+    : platform_timer_(utils::AudioClock::is_virtual() ? nullptr : create_platform_timer()),
+      chunk_size_bytes_(sanitize_chunk_size_bytes(chunk_size_bytes)),
+      manual_ticks_(utils::AudioClock::is_virtual()) {
+    // Under a virtual clock wall-clock timers would fire at the wrong rate; the owner
+    // drives ticks through fire_due_ticks() instead.
+    if (!manual_ticks_) {
+        worker_thread_ = std::thread([this]() { run(); });
+    }
 }
 
 ClockManager::~ClockManager() {
@@ -574,6 +580,59 @@ void ClockManager::run() {
     }
 }
 
+std::size_t ClockManager::fire_due_ticks() {
+    if (!manual_ticks_) {
+        return 0;
+    }
+
+    struct DueClock {
+        std::vector<std::shared_ptr<ConditionEntry>> conditions;
+        std::uint64_t ticks = 0;
+    };
+    std::vector<DueClock> due;
+    std::size_t fired = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto now = utils::AudioClock::now();
+        for (auto it = clock_entries_.begin(); it != clock_entries_.end();) {
+            cleanup_inactive_conditions(it->second);
+            if (it->second.conditions.empty()) {
+                it = clock_entries_.erase(it);
+                continue;
+            }
+            auto& entry = it->second;
+            std::uint64_t ticks = 0;
+            while (entry.next_fire <= now) {
+                entry.next_fire += entry.period;
+                ++ticks;
+            }
+            if (ticks > 0) {
+                due.push_back(DueClock{entry.conditions, ticks});
+                fired += static_cast<std::size_t>(ticks);
+            }
+            ++it;
+        }
+    }
+
+    for (const auto& clock : due) {
+        for (const auto& cond_entry : clock.conditions) {
+            if (!cond_entry || !cond_entry->active.load(std::memory_order_acquire)) {
+                continue;
+            }
+            if (auto condition_state = cond_entry->condition.lock()) {
+                {
+                    std::lock_guard<std::mutex> condition_lock(condition_state->mutex);
+                    condition_state->sequence += clock.ticks;
+                }
+                condition_state->cv.notify_all();
+            } else {
+                cond_entry->active.store(false, std::memory_order_release);
+            }
+        }
+    }
+    return fired;
+}
+
 ClockManager::ConditionHandle ClockManager::register_clock_condition(
     int sample_rate,
     int channels,
@@ -595,7 +654,7 @@ ClockManager::ConditionHandle ClockManager::register_clock_condition(
         auto& entry = clock_entries_[key];
         if (entry.period.count() == 0) {
             entry.period = period;
-            entry.next_fire = std::chrono::steady_clock::now() + period;
+            entry.next_fire = utils::AudioClock::now() + period;
         }
         entry.conditions.push_back(std::move(condition_entry));
         if (platform_timer_) {
@@ -56,6 +56,28 @@ public:
     ConditionHandle register_clock_condition(int sample_rate, int channels, int bit_depth);
     void unregister_clock_condition(const ConditionHandle& handle);
 
+    /**
+     * @brief Tick period for one chunk of the given format.
+     * @details Exposed so components that run their own timers (the Pulse receiver's event
+     *          loops) pace chunks exactly like registered conditions would.
+     * @throws std::invalid_argument for a non-positive rate/channel count or a bit depth that
+     *         is not a multiple of 8.
+     */
+    std::chrono::nanoseconds calculate_period(int sample_rate, int channels, int bit_depth) const;
+
+    /**
+     * @brief Fires every tick that is due at utils::AudioClock::now().
+     * @details A ClockManager constructed while a VirtualClock is installed starts no timer
+     *          thread; its owner advances the virtual clock and calls this instead. Each
+     *          elapsed period bumps its conditions' sequence once, so nothing is skipped.
+     *          Does nothing on a manager that runs its own thread.
+     * @return Number of periods fired across all clocks.
+     */
+    std::size_t fire_due_ticks();
+
+    /** @brief True when ticks are produced by fire_due_ticks() rather than a timer thread. */
+    bool is_manually_ticked() const { return manual_ticks_; }
+
 private:
     struct ConditionEntry {
         std::uint64_t id = 0;
@@ -70,7 +92,6 @@ private:
         std::vector<std::shared_ptr<ConditionEntry>> conditions;
     };
 
-    std::chrono::nanoseconds calculate_period(int sample_rate, int channels, int bit_depth) const;
     bool has_active_conditions(const ClockEntry& entry) const;
     void cleanup_inactive_conditions(ClockEntry& entry);
     void run();
@@ -83,6 +104,7 @@ private:
     std::atomic<bool> stop_requested_{false};
     std::atomic<std::uint64_t> next_condition_id_{1};
     const std::size_t chunk_size_bytes_;
+    const bool manual_ticks_;
 };
 
 } // namespace audio
@@ -4,6 +4,7 @@
 #include "../utils/cpp_logger.h"
 #include "../utils/thread_priority.h"
 #include "../utils/sentinel_logging.h"
+#include "../utils/span_tracer.h"
 #include <iostream>      // For logging (cpp_logger fallb_ack)
 #include <vector>
 #include <cstring>       // For memset
@@ -292,32 +293,7 @@ void NetworkAudioReceiver::run() {
                 continue;
             }
 
-            if (is_valid_packet_structure(receive_buffer.data(), bytes_received, client_addr)) {
-                TaggedAudioPacket packet;
-                std::string source_tag;
-                auto received_time = std::chrono::steady_clock::now();
-
-                bool valid_payload = process_and_validate_payload(receive_buffer.data(),
-                                                                   bytes_received,
-                                                                   client_addr,
-                                                                   received_time,
-                                                                   packet,
-                                                                   source_tag);
-
-                if (!source_tag.empty() && register_source_tag(source_tag)) {
-                    log_message("New source detected: " + source_tag);
-                }
-
-                if (valid_payload) {
-                    dispatch_ready_packet(std::move(packet));
-                } else {
-                    // process_and_validate_payload should log specific reasons for failure
-                    // log_warning("Failed to process/validate payload from " + std::string(inet_ntoa(client_addr.sin_addr)));
-                }
-            } else {
-                // is_valid_packet_structure might log, or we can log generically here
-                // log_warning("Received invalid packet structure from " + std::string(inet_ntoa(client_addr.sin_addr)));
-            }
+            handle_datagram(receive_buffer.data(), bytes_received, client_addr, std::chrono::steady_clock::now());
             on_after_poll_iteration();
         } else if (fds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) {
              // Socket error occurred
@@ -334,6 +310,50 @@ void NetworkAudioReceiver::run() {
     log_message("Receiver thread exiting run loop.");
 }
 
+void NetworkAudioReceiver::inject_datagram(const uint8_t* buffer,
+                                           int size,
+                                           const struct sockaddr_in& client_addr,
+                                           std::chrono::steady_clock::time_point received_time) {
+    if (!buffer || size <= 0) {
+        return;
+    }
+    const int limit = static_cast<int>(std::min<size_t>(get_receive_buffer_size(),
+                                                        static_cast<size_t>(std::numeric_limits<int>::max())));
+    handle_datagram(buffer, std::min(size, limit), client_addr, received_time);
+}
+
+void NetworkAudioReceiver::handle_datagram(const uint8_t* buffer,
+                                           int size,
+                                           const struct sockaddr_in& client_addr,
+                                           std::chrono::steady_clock::time_point received_time) {
+    if (!is_valid_packet_structure(buffer, size, client_addr)) {
+        // is_valid_packet_structure might log, or we can log generically here
+        return;
+    }
+
+    // The flow starts here so a trace links the datagram's arrival to everything downstream.
+    const uint64_t flow_id = utils::SpanTracer::instance().next_flow_id();
+    SR_TRACE_SPAN_FLOW("receive", flow_id);
+    TaggedAudioPacket packet;
+    std::string source_tag;
+    bool valid_payload = process_and_validate_payload(buffer,
+                                                       size,
+                                                       client_addr,
+                                                       received_time,
+                                                       packet,
+                                                       source_tag);
+
+    if (!source_tag.empty() && register_source_tag(source_tag)) {
+        log_message("New source detected: " + source_tag);
+    }
+
+    if (valid_payload) {
+        packet.trace_flow_id = flow_id;
+        dispatch_ready_packet(std::move(packet));
+    }
+    // process_and_validate_payload should log specific reasons for failure
+}
+
 void NetworkAudioReceiver::dispatch_ready_packet(TaggedAudioPacket&& packet) {
     if (!timeshift_manager_) {
         log_error("TimeshiftManager is null. Cannot add packet for source: " + packet.source_tag);
@@ -398,8 +418,10 @@ void NetworkAudioReceiver::dispatch_ready_packet(TaggedAudioPacket&& packet) {
         if (!packet.ssrcs.empty()) {
             acc.ssrcs = packet.ssrcs;
         }
-        if (!acc.base_rtp_timestamp && packet.rtp_timestamp.has_value()) {
-            acc.base_rtp_timestamp = packet.rtp_timestamp;
+        if (!acc.base_rtp_timestamp) {
+            // Scream datagrams carry no timestamp, and TimeshiftManager drops untimed packets,
+            // so their chunks are numbered by frame count from zero.
+            acc.base_rtp_timestamp = packet.rtp_timestamp.value_or(0);
             acc.frame_cursor = 0;
         }
 
@@ -431,6 +453,8 @@ void NetworkAudioReceiver::dispatch_ready_packet(TaggedAudioPacket&& packet) {
             out.ingress_from_loopback = packet.ingress_from_loopback;
             out.rtp_sequence_number = packet.rtp_sequence_number;
             out.is_sentinel = packet.is_sentinel;
+            // Like processed chunks, an assembled chunk follows the datagram that completed it.
+            out.trace_flow_id = packet.trace_flow_id;
 
             const std::size_t chunk_frames = (acc.bytes_per_frame > 0) ? (popped / acc.bytes_per_frame) : 0;
 
@@ -98,6 +98,20 @@ public:
      */
     std::vector<std::string> get_seen_tags();
 
+    /**
+     * @brief Feeds a datagram through the same path as one read from the socket.
+     * @details Used by PcapReplayReceiver. Payloads larger than get_receive_buffer_size()
+     *          are truncated, as recvfrom() would. May be called while the receiver thread runs.
+     * @param buffer Pointer to the UDP payload.
+     * @param size Size of the payload in bytes.
+     * @param client_addr The address the datagram appears to come from.
+     * @param received_time The arrival time to stamp on the packet.
+     */
+    void inject_datagram(const uint8_t* buffer,
+                         int size,
+                         const struct sockaddr_in& client_addr,
+                         std::chrono::steady_clock::time_point received_time);
+
 protected:
     /** @brief The main processing loop for the receiver thread. */
     void run() override;
@@ -137,6 +151,17 @@ protected:
         std::string& out_source_tag
     ) = 0;
 
+    /**
+     * @brief Handles one received datagram: validation, parsing and dispatch.
+     * @details The default runs is_valid_packet_structure(), process_and_validate_payload()
+     *          and dispatch_ready_packet(). Receivers with their own per-datagram pipeline
+     *          (RTP reordering) override it.
+     */
+    virtual void handle_datagram(const uint8_t* buffer,
+                                 int size,
+                                 const struct sockaddr_in& client_addr,
+                                 std::chrono::steady_clock::time_point received_time);
+
     /**
      * @brief Called when a packet has been validated and is ready for dispatch.
      * @param packet The packet to dispatch.
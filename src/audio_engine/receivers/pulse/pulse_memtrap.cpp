@@ -0,0 +1,147 @@
+#include "pulse_memtrap.h"
+
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(WIN32)
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <mutex>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace screamrouter {
+namespace audio {
+namespace pulse {
+
+namespace {
+
+// One registered range. Writers hold g_slots_mutex and bump seq to odd while they change
+// start/size; the signal handler only reads, retrying while seq is odd or changes under it.
+struct TrapSlot {
+    std::atomic<uint32_t> seq{0};
+    std::atomic<uintptr_t> start{0}; ///< 0 for a free slot.
+    std::atomic<std::size_t> size{0};
+    std::atomic<bool> bad{false};
+};
+
+std::array<TrapSlot, MemTrap::kMaxTraps> g_slots;
+std::mutex g_slots_mutex;
+std::once_flag g_install_once;
+struct sigaction g_previous_action {};
+
+static_assert(std::atomic<uintptr_t>::is_always_lock_free, "signal handler needs lock-free atomics");
+static_assert(std::atomic<std::size_t>::is_always_lock_free, "signal handler needs lock-free atomics");
+
+void write_slot(TrapSlot& slot, uintptr_t start, std::size_t size) {
+    slot.seq.fetch_add(1, std::memory_order_acq_rel);
+    slot.start.store(start, std::memory_order_release);
+    slot.size.store(size, std::memory_order_release);
+    slot.seq.fetch_add(1, std::memory_order_acq_rel);
+}
+
+// Consistent snapshot of a slot, or false if it is free or kept changing.
+bool read_slot(const TrapSlot& slot, uintptr_t& start, std::size_t& size) {
+    for (int attempt = 0; attempt < 16; ++attempt) {
+        const uint32_t before = slot.seq.load(std::memory_order_acquire);
+        if (before & 1u) {
+            continue;
+        }
+        start = slot.start.load(std::memory_order_acquire);
+        size = slot.size.load(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_acquire) == before) {
+            return start != 0;
+        }
+    }
+    return false;
+}
+
+void forward_to_previous(int sig, siginfo_t* info, void* context) {
+    if ((g_previous_action.sa_flags & SA_SIGINFO) != 0 && g_previous_action.sa_sigaction) {
+        g_previous_action.sa_sigaction(sig, info, context);
+        return;
+    }
+    if (g_previous_action.sa_handler != SIG_DFL && g_previous_action.sa_handler != SIG_IGN) {
+        g_previous_action.sa_handler(sig);
+        return;
+    }
+    // Restore the default action; returning re-executes the faulting access, which now
+    // terminates the process as if no trap had been installed.
+    struct sigaction dfl {};
+    dfl.sa_handler = SIG_DFL;
+    sigemptyset(&dfl.sa_mask);
+    ::sigaction(SIGBUS, &dfl, nullptr);
+}
+
+void sigbus_handler(int sig, siginfo_t* info, void* context) {
+    const uintptr_t fault = reinterpret_cast<uintptr_t>(info ? info->si_addr : nullptr);
+    for (auto& slot : g_slots) {
+        uintptr_t start = 0;
+        std::size_t size = 0;
+        if (!read_slot(slot, start, size) || fault < start || fault >= start + size) {
+            continue;
+        }
+        // Swap the whole range for private zero pages so the read that faulted, and any later
+        // one, completes. mmap() is not on the async-signal-safe list, but it is a plain
+        // syscall on Linux; PulseAudio's own memtrap relies on the same thing.
+        const int saved_errno = errno;
+        void* replaced = ::mmap(reinterpret_cast<void*>(start), size, PROT_READ,
+                                MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        errno = saved_errno;
+        if (replaced == MAP_FAILED) {
+            break;
+        }
+        slot.bad.store(true, std::memory_order_release);
+        return;
+    }
+    forward_to_previous(sig, info, context);
+}
+
+void install_handler() {
+    struct sigaction action {};
+    action.sa_sigaction = sigbus_handler;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    ::sigaction(SIGBUS, &action, &g_previous_action);
+}
+
+} // namespace
+
+std::unique_ptr<MemTrap> MemTrap::add(const void* start, std::size_t size) {
+    if (!start || size == 0) {
+        return nullptr;
+    }
+    std::call_once(g_install_once, install_handler);
+
+    // Faults are reported per page, so cover the mapping up to its last page boundary.
+    const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t mapped_size = (size + page - 1) / page * page;
+
+    std::lock_guard<std::mutex> lock(g_slots_mutex);
+    for (std::size_t i = 0; i < g_slots.size(); ++i) {
+        if (g_slots[i].start.load(std::memory_order_relaxed) != 0) {
+            continue;
+        }
+        g_slots[i].bad.store(false, std::memory_order_relaxed);
+        write_slot(g_slots[i], reinterpret_cast<uintptr_t>(start), mapped_size);
+        return std::unique_ptr<MemTrap>(new MemTrap(i));
+    }
+    return nullptr;
+}
+
+MemTrap::~MemTrap() {
+    std::lock_guard<std::mutex> lock(g_slots_mutex);
+    write_slot(g_slots[slot_], 0, 0);
+}
+
+bool MemTrap::is_good() const {
+    return !g_slots[slot_].bad.load(std::memory_order_acquire);
+}
+
+} // namespace pulse
+} // namespace audio
+} // namespace screamrouter
+
+#endif // !_WIN32
@@ -0,0 +1,58 @@
+#ifndef SCREAMROUTER_AUDIO_PULSE_PULSE_MEMTRAP_H
+#define SCREAMROUTER_AUDIO_PULSE_PULSE_MEMTRAP_H
+
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(WIN32)
+
+#include <cstddef>
+#include <memory>
+
+namespace screamrouter {
+namespace audio {
+namespace pulse {
+
+/**
+ * @brief Guards a shared mapping that its owner may truncate, after pulsecore/memtrap.c.
+ * @details A client mempool is mapped MAP_SHARED so memblocks can be read in place. libpulse
+ *          creates the memfd with MFD_ALLOW_SEALING but never seals it, so the client can
+ *          ftruncate() it while it is mapped here, and reading past the new end raises SIGBUS.
+ *
+ *          While a MemTrap exists, a process-wide SIGBUS handler recognizes faults inside its
+ *          range. It replaces the whole range with anonymous zero pages, so the faulting read
+ *          and every later read return silence, and marks the trap bad. Faults anywhere else
+ *          go to the previously installed handler, or kill the process as before.
+ *
+ *          Check is_good() after reading: once a trap has fired, the pool's contents are gone.
+ */
+class MemTrap {
+public:
+    /**
+     * @brief Registers [start, start + size) and installs the SIGBUS handler on first use.
+     * @return nullptr when every trap slot is in use.
+     */
+    static std::unique_ptr<MemTrap> add(const void* start, std::size_t size);
+
+    /// Unregisters the range. Unmap it only after the trap is gone.
+    ~MemTrap();
+
+    MemTrap(const MemTrap&) = delete;
+    MemTrap& operator=(const MemTrap&) = delete;
+
+    /// False once a SIGBUS inside the range was trapped.
+    bool is_good() const;
+
+    /// Number of ranges that can be registered at once, across all connections.
+    static constexpr std::size_t kMaxTraps = 256;
+
+private:
+    explicit MemTrap(std::size_t slot) : slot_(slot) {}
+
+    std::size_t slot_;
+};
+
+} // namespace pulse
+} // namespace audio
+} // namespace screamrouter
+
+#endif // !_WIN32
+
+#endif // SCREAMROUTER_AUDIO_PULSE_PULSE_MEMTRAP_H
@@ -43,7 +43,9 @@ void PulseAudioReceiver::run() {}
 
 #else // POSIX build
 
+#include "pulse_memtrap.h"
 #include "pulse_message.h"
+#include "pulse_srbchannel.h"
 #include "pulse_tagstruct.h"
 
 #include "../../input_processor/timeshift_manager.h"
@@ -75,7 +77,6 @@ void PulseAudioReceiver::run() {}
 #include <random>
 #include <thread>
 
-#include "../../audio_processor/audio_processor.h"
 #include "../../configuration/audio_engine_settings.h"
 
 #include <cerrno>
@@ -84,6 +85,8 @@ void PulseAudioReceiver::run() {}
 
 #include <fcntl.h>
 #include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -91,6 +94,7 @@ void PulseAudioReceiver::run() {}
 #include <sys/uio.h>
 #include <sys/mman.h>
 #include <sys/time.h>
+#include <sys/timerfd.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <netdb.h>
@@ -104,6 +108,14 @@ namespace pulse {
 namespace {
 
 constexpr uint32_t kMaxConnections = 64;
+constexpr int kMaxEventLoops = 16;
+constexpr int kMaxEpollEvents = 64;
+// epoll_event::data.u64 carries (connection id << 2) | watch kind.
+constexpr uint64_t kWatchSocket = 0;
+constexpr uint64_t kWatchSrbChannel = 1;
+constexpr uint64_t kWatchWake = 2;
+constexpr uint64_t kWatchTimer = 3;
+constexpr uint64_t kWatchKindMask = 3;
 constexpr uint32_t kVirtualSinkIndex = 0;
 constexpr const char* kVirtualSinkName = "screamrouter.pulse";
 constexpr const char* kVirtualSinkDescription = "ScreamRouter";
@@ -142,6 +154,8 @@ constexpr size_t kShmInfoBlockIdIndex = 0;
 constexpr size_t kShmInfoShmIdIndex = 1;
 constexpr size_t kShmInfoOffsetIndex = 2;
 constexpr size_t kShmInfoLengthIndex = 3;
+constexpr uint32_t kSrbChannelMinVersion = 30;
+constexpr uint32_t kSrbChannelBlockId = 1; // Only block this connection ever exports.
 constexpr uint32_t kUpdateSet = 0;
 constexpr uint32_t kUpdateMerge = 1;
 constexpr uint32_t kUpdateReplace = 2;
@@ -220,6 +234,7 @@ const char* command_name(Command c) {
         case Command::RemoveClientProplist: return "RemoveClientProplist";
         case Command::Request: return "Request";
         case Command::RegisterMemfdShmid: return "RegisterMemfdShmid";
+        case Command::EnableSrbChannel: return "EnableSrbChannel";
         case Command::PlaybackStreamEvent: return "PlaybackStreamEvent";
         case Command::Started: return "Started";
         case Command::Exit: return "Exit";
@@ -435,29 +450,41 @@ std::pair<uint8_t, uint8_t> guess_channel_layout(const ChannelMap& map) {
     return {0x00, 0x00};
 }
 
-std::vector<uint8_t> convert_float_chunk_to_s32(const std::vector<uint8_t>& chunk) {
-    const size_t samples = chunk.size() / sizeof(float);
-    std::vector<uint8_t> converted(chunk.size());
-    const float* input = reinterpret_cast<const float*>(chunk.data());
-    int32_t* output = reinterpret_cast<int32_t*>(converted.data());
-    constexpr double kScale = 32767.0;
-    for (size_t i = 0; i < samples; ++i) {
-        double clamped = std::clamp(static_cast<double>(input[i]), -1.0, 1.0);
-        int32_t sample16 = static_cast<int32_t>(clamped * kScale);
-        output[i] = sample16 << 16;
+// Float32 -> S32 at full 32-bit resolution. src and dst may alias (same sample width); samples
+// go through memcpy because memblock offsets carry no alignment guarantee.
+void convert_float_to_s32(const uint8_t* src, std::size_t bytes, uint8_t* dst) {
+    constexpr double kScale = 2147483647.0;
+    const std::size_t samples = bytes / sizeof(float);
+    for (std::size_t i = 0; i < samples; ++i) {
+        float value = 0.0f;
+        std::memcpy(&value, src + i * sizeof(float), sizeof(float));
+        const double clamped = std::isnan(value) ? 0.0 : std::clamp(static_cast<double>(value), -1.0, 1.0);
+        const int32_t sample = static_cast<int32_t>(clamped * kScale);
+        std::memcpy(dst + i * sizeof(int32_t), &sample, sizeof(int32_t));
     }
-    return converted;
 }
 
 } // namespace
 
 struct PulseAudioReceiver::Impl {
     struct Connection;
-    struct ConnectionContext {
-        std::shared_ptr<Connection> connection;
+
+    // One thread multiplexing many connections. Sockets and srbchannel eventfds are watched with
+    // epoll; clock ticks and deferred REQUESTs are driven by a single timerfd armed to the
+    // earliest deadline of any stream on the loop.
+    struct EventLoop {
+        std::size_t index = 0;
+        int epoll_fd = -1;
+        int wake_fd = -1;
+        int timer_fd = -1;
+        std::chrono::steady_clock::time_point timer_deadline{};
         std::thread worker;
         std::atomic<bool> stop{false};
-        std::atomic<bool> finished{false};
+        std::atomic<std::size_t> load{0};
+        std::mutex incoming_mutex;
+        std::vector<std::shared_ptr<Connection>> incoming;
+        // Owned by the loop thread.
+        std::unordered_map<uint64_t, std::shared_ptr<Connection>> active;
     };
 
     PulseReceiverConfig config;
@@ -470,7 +497,10 @@ struct PulseAudioReceiver::Impl {
     int unix_listen_fd = -1;
     std::string unix_socket_path;
 
-    std::vector<std::unique_ptr<ConnectionContext>> connections;
+    std::vector<std::unique_ptr<EventLoop>> event_loops;
+    std::atomic<uint64_t> next_connection_id{1};
+    // Every live connection, whichever loop owns it; used for the connection limit and telemetry.
+    std::vector<std::shared_ptr<Connection>> connections;
     std::mutex connections_mutex;
     std::vector<std::string> seen_tags;
     std::unordered_set<std::string> known_tags;
@@ -491,14 +521,19 @@ struct PulseAudioReceiver::Impl {
 
     bool initialize();
     void shutdown_all();
+    bool start_event_loops();
     void stop_all_connections();
-    void prune_finished_connections();
 
     void event_loop(std::atomic<bool>& stop_flag);
     void maybe_log_telemetry();
 
-    void accept_connections(int listen_fd, bool is_unix, std::atomic<bool>& global_stop);
-    void start_connection_thread(std::unique_ptr<Connection> conn, std::atomic<bool>& global_stop);
+    void accept_connections(int listen_fd, bool is_unix);
+    void assign_connection(std::unique_ptr<Connection> conn);
+    void run_event_loop(EventLoop& loop);
+    void adopt_incoming(EventLoop& loop);
+    void update_watches(EventLoop& loop, Connection& conn);
+    void arm_loop_timer(EventLoop& loop, std::optional<std::chrono::steady_clock::time_point> deadline);
+    void close_connection(EventLoop& loop, uint64_t id);
 
     void log(const std::string& msg) const {
         LOG_CPP_INFO("%s %s", logger_prefix.c_str(), msg.c_str());
@@ -622,8 +657,16 @@ struct PulseAudioReceiver::Impl::Connection {
     bool client_named = false;
     uint32_t negotiated_version = 13;
 
+    // Frames that carry file descriptors always go over the socket; the fds are borrowed and
+    // stay owned by whoever enqueued them.
+    struct OutgoingFrame {
+        std::vector<uint8_t> bytes;
+        std::vector<int> fds;
+        std::size_t size() const { return bytes.size(); }
+    };
+
     std::vector<uint8_t> read_buffer;
-    std::deque<std::vector<uint8_t>> write_queue;
+    std::deque<OutgoingFrame> write_queue;
     mutable std::mutex write_queue_mutex;
     mutable std::mutex stream_mutex;
 
@@ -686,8 +729,9 @@ struct PulseAudioReceiver::Impl::Connection {
         std::chrono::steady_clock::time_point last_catchup_log{};
         ProfilingData profile;
         std::deque<PendingChunk> pending_chunks;
-        ClockManager::ConditionHandle clock_handle;
-        uint64_t clock_last_sequence = 0;
+        // Chunk pacing; clock_period is zero while the stream has no clock.
+        std::chrono::nanoseconds clock_period{0};
+        std::chrono::steady_clock::time_point next_clock_tick{};
         uint32_t samples_per_chunk = 0;
         std::size_t chunk_bytes = 0;
         std::size_t bytes_since_request = 0;
@@ -701,9 +745,39 @@ struct PulseAudioReceiver::Impl::Connection {
         bool has_rtp_frame = false;
     };
 
+    // Client mempool, mapped read-only so memblocks are read in place as PulseAudio's own server
+    // does. libpulse never seals the memfd against shrinking, so the mapping is covered by a
+    // MemTrap: a client truncating it turns the pages into zeros instead of a process-wide SIGBUS.
     struct MemfdPool {
         int fd = -1;
         off_t size = 0;
+        const uint8_t* base = nullptr;
+        std::unique_ptr<MemTrap> trap; ///< Must go before the mapping does.
+
+        MemfdPool() = default;
+        MemfdPool(MemfdPool&& other) noexcept
+            : fd(std::exchange(other.fd, -1)),
+              size(other.size),
+              base(std::exchange(other.base, nullptr)),
+              trap(std::move(other.trap)) {}
+        MemfdPool& operator=(MemfdPool&&) = delete;
+        MemfdPool(const MemfdPool&) = delete;
+        MemfdPool& operator=(const MemfdPool&) = delete;
+        ~MemfdPool() { release(); }
+
+        bool is_good() const { return trap && trap->is_good(); }
+
+        void release() {
+            trap.reset();
+            if (base) {
+                ::munmap(const_cast<uint8_t*>(base), static_cast<size_t>(size));
+                base = nullptr;
+            }
+            if (fd >= 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
     };
 
     std::unordered_map<uint32_t, StreamState> streams;
@@ -716,6 +790,20 @@ struct PulseAudioReceiver::Impl::Connection {
     bool use_memfd = false;
     bool non_registered_memfd_error_logged = false;
 
+    // srbchannel: offered after AUTH; frames are read from it as soon as it exists, and written
+    // to it once the client has acknowledged ENABLE_SRBCHANNEL.
+    std::unique_ptr<SrbChannel> srbchannel;
+    std::vector<uint8_t> srb_read_buffer;
+    uint32_t srb_setup_tag = 0;
+    bool srb_pending = false;
+    bool srb_write_enabled = false;
+
+    // Event-loop bookkeeping, touched only by the owning loop thread.
+    uint64_t loop_id = 0;
+    uint32_t watched_events = 0;
+    bool srb_watched = false;
+    bool srb_armed = false;
+
     explicit Connection(Impl* impl, int socket_fd, bool unix_socket)
         : owner(impl), fd(socket_fd), is_unix(unix_socket) {
         read_buffer.reserve(4096);
@@ -749,9 +837,7 @@ struct PulseAudioReceiver::Impl::Connection {
         }
 
         for (auto& entry : memfd_pools) {
-            if (entry.second.fd >= 0) {
-                ::close(entry.second.fd);
-            }
+            entry.second.release();
         }
         memfd_pools.clear();
         for (auto& fds : pending_fds) {
@@ -763,17 +849,24 @@ struct PulseAudioReceiver::Impl::Connection {
         }
     }
 
-    void run(std::atomic<bool>& global_stop, std::atomic<bool>& local_stop);
-    bool handle_io(short revents);
+    bool service(std::chrono::steady_clock::time_point now);
+    bool handle_io(uint32_t events);
     bool handle_read();
     bool handle_write();
+    bool handle_srb_read();
+    bool process_frames(std::vector<uint8_t>& buffer, bool socket_frames);
+    bool frame_uses_srbchannel(const OutgoingFrame& frame) const {
+        return srb_write_enabled && frame.fds.empty();
+    }
+    void setup_srbchannel();
+    bool handle_enable_srbchannel(uint32_t tag);
 
     bool process_message(Message& message);
     void apply_volume(StreamState& stream, std::vector<uint8_t>& audio_data) const;
     void handle_clock_tick(uint32_t stream_index);
     void unregister_stream_clock(StreamState& stream);
     void register_stream_clock(StreamState& stream);
-    void dispatch_clock_ticks();
+    void dispatch_clock_ticks(std::chrono::steady_clock::time_point now);
     uint32_t calculate_samples_per_chunk(const StreamState& stream) const;
     bool handle_command(Command command, uint32_t tag, const uint8_t* payload, size_t length, std::vector<int>& fds);
     bool handle_auth(uint32_t tag, TagReader& reader);
@@ -814,7 +907,7 @@ struct PulseAudioReceiver::Impl::Connection {
 
     std::string composite_tag_for_stream(const std::unordered_map<std::string, std::string>& proplist) const;
 
-    void enqueue_tagstruct(const TagWriter& writer);
+    void enqueue_tagstruct(const TagWriter& writer, std::vector<int> fds = {});
     void enqueue_simple_reply(uint32_t tag);
     void enqueue_error(uint32_t tag, uint32_t error_code);
     void enqueue_request(uint32_t stream_index, uint32_t bytes);
@@ -827,7 +920,7 @@ struct PulseAudioReceiver::Impl::Connection {
     uint32_t sample_format_bit_depth(uint8_t format) const;
     uint32_t effective_request_bytes(const StreamState& stream) const;
     void process_due_requests();
-    std::optional<std::chrono::steady_clock::time_point> next_due_request() const;
+    std::optional<std::chrono::steady_clock::time_point> next_wakeup() const;
     void record_chunk_metrics(StreamState& stream,
                               size_t chunk_bytes,
                               uint64_t frames,
@@ -841,10 +934,10 @@ struct PulseAudioReceiver::Impl::Connection {
                                   StreamState& stream,
                                   std::chrono::steady_clock::time_point now);
 
-    short desired_poll_events() const {
-        short events = POLLIN;
+    uint32_t desired_epoll_events() const {
+        uint32_t events = EPOLLIN;
         std::lock_guard<std::mutex> lock(write_queue_mutex);
-        if (!write_queue.empty()) events |= POLLOUT;
+        if (!write_queue.empty() && !frame_uses_srbchannel(write_queue.front())) events |= EPOLLOUT;
         return events;
     }
 };
@@ -977,7 +1070,7 @@ bool PulseAudioReceiver::Impl::initialize() {
         return false;
     }
 
-    return true;
+    return start_event_loops();
 }
 
 void PulseAudioReceiver::Impl::shutdown_all() {
@@ -996,48 +1089,63 @@ void PulseAudioReceiver::Impl::shutdown_all() {
     }
 }
 
-void PulseAudioReceiver::Impl::stop_all_connections() {
-    std::vector<std::unique_ptr<ConnectionContext>> to_join;
-    {
-        std::lock_guard<std::mutex> lock(connections_mutex);
-        for (auto& ctx : connections) {
-            if (ctx) {
-                ctx->stop.store(true);
+bool PulseAudioReceiver::Impl::start_event_loops() {
+    const int count = std::clamp(config.event_loop_threads, 1, kMaxEventLoops);
+    for (int i = 0; i < count; ++i) {
+        auto loop = std::make_unique<EventLoop>();
+        loop->index = static_cast<std::size_t>(i);
+        loop->epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+        loop->wake_fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        loop->timer_fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+        bool ok = loop->epoll_fd >= 0 && loop->wake_fd >= 0 && loop->timer_fd >= 0;
+        if (ok) {
+            epoll_event wake_ev{};
+            wake_ev.events = EPOLLIN;
+            wake_ev.data.u64 = kWatchWake;
+            epoll_event timer_ev{};
+            timer_ev.events = EPOLLIN;
+            timer_ev.data.u64 = kWatchTimer;
+            ok = ::epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, loop->wake_fd, &wake_ev) == 0 &&
+                 ::epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, loop->timer_fd, &timer_ev) == 0;
+        }
+        if (!ok) {
+            log_error("Failed to create PulseAudio event loop: " + errno_string(errno));
+            for (int fd : {loop->epoll_fd, loop->wake_fd, loop->timer_fd}) {
+                if (fd >= 0) {
+                    ::close(fd);
+                }
             }
+            return false;
         }
-        to_join.swap(connections);
-    }
-
-    for (auto& ctx : to_join) {
-        if (ctx && ctx->worker.joinable()) {
-            ctx->worker.join();
-        }
+        auto* loop_ptr = loop.get();
+        loop->worker = std::thread([this, loop_ptr]() { run_event_loop(*loop_ptr); });
+        event_loops.push_back(std::move(loop));
     }
+    log("Started " + std::to_string(count) + " PulseAudio event loop(s)");
+    return true;
 }
 
-void PulseAudioReceiver::Impl::prune_finished_connections() {
-    std::vector<std::unique_ptr<ConnectionContext>> remaining;
-    std::vector<std::unique_ptr<ConnectionContext>> finished;
-    {
-        std::lock_guard<std::mutex> lock(connections_mutex);
-        for (auto& ctx : connections) {
-            if (ctx && ctx->finished.load()) {
-                finished.push_back(std::move(ctx));
-            } else {
-                remaining.push_back(std::move(ctx));
-            }
-        }
-        connections.swap(remaining);
+void PulseAudioReceiver::Impl::stop_all_connections() {
+    for (auto& loop : event_loops) {
+        loop->stop.store(true);
+        const uint64_t one = 1;
+        (void)!::write(loop->wake_fd, &one, sizeof(one));
     }
-
-    for (auto& ctx : finished) {
-        if (ctx && ctx->worker.joinable()) {
-            ctx->worker.join();
+    for (auto& loop : event_loops) {
+        if (loop->worker.joinable()) {
+            loop->worker.join();
         }
+        ::close(loop->epoll_fd);
+        ::close(loop->wake_fd);
+        ::close(loop->timer_fd);
     }
+    event_loops.clear();
+
+    std::lock_guard<std::mutex> lock(connections_mutex);
+    connections.clear();
 }
 
-void PulseAudioReceiver::Impl::accept_connections(int listen_fd, bool is_unix, std::atomic<bool>& global_stop) {
+void PulseAudioReceiver::Impl::accept_connections(int listen_fd, bool is_unix) {
     while (true) {
         sockaddr_storage ss{};
         socklen_t len = sizeof(ss);
@@ -1097,83 +1205,228 @@ void PulseAudioReceiver::Impl::accept_connections(int listen_fd, bool is_unix, s
         conn->base_identity = conn->peer_identity;
 
         log("Accepted PulseAudio client from " + conn->peer_identity);
-        start_connection_thread(std::move(conn), global_stop);
+        assign_connection(std::move(conn));
     }
 }
 
-void PulseAudioReceiver::Impl::start_connection_thread(std::unique_ptr<Connection> conn, std::atomic<bool>& global_stop) {
-    if (!conn) {
+void PulseAudioReceiver::Impl::assign_connection(std::unique_ptr<Connection> conn) {
+    if (!conn || event_loops.empty()) {
         return;
     }
 
-    auto context = std::make_unique<ConnectionContext>();
-    context->connection = std::shared_ptr<Connection>(conn.release());
-    auto shared_conn = context->connection;
-    auto* ctx_ptr = context.get();
-    auto* stop_ptr = &global_stop;
+    auto least_loaded = std::min_element(event_loops.begin(), event_loops.end(),
+                                         [](const auto& a, const auto& b) { return a->load.load() < b->load.load(); });
+    EventLoop& loop = **least_loaded;
 
-    context->worker = std::thread([this, ctx_ptr, shared_conn, stop_ptr]() {
-        if (shared_conn && stop_ptr) {
-            shared_conn->run(*stop_ptr, ctx_ptr->stop);
-            if (shared_conn->owner) {
-                shared_conn->owner->log("Closing PulseAudio client " + shared_conn->peer_identity);
-            }
+    std::shared_ptr<Connection> shared_conn(conn.release());
+    shared_conn->loop_id = next_connection_id.fetch_add(1);
+    loop.load.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex);
+        connections.push_back(shared_conn);
+    }
+    {
+        std::lock_guard<std::mutex> lock(loop.incoming_mutex);
+        loop.incoming.push_back(std::move(shared_conn));
+    }
+    const uint64_t one = 1;
+    (void)!::write(loop.wake_fd, &one, sizeof(one));
+}
+
+void PulseAudioReceiver::Impl::adopt_incoming(EventLoop& loop) {
+    std::vector<std::shared_ptr<Connection>> incoming;
+    {
+        std::lock_guard<std::mutex> lock(loop.incoming_mutex);
+        incoming.swap(loop.incoming);
+    }
+    for (auto& conn : incoming) {
+        const uint64_t id = conn->loop_id;
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u64 = (id << 2) | kWatchSocket;
+        if (::epoll_ctl(loop.epoll_fd, EPOLL_CTL_ADD, conn->fd, &ev) < 0) {
+            log_warning("Failed to watch PulseAudio client " + conn->peer_identity + ": " + errno_string(errno));
+            loop.active.emplace(id, std::move(conn));
+            close_connection(loop, id);
+            continue;
+        }
+        conn->watched_events = EPOLLIN;
+        loop.active.emplace(id, std::move(conn));
+    }
+}
+
+void PulseAudioReceiver::Impl::update_watches(EventLoop& loop, Connection& conn) {
+    const uint64_t id = conn.loop_id;
+    const uint32_t desired = conn.desired_epoll_events();
+    if (desired != conn.watched_events) {
+        epoll_event ev{};
+        ev.events = desired;
+        ev.data.u64 = (id << 2) | kWatchSocket;
+        if (::epoll_ctl(loop.epoll_fd, EPOLL_CTL_MOD, conn.fd, &ev) == 0) {
+            conn.watched_events = desired;
         }
-        ctx_ptr->finished.store(true);
-    });
+    }
+    // The srbchannel appears mid-session, after AUTH.
+    if (conn.srbchannel && !conn.srb_watched) {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u64 = (id << 2) | kWatchSrbChannel;
+        if (::epoll_ctl(loop.epoll_fd, EPOLL_CTL_ADD, conn.srbchannel->read_eventfd(), &ev) == 0) {
+            conn.srb_watched = true;
+        }
+    }
+}
+
+void PulseAudioReceiver::Impl::arm_loop_timer(EventLoop& loop,
+                                              std::optional<std::chrono::steady_clock::time_point> deadline) {
+    const auto target = deadline.value_or(std::chrono::steady_clock::time_point{});
+    if (target == loop.timer_deadline) {
+        return;
+    }
+    loop.timer_deadline = target;
+
+    // steady_clock is CLOCK_MONOTONIC, so deadlines can be handed to the timerfd as-is.
+    itimerspec spec{};
+    if (deadline) {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(target.time_since_epoch()).count();
+        spec.it_value.tv_sec = static_cast<time_t>(ns / 1'000'000'000LL);
+        spec.it_value.tv_nsec = static_cast<long>(ns % 1'000'000'000LL);
+        if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0) {
+            spec.it_value.tv_nsec = 1; // all-zero would disarm
+        }
+    }
+    if (::timerfd_settime(loop.timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr) < 0) {
+        log_warning("timerfd_settime failed: " + errno_string(errno));
+    }
+}
+
+void PulseAudioReceiver::Impl::close_connection(EventLoop& loop, uint64_t id) {
+    auto it = loop.active.find(id);
+    if (it == loop.active.end()) {
+        return;
+    }
+    std::shared_ptr<Connection> conn = std::move(it->second);
+    loop.active.erase(it);
+
+    ::epoll_ctl(loop.epoll_fd, EPOLL_CTL_DEL, conn->fd, nullptr);
+    if (conn->srb_watched) {
+        ::epoll_ctl(loop.epoll_fd, EPOLL_CTL_DEL, conn->srbchannel->read_eventfd(), nullptr);
+    }
+    log("Closing PulseAudio client " + conn->peer_identity);
 
     {
         std::lock_guard<std::mutex> lock(connections_mutex);
-        connections.push_back(std::move(context));
+        connections.erase(std::remove(connections.begin(), connections.end(), conn), connections.end());
     }
+    loop.load.fetch_sub(1);
 }
 
-void PulseAudioReceiver::Impl::Connection::run(std::atomic<bool>& global_stop, std::atomic<bool>& local_stop) {
-    while (!global_stop.load() && !local_stop.load()) {
-        dispatch_clock_ticks();
-        process_due_requests();
+void PulseAudioReceiver::Impl::run_event_loop(EventLoop& loop) {
+    const std::string thread_name = "[PulseLoop:" + logger_prefix + ":" + std::to_string(loop.index) + "]";
+    utils::set_current_thread_realtime_priority(thread_name.c_str());
 
-        int timeout_ms = 5;
-        auto now = std::chrono::steady_clock::now();
-        if (auto due = next_due_request()) {
-            if (*due <= now) {
-                timeout_ms = 0;
-            } else {
-                auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(*due - now);
-                timeout_ms = static_cast<int>(std::max<long long>(diff.count(), 0));
+    std::array<epoll_event, kMaxEpollEvents> events{};
+    std::vector<uint64_t> closed;
+    while (!loop.stop.load()) {
+        adopt_incoming(loop);
+
+        // Clock ticks, due REQUESTs and srbchannel traffic, then decide how long we may sleep.
+        const auto now = std::chrono::steady_clock::now();
+        bool busy = false;
+        std::optional<std::chrono::steady_clock::time_point> deadline;
+        closed.clear();
+        for (auto& [id, conn] : loop.active) {
+            if (!conn->service(now)) {
+                closed.push_back(id);
+                continue;
+            }
+            update_watches(loop, *conn);
+            if (conn->srbchannel) {
+                // The client only kicks the eventfd when we announce that we are about to sleep.
+                conn->srb_armed = conn->srbchannel->before_poll();
+                busy = busy || !conn->srb_armed;
             }
+            if (auto wakeup = conn->next_wakeup()) {
+                if (!deadline || *wakeup < *deadline) {
+                    deadline = wakeup;
+                }
+            }
+        }
+        for (uint64_t id : closed) {
+            close_connection(loop, id);
         }
 
-        pollfd pfd{};
-        pfd.fd = fd;
-        pfd.events = desired_poll_events();
-        int rc = ::poll(&pfd, 1, timeout_ms);
-        if (rc < 0) {
-            if (errno == EINTR) {
-                continue;
+        arm_loop_timer(loop, deadline);
+        const int rc = ::epoll_wait(loop.epoll_fd, events.data(), static_cast<int>(events.size()), busy ? 0 : -1);
+
+        for (auto& [_, conn] : loop.active) {
+            if (conn->srb_armed) {
+                conn->srbchannel->after_poll();
+                conn->srb_armed = false;
             }
-            owner->log_warning("poll failed for connection: " + errno_string(errno));
-            break;
         }
-        if (rc == 0) {
+        if (rc < 0) {
+            if (errno != EINTR) {
+                log_warning("epoll_wait failed: " + errno_string(errno));
+            }
             continue;
         }
-        if (!handle_io(pfd.revents)) {
-            break;
+
+        for (int i = 0; i < rc; ++i) {
+            const uint64_t key = events[i].data.u64;
+            const uint64_t kind = key & kWatchKindMask;
+            if (kind == kWatchWake || kind == kWatchTimer) {
+                uint64_t value = 0;
+                (void)!::read(kind == kWatchWake ? loop.wake_fd : loop.timer_fd, &value, sizeof(value));
+                if (kind == kWatchTimer) {
+                    loop.timer_deadline = {};
+                }
+                continue;
+            }
+            if (kind == kWatchSrbChannel) {
+                continue; // Drained by service() on the next pass.
+            }
+            const uint64_t id = key >> 2;
+            auto it = loop.active.find(id);
+            if (it != loop.active.end() && !it->second->handle_io(events[i].events)) {
+                close_connection(loop, id);
+            }
         }
     }
 
-    local_stop.store(true);
+    adopt_incoming(loop);
+    closed.clear();
+    for (const auto& [id, _] : loop.active) {
+        closed.push_back(id);
+    }
+    for (uint64_t id : closed) {
+        close_connection(loop, id);
+    }
+}
+
+bool PulseAudioReceiver::Impl::Connection::service(std::chrono::steady_clock::time_point now) {
+    dispatch_clock_ticks(now);
+    process_due_requests();
+
+    if (srbchannel) {
+        if (!handle_srb_read()) {
+            return false;
+        }
+        if (srb_write_enabled && !handle_write()) {
+            return false;
+        }
+    }
+    return true;
 }
 
-bool PulseAudioReceiver::Impl::Connection::handle_io(short revents) {
-    if (revents & (POLLERR | POLLHUP | POLLNVAL)) {
+bool PulseAudioReceiver::Impl::Connection::handle_io(uint32_t events) {
+    if (events & (EPOLLERR | EPOLLHUP)) {
         return false;
     }
-    if ((revents & POLLIN) && !handle_read()) {
+    if ((events & EPOLLIN) && !handle_read()) {
         return false;
     }
-    if ((revents & POLLOUT) && !handle_write()) {
+    if ((events & EPOLLOUT) && !handle_write()) {
         return false;
     }
     return true;
@@ -1222,15 +1475,28 @@ bool PulseAudioReceiver::Impl::Connection::handle_read() {
         }
     }
 
+    return process_frames(read_buffer, true);
+}
+
+bool PulseAudioReceiver::Impl::Connection::handle_srb_read() {
+    std::array<uint8_t, 4096> buffer{};
+    while (std::size_t n = srbchannel->read(buffer.data(), buffer.size())) {
+        srb_read_buffer.insert(srb_read_buffer.end(), buffer.begin(), buffer.begin() + static_cast<long>(n));
+    }
+    return process_frames(srb_read_buffer, false);
+}
+
+bool PulseAudioReceiver::Impl::Connection::process_frames(std::vector<uint8_t>& buffer, bool socket_frames) {
     while (true) {
         Message message;
-        size_t consumed = DecodeMessage(read_buffer.data(), read_buffer.size(), message);
+        size_t consumed = DecodeMessage(buffer.data(), buffer.size(), message);
         if (consumed == 0) {
             break; // need more data
         }
-        read_buffer.erase(read_buffer.begin(), read_buffer.begin() + static_cast<long>(consumed));
+        buffer.erase(buffer.begin(), buffer.begin() + static_cast<long>(consumed));
 
-        if (!pending_fds.empty()) {
+        // File descriptors can only arrive over the socket.
+        if (socket_frames && !pending_fds.empty()) {
             message.fds = std::move(pending_fds.front());
             pending_fds.pop_front();
         }
@@ -1252,7 +1518,39 @@ bool PulseAudioReceiver::Impl::Connection::handle_write() {
             return true;
         }
         auto& frame = write_queue.front();
-        ssize_t written = ::send(fd, frame.data(), frame.size(), 0);
+        if (frame_uses_srbchannel(frame)) {
+            const std::size_t written = srbchannel->write(frame.bytes.data(), frame.bytes.size());
+            if (written < frame.bytes.size()) {
+                // Ring full; the client wakes us through the eventfd once it has drained it.
+                frame.bytes.erase(frame.bytes.begin(), frame.bytes.begin() + static_cast<long>(written));
+                return true;
+            }
+            write_queue.pop_front();
+            continue;
+        }
+
+        ssize_t written = 0;
+        if (!frame.fds.empty()) {
+            struct iovec iov {
+                frame.bytes.data(),
+                frame.bytes.size()
+            };
+            char control[CMSG_SPACE(sizeof(int) * kMaxAncillaryFds)]{};
+            const std::size_t fd_bytes = sizeof(int) * frame.fds.size();
+            struct msghdr msg {};
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = control;
+            msg.msg_controllen = CMSG_SPACE(fd_bytes);
+            cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+            cmsg->cmsg_level = SOL_SOCKET;
+            cmsg->cmsg_type = SCM_RIGHTS;
+            cmsg->cmsg_len = CMSG_LEN(fd_bytes);
+            std::memcpy(CMSG_DATA(cmsg), frame.fds.data(), fd_bytes);
+            written = ::sendmsg(fd, &msg, MSG_NOSIGNAL);
+        } else {
+            written = ::send(fd, frame.bytes.data(), frame.bytes.size(), 0);
+        }
         if (written < 0) {
             if (errno == EAGAIN || errno == EWOULDBLOCK) {
                 return true;
@@ -1260,8 +1558,10 @@ bool PulseAudioReceiver::Impl::Connection::handle_write() {
             owner->log_warning("send failed: " + errno_string(errno));
             return false;
         }
+        // Ancillary data rides on the first byte, so a partial send has delivered the fds.
+        frame.fds.clear();
         if (static_cast<size_t>(written) < frame.size()) {
-            frame.erase(frame.begin(), frame.begin() + written);
+            frame.bytes.erase(frame.bytes.begin(), frame.bytes.begin() + written);
             return true;
         }
         write_queue.pop_front();
@@ -1269,7 +1569,7 @@ bool PulseAudioReceiver::Impl::Connection::handle_write() {
     return true;
 }
 
-void PulseAudioReceiver::Impl::Connection::enqueue_tagstruct(const TagWriter& writer) {
+void PulseAudioReceiver::Impl::Connection::enqueue_tagstruct(const TagWriter& writer, std::vector<int> fds) {
     Message message;
     message.descriptor.length = static_cast<uint32_t>(writer.buffer().size());
     message.descriptor.channel = kChannelCommand;
@@ -1288,7 +1588,7 @@ void PulseAudioReceiver::Impl::Connection::enqueue_tagstruct(const TagWriter& wr
     }
     {
         std::lock_guard<std::mutex> lock(write_queue_mutex);
-        write_queue.push_back(std::move(frame));
+        write_queue.push_back(OutgoingFrame{std::move(frame), std::move(fds)});
     }
 }
 
@@ -1464,7 +1764,7 @@ uint32_t PulseAudioReceiver::Impl::Connection::calculate_samples_per_chunk(const
 }
 
 void PulseAudioReceiver::Impl::Connection::register_stream_clock(StreamState& stream) {
-    if (!owner->clock_manager || stream.clock_handle.valid()) {
+    if (!owner->clock_manager || stream.clock_period.count() != 0) {
         return;
     }
     const uint32_t bit_depth = sample_format_bit_depth(stream.sample_spec.format);
@@ -1472,77 +1772,43 @@ void PulseAudioReceiver::Impl::Connection::register_stream_clock(StreamState& st
         return;
     }
     try {
-        stream.clock_handle = owner->clock_manager->register_clock_condition(
+        stream.clock_period = owner->clock_manager->calculate_period(
             static_cast<int>(stream.sample_spec.rate),
             static_cast<int>(stream.sample_spec.channels),
             static_cast<int>(bit_depth));
-        if (!stream.clock_handle.valid()) {
-            throw std::runtime_error("ClockManager returned invalid condition handle");
-        }
-        if (auto condition = stream.clock_handle.condition) {
-            std::lock_guard<std::mutex> condition_lock(condition->mutex);
-            stream.clock_last_sequence = condition->sequence;
-        } else {
-            stream.clock_last_sequence = 0;
-        }
+        stream.next_clock_tick = std::chrono::steady_clock::now() + stream.clock_period;
     } catch (const std::exception& ex) {
+        stream.clock_period = std::chrono::nanoseconds{0};
         owner->log_error("Failed to register PulseAudio stream clock for " + stream.composite_tag + ": " + ex.what());
     }
 }
 
 void PulseAudioReceiver::Impl::Connection::unregister_stream_clock(StreamState& stream) {
-    if (!owner->clock_manager || !stream.clock_handle.valid()) {
-        return;
-    }
-    try {
-        owner->clock_manager->unregister_clock_condition(stream.clock_handle);
-    } catch (const std::exception& ex) {
-        owner->log_error("Failed to unregister PulseAudio stream clock for " + stream.composite_tag + ": " + ex.what());
-    }
-    stream.clock_handle = {};
-    stream.clock_last_sequence = 0;
+    stream.clock_period = std::chrono::nanoseconds{0};
+    stream.next_clock_tick = {};
 }
 
-void PulseAudioReceiver::Impl::Connection::dispatch_clock_ticks() {
-    if (!owner->clock_manager) {
-        return;
-    }
-
-    std::vector<std::pair<uint32_t, uint64_t>> pending_ticks;
-
+void PulseAudioReceiver::Impl::Connection::dispatch_clock_ticks(std::chrono::steady_clock::time_point now) {
+    std::vector<uint32_t> due_streams;
     {
         std::lock_guard<std::mutex> lock(stream_mutex);
         for (auto& [stream_index, stream] : streams) {
-            if (!stream.clock_handle.valid()) {
+            if (stream.clock_period.count() == 0 || stream.next_clock_tick > now) {
                 continue;
             }
-
-            auto condition = stream.clock_handle.condition;
-            if (!condition) {
-                continue;
-            }
-
-            uint64_t sequence_snapshot = 0;
-            {
-                std::unique_lock<std::mutex> condition_lock(condition->mutex);
-                sequence_snapshot = condition->sequence;
-            }
-
-            if (sequence_snapshot > stream.clock_last_sequence) {
-                uint64_t tick_count = sequence_snapshot - stream.clock_last_sequence;
-                stream.clock_last_sequence = sequence_snapshot;
-                pending_ticks.emplace_back(stream_index, tick_count);
+            due_streams.push_back(stream_index);
+            // Same policy as ClockManager: one tick per wake-up, and a tick only counts as
+            // missed (and is skipped) once we are more than half a period late.
+            const auto half_period = stream.clock_period / 2;
+            stream.next_clock_tick += stream.clock_period;
+            while (stream.next_clock_tick + half_period <= now) {
+                stream.next_clock_tick += stream.clock_period;
             }
         }
     }
 
-    for (const auto& [stream_index, tick_count] : pending_ticks) {
-        for (uint64_t i = 0; i < tick_count; ++i) {
-            if (owner->clock_manager == nullptr) {
-                return;
-            }
-            handle_clock_tick(stream_index);
-        }
+    for (uint32_t stream_index : due_streams) {
+        handle_clock_tick(stream_index);
     }
 }
 
@@ -1773,7 +2039,7 @@ void PulseAudioReceiver::Impl::Connection::enqueue_shm_release(uint32_t block_id
     }
     {
         std::lock_guard<std::mutex> lock(write_queue_mutex);
-        write_queue.push_back(std::move(frame));
+        write_queue.push_back(OutgoingFrame{std::move(frame), {}});
     }
 }
 
@@ -1813,6 +2079,12 @@ bool PulseAudioReceiver::Impl::Connection::process_message(Message& message) {
         owner->log_debug(oss.str());
     }
 
+    const uint32_t shm_flags = message.descriptor.flags & kDescriptorFlagShmMask;
+    if (shm_flags == kDescriptorFlagShmRelease || shm_flags == kDescriptorFlagShmRevoke) {
+        // The client hands back the srbchannel block on teardown; it is freed with the connection.
+        return true;
+    }
+
     if (message.descriptor.channel == kChannelCommand) {
         TagReader header_reader(message.payload.data(), message.payload.size());
         auto command_field = header_reader.read_u32();
@@ -2025,6 +2297,8 @@ bool PulseAudioReceiver::Impl::Connection::handle_command(Command command,
             return handle_noop_ack(tag, reader, "RemoveClientProplist");
         case Command::RegisterMemfdShmid:
             return handle_register_memfd(tag, reader, fds);
+        case Command::EnableSrbChannel:
+            return handle_enable_srbchannel(tag);
         case Command::Exit:
             return false;
         default:
@@ -2082,6 +2356,66 @@ bool PulseAudioReceiver::Impl::Connection::handle_auth(uint32_t tag, TagReader&
     writer.put_u32(response_version);
     owner->log("Auth OK, negotiated version " + std::to_string(negotiated_version));
     enqueue_tagstruct(writer);
+
+    // Like PulseAudio, only offer the ring once the client has seen our memfd flag.
+    if (is_unix && use_memfd && negotiated_version >= kSrbChannelMinVersion && owner->config.enable_srbchannel) {
+        setup_srbchannel();
+    }
+    return true;
+}
+
+void PulseAudioReceiver::Impl::Connection::setup_srbchannel() {
+    std::string error;
+    auto channel = SrbChannel::create(SrbChannel::kDefaultBlockSize, &error);
+    if (!channel) {
+        owner->log_warning("srbchannel unavailable, staying on the socket: " + error);
+        return;
+    }
+
+    // Mirrors setup_srbchannel() in protocol-native.c: register the pool, send the eventfds,
+    // then send the ring block itself as a writable memfd reference.
+    TagWriter register_pool;
+    register_pool.put_command(Command::RegisterMemfdShmid, static_cast<uint32_t>(-1));
+    register_pool.put_u32(channel->shm_id());
+    enqueue_tagstruct(register_pool, {channel->memfd()});
+
+    srb_setup_tag = channel->shm_id();
+    TagWriter enable;
+    enable.put_command(Command::EnableSrbChannel, srb_setup_tag);
+    enqueue_tagstruct(enable, {channel->read_eventfd(), channel->write_eventfd()});
+
+    const uint32_t shm_info[4] = {
+        htonl(kSrbChannelBlockId),
+        htonl(channel->shm_id()),
+        htonl(0),
+        htonl(static_cast<uint32_t>(channel->block_size())),
+    };
+    Message block;
+    block.descriptor.length = sizeof(shm_info);
+    block.descriptor.channel = 0;
+    block.descriptor.flags = kDescriptorFlagShmData | kDescriptorFlagMemfdBlock | kDescriptorFlagShmWritable;
+    block.payload.resize(sizeof(shm_info));
+    std::memcpy(block.payload.data(), shm_info, sizeof(shm_info));
+    {
+        std::lock_guard<std::mutex> lock(write_queue_mutex);
+        write_queue.push_back(OutgoingFrame{EncodeMessage(block), {}});
+    }
+
+    owner->log("Offered srbchannel shm_id=" + std::to_string(channel->shm_id()) +
+               " capacity=" + std::to_string(channel->capacity()));
+    srbchannel = std::move(channel);
+    srb_pending = true;
+}
+
+bool PulseAudioReceiver::Impl::Connection::handle_enable_srbchannel(uint32_t tag) {
+    // The client's ack carries no reply; from here on it writes into the ring, and so do we.
+    if (!srbchannel || !srb_pending || tag != srb_setup_tag) {
+        owner->log_warning("Unexpected ENABLE_SRBCHANNEL tag=" + std::to_string(tag));
+        return false;
+    }
+    srb_pending = false;
+    srb_write_enabled = true;
+    owner->log("srbchannel enabled for " + peer_identity);
     return true;
 }
 
@@ -3512,18 +3846,29 @@ bool PulseAudioReceiver::Impl::Connection::handle_register_memfd(uint32_t tag, T
         return false;
     }
 
+    void* mapped = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        owner->log_warning("REGISTER_MEMFD_SHMID mmap failed: " + errno_string(errno));
+        return false;
+    }
+    auto trap = MemTrap::add(mapped, static_cast<size_t>(st.st_size));
+    if (!trap) {
+        owner->log_warning("REGISTER_MEMFD_SHMID: no memtrap slot left for pool " + std::to_string(*shm_id_opt));
+        ::munmap(mapped, static_cast<size_t>(st.st_size));
+        return false;
+    }
+
     auto it = memfd_pools.find(*shm_id_opt);
     if (it != memfd_pools.end()) {
-        if (it->second.fd >= 0) {
-            ::close(it->second.fd);
-        }
         memfd_pools.erase(it);
     }
 
     MemfdPool pool;
     pool.fd = fd;
     pool.size = st.st_size;
-    memfd_pools.emplace(*shm_id_opt, pool);
+    pool.base = static_cast<const uint8_t*>(mapped);
+    pool.trap = std::move(trap);
+    memfd_pools.emplace(*shm_id_opt, std::move(pool));
 
     owner->log("Registered memfd pool id=" + std::to_string(*shm_id_opt) +
                " size=" + std::to_string(static_cast<long long>(st.st_size)));
@@ -3550,10 +3895,12 @@ bool PulseAudioReceiver::Impl::Connection::handle_playback_data(const Message& m
     }
     auto& stream = it->second;
 
-    std::vector<uint8_t> memfd_payload;
-    const std::vector<uint8_t>* active_payload = &message.payload;
+    // Either the frame payload or the memblock, read in place from the client's pool.
+    const uint8_t* payload_data = message.payload.data();
+    std::size_t payload_size = message.payload.size();
     bool should_release_block = false;
     uint32_t release_block_id = 0;
+    const MemfdPool* trapped_pool = nullptr;
 
     if ((flags & kDescriptorFlagShmData) != 0) {
         if (!use_memfd || (flags & kDescriptorFlagMemfdBlock) == 0) {
@@ -3601,18 +3948,13 @@ bool PulseAudioReceiver::Impl::Connection::handle_playback_data(const Message& m
             return false;
         }
 
-        memfd_payload.resize(length);
-        ssize_t read_bytes = ::pread(pool.fd, memfd_payload.data(), length, static_cast<off_t>(offset));
-        if (read_bytes < 0) {
-            owner->log_warning("Failed reading memfd block: " + errno_string(errno));
-            return false;
-        }
-        if (read_bytes != static_cast<ssize_t>(length)) {
-            owner->log_warning("Failed reading memfd block: short read");
+        if (!pool.is_good()) {
+            owner->log_warning("Memfd pool " + std::to_string(shm_id) + " was truncated by its client; dropping connection");
             return false;
         }
-
-        active_payload = &memfd_payload;
+        payload_data = pool.base + offset;
+        trapped_pool = &pool;
+        payload_size = length;
         should_release_block = true;
         release_block_id = block_id;
     }
@@ -3630,29 +3972,11 @@ bool PulseAudioReceiver::Impl::Connection::handle_playback_data(const Message& m
     const bool from_memfd = (flags & kDescriptorFlagShmData) != 0;
     const bool converted_format = (stream.sample_spec.format == kSampleFormatFloat32LE);
 
-    if (!active_payload->empty()) {
-        stream.pending_payload.write(active_payload->data(), active_payload->size());
-    }
-
-    if (should_release_block) {
-        enqueue_shm_release(release_block_id);
-    }
-
     const std::size_t chunk_bytes = stream.chunk_bytes != 0
         ? stream.chunk_bytes
         : (owner ? owner->chunk_size_bytes : kDefaultChunkSizeBytes);
-    while (stream.pending_payload.size() >= chunk_bytes) {
-        std::vector<uint8_t> chunk(chunk_bytes);
-        const std::size_t popped = stream.pending_payload.pop(chunk.data(), chunk_bytes);
-        if (popped == 0) {
-            break;
-        }
-        chunk.resize(popped);
-
-        if (stream.sample_spec.format == kSampleFormatFloat32LE) {
-            chunk = convert_float_chunk_to_s32(chunk);
-        }
 
+    auto queue_chunk = [&](std::vector<uint8_t>&& chunk) {
         const size_t chunk_bytes = chunk.size();
         const uint64_t chunk_frames = frame_bytes > 0 ? static_cast<uint64_t>(chunk_bytes / frame_bytes) : 0;
         if (chunk_frames > 0) {
@@ -3731,6 +4055,60 @@ bool PulseAudioReceiver::Impl::Connection::handle_playback_data(const Message& m
 
             stream.pending_chunks.push_back(std::move(pending_chunk));
         }
+    };
+
+    // Chunks come out of the carry-over ring when they straddle payloads, and straight out of
+    // the payload otherwise; float samples are converted on that single copy.
+    auto take_chunk_from_ring = [&]() {
+        std::vector<uint8_t> chunk(chunk_bytes);
+        const std::size_t popped = stream.pending_payload.pop(chunk.data(), chunk_bytes);
+        chunk.resize(popped);
+        if (converted_format) {
+            convert_float_to_s32(chunk.data(), chunk.size(), chunk.data());
+        }
+        queue_chunk(std::move(chunk));
+    };
+
+    std::size_t payload_offset = 0;
+    if (!stream.pending_payload.empty()) {
+        const std::size_t buffered = stream.pending_payload.size();
+        const std::size_t top_up = buffered < chunk_bytes ? std::min(chunk_bytes - buffered, payload_size) : 0;
+        stream.pending_payload.write(payload_data, top_up);
+        payload_offset = top_up;
+        while (stream.pending_payload.size() >= chunk_bytes) {
+            take_chunk_from_ring();
+        }
+    }
+    if (stream.pending_payload.empty()) {
+        while (payload_size - payload_offset >= chunk_bytes) {
+            const uint8_t* src = payload_data + payload_offset;
+            std::vector<uint8_t> chunk(chunk_bytes);
+            if (converted_format) {
+                convert_float_to_s32(src, chunk_bytes, chunk.data());
+            } else {
+                std::memcpy(chunk.data(), src, chunk_bytes);
+            }
+            payload_offset += chunk_bytes;
+            queue_chunk(std::move(chunk));
+        }
+    }
+    if (payload_offset < payload_size) {
+        stream.pending_payload.write(payload_data + payload_offset, payload_size - payload_offset);
+        while (stream.pending_payload.size() >= chunk_bytes) {
+            take_chunk_from_ring();
+        }
+    }
+
+    // A client truncating its pool while the block was read leaves zeros behind instead of a
+    // SIGBUS; what was queued is silence, but the pool is useless from here on.
+    if (trapped_pool && !trapped_pool->is_good()) {
+        owner->log_warning("Memfd pool was truncated by its client while reading a block; dropping connection");
+        return false;
+    }
+
+    // Only now is the memblock no longer referenced.
+    if (should_release_block) {
+        enqueue_shm_release(release_block_id);
     }
 
     if (!stream.corked && !stream.started_notified && !stream.pending_chunks.empty()) {
@@ -3787,15 +4165,20 @@ void PulseAudioReceiver::Impl::Connection::process_due_requests() {
 }
 
 std::optional<std::chrono::steady_clock::time_point>
-PulseAudioReceiver::Impl::Connection::next_due_request() const {
+PulseAudioReceiver::Impl::Connection::next_wakeup() const {
     std::lock_guard<std::mutex> stream_lock(stream_mutex);
     std::optional<std::chrono::steady_clock::time_point> earliest;
+    auto consider = [&earliest](std::chrono::steady_clock::time_point when) {
+        if (!earliest || when < *earliest) {
+            earliest = when;
+        }
+    };
     for (const auto& [_, stream] : streams) {
-        if (stream.pending_request_bytes == 0) {
-            continue;
+        if (stream.clock_period.count() != 0) {
+            consider(stream.next_clock_tick);
         }
-        if (!earliest || stream.next_request_time < *earliest) {
-            earliest = stream.next_request_time;
+        if (stream.pending_request_bytes != 0) {
+            consider(stream.next_request_time);
         }
     }
     return earliest;
@@ -3804,7 +4187,6 @@ PulseAudioReceiver::Impl::Connection::next_due_request() const {
 void PulseAudioReceiver::Impl::event_loop(std::atomic<bool>& stop_flag) {
     while (!stop_flag.load()) {
         maybe_log_telemetry();
-        prune_finished_connections();
 
         std::vector<pollfd> pollfds;
         if (tcp_listen_fd >= 0) {
@@ -3824,19 +4206,18 @@ void PulseAudioReceiver::Impl::event_loop(std::atomic<bool>& stop_flag) {
         std::size_t index = 0;
         if (tcp_listen_fd >= 0) {
             if (pollfds[index].revents & POLLIN) {
-                accept_connections(tcp_listen_fd, false, stop_flag);
+                accept_connections(tcp_listen_fd, false);
             }
             ++index;
         }
         if (unix_listen_fd >= 0) {
             if (pollfds[index].revents & POLLIN) {
-                accept_connections(unix_listen_fd, true, stop_flag);
+                accept_connections(unix_listen_fd, true);
             }
             ++index;
         }
     }
     stop_all_connections();
-    prune_finished_connections();
 }
 
 namespace {
@@ -3871,11 +4252,7 @@ void PulseAudioReceiver::Impl::maybe_log_telemetry() {
     std::vector<std::shared_ptr<Connection>> snapshot;
     {
         std::lock_guard<std::mutex> lock(connections_mutex);
-        for (const auto& ctx : connections) {
-            if (ctx && ctx->connection) {
-                snapshot.push_back(ctx->connection);
-            }
-        }
+        snapshot = connections;
     }
 
     std::size_t total_write_chunks = 0;
@@ -23,6 +23,8 @@ namespace pulse {
 struct PulseReceiverConfig {
     uint16_t tcp_listen_port = 0;            ///< 0 disables TCP listener
     bool require_auth_cookie = false;       ///< If true, clients must authenticate using cookie
+    bool enable_srbchannel = true;          ///< Offer the shared-memory ring transport to local memfd clients
+    int event_loop_threads = 1;             ///< epoll loops shared by all client connections (minimum 1)
 #if !defined(_WIN32)
     std::string unix_socket_path;           ///< Absolute path for native protocol UNIX socket
     std::string auth_cookie_path;           ///< Optional cookie file path
@@ -0,0 +1,249 @@
+#include "pulse_srbchannel.h"
+
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(WIN32)
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <random>
+
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+
+namespace screamrouter {
+namespace audio {
+namespace pulse {
+
+// pa_fdsem_data: every field is a pa_atomic_t, i.e. a plain int accessed with full barriers.
+struct SrbChannel::SemData {
+    int32_t waiting;
+    int32_t signalled;
+    int32_t in_pipe;
+};
+
+// struct srbheader from pulsecore/srbchannel.c.
+struct SrbChannel::Header {
+    int32_t read_count;
+    int32_t write_count;
+    SemData read_semdata;
+    SemData write_semdata;
+    int32_t capacity;
+    int32_t readbuf_offs;
+    int32_t writebuf_offs;
+};
+
+namespace {
+
+static_assert(sizeof(int32_t) == sizeof(int), "pa_atomic_t is an int");
+
+constexpr std::size_t align_to_pointer(std::size_t value) {
+    return (value + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+}
+
+inline int32_t atomic_load(const int32_t& value) {
+    return __atomic_load_n(&value, __ATOMIC_SEQ_CST);
+}
+
+// Returns the previous value, like pa_atomic_add/pa_atomic_sub.
+inline int32_t atomic_add(int32_t& value, int32_t delta) {
+    return __atomic_fetch_add(&value, delta, __ATOMIC_SEQ_CST);
+}
+
+inline bool atomic_cmpxchg(int32_t& value, int32_t expected, int32_t desired) {
+    return __atomic_compare_exchange_n(&value, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+void close_if_open(int& fd) {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+} // namespace
+
+std::unique_ptr<SrbChannel> SrbChannel::create(std::size_t block_size, std::string* error) {
+    auto fail = [error](const char* what) -> std::unique_ptr<SrbChannel> {
+        if (error) {
+            *error = std::string(what) + ": " + std::strerror(errno);
+        }
+        return nullptr;
+    };
+
+    const std::size_t header_bytes = align_to_pointer(sizeof(Header));
+    if (block_size <= header_bytes * 2) {
+        errno = EINVAL;
+        return fail("srbchannel block too small");
+    }
+
+    std::unique_ptr<SrbChannel> channel(new SrbChannel());
+    channel->block_size_ = block_size;
+
+    channel->memfd_ = static_cast<int>(::syscall(SYS_memfd_create, "pulseaudio", MFD_CLOEXEC));
+    if (channel->memfd_ < 0) {
+        return fail("memfd_create");
+    }
+    if (::ftruncate(channel->memfd_, static_cast<off_t>(block_size)) < 0) {
+        return fail("ftruncate");
+    }
+    void* mapped = ::mmap(nullptr, block_size, PROT_READ | PROT_WRITE, MAP_SHARED, channel->memfd_, 0);
+    if (mapped == MAP_FAILED) {
+        return fail("mmap");
+    }
+    channel->block_ = static_cast<uint8_t*>(mapped);
+
+    // Blocking on purpose: the client shares these file descriptions and libpulse expects
+    // blocking reads once in_pipe says a wake-up is in flight.
+    channel->read_efd_ = ::eventfd(0, EFD_CLOEXEC);
+    channel->write_efd_ = ::eventfd(0, EFD_CLOEXEC);
+    if (channel->read_efd_ < 0 || channel->write_efd_ < 0) {
+        return fail("eventfd");
+    }
+
+    std::random_device rd;
+    channel->shm_id_ = static_cast<uint32_t>(rd());
+
+    // Same split as pa_srbchannel_new(): header, then two equal rings, the second pointer-aligned.
+    Header* h = channel->header();
+    std::memset(h, 0, sizeof(Header));
+    const std::size_t half = (block_size - header_bytes) / 2;
+    const std::size_t write_offset = align_to_pointer(header_bytes + half);
+    const std::size_t capacity = std::min(half, write_offset - header_bytes);
+    h->capacity = static_cast<int32_t>(capacity);
+    h->readbuf_offs = static_cast<int32_t>(header_bytes);
+    h->writebuf_offs = static_cast<int32_t>(write_offset);
+    channel->read_ring_ = channel->block_ + header_bytes;
+    channel->write_ring_ = channel->block_ + write_offset;
+    return channel;
+}
+
+SrbChannel::~SrbChannel() {
+    if (block_) {
+        ::munmap(block_, block_size_);
+        block_ = nullptr;
+    }
+    close_if_open(memfd_);
+    close_if_open(read_efd_);
+    close_if_open(write_efd_);
+}
+
+SrbChannel::Header* SrbChannel::header() const {
+    return reinterpret_cast<Header*>(block_);
+}
+
+std::size_t SrbChannel::capacity() const {
+    return static_cast<std::size_t>(header()->capacity);
+}
+
+std::size_t SrbChannel::readable() const {
+    return static_cast<std::size_t>(std::max<int32_t>(atomic_load(header()->read_count), 0));
+}
+
+std::size_t SrbChannel::read(uint8_t* out, std::size_t max_bytes) {
+    Header* h = header();
+    const std::size_t cap = capacity();
+    std::size_t total = 0;
+    while (total < max_bytes) {
+        const std::size_t available = readable();
+        const std::size_t contiguous = std::min(available, cap - read_index_);
+        const std::size_t count = std::min(contiguous, max_bytes - total);
+        if (count == 0) {
+            break;
+        }
+        std::memcpy(out + total, read_ring_ + read_index_, count);
+        const int32_t before = atomic_add(h->read_count, -static_cast<int32_t>(count));
+        read_index_ = (read_index_ + count) % cap;
+        total += count;
+        if (static_cast<std::size_t>(before) >= cap) {
+            // The client may be waiting for space; pa_srbchannel_read() does the same.
+            post(h->write_semdata, write_efd_);
+        }
+    }
+    return total;
+}
+
+std::size_t SrbChannel::write(const uint8_t* data, std::size_t length) {
+    Header* h = header();
+    const std::size_t cap = capacity();
+    std::size_t total = 0;
+    while (total < length) {
+        const std::size_t used = static_cast<std::size_t>(std::max<int32_t>(atomic_load(h->write_count), 0));
+        const std::size_t count = std::min({cap - write_index_, cap - std::min(used, cap), length - total});
+        if (count == 0) {
+            break;
+        }
+        std::memcpy(write_ring_ + write_index_, data + total, count);
+        atomic_add(h->write_count, static_cast<int32_t>(count));
+        write_index_ = (write_index_ + count) % cap;
+        total += count;
+    }
+    if (total > 0) {
+        post(h->write_semdata, write_efd_);
+    }
+    return total;
+}
+
+bool SrbChannel::before_poll() {
+    SemData& sem = header()->read_semdata;
+    flush(sem, read_efd_);
+    if (atomic_cmpxchg(sem.signalled, 1, 0)) {
+        return false;
+    }
+    atomic_add(sem.waiting, 1);
+    if (atomic_cmpxchg(sem.signalled, 1, 0)) {
+        atomic_add(sem.waiting, -1);
+        return false;
+    }
+    return true;
+}
+
+void SrbChannel::after_poll() {
+    SemData& sem = header()->read_semdata;
+    atomic_add(sem.waiting, -1);
+    flush(sem, read_efd_);
+    atomic_cmpxchg(sem.signalled, 1, 0);
+}
+
+void SrbChannel::post(SemData& sem, int efd) {
+    if (!atomic_cmpxchg(sem.signalled, 0, 1)) {
+        return; // Already signalled; the peer will see it.
+    }
+    if (atomic_load(sem.waiting) <= 0) {
+        return; // Peer is busy and will check signalled before sleeping.
+    }
+    atomic_add(sem.in_pipe, 1);
+    const uint64_t one = 1;
+    while (::write(efd, &one, sizeof(one)) < 0 && errno == EINTR) {
+    }
+}
+
+void SrbChannel::flush(SemData& sem, int efd) {
+    if (atomic_load(sem.in_pipe) <= 0) {
+        return;
+    }
+    int32_t drained = 0;
+    do {
+        uint64_t value = 0;
+        drained = 0;
+        const ssize_t r = ::read(efd, &value, sizeof(value));
+        if (r != static_cast<ssize_t>(sizeof(value))) {
+            if (r < 0 && errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        drained = static_cast<int32_t>(value);
+    } while (atomic_add(sem.in_pipe, -drained) > drained);
+}
+
+} // namespace pulse
+} // namespace audio
+} // namespace screamrouter
+
+#endif // !_WIN32
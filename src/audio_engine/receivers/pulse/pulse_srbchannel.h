@@ -0,0 +1,115 @@
+#ifndef SCREAMROUTER_AUDIO_PULSE_PULSE_SRBCHANNEL_H
+#define SCREAMROUTER_AUDIO_PULSE_PULSE_SRBCHANNEL_H
+
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(WIN32)
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace screamrouter {
+namespace audio {
+namespace pulse {
+
+/**
+ * @brief Server side of PulseAudio's srbchannel: a pair of byte rings in one shared memfd block.
+ * @details Once a client acknowledges ENABLE_SRBCHANNEL, native-protocol frames that carry no
+ *          file descriptors travel through this block instead of the socket. The layout and the
+ *          wake-up handshake mirror pulsecore/srbchannel.c and pulsecore/fdsem.c, since the
+ *          client side is libpulse itself:
+ *
+ *          - a small header with the two fill counters, two fdsem records, the ring capacity
+ *            and the offsets of both rings;
+ *          - the client-to-server ring, followed by the server-to-client ring.
+ *
+ *          Each direction has an eventfd. A writer only writes to it when the reader has
+ *          announced that it is about to sleep, so a busy stream costs no syscalls.
+ *
+ *          All methods must be called from the connection thread.
+ */
+class SrbChannel {
+public:
+    /// PulseAudio hands out one mempool slot (64 KiB) for the ring block.
+    static constexpr std::size_t kDefaultBlockSize = 64 * 1024;
+
+    /**
+     * @brief Allocates the memfd block and both eventfds.
+     * @return nullptr on failure, with a reason in error if provided.
+     */
+    static std::unique_ptr<SrbChannel> create(std::size_t block_size = kDefaultBlockSize,
+                                              std::string* error = nullptr);
+
+    ~SrbChannel();
+
+    SrbChannel(const SrbChannel&) = delete;
+    SrbChannel& operator=(const SrbChannel&) = delete;
+
+    /// memfd backing the block; announced to the client with REGISTER_MEMFD_SHMID.
+    int memfd() const { return memfd_; }
+    /// Pool id the client uses to resolve the block reference.
+    uint32_t shm_id() const { return shm_id_; }
+    std::size_t block_size() const { return block_size_; }
+    /// Bytes each ring can hold.
+    std::size_t capacity() const;
+
+    /// eventfd posted by the client after it writes; poll it for POLLIN.
+    int read_eventfd() const { return read_efd_; }
+    /// eventfd this side posts after writing.
+    int write_eventfd() const { return write_efd_; }
+
+    /// Bytes waiting in the client-to-server ring.
+    std::size_t readable() const;
+
+    /**
+     * @brief Copies up to max_bytes out of the client-to-server ring.
+     * @details Wakes the client if the ring was full, so a writer stalled on space resumes.
+     */
+    std::size_t read(uint8_t* out, std::size_t max_bytes);
+
+    /**
+     * @brief Copies as much of data as fits into the server-to-client ring and wakes the client.
+     * @return Bytes written; less than length when the ring is full.
+     */
+    std::size_t write(const uint8_t* data, std::size_t length);
+
+    /**
+     * @brief Arms the read semaphore before sleeping in poll().
+     * @return false when the client already signalled, in which case do not sleep and do not
+     *         call after_poll().
+     */
+    bool before_poll();
+
+    /// Disarms the read semaphore after poll() returns.
+    void after_poll();
+
+private:
+    struct Header;
+    struct SemData;
+
+    SrbChannel() = default;
+
+    Header* header() const;
+    void post(SemData& sem, int efd);
+    void flush(SemData& sem, int efd);
+
+    int memfd_ = -1;
+    int read_efd_ = -1;
+    int write_efd_ = -1;
+    uint32_t shm_id_ = 0;
+    std::size_t block_size_ = 0;
+    uint8_t* block_ = nullptr;
+    uint8_t* read_ring_ = nullptr;
+    uint8_t* write_ring_ = nullptr;
+    // Ring positions are private to each side; only the fill counters are shared.
+    std::size_t read_index_ = 0;
+    std::size_t write_index_ = 0;
+};
+
+} // namespace pulse
+} // namespace audio
+} // namespace screamrouter
+
+#endif // !_WIN32
+
+#endif // SCREAMROUTER_AUDIO_PULSE_PULSE_SRBCHANNEL_H
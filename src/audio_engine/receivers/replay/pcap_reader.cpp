@@ -0,0 +1,345 @@
+#include "pcap_reader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace screamrouter {
+namespace audio {
+
+namespace {
+
+constexpr uint32_t kPcapMagicMicroseconds = 0xA1B2C3D4;
+constexpr uint32_t kPcapMagicNanoseconds = 0xA1B23C4D;
+constexpr uint32_t kPcapngSectionHeader = 0x0A0D0D0A;
+constexpr uint32_t kPcapngByteOrderMagic = 0x1A2B3C4D;
+constexpr uint32_t kPcapngInterfaceDescription = 0x00000001;
+constexpr uint32_t kPcapngSimplePacket = 0x00000003;
+constexpr uint32_t kPcapngEnhancedPacket = 0x00000006;
+constexpr uint16_t kPcapngOptionTsResol = 9;
+
+constexpr uint16_t kLinkTypeNull = 0;
+constexpr uint16_t kLinkTypeEthernet = 1;
+constexpr uint16_t kLinkTypeRaw = 101;
+constexpr uint16_t kLinkTypeLoop = 108;
+constexpr uint16_t kLinkTypeLinuxSll = 113;
+constexpr uint16_t kLinkTypeIpv4 = 228;
+constexpr uint16_t kLinkTypeLinuxSll2 = 276;
+
+constexpr uint16_t kEtherTypeIpv4 = 0x0800;
+constexpr uint16_t kEtherTypeVlan = 0x8100;
+constexpr uint16_t kEtherTypeQinQ = 0x88A8;
+constexpr uint8_t kIpProtocolUdp = 17;
+
+/** @brief Larger records are treated as corruption rather than allocated. */
+constexpr uint32_t kMaxRecordBytes = 16u * 1024u * 1024u;
+
+uint16_t be16(const uint8_t* p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+uint32_t be32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+uint32_t le32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+std::chrono::nanoseconds ticks_to_ns(uint64_t ticks, uint64_t ticks_per_second) {
+    const uint64_t seconds = ticks / ticks_per_second;
+    const uint64_t remainder = ticks % ticks_per_second;
+    return std::chrono::nanoseconds(static_cast<int64_t>(seconds * 1000000000ull +
+                                                         remainder * 1000000000ull / ticks_per_second));
+}
+
+} // namespace
+
+PcapReader::PcapReader(const std::string& path) : path_(path), file_(path, std::ios::binary) {
+    if (!file_) {
+        throw std::runtime_error("Cannot open capture file: " + path);
+    }
+    uint8_t magic[4];
+    if (!file_.read(reinterpret_cast<char*>(magic), sizeof(magic))) {
+        throw std::runtime_error("Capture file is too short: " + path);
+    }
+
+    if (le32(magic) == kPcapngSectionHeader) {
+        is_pcapng_ = true;
+        first_record_ = 0;
+        rewind();
+        return;
+    }
+
+    const uint32_t magic_le = le32(magic);
+    const uint32_t magic_be = be32(magic);
+    if (magic_le == kPcapMagicMicroseconds || magic_le == kPcapMagicNanoseconds) {
+        big_endian_ = false;
+        nanosecond_ = magic_le == kPcapMagicNanoseconds;
+    } else if (magic_be == kPcapMagicMicroseconds || magic_be == kPcapMagicNanoseconds) {
+        big_endian_ = true;
+        nanosecond_ = magic_be == kPcapMagicNanoseconds;
+    } else {
+        throw std::runtime_error("Not a pcap or pcapng file: " + path);
+    }
+
+    uint8_t header[20];
+    if (!file_.read(reinterpret_cast<char*>(header), sizeof(header))) {
+        throw std::runtime_error("Truncated pcap header: " + path);
+    }
+    classic_link_type_ = static_cast<uint16_t>(u32(header + 16) & 0xFFFF);
+    first_record_ = file_.tellg();
+}
+
+uint16_t PcapReader::u16(const uint8_t* p) const {
+    return big_endian_ ? be16(p) : static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t PcapReader::u32(const uint8_t* p) const {
+    return big_endian_ ? be32(p) : le32(p);
+}
+
+void PcapReader::rewind() {
+    file_.clear();
+    file_.seekg(first_record_);
+    interfaces_.clear();
+    last_timestamp_ = std::chrono::nanoseconds(0);
+}
+
+bool PcapReader::next(PcapUdpDatagram& out) {
+    if (!is_pcapng_) {
+        return read_classic_record(out);
+    }
+    bool produced = false;
+    while (read_pcapng_block(out, produced)) {
+        if (produced) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PcapReader::read_classic_record(PcapUdpDatagram& out) {
+    uint8_t header[16];
+    while (file_.read(reinterpret_cast<char*>(header), sizeof(header))) {
+        const uint32_t seconds = u32(header);
+        const uint32_t fraction = u32(header + 4);
+        const uint32_t captured = u32(header + 8);
+        if (captured > kMaxRecordBytes) {
+            return false;
+        }
+        scratch_.resize(captured);
+        if (!file_.read(reinterpret_cast<char*>(scratch_.data()), captured)) {
+            return false;
+        }
+        out.timestamp = std::chrono::seconds(seconds) +
+                        (nanosecond_ ? std::chrono::nanoseconds(fraction) : std::chrono::microseconds(fraction));
+        if (decode_frame(classic_link_type_, scratch_.data(), scratch_.size(), out)) {
+            return true;
+        }
+        ++records_skipped_;
+    }
+    return false;
+}
+
+bool PcapReader::read_pcapng_block(PcapUdpDatagram& out, bool& produced) {
+    produced = false;
+    uint8_t header[8];
+    if (!file_.read(reinterpret_cast<char*>(header), sizeof(header))) {
+        return false;
+    }
+
+    if (le32(header) == kPcapngSectionHeader) {
+        // The byte-order magic that follows decides how the length just read is interpreted.
+        uint8_t bom[4];
+        if (!file_.read(reinterpret_cast<char*>(bom), sizeof(bom))) {
+            return false;
+        }
+        if (le32(bom) == kPcapngByteOrderMagic) {
+            big_endian_ = false;
+        } else if (be32(bom) == kPcapngByteOrderMagic) {
+            big_endian_ = true;
+        } else {
+            return false;
+        }
+        const uint32_t total_length = u32(header + 4);
+        if (total_length < 28 || total_length > kMaxRecordBytes) {
+            return false;
+        }
+        scratch_.resize(total_length - 16);
+        if (!file_.read(reinterpret_cast<char*>(scratch_.data()), scratch_.size()) || !file_.ignore(4)) {
+            return false;
+        }
+        interfaces_.clear();
+        return true;
+    }
+
+    const uint32_t block_type = u32(header);
+    const uint32_t total_length = u32(header + 4);
+    if (total_length < 12 || total_length > kMaxRecordBytes || (total_length % 4) != 0) {
+        return false;
+    }
+    scratch_.resize(total_length - 12);
+    if (!file_.read(reinterpret_cast<char*>(scratch_.data()), scratch_.size()) || !file_.ignore(4)) {
+        return false;
+    }
+    const uint8_t* body = scratch_.data();
+    const size_t body_size = scratch_.size();
+
+    if (block_type == kPcapngInterfaceDescription) {
+        read_interface_description(scratch_);
+        return true;
+    }
+
+    if (block_type == kPcapngEnhancedPacket && body_size >= 20) {
+        const uint32_t interface_id = u32(body);
+        const uint64_t ticks = (static_cast<uint64_t>(u32(body + 4)) << 32) | u32(body + 8);
+        const uint32_t captured = u32(body + 12);
+        if (interface_id >= interfaces_.size() || captured > body_size - 20) {
+            ++records_skipped_;
+            return true;
+        }
+        const Interface& iface = interfaces_[interface_id];
+        out.timestamp = ticks_to_ns(ticks, iface.ticks_per_second);
+        last_timestamp_ = out.timestamp;
+        produced = decode_frame(iface.link_type, body + 20, captured, out);
+        if (!produced) {
+            ++records_skipped_;
+        }
+        return true;
+    }
+
+    if (block_type == kPcapngSimplePacket && body_size >= 4) {
+        // Simple packets carry no timestamp; they inherit the previous one.
+        const size_t captured = std::min<size_t>(u32(body), body_size - 4);
+        if (interfaces_.empty()) {
+            ++records_skipped_;
+            return true;
+        }
+        out.timestamp = last_timestamp_;
+        produced = decode_frame(interfaces_.front().link_type, body + 4, captured, out);
+        if (!produced) {
+            ++records_skipped_;
+        }
+        return true;
+    }
+
+    // Name resolution, statistics, custom and obsolete blocks carry no datagrams.
+    return true;
+}
+
+void PcapReader::read_interface_description(const std::vector<uint8_t>& body) {
+    Interface iface;
+    if (body.size() < 8) {
+        interfaces_.push_back(iface);
+        return;
+    }
+    iface.link_type = u16(body.data());
+    size_t pos = 8;
+    while (pos + 4 <= body.size()) {
+        const uint16_t code = u16(body.data() + pos);
+        const uint16_t length = u16(body.data() + pos + 2);
+        pos += 4;
+        if (code == 0 || pos + length > body.size()) {
+            break;
+        }
+        if (code == kPcapngOptionTsResol && length >= 1) {
+            const uint8_t resolution = body[pos];
+            const uint8_t exponent = resolution & 0x7F;
+            uint64_t ticks = 1;
+            if (resolution & 0x80) {
+                ticks = exponent < 64 ? (1ull << exponent) : 0;
+            } else {
+                for (uint8_t i = 0; i < exponent && ticks <= UINT64_MAX / 10; ++i) {
+                    ticks *= 10;
+                }
+            }
+            if (ticks > 0) {
+                iface.ticks_per_second = ticks;
+            }
+        }
+        pos += (length + 3u) & ~3u;
+    }
+    interfaces_.push_back(iface);
+}
+
+bool PcapReader::decode_frame(uint16_t link_type, const uint8_t* data, size_t size, PcapUdpDatagram& out) {
+    size_t offset = 0;
+    switch (link_type) {
+        case kLinkTypeEthernet: {
+            if (size < 14) {
+                return false;
+            }
+            uint16_t ether_type = be16(data + 12);
+            offset = 14;
+            while ((ether_type == kEtherTypeVlan || ether_type == kEtherTypeQinQ) && size >= offset + 4) {
+                ether_type = be16(data + offset + 2);
+                offset += 4;
+            }
+            if (ether_type != kEtherTypeIpv4) {
+                return false;
+            }
+            break;
+        }
+        case kLinkTypeNull:
+            // The family is in the capturing host's byte order.
+            if (size < 4 || (le32(data) != 2 && be32(data) != 2)) {
+                return false;
+            }
+            offset = 4;
+            break;
+        case kLinkTypeLoop:
+            if (size < 4 || be32(data) != 2) {
+                return false;
+            }
+            offset = 4;
+            break;
+        case kLinkTypeRaw:
+        case kLinkTypeIpv4:
+            offset = 0;
+            break;
+        case kLinkTypeLinuxSll:
+            if (size < 16 || be16(data + 14) != kEtherTypeIpv4) {
+                return false;
+            }
+            offset = 16;
+            break;
+        case kLinkTypeLinuxSll2:
+            if (size < 20 || be16(data) != kEtherTypeIpv4) {
+                return false;
+            }
+            offset = 20;
+            break;
+        default:
+            return false;
+    }
+
+    const uint8_t* ip = data + offset;
+    const size_t ip_available = size - offset;
+    if (ip_available < 20 || (ip[0] >> 4) != 4) {
+        return false;
+    }
+    const size_t header_length = static_cast<size_t>(ip[0] & 0x0F) * 4;
+    const size_t total_length = std::min<size_t>(be16(ip + 2), ip_available);
+    const uint16_t fragment = be16(ip + 6);
+    if (header_length < 20 || total_length < header_length + 8 || ip[9] != kIpProtocolUdp ||
+        (fragment & 0x3FFF) != 0) {
+        // Fragments (more-fragments flag or non-zero offset) cannot be replayed on their own.
+        return false;
+    }
+
+    const uint8_t* udp = ip + header_length;
+    const size_t udp_available = total_length - header_length;
+    const size_t udp_length = std::min<size_t>(be16(udp + 4), udp_available);
+    if (udp_length < 8) {
+        return false;
+    }
+
+    std::memcpy(&out.source_address, ip + 12, sizeof(uint32_t));
+    std::memcpy(&out.destination_address, ip + 16, sizeof(uint32_t));
+    out.source_port = be16(udp);
+    out.destination_port = be16(udp + 2);
+    out.payload.assign(udp + 8, udp + udp_length);
+    return true;
+}
+
+} // namespace audio
+} // namespace screamrouter
@@ -0,0 +1,96 @@
+/**
+ * @file pcap_reader.h
+ * @brief Sequential reader for UDP datagrams in pcap and pcapng captures.
+ * @details Handles classic pcap (either byte order, microsecond or nanosecond timestamps)
+ *          and pcapng (section header, interface description, enhanced and simple packet
+ *          blocks). Ethernet (with VLAN tags), Linux cooked v1/v2, BSD loopback and raw
+ *          IPv4 link types are decoded; anything that is not an unfragmented IPv4/UDP
+ *          datagram is counted and skipped.
+ */
+#ifndef PCAP_READER_H
+#define PCAP_READER_H
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace screamrouter {
+namespace audio {
+
+/**
+ * @struct PcapUdpDatagram
+ * @brief One UDP datagram recovered from a capture.
+ */
+struct PcapUdpDatagram {
+    /** @brief Capture timestamp since the Unix epoch. */
+    std::chrono::nanoseconds timestamp{0};
+    /** @brief IPv4 addresses in network byte order, ports in host byte order. */
+    uint32_t source_address = 0;
+    uint16_t source_port = 0;
+    uint32_t destination_address = 0;
+    uint16_t destination_port = 0;
+    /** @brief UDP payload, without headers. */
+    std::vector<uint8_t> payload;
+};
+
+/**
+ * @class PcapReader
+ * @brief Reads UDP datagrams from a pcap or pcapng file in capture order.
+ */
+class PcapReader {
+public:
+    /**
+     * @brief Opens @p path and reads its file header.
+     * @throws std::runtime_error if the file cannot be opened or is not a capture.
+     */
+    explicit PcapReader(const std::string& path);
+
+    /**
+     * @brief Reads the next UDP datagram.
+     * @return false at the end of the file or on a truncated record.
+     */
+    bool next(PcapUdpDatagram& out);
+
+    /** @brief Returns to the first record. */
+    void rewind();
+
+    /** @brief Records read that were not IPv4/UDP, were fragments or used an unknown link type. */
+    uint64_t records_skipped() const { return records_skipped_; }
+
+    bool is_pcapng() const { return is_pcapng_; }
+
+private:
+    struct Interface {
+        uint16_t link_type = 0;
+        /** @brief Timestamp units per second (if_tsresol). */
+        uint64_t ticks_per_second = 1000000;
+    };
+
+    bool read_classic_record(PcapUdpDatagram& out);
+    bool read_pcapng_block(PcapUdpDatagram& out, bool& produced);
+    bool read_section_header(const std::vector<uint8_t>& body);
+    void read_interface_description(const std::vector<uint8_t>& body);
+    bool decode_frame(uint16_t link_type, const uint8_t* data, size_t size, PcapUdpDatagram& out);
+    uint16_t u16(const uint8_t* p) const;
+    uint32_t u32(const uint8_t* p) const;
+
+    std::string path_;
+    std::ifstream file_;
+    std::streampos first_record_{0};
+    bool is_pcapng_ = false;
+    /** @brief Header fields of the current file or section are big-endian. */
+    bool big_endian_ = false;
+    bool nanosecond_ = false;
+    uint16_t classic_link_type_ = 0;
+    std::vector<Interface> interfaces_;
+    std::chrono::nanoseconds last_timestamp_{0};
+    std::vector<uint8_t> scratch_;
+    uint64_t records_skipped_ = 0;
+};
+
+} // namespace audio
+} // namespace screamrouter
+
+#endif // PCAP_READER_H
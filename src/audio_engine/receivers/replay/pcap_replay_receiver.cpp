@@ -0,0 +1,193 @@
+#include "pcap_replay_receiver.h"
+#include "../../utils/cpp_logger.h"
+#include "../../utils/thread_priority.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace screamrouter {
+namespace audio {
+
+PcapReplayReceiver::PcapReplayReceiver(PcapReplayConfig config)
+    : config_(std::move(config)),
+      reader_(std::make_unique<PcapReader>(config_.file_path)) {
+    if (config_.speed < 0.0) {
+        config_.speed = 0.0;
+    }
+    LOG_CPP_INFO("[PcapReplay] Opened %s capture %s (speed=%.2f, loops=%d).",
+                 reader_->is_pcapng() ? "pcapng" : "pcap",
+                 config_.file_path.c_str(),
+                 config_.speed,
+                 config_.loop_count);
+}
+
+PcapReplayReceiver::~PcapReplayReceiver() noexcept {
+    stop();
+}
+
+void PcapReplayReceiver::add_target(uint16_t port, NetworkAudioReceiver* receiver) {
+    if (is_running()) {
+        LOG_CPP_WARNING("[PcapReplay] Ignoring add_target(%u) while the replay is running.", port);
+        return;
+    }
+    if (receiver) {
+        targets_[port] = receiver;
+    } else {
+        targets_.erase(port);
+    }
+}
+
+void PcapReplayReceiver::start() {
+    if (is_running()) {
+        LOG_CPP_WARNING("[PcapReplay] Already running.");
+        return;
+    }
+    if (component_thread_.joinable()) {
+        component_thread_.join();
+    }
+    if (targets_.empty()) {
+        LOG_CPP_WARNING("[PcapReplay] No receivers registered; every datagram will be counted as unrouted.");
+    }
+    stop_flag_ = false;
+    reader_->rewind();
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_ = PcapReplayStats{};
+    }
+    component_thread_ = std::thread([this]() { this->run(); });
+}
+
+void PcapReplayReceiver::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wait_mutex_);
+        stop_flag_ = true;
+    }
+    wait_cv_.notify_all();
+    if (component_thread_.joinable()) {
+        component_thread_.join();
+    }
+}
+
+PcapReplayStats PcapReplayReceiver::get_stats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return stats_;
+}
+
+bool PcapReplayReceiver::wait_until(std::chrono::steady_clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(wait_mutex_);
+    wait_cv_.wait_until(lock, deadline, [this]() { return stop_flag_.load(); });
+    return !stop_flag_;
+}
+
+void PcapReplayReceiver::inject(const PcapUdpDatagram& datagram) {
+    auto target = targets_.find(datagram.destination_port);
+    if (target == targets_.end()) {
+        target = targets_.find(0);
+    }
+    if (target == targets_.end() || datagram.payload.empty()) {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        ++stats_.datagrams_unrouted;
+        return;
+    }
+
+    struct sockaddr_in client_addr;
+    std::memset(&client_addr, 0, sizeof(client_addr));
+    client_addr.sin_family = AF_INET;
+    client_addr.sin_addr.s_addr = datagram.source_address;
+    client_addr.sin_port = htons(datagram.source_port);
+
+    target->second->inject_datagram(datagram.payload.data(),
+                                    static_cast<int>(datagram.payload.size()),
+                                    client_addr,
+                                    std::chrono::steady_clock::now());
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    ++stats_.datagrams_injected;
+    stats_.bytes_injected += datagram.payload.size();
+}
+
+void PcapReplayReceiver::run() {
+    utils::set_current_thread_realtime_priority("[PcapReplay]");
+    LOG_CPP_INFO("[PcapReplay] Replay thread started.");
+
+    const auto wall_start = std::chrono::steady_clock::now();
+    const bool paced = config_.speed > 0.0;
+    PcapUdpDatagram datagram;
+    uint32_t loops = 0;
+    // Media time of earlier passes, so each loop continues the schedule instead of restarting it.
+    std::chrono::nanoseconds schedule_offset{0};
+    std::chrono::nanoseconds last_capture_time{0};
+    std::chrono::nanoseconds mean_gap{0};
+
+    while (!stop_flag_) {
+        bool have_first = false;
+        std::chrono::nanoseconds first_capture_time{0};
+        uint64_t datagrams_this_pass = 0;
+
+        while (!stop_flag_ && reader_->next(datagram)) {
+            if (!have_first) {
+                have_first = true;
+                first_capture_time = datagram.timestamp;
+            }
+            // Captures can step backwards (clock changes, merged files); hold the schedule instead.
+            const auto capture_offset = std::max(datagram.timestamp - first_capture_time, last_capture_time);
+            last_capture_time = capture_offset;
+            ++datagrams_this_pass;
+
+            if (paced) {
+                const auto media_offset = schedule_offset + capture_offset;
+                const auto due = wall_start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                  std::chrono::duration<double, std::nano>(media_offset.count() / config_.speed));
+                if (!wait_until(due)) {
+                    break;
+                }
+                const double lateness_ms =
+                    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - due).count();
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                stats_.max_lateness_ms = std::max(stats_.max_lateness_ms, lateness_ms);
+            }
+
+            inject(datagram);
+            {
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                stats_.capture_seconds =
+                    std::chrono::duration<double>(schedule_offset + capture_offset).count();
+            }
+        }
+
+        if (stop_flag_) {
+            break;
+        }
+        ++loops;
+        if (datagrams_this_pass > 1) {
+            mean_gap = last_capture_time / static_cast<int64_t>(datagrams_this_pass - 1);
+        }
+        schedule_offset += last_capture_time + mean_gap;
+        last_capture_time = std::chrono::nanoseconds(0);
+        {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            stats_.loops_completed = loops;
+            stats_.records_skipped = reader_->records_skipped();
+        }
+        if (datagrams_this_pass == 0 || (config_.loop_count > 0 && loops >= static_cast<uint32_t>(config_.loop_count))) {
+            break;
+        }
+        reader_->rewind();
+    }
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_.records_skipped = reader_->records_skipped();
+    stats_.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+    stats_.finished = !stop_flag_;
+    LOG_CPP_INFO("[PcapReplay] Replay %s: %llu datagrams (%llu unrouted) in %.3fs, %u loop(s), max lateness %.2f ms.",
+                 stats_.finished ? "finished" : "stopped",
+                 static_cast<unsigned long long>(stats_.datagrams_injected),
+                 static_cast<unsigned long long>(stats_.datagrams_unrouted),
+                 stats_.wall_seconds,
+                 stats_.loops_completed,
+                 stats_.max_lateness_ms);
+}
+
+} // namespace audio
+} // namespace screamrouter
@@ -0,0 +1,94 @@
+/**
+ * @file pcap_replay_receiver.h
+ * @brief Replays UDP datagrams from a capture file into the network receivers.
+ * @details PcapReplayReceiver reads a pcap/pcapng file on its own thread and hands each
+ *          UDP payload to the receiver registered for its destination port through
+ *          NetworkAudioReceiver::inject_datagram(). The datagrams take the same parsing,
+ *          format-probe and RTP reordering path as live traffic, with the captured source
+ *          address, so field captures can be replayed at their original pace, accelerated,
+ *          or as fast as possible.
+ */
+#ifndef PCAP_REPLAY_RECEIVER_H
+#define PCAP_REPLAY_RECEIVER_H
+
+#include "pcap_reader.h"
+#include "../network_audio_receiver.h"
+#include "../../audio_types.h"
+#include "../../utils/audio_component.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace screamrouter {
+namespace audio {
+
+/**
+ * @struct PcapReplayStats
+ * @brief Progress counters of a replay.
+ */
+struct PcapReplayStats {
+    uint64_t datagrams_injected = 0;
+    uint64_t bytes_injected = 0;
+    /** @brief UDP datagrams whose destination port has no receiver. */
+    uint64_t datagrams_unrouted = 0;
+    /** @brief Capture records that were not IPv4/UDP datagrams. */
+    uint64_t records_skipped = 0;
+    uint32_t loops_completed = 0;
+    /** @brief Largest delay behind the paced schedule, in milliseconds; 0 when unpaced. */
+    double max_lateness_ms = 0.0;
+    /** @brief Media time covered by the captured timestamps so far. */
+    double capture_seconds = 0.0;
+    double wall_seconds = 0.0;
+    bool finished = false;
+};
+
+/**
+ * @class PcapReplayReceiver
+ * @brief An AudioComponent that feeds a capture file into existing receivers.
+ */
+class PcapReplayReceiver : public AudioComponent {
+public:
+    /**
+     * @brief Opens the capture named in @p config.
+     * @throws std::runtime_error if the file cannot be read as pcap or pcapng.
+     */
+    explicit PcapReplayReceiver(PcapReplayConfig config);
+    ~PcapReplayReceiver() noexcept override;
+
+    /**
+     * @brief Routes datagrams for @p port to @p receiver; port 0 catches every unrouted port.
+     * @note Must be called before start(). The receiver must outlive the replay.
+     */
+    void add_target(uint16_t port, NetworkAudioReceiver* receiver);
+
+    void start() override;
+    void stop() override;
+
+    PcapReplayStats get_stats() const;
+
+protected:
+    void run() override;
+
+private:
+    /** @brief Sleeps until @p deadline; returns false if stop() was called first. */
+    bool wait_until(std::chrono::steady_clock::time_point deadline);
+    void inject(const PcapUdpDatagram& datagram);
+
+    PcapReplayConfig config_;
+    std::unique_ptr<PcapReader> reader_;
+    std::map<uint16_t, NetworkAudioReceiver*> targets_;
+
+    std::mutex wait_mutex_;
+    std::condition_variable wait_cv_;
+
+    mutable std::mutex stats_mutex_;
+    PcapReplayStats stats_;
+};
+
+} // namespace audio
+} // namespace screamrouter
+
+#endif // PCAP_REPLAY_RECEIVER_H
@@ -5,6 +5,7 @@
 #include "../../input_processor/timeshift_manager.h"
 #include "../../utils/cpp_logger.h"
 #include "../../utils/sentinel_logging.h"
+#include "../../utils/span_tracer.h"
 #include "rtp_receiver_utils.h"
 #include "rtp_payload_defaults.h"
 
@@ -355,118 +356,128 @@ void RtpReceiverBase::run() {
                 continue;
             }
 
-            auto received_time = std::chrono::steady_clock::now();
-            const bool is_loopback =
-                (cliaddr.sin_family == AF_INET && ntohl(cliaddr.sin_addr.s_addr) == INADDR_LOOPBACK);
+            handle_datagram(raw_buffer, static_cast<int>(n_received), cliaddr, std::chrono::steady_clock::now());
 
-            if (static_cast<size_t>(n_received) < sizeof(rtc::RtpHeader)) {
-                if (is_loopback) {
-                    LOG_CPP_INFO("[RtpReceiver] Loopback packet dropped before RTP parse (size=%zd bytes).", n_received);
-                }
-                log_warning("Received packet too small to be an RTP packet (" + std::to_string(n_received) + " bytes).");
-                continue;
-            }
+#ifndef _WIN32
+        }
+#else
+        }
+#endif
+        maybe_log_telemetry();
+    }
+    log_message("RTP receiver thread finished.");
+}
 
-            const rtc::RtpHeader* rtp_header = reinterpret_cast<const rtc::RtpHeader*>(raw_buffer);
-            if (is_loopback) {
-                LOG_CPP_INFO("[RtpReceiver] Loopback recv seq=%u ssrc=0x%08X len=%zd",
-                             rtp_header->seqNumber(),
-                             rtp_header->ssrc(),
-                             n_received);
-            }
-            uint8_t pt = rtp_header->payloadType();
-            uint32_t current_ssrc = rtp_header->ssrc();
-
-            if (!supports_payload_type(pt, current_ssrc)) {
-                if (is_loopback) {
-                    LOG_CPP_INFO("[RtpReceiver] Loopback packet seq=%u filtered due to unsupported payload %u",
-                                 rtp_header->seqNumber(),
-                                 pt);
-                }
-                continue;
-            }
+void RtpReceiverBase::handle_datagram(const uint8_t* buffer,
+                                      int size,
+                                      const struct sockaddr_in& client_addr,
+                                      std::chrono::steady_clock::time_point received_time) {
+    const bool is_loopback =
+        (client_addr.sin_family == AF_INET && ntohl(client_addr.sin_addr.s_addr) == INADDR_LOOPBACK);
 
-            std::string source_key = get_source_key(cliaddr);
-            {
-                std::lock_guard<std::mutex> lock(source_ssrc_mutex_);
-                auto it = source_to_last_ssrc_.find(source_key);
-                if (it == source_to_last_ssrc_.end()) {
-                    source_to_last_ssrc_[source_key] = current_ssrc;
-                    char ssrc_hex[12];
-                    snprintf(ssrc_hex, sizeof(ssrc_hex), "0x%08X", current_ssrc);
-                    log_message("New RTP source detected: " + source_key + " with SSRC " + std::string(ssrc_hex));
-                } else if (it->second != current_ssrc) {
-                    uint32_t old_ssrc = it->second;
-                    handle_ssrc_changed(old_ssrc, current_ssrc, source_key);
-                    it->second = current_ssrc;
-                }
-            }
-            {
-                std::lock_guard<std::mutex> lock(ssrc_addr_mutex_);
-                ssrc_last_addr_[current_ssrc] = cliaddr;
-            }
+    if (static_cast<size_t>(size) < sizeof(rtc::RtpHeader)) {
+        if (is_loopback) {
+            LOG_CPP_INFO("[RtpReceiver] Loopback packet dropped before RTP parse (size=%d bytes).", size);
+        }
+        log_warning("Received packet too small to be an RTP packet (" + std::to_string(size) + " bytes).");
+        return;
+    }
 
-            RtpPacketData packet_data;
-            packet_data.sequence_number = rtp_header->seqNumber();
-            packet_data.rtp_timestamp = rtp_header->timestamp();
-            packet_data.received_time = received_time;
-            packet_data.ssrc = current_ssrc;
-            packet_data.payload_type = pt;
-            packet_data.ingress_from_loopback = is_loopback;
-
-            size_t header_len = 12 + (rtp_header->csrcCount() * sizeof(uint32_t));
-            if (static_cast<size_t>(n_received) < header_len) {
-                if (is_loopback) {
-                    LOG_CPP_INFO("[RtpReceiver] Loopback packet seq=%u dropped due to truncated header (expected=%zu, actual=%zd)",
-                                 rtp_header->seqNumber(),
-                                 header_len,
-                                 n_received);
-                }
-                log_warning("Received RTP packet smaller than its own header length. SSRC: 0x" + std::to_string(current_ssrc));
-                continue;
-            }
+    const rtc::RtpHeader* rtp_header = reinterpret_cast<const rtc::RtpHeader*>(buffer);
+    if (is_loopback) {
+        LOG_CPP_INFO("[RtpReceiver] Loopback recv seq=%u ssrc=0x%08X len=%d",
+                     rtp_header->seqNumber(),
+                     rtp_header->ssrc(),
+                     size);
+    }
+    uint8_t pt = rtp_header->payloadType();
+    uint32_t current_ssrc = rtp_header->ssrc();
 
-            const uint8_t* payload_data = raw_buffer + header_len;
-            size_t payload_len = n_received - header_len;
-            if (payload_len > 0) {
-                packet_data.payload.assign(payload_data, payload_data + payload_len);
-            }
+    if (!supports_payload_type(pt, current_ssrc)) {
+        if (is_loopback) {
+            LOG_CPP_INFO("[RtpReceiver] Loopback packet seq=%u filtered due to unsupported payload %u",
+                         rtp_header->seqNumber(),
+                         pt);
+        }
+        return;
+    }
 
-            const uint8_t csrc_count = rtp_header->csrcCount();
-            if (csrc_count > 0) {
-                const uint8_t* csrc_ptr = raw_buffer + 12;
-                for (uint8_t c = 0; c < csrc_count; c++) {
-                    uint32_t csrc;
-                    std::memcpy(&csrc, csrc_ptr, sizeof(uint32_t));
-                    packet_data.csrcs.push_back(ntohl(csrc));
-                    csrc_ptr += sizeof(uint32_t);
-                }
-            }
+    const uint64_t flow_id = utils::SpanTracer::instance().next_flow_id();
+    SR_TRACE_SPAN_FLOW("receive", flow_id);
 
-            {
-                std::lock_guard<std::mutex> lock(reordering_buffer_mutex_);
-                bool is_new_buffer = (reordering_buffers_.find(current_ssrc) == reordering_buffers_.end());
-                if (is_new_buffer) {
-                    char ssrc_hex[12];
-                    snprintf(ssrc_hex, sizeof(ssrc_hex), "0x%08X", current_ssrc);
-                    char client_ip_str[INET_ADDRSTRLEN];
-                    inet_ntop(AF_INET, &(cliaddr.sin_addr), client_ip_str, INET_ADDRSTRLEN);
-                    log_message("Creating new reordering buffer for SSRC " + std::string(ssrc_hex) +
-                                " from " + std::string(client_ip_str) + ":" + std::to_string(ntohs(cliaddr.sin_port)));
-                }
-                reordering_buffers_[current_ssrc].add_packet(std::move(packet_data));
-            }
+    std::string source_key = get_source_key(client_addr);
+    {
+        std::lock_guard<std::mutex> lock(source_ssrc_mutex_);
+        auto it = source_to_last_ssrc_.find(source_key);
+        if (it == source_to_last_ssrc_.end()) {
+            source_to_last_ssrc_[source_key] = current_ssrc;
+            char ssrc_hex[12];
+            snprintf(ssrc_hex, sizeof(ssrc_hex), "0x%08X", current_ssrc);
+            log_message("New RTP source detected: " + source_key + " with SSRC " + std::string(ssrc_hex));
+        } else if (it->second != current_ssrc) {
+            uint32_t old_ssrc = it->second;
+            handle_ssrc_changed(old_ssrc, current_ssrc, source_key);
+            it->second = current_ssrc;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(ssrc_addr_mutex_);
+        ssrc_last_addr_[current_ssrc] = client_addr;
+    }
+
+    RtpPacketData packet_data;
+    packet_data.sequence_number = rtp_header->seqNumber();
+    packet_data.rtp_timestamp = rtp_header->timestamp();
+    packet_data.received_time = received_time;
+    packet_data.ssrc = current_ssrc;
+    packet_data.payload_type = pt;
+    packet_data.ingress_from_loopback = is_loopback;
+    packet_data.trace_flow_id = flow_id;
+
+    size_t header_len = 12 + (rtp_header->csrcCount() * sizeof(uint32_t));
+    if (static_cast<size_t>(size) < header_len) {
+        if (is_loopback) {
+            LOG_CPP_INFO("[RtpReceiver] Loopback packet seq=%u dropped due to truncated header (expected=%zu, actual=%d)",
+                         rtp_header->seqNumber(),
+                         header_len,
+                         size);
+        }
+        log_warning("Received RTP packet smaller than its own header length. SSRC: 0x" + std::to_string(current_ssrc));
+        return;
+    }
 
-            process_ready_packets(current_ssrc, cliaddr);
+    const uint8_t* payload_data = buffer + header_len;
+    size_t payload_len = size - header_len;
+    if (payload_len > 0) {
+        packet_data.payload.assign(payload_data, payload_data + payload_len);
+    }
 
-#ifndef _WIN32
+    const uint8_t csrc_count = rtp_header->csrcCount();
+    if (csrc_count > 0) {
+        const uint8_t* csrc_ptr = buffer + 12;
+        for (uint8_t c = 0; c < csrc_count; c++) {
+            uint32_t csrc;
+            std::memcpy(&csrc, csrc_ptr, sizeof(uint32_t));
+            packet_data.csrcs.push_back(ntohl(csrc));
+            csrc_ptr += sizeof(uint32_t);
         }
-#else
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(reordering_buffer_mutex_);
+        bool is_new_buffer = (reordering_buffers_.find(current_ssrc) == reordering_buffers_.end());
+        if (is_new_buffer) {
+            char ssrc_hex[12];
+            snprintf(ssrc_hex, sizeof(ssrc_hex), "0x%08X", current_ssrc);
+            char client_ip_str[INET_ADDRSTRLEN];
+            inet_ntop(AF_INET, &(client_addr.sin_addr), client_ip_str, INET_ADDRSTRLEN);
+            log_message("Creating new reordering buffer for SSRC " + std::string(ssrc_hex) +
+                        " from " + std::string(client_ip_str) + ":" + std::to_string(ntohs(client_addr.sin_port)));
         }
-#endif
-        maybe_log_telemetry();
+        reordering_buffers_[current_ssrc].add_packet(std::move(packet_data));
     }
-    log_message("RTP receiver thread finished.");
+
+    process_ready_packets(current_ssrc, client_addr);
 }
 
 void RtpReceiverBase::open_dynamic_session(const std::string& ip, int port, const std::string& source_ip) {
@@ -853,6 +864,7 @@ void RtpReceiverBase::process_ready_packets_internal(uint32_t ssrc, const struct
         packet.rtp_timestamp = packet_data.rtp_timestamp;
         packet.rtp_sequence_number = packet_data.sequence_number;
         packet.ingress_from_loopback = packet_data.ingress_from_loopback;
+        packet.trace_flow_id = packet_data.trace_flow_id;
         packet.ssrcs.reserve(1 + packet_data.csrcs.size());
         packet.ssrcs.push_back(packet_data.ssrc);
         packet.ssrcs.insert(packet.ssrcs.end(), packet_data.csrcs.begin(), packet_data.csrcs.end());
@@ -92,6 +92,10 @@ protected:
         std::chrono::steady_clock::time_point received_time,
         TaggedAudioPacket& out_packet,
         std::string& out_source_tag) override;
+    void handle_datagram(const uint8_t* buffer,
+                         int size,
+                         const struct sockaddr_in& client_addr,
+                         std::chrono::steady_clock::time_point received_time) override;
 
     size_t get_receive_buffer_size() const override;
     int get_poll_timeout_ms() const override;
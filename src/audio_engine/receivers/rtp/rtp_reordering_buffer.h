@@ -21,6 +21,8 @@ struct RtpPacketData {
     std::vector<uint32_t> csrcs;
     uint8_t payload_type = 0;
     bool ingress_from_loopback = false;
+    /** @brief Trace flow started when the datagram arrived; 0 when tracing is off. */
+    uint64_t trace_flow_id = 0;
 };
 
 /**
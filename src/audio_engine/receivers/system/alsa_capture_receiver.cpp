@@ -2,12 +2,12 @@
 
 #include "../../utils/cpp_logger.h"
 #include "../../input_processor/timeshift_manager.h"
-#include "../../audio_processor/audio_processor.h"
 #include "../../configuration/audio_engine_settings.h"
 
 #include <algorithm>
 #include <cstring>
 #include <sstream>
+#include <time.h>
 
 namespace screamrouter {
 namespace audio {
@@ -29,6 +29,18 @@ bool parse_legacy_card_device(const std::string& value, int& card, int& device)
     }
     return true;
 }
+
+#if SCREAMROUTER_ALSA_CAPTURE_AVAILABLE
+int64_t monotonic_now_ns() {
+    struct timespec ts {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + static_cast<int64_t>(ts.tv_nsec);
+}
+
+int64_t htimestamp_ns(const snd_htimestamp_t& ts) {
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + static_cast<int64_t>(ts.tv_nsec);
+}
+#endif
 }
 
 AlsaCaptureReceiver::AlsaCaptureReceiver(
@@ -56,12 +68,16 @@ AlsaCaptureReceiver::AlsaCaptureReceiver(
         chunk_size_bytes_ = resolve_chunk_size_bytes(timeshift_manager ? timeshift_manager->get_settings() : nullptr);
     }
     chunk_bytes_ = chunk_size_bytes_;
-    chunk_buffer_.reserve(chunk_size_bytes_ * 2);
 #endif
 }
 
 AlsaCaptureReceiver::~AlsaCaptureReceiver() noexcept {
     stop();
+#if SCREAMROUTER_ALSA_CAPTURE_AVAILABLE
+    // The capture thread closes the device when it exits; this covers a device it never owned.
+    std::lock_guard<std::mutex> lock(device_mutex_);
+    close_device_locked();
+#endif
 }
 
 bool AlsaCaptureReceiver::setup_socket() {
@@ -90,18 +106,13 @@ void AlsaCaptureReceiver::run() {
     }
 
     while (!stop_flag_) {
-        snd_pcm_sframes_t frames_read = snd_pcm_readi(pcm_handle_, period_buffer_.data(), period_frames_);
-        if (frames_read == 0) {
-            continue;
-        }
+        const snd_pcm_sframes_t frames_read = mmap_access_ ? capture_mmap() : capture_readi();
         if (frames_read < 0) {
             if (!recover_from_error(static_cast<int>(frames_read))) {
                 LOG_CPP_ERROR("[AlsaCapture:%s] Unrecoverable ALSA read error. Exiting loop.", device_tag_.c_str());
                 break;
             }
-            continue;
         }
-        process_captured_frames(static_cast<size_t>(frames_read));
     }
 
     {
@@ -213,7 +224,15 @@ bool AlsaCaptureReceiver::open_device_locked() {
         return false;
     }
 
-    if ((err = snd_pcm_hw_params_set_access(pcm_handle_, hw_params, SND_PCM_ACCESS_RW_INTERLEAVED)) < 0) {
+    // Prefer mmap access so captured frames are copied from the DMA ring straight into packet
+    // payloads; plugins that cannot map their buffer keep the readi path.
+    mmap_access_ = false;
+    auto settings = timeshift_manager_ ? timeshift_manager_->get_settings() : nullptr;
+    const bool mmap_requested = !settings || settings->system_audio_tuning.alsa_mmap_enabled;
+    if (mmap_requested &&
+        snd_pcm_hw_params_set_access(pcm_handle_, hw_params, SND_PCM_ACCESS_MMAP_INTERLEAVED) == 0) {
+        mmap_access_ = true;
+    } else if ((err = snd_pcm_hw_params_set_access(pcm_handle_, hw_params, SND_PCM_ACCESS_RW_INTERLEAVED)) < 0) {
         LOG_CPP_ERROR("[AlsaCapture:%s] Failed to set interleaved access: %s", device_tag_.c_str(), snd_strerror(err));
         snd_pcm_hw_params_free(hw_params);
         close_device_locked();
@@ -292,6 +311,9 @@ bool AlsaCaptureReceiver::open_device_locked() {
         if (snd_pcm_sw_params_current(pcm_handle_, sw_params) == 0) {
             snd_pcm_sw_params_set_start_threshold(pcm_handle_, sw_params, period_frames_);
             snd_pcm_sw_params_set_avail_min(pcm_handle_, sw_params, period_frames_);
+            // Timestamp every hw pointer update on CLOCK_MONOTONIC so packets carry capture time.
+            snd_pcm_sw_params_set_tstamp_mode(pcm_handle_, sw_params, SND_PCM_TSTAMP_ENABLE);
+            snd_pcm_sw_params_set_tstamp_type(pcm_handle_, sw_params, SND_PCM_TSTAMP_TYPE_MONOTONIC);
             snd_pcm_sw_params(pcm_handle_, sw_params);
         }
         snd_pcm_sw_params_free(sw_params);
@@ -313,14 +335,21 @@ bool AlsaCaptureReceiver::open_device_locked() {
     }
     chunk_bytes_ = chunk_size_bytes_;
 
-    period_buffer_.assign(period_frames_ * bytes_per_frame_, 0u);
-    chunk_buffer_.clear();
-    chunk_buffer_.reserve(chunk_bytes_ * 2);
+    pending_chunk_.assign(chunk_bytes_, 0u);
+    pending_bytes_ = 0;
     running_timestamp_ = 0;
+    reset_capture_clock();
 
-    LOG_CPP_INFO("[AlsaCapture:%s] Opened %s (rate=%u Hz, channels=%u, bit_depth=%u, period=%lu frames).",
+    // readi starts the stream on the first read; an mmap capture has to be started explicitly.
+    if (mmap_access_ && (err = snd_pcm_start(pcm_handle_)) < 0) {
+        LOG_CPP_ERROR("[AlsaCapture:%s] Failed to start mmap capture: %s", device_tag_.c_str(), snd_strerror(err));
+        close_device_locked();
+        return false;
+    }
+
+    LOG_CPP_INFO("[AlsaCapture:%s] Opened %s (rate=%u Hz, channels=%u, bit_depth=%u, period=%lu frames, access=%s).",
                  device_tag_.c_str(), hw_device_name_.c_str(), active_sample_rate_, active_channels_, active_bit_depth_,
-                 static_cast<unsigned long>(period_frames_));
+                 static_cast<unsigned long>(period_frames_), mmap_access_ ? "mmap" : "rw");
 
     return true;
 }
@@ -331,6 +360,7 @@ void AlsaCaptureReceiver::close_device_locked() {
         snd_pcm_close(pcm_handle_);
         pcm_handle_ = nullptr;
     }
+    mmap_access_ = false;
 }
 
 bool AlsaCaptureReceiver::recover_from_error(int err) {
@@ -347,31 +377,150 @@ bool AlsaCaptureReceiver::recover_from_error(int err) {
         LOG_CPP_ERROR("[AlsaCapture:%s] snd_pcm_recover failed: %s", device_tag_.c_str(), snd_strerror(err));
         return false;
     }
+
+    // Frames were lost, so the partial chunk and the position/timestamp mapping are stale.
+    pending_bytes_ = 0;
+    reset_capture_clock();
+    if (mmap_access_ && (err = snd_pcm_start(pcm_handle_)) < 0) {
+        LOG_CPP_ERROR("[AlsaCapture:%s] Failed to restart mmap capture: %s", device_tag_.c_str(), snd_strerror(err));
+        return false;
+    }
     return true;
 }
 
-void AlsaCaptureReceiver::process_captured_frames(size_t frames_captured) {
-    if (frames_captured == 0) {
+#if defined(SCREAMROUTER_TESTING)
+bool AlsaCaptureReceiver::open_device_for_testing() {
+    std::lock_guard<std::mutex> lock(device_mutex_);
+    return open_device_locked();
+}
+
+void AlsaCaptureReceiver::set_capture_clock_for_testing(unsigned int sample_rate, int64_t stamp_ns,
+                                                        uint64_t stamp_position, int64_t trigger_ns) {
+    active_sample_rate_ = sample_rate;
+    stamp_ns_ = stamp_ns;
+    stamp_position_ = stamp_position;
+    trigger_ns_ = trigger_ns;
+}
+#endif
+
+void AlsaCaptureReceiver::reset_capture_clock() {
+    frames_captured_total_ = 0;
+    stamp_ns_ = 0;
+    stamp_position_ = 0;
+    trigger_ns_ = 0;
+}
+
+snd_pcm_sframes_t AlsaCaptureReceiver::capture_readi() {
+    const size_t room_frames = (chunk_bytes_ - pending_bytes_) / bytes_per_frame_;
+    const snd_pcm_uframes_t wanted = std::min<snd_pcm_uframes_t>(period_frames_, room_frames);
+    const snd_pcm_sframes_t frames_read = snd_pcm_readi(pcm_handle_, pending_chunk_.data() + pending_bytes_, wanted);
+    if (frames_read <= 0) {
+        return frames_read;
+    }
+    frames_captured_total_ += static_cast<uint64_t>(frames_read);
+    refresh_timestamp();
+    commit_frames(static_cast<size_t>(frames_read));
+    return frames_read;
+}
+
+snd_pcm_sframes_t AlsaCaptureReceiver::capture_mmap() {
+    int err = snd_pcm_wait(pcm_handle_, get_poll_timeout_ms() * 2);
+    if (err <= 0) {
+        return err;
+    }
+    snd_pcm_sframes_t avail = snd_pcm_avail_update(pcm_handle_);
+    if (avail <= 0) {
+        return avail;
+    }
+    // The timestamp pairs with the pointer avail_update just synced, before anything is consumed.
+    refresh_timestamp();
+
+    snd_pcm_sframes_t total = 0;
+    while (avail > 0) {
+        const size_t room_frames = (chunk_bytes_ - pending_bytes_) / bytes_per_frame_;
+        const snd_pcm_channel_area_t* areas = nullptr;
+        snd_pcm_uframes_t offset = 0;
+        snd_pcm_uframes_t frames = std::min<snd_pcm_uframes_t>(static_cast<snd_pcm_uframes_t>(avail), room_frames);
+        if ((err = snd_pcm_mmap_begin(pcm_handle_, &areas, &offset, &frames)) < 0) {
+            return err;
+        }
+        // Interleaved access: every channel shares one area, and the first one's step is the frame.
+        const uint8_t* src = static_cast<const uint8_t*>(areas[0].addr) + (areas[0].first + offset * areas[0].step) / 8;
+        std::memcpy(pending_chunk_.data() + pending_bytes_, src, frames * bytes_per_frame_);
+        const snd_pcm_sframes_t committed = snd_pcm_mmap_commit(pcm_handle_, offset, frames);
+        if (committed < 0) {
+            return committed;
+        }
+        frames_captured_total_ += static_cast<uint64_t>(committed);
+        commit_frames(static_cast<size_t>(committed));
+        avail -= committed;
+        total += committed;
+        if (committed == 0) {
+            break;
+        }
+    }
+    return total;
+}
+
+void AlsaCaptureReceiver::commit_frames(size_t frames) {
+    pending_bytes_ += frames * bytes_per_frame_;
+    if (pending_bytes_ < chunk_bytes_) {
         return;
     }
-    const size_t bytes_captured = frames_captured * bytes_per_frame_;
-    const uint8_t* src = period_buffer_.data();
-    chunk_buffer_.write(src, bytes_captured);
+    // The filled payload moves into the packet as-is; the next chunk gets a fresh buffer.
+    std::vector<uint8_t> chunk;
+    chunk.swap(pending_chunk_);
+    pending_chunk_.resize(chunk_bytes_);
+    pending_bytes_ = 0;
+    dispatch_chunk(std::move(chunk), capture_time_of(frames_captured_total_));
+}
+
+void AlsaCaptureReceiver::refresh_timestamp() {
+    snd_pcm_uframes_t avail = 0;
+    snd_htimestamp_t stamp{};
+    if (snd_pcm_htimestamp(pcm_handle_, &avail, &stamp) == 0 && htimestamp_ns(stamp) > 0) {
+        stamp_ns_ = htimestamp_ns(stamp);
+        stamp_position_ = frames_captured_total_ + avail;
+        return;
+    }
+    stamp_ns_ = 0;
 
-    while (chunk_buffer_.size() >= chunk_bytes_) {
-        std::vector<uint8_t> chunk(chunk_bytes_);
-        const std::size_t popped = chunk_buffer_.pop(chunk.data(), chunk_bytes_);
-        if (popped != chunk_bytes_) {
-            if (popped > 0) {
-                chunk_buffer_.write(chunk.data(), popped);
+    // No per-update stamps from this driver: fall back to the trigger time of the stream start.
+    if (trigger_ns_ == 0) {
+        snd_pcm_status_t* status = nullptr;
+        if (snd_pcm_status_malloc(&status) == 0 && status) {
+            if (snd_pcm_status(pcm_handle_, status) == 0) {
+                snd_htimestamp_t trigger{};
+                snd_pcm_status_get_trigger_htstamp(status, &trigger);
+                trigger_ns_ = htimestamp_ns(trigger);
             }
-            break;
+            snd_pcm_status_free(status);
         }
-        dispatch_chunk(std::move(chunk));
     }
 }
 
-void AlsaCaptureReceiver::dispatch_chunk(std::vector<uint8_t>&& chunk_data) {
+std::chrono::steady_clock::time_point AlsaCaptureReceiver::capture_time_of(uint64_t frame_end) const {
+    const auto steady_now = std::chrono::steady_clock::now();
+    if (active_sample_rate_ == 0) {
+        return steady_now;
+    }
+
+    int64_t captured_ns = 0;
+    if (stamp_ns_ > 0) {
+        // Frames behind the stamped hw pointer were captured earlier by their duration.
+        const int64_t behind = static_cast<int64_t>(stamp_position_) - static_cast<int64_t>(frame_end);
+        captured_ns = stamp_ns_ - behind * 1000000000LL / static_cast<int64_t>(active_sample_rate_);
+    } else if (trigger_ns_ > 0) {
+        captured_ns = trigger_ns_ + static_cast<int64_t>(frame_end * 1000000000ull / active_sample_rate_);
+    } else {
+        return steady_now;
+    }
+    const int64_t age_ns = monotonic_now_ns() - captured_ns;
+    return steady_now - std::chrono::nanoseconds(std::max<int64_t>(age_ns, 0));
+}
+
+void AlsaCaptureReceiver::dispatch_chunk(std::vector<uint8_t>&& chunk_data,
+                                         std::chrono::steady_clock::time_point received_time) {
     if (chunk_data.size() != chunk_bytes_) {
         return;
     }
@@ -382,7 +531,7 @@ void AlsaCaptureReceiver::dispatch_chunk(std::vector<uint8_t>&& chunk_data) {
     TaggedAudioPacket packet;
     packet.source_tag = device_tag_;
     packet.audio_data = std::move(chunk_data);
-    packet.received_time = std::chrono::steady_clock::now();
+    packet.received_time = received_time;
     packet.channels = static_cast<int>(active_channels_);
     packet.sample_rate = static_cast<int>(active_sample_rate_);
     packet.bit_depth = static_cast<int>(active_bit_depth_);
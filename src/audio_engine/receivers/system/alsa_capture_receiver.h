@@ -7,8 +7,7 @@
 #include <mutex>
 #include <atomic>
 #include <chrono>
-
-#include "../../utils/byte_ring_buffer.h"
+#include <cstdint>
 
 #if defined(__linux__) && defined(__has_include)
 #  if __has_include(<alsa/asoundlib.h>)
@@ -39,6 +38,19 @@ public:
 
     ~AlsaCaptureReceiver() noexcept override;
 
+#if defined(SCREAMROUTER_TESTING) && SCREAMROUTER_ALSA_CAPTURE_AVAILABLE
+    /** @brief Opens and starts the device without the capture thread; it is closed on destruction. */
+    bool open_device_for_testing();
+    /** @brief Runs one iteration of the capture loop: a readi() or one mmap pass over what is available. */
+    snd_pcm_sframes_t capture_once_for_testing() { return mmap_access_ ? capture_mmap() : capture_readi(); }
+    bool uses_mmap_for_testing() const { return mmap_access_; }
+    snd_pcm_uframes_t buffer_frames_for_testing() const { return buffer_frames_; }
+    uint64_t frames_captured_for_testing() const { return frames_captured_total_; }
+    /** @brief Replaces the capture clock so capture_time_of() can be checked against known stamps. */
+    void set_capture_clock_for_testing(unsigned int sample_rate, int64_t stamp_ns, uint64_t stamp_position, int64_t trigger_ns);
+    std::chrono::steady_clock::time_point capture_time_for_testing(uint64_t frame_end) const { return capture_time_of(frame_end); }
+#endif
+
 protected:
     bool setup_socket() override;
     void close_socket() override;
@@ -60,8 +72,13 @@ private:
     bool open_device_locked();
     void close_device_locked();
     bool recover_from_error(int err);
-    void process_captured_frames(size_t frames_captured);
-    void dispatch_chunk(std::vector<uint8_t>&& chunk_data);
+    snd_pcm_sframes_t capture_readi();
+    snd_pcm_sframes_t capture_mmap();
+    void commit_frames(size_t frames);
+    void reset_capture_clock();
+    void refresh_timestamp();
+    std::chrono::steady_clock::time_point capture_time_of(uint64_t frame_end) const;
+    void dispatch_chunk(std::vector<uint8_t>&& chunk_data, std::chrono::steady_clock::time_point received_time);
     std::string resolve_hw_id() const;
 
     std::string device_tag_;
@@ -81,9 +98,18 @@ private:
     size_t bytes_per_frame_ = 0;
     size_t chunk_bytes_ = 0;
     uint32_t running_timestamp_ = 0;
-
-    std::vector<uint8_t> period_buffer_;
-    ::screamrouter::audio::utils::ByteRingBuffer chunk_buffer_;
+    bool mmap_access_ = false;
+
+    // Payload of the packet being captured; readi() or the mmap copy lands here directly.
+    std::vector<uint8_t> pending_chunk_;
+    size_t pending_bytes_ = 0;
+
+    // Capture clock: frames taken from the device since it was (re)started, and the latest
+    // hardware timestamp with the device position it belongs to (CLOCK_MONOTONIC ns, 0 = none).
+    uint64_t frames_captured_total_ = 0;
+    int64_t stamp_ns_ = 0;
+    uint64_t stamp_position_ = 0;
+    int64_t trigger_ns_ = 0;
 
     std::mutex device_mutex_;
 #else
@@ -22,6 +22,11 @@ namespace {
 constexpr uint8_t kStereoLayout = 0x03;
 constexpr uint8_t kMonoLayout = 0x01;
 constexpr size_t kFramesPerChunk = 1024;
+// How long the capture thread sleeps on the ring doorbell before refreshing its heartbeat.
+constexpr int kRingWaitMs = 100;
+// Plugins built before the ring existed never publish one; don't stat for it on every read.
+constexpr auto kRingProbeInterval = std::chrono::milliseconds(500);
+constexpr auto kRingDropLogInterval = std::chrono::seconds(1);
 }
 
 ScreamrouterFifoReceiver::ScreamrouterFifoReceiver(
@@ -80,12 +85,46 @@ void ScreamrouterFifoReceiver::run() {
 
     while (!stop_flag_) {
         if (fifo_fd_ < 0) {
+            detach_ring();
             if (!open_fifo()) {
                 std::this_thread::sleep_for(std::chrono::milliseconds(50));
                 continue;
             }
         }
 
+        if (!ring_ && std::chrono::steady_clock::now() >= next_ring_probe_) {
+            next_ring_probe_ = std::chrono::steady_clock::now() + kRingProbeInterval;
+            try_attach_ring();
+        }
+
+        if (ring_) {
+            ring_->heartbeat();
+            report_ring_drops();
+            // The plugin finishes a FIFO transfer before it writes the ring, so once ring frames
+            // are visible the FIFO holds nothing newer: take its tail one last time, then read the
+            // ring alone. The FIFO is only polled again when the ring comes up empty, which is
+            // also how a fallback after a stalled heartbeat is noticed.
+            if (!fifo_retired_) {
+                const bool plugin_on_ring = ring_->readable_frames() > 0;
+                drain_fifo_leftovers();
+                fifo_retired_ = plugin_on_ring;
+            }
+            const bool drained = drain_ring();
+            if (!drained && fifo_retired_ && drain_fifo_leftovers()) {
+                fifo_retired_ = false;
+            }
+            if (!drained) {
+                if (ring_->is_orphaned()) {
+                    LOG_CPP_INFO("[SR-FIFO:%s] Plugin closed its shared ring, falling back to FIFO.", device_tag_.c_str());
+                    detach_ring();
+                    close_fifo();
+                    continue;
+                }
+                ring_->wait(chunk_bytes_ / bytes_per_frame_, kRingWaitMs);
+            }
+            continue;
+        }
+
         struct pollfd pfd { fifo_fd_, POLLIN, 0 };
         int poll_result = poll(&pfd, 1, 100);
         if (poll_result < 0) {
@@ -122,19 +161,10 @@ void ScreamrouterFifoReceiver::run() {
         }
 
         chunk_buffer_.write(read_buffer_.data(), static_cast<std::size_t>(bytes_read));
-        while (chunk_buffer_.size() >= chunk_bytes_) {
-            std::vector<uint8_t> chunk(chunk_bytes_);
-            const std::size_t popped = chunk_buffer_.pop(chunk.data(), chunk_bytes_);
-            if (popped != chunk_bytes_) {
-                if (popped > 0) {
-                    chunk_buffer_.write(chunk.data(), popped);
-                }
-                break;
-            }
-            dispatch_chunk(std::move(chunk));
-        }
+        flush_chunk_buffer(std::chrono::steady_clock::now());
     }
 
+    detach_ring();
     close_fifo();
     LOG_CPP_INFO("[SR-FIFO:%s] Capture thread exiting.", device_tag_.c_str());
 #else
@@ -211,7 +241,117 @@ void ScreamrouterFifoReceiver::close_fifo() {
     }
 }
 
-void ScreamrouterFifoReceiver::dispatch_chunk(std::vector<uint8_t>&& chunk_data) {
+bool ScreamrouterFifoReceiver::try_attach_ring() {
+    if (fifo_path_.empty()) {
+        return false;
+    }
+    const std::string ring_path = ScreamrouterShmRing::ring_path_for(fifo_path_);
+    std::string error;
+    auto ring = ScreamrouterShmRing::attach(ring_path, &error);
+    if (!ring) {
+        return false;
+    }
+    if (ring->frame_bytes() != bytes_per_frame_ || ring->rate() != sample_rate_ || ring->channels() != channels_) {
+        LOG_CPP_WARNING("[SR-FIFO:%s] Ignoring shared ring %s: %u ch/%u Hz/%zu-byte frames does not match the FIFO format.",
+                        device_tag_.c_str(), ring_path.c_str(), ring->channels(), ring->rate(), ring->frame_bytes());
+        return false;
+    }
+
+    ring_ = std::move(ring);
+    // Drops from before this attach belong to an earlier reader.
+    ring_dropped_frames_seen_ = ring_->dropped_frames();
+    LOG_CPP_INFO("[SR-FIFO:%s] Attached shared ring %s (%zu frames).",
+                 device_tag_.c_str(), ring_path.c_str(), ring_->capacity_frames());
+    return true;
+}
+
+void ScreamrouterFifoReceiver::detach_ring() {
+    ring_.reset();
+    next_ring_probe_ = std::chrono::steady_clock::time_point{};
+    fifo_retired_ = false;
+    ring_dropped_frames_seen_ = 0;
+}
+
+void ScreamrouterFifoReceiver::report_ring_drops() {
+    const uint64_t dropped = ring_->dropped_frames();
+    if (dropped <= ring_dropped_frames_seen_) {
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (now - last_ring_drop_log_time_ < kRingDropLogInterval) {
+        return;
+    }
+    LOG_CPP_WARNING("[SR-FIFO:%s] Shared ring overran; plugin dropped %llu frame(s) (%llu total).",
+                    device_tag_.c_str(),
+                    static_cast<unsigned long long>(dropped - ring_dropped_frames_seen_),
+                    static_cast<unsigned long long>(dropped));
+    ring_dropped_frames_seen_ = dropped;
+    last_ring_drop_log_time_ = now;
+}
+
+bool ScreamrouterFifoReceiver::drain_ring() {
+    const std::size_t frames_per_chunk = chunk_bytes_ / bytes_per_frame_;
+    bool consumed = false;
+
+    // Complete a chunk started from FIFO bytes first so the switch-over keeps stream order.
+    if (!chunk_buffer_.empty()) {
+        const std::size_t missing_frames = (chunk_bytes_ - chunk_buffer_.size()) / bytes_per_frame_;
+        const auto received_time = ring_->time_of_frame(ring_->read_position());
+        const std::size_t got = ring_->read(read_buffer_.data(), missing_frames);
+        if (got == 0) {
+            return false;
+        }
+        chunk_buffer_.write(read_buffer_.data(), got * bytes_per_frame_);
+        flush_chunk_buffer(received_time);
+        consumed = true;
+        if (!chunk_buffer_.empty()) {
+            return consumed;
+        }
+    }
+
+    while (ring_->readable_frames() >= frames_per_chunk) {
+        const auto received_time = ring_->time_of_frame(ring_->read_position());
+        std::vector<uint8_t> chunk(chunk_bytes_);
+        ring_->read(chunk.data(), frames_per_chunk);
+        dispatch_chunk(std::move(chunk), received_time);
+        consumed = true;
+    }
+    return consumed;
+}
+
+bool ScreamrouterFifoReceiver::drain_fifo_leftovers() {
+    if (fifo_fd_ < 0) {
+        return false;
+    }
+    bool consumed = false;
+    for (;;) {
+        const ssize_t bytes_read = read(fifo_fd_, read_buffer_.data(), read_buffer_.size());
+        if (bytes_read <= 0) {
+            // EAGAIN once drained; EOF just means the plugin is not holding the FIFO open.
+            return consumed;
+        }
+        chunk_buffer_.write(read_buffer_.data(), static_cast<std::size_t>(bytes_read));
+        flush_chunk_buffer(std::chrono::steady_clock::now());
+        consumed = true;
+    }
+}
+
+void ScreamrouterFifoReceiver::flush_chunk_buffer(std::chrono::steady_clock::time_point received_time) {
+    while (chunk_buffer_.size() >= chunk_bytes_) {
+        std::vector<uint8_t> chunk(chunk_bytes_);
+        const std::size_t popped = chunk_buffer_.pop(chunk.data(), chunk_bytes_);
+        if (popped != chunk_bytes_) {
+            if (popped > 0) {
+                chunk_buffer_.write(chunk.data(), popped);
+            }
+            break;
+        }
+        dispatch_chunk(std::move(chunk), received_time);
+    }
+}
+
+void ScreamrouterFifoReceiver::dispatch_chunk(std::vector<uint8_t>&& chunk_data,
+                                              std::chrono::steady_clock::time_point received_time) {
     if (chunk_data.size() != chunk_bytes_) {
         return;
     }
@@ -219,7 +359,7 @@ void ScreamrouterFifoReceiver::dispatch_chunk(std::vector<uint8_t>&& chunk_data)
     TaggedAudioPacket packet;
     packet.source_tag = device_tag_;
     packet.audio_data = std::move(chunk_data);
-    packet.received_time = std::chrono::steady_clock::now();
+    packet.received_time = received_time;
     packet.channels = static_cast<int>(channels_);
     packet.sample_rate = static_cast<int>(sample_rate_);
     packet.bit_depth = static_cast<int>(bit_depth_);
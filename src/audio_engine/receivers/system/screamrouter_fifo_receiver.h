@@ -2,6 +2,8 @@
 
 #include "../network_audio_receiver.h"
 
+#include <chrono>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -13,6 +15,10 @@
 #define SCREAMROUTER_FIFO_CAPTURE_AVAILABLE 0
 #endif
 
+#if SCREAMROUTER_FIFO_CAPTURE_AVAILABLE
+#include "screamrouter_shm_ring.h"
+#endif
+
 namespace screamrouter {
 namespace audio {
 
@@ -45,7 +51,17 @@ private:
 #if SCREAMROUTER_FIFO_CAPTURE_AVAILABLE
     bool open_fifo();
     void close_fifo();
-    void dispatch_chunk(std::vector<uint8_t>&& chunk_data);
+    /// Maps the plugin's shared ring if it published one for this FIFO.
+    bool try_attach_ring();
+    void detach_ring();
+    /// Moves every complete chunk out of the ring. Returns true if any frames were consumed.
+    bool drain_ring();
+    /// Picks up bytes the plugin wrote to the FIFO instead of the ring. Returns true if any were read.
+    bool drain_fifo_leftovers();
+    /// Logs frames the plugin dropped on a full ring, at most once per second.
+    void report_ring_drops();
+    void flush_chunk_buffer(std::chrono::steady_clock::time_point received_time);
+    void dispatch_chunk(std::vector<uint8_t>&& chunk_data, std::chrono::steady_clock::time_point received_time);
 #endif
 
     std::string device_tag_;
@@ -62,6 +78,11 @@ private:
     uint32_t running_timestamp_ = 0;
     std::vector<uint8_t> read_buffer_;
     ::screamrouter::audio::utils::ByteRingBuffer chunk_buffer_;
+    std::unique_ptr<ScreamrouterShmRing> ring_;
+    std::chrono::steady_clock::time_point next_ring_probe_{};
+    bool fifo_retired_ = false; ///< True once the plugin writes the ring and the FIFO is drained.
+    uint64_t ring_dropped_frames_seen_ = 0;
+    std::chrono::steady_clock::time_point last_ring_drop_log_time_{};
 #endif
 };
 
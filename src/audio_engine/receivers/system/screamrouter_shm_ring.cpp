@@ -0,0 +1,213 @@
+#include "screamrouter_shm_ring.h"
+
+#if defined(__linux__)
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace screamrouter {
+namespace audio {
+
+namespace {
+
+uint64_t monotonic_now_ns() {
+    struct timespec ts {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+template <typename T>
+T load_acquire(const T& value) {
+    return __atomic_load_n(&value, __ATOMIC_ACQUIRE);
+}
+
+template <typename T>
+void store_release(T& value, T desired) {
+    __atomic_store_n(&value, desired, __ATOMIC_RELEASE);
+}
+
+} // namespace
+
+std::string ScreamrouterShmRing::ring_path_for(const std::string& fifo_path) {
+    const auto slash = fifo_path.find_last_of('/');
+    if (slash == std::string::npos) {
+        return "." + fifo_path + ".ring";
+    }
+    return fifo_path.substr(0, slash + 1) + "." + fifo_path.substr(slash + 1) + ".ring";
+}
+
+std::unique_ptr<ScreamrouterShmRing> ScreamrouterShmRing::attach(const std::string& path, std::string* error) {
+    auto fail = [error](const std::string& what) -> std::unique_ptr<ScreamrouterShmRing> {
+        if (error) {
+            *error = what;
+        }
+        return nullptr;
+    };
+
+    std::unique_ptr<ScreamrouterShmRing> ring(new ScreamrouterShmRing());
+    ring->fd_ = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+    if (ring->fd_ < 0) {
+        return fail(std::string("open: ") + std::strerror(errno));
+    }
+
+    struct stat st {};
+    if (::fstat(ring->fd_, &st) < 0 || !S_ISREG(st.st_mode) ||
+        static_cast<std::size_t>(st.st_size) < sizeof(ScreamrouterShmRingHeader)) {
+        return fail("not a ring file");
+    }
+    ring->block_size_ = static_cast<std::size_t>(st.st_size);
+
+    void* mapped = ::mmap(nullptr, ring->block_size_, PROT_READ | PROT_WRITE, MAP_SHARED, ring->fd_, 0);
+    if (mapped == MAP_FAILED) {
+        return fail(std::string("mmap: ") + std::strerror(errno));
+    }
+    ring->block_ = static_cast<uint8_t*>(mapped);
+
+    const ScreamrouterShmRingHeader* h = ring->header();
+    if (h->magic != ScreamrouterShmRingHeader::kMagic || h->version != ScreamrouterShmRingHeader::kVersion) {
+        return fail("unknown ring layout");
+    }
+    const std::size_t data_bytes = static_cast<std::size_t>(h->frame_bytes) * h->capacity_frames;
+    if (h->frame_bytes == 0 || h->capacity_frames == 0 || h->data_offset < sizeof(ScreamrouterShmRingHeader) ||
+        h->data_offset > ring->block_size_ || data_bytes > ring->block_size_ - h->data_offset) {
+        return fail("ring header does not fit the file");
+    }
+
+    ring->data_ = ring->block_ + h->data_offset;
+    ring->frame_bytes_ = h->frame_bytes;
+    ring->capacity_frames_ = h->capacity_frames;
+    ring->rate_ = h->rate;
+    ring->channels_ = h->channels;
+    ring->bit_depth_ = h->bit_depth;
+
+    // Anything left behind by a previous reader is stale; start at the live edge.
+    ring->read_frames_ = load_acquire(h->write_frames);
+    ScreamrouterShmRingHeader* mutable_header = ring->header();
+    store_release(mutable_header->read_frames, ring->read_frames_);
+    store_release(mutable_header->reader_pid, static_cast<uint32_t>(::getpid()));
+    ring->heartbeat();
+    return ring;
+}
+
+ScreamrouterShmRing::~ScreamrouterShmRing() {
+    if (block_) {
+        ScreamrouterShmRingHeader* h = header();
+        if (h->magic == ScreamrouterShmRingHeader::kMagic) {
+            store_release(h->reader_heartbeat_ns, uint64_t{0});
+            store_release(h->reader_waiting, uint32_t{0});
+        }
+        ::munmap(block_, block_size_);
+        block_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+ScreamrouterShmRingHeader* ScreamrouterShmRing::header() const {
+    return reinterpret_cast<ScreamrouterShmRingHeader*>(block_);
+}
+
+std::size_t ScreamrouterShmRing::readable_frames() const {
+    const uint64_t written = load_acquire(header()->write_frames);
+    if (written <= read_frames_) {
+        return 0;
+    }
+    // The plugin never overwrites unread frames; the clamp only keeps a corrupt header
+    // from walking us off the mapping.
+    return static_cast<std::size_t>(std::min<uint64_t>(written - read_frames_, capacity_frames_));
+}
+
+const uint8_t* ScreamrouterShmRing::peek(std::size_t& frames) const {
+    const std::size_t index = static_cast<std::size_t>(read_frames_ % capacity_frames_);
+    frames = std::min({frames, readable_frames(), capacity_frames_ - index});
+    return data_ + index * frame_bytes_;
+}
+
+void ScreamrouterShmRing::consume(std::size_t frames) {
+    read_frames_ += frames;
+    store_release(header()->read_frames, read_frames_);
+}
+
+std::size_t ScreamrouterShmRing::read(uint8_t* out, std::size_t max_frames) {
+    std::size_t total = 0;
+    while (total < max_frames) {
+        std::size_t frames = max_frames - total;
+        const uint8_t* src = peek(frames);
+        if (frames == 0) {
+            break;
+        }
+        std::memcpy(out + total * frame_bytes_, src, frames * frame_bytes_);
+        consume(frames);
+        total += frames;
+    }
+    return total;
+}
+
+uint64_t ScreamrouterShmRing::dropped_frames() const {
+    return __atomic_load_n(&header()->dropped_frames, __ATOMIC_RELAXED);
+}
+
+std::chrono::steady_clock::time_point ScreamrouterShmRing::time_of_frame(uint64_t position) const {
+    const ScreamrouterShmRingHeader* h = header();
+    const uint64_t written = load_acquire(h->write_frames);
+    const uint64_t written_at = load_acquire(h->write_time_ns);
+    const auto steady_now = std::chrono::steady_clock::now();
+    if (written_at == 0 || rate_ == 0) {
+        return steady_now;
+    }
+
+    // Frames before the publish point were written earlier by their duration at the stream rate.
+    int64_t stamp_ns = static_cast<int64_t>(written_at);
+    if (position < written) {
+        stamp_ns -= static_cast<int64_t>((written - position) * 1000000000ull / rate_);
+    }
+    const int64_t age_ns = static_cast<int64_t>(monotonic_now_ns()) - stamp_ns;
+    return steady_now - std::chrono::nanoseconds(std::max<int64_t>(age_ns, 0));
+}
+
+void ScreamrouterShmRing::heartbeat() {
+    store_release(header()->reader_heartbeat_ns, monotonic_now_ns());
+}
+
+bool ScreamrouterShmRing::wait(std::size_t min_frames, int timeout_ms) {
+    min_frames = std::max<std::size_t>(min_frames, 1);
+    if (readable_frames() >= min_frames) {
+        return true;
+    }
+
+    ScreamrouterShmRingHeader* h = header();
+    const uint32_t seen = load_acquire(h->doorbell);
+    // Pairs with the plugin's store of write_frames followed by its load of reader_waiting:
+    // either it sees us waiting and wakes us, or we see its frames here.
+    __atomic_store_n(&h->reader_waiting, 1u, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&h->write_frames, __ATOMIC_SEQ_CST) < read_frames_ + min_frames) {
+        struct timespec timeout {};
+        timeout.tv_sec = timeout_ms / 1000;
+        timeout.tv_nsec = static_cast<long>(timeout_ms % 1000) * 1000000L;
+        // Shared (non-private) futex: the word lives in a MAP_SHARED file mapping.
+        ::syscall(SYS_futex, &h->doorbell, FUTEX_WAIT, seen, &timeout, nullptr, 0);
+    }
+    __atomic_store_n(&h->reader_waiting, 0u, __ATOMIC_SEQ_CST);
+    return readable_frames() >= min_frames;
+}
+
+bool ScreamrouterShmRing::is_orphaned() const {
+    struct stat st {};
+    return ::fstat(fd_, &st) < 0 || st.st_nlink == 0;
+}
+
+} // namespace audio
+} // namespace screamrouter
+
+#endif // __linux__
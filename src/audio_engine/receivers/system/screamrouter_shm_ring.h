@@ -0,0 +1,146 @@
+#pragma once
+
+#if defined(__linux__)
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace screamrouter {
+namespace audio {
+
+/**
+ * @brief Shared layout of the ring block published by the screamrouter ALSA plugin.
+ * @details Must stay byte-for-byte identical to struct sr_ring_header in
+ *          alsa_plugin/src/pcm_screamrouter.c. Writer and reader fields live on separate
+ *          cache lines so the two processes never bounce the same line.
+ */
+struct ScreamrouterShmRingHeader {
+    static constexpr uint32_t kMagic = 0x47525253u; // "SRRG"
+    static constexpr uint32_t kVersion = 1u;
+
+    // Written once by the plugin before the file becomes visible.
+    uint32_t magic;
+    uint32_t version;
+    uint32_t data_offset;
+    uint32_t frame_bytes;
+    uint32_t capacity_frames;
+    uint32_t rate;
+    uint32_t channels;
+    uint32_t bit_depth;
+    uint8_t reserved0[32];
+
+    // Plugin (writer) side.
+    uint64_t write_frames;        ///< Frames published so far; only ever grows.
+    uint64_t write_time_ns;       ///< CLOCK_MONOTONIC when write_frames was last published.
+    uint32_t doorbell;            ///< Futex word bumped on every publish.
+    uint32_t writer_pid;
+    uint64_t dropped_frames;      ///< Frames refused because the ring was full; only ever grows.
+    uint8_t reserved1[32];
+
+    // Engine (reader) side.
+    uint64_t read_frames;         ///< Frames consumed so far; the plugin reports delay from it.
+    uint64_t reader_heartbeat_ns; ///< CLOCK_MONOTONIC of the last reader pass, 0 when detached.
+    uint32_t reader_waiting;      ///< Non-zero while the reader sleeps on the doorbell.
+    uint32_t reader_pid;
+    uint8_t reserved2[40];
+};
+
+static_assert(sizeof(ScreamrouterShmRingHeader) == 192, "ring header layout is shared with the ALSA plugin");
+
+/**
+ * @brief Reader side of the plugin's shared-memory PCM ring.
+ * @details The plugin creates the ring as a hidden file next to its FIFO
+ *          (see ring_path_for()) on the tmpfs runtime directory. Once a reader keeps
+ *          reader_heartbeat_ns fresh, the plugin writes PCM there instead of into the FIFO,
+ *          so a period costs one copy into the ring and one out of it.
+ *
+ *          The ring is single-producer/single-consumer over monotonically increasing frame
+ *          counters. The doorbell is a futex on the shared page: the plugin only issues
+ *          FUTEX_WAKE when reader_waiting says the engine is asleep.
+ *
+ *          All methods must be called from the capture thread.
+ */
+class ScreamrouterShmRing {
+public:
+    /// The plugin falls back to the FIFO once reader_heartbeat_ns is older than this.
+    static constexpr uint64_t kHeartbeatTimeoutNs = 1000000000ull;
+
+    /// Ring file the plugin publishes for the given FIFO: "<dir>/.<fifo name>.ring".
+    static std::string ring_path_for(const std::string& fifo_path);
+
+    /**
+     * @brief Maps an existing ring file and announces this process as its reader.
+     * @return nullptr if the file is missing, malformed, or from another layout version.
+     */
+    static std::unique_ptr<ScreamrouterShmRing> attach(const std::string& path, std::string* error = nullptr);
+
+    /// Clears the heartbeat so the plugin falls back to the FIFO, then unmaps.
+    ~ScreamrouterShmRing();
+
+    ScreamrouterShmRing(const ScreamrouterShmRing&) = delete;
+    ScreamrouterShmRing& operator=(const ScreamrouterShmRing&) = delete;
+
+    std::size_t frame_bytes() const { return frame_bytes_; }
+    std::size_t capacity_frames() const { return capacity_frames_; }
+    uint32_t rate() const { return rate_; }
+    uint32_t channels() const { return channels_; }
+    uint32_t bit_depth() const { return bit_depth_; }
+
+    /// Frames consumed so far.
+    uint64_t read_position() const { return read_frames_; }
+    /// Frames published by the plugin but not yet consumed.
+    std::size_t readable_frames() const;
+
+    /**
+     * @brief Unread frames that are contiguous in the mapping, without copying.
+     * @param frames In: most frames wanted. Out: frames available at the returned pointer.
+     */
+    const uint8_t* peek(std::size_t& frames) const;
+    /// Releases frames previously returned by peek() back to the plugin.
+    void consume(std::size_t frames);
+    /// Copies up to max_frames frames across the wrap point. Returns frames copied.
+    std::size_t read(uint8_t* out, std::size_t max_frames);
+
+    /// Frames the plugin has dropped so far because the ring was full.
+    uint64_t dropped_frames() const;
+
+    /// Steady-clock instant at which the frame at position was handed to ALSA by the app.
+    std::chrono::steady_clock::time_point time_of_frame(uint64_t position) const;
+
+    /// Refreshes reader_heartbeat_ns; call at least every kHeartbeatTimeoutNs / 2.
+    void heartbeat();
+
+    /**
+     * @brief Sleeps on the doorbell until at least min_frames are readable.
+     * @details Returns early on any publish or after timeout_ms, so callers loop.
+     * @return true if min_frames are readable on return.
+     */
+    bool wait(std::size_t min_frames, int timeout_ms);
+
+    /// True once the plugin has closed the stream and removed the ring file.
+    bool is_orphaned() const;
+
+private:
+    ScreamrouterShmRing() = default;
+
+    ScreamrouterShmRingHeader* header() const;
+
+    int fd_ = -1;
+    uint8_t* block_ = nullptr;
+    std::size_t block_size_ = 0;
+    const uint8_t* data_ = nullptr;
+    std::size_t frame_bytes_ = 0;
+    std::size_t capacity_frames_ = 0;
+    uint32_t rate_ = 0;
+    uint32_t channels_ = 0;
+    uint32_t bit_depth_ = 0;
+    uint64_t read_frames_ = 0;
+};
+
+} // namespace audio
+} // namespace screamrouter
+
+#endif // __linux__
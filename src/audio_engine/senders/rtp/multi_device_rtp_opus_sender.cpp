@@ -5,6 +5,7 @@
 
 #include "multi_device_rtp_opus_sender.h"
 #include "../../utils/cpp_logger.h"
+#include "../../utils/span_tracer.h"
 #include <algorithm>
 #include <cstddef>
 #include <cstring>
@@ -237,6 +238,7 @@ void MultiDeviceRtpOpusSender::send_payload(const uint8_t* payload_data, size_t
                 continue;
             }
 
+            SR_TRACE_SPAN("opus_encode");
             const int encoded_bytes = opus_encode(
                 receiver.encoder,
                 frame_ptr,
@@ -1,6 +1,7 @@
 #include "rtp_opus_sender.h"
 #include "../../audio_channel_layout.h"
 #include "../../utils/cpp_logger.h"
+#include "../../utils/span_tracer.h"
 #include <algorithm>
 #include <cstring>
 #include <numeric>
@@ -305,6 +306,7 @@ bool RtpOpusSender::handle_send_payload(const uint8_t* payload_data, size_t payl
 
         int encoded_bytes = 0;
         while (true) {
+            SR_TRACE_SPAN("opus_encode");
             if (use_multistream_) {
                 encoded_bytes = opus_multistream_encode(
                     opus_ms_encoder_,
@@ -6,7 +6,9 @@
 #include <algorithm>
 #include <fstream>
 #include <cerrno>
+#include <cmath>
 #include <cstring>
+#include <ctime>
 #include <limits>
 #include <sstream>
 #include <vector>
@@ -41,6 +43,12 @@ bool DetectRaspberryPi() {
     return false;
 }
 
+int64_t monotonic_now_ns() {
+    struct timespec ts {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + static_cast<int64_t>(ts.tv_nsec);
+}
+
 } // namespace
 
 AlsaPlaybackSender::AlsaPlaybackSender(const SinkMixerConfig& config,
@@ -376,7 +384,22 @@ bool AlsaPlaybackSender::configure_device() {
     // Disable hidden conversions so latency stays predictable.
     snd_pcm_hw_params_set_rate_resample(pcm_handle_, hw_params, 0);
 
-    snd_pcm_hw_params_set_access(pcm_handle_, hw_params, SND_PCM_ACCESS_RW_INTERLEAVED);
+    // Prefer mmap access so the mixer can quantize straight into the DMA ring; plugins that
+    // cannot map their buffer keep the readi/writei path.
+    mmap_access_ = false;
+    const bool mmap_requested = !settings_ || settings_->system_audio_tuning.alsa_mmap_enabled;
+    if (mmap_requested &&
+        snd_pcm_hw_params_set_access(pcm_handle_, hw_params, SND_PCM_ACCESS_MMAP_INTERLEAVED) == 0) {
+        mmap_access_ = true;
+    } else {
+        err = snd_pcm_hw_params_set_access(pcm_handle_, hw_params, SND_PCM_ACCESS_RW_INTERLEAVED);
+        if (err < 0) {
+            LOG_CPP_ERROR("[AlsaPlayback:%s] Failed to set interleaved access: %s", device_tag_.c_str(), snd_strerror(err));
+            snd_pcm_hw_params_free(hw_params);
+            close_locked();
+            return false;
+        }
+    }
     err = snd_pcm_hw_params_set_format(pcm_handle_, hw_params, sample_format_);
     if (err < 0) {
         LOG_CPP_ERROR("[AlsaPlayback:%s] Failed to set %d-bit format (%s).",
@@ -418,11 +441,30 @@ bool AlsaPlaybackSender::configure_device() {
         }
     }
 
+    const snd_pcm_uframes_t tick_frames = static_cast<snd_pcm_uframes_t>(resolve_base_frames_per_chunk(settings_));
+    const double tick_us = sample_rate_ > 0 ? 1e6 * static_cast<double>(tick_frames) / static_cast<double>(sample_rate_) : 0.0;
+    timer_scheduling_ = settings_ && settings_->system_audio_tuning.alsa_timer_scheduling_enabled && tick_us > 0.0;
+    if (timer_scheduling_) {
+        // Device-clocked ticks hold the queue between the target fill and one tick above it, so
+        // the buffer only needs that plus a small margin for wakeup jitter. The mix chunk still
+        // bounds the latency: lower base_frames_per_chunk to get closer to the target fill.
+        constexpr double kTimerMarginUs = 2000.0;
+        const double fill_us = std::max(0.0, settings_->system_audio_tuning.alsa_timer_target_fill_ms) * 1000.0;
+        buffer_time = static_cast<unsigned int>(std::ceil(fill_us + tick_us + kTimerMarginUs));
+    }
+
     unsigned int period_time = std::max(kMinPeriodTimeUs, buffer_time / periods_per_buffer);
     const unsigned int requested_buffer_time = buffer_time;
     const unsigned int requested_period_time = period_time;
 
-    snd_pcm_hw_params_set_period_time_near(pcm_handle_, hw_params, &period_time, nullptr);
+    // When each mixer tick commits one chunk (mmap or device-clocked), size periods to the tick
+    // when at least two still fit the buffer; wakeups then line up with the mixer.
+    if ((mmap_access_ || timer_scheduling_) && tick_us > 0.0 && tick_us * 2.0 <= static_cast<double>(buffer_time)) {
+        snd_pcm_uframes_t period_size = tick_frames;
+        snd_pcm_hw_params_set_period_size_near(pcm_handle_, hw_params, &period_size, nullptr);
+    } else {
+        snd_pcm_hw_params_set_period_time_near(pcm_handle_, hw_params, &period_time, nullptr);
+    }
     snd_pcm_hw_params_set_buffer_time_near(pcm_handle_, hw_params, &buffer_time, nullptr);
 
     err = snd_pcm_hw_params(pcm_handle_, hw_params);
@@ -449,7 +491,15 @@ bool AlsaPlaybackSender::configure_device() {
     snd_pcm_uframes_t start_threshold = period_frames_ > 0 && buffer_frames_ > period_frames_
                                             ? buffer_frames_ - period_frames_
                                             : std::max<snd_pcm_uframes_t>(1, period_frames_);
+    if (timer_scheduling_) {
+        // Start as soon as one tick sits above the target fill; the scheduler keeps it there.
+        const auto timer_start = static_cast<snd_pcm_uframes_t>(timer_target_fill_frames()) + period_frames_;
+        start_threshold = std::clamp<snd_pcm_uframes_t>(timer_start, 1, start_threshold);
+        snd_pcm_sw_params_set_tstamp_mode(pcm_handle_, sw_params, SND_PCM_TSTAMP_ENABLE);
+        snd_pcm_sw_params_set_tstamp_type(pcm_handle_, sw_params, SND_PCM_TSTAMP_TYPE_MONOTONIC);
+    }
     snd_pcm_sw_params_set_start_threshold(pcm_handle_, sw_params, start_threshold);
+    start_threshold_frames_ = start_threshold;
     // Require at least one full period available before we wake the writer; keeps a bit more headroom.
     snd_pcm_sw_params_set_avail_min(pcm_handle_, sw_params, period_frames_);
     snd_pcm_sw_params_set_stop_threshold(pcm_handle_, sw_params, buffer_frames_);
@@ -463,11 +513,14 @@ bool AlsaPlaybackSender::configure_device() {
         return false;
     }
 
-    LOG_CPP_INFO("[AlsaPlayback:%s] Opened %s rate=%u Hz channels=%u bit_depth=%d period=%lu frames (%u us, requested=%u us) buffer=%lu frames (%u us, requested=%u us).",
-                 device_tag_.c_str(), hw_device_name_.c_str(), sample_rate_, channels_, bit_depth_, period_frames_,
+    LOG_CPP_INFO("[AlsaPlayback:%s] Opened %s access=%s clock=%s rate=%u Hz channels=%u bit_depth=%d period=%lu frames (%u us, requested=%u us) buffer=%lu frames (%u us, requested=%u us).",
+                 device_tag_.c_str(), hw_device_name_.c_str(), mmap_access_ ? "mmap" : "rw",
+                 timer_scheduling_ ? "device" : "timer",
+                 sample_rate_, channels_, bit_depth_, period_frames_,
                  got_period_us, requested_period_time, buffer_frames_, got_buffer_us, requested_buffer_time);
 
     frames_written_.store(0, std::memory_order_release);
+    frames_committed_total_ = 0;
     if (buffer_frames_ > 0) {
         target_delay_frames_ = static_cast<double>(buffer_frames_) / 2.0;
     } else if (period_frames_ > 0) {
@@ -475,6 +528,11 @@ bool AlsaPlaybackSender::configure_device() {
     } else {
         target_delay_frames_ = 0.0;
     }
+    if (timer_scheduling_) {
+        // The queue oscillates between the fill target and one period above it.
+        target_delay_frames_ = timer_target_fill_frames() + static_cast<double>(period_frames_) / 2.0;
+        timer_scheduler_.reset(sample_rate_, timer_target_fill_frames());
+    }
     playback_rate_integral_ = 0.0;
     last_playback_rate_command_ = 1.0;
     prefill_target_delay_locked();
@@ -631,7 +689,7 @@ void AlsaPlaybackSender::prefill_target_delay_locked() {
                                               : deficit;
     deficit = std::min(deficit, max_prefill);
     std::vector<uint8_t> zeros(static_cast<size_t>(deficit) * bytes_per_frame_, 0);
-    snd_pcm_sframes_t written = snd_pcm_writei(pcm_handle_, zeros.data(), deficit);
+    snd_pcm_sframes_t written = write_pcm_locked(zeros.data(), static_cast<snd_pcm_uframes_t>(deficit));
     if (written < 0) {
         LOG_CPP_WARNING("[AlsaPlayback:%s] Prefill write failed: %s", device_tag_.c_str(), snd_strerror(static_cast<int>(written)));
     } else {
@@ -690,6 +748,11 @@ bool AlsaPlaybackSender::handle_write_error(int err) {
     } else {
         target_delay_frames_ = 0.0;
     }
+    if (timer_scheduling_) {
+        // Recovery discards the queue, so the position/delay history no longer lines up.
+        target_delay_frames_ = timer_target_fill_frames() + static_cast<double>(period_frames_) / 2.0;
+        timer_scheduler_.resync();
+    }
     filtered_delay_frames_ = 0.0;
     bool reconfigured_due_to_xrun = false;
     if (detected_xrun) {
@@ -746,20 +809,197 @@ void AlsaPlaybackSender::close_locked() {
         snd_pcm_close(pcm_handle_);
         pcm_handle_ = nullptr;
     }
+    if (status_) {
+        snd_pcm_status_free(status_);
+        status_ = nullptr;
+    }
+    timer_scheduler_.resync();
     target_delay_frames_ = 0.0;
     upstream_buffer_frames_ = 0.0;
     upstream_target_frames_ = 0.0;
     playback_rate_integral_ = 0.0;
     last_playback_rate_command_ = 1.0;
+    mmap_access_ = false;
     frames_written_.store(0, std::memory_order_release);
 }
 
+bool AlsaPlaybackSender::direct_format_matches_locked(unsigned int channels, unsigned int bit_depth) const {
+    // write_direct() callers produce packed little-endian samples, so 24-bit needs a 3-byte device format.
+    const size_t bytes_per_sample = bit_depth / 8u;
+    return pcm_handle_ && channels > 0 && bytes_per_sample > 0 &&
+           channels_ == channels &&
+           hardware_bit_depth_ == bit_depth &&
+           bytes_per_frame_ == bytes_per_sample * static_cast<size_t>(channels);
+}
+
+bool AlsaPlaybackSender::accepts_direct_writes(unsigned int channels, unsigned int bit_depth) const {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return mmap_access_ && direct_format_matches_locked(channels, bit_depth);
+}
+
+AlsaPlaybackSender::DirectWriteResult AlsaPlaybackSender::write_direct(size_t frame_count,
+                                                                       unsigned int channels,
+                                                                       unsigned int bit_depth,
+                                                                       const DirectFill& fill) {
+    if (frame_count == 0 || !fill) {
+        return DirectWriteResult::Declined;
+    }
+
+    DirectWriteResult result = DirectWriteResult::Failed;
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        if (!pcm_handle_ && !configure_device()) {
+            LOG_CPP_ERROR("[AlsaPlayback:%s] Unable to configure device before playback.", device_tag_.c_str());
+            return DirectWriteResult::Failed;
+        }
+        if (!direct_format_matches_locked(channels, bit_depth)) {
+            return DirectWriteResult::Declined;
+        }
+
+        bool format_lost = false;
+        const bool write_result = write_frames_locked(frame_count, [&](size_t first_frame, snd_pcm_uframes_t frames) -> snd_pcm_sframes_t {
+            // handle_write_error() and apply_pending_dynamic_latency_locked() may have reopened
+            // the device since the last chunk, with different access or a different format.
+            if (!direct_format_matches_locked(channels, bit_depth)) {
+                format_lost = true;
+                return -ECANCELED;
+            }
+            if (mmap_access_) {
+                return commit_mmap_locked(first_frame, frames, fill);
+            }
+            direct_staging_.resize(static_cast<size_t>(frames) * bytes_per_frame_);
+            fill(direct_staging_.data(), first_frame, static_cast<size_t>(frames));
+            return write_pcm_locked(direct_staging_.data(), frames);
+        });
+        if (write_result) {
+            result = DirectWriteResult::Written;
+        } else if (format_lost) {
+            LOG_CPP_WARNING("[AlsaPlayback:%s] Device format changed during a direct write; dropped the rest of the chunk.",
+                            device_tag_.c_str());
+        } else {
+            LOG_CPP_WARNING("[AlsaPlayback:%s] Dropped audio chunk due to write failure.", device_tag_.c_str());
+        }
+    }
+    auto note = consume_pending_format_notification();
+    if (note.valid) {
+        dispatch_format_notification(note);
+    }
+    return result;
+}
+
+snd_pcm_sframes_t AlsaPlaybackSender::write_pcm_locked(const void* data, snd_pcm_uframes_t frames) {
+    const snd_pcm_sframes_t written = mmap_access_ ? snd_pcm_mmap_writei(pcm_handle_, data, frames)
+                                                   : snd_pcm_writei(pcm_handle_, data, frames);
+    if (written > 0) {
+        frames_committed_total_ += static_cast<uint64_t>(written);
+    }
+    return written;
+}
+
+double AlsaPlaybackSender::timer_target_fill_frames() const {
+    if (!settings_ || sample_rate_ == 0) {
+        return 0.0;
+    }
+    const double fill_ms = std::max(0.0, settings_->system_audio_tuning.alsa_timer_target_fill_ms);
+    return fill_ms * static_cast<double>(sample_rate_) / 1000.0;
+}
+
+bool AlsaPlaybackSender::next_mix_deadline(std::chrono::steady_clock::time_point& deadline) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (!timer_scheduling_ || !pcm_handle_ || sample_rate_ == 0) {
+        return false;
+    }
+    if (!status_ && (snd_pcm_status_malloc(&status_) < 0 || !status_)) {
+        status_ = nullptr;
+        return false;
+    }
+    if (snd_pcm_status(pcm_handle_, status_) < 0) {
+        return false;
+    }
+
+    const auto steady_now = std::chrono::steady_clock::now();
+    const int64_t mono_now = monotonic_now_ns();
+    switch (snd_pcm_status_get_state(status_)) {
+    case SND_PCM_STATE_RUNNING:
+        break;
+    case SND_PCM_STATE_PREPARED:
+    case SND_PCM_STATE_XRUN:
+        // Still filling toward the start threshold, or in x-run: tick now so the write path
+        // fills or recovers the device.
+        timer_scheduler_.resync();
+        deadline = steady_now;
+        return true;
+    default:
+        // Paused, draining, suspended or gone: the device has no clock, so ClockManager paces the mixer.
+        timer_scheduler_.resync();
+        return false;
+    }
+
+    snd_htimestamp_t htstamp{};
+    snd_pcm_status_get_htstamp(status_, &htstamp);
+    int64_t stamp_ns = static_cast<int64_t>(htstamp.tv_sec) * 1000000000LL + static_cast<int64_t>(htstamp.tv_nsec);
+    if (stamp_ns <= 0 || stamp_ns > mono_now) {
+        // Driver without hardware timestamps: the status was taken just now.
+        stamp_ns = mono_now;
+    }
+    const snd_pcm_sframes_t delay = std::max<snd_pcm_sframes_t>(snd_pcm_status_get_delay(status_), 0);
+    const uint64_t queued = static_cast<uint64_t>(delay);
+    const uint64_t position = frames_committed_total_ > queued ? frames_committed_total_ - queued : 0;
+    timer_scheduler_.observe(stamp_ns, position, static_cast<double>(delay));
+
+    const int64_t wait_ns = std::max<int64_t>(timer_scheduler_.next_wakeup_ns() - mono_now, 0);
+    deadline = steady_now + std::chrono::nanoseconds(wait_ns);
+    return true;
+}
+
+snd_pcm_sframes_t AlsaPlaybackSender::commit_mmap_locked(size_t first_frame,
+                                                         snd_pcm_uframes_t frames,
+                                                         const DirectFill& fill) {
+    const snd_pcm_channel_area_t* areas = nullptr;
+    snd_pcm_uframes_t offset = 0;
+    snd_pcm_uframes_t contiguous = frames;
+    int err = snd_pcm_mmap_begin(pcm_handle_, &areas, &offset, &contiguous);
+    if (err < 0) {
+        return err;
+    }
+    if (contiguous > 0) {
+        // Interleaved access: every channel shares areas[0], frames are step bits apart.
+        uint8_t* dst = static_cast<uint8_t*>(areas[0].addr) + (areas[0].first + offset * areas[0].step) / 8;
+        fill(dst, first_frame, static_cast<size_t>(contiguous));
+    }
+    const snd_pcm_sframes_t committed = snd_pcm_mmap_commit(pcm_handle_, offset, contiguous);
+    if (committed <= 0) {
+        return committed;
+    }
+    frames_committed_total_ += static_cast<uint64_t>(committed);
+
+    // Unlike writei, a raw commit never trips the start threshold; start the stream ourselves.
+    if (snd_pcm_state(pcm_handle_) == SND_PCM_STATE_PREPARED) {
+        const snd_pcm_sframes_t avail = snd_pcm_avail_update(pcm_handle_);
+        if (avail >= 0 && buffer_frames_ >= static_cast<snd_pcm_uframes_t>(avail) &&
+            buffer_frames_ - static_cast<snd_pcm_uframes_t>(avail) >= start_threshold_frames_) {
+            err = snd_pcm_start(pcm_handle_);
+            if (err < 0) {
+                return err;
+            }
+        }
+    }
+    return committed;
+}
+
 bool AlsaPlaybackSender::write_frames(const void* data, size_t frame_count, size_t bytes_per_frame) {
+    const uint8_t* byte_ptr = static_cast<const uint8_t*>(data);
+    return write_frames_locked(frame_count, [&](size_t first_frame, snd_pcm_uframes_t frames) {
+        return write_pcm_locked(byte_ptr + first_frame * bytes_per_frame, frames);
+    });
+}
+
+bool AlsaPlaybackSender::write_frames_locked(size_t frame_count, const FrameEmitter& emit) {
     if (!pcm_handle_ || frame_count == 0) {
         return false;
     }
 
-    const uint8_t* byte_ptr = static_cast<const uint8_t*>(data);
+    size_t frames_done = 0;
     size_t frames_remaining = frame_count;
     // Treat a "chunk" as the ALSA period we negotiated; fall back to the buffer geometry if needed.
     constexpr snd_pcm_sframes_t kMaxBufferedPeriods = 9;
@@ -777,6 +1017,9 @@ bool AlsaPlaybackSender::write_frames(const void* data, size_t frame_count, size
                                                       : static_cast<snd_pcm_sframes_t>(0);
 
     while (frames_remaining > 0) {
+        if (!pcm_handle_) {
+            return false; // recovery closed the device and could not reopen it
+        }
         // Wake frequently to avoid long sleeps that drain the hardware queue and cause underruns.
         int wait_rc = snd_pcm_wait(pcm_handle_, 10);
         if (wait_rc == 0) {
@@ -849,10 +1092,13 @@ bool AlsaPlaybackSender::write_frames(const void* data, size_t frame_count, size
             continue;
         }
 
-        snd_pcm_sframes_t written = snd_pcm_writei(pcm_handle_, byte_ptr, frames_desired);
+        snd_pcm_sframes_t written = emit(frames_done, static_cast<snd_pcm_uframes_t>(frames_desired));
         if (written == -EAGAIN) {
             continue;
         }
+        if (written == -ECANCELED) {
+            return false;
+        }
         if (written < 0) {
             if (!handle_write_error(static_cast<int>(written))) {
                 return false;
@@ -864,7 +1110,7 @@ bool AlsaPlaybackSender::write_frames(const void* data, size_t frame_count, size
             frames_written_.fetch_add(static_cast<uint64_t>(written), std::memory_order_release);
         }
 
-        byte_ptr += static_cast<size_t>(written) * bytes_per_frame;
+        frames_done += static_cast<size_t>(written);
         frames_remaining -= static_cast<size_t>(written);
 
         if (snd_pcm_delay(pcm_handle_, &delay_frames) == 0) {
@@ -912,7 +1158,7 @@ void AlsaPlaybackSender::maybe_log_telemetry_locked() {
     }
 
     LOG_CPP_INFO(
-        "[Telemetry][AlsaPlayback:%s] delay_frames=%ld delay_ms=%.3f buffer_frames=%lu (%.3f ms) period_frames=%lu (%.3f ms) dyn_latency={target=%.2f applied=%.2f hysteresis=%.2f cooldown_ms=%.0f}",
+        "[Telemetry][AlsaPlayback:%s] delay_frames=%ld delay_ms=%.3f buffer_frames=%lu (%.3f ms) period_frames=%lu (%.3f ms) dyn_latency={target=%.2f applied=%.2f hysteresis=%.2f cooldown_ms=%.0f} device_clock={enabled=%d ratio=%.6f target_fill=%.1f}",
         device_tag_.c_str(),
         static_cast<long>(delay_frames),
         delay_ms,
@@ -923,7 +1169,10 @@ void AlsaPlaybackSender::maybe_log_telemetry_locked() {
         dynamic_latency_target_ms_,
         dynamic_latency_applied_ms_,
         settings_ ? settings_->system_audio_tuning.alsa_latency_apply_hysteresis_ms : 0.0,
-        settings_ ? settings_->system_audio_tuning.alsa_latency_reconfig_cooldown_ms : 0.0);
+        settings_ ? settings_->system_audio_tuning.alsa_latency_reconfig_cooldown_ms : 0.0,
+        timer_scheduling_ ? 1 : 0,
+        timer_scheduler_.rate_ratio(),
+        timer_scheduler_.target_fill_frames());
 }
 
 unsigned int AlsaPlaybackSender::get_effective_sample_rate() const {
@@ -949,7 +1198,8 @@ void AlsaPlaybackSender::maybe_adjust_dynamic_latency_locked(double filtered_del
     }
 
     auto& tuning = settings_->system_audio_tuning;
-    if (!tuning.alsa_dynamic_latency_enabled) {
+    // Device-clocked scheduling sizes the buffer itself; resizing it here would fight the scheduler.
+    if (!tuning.alsa_dynamic_latency_enabled || timer_scheduling_) {
         dynamic_latency_reconfigure_pending_ = false;
         return;
     }
@@ -3,6 +3,7 @@
 #include "../i_network_sender.h"
 #include "../../audio_types.h"
 #include "../../configuration/audio_engine_settings.h"
+#include "alsa_timer_scheduler.h"
 
 #include <string>
 #include <vector>
@@ -50,6 +51,47 @@ public:
     unsigned int get_effective_sample_rate() const;
     unsigned int get_effective_channels() const;
     unsigned int get_effective_bit_depth() const;
+
+    /**
+     * @brief Fills device frames in place.
+     * @param dst Interleaved destination for @p frames frames in the device format.
+     * @param first_frame Index of the first frame within the current write_direct() call.
+     */
+    using DirectFill = std::function<void(uint8_t* dst, size_t first_frame, size_t frames)>;
+
+    /// True when the device is open with mmap access in the given packed format, so write_direct() fills the DMA ring itself.
+    bool accepts_direct_writes(unsigned int channels, unsigned int bit_depth) const;
+
+    enum class DirectWriteResult {
+        Written,  ///< Every frame reached the device.
+        Declined, ///< The device is not open in the caller's format; nothing was filled.
+        Failed    ///< The write failed or the device changed format mid-call; remaining frames were dropped.
+    };
+
+    /**
+     * @brief Writes frame_count frames produced by @p fill straight into the device ring.
+     * @details @p fill produces interleaved frames of @p channels samples at @p bit_depth.
+     *          With mmap access the callback quantizes into snd_pcm_mmap_begin() areas and
+     *          the frames are committed in place; otherwise it fills a staging buffer that is
+     *          handed to snd_pcm_writei(). Access mode and format are re-checked before every
+     *          chunk because x-run recovery and dynamic latency changes can reopen the device
+     *          mid-call. Pacing, rate control and x-run recovery are shared with send_payload().
+     */
+    DirectWriteResult write_direct(size_t frame_count,
+                                   unsigned int channels,
+                                   unsigned int bit_depth,
+                                   const DirectFill& fill);
+
+    /**
+     * @brief When the next mix tick should run if this device clocks its sink.
+     * @details Samples snd_pcm_status (hardware timestamp and delay), steers the device clock
+     *          estimate and returns the instant the queue drains to alsa_timer_target_fill_ms.
+     *          While the stream is prepared or in x-run the deadline is now, so the write path
+     *          can fill or recover the device.
+     * @return false when timer scheduling is off or no device clock is available; the mixer
+     *         then keeps its ClockManager timer.
+     */
+    bool next_mix_deadline(std::chrono::steady_clock::time_point& deadline);
 #endif
 
 private:
@@ -68,6 +110,13 @@ private:
     bool configure_device();
     bool handle_write_error(int err);
     bool write_frames(const void* data, size_t frame_count, size_t bytes_per_frame);
+    /// Returns frames written or a negative errno; -ECANCELED abandons the write without recovery.
+    using FrameEmitter = std::function<snd_pcm_sframes_t(size_t first_frame, snd_pcm_uframes_t frames)>;
+    bool write_frames_locked(size_t frame_count, const FrameEmitter& emit);
+    snd_pcm_sframes_t write_pcm_locked(const void* data, snd_pcm_uframes_t frames);
+    bool direct_format_matches_locked(unsigned int channels, unsigned int bit_depth) const;
+    snd_pcm_sframes_t commit_mmap_locked(size_t first_frame, snd_pcm_uframes_t frames, const DirectFill& fill);
+    double timer_target_fill_frames() const;
     bool detect_xrun_locked();
     void close_locked();
     void maybe_log_telemetry_locked();
@@ -96,7 +145,14 @@ private:
     snd_pcm_format_t sample_format_ = SND_PCM_FORMAT_UNKNOWN;
     snd_pcm_uframes_t period_frames_ = 0;
     snd_pcm_uframes_t buffer_frames_ = 0;
+    snd_pcm_uframes_t start_threshold_frames_ = 0;
     size_t bytes_per_frame_ = 0;
+    bool mmap_access_ = false;
+    std::vector<uint8_t> direct_staging_;
+    bool timer_scheduling_ = false;
+    AlsaTimerScheduler timer_scheduler_;
+    snd_pcm_status_t* status_ = nullptr; ///< Reused by next_mix_deadline() so ticks do not allocate.
+    uint64_t frames_committed_total_ = 0; ///< Every frame handed to ALSA since configure, prefill included.
     unsigned int source_sample_rate_ = 0;
     unsigned int source_channels_ = 0;
     unsigned int source_bit_depth_ = 0;
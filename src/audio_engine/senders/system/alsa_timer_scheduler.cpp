@@ -0,0 +1,77 @@
+/**
+ * @file alsa_timer_scheduler.cpp
+ * @brief Implementation of the device-clocked ALSA mix scheduler.
+ */
+#include "alsa_timer_scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace screamrouter {
+namespace audio {
+
+namespace {
+constexpr double kTwoPi = 6.283185307179586;
+constexpr double kSqrt2 = 1.4142135623730951;
+// Cap the per-update loop gain so a long gap between observations cannot overshoot.
+constexpr double kMaxLoopGain = 0.5;
+} // namespace
+
+void AlsaTimerScheduler::reset(unsigned int sample_rate, double target_fill_frames) {
+    sample_rate_ = sample_rate;
+    target_fill_frames_ = std::max(0.0, target_fill_frames);
+    ratio_ = 1.0;
+    resync();
+}
+
+void AlsaTimerScheduler::resync() {
+    primed_ = false;
+    estimated_position_ = 0.0;
+    last_stamp_ns_ = 0;
+    last_fill_frames_ = 0.0;
+}
+
+void AlsaTimerScheduler::observe(int64_t stamp_ns, uint64_t position_frames, double fill_frames) {
+    const double position = static_cast<double>(position_frames);
+    const int64_t elapsed_ns = stamp_ns - last_stamp_ns_;
+    if (!primed_ || elapsed_ns > kMaxObservationGapNs || sample_rate_ == 0) {
+        primed_ = sample_rate_ > 0;
+        estimated_position_ = position;
+        last_stamp_ns_ = stamp_ns;
+        last_fill_frames_ = std::max(0.0, fill_frames);
+        return;
+    }
+    if (elapsed_ns <= 0) {
+        // Same hardware snapshot as last time (no pointer update yet); only the fill moved.
+        last_fill_frames_ = std::max(0.0, fill_frames);
+        return;
+    }
+
+    const double dt = static_cast<double>(elapsed_ns) * 1e-9;
+    const double nominal_frames = dt * static_cast<double>(sample_rate_);
+    const double predicted = estimated_position_ + nominal_frames * ratio_;
+    const double error = position - predicted;
+
+    const double omega = std::min(kTwoPi * kBandwidthHz * dt, kMaxLoopGain);
+    estimated_position_ = predicted + kSqrt2 * omega * error;
+    ratio_ += omega * omega * error / nominal_frames;
+    ratio_ = std::clamp(ratio_, 1.0 - kMaxRatioDeviation, 1.0 + kMaxRatioDeviation);
+
+    last_stamp_ns_ = stamp_ns;
+    last_fill_frames_ = std::max(0.0, fill_frames);
+}
+
+double AlsaTimerScheduler::frames_per_ns() const {
+    return static_cast<double>(sample_rate_) * ratio_ * 1e-9;
+}
+
+int64_t AlsaTimerScheduler::next_wakeup_ns() const {
+    const double rate = frames_per_ns();
+    if (!primed_ || rate <= 0.0 || last_fill_frames_ <= target_fill_frames_) {
+        return last_stamp_ns_;
+    }
+    return last_stamp_ns_ + static_cast<int64_t>(std::llround((last_fill_frames_ - target_fill_frames_) / rate));
+}
+
+} // namespace audio
+} // namespace screamrouter
@@ -0,0 +1,76 @@
+/**
+ * @file alsa_timer_scheduler.h
+ * @brief Device-clocked mix scheduling for ALSA playback.
+ * @details Tracks the playback hardware pointer from timestamped snd_pcm_status snapshots and
+ *          predicts when the queued audio will have drained to a target fill. Kept free of ALSA
+ *          types so the control loop can be exercised without a sound card.
+ */
+#ifndef ALSA_TIMER_SCHEDULER_H
+#define ALSA_TIMER_SCHEDULER_H
+
+#include <cstdint>
+
+namespace screamrouter {
+namespace audio {
+
+/**
+ * @class AlsaTimerScheduler
+ * @brief Second-order delay-locked loop over (timestamp, hardware position) observations.
+ * @details The loop estimates how fast the device consumes frames relative to its nominal
+ *          rate, so wakeups are placed on the device clock instead of the system timer.
+ *          The next wakeup is extrapolated from the latest snapshot along that estimate.
+ */
+class AlsaTimerScheduler {
+public:
+    /// Loop bandwidth: slow enough to ignore DMA burst jitter, fast enough to lock within seconds.
+    static constexpr double kBandwidthHz = 0.1;
+    /// Largest device/nominal rate mismatch the loop will track (±1%).
+    static constexpr double kMaxRatioDeviation = 0.01;
+    /// Observations further apart than this re-anchor the loop instead of steering it.
+    static constexpr int64_t kMaxObservationGapNs = 500000000;
+
+    /**
+     * @brief Forgets all state for a newly configured stream.
+     * @param sample_rate Nominal device rate in Hz.
+     * @param target_fill_frames Frames that should still be queued when the next tick runs.
+     */
+    void reset(unsigned int sample_rate, double target_fill_frames);
+
+    /// Re-anchors on the next observation while keeping the learned rate ratio (e.g. after an x-run).
+    void resync();
+
+    /**
+     * @brief Feeds one hardware snapshot.
+     * @param stamp_ns CLOCK_MONOTONIC time of the snapshot.
+     * @param position_frames Frames the device has consumed since the stream was configured.
+     * @param fill_frames Frames still queued ahead of the hardware pointer at stamp_ns.
+     */
+    void observe(int64_t stamp_ns, uint64_t position_frames, double fill_frames);
+
+    bool primed() const { return primed_; }
+    /// Device frames consumed per nominal frame (1.0 for a perfect crystal).
+    double rate_ratio() const { return ratio_; }
+    double target_fill_frames() const { return target_fill_frames_; }
+
+    /**
+     * @brief CLOCK_MONOTONIC time at which the fill drains to the target.
+     * @details Returns the last observation time when the fill is already at or below target.
+     */
+    int64_t next_wakeup_ns() const;
+
+private:
+    double frames_per_ns() const;
+
+    unsigned int sample_rate_ = 0;
+    double target_fill_frames_ = 0.0;
+    bool primed_ = false;
+    double ratio_ = 1.0;
+    double estimated_position_ = 0.0;
+    int64_t last_stamp_ns_ = 0;
+    double last_fill_frames_ = 0.0;
+};
+
+} // namespace audio
+} // namespace screamrouter
+
+#endif // ALSA_TIMER_SCHEDULER_H
@@ -7,13 +7,19 @@
 #if SCREAMROUTER_FIFO_SENDER_AVAILABLE
 #include <cerrno>
 #include <cstring>
+#include <fstream>
 #include <fcntl.h>
+#include <sys/ioctl.h>
 #include <unistd.h>
 #endif
 
 namespace screamrouter {
 namespace audio {
 
+namespace {
+constexpr auto kDropLogInterval = std::chrono::seconds(1);
+}
+
 ScreamrouterFifoSender::ScreamrouterFifoSender(const SinkMixerConfig& config)
     : config_(config),
       fifo_path_(config.output_ip)
@@ -87,34 +93,63 @@ void ScreamrouterFifoSender::send_payload(const uint8_t* payload_data, size_t pa
         return;
     }
 
-    const uint8_t* ptr = payload_data;
-    size_t remaining = payload_size;
-    while (remaining > 0) {
-        ssize_t written = write(fifo_fd_, ptr, remaining);
-        if (written < 0) {
-            if (errno == EAGAIN || errno == EINTR) {
-                break;
-            }
-            if (errno == EPIPE || errno == ENXIO) {
-                LOG_CPP_DEBUG("[SR-FIFO-Sender:%s] FIFO consumer disconnected (%s).", config_.sink_id.c_str(), std::strerror(errno));
-                close_fifo_locked();
-            } else {
-                LOG_CPP_DEBUG("[SR-FIFO-Sender:%s] Write error (%s).", config_.sink_id.c_str(), std::strerror(errno));
-                close_fifo_locked();
+    // The tail of the previous payload goes first so the reader stays frame-aligned.
+    if (!flush_pending_locked()) {
+        if (fifo_fd_ >= 0) {
+            record_drop_locked(payload_size);
+        }
+        return;
+    }
+
+    if (pipe_capacity_ > 0) {
+        int queued = 0;
+        if (ioctl(fifo_fd_, FIONREAD, &queued) == 0) {
+            const size_t used = std::min(static_cast<size_t>(std::max(queued, 0)), pipe_capacity_);
+            if (pipe_capacity_ - used < payload_size) {
+                record_drop_locked(payload_size);
+                return;
             }
-            break;
         }
-        if (written == 0) {
-            break;
+    }
+
+    ssize_t written = write(fifo_fd_, payload_data, payload_size);
+    if (written < 0 && errno == EINTR) {
+        written = write(fifo_fd_, payload_data, payload_size);
+    }
+    if (written < 0) {
+        if (errno == EAGAIN || errno == EINTR) {
+            record_drop_locked(payload_size);
+        } else if (errno == EPIPE || errno == ENXIO) {
+            LOG_CPP_DEBUG("[SR-FIFO-Sender:%s] FIFO consumer disconnected (%s).", config_.sink_id.c_str(), std::strerror(errno));
+            close_fifo_locked();
+        } else {
+            LOG_CPP_DEBUG("[SR-FIFO-Sender:%s] Write error (%s).", config_.sink_id.c_str(), std::strerror(errno));
+            close_fifo_locked();
         }
-        ptr += static_cast<size_t>(written);
-        remaining -= static_cast<size_t>(written);
+        return;
+    }
+
+    stats_.payloads_written++;
+    if (static_cast<size_t>(written) < payload_size) {
+        // Only possible when the fd is not a pipe we could size; keep the rest for next time.
+        pending_.assign(payload_data + written, payload_data + payload_size);
     }
 #else
     (void)payload_size;
 #endif
 }
 
+ScreamrouterFifoSenderStats ScreamrouterFifoSender::get_stats() {
+#if SCREAMROUTER_FIFO_SENDER_AVAILABLE
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    ScreamrouterFifoSenderStats stats = stats_;
+    stats.pipe_capacity_bytes = pipe_capacity_;
+    return stats;
+#else
+    return {};
+#endif
+}
+
 #if SCREAMROUTER_FIFO_SENDER_AVAILABLE
 
 bool ScreamrouterFifoSender::open_fifo_locked() {
@@ -135,7 +170,35 @@ bool ScreamrouterFifoSender::open_fifo_locked() {
         return false;
     }
 
-    LOG_CPP_INFO("[SR-FIFO-Sender:%s] Opened FIFO %s for playback.", config_.sink_id.c_str(), fifo_path_.c_str());
+    pipe_capacity_ = 0;
+    const int current_capacity = fcntl(fifo_fd_, F_GETPIPE_SZ);
+    if (current_capacity > 0) {
+        pipe_capacity_ = static_cast<size_t>(current_capacity);
+        const size_t bytes_per_second = static_cast<size_t>(std::max(0, config_.output_samplerate)) *
+                                        static_cast<size_t>(std::max(0, config_.output_channels)) *
+                                        static_cast<size_t>(std::max(0, config_.output_bitdepth) / 8);
+        const size_t wanted = bytes_per_second * kPipeBufferMs / 1000;
+        if (wanted > pipe_capacity_) {
+            int resized = fcntl(fifo_fd_, F_SETPIPE_SZ, static_cast<int>(wanted));
+            if (resized < 0 && errno == EPERM) {
+                // Unprivileged processes are capped by pipe-max-size; take as much as allowed.
+                std::ifstream max_size_file("/proc/sys/fs/pipe-max-size");
+                size_t max_size = 0;
+                if (max_size_file >> max_size && max_size > pipe_capacity_) {
+                    resized = fcntl(fifo_fd_, F_SETPIPE_SZ, static_cast<int>(max_size));
+                }
+            }
+            if (resized > 0) {
+                pipe_capacity_ = static_cast<size_t>(resized);
+            } else {
+                LOG_CPP_DEBUG("[SR-FIFO-Sender:%s] Could not grow FIFO to %zu bytes (%s).",
+                              config_.sink_id.c_str(), wanted, std::strerror(errno));
+            }
+        }
+    }
+
+    LOG_CPP_INFO("[SR-FIFO-Sender:%s] Opened FIFO %s for playback (pipe buffer %zu bytes).",
+                 config_.sink_id.c_str(), fifo_path_.c_str(), pipe_capacity_);
     return true;
 }
 
@@ -144,6 +207,45 @@ void ScreamrouterFifoSender::close_fifo_locked() {
         ::close(fifo_fd_);
         fifo_fd_ = -1;
     }
+    // A new reader must start on a payload boundary.
+    pending_.clear();
+    pipe_capacity_ = 0;
+}
+
+bool ScreamrouterFifoSender::flush_pending_locked() {
+    size_t offset = 0;
+    while (offset < pending_.size()) {
+        const ssize_t written = write(fifo_fd_, pending_.data() + offset, pending_.size() - offset);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN) {
+                close_fifo_locked();
+                return false;
+            }
+            break;
+        }
+        offset += static_cast<size_t>(written);
+    }
+    pending_.erase(pending_.begin(), pending_.begin() + static_cast<std::ptrdiff_t>(offset));
+    return pending_.empty();
+}
+
+void ScreamrouterFifoSender::record_drop_locked(size_t bytes) {
+    stats_.payloads_dropped++;
+    stats_.bytes_dropped += bytes;
+    drops_since_log_++;
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - last_drop_log_time_ >= kDropLogInterval) {
+        LOG_CPP_WARNING("[SR-FIFO-Sender:%s] FIFO reader is not keeping up; dropped %llu payload(s) (%llu total).",
+                        config_.sink_id.c_str(),
+                        static_cast<unsigned long long>(drops_since_log_),
+                        static_cast<unsigned long long>(stats_.payloads_dropped));
+        drops_since_log_ = 0;
+        last_drop_log_time_ = now;
+    }
 }
 
 #endif // SCREAMROUTER_FIFO_SENDER_AVAILABLE
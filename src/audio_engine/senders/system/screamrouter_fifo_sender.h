@@ -4,9 +4,12 @@
 #include "../../audio_types.h"
 #include "../../system_audio/runtime_device_advertiser.h"
 
+#include <chrono>
+#include <cstdint>
 #include <mutex>
 #include <memory>
 #include <string>
+#include <vector>
 
 #if defined(__linux__)
 #define SCREAMROUTER_FIFO_SENDER_AVAILABLE 1
@@ -17,8 +20,31 @@
 namespace screamrouter {
 namespace audio {
 
+/**
+ * @struct ScreamrouterFifoSenderStats
+ * @brief Delivery counters for a FIFO sink output.
+ */
+struct ScreamrouterFifoSenderStats {
+    uint64_t payloads_written = 0;
+    uint64_t payloads_dropped = 0; ///< Whole payloads refused because the reader fell behind.
+    uint64_t bytes_dropped = 0;
+    size_t pipe_capacity_bytes = 0;
+};
+
+/**
+ * @class ScreamrouterFifoSender
+ * @brief Writes sink output into a screamrouter runtime FIFO for local capture apps.
+ * @details Each payload is written whole or not at all: before writing, the free space
+ *          in the pipe is checked, and a payload that does not fit is dropped and counted.
+ *          A stalled reader therefore never gets torn frames, and the mixer thread never
+ *          loops on partial writes. The pipe is grown to hold kPipeBufferMs of audio so
+ *          readers can drain it in large batches.
+ */
 class ScreamrouterFifoSender : public INetworkSender {
 public:
+    /// Audio the pipe should be able to hold before payloads are dropped.
+    static constexpr int kPipeBufferMs = 250;
+
     explicit ScreamrouterFifoSender(const SinkMixerConfig& config);
     ~ScreamrouterFifoSender() override;
 
@@ -26,16 +52,26 @@ public:
     void close() override;
     void send_payload(const uint8_t* payload_data, size_t payload_size, const std::vector<uint32_t>& csrcs) override;
 
+    ScreamrouterFifoSenderStats get_stats();
+
 private:
 #if SCREAMROUTER_FIFO_SENDER_AVAILABLE
     bool open_fifo_locked();
     void close_fifo_locked();
+    /// Writes the tail of a payload the pipe only partly accepted. Returns true once empty.
+    bool flush_pending_locked();
+    void record_drop_locked(size_t bytes);
 #endif
 
     SinkMixerConfig config_;
     std::string fifo_path_;
 #if SCREAMROUTER_FIFO_SENDER_AVAILABLE
     int fifo_fd_ = -1;
+    size_t pipe_capacity_ = 0;
+    std::vector<uint8_t> pending_;
+    ScreamrouterFifoSenderStats stats_;
+    uint64_t drops_since_log_ = 0;
+    std::chrono::steady_clock::time_point last_drop_log_time_{};
     std::mutex state_mutex_;
     std::unique_ptr<system_audio::RuntimeDeviceAdvertiser> runtime_advertiser_;
 #endif
@@ -449,12 +449,12 @@ void AlsaDeviceEnumerator::monitor_loop() {
                             continue;
                         }
                         if (pfd.revents & (POLLIN | POLLERR | POLLHUP)) {
-                            fifo_event_seen = true;
-                            bool events_seen = drain_fifo_watch_events();
+                            fifo_event_seen = drain_fifo_watch_events();
                             if (pfd.revents & (POLLERR | POLLHUP)) {
+                                fifo_event_seen = true;
                                 teardown_fifo_watch();
-                            } else if (!events_seen) {
-                                LOG_CPP_DEBUG("[ALSA-Enumerator] Inotify signaled but no detailed events read");
+                            } else if (!fifo_event_seen) {
+                                LOG_CPP_DEBUG("[ALSA-Enumerator] Inotify signaled but no FIFO changes read");
                             }
                         }
                     }
@@ -795,8 +795,11 @@ bool AlsaDeviceEnumerator::drain_fifo_watch_events() {
                 LOG_CPP_WARNING("[ALSA-Enumerator] Inotify queue overflow; forcing rescan");
                 rescan_needed = true;
             }
-            if (event->mask & (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ATTRIB |
-                               IN_CLOSE_WRITE | IN_CLOSE_NOWRITE | IN_OPEN)) {
+            // Nameless events are about the directory itself. Opening and closing it is what
+            // every rescan does, so counting those would rescan forever.
+            if (event->len > 0 &&
+                (event->mask & (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ATTRIB |
+                                IN_CLOSE_WRITE | IN_CLOSE_NOWRITE | IN_OPEN))) {
                 rescan_needed = true;
             }
             if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF)) {
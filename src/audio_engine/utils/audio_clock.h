@@ -0,0 +1,97 @@
+/**
+ * @file audio_clock.h
+ * @brief Injectable time source for media timing.
+ * @details Playout deadlines, stream clocks and rate control read the time through
+ *          AudioClock::now(). Normally that is std::chrono::steady_clock::now(); when a
+ *          VirtualClock is installed, time only moves when its owner advances it, which is
+ *          how the offline renderer runs the graph faster than real time and reproducibly.
+ *          Code that measures CPU time (profilers, lock timing) keeps using steady_clock.
+ */
+#ifndef SCREAMROUTER_AUDIO_UTILS_AUDIO_CLOCK_H
+#define SCREAMROUTER_AUDIO_UTILS_AUDIO_CLOCK_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace screamrouter {
+namespace audio {
+namespace utils {
+
+/**
+ * @class VirtualClock
+ * @brief A steady_clock-compatible clock that is moved forward explicitly.
+ */
+class VirtualClock {
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+
+    /**
+     * @brief Creates a clock reading @p start.
+     * @details The default start is one hour past the epoch: several components treat a
+     *          zero time_point as "not set yet".
+     */
+    explicit VirtualClock(time_point start = time_point{} + std::chrono::hours(1))
+        : now_ns_(std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count()) {}
+
+    time_point now() const {
+        return time_point{std::chrono::duration_cast<time_point::duration>(
+            std::chrono::nanoseconds(now_ns_.load(std::memory_order_acquire)))};
+    }
+
+    /** @brief Moves the clock forward by @p step. Negative steps are ignored. */
+    void advance(std::chrono::nanoseconds step) {
+        if (step.count() > 0) {
+            now_ns_.fetch_add(step.count(), std::memory_order_acq_rel);
+        }
+    }
+
+    /** @brief Moves the clock to @p t if that is not in its past. */
+    void advance_to(time_point t) {
+        const int64_t target = std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+        int64_t current = now_ns_.load(std::memory_order_acquire);
+        while (target > current && !now_ns_.compare_exchange_weak(current, target, std::memory_order_acq_rel)) {
+        }
+    }
+
+private:
+    std::atomic<int64_t> now_ns_;
+};
+
+/**
+ * @class AudioClock
+ * @brief Process-wide media clock: steady_clock unless a VirtualClock is installed.
+ */
+class AudioClock {
+public:
+    static std::chrono::steady_clock::time_point now() {
+        const VirtualClock* clock = installed().load(std::memory_order_acquire);
+        return clock ? clock->now() : std::chrono::steady_clock::now();
+    }
+
+    /** @brief Routes now() to @p clock; nullptr restores the wall clock. The caller keeps ownership. */
+    static void install(const VirtualClock* clock) { installed().store(clock, std::memory_order_release); }
+
+    static bool is_virtual() { return installed().load(std::memory_order_acquire) != nullptr; }
+
+private:
+    static std::atomic<const VirtualClock*>& installed() {
+        static std::atomic<const VirtualClock*> clock{nullptr};
+        return clock;
+    }
+};
+
+/** @brief Installs a VirtualClock for the lifetime of the scope. */
+class ScopedVirtualClock {
+public:
+    explicit ScopedVirtualClock(const VirtualClock& clock) { AudioClock::install(&clock); }
+    ~ScopedVirtualClock() { AudioClock::install(nullptr); }
+    ScopedVirtualClock(const ScopedVirtualClock&) = delete;
+    ScopedVirtualClock& operator=(const ScopedVirtualClock&) = delete;
+};
+
+} // namespace utils
+} // namespace audio
+} // namespace screamrouter
+
+#endif // SCREAMROUTER_AUDIO_UTILS_AUDIO_CLOCK_H
@@ -8,20 +8,379 @@
 
 #include <chrono> // For std::chrono::milliseconds
 #include <algorithm> // For std::min
-#include <condition_variable> // For std::condition_variable
+#include <memory>
+#include <thread>
 
 namespace screamrouter {
 namespace audio {
 namespace logging {
 
+namespace detail {
+
+/**
+ * @brief Single-producer/single-consumer byte ring owned by one logging thread.
+ * @details The owning thread appends encoded records and publishes them with a release
+ *          store of `head`; retrieve_log_entries() is the only consumer. Positions are
+ *          monotonic byte counts, masked into `data`.
+ */
+struct LogRing {
+    static constexpr size_t kCapacity = 64 * 1024;
+    static constexpr size_t kMask = kCapacity - 1;
+
+    alignas(64) std::atomic<size_t> head{0};
+    alignas(64) std::atomic<size_t> tail{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<bool> retired{false};
+    size_t reserved_head = 0; // producer-only: head value after the pending reservation's wrap
+    alignas(64) uint8_t data[kCapacity];
+};
+
+} // namespace detail
+
 namespace { // Anonymous namespace for internal linkage
-    std::deque<screamrouter::audio::logging::LogEntry> internal_log_queue;
-    std::mutex internal_log_queue_mutex;
-    std::condition_variable internal_log_queue_cv;
-    const size_t MAX_LOG_QUEUE_SIZE = 8192; // Max number of log entries in queue
-    bool shutdown_requested = false;
+    using detail::LogRing;
+    using detail::RecordHeader;
+
+    const size_t MAX_LOG_QUEUE_SIZE = 8192; // Max number of formatted entries waiting for Python
+    const size_t MAX_BATCH_SIZE = 100;
+    const size_t MAX_RECORD_BYTES = LogRing::kCapacity / 4;
+    const size_t MAX_PREFORMATTED_BYTES = 4096;
+    constexpr auto DRAIN_POLL_INTERVAL = std::chrono::milliseconds(5);
+
+    struct RingRegistry {
+        std::mutex mutex;
+        std::vector<std::shared_ptr<LogRing>> rings;
+    };
+
+    // Intentionally leaked so threads that log during static destruction still find it.
+    RingRegistry& ring_registry() {
+        static RingRegistry* registry = new RingRegistry();
+        return *registry;
+    }
+
+    struct RingOwner {
+        std::shared_ptr<LogRing> ring;
+        ~RingOwner() {
+            if (ring) {
+                ring->retired.store(true, std::memory_order_release);
+            }
+        }
+    };
+
+    LogRing& local_ring() {
+        thread_local RingOwner owner;
+        if (!owner.ring) {
+            auto ring = std::make_shared<LogRing>();
+            RingRegistry& registry = ring_registry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.rings.push_back(ring);
+            owner.ring = std::move(ring);
+        }
+        return *owner.ring;
+    }
+
+    // Drain-side state. Only retrieve_log_entries() touches it, under drain_mutex.
+    std::mutex drain_mutex;
+    std::deque<LogEntry> pending_entries;
     bool overflow_message_logged_since_clear = false; // To prevent spamming overflow messages
+
+    std::atomic<bool> shutdown_requested{false};
     std::atomic<bool> stderr_mirror{false};
+
+    struct DecodedArg {
+        detail::ArgTag tag;
+        uint64_t bits = 0;
+        std::string text;
+
+        int64_t as_signed() const {
+            if (tag == detail::ArgTag::F64) {
+                double value;
+                std::memcpy(&value, &bits, sizeof(value));
+                return static_cast<int64_t>(value);
+            }
+            return static_cast<int64_t>(bits);
+        }
+        double as_double() const {
+            switch (tag) {
+                case detail::ArgTag::F64: {
+                    double value;
+                    std::memcpy(&value, &bits, sizeof(value));
+                    return value;
+                }
+                case detail::ArgTag::I32:
+                case detail::ArgTag::I64:
+                    return static_cast<double>(static_cast<int64_t>(bits));
+                default:
+                    return static_cast<double>(bits);
+            }
+        }
+    };
+
+    void append_printf(std::string& out, const char* spec, ...) {
+        char stack_buffer[256];
+        va_list args;
+        va_start(args, spec);
+        int needed = vsnprintf(stack_buffer, sizeof(stack_buffer), spec, args);
+        va_end(args);
+        if (needed < 0) {
+            return;
+        }
+        if (static_cast<size_t>(needed) < sizeof(stack_buffer)) {
+            out.append(stack_buffer, static_cast<size_t>(needed));
+            return;
+        }
+        std::vector<char> heap_buffer(static_cast<size_t>(needed) + 1);
+        va_start(args, spec);
+        vsnprintf(heap_buffer.data(), heap_buffer.size(), spec, args);
+        va_end(args);
+        out.append(heap_buffer.data(), static_cast<size_t>(needed));
+    }
+
+    /**
+     * Applies a printf-style format to decoded arguments one conversion at a time.
+     * Integer conversions are widened to `ll` because every integer is stored as 64 bits;
+     * `h`/`hh` keep their int-sized argument so snprintf still truncates as the caller meant.
+     */
+    void format_with_args(const char* format, const std::vector<DecodedArg>& args, std::string& out) {
+        size_t next_arg = 0;
+        const char* p = format;
+        while (*p) {
+            if (*p != '%') {
+                const char* run = p;
+                while (*p && *p != '%') {
+                    ++p;
+                }
+                out.append(run, static_cast<size_t>(p - run));
+                continue;
+            }
+            if (p[1] == '%') {
+                out.push_back('%');
+                p += 2;
+                continue;
+            }
+
+            const char* spec_start = p++;
+            std::string spec = "%";
+            bool missing_arg = false;
+            while (*p && std::strchr("-+ #0", *p)) {
+                spec.push_back(*p++);
+            }
+            // Width and precision, with '*' pulled from the argument list.
+            for (int part = 0; part < 2; ++part) {
+                if (part == 1) {
+                    if (*p != '.') {
+                        break;
+                    }
+                    spec.push_back(*p++);
+                }
+                if (*p == '*') {
+                    ++p;
+                    if (next_arg < args.size()) {
+                        spec += std::to_string(args[next_arg++].as_signed());
+                    } else {
+                        missing_arg = true;
+                    }
+                } else {
+                    while (*p >= '0' && *p <= '9') {
+                        spec.push_back(*p++);
+                    }
+                }
+            }
+            std::string length;
+            while (*p && std::strchr("hljztLq", *p)) {
+                length.push_back(*p++);
+            }
+            const char conversion = *p;
+            if (conversion) {
+                ++p;
+            }
+            const bool short_length = !length.empty() && length[0] == 'h';
+            const bool wide_length = !length.empty() && !short_length;
+
+            if (missing_arg || !conversion || next_arg >= args.size()) {
+                out.append(spec_start, static_cast<size_t>(p - spec_start));
+                continue;
+            }
+            const DecodedArg& arg = args[next_arg++];
+
+            switch (conversion) {
+                case 'd':
+                case 'i':
+                    if (short_length) {
+                        append_printf(out, (spec + length + conversion).c_str(), static_cast<int>(arg.as_signed()));
+                    } else {
+                        append_printf(out, (spec + "ll" + conversion).c_str(), static_cast<long long>(arg.as_signed()));
+                    }
+                    break;
+                case 'u':
+                case 'o':
+                case 'x':
+                case 'X': {
+                    uint64_t value = static_cast<uint64_t>(arg.as_signed());
+                    if (short_length) {
+                        append_printf(out, (spec + length + conversion).c_str(), static_cast<unsigned int>(value));
+                        break;
+                    }
+                    // A 32-bit argument read through %u/%x was reinterpreted as unsigned int.
+                    if (!wide_length && (arg.tag == detail::ArgTag::I32 || arg.tag == detail::ArgTag::U32)) {
+                        value = static_cast<uint32_t>(value);
+                    }
+                    append_printf(out, (spec + "ll" + conversion).c_str(), static_cast<unsigned long long>(value));
+                    break;
+                }
+                case 'c':
+                    append_printf(out, (spec + conversion).c_str(), static_cast<int>(arg.as_signed()));
+                    break;
+                case 'f': case 'F': case 'e': case 'E':
+                case 'g': case 'G': case 'a': case 'A':
+                    append_printf(out, (spec + conversion).c_str(), arg.as_double());
+                    break;
+                case 's':
+                    if (arg.tag == detail::ArgTag::STR) {
+                        append_printf(out, (spec + 's').c_str(), arg.text.c_str());
+                    } else {
+                        out += "(invalid)";
+                    }
+                    break;
+                case 'p':
+                    append_printf(out, (spec + 'p').c_str(),
+                                  reinterpret_cast<void*>(static_cast<uintptr_t>(arg.bits)));
+                    break;
+                case 'n':
+                    break; // Writes back through a pointer; meaningless after the fact.
+                default:
+                    --next_arg;
+                    out.append(spec_start, static_cast<size_t>(p - spec_start));
+                    break;
+            }
+        }
+    }
+
+    /** Decodes one record produced by detail::log_deferred() into a LogEntry. */
+    LogEntry format_record(const uint8_t* record) {
+        RecordHeader header;
+        std::memcpy(&header, record, sizeof(header));
+        const uint8_t* cursor = record + sizeof(RecordHeader);
+
+        LogEntry entry;
+        entry.level = static_cast<LogLevel>(header.level);
+        entry.filename = header.file ? get_base_filename(header.file) : "unknown_file";
+        entry.line_number = header.line;
+
+        std::string format_copy;
+        const char* format = header.format;
+        if (header.flags & detail::kRecordFormatCopied) {
+            uint32_t len;
+            std::memcpy(&len, cursor, sizeof(len));
+            format_copy.assign(reinterpret_cast<const char*>(cursor + sizeof(len)), len);
+            cursor += sizeof(len) + len;
+            format = format_copy.c_str();
+        }
+        if (header.flags & detail::kRecordPreformatted) {
+            entry.message = std::move(format_copy);
+            return entry;
+        }
+
+        std::vector<DecodedArg> args;
+        args.reserve(header.argc);
+        for (uint16_t i = 0; i < header.argc; ++i) {
+            DecodedArg arg;
+            arg.tag = static_cast<detail::ArgTag>(*cursor++);
+            if (arg.tag == detail::ArgTag::STR) {
+                uint32_t len;
+                std::memcpy(&len, cursor, sizeof(len));
+                arg.text.assign(reinterpret_cast<const char*>(cursor + sizeof(len)), len);
+                cursor += sizeof(len) + len;
+            } else {
+                std::memcpy(&arg.bits, cursor, sizeof(arg.bits));
+                cursor += sizeof(arg.bits);
+            }
+            args.push_back(std::move(arg));
+        }
+
+        format_with_args(format ? format : "", args, entry.message);
+        return entry;
+    }
+
+    const char* level_label(LogLevel level) {
+        switch (level) {
+            case LogLevel::DEBUG: return "DEBUG";
+            case LogLevel::INFO: return "INFO";
+            case LogLevel::WARNING: return "WARN";
+            case LogLevel::ERR: return "ERROR";
+        }
+        return "INFO";
+    }
+
+    void push_pending(LogEntry entry) {
+        if (pending_entries.size() >= MAX_LOG_QUEUE_SIZE) {
+            pending_entries.pop_front(); // Drop oldest
+            if (!overflow_message_logged_since_clear) {
+                LogEntry overflow_entry;
+                overflow_entry.level = LogLevel::WARNING;
+                overflow_entry.message = "C++ log queue overflow. Oldest messages dropped.";
+                overflow_entry.filename = "cpp_logger.cpp";
+                overflow_entry.line_number = __LINE__;
+                pending_entries.push_back(std::move(overflow_entry));
+                overflow_message_logged_since_clear = true;
+            }
+        }
+        pending_entries.push_back(std::move(entry));
+    }
+
+    /** Moves every published record out of the thread rings into pending_entries, oldest first. */
+    void drain_rings_locked() {
+        std::vector<std::shared_ptr<LogRing>> rings;
+        {
+            RingRegistry& registry = ring_registry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            rings = registry.rings;
+        }
+
+        std::vector<std::pair<uint64_t, LogEntry>> drained;
+        uint64_t dropped_total = 0;
+        for (const auto& ring : rings) {
+            const bool retired = ring->retired.load(std::memory_order_acquire);
+            size_t tail = ring->tail.load(std::memory_order_relaxed);
+            const size_t head = ring->head.load(std::memory_order_acquire);
+            while (tail != head) {
+                const size_t offset = tail & LogRing::kMask;
+                uint32_t size;
+                std::memcpy(&size, ring->data + offset, sizeof(size));
+                if (size == 0) {
+                    tail += LogRing::kCapacity - offset; // Wrap marker
+                    continue;
+                }
+                RecordHeader header;
+                std::memcpy(&header, ring->data + offset, sizeof(header));
+                drained.emplace_back(header.timestamp_ns, format_record(ring->data + offset));
+                tail += size;
+            }
+            ring->tail.store(tail, std::memory_order_release);
+            dropped_total += ring->dropped.exchange(0, std::memory_order_relaxed);
+
+            if (retired) {
+                RingRegistry& registry = ring_registry();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                registry.rings.erase(std::remove(registry.rings.begin(), registry.rings.end(), ring),
+                                     registry.rings.end());
+            }
+        }
+
+        std::stable_sort(drained.begin(), drained.end(),
+                         [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+        for (auto& item : drained) {
+            push_pending(std::move(item.second));
+        }
+        if (dropped_total > 0) {
+            LogEntry dropped_entry;
+            dropped_entry.level = LogLevel::WARNING;
+            dropped_entry.message = "C++ log ring full; dropped " + std::to_string(dropped_total) + " messages.";
+            dropped_entry.filename = "cpp_logger.cpp";
+            dropped_entry.line_number = __LINE__;
+            push_pending(std::move(dropped_entry));
+        }
+    }
 }
 
 // Definition of the global log level variable
@@ -33,7 +392,7 @@ const char* get_base_filename(const char* path) {
     }
     const char* last_slash = strrchr(path, '/');
     const char* last_backslash = strrchr(path, '\\');
-    
+
     const char* base = nullptr;
     if (last_slash && last_backslash) {
         base = (last_slash > last_backslash) ? last_slash + 1 : last_backslash + 1;
@@ -47,6 +406,59 @@ const char* get_base_filename(const char* path) {
     return base;
 }
 
+namespace detail {
+
+uint8_t* reserve_record(size_t bytes) {
+    if (shutdown_requested.load(std::memory_order_relaxed)) {
+        return nullptr; // Don't add new logs if shutdown is in progress
+    }
+    LogRing& ring = local_ring();
+    if (bytes > MAX_RECORD_BYTES) {
+        ring.dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    size_t head = ring.head.load(std::memory_order_relaxed);
+    const size_t tail = ring.tail.load(std::memory_order_acquire);
+    const size_t offset = head & LogRing::kMask;
+    const size_t contiguous = LogRing::kCapacity - offset;
+    const size_t needed = bytes > contiguous ? contiguous + bytes : bytes;
+    if (LogRing::kCapacity - (head - tail) < needed) {
+        // Never wait for the drainer: a real-time thread would rather lose a log line.
+        ring.dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    if (bytes > contiguous) {
+        const uint32_t wrap_marker = 0;
+        std::memcpy(ring.data + offset, &wrap_marker, sizeof(wrap_marker));
+        head += contiguous;
+    }
+    ring.reserved_head = head;
+    return ring.data + (head & LogRing::kMask);
+}
+
+void commit_record(size_t bytes) {
+    LogRing& ring = local_ring();
+    ring.head.store(ring.reserved_head + bytes, std::memory_order_release);
+}
+
+bool stderr_mirror_enabled() {
+    return stderr_mirror.load(std::memory_order_relaxed);
+}
+
+void mirror_record_to_stderr(const uint8_t* record) {
+    const LogEntry entry = format_record(record);
+    std::cerr << "[CPP][" << level_label(entry.level) << "][" << entry.filename << ":" << entry.line_number
+              << "] " << entry.message << std::endl;
+}
+
+uint64_t log_timestamp_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace detail
+
 void log_message(LogLevel level, const char* file, int line, const char* format, ...) {
     // Format the message
     if (level < current_log_level.load(std::memory_order_relaxed)) {
@@ -59,8 +471,6 @@ void log_message(LogLevel level, const char* file, int line, const char* format,
     va_end(args);
 
     if (needed < 0) {
-        // Consider logging this formatting error to std::cerr directly,
-        // as it's an issue before even attempting to queue.
         std::cerr << "CppLogger: Encoding error in log_message for file " << (file ? file : "unknown_file") << ":" << line << std::endl;
         return;
     }
@@ -72,81 +482,58 @@ void log_message(LogLevel level, const char* file, int line, const char* format,
         va_end(args);
     }
 
-    // Mirror to stderr if enabled (best-effort, non-blocking)
-    if (stderr_mirror.load(std::memory_order_relaxed)) {
-        const char* lvl = "INFO";
-        switch (level) {
-            case LogLevel::DEBUG: lvl = "DEBUG"; break;
-            case LogLevel::INFO: lvl = "INFO"; break;
-            case LogLevel::WARNING: lvl = "WARN"; break;
-            case LogLevel::ERR: lvl = "ERROR"; break;
-        }
-        std::cerr << "[CPP][" << lvl << "][" << (file ? file : "?") << ":" << line << "] " << buffer.data() << std::endl;
+    // Store the finished text as a copied format flagged so the drain side skips formatting.
+    const uint32_t len = static_cast<uint32_t>(std::min<size_t>(static_cast<size_t>(needed), MAX_PREFORMATTED_BYTES));
+    const size_t total = detail::align_record(sizeof(RecordHeader) + sizeof(len) + len);
+    uint8_t* record = detail::reserve_record(total);
+    if (!record) {
+        return;
     }
+    RecordHeader header{};
+    header.size = static_cast<uint32_t>(total);
+    header.level = static_cast<uint8_t>(level);
+    header.flags = detail::kRecordFormatCopied | detail::kRecordPreformatted;
+    header.line = line;
+    header.timestamp_ns = detail::log_timestamp_ns();
+    header.file = file;
+    std::memcpy(record, &header, sizeof(header));
+    std::memcpy(record + sizeof(header), &len, sizeof(len));
+    std::memcpy(record + sizeof(header) + sizeof(len), buffer.data(), len);
 
-    LogEntry new_entry;
-    new_entry.level = level;
-    new_entry.message = std::string(buffer.data());
-    new_entry.filename = (file ? std::string(file) : "unknown_file"); // Store copy
-    new_entry.line_number = line;
-
-    { // Scope for the lock
-        std::unique_lock<std::mutex> lock(internal_log_queue_mutex);
-        if (shutdown_requested) {
-            return; // Don't add new logs if shutdown is in progress
-        }
-
-        if (internal_log_queue.size() >= MAX_LOG_QUEUE_SIZE) {
-            internal_log_queue.pop_front(); // Drop oldest
-            if (!overflow_message_logged_since_clear) {
-                 // To avoid spamming cerr, only log overflow once until queue is cleared by Python
-                 // Or, add a special LogEntry indicating overflow. For now, simple cerr message.
-                LogEntry overflow_entry;
-                overflow_entry.level = LogLevel::WARNING;
-                overflow_entry.message = "C++ log queue overflow. Oldest messages dropped.";
-                overflow_entry.filename = "cpp_logger.cpp";
-                overflow_entry.line_number = __LINE__; // Approximate line
-                internal_log_queue.push_back(std::move(overflow_entry)); // Add this as a log entry itself
-                overflow_message_logged_since_clear = true; // Mark that we've logged an overflow
-                // Alternatively, a simple std::cerr message:
-                // std::cerr << "CppLogger [WARNING][cpp_logger.cpp]: C++ log queue overflow. Oldest messages dropped." << std::endl;
-                // overflow_message_logged_since_clear = true; // If using cerr directly
-            }
-        }
-        internal_log_queue.push_back(std::move(new_entry));
-        lock.unlock(); // Unlock before notifying
-        internal_log_queue_cv.notify_one(); // Notify one waiting thread (Python retriever)
+    if (detail::stderr_mirror_enabled()) {
+        detail::mirror_record_to_stderr(record);
     }
+    detail::commit_record(total);
 }
 
 std::vector<LogEntry> retrieve_log_entries(int timeout_ms) {
     std::vector<LogEntry> batch;
-    std::unique_lock<std::mutex> lock(internal_log_queue_mutex);
+    std::lock_guard<std::mutex> lock(drain_mutex);
 
-    if (!internal_log_queue_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms),
-                                         []{ return !internal_log_queue.empty() || shutdown_requested; })) {
-        // Timeout occurred, queue is still empty, and no shutdown
-        return batch; // Return empty vector
+    // Producers never signal (that would put a syscall on the audio threads), so poll the
+    // rings until something shows up or the timeout expires.
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (true) {
+        drain_rings_locked();
+        if (!pending_entries.empty() || shutdown_requested.load(std::memory_order_relaxed)) {
+            break;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return batch; // Timeout occurred, nothing was logged
+        }
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(DRAIN_POLL_INTERVAL, deadline - now));
     }
 
-    // If woken up, either queue is not empty OR shutdown is requested.
-    if (shutdown_requested && internal_log_queue.empty()) {
-        return batch; // Shutdown and queue is empty, nothing to retrieve
-    }
-    
-    // Determine how many items to grab.
-    // Example: grab all available up to a certain reasonable batch size (e.g., 100 or 200)
-    // to avoid holding the lock for too long if the queue is massive.
-    size_t items_to_grab = std::min(internal_log_queue.size(), static_cast<size_t>(100));
+    size_t items_to_grab = std::min(pending_entries.size(), MAX_BATCH_SIZE);
     batch.reserve(items_to_grab);
-
-    for (size_t i = 0; i < items_to_grab && !internal_log_queue.empty(); ++i) {
-        batch.push_back(std::move(internal_log_queue.front()));
-        internal_log_queue.pop_front();
+    for (size_t i = 0; i < items_to_grab; ++i) {
+        batch.push_back(std::move(pending_entries.front()));
+        pending_entries.pop_front();
     }
-    
+
     // If we cleared the queue sufficiently, reset the overflow message flag
-    if (overflow_message_logged_since_clear && internal_log_queue.size() < (MAX_LOG_QUEUE_SIZE / 2)) {
+    if (overflow_message_logged_since_clear && pending_entries.size() < (MAX_LOG_QUEUE_SIZE / 2)) {
         overflow_message_logged_since_clear = false;
     }
 
@@ -154,10 +541,7 @@ std::vector<LogEntry> retrieve_log_entries(int timeout_ms) {
 }
 
 void shutdown_cpp_logger() {
-    std::unique_lock<std::mutex> lock(internal_log_queue_mutex);
-    shutdown_requested = true;
-    lock.unlock();
-    internal_log_queue_cv.notify_all(); // Wake up any waiting retrieve_log_entries calls
+    shutdown_requested.store(true, std::memory_order_relaxed);
 }
 
 void set_cpp_log_level(LogLevel /*level*/) {
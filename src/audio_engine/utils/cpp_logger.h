@@ -1,9 +1,11 @@
 /**
  * @file cpp_logger.h
  * @brief Defines a logging framework for the C++ audio engine.
- * @details This file provides a simple, thread-safe logging mechanism that queues log
- *          messages from C++ and allows them to be retrieved by a Python layer.
- *          It includes log levels, a log entry structure, and macros for easy logging.
+ * @details Log calls encode the format pointer, the raw arguments and a timestamp into a
+ *          lock-free ring owned by the calling thread; nothing is formatted or locked on the
+ *          hot path. retrieve_log_entries() drains every ring, formats the records and hands
+ *          them to the Python layer. It includes log levels, a log entry structure, and macros
+ *          for easy logging.
  */
 #ifndef CPP_LOGGER_H
 #define CPP_LOGGER_H
@@ -14,6 +16,10 @@
 #include <deque>
 #include <mutex>
 #include <atomic>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 #ifndef SCREAMROUTER_TESTING
 #include <pybind11/pybind11.h>
@@ -52,9 +58,9 @@ struct LogEntry {
 
 /**
  * @brief Retrieves all currently buffered log entries.
- * @details This function is intended to be called by Python. It blocks until messages
- *          are available or a timeout occurs, then returns all entries currently in the
- *          queue and clears it.
+ * @details This function is intended to be called by Python. It polls the per-thread
+ *          rings until messages are available or a timeout occurs, formats them in timestamp
+ *          order and returns up to 100 entries.
  * @param timeout_ms The maximum time to wait in milliseconds.
  * @return A vector of `LogEntry` objects.
  */
@@ -74,15 +80,16 @@ void set_cpp_log_level(LogLevel level);
 
 /**
  * @brief Enables or disables mirroring C++ logs to stderr immediately.
- * @details When enabled, every log_message will also be written to stderr in addition to
- *          being queued. Useful during early initialization or shutdown when the Python
+ * @details When enabled, every message is also formatted on the calling thread and written
+ *          to stderr in addition to being queued. Useful during early initialization or shutdown when the Python
  *          side may not be draining the queue.
  */
 void set_cpp_log_stderr_mirror(bool enable);
 
 /**
- * @brief Dispatches a log message to the internal C++ queue.
- * @details This function handles printf-style formatting and captures file/line info.
+ * @brief Formats and queues a log message immediately.
+ * @details Kept for callers that need printf-style va_args formatting on the calling
+ *          thread. The LOG_CPP_* macros use the deferred path below instead.
  * @param level The log level.
  * @param file The source file name (`__FILE__`).
  * @param line The source line number (`__LINE__`).
@@ -91,6 +98,183 @@ void set_cpp_log_stderr_mirror(bool enable);
  */
 void log_message(LogLevel level, const char* file, int line, const char* format, ...);
 
+namespace detail {
+
+/**
+ * @brief Format string reference captured by the LOG_CPP_* macros.
+ * @details String literals have static storage and are stored by pointer. Anything else
+ *          (e.g. a std::string's c_str()) is copied into the record.
+ */
+struct FormatRef {
+    const char* text;
+    bool is_static;
+};
+
+/** @brief Argument type tags in a binary log record. */
+enum class ArgTag : uint8_t { I32, U32, I64, U64, F64, STR, PTR };
+
+/** @brief Longest string argument copied into a record; longer strings are truncated. */
+constexpr size_t kMaxLogStringArg = 1024;
+/** @brief Placeholder text recorded for argument types the encoder does not understand. */
+constexpr char kUnsupportedArg[] = "<unsupported>";
+
+/** @brief Fixed part of a binary log record. Followed by an optional format copy and the arguments. */
+struct RecordHeader {
+    uint32_t size;          ///< Total record size in bytes, 8-byte aligned. 0 marks a wrap to the ring start.
+    uint8_t level;
+    uint8_t flags;          ///< kRecordFormatCopied / kRecordPreformatted.
+    uint16_t argc;
+    int32_t line;
+    uint32_t reserved;
+    uint64_t timestamp_ns;
+    const char* file;
+    const char* format;     ///< Valid when the format was not copied.
+};
+constexpr uint8_t kRecordFormatCopied = 0x1;
+constexpr uint8_t kRecordPreformatted = 0x2;
+
+/**
+ * @brief Reserves space for a record in the calling thread's log ring.
+ * @return Pointer to write the record into, or nullptr if the ring is full (the record is counted as dropped).
+ */
+uint8_t* reserve_record(size_t bytes);
+/** @brief Publishes the record most recently reserved by this thread. */
+void commit_record(size_t bytes);
+/** @brief Returns true if log output should also be formatted and mirrored to stderr right away. */
+bool stderr_mirror_enabled();
+/** @brief Formats and writes an encoded record to stderr. */
+void mirror_record_to_stderr(const uint8_t* record);
+uint64_t log_timestamp_ns();
+
+template <typename T>
+struct is_log_string : std::integral_constant<bool,
+    std::is_same<T, const char*>::value || std::is_same<T, char*>::value> {};
+
+// Only real pointers can be null; char arrays and literals are taken as-is so the check
+// does not trip -Waddress / -Wnonnull-compare at every call site.
+template <typename Raw>
+inline const char* log_string_arg(const Raw& raw) {
+    if constexpr (std::is_pointer<Raw>::value) {
+        return raw ? static_cast<const char*>(raw) : "(null)";
+    } else {
+        return raw;
+    }
+}
+
+inline size_t clamp_string_length(const char* str) {
+    return ::strnlen(str, kMaxLogStringArg);
+}
+
+template <typename Raw>
+inline size_t encoded_arg_size(const Raw& raw) {
+    using T = typename std::decay<Raw>::type;
+    if constexpr (is_log_string<T>::value) {
+        return 1 + sizeof(uint32_t) + clamp_string_length(log_string_arg(raw));
+    } else if constexpr (std::is_same<T, std::string>::value) {
+        return 1 + sizeof(uint32_t) + std::min(raw.size(), kMaxLogStringArg);
+    } else if constexpr (std::is_arithmetic<T>::value || std::is_enum<T>::value ||
+                         std::is_pointer<T>::value || std::is_null_pointer<T>::value) {
+        return 1 + 8;
+    } else {
+        return 1 + sizeof(uint32_t) + sizeof(kUnsupportedArg) - 1;
+    }
+}
+
+inline uint8_t* write_tagged(uint8_t* out, ArgTag tag, const void* value, size_t bytes) {
+    *out++ = static_cast<uint8_t>(tag);
+    std::memcpy(out, value, bytes);
+    return out + bytes;
+}
+
+inline uint8_t* write_string_arg(uint8_t* out, const char* str, size_t len) {
+    *out++ = static_cast<uint8_t>(ArgTag::STR);
+    const uint32_t len32 = static_cast<uint32_t>(len);
+    std::memcpy(out, &len32, sizeof(len32));
+    out += sizeof(len32);
+    std::memcpy(out, str, len);
+    return out + len;
+}
+
+template <typename Raw>
+inline uint8_t* encode_arg(uint8_t* out, const Raw& raw) {
+    using T = typename std::decay<Raw>::type;
+    if constexpr (is_log_string<T>::value) {
+        const char* str = log_string_arg(raw);
+        return write_string_arg(out, str, clamp_string_length(str));
+    } else if constexpr (std::is_same<T, std::string>::value) {
+        return write_string_arg(out, raw.data(), std::min(raw.size(), kMaxLogStringArg));
+    } else if constexpr (std::is_enum<T>::value) {
+        return encode_arg(out, static_cast<typename std::underlying_type<T>::type>(raw));
+    } else if constexpr (std::is_floating_point<T>::value) {
+        const double value = static_cast<double>(raw);
+        return write_tagged(out, ArgTag::F64, &value, 8);
+    } else if constexpr (std::is_integral<T>::value) {
+        // Keep the argument's width so %u/%x of a negative 32-bit value prints as before.
+        if constexpr (std::is_signed<T>::value) {
+            const int64_t value = static_cast<int64_t>(raw);
+            return write_tagged(out, sizeof(T) <= 4 ? ArgTag::I32 : ArgTag::I64, &value, 8);
+        } else {
+            const uint64_t value = static_cast<uint64_t>(raw);
+            return write_tagged(out, sizeof(T) <= 4 ? ArgTag::U32 : ArgTag::U64, &value, 8);
+        }
+    } else if constexpr (std::is_pointer<T>::value || std::is_null_pointer<T>::value) {
+        const uint64_t value = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(static_cast<const void*>(raw)));
+        return write_tagged(out, ArgTag::PTR, &value, 8);
+    } else {
+        return write_string_arg(out, kUnsupportedArg, sizeof(kUnsupportedArg) - 1);
+    }
+}
+
+constexpr size_t align_record(size_t bytes) { return (bytes + 7) & ~static_cast<size_t>(7); }
+
+/**
+ * @brief Encodes a log call into the calling thread's ring without formatting it.
+ * @details Only the format pointer, argument bytes and a timestamp are stored; string
+ *          arguments are copied because their storage may not outlive the call. The
+ *          draining side formats the record. Never blocks: a full ring drops the record.
+ */
+template <typename... Args>
+void log_deferred(LogLevel level, const char* file, int line, FormatRef format, const Args&... args) {
+    if (level < current_log_level.load(std::memory_order_relaxed)) {
+        return;
+    }
+    const size_t format_bytes = format.is_static ? 0 : sizeof(uint32_t) + ::strnlen(format.text, kMaxLogStringArg);
+    size_t payload = 0;
+    ((payload += encoded_arg_size(args)), ...);
+    const size_t total = align_record(sizeof(RecordHeader) + format_bytes + payload);
+
+    uint8_t* record = reserve_record(total);
+    if (!record) {
+        return;
+    }
+    RecordHeader header{};
+    header.size = static_cast<uint32_t>(total);
+    header.level = static_cast<uint8_t>(level);
+    header.flags = format.is_static ? 0 : kRecordFormatCopied;
+    header.argc = static_cast<uint16_t>(sizeof...(Args));
+    header.line = line;
+    header.timestamp_ns = log_timestamp_ns();
+    header.file = file;
+    header.format = format.is_static ? format.text : nullptr;
+    std::memcpy(record, &header, sizeof(header));
+
+    uint8_t* out = record + sizeof(RecordHeader);
+    if (!format.is_static) {
+        const uint32_t len = static_cast<uint32_t>(format_bytes - sizeof(uint32_t));
+        std::memcpy(out, &len, sizeof(len));
+        std::memcpy(out + sizeof(len), format.text, len);
+        out += format_bytes;
+    }
+    ((out = encode_arg(out, args)), ...);
+
+    if (stderr_mirror_enabled()) {
+        mirror_record_to_stderr(record);
+    }
+    commit_record(total);
+}
+
+} // namespace detail
+
 /**
  * @brief Helper function to extract the base filename from a full path.
  * @param path The full path to the file.
@@ -142,17 +326,33 @@ inline void bind_logger(pybind11::module_ &m) {
 } // namespace audio
 } // namespace screamrouter
 
+/**
+ * @def SCREAMROUTER_LOG_LEVEL_FLOOR
+ * @brief Compile-time minimum log level (0=DEBUG .. 3=ERROR). Calls below it compile to nothing.
+ */
+#ifndef SCREAMROUTER_LOG_LEVEL_FLOOR
+#define SCREAMROUTER_LOG_LEVEL_FLOOR 0
+#endif
+
 /**
  * @def LOG_CPP_BASE
  * @brief A base macro for logging. Not intended for direct use.
+ * @details String-literal formats are stored by pointer; other formats are copied.
  */
 #define LOG_CPP_BASE(level, fmt, ...) \
-    screamrouter::audio::logging::log_message( \
-        level, \
-        screamrouter::audio::logging::get_base_filename(__FILE__), \
-        __LINE__, \
-        fmt, \
-        ##__VA_ARGS__)
+    do { \
+        if (static_cast<int>(level) >= SCREAMROUTER_LOG_LEVEL_FLOOR) { \
+            screamrouter::audio::logging::detail::log_deferred( \
+                level, \
+                __FILE__, \
+                __LINE__, \
+                screamrouter::audio::logging::detail::FormatRef{ \
+                    (fmt), \
+                    std::is_same<typename std::remove_reference<decltype(fmt)>::type, \
+                                 const char[sizeof(fmt)]>::value}, \
+                ##__VA_ARGS__); \
+        } \
+    } while (0)
 
 /** @def LOG_CPP_DEBUG(fmt, ...) @brief Logs a message at the DEBUG level. */
 #define LOG_CPP_DEBUG(fmt, ...)   LOG_CPP_BASE(screamrouter::audio::logging::LogLevel::DEBUG, fmt, ##__VA_ARGS__)
@@ -0,0 +1,309 @@
+/**
+ * @file mpsc_queue.h
+ * @brief Bounded lock-free multi-producer queue for hot hand-off paths.
+ * @details `MpscQueue` is a drop-in replacement for `ThreadSafeQueue` where many threads push
+ *          and one thread drains: receiver threads feeding the TimeshiftManager, the mixer
+ *          feeding the MP3 reader. It is an array of sequenced cells (Vyukov's bounded queue),
+ *          so producers claim a slot with one CAS and never block each other on a mutex.
+ *
+ *          Consumers that want to sleep use `pop()`, which parks on a futex (a condition
+ *          variable off Linux). Producers only issue a wake-up syscall when a consumer is
+ *          actually parked.
+ *
+ *          The cells tolerate several dequeuers, which is what lets `push_bounded(...,
+ *          drop_oldest=true)` evict the oldest item from the producer side exactly like
+ *          `ThreadSafeQueue` does.
+ */
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#if defined(__linux__)
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+#include "thread_safe_queue.h"
+
+namespace screamrouter {
+namespace audio {
+namespace utils {
+
+/**
+ * @class MpscQueue
+ * @brief Bounded lock-free queue: any number of producers, one draining consumer.
+ * @tparam T Element type; must be default-constructible and move-assignable.
+ */
+template <typename T>
+class MpscQueue {
+public:
+    using PushResult = typename ThreadSafeQueue<T>::PushResult;
+
+    static constexpr std::size_t kDefaultCapacity = 1024;
+
+    /**
+     * @param capacity Maximum number of queued items, rounded up to a power of two.
+     */
+    explicit MpscQueue(std::size_t capacity = kDefaultCapacity)
+        : mask_(round_up_pow2(capacity < 2 ? 2 : capacity) - 1),
+          cells_(new Cell[mask_ + 1]) {
+        for (std::size_t i = 0; i <= mask_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+    MpscQueue(MpscQueue&&) = delete;
+    MpscQueue& operator=(MpscQueue&&) = delete;
+
+    /**
+     * @brief Pushes an item; when the queue is at capacity the oldest item is dropped.
+     * @details Matches `ThreadSafeQueue::push`, which never refuses an item, while keeping
+     *          memory bounded.
+     */
+    void push(T item) {
+        push_bounded(std::move(item), 0, true);
+    }
+
+    /**
+     * @brief Attempts to push an item while enforcing a maximum size.
+     * @param item Item to enqueue (moved on success).
+     * @param max_size Maximum number of items allowed (0 means the queue capacity).
+     * @param drop_oldest When true, the oldest queued item is discarded to make room.
+     * @return Outcome describing whether the item was queued or dropped.
+     * @note If other producers race for the slot freed by an eviction, more than one old item
+     *       may be evicted; `DroppedOldest` is still reported once.
+     */
+    PushResult push_bounded(T item, std::size_t max_size, bool drop_oldest) {
+        if (stop_requested_.load(std::memory_order_acquire)) {
+            return PushResult::QueueStopped;
+        }
+        const std::size_t limit = (max_size == 0 || max_size > capacity()) ? capacity() : max_size;
+
+        bool dropped = false;
+        if (size() >= limit) {
+            if (!drop_oldest) {
+                return PushResult::QueueFull;
+            }
+            T evicted;
+            dropped = dequeue(evicted);
+        }
+        while (!enqueue(item)) {
+            // Only reachable at full capacity when other producers raced us to the free slot.
+            if (!drop_oldest) {
+                return PushResult::QueueFull;
+            }
+            T evicted;
+            dropped = dequeue(evicted) || dropped;
+        }
+        notify();
+        return dropped ? PushResult::DroppedOldest : PushResult::Pushed;
+    }
+
+    /**
+     * @brief Pops an item, blocking while the queue is empty.
+     * @return `true` if an item was popped, `false` if the queue was stopped and is empty.
+     */
+    bool pop(T& item) {
+        for (;;) {
+            if (dequeue(item)) {
+                return true;
+            }
+            if (stop_requested_.load(std::memory_order_acquire)) {
+                return dequeue(item);
+            }
+            const uint32_t seen = wake_seq_.load(std::memory_order_acquire);
+            waiters_.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (dequeue(item)) {
+                waiters_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+            if (!stop_requested_.load(std::memory_order_acquire)) {
+                wait_for_change(seen);
+            }
+            waiters_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Pops an item without blocking.
+     * @return `true` if an item was popped, `false` if the queue was empty.
+     */
+    bool try_pop(T& item) {
+        return dequeue(item);
+    }
+
+    /**
+     * @brief Pops up to max_items without blocking.
+     * @return Number of items written through out.
+     */
+    template <typename OutputIt>
+    std::size_t try_pop_bulk(OutputIt out, std::size_t max_items) {
+        std::size_t count = 0;
+        T item;
+        while (count < max_items && dequeue(item)) {
+            *out = std::move(item);
+            ++out;
+            ++count;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Makes further pushes fail and wakes a blocked `pop()`.
+     */
+    void stop() {
+        stop_requested_.store(true, std::memory_order_release);
+        wake_seq_.fetch_add(1, std::memory_order_release);
+        wake_all();
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /** @brief Approximate number of queued items. */
+    std::size_t size() const {
+        const std::size_t head = dequeue_pos_.load(std::memory_order_acquire);
+        const std::size_t tail = enqueue_pos_.load(std::memory_order_acquire);
+        if (tail <= head) {
+            return 0;
+        }
+        const std::size_t depth = tail - head;
+        return depth > capacity() ? capacity() : depth;
+    }
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+    bool is_stopped() const {
+        return stop_requested_.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr std::size_t kCacheLine = 64;
+
+    struct Cell {
+        std::atomic<std::size_t> sequence{0};
+        T data{};
+    };
+
+    static std::size_t round_up_pow2(std::size_t value) {
+        std::size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    /** @brief Moves item into the queue on success; leaves it untouched when full. */
+    bool enqueue(T& item) {
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = std::move(item);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool dequeue(T& item) {
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        item = std::move(cell->data);
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    void notify() {
+        // Pairs with the seq_cst increment in pop(): either the consumer sees our item on its
+        // re-check, or we see it parked and bump the futex word it is waiting on.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) > 0) {
+            wake_seq_.fetch_add(1, std::memory_order_release);
+            wake_all();
+        }
+    }
+
+#if defined(__linux__)
+    void wait_for_change(uint32_t seen) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&wake_seq_), FUTEX_WAIT_PRIVATE, seen,
+                nullptr, nullptr, 0);
+    }
+
+    void wake_all() {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&wake_seq_), FUTEX_WAKE_PRIVATE, INT_MAX,
+                nullptr, nullptr, 0);
+    }
+#else
+    void wait_for_change(uint32_t seen) {
+        std::unique_lock<std::mutex> lock(wait_mutex_);
+        wait_cv_.wait_for(lock, std::chrono::milliseconds(10), [&] {
+            return wake_seq_.load(std::memory_order_acquire) != seen;
+        });
+    }
+
+    void wake_all() {
+        { std::lock_guard<std::mutex> lock(wait_mutex_); }
+        wait_cv_.notify_all();
+    }
+
+    std::mutex wait_mutex_;
+    std::condition_variable wait_cv_;
+#endif
+
+    const std::size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+
+    alignas(kCacheLine) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(kCacheLine) std::atomic<std::size_t> dequeue_pos_{0};
+    alignas(kCacheLine) std::atomic<uint32_t> wake_seq_{0};
+    std::atomic<int> waiters_{0};
+    std::atomic<bool> stop_requested_{false};
+
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32 bits");
+};
+
+} // namespace utils
+} // namespace audio
+} // namespace screamrouter
+
+#endif // MPSC_QUEUE_H
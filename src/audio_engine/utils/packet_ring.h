@@ -1,9 +1,11 @@
 #ifndef PACKET_RING_H
 #define PACKET_RING_H
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
-#include <optional>
+#include <iterator>
+#include <utility>
 #include <vector>
 
 namespace screamrouter {
@@ -11,18 +13,29 @@ namespace audio {
 namespace utils {
 
 /**
- * @brief Simple single-producer/single-consumer ring buffer with drop-oldest semantics on overflow.
+ * @brief Lock-free single-producer/single-consumer ring buffer.
+ * @details Holds up to capacity() items. Indices are free-running counters: only the producer
+ *          writes tail_ and only the consumer writes head_, each on its own cache line next to
+ *          a cached copy of the other side's index, so the shared line is only touched when the
+ *          cached view says the ring looks full (producer) or empty (consumer).
+ *
+ *          On overflow the producer never touches the consumer's slots: push() rejects the new
+ *          item and counts it. The consumer learns about the gap through take_overflow().
  */
 template <typename T>
 class PacketRing {
 public:
     explicit PacketRing(std::size_t capacity)
-        : capacity_(capacity),
-          buffer_(capacity),
-          head_(0),
-          tail_(0),
-          drop_count_(0) {}
+        : capacity_(std::max<std::size_t>(capacity, 1)),
+          mask_(round_up_pow2(capacity_) - 1),
+          buffer_(mask_ + 1) {}
 
+    PacketRing(const PacketRing&) = delete;
+    PacketRing& operator=(const PacketRing&) = delete;
+
+    // --- Producer side ---
+
+    /** @return false if the ring was full; the item is dropped and counted. */
     bool push(const T& value) {
         return emplace(value);
     }
@@ -31,55 +44,136 @@ public:
         return emplace(std::move(value));
     }
 
+    /**
+     * @brief Moves items from [first, last) into the ring with a single publish.
+     * @return Number of items accepted; the rest are dropped and counted.
+     */
+    template <typename InputIt>
+    std::size_t push_bulk(InputIt first, InputIt last) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t requested = static_cast<std::size_t>(std::distance(first, last));
+        std::size_t space = capacity_ - (tail - cached_head_);
+        if (space < requested) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            space = capacity_ - (tail - cached_head_);
+        }
+        const std::size_t count = std::min(space, requested);
+        for (std::size_t i = 0; i < count; ++i, ++first) {
+            buffer_[(tail + i) & mask_] = std::move(*first);
+        }
+        if (count > 0) {
+            tail_.store(tail + count, std::memory_order_release);
+        }
+        if (count < requested) {
+            drop_count_.fetch_add(requested - count, std::memory_order_relaxed);
+        }
+        return count;
+    }
+
+    // --- Consumer side ---
+
     bool pop(T& out) {
-        const std::size_t head = head_.load(std::memory_order_acquire);
-        const std::size_t tail = tail_.load(std::memory_order_acquire);
-        if (head == tail) {
-            return false; // empty
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false; // empty
+            }
         }
-        out = std::move(buffer_[head]);
-        const std::size_t next = (head + 1) % capacity_;
-        head_.store(next, std::memory_order_release);
+        out = std::move(buffer_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
         return true;
     }
 
+    /**
+     * @brief Moves up to max_items into out with a single release of the slots.
+     * @return Number of items popped.
+     */
+    template <typename OutputIt>
+    std::size_t pop_bulk(OutputIt out, std::size_t max_items) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        std::size_t available = cached_tail_ - head;
+        if (available < max_items) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            available = cached_tail_ - head;
+        }
+        const std::size_t count = std::min(available, max_items);
+        for (std::size_t i = 0; i < count; ++i) {
+            *out = std::move(buffer_[(head + i) & mask_]);
+            ++out;
+        }
+        if (count > 0) {
+            head_.store(head + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Items the producer dropped since the consumer last asked.
+     * @details A non-zero result means there is a gap between the last item popped before the
+     *          overflow and the next one that will be popped.
+     */
+    std::size_t take_overflow() {
+        const std::size_t dropped = drop_count_.load(std::memory_order_relaxed);
+        const std::size_t fresh = dropped - overflow_seen_;
+        overflow_seen_ = dropped;
+        return fresh;
+    }
+
+    // --- Either side ---
+
+    /** @brief Approximate fill level; exact when called from the producer or consumer thread. */
     std::size_t size() const {
         const std::size_t head = head_.load(std::memory_order_acquire);
         const std::size_t tail = tail_.load(std::memory_order_acquire);
-        if (tail >= head) {
-            return tail - head;
-        }
-        return capacity_ - head + tail;
+        return std::min(tail - head, capacity_);
     }
 
     std::size_t capacity() const { return capacity_; }
 
+    /** @brief Total items rejected by push()/push_bulk() because the ring was full. */
     std::size_t drop_count() const { return drop_count_.load(std::memory_order_relaxed); }
 
 private:
+    static constexpr std::size_t kCacheLine = 64;
+
+    static std::size_t round_up_pow2(std::size_t value) {
+        std::size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
     template <typename U>
     bool emplace(U&& value) {
-        std::size_t head = head_.load(std::memory_order_acquire);
-        std::size_t tail = tail_.load(std::memory_order_acquire);
-        std::size_t next = (tail + 1) % capacity_;
-
-        if (next == head) {
-            // overflow: drop oldest
-            head = (head + 1) % capacity_;
-            head_.store(head, std::memory_order_release);
-            drop_count_.fetch_add(1, std::memory_order_relaxed);
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ >= capacity_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ >= capacity_) {
+                drop_count_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
         }
-
-        buffer_[tail] = std::forward<U>(value);
-        tail_.store(next, std::memory_order_release);
+        buffer_[tail & mask_] = std::forward<U>(value);
+        tail_.store(tail + 1, std::memory_order_release);
         return true;
     }
 
+    // Read-only after construction.
     const std::size_t capacity_;
+    const std::size_t mask_;
     std::vector<T> buffer_;
-    std::atomic<std::size_t> head_;
-    std::atomic<std::size_t> tail_;
-    std::atomic<std::size_t> drop_count_;
+
+    // Producer-owned.
+    alignas(kCacheLine) std::atomic<std::size_t> tail_{0};
+    std::size_t cached_head_ = 0;
+    std::atomic<std::size_t> drop_count_{0};
+
+    // Consumer-owned.
+    alignas(kCacheLine) std::atomic<std::size_t> head_{0};
+    std::size_t cached_tail_ = 0;
+    std::size_t overflow_seen_ = 0;
 };
 
 } // namespace utils
@@ -4,49 +4,199 @@
 
 #include "cpp_logger.h"
 #include <algorithm>
-#include <vector>
+#include <map>
 
 namespace screamrouter {
 namespace audio {
 namespace utils {
 
+// Counters are written only by the owning thread; other threads read them with relaxed
+// loads while aggregating, so plain load/store pairs are enough on the hot path.
+struct FunctionProfiler::ThreadBlock {
+    struct Counter {
+        std::atomic<uint64_t> total_ns{0};
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> max_ns{0};
+        uint32_t sample_countdown = 0; // owner-only
+    };
+
+    std::atomic<uint64_t> generation{0};
+    Counter counters[kMaxSites];
+};
+
+struct ThreadBlockOwner {
+    FunctionProfiler::ThreadBlock* block = nullptr;
+    ~ThreadBlockOwner() {
+        if (block) {
+            FunctionProfiler::instance().retire_block(block);
+        }
+    }
+};
+
+namespace {
+
+inline void add_relaxed(std::atomic<uint64_t>& counter, uint64_t value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+} // namespace
+
 FunctionProfiler& FunctionProfiler::instance() {
     static FunctionProfiler instance;
     return instance;
 }
 
-void FunctionProfiler::record(const char* name, uint64_t duration_ns) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto& entry = stats_[name];
-    entry.total_ns += duration_ns;
-    entry.count += 1;
-    entry.max_ns = std::max(entry.max_ns, duration_ns);
+uint32_t FunctionProfiler::register_site(const char* name) {
+    uint32_t index = site_count_.load(std::memory_order_relaxed);
+    do {
+        if (index >= kMaxSites) {
+            return kInvalidSite;
+        }
+    } while (!site_count_.compare_exchange_weak(index, index + 1, std::memory_order_acq_rel));
+    site_names_[index].store(name, std::memory_order_release);
+    return index;
+}
+
+FunctionProfiler::ThreadBlock& FunctionProfiler::local_block() {
+    thread_local ThreadBlockOwner owner;
+    if (!owner.block) {
+        auto* block = new ThreadBlock();
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        block->generation.store(generation_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        blocks_.push_back(block);
+        owner.block = block;
+    }
+    return *owner.block;
+}
+
+void FunctionProfiler::attach_current_thread() {
+    (void)local_block();
+}
+
+void FunctionProfiler::retire_block(ThreadBlock* block) {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    if (block->generation.load(std::memory_order_acquire) == generation_.load(std::memory_order_relaxed)) {
+        const uint32_t sites = std::min<uint32_t>(site_count_.load(std::memory_order_acquire), kMaxSites);
+        if (retired_.size() < sites) {
+            retired_.resize(sites);
+        }
+        for (uint32_t i = 0; i < sites; ++i) {
+            const auto& counter = block->counters[i];
+            retired_[i].total_ns += counter.total_ns.load(std::memory_order_relaxed);
+            retired_[i].count += counter.count.load(std::memory_order_relaxed);
+            retired_[i].max_ns = std::max(retired_[i].max_ns, counter.max_ns.load(std::memory_order_relaxed));
+        }
+    }
+    blocks_.erase(std::remove(blocks_.begin(), blocks_.end(), block), blocks_.end());
+    delete block;
+}
+
+bool FunctionProfiler::should_sample(uint32_t site) {
+    if (!enabled_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    const uint32_t interval = sample_interval_.load(std::memory_order_relaxed);
+    if (interval <= 1) {
+        return true;
+    }
+    auto& counter = local_block().counters[site];
+    if (++counter.sample_countdown >= interval) {
+        counter.sample_countdown = 0;
+        return true;
+    }
+    return false;
+}
+
+void FunctionProfiler::record(uint32_t site, uint64_t duration_ns) {
+    if (site >= kMaxSites) {
+        return;
+    }
+    ThreadBlock& block = local_block();
+    const uint64_t generation = generation_.load(std::memory_order_acquire);
+    if (block.generation.load(std::memory_order_relaxed) != generation) {
+        // A reset happened since this thread last recorded: start its counters over.
+        const uint32_t sites = std::min<uint32_t>(site_count_.load(std::memory_order_acquire), kMaxSites);
+        for (uint32_t i = 0; i < sites; ++i) {
+            block.counters[i].total_ns.store(0, std::memory_order_relaxed);
+            block.counters[i].count.store(0, std::memory_order_relaxed);
+            block.counters[i].max_ns.store(0, std::memory_order_relaxed);
+        }
+        block.generation.store(generation, std::memory_order_release);
+    }
+    auto& counter = block.counters[site];
+    add_relaxed(counter.total_ns, duration_ns);
+    add_relaxed(counter.count, 1);
+    if (duration_ns > counter.max_ns.load(std::memory_order_relaxed)) {
+        counter.max_ns.store(duration_ns, std::memory_order_relaxed);
+    }
+}
+
+void FunctionProfiler::set_sample_interval(uint32_t interval) {
+    sample_interval_.store(std::max<uint32_t>(interval, 1), std::memory_order_relaxed);
+    reset();
 }
 
 void FunctionProfiler::reset() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    stats_.clear();
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    generation_.fetch_add(1, std::memory_order_acq_rel);
+    retired_.clear();
+}
+
+std::vector<std::pair<std::string, FunctionProfiler::Stats>> FunctionProfiler::snapshot() {
+    std::vector<Stats> totals;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        const uint64_t generation = generation_.load(std::memory_order_relaxed);
+        const uint32_t sites = std::min<uint32_t>(site_count_.load(std::memory_order_acquire), kMaxSites);
+        totals = retired_;
+        totals.resize(sites);
+        for (const ThreadBlock* block : blocks_) {
+            // Blocks still on an older generation have not recorded since the last reset.
+            if (block->generation.load(std::memory_order_acquire) != generation) {
+                continue;
+            }
+            for (uint32_t i = 0; i < sites; ++i) {
+                const auto& counter = block->counters[i];
+                totals[i].total_ns += counter.total_ns.load(std::memory_order_relaxed);
+                totals[i].count += counter.count.load(std::memory_order_relaxed);
+                totals[i].max_ns = std::max(totals[i].max_ns, counter.max_ns.load(std::memory_order_relaxed));
+            }
+        }
+    }
+
+    // Sites that share a name (e.g. one function instrumented in several places) are merged.
+    const uint64_t scale = get_sample_interval();
+    std::map<std::string, Stats> by_name;
+    for (uint32_t i = 0; i < totals.size(); ++i) {
+        const char* name = site_names_[i].load(std::memory_order_acquire);
+        if (!name || totals[i].count == 0) {
+            continue;
+        }
+        auto& entry = by_name[name];
+        entry.total_ns += totals[i].total_ns * scale;
+        entry.count += totals[i].count * scale;
+        entry.max_ns = std::max(entry.max_ns, totals[i].max_ns);
+    }
+    return {by_name.begin(), by_name.end()};
 }
 
 void FunctionProfiler::log_stats() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (stats_.empty()) {
+    auto stats = snapshot();
+    if (stats.empty()) {
         LOG_CPP_INFO("[Profiler] No profiling data collected yet.");
         return;
     }
 
-    std::vector<std::pair<std::string, Stats>> snapshot;
-    snapshot.reserve(stats_.size());
-    for (const auto& kv : stats_) {
-        snapshot.emplace_back(kv.first, kv.second);
-    }
-
-    std::sort(snapshot.begin(), snapshot.end(), [](const auto& lhs, const auto& rhs) {
+    std::sort(stats.begin(), stats.end(), [](const auto& lhs, const auto& rhs) {
         return lhs.second.total_ns > rhs.second.total_ns;
     });
 
+    const uint32_t interval = get_sample_interval();
+    if (interval > 1) {
+        LOG_CPP_INFO("[Profiler] Sampling 1 in %u calls; totals and call counts are estimates.", interval);
+    }
     LOG_CPP_INFO("[Profiler] Function timing (total_ms | avg_us | max_us | calls)");
-    for (const auto& [name, stat] : snapshot) {
+    for (const auto& [name, stat] : stats) {
         const double total_ms = static_cast<double>(stat.total_ns) / 1'000'000.0;
         const double avg_us = stat.count > 0 ? (static_cast<double>(stat.total_ns) / static_cast<double>(stat.count)) / 1'000.0 : 0.0;
         const double max_us = static_cast<double>(stat.max_ns) / 1'000.0;
@@ -54,15 +204,6 @@ void FunctionProfiler::log_stats() {
     }
 }
 
-ScopedProfileTimer::ScopedProfileTimer(const char* name)
-    : name_(name), start_(std::chrono::steady_clock::now()) {}
-
-ScopedProfileTimer::~ScopedProfileTimer() {
-    const auto end = std::chrono::steady_clock::now();
-    const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start_).count();
-    FunctionProfiler::instance().record(name_, static_cast<uint64_t>(duration));
-}
-
 } // namespace utils
 } // namespace audio
 } // namespace screamrouter
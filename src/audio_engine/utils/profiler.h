@@ -1,7 +1,9 @@
 #ifndef SCREAMROUTER_AUDIO_UTILS_PROFILER_H
 #define SCREAMROUTER_AUDIO_UTILS_PROFILER_H
 
+#include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
@@ -9,7 +11,7 @@
 
 #ifdef ENABLE_AUDIO_PROFILING
 #include <mutex>
-#include <unordered_map>
+#include <vector>
 #endif
 
 namespace screamrouter {
@@ -18,6 +20,14 @@ namespace utils {
 
 #ifdef ENABLE_AUDIO_PROFILING
 
+/**
+ * @class FunctionProfiler
+ * @brief Aggregates scope timings from PROFILE_FUNCTION()/PROFILE_SCOPE() call sites.
+ * @details Each call site registers once (function-local static) and gets a dense index.
+ *          Timings are written into per-thread counter blocks owned by the recording
+ *          thread, so the hot path takes no lock and touches no shared cache line.
+ *          log_stats() and reset() are the only operations that walk every thread.
+ */
 class FunctionProfiler {
 public:
     struct Stats {
@@ -26,33 +36,103 @@ public:
         uint64_t max_ns = 0;
     };
 
+    /** @brief Upper bound on distinct call sites; later registrations are ignored. */
+    static constexpr std::size_t kMaxSites = 1024;
+    static constexpr uint32_t kInvalidSite = UINT32_MAX;
+
     static FunctionProfiler& instance();
 
-    void record(const char* name, uint64_t duration_ns);
+    /** @brief Registers a call site. Called once per site; returns kInvalidSite when full. */
+    uint32_t register_site(const char* name);
+
+    /**
+     * @brief Allocates the calling thread's counter block if it has none yet.
+     * @details The first timed scope on a thread otherwise allocates the block (~32 KB) and
+     *          takes the registry lock. Real-time threads attach at startup through
+     *          set_current_thread_realtime_priority() so their loops never do.
+     */
+    void attach_current_thread();
+
+    /** @brief Records one timed execution of a site on the calling thread. Lock-free. */
+    void record(uint32_t site, uint64_t duration_ns);
+
+    /** @brief Returns true if the calling thread should time this execution of @p site. */
+    bool should_sample(uint32_t site);
+
+    /** @brief Enables or disables timing at runtime. Disabled sites cost one relaxed load. */
+    void set_enabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    bool is_enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Times only every Nth execution of each site per thread (1 = every call).
+     * @details Reported call counts and totals are scaled back up by N. Changing the
+     *          interval resets the collected stats.
+     */
+    void set_sample_interval(uint32_t interval);
+    uint32_t get_sample_interval() const { return sample_interval_.load(std::memory_order_relaxed); }
+
     void reset();
     void log_stats();
+    /** @brief Returns aggregated stats per site name, scaled for sampling. */
+    std::vector<std::pair<std::string, Stats>> snapshot();
 
 private:
+    struct ThreadBlock;
+    friend struct ThreadBlockOwner;
+
     FunctionProfiler() = default;
     FunctionProfiler(const FunctionProfiler&) = delete;
     FunctionProfiler& operator=(const FunctionProfiler&) = delete;
 
-    std::mutex mutex_;
-    std::unordered_map<std::string, Stats> stats_;
+    ThreadBlock& local_block();
+    void retire_block(ThreadBlock* block);
+
+    std::atomic<bool> enabled_{true};
+    std::atomic<uint32_t> sample_interval_{1};
+    /** @brief Bumped by reset(); threads lazily zero their own counters when they see a new value. */
+    std::atomic<uint64_t> generation_{0};
+
+    std::atomic<uint32_t> site_count_{0};
+    std::atomic<const char*> site_names_[kMaxSites] = {};
+
+    std::mutex registry_mutex_;
+    std::vector<ThreadBlock*> blocks_;
+    /** @brief Totals folded in from threads that exited during the current generation. */
+    std::vector<Stats> retired_;
 };
 
 class ScopedProfileTimer {
 public:
-    explicit ScopedProfileTimer(const char* name);
-    ~ScopedProfileTimer();
+    explicit ScopedProfileTimer(uint32_t site)
+        : site_(site),
+          active_(site != FunctionProfiler::kInvalidSite && FunctionProfiler::instance().should_sample(site)) {
+        if (active_) {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+    ~ScopedProfileTimer() {
+        if (active_) {
+            const auto end = std::chrono::steady_clock::now();
+            FunctionProfiler::instance().record(
+                site_, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start_).count()));
+        }
+    }
 
 private:
-    const char* name_;
+    uint32_t site_;
+    bool active_;
     std::chrono::steady_clock::time_point start_;
 };
 
-#define PROFILE_FUNCTION() ::screamrouter::audio::utils::ScopedProfileTimer profile_timer_##__LINE__(__FUNCTION__)
-#define PROFILE_SCOPE(name) ::screamrouter::audio::utils::ScopedProfileTimer profile_timer_##__LINE__(name)
+#define SR_PROFILE_CONCAT_INNER(a, b) a##b
+#define SR_PROFILE_CONCAT(a, b) SR_PROFILE_CONCAT_INNER(a, b)
+// The name must be constant for a given call site; it is captured on first execution.
+#define PROFILE_SCOPE(name)                                                                               \
+    static const uint32_t SR_PROFILE_CONCAT(profile_site_, __LINE__) =                                    \
+        ::screamrouter::audio::utils::FunctionProfiler::instance().register_site(name);                   \
+    ::screamrouter::audio::utils::ScopedProfileTimer SR_PROFILE_CONCAT(profile_timer_, __LINE__)(         \
+        SR_PROFILE_CONCAT(profile_site_, __LINE__))
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
 
 #else  // ENABLE_AUDIO_PROFILING
 
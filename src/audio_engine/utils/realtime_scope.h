@@ -0,0 +1,89 @@
+/**
+ * @file realtime_scope.h
+ * @brief Marks code that must not allocate, block or make syscalls.
+ * @details SR_RT_SCOPE("name") flags the current thread as real-time until the end of the
+ *          enclosing scope. In normal builds the macros expand to nothing. Test builds define
+ *          SCREAMROUTER_RT_CHECKS and link tests/support/realtime_checker.cpp, which intercepts
+ *          malloc/free, contended mutex locks, condition waits and blocking syscalls, and
+ *          records a violation with a call stack whenever one happens inside a scope.
+ *
+ *          SR_RT_ALLOW("reason") suspends checking for the rest of a scope. It is for known,
+ *          reviewed exceptions (a rare reconfiguration path, a handoff that still allocates),
+ *          and the reason string is what a reviewer reads, so make it specific.
+ */
+#ifndef SCREAMROUTER_AUDIO_UTILS_REALTIME_SCOPE_H
+#define SCREAMROUTER_AUDIO_UTILS_REALTIME_SCOPE_H
+
+namespace screamrouter {
+namespace audio {
+namespace utils {
+namespace rt {
+
+/** @brief Per-thread real-time state read by the checker's interceptors. */
+struct ThreadState {
+    /** @brief Nesting depth of SR_RT_SCOPE; the thread is real-time while > 0. */
+    int depth = 0;
+    /** @brief Nesting depth of SR_RT_ALLOW and of the checker's own bookkeeping. */
+    int suspended = 0;
+    /** @brief Name of the outermost open scope. */
+    const char* scope = nullptr;
+};
+
+inline ThreadState& thread_state() {
+    static thread_local ThreadState state;
+    return state;
+}
+
+/** @brief True when the calling thread is inside SR_RT_SCOPE and not inside SR_RT_ALLOW. */
+inline bool in_realtime_context() {
+    const ThreadState& state = thread_state();
+    return state.depth > 0 && state.suspended == 0;
+}
+
+class RealtimeScope {
+public:
+    explicit RealtimeScope(const char* name) {
+        ThreadState& state = thread_state();
+        if (state.depth++ == 0) {
+            state.scope = name;
+        }
+    }
+    ~RealtimeScope() {
+        ThreadState& state = thread_state();
+        if (--state.depth == 0) {
+            state.scope = nullptr;
+        }
+    }
+    RealtimeScope(const RealtimeScope&) = delete;
+    RealtimeScope& operator=(const RealtimeScope&) = delete;
+};
+
+class AllowNonRealtime {
+public:
+    explicit AllowNonRealtime(const char* reason) { (void)reason; ++thread_state().suspended; }
+    ~AllowNonRealtime() { --thread_state().suspended; }
+    AllowNonRealtime(const AllowNonRealtime&) = delete;
+    AllowNonRealtime& operator=(const AllowNonRealtime&) = delete;
+};
+
+} // namespace rt
+} // namespace utils
+} // namespace audio
+} // namespace screamrouter
+
+#define SR_RT_CONCAT_INNER(a, b) a##b
+#define SR_RT_CONCAT(a, b) SR_RT_CONCAT_INNER(a, b)
+
+#if defined(SCREAMROUTER_RT_CHECKS)
+/** @brief Treats the rest of the enclosing scope as real-time code. */
+#define SR_RT_SCOPE(name) \
+    ::screamrouter::audio::utils::rt::RealtimeScope SR_RT_CONCAT(rt_scope_, __LINE__)(name)
+/** @brief Suspends real-time checking for the rest of the enclosing scope. */
+#define SR_RT_ALLOW(reason) \
+    ::screamrouter::audio::utils::rt::AllowNonRealtime SR_RT_CONCAT(rt_allow_, __LINE__)(reason)
+#else
+#define SR_RT_SCOPE(name) ((void)0)
+#define SR_RT_ALLOW(reason) ((void)0)
+#endif
+
+#endif // SCREAMROUTER_AUDIO_UTILS_REALTIME_SCOPE_H
@@ -0,0 +1,248 @@
+#include "span_tracer.h"
+
+#include "cpp_logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <map>
+
+#if defined(__linux__)
+#include <pthread.h>
+#endif
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+namespace screamrouter {
+namespace audio {
+namespace utils {
+
+// Each slot is guarded by a sequence counter (odd while the owner is writing it), so
+// dump() can read live rings and discard the few slots that are being overwritten.
+struct SpanTracer::ThreadRing {
+    struct Slot {
+        std::atomic<uint64_t> seq{0};
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t> begin_ns{0};
+        std::atomic<uint64_t> dur_ns{0};
+        std::atomic<uint64_t> flow_id{0};
+    };
+
+    explicit ThreadRing(size_t capacity) : slots(new Slot[capacity]), mask(capacity - 1) {}
+
+    std::atomic<uint64_t> write_index{0};
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+    uint32_t tid = 0;
+    std::string thread_name;
+    std::atomic<bool> retired{false};
+};
+
+struct ThreadRingOwner {
+    std::shared_ptr<SpanTracer::ThreadRing> ring;
+    ~ThreadRingOwner() {
+        if (ring) {
+            ring->retired.store(true, std::memory_order_release);
+        }
+    }
+};
+
+namespace {
+
+size_t round_up_pow2(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+std::string current_thread_name() {
+#if defined(__linux__)
+    char name[32] = {};
+    if (pthread_getname_np(pthread_self(), name, sizeof(name)) == 0 && name[0] != '\0') {
+        return name;
+    }
+#endif
+    return "thread";
+}
+
+void write_json_string(FILE* fp, const char* text) {
+    std::fputc('"', fp);
+    for (const char* p = text; *p; ++p) {
+        const unsigned char c = static_cast<unsigned char>(*p);
+        if (c == '"' || c == '\\') {
+            std::fputc('\\', fp);
+            std::fputc(c, fp);
+        } else if (c < 0x20) {
+            std::fprintf(fp, "\\u%04x", c);
+        } else {
+            std::fputc(c, fp);
+        }
+    }
+    std::fputc('"', fp);
+}
+
+struct DumpEvent {
+    const char* name;
+    uint64_t begin_ns;
+    uint64_t dur_ns;
+    uint64_t flow_id;
+    uint32_t tid;
+};
+
+} // namespace
+
+SpanTracer& SpanTracer::instance() {
+    static SpanTracer instance;
+    return instance;
+}
+
+uint64_t SpanTracer::now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void SpanTracer::start(size_t events_per_thread) {
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        // Rings of threads that have exited are only kept around for the next dump.
+        rings_.erase(std::remove_if(rings_.begin(), rings_.end(),
+                                    [](const auto& ring) { return ring->retired.load(std::memory_order_acquire); }),
+                     rings_.end());
+    }
+    events_per_thread_.store(round_up_pow2(std::max<size_t>(events_per_thread, 64)), std::memory_order_relaxed);
+    session_start_ns_.store(now_ns(), std::memory_order_relaxed);
+    enabled_.store(true, std::memory_order_release);
+    LOG_CPP_INFO("[SpanTracer] Tracing started (%zu events per thread).", events_per_thread_.load());
+}
+
+void SpanTracer::stop() {
+    enabled_.store(false, std::memory_order_release);
+    LOG_CPP_INFO("[SpanTracer] Tracing stopped.");
+}
+
+SpanTracer::ThreadRing* SpanTracer::local_ring() {
+    thread_local ThreadRingOwner owner;
+    if (!owner.ring) {
+        auto ring = std::make_shared<ThreadRing>(events_per_thread_.load(std::memory_order_relaxed));
+        ring->thread_name = current_thread_name();
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        ring->tid = next_thread_index_++;
+        rings_.push_back(ring);
+        owner.ring = std::move(ring);
+    }
+    return owner.ring.get();
+}
+
+void SpanTracer::write_event(const char* name, uint64_t begin_ns, uint64_t dur_ns, uint64_t flow_id) {
+    ThreadRing* ring = local_ring();
+    const uint64_t index = ring->write_index.load(std::memory_order_relaxed);
+    auto& slot = ring->slots[index & ring->mask];
+    const uint64_t seq = slot.seq.load(std::memory_order_relaxed);
+    slot.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.begin_ns.store(begin_ns, std::memory_order_relaxed);
+    slot.dur_ns.store(dur_ns, std::memory_order_relaxed);
+    slot.flow_id.store(flow_id, std::memory_order_relaxed);
+    slot.seq.store(seq + 2, std::memory_order_release);
+    ring->write_index.store(index + 1, std::memory_order_release);
+}
+
+void SpanTracer::record_span(const char* name, uint64_t begin_ns, uint64_t end_ns) {
+    write_event(name, begin_ns, end_ns >= begin_ns ? end_ns - begin_ns : 0, 0);
+}
+
+void SpanTracer::record_flow(uint64_t flow_id, uint64_t ts_ns) {
+    write_event(nullptr, ts_ns, 0, flow_id);
+}
+
+bool SpanTracer::dump(const std::string& path) {
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        rings = rings_;
+    }
+    const uint64_t session_start = session_start_ns_.load(std::memory_order_relaxed);
+
+    std::vector<DumpEvent> spans;
+    std::map<uint64_t, std::vector<DumpEvent>> flows;
+    for (const auto& ring : rings) {
+        const uint64_t end = ring->write_index.load(std::memory_order_acquire);
+        const uint64_t capacity = ring->mask + 1;
+        const uint64_t begin = end > capacity ? end - capacity : 0;
+        for (uint64_t i = begin; i < end; ++i) {
+            const auto& slot = ring->slots[i & ring->mask];
+            const uint64_t seq_before = slot.seq.load(std::memory_order_acquire);
+            if (seq_before & 1) {
+                continue;
+            }
+            DumpEvent event{slot.name.load(std::memory_order_relaxed),
+                            slot.begin_ns.load(std::memory_order_relaxed),
+                            slot.dur_ns.load(std::memory_order_relaxed),
+                            slot.flow_id.load(std::memory_order_relaxed),
+                            ring->tid};
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) != seq_before || event.begin_ns < session_start) {
+                continue;
+            }
+            if (event.name) {
+                spans.push_back(event);
+            } else if (event.flow_id != 0) {
+                flows[event.flow_id].push_back(event);
+            }
+        }
+    }
+
+    FILE* fp = std::fopen(path.c_str(), "w");
+    if (!fp) {
+        LOG_CPP_ERROR("[SpanTracer] Failed to open trace file '%s'.", path.c_str());
+        return false;
+    }
+#if defined(_WIN32)
+    const int pid = 0;
+#else
+    const int pid = static_cast<int>(::getpid());
+#endif
+    auto us = [session_start](uint64_t ns) { return static_cast<double>(ns - session_start) / 1000.0; };
+
+    std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", fp);
+    std::fprintf(fp, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"screamrouter_audio_engine\"}}", pid);
+    for (const auto& ring : rings) {
+        std::fprintf(fp, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%u,\"args\":{\"name\":", pid, ring->tid);
+        write_json_string(fp, ring->thread_name.c_str());
+        std::fputs("}}", fp);
+    }
+    for (const auto& span : spans) {
+        std::fputs(",\n{\"name\":", fp);
+        write_json_string(fp, span.name);
+        std::fprintf(fp, ",\"cat\":\"audio\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%u}",
+                     us(span.begin_ns), static_cast<double>(span.dur_ns) / 1000.0, pid, span.tid);
+    }
+    // Flow steps become s/t/f events, which bind to the span enclosing them on their thread.
+    for (auto& [flow_id, steps] : flows) {
+        if (steps.size() < 2) {
+            continue;
+        }
+        std::sort(steps.begin(), steps.end(),
+                  [](const DumpEvent& lhs, const DumpEvent& rhs) { return lhs.begin_ns < rhs.begin_ns; });
+        for (size_t i = 0; i < steps.size(); ++i) {
+            const char* phase = i == 0 ? "s" : (i + 1 == steps.size() ? "f" : "t");
+            std::fprintf(fp, ",\n{\"name\":\"flow\",\"cat\":\"audio\",\"ph\":\"%s\",\"id\":%" PRIu64
+                             ",\"ts\":%.3f,\"pid\":%d,\"tid\":%u%s}",
+                         phase, flow_id, us(steps[i].begin_ns), pid, steps[i].tid,
+                         i == 0 ? "" : ",\"bp\":\"e\"");
+        }
+    }
+    std::fputs("\n]}\n", fp);
+    const bool ok = std::fclose(fp) == 0;
+    LOG_CPP_INFO("[SpanTracer] Wrote %zu spans and %zu flows to '%s'.", spans.size(), flows.size(), path.c_str());
+    return ok;
+}
+
+} // namespace utils
+} // namespace audio
+} // namespace screamrouter
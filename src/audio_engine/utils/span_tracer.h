@@ -0,0 +1,131 @@
+/**
+ * @file span_tracer.h
+ * @brief Scoped trace spans and packet/chunk flows for the audio pipeline.
+ * @details Spans are written into per-thread ring buffers (flight-recorder style: the
+ *          oldest events are overwritten) so recording takes no lock. dump() writes the
+ *          recorded window as Chrome Trace Event JSON, which Perfetto UI and
+ *          chrome://tracing both load. Unlike fntrace, this is meant to be switched on in
+ *          production builds when a latency problem needs to be looked at.
+ */
+#ifndef SCREAMROUTER_AUDIO_UTILS_SPAN_TRACER_H
+#define SCREAMROUTER_AUDIO_UTILS_SPAN_TRACER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace screamrouter {
+namespace audio {
+namespace utils {
+
+/**
+ * @class SpanTracer
+ * @brief Process-wide span recorder. Disabled by default; a disabled span costs one relaxed load.
+ */
+class SpanTracer {
+public:
+    static constexpr size_t kDefaultEventsPerThread = 16384;
+
+    static SpanTracer& instance();
+
+    /**
+     * @brief Starts a new trace session.
+     * @param events_per_thread Ring capacity for threads that start recording in this session,
+     *        rounded up to a power of two. Events recorded before this call are not dumped.
+     */
+    void start(size_t events_per_thread = kDefaultEventsPerThread);
+    /** @brief Stops recording. Recorded events stay available to dump(). */
+    void stop();
+    bool is_enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Writes the events recorded in the current session to @p path as Chrome Trace JSON.
+     * @return false if the file could not be written.
+     */
+    bool dump(const std::string& path);
+
+    /** @brief Returns a new flow id, or 0 when tracing is off (0 means "no flow"). */
+    uint64_t next_flow_id() {
+        return is_enabled() ? next_flow_id_.fetch_add(1, std::memory_order_relaxed) : 0;
+    }
+
+    /** @brief Records a completed span. @p name must be a string with static storage. */
+    void record_span(const char* name, uint64_t begin_ns, uint64_t end_ns);
+    /** @brief Records that flow @p flow_id passed through the span enclosing @p ts_ns on this thread. */
+    void record_flow(uint64_t flow_id, uint64_t ts_ns);
+
+    static uint64_t now_ns();
+
+private:
+    struct ThreadRing;
+    friend struct ThreadRingOwner;
+
+    SpanTracer() = default;
+    SpanTracer(const SpanTracer&) = delete;
+    SpanTracer& operator=(const SpanTracer&) = delete;
+
+    ThreadRing* local_ring();
+    void write_event(const char* name, uint64_t begin_ns, uint64_t dur_ns, uint64_t flow_id);
+
+    std::atomic<bool> enabled_{false};
+    std::atomic<uint64_t> session_start_ns_{0};
+    std::atomic<size_t> events_per_thread_{kDefaultEventsPerThread};
+    std::atomic<uint64_t> next_flow_id_{1};
+
+    std::mutex registry_mutex_;
+    std::vector<std::shared_ptr<ThreadRing>> rings_;
+    uint32_t next_thread_index_ = 1;
+};
+
+/** @brief RAII span: records [construction, destruction) when tracing is enabled. */
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name, uint64_t flow_id = 0)
+        : name_(SpanTracer::instance().is_enabled() ? name : nullptr) {
+        if (name_) {
+            begin_ns_ = SpanTracer::now_ns();
+            if (flow_id != 0) {
+                SpanTracer::instance().record_flow(flow_id, begin_ns_);
+            }
+        }
+    }
+    ~TraceSpan() {
+        if (name_) {
+            SpanTracer::instance().record_span(name_, begin_ns_, SpanTracer::now_ns());
+        }
+    }
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* name_;
+    uint64_t begin_ns_ = 0;
+};
+
+/** @brief Marks flow @p flow_id as passing through the currently open span. */
+inline void trace_flow(uint64_t flow_id) {
+    if (flow_id != 0 && SpanTracer::instance().is_enabled()) {
+        SpanTracer::instance().record_flow(flow_id, SpanTracer::now_ns());
+    }
+}
+
+#define SR_TRACE_CONCAT_INNER(a, b) a##b
+#define SR_TRACE_CONCAT(a, b) SR_TRACE_CONCAT_INNER(a, b)
+/** @brief Opens a span named @p name (a string literal) until the end of the enclosing scope. */
+#define SR_TRACE_SPAN(name) \
+    ::screamrouter::audio::utils::TraceSpan SR_TRACE_CONCAT(trace_span_, __LINE__)(name)
+/** @brief Opens a span and attaches flow @p flow_id to it. */
+#define SR_TRACE_SPAN_FLOW(name, flow_id) \
+    ::screamrouter::audio::utils::TraceSpan SR_TRACE_CONCAT(trace_span_, __LINE__)(name, flow_id)
+/** @brief Attaches flow @p flow_id to the currently open span. */
+#define SR_TRACE_FLOW(flow_id) ::screamrouter::audio::utils::trace_flow(flow_id)
+
+} // namespace utils
+} // namespace audio
+} // namespace screamrouter
+
+#endif // SCREAMROUTER_AUDIO_UTILS_SPAN_TRACER_H
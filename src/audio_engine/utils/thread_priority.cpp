@@ -5,6 +5,7 @@
 
 #include "thread_priority.h"
 #include "cpp_logger.h"
+#include "profiler.h"
 
 #include <optional>
 #include <string>
@@ -123,6 +124,10 @@ bool set_win32_realtime_priority(HANDLE handle, const char* thread_name) {
 } // namespace
 
 bool set_current_thread_realtime_priority(const char* thread_name) {
+#ifdef ENABLE_AUDIO_PROFILING
+    // Callers are about to enter their real-time loop; set up profiling state while allocating is still fine.
+    FunctionProfiler::instance().attach_current_thread();
+#endif
 #if defined(__linux__)
     return set_posix_realtime_priority(pthread_self(), thread_name);
 #elif defined(_WIN32)
@@ -13,6 +13,7 @@ namespace utils {
 
 /**
  * @brief Promote the calling thread to real-time priority if the platform allows it.
+ * @details Also attaches the thread to FunctionProfiler so timed scopes in its loop do not allocate.
  * @param thread_name Human-readable thread label for logging.
  * @return true on success, false if the promotion failed or is unsupported.
  */
@@ -0,0 +1,90 @@
+/**
+ * @file bench_mixing.cpp
+ * @brief Sink mix accumulation, speaker-mix kernels and silence detection.
+ */
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "audio_processor/silence_detect.h"
+#include "audio_processor/speaker_mix_kernels.h"
+#include "output_mixer/mix_accumulate.h"
+
+using screamrouter::audio::is_digital_silence;
+using screamrouter::audio::mix_accumulate_saturating;
+using screamrouter::audio::select_speaker_mix_kernel;
+
+namespace {
+
+std::vector<int32_t> random_samples(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int32_t> dist(-(1 << 28), 1 << 28);
+    std::vector<int32_t> samples(count);
+    for (auto& s : samples) {
+        s = dist(rng);
+    }
+    return samples;
+}
+
+} // namespace
+
+// One SinkAudioMixer::mix_buffers pass. range(0): active sources, range(1): output channels.
+static void BM_MixAccumulate(benchmark::State& state) {
+    const int sources = static_cast<int>(state.range(0));
+    const size_t channels = static_cast<size_t>(state.range(1));
+    const size_t samples = 288 * channels;
+    std::vector<std::vector<int32_t>> inputs;
+    for (int s = 0; s < sources; ++s) {
+        inputs.push_back(random_samples(samples, static_cast<uint32_t>(s + 1)));
+    }
+    std::vector<int32_t> mix(samples);
+    for (auto _ : state) {
+        std::fill(mix.begin(), mix.end(), 0);
+        for (const auto& input : inputs) {
+            mix_accumulate_saturating(mix.data(), input.data(), samples);
+        }
+        benchmark::DoNotOptimize(mix.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * sources * static_cast<int64_t>(samples));
+}
+BENCHMARK(BM_MixAccumulate)
+    ->ArgNames({"sources", "channels"})
+    ->ArgsProduct({{1, 4, 16}, {2, 8}});
+
+// range(0): input channels, range(1): output channels.
+static void BM_SpeakerMixKernel(benchmark::State& state) {
+    const int in_ch = static_cast<int>(state.range(0));
+    const int out_ch = static_cast<int>(state.range(1));
+    auto kernel = select_speaker_mix_kernel(in_ch, out_ch);
+    if (!kernel) {
+        state.SkipWithError("no specialized kernel for this channel pair");
+        return;
+    }
+    const size_t frames = 480;
+    std::vector<float> in(frames * in_ch, 0.25f);
+    std::vector<float> out(frames * out_ch);
+    std::vector<float> gains(static_cast<size_t>(in_ch * out_ch), 0.5f);
+    for (auto _ : state) {
+        kernel(in.data(), out.data(), frames, gains.data());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(frames));
+}
+BENCHMARK(BM_SpeakerMixKernel)
+    ->ArgNames({"in", "out"})
+    ->Args({2, 2})
+    ->Args({2, 8})
+    ->Args({8, 2})
+    ->Args({8, 8});
+
+static void BM_SilenceDetect(benchmark::State& state) {
+    const size_t bytes = static_cast<size_t>(state.range(0));
+    std::vector<uint8_t> silent(bytes, 0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(is_digital_silence(silent.data(), silent.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_SilenceDetect)->Arg(1152)->Arg(4608);
@@ -0,0 +1,96 @@
+/**
+ * @file bench_queues.cpp
+ * @brief Many-producer hand-off through ThreadSafeQueue versus MpscQueue.
+ * @details Models receiver threads feeding TimeshiftManager's inbound queue: each benchmark
+ *          thread is a producer, and one extra thread drains the queue with try_pop. Items
+ *          are word-sized so the numbers are queue overhead, not packet copies.
+ */
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "utils/mpsc_queue.h"
+#include "utils/thread_safe_queue.h"
+
+using screamrouter::audio::utils::MpscQueue;
+using screamrouter::audio::utils::ThreadSafeQueue;
+
+namespace {
+
+constexpr std::size_t kQueueDepth = 1024;
+
+template <typename Queue>
+struct SharedQueue {
+    Queue queue;
+    std::atomic<bool> draining{false};
+    std::thread consumer;
+
+    void start() {
+        draining.store(true);
+        consumer = std::thread([this] {
+            uint64_t value = 0;
+            while (draining.load(std::memory_order_relaxed)) {
+                if (!queue.try_pop(value)) {
+                    std::this_thread::yield();
+                }
+            }
+            while (queue.try_pop(value)) {
+            }
+        });
+    }
+
+    void finish() {
+        draining.store(false);
+        consumer.join();
+    }
+};
+
+template <typename Queue>
+SharedQueue<Queue>& shared_queue();
+
+template <>
+SharedQueue<ThreadSafeQueue<uint64_t>>& shared_queue() {
+    static SharedQueue<ThreadSafeQueue<uint64_t>> instance;
+    return instance;
+}
+
+template <>
+SharedQueue<MpscQueue<uint64_t>>& shared_queue() {
+    static SharedQueue<MpscQueue<uint64_t>> instance{MpscQueue<uint64_t>(kQueueDepth)};
+    return instance;
+}
+
+template <typename Queue>
+void run_producers(benchmark::State& state) {
+    using PushResult = typename Queue::PushResult;
+    auto& shared = shared_queue<Queue>();
+    if (state.thread_index() == 0) {
+        shared.start();
+    }
+    uint64_t next = 0;
+    for (auto _ : state) {
+        // Back off when full, as a receiver would, so every iteration hands off one item.
+        while (shared.queue.push_bounded(next, kQueueDepth, false) != PushResult::Pushed) {
+            std::this_thread::yield();
+        }
+        ++next;
+    }
+    if (state.thread_index() == 0) {
+        shared.finish();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+static void BM_ThreadSafeQueue_Producers(benchmark::State& state) {
+    run_producers<ThreadSafeQueue<uint64_t>>(state);
+}
+BENCHMARK(BM_ThreadSafeQueue_Producers)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_MpscQueue_Producers(benchmark::State& state) {
+    run_producers<MpscQueue<uint64_t>>(state);
+}
+BENCHMARK(BM_MpscQueue_Producers)->ThreadRange(1, 64)->UseRealTime();
@@ -0,0 +1,119 @@
+/**
+ * @file bench_ring_buffers.cpp
+ * @brief Throughput of the PacketRing and ByteRingBuffer hand-off paths.
+ */
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "audio_types.h"
+#include "utils/byte_ring_buffer.h"
+#include "utils/packet_ring.h"
+
+using screamrouter::audio::TaggedAudioPacket;
+using screamrouter::audio::utils::ByteRingBuffer;
+using screamrouter::audio::utils::PacketRing;
+
+namespace {
+
+TaggedAudioPacket make_packet(size_t payload_bytes) {
+    TaggedAudioPacket packet;
+    packet.source_tag = "192.168.1.10";
+    packet.audio_data.assign(payload_bytes, 0x5a);
+    packet.channels = 2;
+    packet.sample_rate = 48000;
+    packet.bit_depth = 16;
+    packet.rtp_timestamp = 0;
+    packet.ssrcs = {0x1234u};
+    return packet;
+}
+
+} // namespace
+
+// Single-threaded push+pop of copies, as TimeshiftManager does when fanning out to sink rings.
+static void BM_PacketRing_PushPop(benchmark::State& state) {
+    const size_t payload_bytes = static_cast<size_t>(state.range(0));
+    PacketRing<TaggedAudioPacket> ring(64);
+    const TaggedAudioPacket packet = make_packet(payload_bytes);
+    TaggedAudioPacket out;
+    for (auto _ : state) {
+        ring.push(packet);
+        ring.pop(out);
+        benchmark::DoNotOptimize(out.audio_data.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(payload_bytes));
+}
+BENCHMARK(BM_PacketRing_PushPop)->Arg(1152)->Arg(1920)->Arg(4608);
+
+// Producer and consumer on separate threads; measures the cross-core hand-off.
+static void BM_PacketRing_CrossThread(benchmark::State& state) {
+    const size_t payload_bytes = static_cast<size_t>(state.range(0));
+    PacketRing<TaggedAudioPacket> ring(256);
+    std::atomic<bool> running{true};
+    std::atomic<int64_t> consumed{0};
+    std::thread consumer([&] {
+        TaggedAudioPacket out;
+        while (running.load(std::memory_order_relaxed)) {
+            if (ring.pop(out)) {
+                consumed.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    const TaggedAudioPacket packet = make_packet(payload_bytes);
+    for (auto _ : state) {
+        // A full ring rejects the push; retry so every iteration hands off one packet.
+        while (!ring.push(packet)) {
+            std::this_thread::yield();
+        }
+    }
+    running.store(false);
+    consumer.join();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PacketRing_CrossThread)->Arg(1152)->UseRealTime();
+
+// Ring overhead alone: word-sized items, consumer draining with pop_bulk in batches of Arg.
+static void BM_PacketRing_CrossThreadBulk(benchmark::State& state) {
+    const size_t batch = static_cast<size_t>(state.range(0));
+    PacketRing<uint64_t> ring(1024);
+    std::atomic<bool> running{true};
+    std::thread consumer([&] {
+        std::vector<uint64_t> out(batch);
+        while (running.load(std::memory_order_relaxed)) {
+            if (ring.pop_bulk(out.data(), batch) == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    uint64_t next = 0;
+    for (auto _ : state) {
+        while (!ring.push(next)) {
+            std::this_thread::yield();
+        }
+        ++next;
+    }
+    running.store(false);
+    consumer.join();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PacketRing_CrossThreadBulk)->Arg(1)->Arg(16)->Arg(64)->UseRealTime();
+
+static void BM_ByteRingBuffer_WriteRead(benchmark::State& state) {
+    const size_t chunk_bytes = static_cast<size_t>(state.range(0));
+    ByteRingBuffer ring;
+    ring.reserve(chunk_bytes * 8);
+    std::vector<uint8_t> in(chunk_bytes, 0x33);
+    std::vector<uint8_t> out(chunk_bytes);
+    for (auto _ : state) {
+        ring.write(in.data(), in.size());
+        benchmark::DoNotOptimize(ring.pop(out.data(), out.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(chunk_bytes));
+}
+BENCHMARK(BM_ByteRingBuffer_WriteRead)->Arg(256)->Arg(1152)->Arg(4608)->Arg(16384);
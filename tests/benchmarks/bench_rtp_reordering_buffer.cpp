@@ -0,0 +1,55 @@
+/**
+ * @file bench_rtp_reordering_buffer.cpp
+ * @brief Cost per packet of RtpReorderingBuffer for in-order and jittered arrival.
+ */
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <vector>
+
+#include "receivers/rtp/rtp_reordering_buffer.h"
+
+namespace {
+
+RtpPacketData make_packet(uint16_t seq, size_t payload_bytes) {
+    RtpPacketData packet;
+    packet.sequence_number = seq;
+    packet.rtp_timestamp = static_cast<uint32_t>(seq) * 288u;
+    packet.received_time = std::chrono::steady_clock::now();
+    packet.payload.assign(payload_bytes, 0x11);
+    packet.ssrc = 0xabcdu;
+    return packet;
+}
+
+} // namespace
+
+// range(0): payload bytes, range(1): reorder distance (0 = in order; N swaps every N-th pair).
+static void BM_RtpReorderingBuffer(benchmark::State& state) {
+    const size_t payload_bytes = static_cast<size_t>(state.range(0));
+    const int reorder_every = static_cast<int>(state.range(1));
+    RtpReorderingBuffer buffer(std::chrono::milliseconds(20), 128);
+    uint16_t seq = 0;
+    int64_t released = 0;
+    for (auto _ : state) {
+        if (reorder_every > 0 && (seq % reorder_every) == 0) {
+            buffer.add_packet(make_packet(static_cast<uint16_t>(seq + 1), payload_bytes));
+            buffer.add_packet(make_packet(seq, payload_bytes));
+        } else {
+            buffer.add_packet(make_packet(seq, payload_bytes));
+            buffer.add_packet(make_packet(static_cast<uint16_t>(seq + 1), payload_bytes));
+        }
+        seq = static_cast<uint16_t>(seq + 2);
+        auto ready = buffer.get_ready_packets();
+        released += static_cast<int64_t>(ready.size());
+        benchmark::DoNotOptimize(ready.data());
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+    state.counters["released_per_iter"] = benchmark::Counter(
+        static_cast<double>(released), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_RtpReorderingBuffer)
+    ->ArgNames({"payload", "reorder_every"})
+    ->Args({1152, 0})
+    ->Args({1152, 4})
+    ->Args({4608, 0})
+    ->Args({4608, 4});
@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""
+Compare two Google Benchmark JSON result files and flag regressions.
+
+Usage:
+    compare_benchmarks.py baseline.json candidate.json [--threshold 5] [--metric cpu_time]
+
+Exits with status 1 when any benchmark present in both files got slower than the
+threshold (in percent), so it can gate a CI job.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_results(path, metric):
+    """Returns {benchmark name: time in ns} for plain iteration results in @path."""
+    with open(path, "r", encoding="utf-8") as handle:
+        data = json.load(handle)
+
+    scale_to_ns = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+    results = {}
+    for entry in data.get("benchmarks", []):
+        # Aggregates (mean/median/stddev from --benchmark_repetitions) are skipped unless
+        # they are the median, which is the most stable figure to compare.
+        run_type = entry.get("run_type", "iteration")
+        if run_type == "aggregate":
+            if entry.get("aggregate_name") != "median":
+                continue
+            name = entry["run_name"]
+        else:
+            name = entry["name"]
+        if entry.get("error_occurred"):
+            continue
+        unit = scale_to_ns.get(entry.get("time_unit", "ns"), 1.0)
+        results[name] = float(entry[metric]) * unit
+    return results
+
+
+def format_ns(value):
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if value >= scale:
+            return f"{value / scale:.2f} {unit}"
+    return f"{value:.1f} ns"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Flag regressions between two Google Benchmark JSON files.")
+    parser.add_argument("baseline", help="JSON written by --benchmark_out on the reference build")
+    parser.add_argument("candidate", help="JSON written by --benchmark_out on the build under test")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="Slowdown in percent that counts as a regression (default: 5)")
+    parser.add_argument("--metric", choices=("cpu_time", "real_time"), default="cpu_time",
+                        help="Which time to compare (default: cpu_time)")
+    args = parser.parse_args()
+
+    baseline = load_results(args.baseline, args.metric)
+    candidate = load_results(args.candidate, args.metric)
+
+    common = [name for name in baseline if name in candidate]
+    if not common:
+        print("No benchmarks in common between the two files.", file=sys.stderr)
+        return 2
+
+    width = max(len(name) for name in common)
+    print(f"{'Benchmark':<{width}}  {'Baseline':>12}  {'Candidate':>12}  {'Change':>8}")
+    regressions = []
+    for name in common:
+        old, new = baseline[name], candidate[name]
+        change = (new - old) / old * 100.0 if old > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions.append(name)
+        elif change < -args.threshold:
+            flag = "  improved"
+        print(f"{name:<{width}}  {format_ns(old):>12}  {format_ns(new):>12}  {change:>+7.1f}%{flag}")
+
+    for name in sorted(set(baseline) - set(candidate)):
+        print(f"{name:<{width}}  missing from candidate")
+    for name in sorted(set(candidate) - set(baseline)):
+        print(f"{name:<{width}}  new in candidate")
+
+    if regressions:
+        print(f"\n{len(regressions)} benchmark(s) regressed by more than {args.threshold:g}%.")
+        return 1
+    print(f"\nNo regressions above {args.threshold:g}%.")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -8,6 +8,7 @@
 #include <chrono>
 
 #include "managers/audio_manager.h"
+#include "realtime_checker.h"
 
 using namespace screamrouter::audio;
 using namespace std::chrono;
@@ -294,3 +295,27 @@ TEST_F(FullAudioGraphTest, DelayUpdate) {
     
     EXPECT_TRUE(manager->remove_source(src));
 }
+
+// ============================================================================
+// Real-Time Safety
+// ============================================================================
+
+TEST_F(FullAudioGraphTest, SteadyStateMixingIsRealtimeSafe) {
+    ASSERT_TRUE(screamrouter::audio::testing::rt_checker_active());
+    ASSERT_TRUE(manager->initialize(0, 10));
+    ASSERT_TRUE(manager->add_sink(make_scream_sink("rt-sink")));
+
+    std::string src = manager->configure_source(make_source("rt-source"));
+    ASSERT_FALSE(src.empty());
+    EXPECT_TRUE(manager->connect_source_sink(src, "rt-sink"));
+
+    // Let the mixer settle, then watch it run undisturbed.
+    std::this_thread::sleep_for(milliseconds(300));
+    screamrouter::audio::testing::rt_reset_violations();
+    std::this_thread::sleep_for(milliseconds(500));
+    EXPECT_NO_RT_VIOLATIONS();
+
+    EXPECT_TRUE(manager->disconnect_source_sink(src, "rt-sink"));
+    EXPECT_TRUE(manager->remove_source(src));
+    EXPECT_TRUE(manager->remove_sink("rt-sink"));
+}
@@ -1,11 +1,13 @@
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <chrono>
+#include <atomic>
 #include <functional>
 #include <thread>
 #include <vector>
 
 #include "managers/audio_manager.h"
+#include "managers/sink_manager.h"
 #include "configuration/audio_engine_config_applier.h"
 #include "configuration/audio_engine_config_types.h"
 #include "audio_types.h"
@@ -93,6 +95,24 @@ protected:
                            });
     }
 
+    size_t SourceInstanceCount(const std::string& source_tag) const {
+        const auto stats = manager_->get_audio_engine_stats();
+        return static_cast<size_t>(std::count_if(stats.source_stats.begin(), stats.source_stats.end(),
+                                                 [&](const screamrouter::audio::SourceStats& entry) {
+                                                     return entry.source_tag == source_tag;
+                                                 }));
+    }
+
+    std::string GroupLeaderOf(const std::string& sink_id) const {
+        const auto stats = manager_->get_audio_engine_stats();
+        for (const auto& entry : stats.sink_stats) {
+            if (entry.sink_id == sink_id) {
+                return entry.mix_group_leader;
+            }
+        }
+        return "<missing>";
+    }
+
     std::shared_ptr<AudioManager> manager_;
     std::unique_ptr<screamrouter::config::AudioEngineConfigApplier> applier_;
 };
@@ -125,6 +145,75 @@ TEST_F(AudioEngineConfigApplierTest, ApplyStateRemovesSinkAndSourcePath) {
         << "sink stats still reported " << sink_id << " after removal";
 }
 
+TEST_F(AudioEngineConfigApplierTest, IdenticalPathsToDifferentSinksAreDeduplicated) {
+    const std::string source_tag = "shared-source";
+    DesiredEngineState desired;
+    for (const std::string sink_id : {"shared-sink-a", "shared-sink-b", "shared-sink-c"}) {
+        AppliedSinkParams sink = MakeSinkParams(sink_id);
+        sink.connected_source_path_ids = {sink_id + "-path"};
+        desired.sinks.push_back(sink);
+        desired.source_paths.push_back(MakeSourcePath(sink_id + "-path", sink_id, source_tag));
+    }
+    ASSERT_TRUE(applier_->apply_state(desired));
+    // Source stats are refreshed once a second.
+    EXPECT_TRUE(WaitForCondition([&]() { return SourceInstanceCount(source_tag) == 1u; }));
+
+    // Diverging one path moves it onto its own processor; the others stay deduplicated.
+    desired.source_paths[1].volume = 0.5f;
+    ASSERT_TRUE(applier_->apply_state(desired));
+    EXPECT_TRUE(WaitForCondition([&]() { return SourceInstanceCount(source_tag) == 2u; }));
+
+    // Removing the sink that drives the deduplicated processor leaves it running for the other sink.
+    desired.sinks.erase(desired.sinks.begin());
+    desired.source_paths.erase(desired.source_paths.begin());
+    ASSERT_TRUE(applier_->apply_state(desired));
+    ASSERT_TRUE(WaitForCondition([&]() { return !SinkExists("shared-sink-a"); }));
+    EXPECT_EQ(SourceInstanceCount(source_tag), 2u);
+
+    DesiredEngineState empty_state;
+    ASSERT_TRUE(applier_->apply_state(empty_state));
+    EXPECT_TRUE(WaitForCondition([&]() { return SourceInstanceCount(source_tag) == 0u; }));
+}
+
+TEST_F(AudioEngineConfigApplierTest, SinksWithIdenticalInputsShareOneMixer) {
+    const std::string source_tag = "group-source";
+    DesiredEngineState desired;
+    int port = 15100;
+    for (const std::string sink_id : {"group-sink-a", "group-sink-b", "group-sink-c"}) {
+        AppliedSinkParams sink = MakeSinkParams(sink_id);
+        sink.sink_engine_config.output_port = port++;
+        sink.connected_source_path_ids = {sink_id + "-path"};
+        desired.sinks.push_back(sink);
+        desired.source_paths.push_back(MakeSourcePath(sink_id + "-path", sink_id, source_tag));
+    }
+    ASSERT_TRUE(applier_->apply_state(desired));
+    EXPECT_TRUE(WaitForCondition([&]() {
+        return GroupLeaderOf("group-sink-a").empty() &&
+               GroupLeaderOf("group-sink-b") == "group-sink-a" &&
+               GroupLeaderOf("group-sink-c") == "group-sink-a";
+    })) << "sinks b and c were not grouped under sink a";
+
+    // A diverging input set takes the sink out of the group.
+    desired.source_paths[2].volume = 0.5f;
+    ASSERT_TRUE(applier_->apply_state(desired));
+    EXPECT_TRUE(WaitForCondition([&]() {
+        return GroupLeaderOf("group-sink-b") == "group-sink-a" &&
+               GroupLeaderOf("group-sink-c").empty();
+    })) << "sink c still grouped after its input diverged";
+
+    // Removing the leader leaves the former member running on its own mixer.
+    desired.sinks.erase(desired.sinks.begin());
+    desired.source_paths.erase(desired.source_paths.begin());
+    ASSERT_TRUE(applier_->apply_state(desired));
+    EXPECT_TRUE(WaitForCondition([&]() {
+        return !SinkExists("group-sink-a") && GroupLeaderOf("group-sink-b").empty();
+    })) << "sink b was not restored after its leader was removed";
+
+    DesiredEngineState empty_state;
+    ASSERT_TRUE(applier_->apply_state(empty_state));
+    EXPECT_TRUE(WaitForCondition([&]() { return !SinkExists("group-sink-b") && !SinkExists("group-sink-c"); }));
+}
+
 TEST_F(AudioEngineConfigApplierTest, ApplyStateRapidFirePropertyCombinations) {
     const std::vector<int> sample_rates = {44100, 48000};
     const std::vector<int> bit_depths = {16, 24};
@@ -218,4 +307,112 @@ TEST_F(AudioEngineConfigApplierTest, ApplyStateRapidFirePropertyCombinations) {
     }
 }
 
+class CountingListener : public screamrouter::audio::INetworkSender {
+public:
+    explicit CountingListener(std::atomic<int>& closes) : closes_(closes) {}
+    bool setup() override { return true; }
+    void close() override { closes_.fetch_add(1); }
+    void send_payload(const uint8_t*, size_t, const std::vector<uint32_t>&) override {}
+
+private:
+    std::atomic<int>& closes_;
+};
+
+screamrouter::audio::SinkAudioMixer* FindMixer(screamrouter::audio::SinkManager& sinks, const std::string& sink_id) {
+    for (auto* mixer : sinks.get_all_mixers()) {
+        if (mixer->get_config().sink_id == sink_id) {
+            return mixer;
+        }
+    }
+    return nullptr;
+}
+
+TEST(SinkManagerListenerTest, ListenerFollowsSinkOutOfMixGroup) {
+    std::recursive_mutex manager_mutex;
+    screamrouter::audio::SinkManager sinks(manager_mutex,
+                                           std::make_shared<screamrouter::audio::AudioEngineSettings>(),
+                                           nullptr);
+    screamrouter::audio::SinkConfig leader;
+    leader.id = "listener-leader";
+    leader.output_ip = "127.0.0.1";
+    leader.output_port = 15200;
+    leader.protocol = "scream";
+    screamrouter::audio::SinkConfig member = leader;
+    member.id = "listener-member";
+    member.output_port = 15201;
+
+    ASSERT_TRUE(sinks.add_sink(leader, true));
+    ASSERT_TRUE(sinks.add_sink_to_group("listener-leader", member));
+
+    std::atomic<int> closes{0};
+    sinks.add_listener_to_sink("listener-member", "peer", std::make_unique<CountingListener>(closes));
+    ASSERT_NE(sinks.get_listener_from_sink("listener-member", "peer"), nullptr);
+    EXPECT_TRUE(sinks.sink_has_listeners("listener-member"));
+    EXPECT_FALSE(sinks.sink_has_listeners("listener-leader"));
+    EXPECT_EQ(sinks.get_listener_owner("listener-leader", "peer"), "listener-member");
+
+    // Restore the member the way the config applier does: leave the group, then get its own mixer.
+    ASSERT_TRUE(sinks.remove_sink_from_group("listener-member"));
+    ASSERT_TRUE(sinks.add_sink(member, true));
+    EXPECT_EQ(FindMixer(sinks, "listener-leader")->get_listener("peer"), nullptr);
+    EXPECT_NE(FindMixer(sinks, "listener-member")->get_listener("peer"), nullptr);
+    EXPECT_EQ(closes.load(), 0) << "moving the listener must not close it";
+
+    sinks.remove_listener_from_sink("listener-member", "peer");
+    EXPECT_EQ(sinks.get_listener_from_sink("listener-member", "peer"), nullptr);
+    EXPECT_FALSE(sinks.sink_has_listeners("listener-member"));
+    EXPECT_EQ(closes.load(), 1);
+
+    sinks.stop_all();
+    EXPECT_EQ(closes.load(), 1);
+}
+
+
+TEST_F(AudioEngineConfigApplierTest, PathVolumeUpdateKeepsSinkGroupAndMixer) {
+    const std::string source_tag = "volume-group-source";
+    DesiredEngineState desired;
+    int port = 15300;
+    for (const std::string sink_id : {"volume-sink-a", "volume-sink-b"}) {
+        AppliedSinkParams sink = MakeSinkParams(sink_id);
+        sink.sink_engine_config.output_port = port++;
+        sink.connected_source_path_ids = {sink_id + "-path"};
+        desired.sinks.push_back(sink);
+        desired.source_paths.push_back(MakeSourcePath(sink_id + "-path", sink_id, source_tag));
+    }
+    ASSERT_TRUE(applier_->apply_state(desired));
+    auto* sinks = manager_->sink_manager_for_testing();
+    ASSERT_EQ(sinks->get_group_leader("volume-sink-b"), "volume-sink-a");
+    auto* leader_mixer = FindMixer(*sinks, "volume-sink-a");
+    ASSERT_NE(leader_mixer, nullptr);
+    ASSERT_EQ(FindMixer(*sinks, "volume-sink-b"), nullptr);
+
+    // The member's listener rides on the leader's mixer. Restoring the member would move it to
+    // a mixer of its own, and a sink with listeners is never grouped again.
+    std::atomic<int> closes{0};
+    sinks->add_listener_to_sink("volume-sink-b", "peer", std::make_unique<CountingListener>(closes));
+    ASSERT_NE(leader_mixer->get_listener("peer"), nullptr);
+
+    // The same volume on every path is applied in place to the one deduplicated instance.
+    for (auto& path : desired.source_paths) {
+        path.volume = 0.5f;
+    }
+    ASSERT_TRUE(applier_->apply_state(desired));
+    EXPECT_EQ(sinks->get_group_leader("volume-sink-b"), "volume-sink-a");
+    EXPECT_EQ(FindMixer(*sinks, "volume-sink-a"), leader_mixer);
+    EXPECT_EQ(FindMixer(*sinks, "volume-sink-b"), nullptr);
+    EXPECT_NE(leader_mixer->get_listener("peer"), nullptr);
+    EXPECT_EQ(closes.load(), 0);
+
+    // A volume on one path only still splits the group.
+    desired.source_paths[1].volume = 0.25f;
+    ASSERT_TRUE(applier_->apply_state(desired));
+    EXPECT_TRUE(sinks->get_group_leader("volume-sink-b").empty());
+    EXPECT_NE(FindMixer(*sinks, "volume-sink-b"), nullptr);
+    EXPECT_TRUE(WaitForCondition([&]() { return SourceInstanceCount(source_tag) == 2u; }));
+
+    sinks->remove_listener_from_sink("volume-sink-b", "peer");
+    DesiredEngineState empty_state;
+    ASSERT_TRUE(applier_->apply_state(empty_state));
+}
+
 }  // namespace
@@ -0,0 +1,116 @@
+/**
+ * Offline Renderer Integration Tests
+ * Renders small graphs through TimeshiftManager → SourceInputProcessor under a virtual clock
+ * and checks that the output is deterministic and produced faster than real time.
+ */
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+
+#include "offline/offline_renderer.h"
+#include "audio_types.h"
+
+// Sentinel logging stub
+namespace screamrouter::audio::utils {
+    void log_sentinel(const char*, const screamrouter::audio::TaggedAudioPacket&, const std::string&) {}
+    void log_sentinel(const char*, const screamrouter::audio::ProcessedAudioChunk&, const std::string&) {}
+}
+
+using namespace screamrouter::audio;
+using namespace screamrouter::audio::offline;
+
+namespace {
+
+OfflineRenderConfig make_two_source_config(double duration_sec) {
+    OfflineRenderConfig config;
+    config.duration_sec = duration_sec;
+
+    OfflineSourceConfig sine;
+    sine.tag = "sine";
+    sine.frequency_hz = 1000.0;
+    config.sources.push_back(sine);
+
+    OfflineSourceConfig noise;
+    noise.tag = "noise";
+    noise.generator = GeneratorType::NOISE;
+    noise.amplitude = 0.1;
+    noise.sample_rate = 44100;
+    noise.seed = 7;
+    noise.jitter_ms = 2.0;
+    config.sources.push_back(noise);
+
+    OfflineSinkConfig sink;
+    sink.id = "out";
+    config.sinks.push_back(sink);
+
+    config.connections.push_back({"sine", "out", 0.5f, {}, 0});
+    config.connections.push_back({"noise", "out", 1.0f, {}, 0});
+    return config;
+}
+
+} // namespace
+
+TEST(OfflineRendererTest, RejectsUnknownConnectionEndpoints) {
+    OfflineRenderConfig config = make_two_source_config(1.0);
+    config.connections.push_back({"missing", "out", 1.0f, {}, 0});
+    EXPECT_THROW(OfflineRenderer{config}, std::invalid_argument);
+}
+
+TEST(OfflineRendererTest, RejectsUnsupportedFormats) {
+    OfflineRenderConfig config = make_two_source_config(1.0);
+    config.sinks[0].bit_depth = 12;
+    EXPECT_THROW(OfflineRenderer{config}, std::invalid_argument);
+}
+
+TEST(OfflineRendererTest, RendersRequestedDurationFasterThanRealTime) {
+    OfflineRenderer renderer(make_two_source_config(5.0));
+    OfflineRenderResult result = renderer.render();
+
+    ASSERT_EQ(result.sinks.size(), 1u);
+    const auto& sink = result.sinks[0];
+    EXPECT_NEAR(static_cast<double>(sink.frames_rendered), 5.0 * 48000, 2.0 * 1152);
+    EXPECT_GT(result.speed_factor, 1.0);
+    EXPECT_DOUBLE_EQ(result.media_seconds, 5.0);
+}
+
+TEST(OfflineRendererTest, RepeatedRendersAreBitIdentical) {
+    OfflineRenderResult first = OfflineRenderer(make_two_source_config(3.0)).render();
+    OfflineRenderResult second = OfflineRenderer(make_two_source_config(3.0)).render();
+
+    ASSERT_EQ(first.sinks.size(), second.sinks.size());
+    EXPECT_EQ(first.sinks[0].frames_rendered, second.sinks[0].frames_rendered);
+    EXPECT_EQ(first.sinks[0].checksum, second.sinks[0].checksum);
+    EXPECT_EQ(first.sinks[0].input_underruns, second.sinks[0].input_underruns);
+}
+
+TEST(OfflineRendererTest, DifferentSignalChangesChecksum) {
+    OfflineRenderConfig config = make_two_source_config(2.0);
+    OfflineRenderResult base = OfflineRenderer(config).render();
+    config.sources[0].frequency_hz = 997.0;
+    OfflineRenderResult changed = OfflineRenderer(config).render();
+    EXPECT_NE(base.sinks[0].checksum, changed.sinks[0].checksum);
+}
+
+TEST(OfflineRendererTest, DriftingSourceStillProducesOutput) {
+    OfflineRenderConfig config = make_two_source_config(10.0);
+    config.sources[0].clock_drift_ppm = -300.0;
+    config.sources[1].clock_drift_ppm = 300.0;
+    OfflineRenderResult result = OfflineRenderer(config).render();
+    ASSERT_EQ(result.sinks.size(), 1u);
+    EXPECT_GT(result.sinks[0].frames_rendered, 9u * 48000u);
+}
+
+TEST(OfflineRendererTest, WritesWavOutput) {
+    std::string path = ::testing::TempDir() + "offline_renderer_out.wav";
+    OfflineRenderConfig config = make_two_source_config(1.0);
+    config.sinks[0].output_wav = path;
+    OfflineRenderResult result = OfflineRenderer(config).render();
+
+    FILE* fp = std::fopen(path.c_str(), "rb");
+    ASSERT_NE(fp, nullptr);
+    std::fseek(fp, 0, SEEK_END);
+    long size = std::ftell(fp);
+    std::fclose(fp);
+    std::remove(path.c_str());
+    EXPECT_EQ(static_cast<uint64_t>(size), 44 + result.sinks[0].frames_rendered * 2 * 2);
+}
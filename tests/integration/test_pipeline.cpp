@@ -7,20 +7,21 @@
 #include <memory>
 #include <thread>
 #include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
 #include <vector>
 
 #include "input_processor/timeshift_manager.h"
 #include "input_processor/source_input_processor.h"
 #include "configuration/audio_engine_settings.h"
 #include "audio_types.h"
-
-// Mock logging
-namespace screamrouter::audio::logging {
-    enum class LogLevel { DEBUG, INFO, WARNING, ERR };
-    std::atomic<LogLevel> current_log_level{LogLevel::INFO};
-    void log_message(LogLevel, const char*, int, const char*, ...) {}
-    const char* get_base_filename(const char* path) { return path; }
-}
+#include "utils/audio_clock.h"
+#include "utils/span_tracer.h"
+#include "receivers/network_audio_receiver.h"
+#include "receivers/scream/raw_scream_receiver.h"
 
 // Sentinel logging stub
 namespace screamrouter::audio::utils {
@@ -217,3 +218,303 @@ TEST_F(PipelineIntegrationTest, GetStatsDuringActiveProcessing) {
     timeshift_manager->unregister_processor("stats-proc", "192.168.1.200");
     timeshift_manager->stop();
 }
+
+// ============================================================================
+// Timeshift Export Tests
+// ============================================================================
+
+// A manager that has not been started files packets synchronously, so exports see them at once.
+TEST_F(PipelineIntegrationTest, ExportRangeSelectsPacketsInsideWindow) {
+    timeshift_manager = std::make_unique<TimeshiftManager>(seconds(10), settings);
+
+    // One packet per second of age, 9 s .. 1 s old; each packet's samples carry its age.
+    const auto now = steady_clock::now();
+    for (int age = 9; age >= 1; --age) {
+        auto pkt = make_test_packet("10.0.0.5", 48);
+        pkt.received_time = now - seconds(age);
+        pkt.rtp_timestamp = static_cast<uint32_t>((9 - age) * 48000);
+        std::fill(pkt.audio_data.begin(), pkt.audio_data.end(), static_cast<uint8_t>(age));
+        timeshift_manager->add_packet(std::move(pkt));
+    }
+    auto other = make_test_packet("10.0.0.6", 48);
+    other.received_time = now - seconds(4);
+    other.rtp_timestamp = 0;
+    timeshift_manager->add_packet(std::move(other));
+
+    auto exported = timeshift_manager->export_buffer_range("10.0.0.5", milliseconds(5500), milliseconds(2500), false);
+    ASSERT_TRUE(exported.has_value());
+    EXPECT_FALSE(exported->float32);
+    EXPECT_EQ(exported->bit_depth, 16);
+    EXPECT_EQ(exported->chunk_size_bytes, 48u * 4u);
+    ASSERT_EQ(exported->pcm_data.size(), 3u * 48u * 4u);
+    EXPECT_EQ(exported->pcm_data.front(), 5);
+    EXPECT_EQ(exported->pcm_data[48 * 4], 4);
+    EXPECT_EQ(exported->pcm_data.back(), 3);
+    EXPECT_NEAR(exported->duration_seconds, 3.0 * 48.0 / 48000.0, 1e-9);
+
+    // An empty or inverted window has nothing to export.
+    EXPECT_FALSE(timeshift_manager->export_buffer_range("10.0.0.5", milliseconds(2000), milliseconds(2000), false));
+    EXPECT_FALSE(timeshift_manager->export_buffer_range("10.0.0.5", milliseconds(1000), milliseconds(3000), false));
+}
+
+TEST_F(PipelineIntegrationTest, ExportConvertsToFloat32) {
+    timeshift_manager = std::make_unique<TimeshiftManager>(seconds(10), settings);
+
+    auto pkt = make_test_packet("10.0.0.7", 4);
+    pkt.rtp_timestamp = 0;
+    const int16_t samples[] = {16384, -16384, 32767, -32768, 0, 8192, -8192, 1};
+    std::memcpy(pkt.audio_data.data(), samples, sizeof(samples));
+    timeshift_manager->add_packet(std::move(pkt));
+
+    auto exported = timeshift_manager->export_buffer_range("10.0.0.7", milliseconds(5000), milliseconds(0), true);
+    ASSERT_TRUE(exported.has_value());
+    EXPECT_TRUE(exported->float32);
+    EXPECT_EQ(exported->bit_depth, 32);
+    ASSERT_EQ(exported->pcm_data.size(), 8 * sizeof(float));
+    std::vector<float> values(8);
+    std::memcpy(values.data(), exported->pcm_data.data(), exported->pcm_data.size());
+    EXPECT_NEAR(values[0], 0.5f, 1e-6f);
+    EXPECT_NEAR(values[1], -0.5f, 1e-6f);
+    EXPECT_NEAR(values[3], -1.0f, 1e-6f);
+    EXPECT_FLOAT_EQ(values[4], 0.0f);
+    EXPECT_NEAR(values[5], 0.25f, 1e-6f);
+    // Duration still describes the source audio.
+    EXPECT_NEAR(exported->duration_seconds, 4.0 / 48000.0, 1e-12);
+}
+
+TEST_F(PipelineIntegrationTest, ExportSpanningSeveralSlicesKeepsPacketOrder) {
+    timeshift_manager = std::make_unique<TimeshiftManager>(seconds(10), settings);
+
+    // ~750 KB of payload: copied across several lock holds.
+    const auto now = steady_clock::now();
+    constexpr int kPackets = 400;
+    for (int i = 0; i < kPackets; ++i) {
+        auto pkt = make_test_packet("10.0.0.8", 480);
+        pkt.received_time = now - milliseconds(4000) + milliseconds(10 * i);
+        pkt.rtp_timestamp = static_cast<uint32_t>(i * 480);
+        std::fill(pkt.audio_data.begin(), pkt.audio_data.end(), static_cast<uint8_t>(i));
+        timeshift_manager->add_packet(std::move(pkt));
+    }
+
+    auto exported = timeshift_manager->export_buffer_range("10.0.0.8", milliseconds(5000), milliseconds(0), false);
+    ASSERT_TRUE(exported.has_value());
+    ASSERT_EQ(exported->pcm_data.size(), static_cast<size_t>(kPackets) * 480u * 4u);
+    for (int i = 0; i < kPackets; ++i) {
+        ASSERT_EQ(exported->pcm_data[static_cast<size_t>(i) * 480u * 4u], static_cast<uint8_t>(i)) << "packet " << i;
+    }
+}
+
+namespace {
+
+// Stamps a packet index into the first two payload bytes so exports can be checked for order.
+uint16_t packet_marker(const std::vector<uint8_t>& pcm, size_t packet_bytes, size_t index) {
+    uint16_t marker = 0;
+    std::memcpy(&marker, pcm.data() + index * packet_bytes, sizeof(marker));
+    return marker;
+}
+
+} // namespace
+
+TEST_F(PipelineIntegrationTest, ExportSkipsPacketsEvictedBetweenSlices) {
+    utils::VirtualClock clock;
+    utils::ScopedVirtualClock scoped_clock(clock);
+    timeshift_manager = std::make_unique<TimeshiftManager>(seconds(10), settings);
+
+    // 400 packets of 1920 bytes, 9.9 s .. 0.3 s old: the copy needs several slices.
+    constexpr size_t kPacketBytes = 480u * 4u;
+    constexpr uint16_t kPackets = 400;
+    const auto now = utils::AudioClock::now();
+    for (uint16_t i = 0; i < kPackets; ++i) {
+        auto pkt = make_test_packet("10.0.0.9", 480);
+        pkt.received_time = now - milliseconds(9900) + milliseconds(24 * i);
+        pkt.rtp_timestamp = static_cast<uint32_t>(i) * 480u;
+        std::memcpy(pkt.audio_data.data(), &i, sizeof(i));
+        timeshift_manager->add_packet(std::move(pkt));
+    }
+
+    int hook_calls = 0;
+    timeshift_manager->set_export_slice_hook([&]() {
+        // After the first slice that copied data, age the buffer by 5 s and let cleanup evict.
+        if (++hook_calls == 2) {
+            clock.advance(seconds(5));
+            timeshift_manager->run_once();
+        }
+    });
+
+    auto exported = timeshift_manager->export_buffer_range("10.0.0.9", milliseconds(10000), milliseconds(0), false);
+    ASSERT_TRUE(exported.has_value());
+    EXPECT_GE(hook_calls, 2);
+    ASSERT_EQ(exported->pcm_data.size() % kPacketBytes, 0u);
+    const size_t exported_packets = exported->pcm_data.size() / kPacketBytes;
+    ASSERT_GT(exported_packets, 0u);
+    EXPECT_LT(exported_packets, static_cast<size_t>(kPackets));
+
+    // What was copied before the eviction stays, the evicted run is skipped, and the rest follows in order.
+    EXPECT_EQ(packet_marker(exported->pcm_data, kPacketBytes, 0), 0u);
+    EXPECT_EQ(packet_marker(exported->pcm_data, kPacketBytes, exported_packets - 1), kPackets - 1);
+    bool skipped = false;
+    for (size_t i = 1; i < exported_packets; ++i) {
+        const uint16_t prev = packet_marker(exported->pcm_data, kPacketBytes, i - 1);
+        const uint16_t cur = packet_marker(exported->pcm_data, kPacketBytes, i);
+        ASSERT_GT(cur, prev) << "packet " << i;
+        skipped = skipped || cur != prev + 1;
+    }
+    EXPECT_TRUE(skipped);
+}
+
+TEST_F(PipelineIntegrationTest, ExportSliceBoundsPacketsVisited) {
+    timeshift_manager = std::make_unique<TimeshiftManager>(seconds(10), settings);
+
+    // Thousands of small packets from another source and none from the exported one until the
+    // end: slices must still end even though they copy no bytes.
+    const auto now = steady_clock::now();
+    constexpr int kOtherPackets = 5000;
+    for (int i = 0; i < kOtherPackets; ++i) {
+        auto pkt = make_test_packet("10.0.0.10", 4);
+        pkt.received_time = now - milliseconds(3000) + microseconds(500 * i);
+        pkt.rtp_timestamp = static_cast<uint32_t>(i * 4);
+        timeshift_manager->add_packet(std::move(pkt));
+    }
+    auto target = make_test_packet("10.0.0.11", 48);
+    target.received_time = now - milliseconds(100);
+    target.rtp_timestamp = 0;
+    std::fill(target.audio_data.begin(), target.audio_data.end(), static_cast<uint8_t>(7));
+    timeshift_manager->add_packet(std::move(target));
+
+    int hook_calls = 0;
+    timeshift_manager->set_export_slice_hook([&]() { ++hook_calls; });
+
+    auto exported = timeshift_manager->export_buffer_range("10.0.0.11", milliseconds(5000), milliseconds(0), false);
+    ASSERT_TRUE(exported.has_value());
+    EXPECT_GE(hook_calls, 2);
+    ASSERT_EQ(exported->pcm_data.size(), 48u * 4u);
+    EXPECT_EQ(exported->pcm_data.front(), 7);
+}
+
+TEST_F(PipelineIntegrationTest, ExportBurstBeyondEstimateKeepsEveryPacket) {
+    timeshift_manager = std::make_unique<TimeshiftManager>(seconds(10), settings);
+
+    // 2 s of audio received within 200 ms: far more than the window's rate-based estimate.
+    constexpr size_t kPacketBytes = 480u * 4u;
+    constexpr uint16_t kPackets = 200;
+    const auto now = steady_clock::now();
+    for (uint16_t i = 0; i < kPackets; ++i) {
+        auto pkt = make_test_packet("10.0.0.12", 480);
+        pkt.received_time = now - milliseconds(300) + milliseconds(i);
+        pkt.rtp_timestamp = static_cast<uint32_t>(i) * 480u;
+        std::memcpy(pkt.audio_data.data(), &i, sizeof(i));
+        timeshift_manager->add_packet(std::move(pkt));
+    }
+
+    auto exported = timeshift_manager->export_buffer_range("10.0.0.12", milliseconds(400), milliseconds(0), false);
+    ASSERT_TRUE(exported.has_value());
+    ASSERT_EQ(exported->pcm_data.size(), static_cast<size_t>(kPackets) * kPacketBytes);
+    for (uint16_t i = 0; i < kPackets; ++i) {
+        ASSERT_EQ(packet_marker(exported->pcm_data, kPacketBytes, i), i);
+    }
+}
+
+// ============================================================================
+// Trace flows
+// ============================================================================
+
+namespace {
+
+// Treats every datagram as raw 16-bit stereo PCM from one source.
+class PcmDatagramReceiver : public NetworkAudioReceiver {
+public:
+    explicit PcmDatagramReceiver(TimeshiftManager* timeshift_manager)
+        : NetworkAudioReceiver(0, std::make_shared<NotificationQueue>(), timeshift_manager, "[PcmDatagramReceiver]") {}
+
+    std::size_t chunk_bytes() const { return default_chunk_size_bytes_; }
+
+protected:
+    bool is_valid_packet_structure(const uint8_t*, int size, const struct sockaddr_in&) override {
+        return size > 0;
+    }
+
+    bool process_and_validate_payload(const uint8_t* buffer,
+                                      int size,
+                                      const struct sockaddr_in&,
+                                      steady_clock::time_point received_time,
+                                      TaggedAudioPacket& out_packet,
+                                      std::string& out_source_tag) override {
+        out_source_tag = "flow-source";
+        out_packet.source_tag = out_source_tag;
+        out_packet.channels = 2;
+        out_packet.sample_rate = 48000;
+        out_packet.bit_depth = 16;
+        out_packet.chlayout1 = 0x03;
+        out_packet.rtp_timestamp = 0;
+        out_packet.received_time = received_time;
+        out_packet.audio_data.assign(buffer, buffer + size);
+        return true;
+    }
+
+    size_t get_receive_buffer_size() const override { return 65536; }
+    int get_poll_timeout_ms() const override { return 10; }
+};
+
+} // namespace
+
+TEST_F(PipelineIntegrationTest, ReceiveSpanStartsTheFlowTimeshiftContinues) {
+    using screamrouter::audio::utils::SpanTracer;
+    timeshift_manager = std::make_unique<TimeshiftManager>(seconds(10), settings);
+    PcmDatagramReceiver receiver(timeshift_manager.get());
+
+    SpanTracer::instance().start();
+    const uint64_t expected_flow = SpanTracer::instance().next_flow_id() + 1;
+    const std::vector<uint8_t> datagram(receiver.chunk_bytes(), 0);
+    struct sockaddr_in from {};
+    from.sin_family = AF_INET;
+    receiver.inject_datagram(datagram.data(), static_cast<int>(datagram.size()), from, steady_clock::now());
+    SpanTracer::instance().stop();
+
+    const std::string path = ::testing::TempDir() + "pipeline_receive_flow.json";
+    ASSERT_TRUE(SpanTracer::instance().dump(path));
+    std::ifstream in(path);
+    std::stringstream json;
+    json << in.rdbuf();
+    std::remove(path.c_str());
+
+    // One flow id on both spans: started at "receive", finished at "timeshift_ingress".
+    const std::string trace = json.str();
+    EXPECT_NE(trace.find("\"name\":\"receive\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"timeshift_ingress\""), std::string::npos);
+    const std::string id_field = "\"id\":" + std::to_string(expected_flow) + ",";
+    const size_t first = trace.find(id_field);
+    ASSERT_NE(first, std::string::npos);
+    EXPECT_NE(trace.find(id_field, first + 1), std::string::npos);
+}
+
+TEST_F(PipelineIntegrationTest, RawScreamChunksAreNumberedByFrame) {
+    timeshift_manager = std::make_unique<TimeshiftManager>(seconds(10), settings);
+    std::vector<TaggedAudioPacket> ingress;
+    timeshift_manager->set_ingress_hook([&ingress](const TaggedAudioPacket& packet) {
+        ingress.push_back(packet);
+    });
+    RawScreamReceiverConfig config;
+    config.listen_port = 0;
+    RawScreamReceiver receiver(config, std::make_shared<NotificationQueue>(), timeshift_manager.get(), "[RawScreamTest]");
+
+    // Scream headers carry no timestamp: 48 kHz, 16-bit stereo, then 1152 bytes of PCM.
+    std::vector<uint8_t> datagram(5 + 1152, 0);
+    datagram[0] = 1;
+    datagram[1] = 16;
+    datagram[2] = 2;
+    datagram[3] = 0x03;
+    struct sockaddr_in from {};
+    from.sin_family = AF_INET;
+    from.sin_addr.s_addr = htonl(0x0A000007);  // 10.0.0.7
+    for (int i = 0; i < 16; ++i) {
+        receiver.inject_datagram(datagram.data(), static_cast<int>(datagram.size()), from, steady_clock::now());
+    }
+
+    ASSERT_GE(ingress.size(), 2u);
+    const uint32_t chunk_frames = static_cast<uint32_t>(ingress[0].audio_data.size() / 4);
+    for (size_t i = 0; i < ingress.size(); ++i) {
+        EXPECT_EQ(ingress[i].source_tag, "10.0.0.7");
+        ASSERT_TRUE(ingress[i].rtp_timestamp.has_value()) << "chunk " << i;
+        EXPECT_EQ(*ingress[i].rtp_timestamp, static_cast<uint32_t>(i) * chunk_frames) << "chunk " << i;
+    }
+}
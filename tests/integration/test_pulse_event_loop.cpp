@@ -0,0 +1,497 @@
+/**
+ * @file test_pulse_event_loop.cpp
+ * @brief Drives PulseAudioReceiver over its UNIX socket with hand-built native-protocol frames.
+ * @details Covers the shared epoll event loop: many clients must not cost a thread each,
+ *          closed clients must free their slot, and chunk pacing from the loop's timerfd must
+ *          track the stream's real-time byte rate. Also covers memblocks from a client's memfd
+ *          pool, which is always mapped and guarded by a MemTrap against the client truncating it.
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "receivers/clock_manager.h"
+#include "receivers/pulse/pulse_memtrap.h"
+#include "receivers/pulse/pulse_message.h"
+#include "receivers/pulse/pulse_protocol.h"
+#include "receivers/pulse/pulse_receiver.h"
+#include "receivers/pulse/pulse_tagstruct.h"
+
+using namespace screamrouter::audio;
+using namespace screamrouter::audio::pulse;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr uint32_t kClientVersion = 13;
+constexpr uint32_t kMemfdClientVersion = 35;
+constexpr uint32_t kAuthTag = 1;
+constexpr uint32_t kCreateTag = 2;
+constexpr uint32_t kRegisterTag = 3;
+constexpr uint32_t kInvalid = 0xFFFFFFFFu;
+constexpr uint32_t kShmDataFlags = 0x80000000u | 0x20000000u; // SHMDATA | MEMFD_BLOCK
+constexpr uint32_t kShmReleaseFlags = 0x40000000u;
+
+int thread_count() {
+    int count = 0;
+    if (DIR* dir = ::opendir("/proc/self/task")) {
+        while (dirent* entry = ::readdir(dir)) {
+            if (entry->d_name[0] != '.') {
+                ++count;
+            }
+        }
+        ::closedir(dir);
+    }
+    return count;
+}
+
+// Minimal native-protocol client: enough to authenticate, open a playback stream and answer
+// REQUESTs with silence.
+class TestClient {
+public:
+    explicit TestClient(const std::string& socket_path) {
+        fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", socket_path.c_str());
+        connected_ = ::connect(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+    }
+    ~TestClient() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    bool connected() const { return connected_; }
+    int fd() const { return fd_; }
+
+    void send_auth(uint32_t version_word = kClientVersion) {
+        version_ = version_word & kProtocolVersionMask;
+        TagWriter writer;
+        writer.put_command(Command::Auth, kAuthTag);
+        writer.put_u32(version_word);
+        std::vector<uint8_t> cookie(256, 0);
+        writer.put_arbitrary(cookie.data(), cookie.size());
+        send_command(writer);
+    }
+
+    void send_create_playback_stream(uint8_t format = 3 /* PA_SAMPLE_S16LE */) {
+        TagWriter writer;
+        writer.put_command(Command::CreatePlaybackStream, kCreateTag);
+        SampleSpec spec;
+        spec.format = format;
+        spec.channels = 2;
+        spec.rate = 48000;
+        writer.put_sample_spec(spec);
+        ChannelMap map;
+        map.channels = 2;
+        map.map = {1, 2};
+        writer.put_channel_map(map);
+        writer.put_u32(kInvalid);            // sink index
+        writer.put_nullable_string(nullptr); // sink name
+        writer.put_u32(kInvalid);            // maxlength
+        writer.put_bool(false);              // corked
+        writer.put_u32(kInvalid);            // tlength
+        writer.put_u32(kInvalid);            // prebuf
+        writer.put_u32(kInvalid);            // minreq
+        writer.put_u32(0);                   // sync id
+        CVolume volume;
+        volume.channels = 2;
+        volume.values = {0x10000u, 0x10000u};
+        writer.put_cvolume(volume);
+        for (int i = 0; i < 7; ++i) {
+            writer.put_bool(false); // no_remap .. variable_rate
+        }
+        writer.put_bool(false); // muted
+        writer.put_bool(false); // adjust_latency
+        Proplist props;
+        props["application.name"] = "pulse-event-loop-test";
+        writer.put_proplist(props);
+        if (version_ >= 21) {
+            for (int i = 0; i < 7; ++i) {
+                writer.put_bool(false); // volume_set .. passthrough
+            }
+            writer.put_u8(0); // no format list
+        }
+        send_command(writer);
+    }
+
+    void send_register_memfd(uint32_t shm_id, int memfd) {
+        TagWriter writer;
+        writer.put_command(Command::RegisterMemfdShmid, kRegisterTag);
+        writer.put_u32(shm_id);
+        Message message;
+        message.descriptor.length = static_cast<uint32_t>(writer.buffer().size());
+        message.payload = writer.buffer();
+        const auto frame = EncodeMessage(message);
+
+        iovec iov{const_cast<uint8_t*>(frame.data()), frame.size()};
+        char control[CMSG_SPACE(sizeof(int))]{};
+        msghdr msg{};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        std::memcpy(CMSG_DATA(cmsg), &memfd, sizeof(int));
+        ASSERT_EQ(::sendmsg(fd_, &msg, MSG_NOSIGNAL), static_cast<ssize_t>(frame.size()));
+    }
+
+    void send_memblock(uint32_t stream_index, uint32_t block_id, uint32_t shm_id, uint32_t offset, uint32_t length) {
+        const uint32_t info[4] = {htonl(block_id), htonl(shm_id), htonl(offset), htonl(length)};
+        Message message;
+        message.descriptor.channel = stream_index;
+        message.descriptor.flags = kShmDataFlags;
+        message.payload.assign(reinterpret_cast<const uint8_t*>(info), reinterpret_cast<const uint8_t*>(info) + sizeof(info));
+        message.descriptor.length = static_cast<uint32_t>(message.payload.size());
+        send_frame(EncodeMessage(message));
+    }
+
+    void send_silence(uint32_t stream_index, uint32_t bytes) {
+        Message message;
+        message.descriptor.channel = stream_index;
+        message.descriptor.length = bytes;
+        message.payload.assign(bytes, 0);
+        send_frame(EncodeMessage(message));
+    }
+
+    /// Reads whatever is available and decodes complete frames into messages.
+    bool receive(std::vector<Message>& out, int timeout_ms) {
+        pollfd pfd{fd_, POLLIN, 0};
+        if (::poll(&pfd, 1, timeout_ms) <= 0) {
+            return false;
+        }
+        uint8_t buffer[65536];
+        const ssize_t n = ::recv(fd_, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            return false;
+        }
+        pending_.insert(pending_.end(), buffer, buffer + n);
+        Message message;
+        while (std::size_t used = DecodeMessage(pending_.data(), pending_.size(), message)) {
+            pending_.erase(pending_.begin(), pending_.begin() + static_cast<long>(used));
+            out.push_back(std::move(message));
+            message = Message{};
+        }
+        return true;
+    }
+
+private:
+    void send_command(const TagWriter& writer) {
+        Message message;
+        message.descriptor.length = static_cast<uint32_t>(writer.buffer().size());
+        message.payload = writer.buffer();
+        send_frame(EncodeMessage(message));
+    }
+
+    void send_frame(const std::vector<uint8_t>& frame) {
+        ASSERT_EQ(::send(fd_, frame.data(), frame.size(), MSG_NOSIGNAL), static_cast<ssize_t>(frame.size()));
+    }
+
+    int fd_ = -1;
+    bool connected_ = false;
+    uint32_t version_ = kClientVersion;
+    std::vector<uint8_t> pending_;
+};
+
+bool wait_for_reply(TestClient& client, uint32_t tag) {
+    const auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (std::chrono::steady_clock::now() < deadline) {
+        std::vector<Message> messages;
+        client.receive(messages, 50);
+        for (const auto& message : messages) {
+            TagReader reader(message.payload.data(), message.payload.size());
+            auto command = reader.read_u32();
+            auto reply_tag = reader.read_u32();
+            if (command && reply_tag && *command == static_cast<uint32_t>(Command::Reply) && *reply_tag == tag) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+struct Memblock {
+    uint32_t block_id;
+    uint32_t offset;
+    uint32_t length;
+};
+
+// Creates a float32 stream on an authorized memfd client, sends @p blocks from pool @p shm_id
+// once the stream exists and returns the block ids the server released, in order.
+// @p on_stream_ready runs just before the blocks go out, after the server has handled everything sent so far.
+std::vector<uint32_t> play_memblocks(TestClient& client, uint32_t shm_id, const std::vector<Memblock>& blocks,
+                                     std::size_t expected_releases,
+                                     const std::function<void()>& on_stream_ready = {}) {
+    client.send_create_playback_stream(5 /* PA_SAMPLE_FLOAT32LE */);
+
+    uint32_t stream_index = kInvalid;
+    std::vector<uint32_t> released;
+    bool blocks_sent = false;
+    const auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (released.size() < expected_releases && std::chrono::steady_clock::now() < deadline) {
+        std::vector<Message> messages;
+        client.receive(messages, 20);
+        for (const auto& message : messages) {
+            if (message.descriptor.flags == kShmReleaseFlags) {
+                released.push_back(message.descriptor.offset_hi);
+                continue;
+            }
+            TagReader reader(message.payload.data(), message.payload.size());
+            auto command = reader.read_u32();
+            auto tag = reader.read_u32();
+            if (command && tag && *command == static_cast<uint32_t>(Command::Reply) && *tag == kCreateTag) {
+                stream_index = reader.read_u32().value_or(kInvalid);
+            }
+        }
+        if (stream_index != kInvalid && !blocks_sent) {
+            if (on_stream_ready) {
+                on_stream_ready();
+            }
+            for (const auto& block : blocks) {
+                client.send_memblock(stream_index, block.block_id, shm_id, block.offset, block.length);
+            }
+            blocks_sent = true;
+        }
+    }
+    return released;
+}
+
+// A client mempool of @p bytes filled with a float pattern, optionally sealed against shrinking.
+int make_pool(std::size_t bytes, bool seal_shrink) {
+    const int memfd = static_cast<int>(::syscall(SYS_memfd_create, "pulse-test-pool", seal_shrink ? MFD_ALLOW_SEALING : 0));
+    if (memfd < 0 || ::ftruncate(memfd, static_cast<off_t>(bytes)) != 0) {
+        return -1;
+    }
+    void* mapped = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+    if (mapped == MAP_FAILED) {
+        ::close(memfd);
+        return -1;
+    }
+    auto* samples = static_cast<float*>(mapped);
+    for (std::size_t i = 0; i < 8192; ++i) {
+        samples[i] = (i % 2) ? -0.25f : 0.5f;
+    }
+    ::munmap(mapped, bytes);
+    if (seal_shrink && ::fcntl(memfd, F_ADD_SEALS, F_SEAL_SHRINK) != 0) {
+        ::close(memfd);
+        return -1;
+    }
+    return memfd;
+}
+
+} // namespace
+
+class PulseEventLoopTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char dir_template[] = "/tmp/sr_pulse_XXXXXX";
+        ASSERT_NE(::mkdtemp(dir_template), nullptr);
+        dir_ = dir_template;
+        socket_path_ = dir_ + "/native";
+
+        PulseReceiverConfig config;
+        config.unix_socket_path = dir_;
+        config.event_loop_threads = 1;
+        config.enable_srbchannel = false;
+        receiver_ = std::make_unique<PulseAudioReceiver>(config, nullptr, nullptr, &clock_manager_, "PulseEventLoopTest");
+        receiver_->start();
+        ASSERT_TRUE(receiver_->is_running());
+    }
+
+    void TearDown() override {
+        if (receiver_) {
+            receiver_->stop();
+        }
+        ::unlink((dir_ + "/pid").c_str());
+        ::rmdir(dir_.c_str());
+    }
+
+    ClockManager clock_manager_;
+    std::unique_ptr<PulseAudioReceiver> receiver_;
+    std::string dir_;
+    std::string socket_path_;
+};
+
+TEST_F(PulseEventLoopTest, ManyClientsShareOneLoopThread) {
+    const int threads_before = thread_count();
+
+    std::vector<std::unique_ptr<TestClient>> clients;
+    for (int i = 0; i < 32; ++i) {
+        clients.push_back(std::make_unique<TestClient>(socket_path_));
+        ASSERT_TRUE(clients.back()->connected());
+        clients.back()->send_auth();
+    }
+    for (auto& client : clients) {
+        EXPECT_TRUE(wait_for_reply(*client, kAuthTag));
+    }
+
+    EXPECT_EQ(thread_count(), threads_before);
+}
+
+TEST_F(PulseEventLoopTest, ClosedClientsReleaseTheirSlots) {
+    // Two full rounds at the connection limit: the second only fits if the first was reaped.
+    for (int round = 0; round < 2; ++round) {
+        std::vector<std::unique_ptr<TestClient>> clients;
+        for (int i = 0; i < 64; ++i) {
+            clients.push_back(std::make_unique<TestClient>(socket_path_));
+            ASSERT_TRUE(clients.back()->connected());
+            clients.back()->send_auth();
+        }
+        for (auto& client : clients) {
+            ASSERT_TRUE(wait_for_reply(*client, kAuthTag)) << "round " << round;
+        }
+        clients.clear();
+        std::this_thread::sleep_for(100ms);
+    }
+}
+
+TEST_F(PulseEventLoopTest, TimerPacesPlaybackAtStreamRate) {
+    TestClient client(socket_path_);
+    ASSERT_TRUE(client.connected());
+    client.send_auth();
+    ASSERT_TRUE(wait_for_reply(client, kAuthTag));
+    client.send_create_playback_stream();
+
+    // Serve every REQUEST for one second; pacing means we are asked for about one second of audio.
+    uint32_t stream_index = kInvalid;
+    uint64_t requested = 0;
+    const auto start = std::chrono::steady_clock::now();
+    const auto end = start + 1s;
+    while (std::chrono::steady_clock::now() < end) {
+        std::vector<Message> messages;
+        client.receive(messages, 10);
+        for (const auto& message : messages) {
+            TagReader reader(message.payload.data(), message.payload.size());
+            auto command = reader.read_u32();
+            auto tag = reader.read_u32();
+            if (!command || !tag) {
+                continue;
+            }
+            uint32_t bytes = 0;
+            if (*command == static_cast<uint32_t>(Command::Reply) && *tag == kCreateTag) {
+                stream_index = reader.read_u32().value_or(kInvalid);
+                reader.read_u32(); // sink input index
+                bytes = reader.read_u32().value_or(0);
+            } else if (*command == static_cast<uint32_t>(Command::Request)) {
+                reader.read_u32();
+                bytes = reader.read_u32().value_or(0);
+            }
+            if (bytes != 0 && stream_index != kInvalid) {
+                requested += bytes;
+                client.send_silence(stream_index, bytes);
+            }
+        }
+    }
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    ASSERT_NE(stream_index, kInvalid);
+    const double bytes_per_second = 48000.0 * 2 * 2;
+    EXPECT_GT(static_cast<double>(requested), bytes_per_second * elapsed * 0.7);
+    EXPECT_LT(static_cast<double>(requested), bytes_per_second * elapsed * 1.3);
+}
+
+TEST_F(PulseEventLoopTest, MemfdBlocksAreReleasedOnceIngested) {
+    constexpr uint32_t kShmId = 77;
+    const int memfd = make_pool(1 << 20, false);
+    ASSERT_GE(memfd, 0);
+
+    TestClient client(socket_path_);
+    ASSERT_TRUE(client.connected());
+    client.send_auth(kMemfdClientVersion | kProtocolFlagSHM | kProtocolFlagMemFd);
+    ASSERT_TRUE(wait_for_reply(client, kAuthTag));
+    client.send_register_memfd(kShmId, memfd);
+
+    // The second block starts mid-chunk, so it is consumed through the carry-over ring.
+    const auto released = play_memblocks(client, kShmId, {{5, 0, 7000}, {6, 7000, 13000}}, 2);
+    EXPECT_EQ(released, (std::vector<uint32_t>{5, 6}));
+    ::close(memfd);
+}
+
+TEST_F(PulseEventLoopTest, ShrinkSealedMemfdBlocksAreReadInPlace) {
+    constexpr uint32_t kShmId = 78;
+    const int memfd = make_pool(1 << 20, true);
+    ASSERT_GE(memfd, 0);
+
+    TestClient client(socket_path_);
+    ASSERT_TRUE(client.connected());
+    client.send_auth(kMemfdClientVersion | kProtocolFlagSHM | kProtocolFlagMemFd);
+    ASSERT_TRUE(wait_for_reply(client, kAuthTag));
+    client.send_register_memfd(kShmId, memfd);
+
+    const auto released = play_memblocks(client, kShmId, {{5, 0, 7000}, {6, 7000, 13000}}, 2);
+    EXPECT_EQ(released, (std::vector<uint32_t>{5, 6}));
+    ::close(memfd);
+}
+
+TEST_F(PulseEventLoopTest, UnsealedMemfdShrunkAfterRegistrationIsTrapped) {
+    constexpr uint32_t kShmId = 79;
+    const int memfd = make_pool(1 << 20, false);
+    ASSERT_GE(memfd, 0);
+
+    {
+        TestClient client(socket_path_);
+        ASSERT_TRUE(client.connected());
+        client.send_auth(kMemfdClientVersion | kProtocolFlagSHM | kProtocolFlagMemFd);
+        ASSERT_TRUE(wait_for_reply(client, kAuthTag));
+        client.send_register_memfd(kShmId, memfd);
+
+        // Shrink the pool after the server mapped it at full size, as an unsealed libpulse pool
+        // allows. Reading the block faults; the memtrap turns that into zeros, and only this
+        // client is dropped.
+        const auto released = play_memblocks(client, kShmId, {{5, 8192, 7000}}, 1,
+                                             [memfd]() { ASSERT_EQ(::ftruncate(memfd, 4096), 0); });
+        EXPECT_TRUE(released.empty());
+    }
+
+    TestClient next(socket_path_);
+    ASSERT_TRUE(next.connected());
+    next.send_auth(kClientVersion);
+    EXPECT_TRUE(wait_for_reply(next, kAuthTag));
+    ::close(memfd);
+}
+
+TEST(PulseMemTrapTest, TruncatedMappingReadsZerosAndMarksTrapBad) {
+    const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    constexpr std::size_t kPages = 16; // make_pool fills the first 32 KiB.
+    const int memfd = make_pool(kPages * page, false);
+    ASSERT_GE(memfd, 0);
+    const uint8_t marker = 0x5a;
+    ASSERT_EQ(::pwrite(memfd, &marker, 1, static_cast<off_t>((kPages - 1) * page)), 1);
+
+    void* mapped = ::mmap(nullptr, kPages * page, PROT_READ, MAP_SHARED, memfd, 0);
+    ASSERT_NE(mapped, MAP_FAILED);
+    const auto* bytes = static_cast<const volatile uint8_t*>(mapped);
+    {
+        auto trap = screamrouter::audio::pulse::MemTrap::add(mapped, kPages * page);
+        ASSERT_NE(trap, nullptr);
+        EXPECT_EQ(bytes[(kPages - 1) * page], marker);
+        EXPECT_TRUE(trap->is_good());
+
+        ASSERT_EQ(::ftruncate(memfd, static_cast<off_t>(page)), 0);
+        EXPECT_EQ(bytes[(kPages - 1) * page], 0);
+        EXPECT_EQ(bytes[0], 0); // The whole range is replaced, including pages still backed.
+        EXPECT_FALSE(trap->is_good());
+    }
+    ::munmap(mapped, kPages * page);
+    ::close(memfd);
+}
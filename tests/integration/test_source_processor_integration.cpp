@@ -6,14 +6,6 @@
 #include "audio_types.h"
 #include "configuration/audio_engine_settings.h"
 
-// Mock logging
-namespace screamrouter::audio::logging {
-    enum class LogLevel { DEBUG, INFO, WARNING, ERR };
-    std::atomic<LogLevel> current_log_level{LogLevel::INFO};
-    void log_message(LogLevel, const char*, int, const char*, ...) {}
-    const char* get_base_filename(const char* path) { return path; }
-}
-
 // Sentinel logging stub
 namespace screamrouter::audio::utils {
     void log_sentinel(const char*, const TaggedAudioPacket&, const std::string&) {}
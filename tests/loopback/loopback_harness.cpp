@@ -0,0 +1,1079 @@
+/**
+ * @file loopback_harness.cpp
+ * @brief End-to-end load generator and latency harness for the audio engine.
+ * @details Starts an AudioManager, feeds it N synthetic Scream or RTP sources over the
+ *          loopback interface and listens on loopback for the output of M Scream or RTP
+ *          sinks. Every source embeds short full-scale marker pulses on top of a quiet
+ *          tone; each sink probe detects the pulses in the mixed output and matches them
+ *          to the send times, giving glass-to-glass latency (send on the wire to receive
+ *          from the wire). The pulse length carries a small code so a lost marker does not
+ *          shift every later match. The report covers latency percentiles, packet jitter,
+ *          output gaps, RTP losses, engine underrun/drop counters and per-thread CPU.
+ *
+ *          Runs headless on any Linux box: no audio devices, no Python. Each source sends
+ *          from its own 127.0.x.y address so the engine sees N distinct source tags.
+ */
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <dirent.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "managers/audio_manager.h"
+#include "utils/cpp_logger.h"
+
+using namespace screamrouter::audio;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr int kSampleRate = 48000;
+constexpr int kChannels = 2;
+constexpr int kBitDepth = 16;
+constexpr int kFramesPerPacket = 288;  // 1152 bytes of 16-bit stereo, one Scream packet
+constexpr size_t kScreamHeaderBytes = 5;
+constexpr int kRawScreamPort = 16401;  // Fixed by ReceiverManager
+constexpr int kRtpListenPort = 40000;  // The RTP port that applies default payload mappings
+constexpr uint8_t kRtpPayloadTypeL16 = 127;
+
+constexpr float kToneAmplitude = 0.01f;   // -40 dBFS background so silence gating stays out of the way
+constexpr float kMarkerAmplitude = 0.5f;
+constexpr float kDetectThreshold = 0.2f;
+constexpr int kMarkerUnitFrames = 48;     // Marker pulses are 1..kMarkerCodes ms long
+constexpr int kMarkerCodes = 8;
+constexpr int kRefractoryFrames = kSampleRate / 100;  // 10 ms below threshold before the next onset
+
+struct HarnessOptions {
+    int sources = 4;
+    int sinks = 2;
+    std::string source_protocol = "scream";  // scream | rtp | mixed
+    std::string sink_protocol = "scream";    // scream | rtp
+    std::string topology = "full";           // full | spread
+    double duration_sec = 30.0;
+    double warmup_sec = 3.0;
+    int marker_interval_ms = 500;
+    int sink_base_port = 41000;
+    int timeshift_sec = 10;
+    double max_latency_ms = 2000.0;          // Markers not seen within this window count as missed
+    double fail_p99_ms = 0.0;                // Non-zero: exit 1 when p99 latency exceeds it
+    std::string json_path;
+    bool verbose = false;
+};
+
+void print_usage(const char* argv0) {
+    std::printf(
+        "Usage: %s [options]\n"
+        "  --sources N            synthetic sources (default 4)\n"
+        "  --sinks M              sinks received back on loopback (default 2)\n"
+        "  --source-protocol P    scream | rtp | mixed (default scream)\n"
+        "  --sink-protocol P      scream | rtp (default scream)\n"
+        "  --topology T           full: every source to every sink; spread: source i to sink i%%M (default full)\n"
+        "  --duration SEC         measured run time (default 30)\n"
+        "  --warmup SEC           time before measuring starts (default 3)\n"
+        "  --marker-interval MS   marker period per source (default 500)\n"
+        "  --sink-base-port PORT  first sink output port, sinks use every second port (default 41000)\n"
+        "  --timeshift SEC        engine timeshift buffer length (default 10)\n"
+        "  --max-latency MS       markers older than this are counted as missed (default 2000)\n"
+        "  --fail-p99 MS          exit with status 1 if p99 latency exceeds MS\n"
+        "  --json PATH            also write the report as JSON\n"
+        "  --verbose              print engine log output\n",
+        argv0);
+}
+
+bool parse_options(int argc, char** argv, HarnessOptions& out) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&](const char* name) -> const char* {
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "Missing value for %s\n", name);
+                return nullptr;
+            }
+            return argv[++i];
+        };
+        const char* v = nullptr;
+        if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            std::exit(0);
+        } else if (arg == "--verbose") {
+            out.verbose = true;
+        } else if (arg == "--sources") {
+            if (!(v = value("--sources"))) return false;
+            out.sources = std::atoi(v);
+        } else if (arg == "--sinks") {
+            if (!(v = value("--sinks"))) return false;
+            out.sinks = std::atoi(v);
+        } else if (arg == "--source-protocol") {
+            if (!(v = value("--source-protocol"))) return false;
+            out.source_protocol = v;
+        } else if (arg == "--sink-protocol") {
+            if (!(v = value("--sink-protocol"))) return false;
+            out.sink_protocol = v;
+        } else if (arg == "--topology") {
+            if (!(v = value("--topology"))) return false;
+            out.topology = v;
+        } else if (arg == "--duration") {
+            if (!(v = value("--duration"))) return false;
+            out.duration_sec = std::atof(v);
+        } else if (arg == "--warmup") {
+            if (!(v = value("--warmup"))) return false;
+            out.warmup_sec = std::atof(v);
+        } else if (arg == "--marker-interval") {
+            if (!(v = value("--marker-interval"))) return false;
+            out.marker_interval_ms = std::atoi(v);
+        } else if (arg == "--sink-base-port") {
+            if (!(v = value("--sink-base-port"))) return false;
+            out.sink_base_port = std::atoi(v);
+        } else if (arg == "--timeshift") {
+            if (!(v = value("--timeshift"))) return false;
+            out.timeshift_sec = std::atoi(v);
+        } else if (arg == "--max-latency") {
+            if (!(v = value("--max-latency"))) return false;
+            out.max_latency_ms = std::atof(v);
+        } else if (arg == "--fail-p99") {
+            if (!(v = value("--fail-p99"))) return false;
+            out.fail_p99_ms = std::atof(v);
+        } else if (arg == "--json") {
+            if (!(v = value("--json"))) return false;
+            out.json_path = v;
+        } else {
+            std::fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+            return false;
+        }
+    }
+    const bool protocols_ok =
+        (out.source_protocol == "scream" || out.source_protocol == "rtp" || out.source_protocol == "mixed") &&
+        (out.sink_protocol == "scream" || out.sink_protocol == "rtp") &&
+        (out.topology == "full" || out.topology == "spread");
+    if (!protocols_ok || out.sources < 1 || out.sources > 250 || out.sinks < 1 ||
+        out.duration_sec <= 0.0 || out.marker_interval_ms / out.sources < 20) {
+        std::fprintf(stderr, "Invalid option values (markers from all sources need at least 20 ms between them).\n");
+        return false;
+    }
+    return true;
+}
+
+void name_current_thread(const std::string& name) {
+    pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+}
+
+double ms_between(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+// --- Marker matching --------------------------------------------------------
+
+struct PendingMarker {
+    Clock::time_point emitted;
+    int code;       // Pulse length in kMarkerUnitFrames, minus one
+    bool measured;  // false for markers sent during warm-up
+};
+
+/**
+ * @brief Matches marker onsets seen at one sink to the markers the sources sent towards it.
+ * @details Sources are staggered so markers reach a sink one at a time and in send order.
+ *          An onset is matched to the oldest outstanding marker with the same code; older
+ *          markers skipped over were lost on the way.
+ */
+class LatencyTracker {
+public:
+    explicit LatencyTracker(double max_latency_ms) : max_latency_(std::chrono::microseconds(
+        static_cast<int64_t>(max_latency_ms * 1000.0))) {}
+
+    void expect(const PendingMarker& marker) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.push_back(marker);
+    }
+
+    void on_marker(Clock::time_point seen, int code) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        expire_locked(seen);
+        const size_t search = std::min<size_t>(pending_.size(), kMarkerCodes);
+        for (size_t i = 0; i < search && pending_[i].emitted <= seen; ++i) {
+            if (pending_[i].code != code) {
+                continue;
+            }
+            for (size_t skipped = 0; skipped < i; ++skipped) {
+                if (pending_.front().measured) {
+                    ++missed_;
+                }
+                pending_.pop_front();
+            }
+            if (pending_.front().measured) {
+                latencies_ms_.push_back(ms_between(pending_.front().emitted, seen));
+            }
+            pending_.pop_front();
+            return;
+        }
+        ++spurious_;
+    }
+
+    void expire(Clock::time_point now) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        expire_locked(now);
+    }
+
+    std::vector<double> latencies() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return latencies_ms_;
+    }
+    uint64_t missed() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return missed_;
+    }
+    uint64_t spurious() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return spurious_;
+    }
+
+private:
+    void expire_locked(Clock::time_point now) {
+        while (!pending_.empty() && pending_.front().emitted + max_latency_ < now) {
+            if (pending_.front().measured) {
+                ++missed_;
+            }
+            pending_.pop_front();
+        }
+    }
+
+    const Clock::duration max_latency_;
+    std::mutex mutex_;
+    std::deque<PendingMarker> pending_;
+    std::vector<double> latencies_ms_;
+    uint64_t missed_ = 0;
+    uint64_t spurious_ = 0;
+};
+
+// --- Sink probes ------------------------------------------------------------
+
+/** @brief Receives one sink's output on loopback, tracks arrival timing and detects markers. */
+class SinkProbe {
+public:
+    SinkProbe(std::string sink_id, std::string protocol, int port, double max_latency_ms)
+        : sink_id_(std::move(sink_id)), protocol_(std::move(protocol)), port_(port), tracker_(max_latency_ms) {}
+
+    ~SinkProbe() { stop(); }
+
+    bool open() {
+        fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+        if (fd_ < 0) {
+            return false;
+        }
+        int rcvbuf = 4 * 1024 * 1024;
+        ::setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<uint16_t>(port_));
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (::bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            std::fprintf(stderr, "Failed to bind sink probe on 127.0.0.1:%d: %s\n", port_, std::strerror(errno));
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+        return true;
+    }
+
+    void start() {
+        running_ = true;
+        thread_ = std::thread(&SinkProbe::run, this);
+    }
+
+    void stop() {
+        running_ = false;
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    /** @brief Starts counting arrival statistics; latency measurement is gated per marker. */
+    void begin_measurement() { measuring_ = true; }
+
+    const std::string& sink_id() const { return sink_id_; }
+    const std::string& protocol() const { return protocol_; }
+    int port() const { return port_; }
+    LatencyTracker& tracker() { return tracker_; }
+
+    struct ArrivalStats {
+        uint64_t packets = 0;
+        uint64_t bytes = 0;
+        uint64_t gaps = 0;          // Inter-arrival gaps longer than 2.5 packet periods
+        uint64_t rtp_lost = 0;      // Missing RTP sequence numbers
+        double jitter_ms = 0.0;     // RFC 3550 style smoothed inter-arrival jitter
+        double max_gap_ms = 0.0;
+    };
+
+    ArrivalStats arrival_stats() {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        return stats_;
+    }
+
+private:
+    void run() {
+        name_current_thread("lb_" + sink_id_);
+        std::vector<uint8_t> buffer(65536);
+        while (running_) {
+            pollfd pfd{fd_, POLLIN, 0};
+            const int ready = ::poll(&pfd, 1, 50);
+            const auto now = Clock::now();
+            tracker_.expire(now);
+            if (ready <= 0) {
+                continue;
+            }
+            const ssize_t size = ::recv(fd_, buffer.data(), buffer.size(), 0);
+            if (size <= 0) {
+                continue;
+            }
+            handle_packet(buffer.data(), static_cast<size_t>(size), now);
+        }
+    }
+
+    void handle_packet(const uint8_t* data, size_t size, Clock::time_point arrival) {
+        const uint8_t* payload = nullptr;
+        size_t payload_size = 0;
+        int bit_depth = kBitDepth;
+        int channels = kChannels;
+        bool big_endian = false;
+        int sample_rate = kSampleRate;
+
+        if (protocol_ == "rtp") {
+            if (size < 12 || (data[0] >> 6) != 2) {
+                return;
+            }
+            size_t header = 12 + (data[0] & 0x0F) * 4;
+            if (data[0] & 0x10) {
+                if (size < header + 4) {
+                    return;
+                }
+                header += 4 + ((static_cast<size_t>(data[header + 2]) << 8) | data[header + 3]) * 4;
+            }
+            if (size <= header) {
+                return;
+            }
+            const uint16_t seq = static_cast<uint16_t>((data[2] << 8) | data[3]);
+            if (have_seq_ && measuring_) {
+                const uint16_t expected = static_cast<uint16_t>(last_seq_ + 1);
+                const uint16_t skipped = static_cast<uint16_t>(seq - expected);
+                if (skipped != 0 && skipped < 0x8000) {
+                    std::lock_guard<std::mutex> lock(stats_mutex_);
+                    stats_.rtp_lost += skipped;
+                }
+            }
+            have_seq_ = true;
+            last_seq_ = seq;
+            payload = data + header;
+            payload_size = size - header;
+            big_endian = true;
+        } else {
+            if (size <= kScreamHeaderBytes) {
+                return;
+            }
+            const int base = (data[0] & 0x80) ? 44100 : 48000;
+            const int mult = (data[0] & 0x7F) ? (data[0] & 0x7F) : 1;
+            sample_rate = base * mult;
+            bit_depth = data[1];
+            channels = data[2] ? data[2] : kChannels;
+            payload = data + kScreamHeaderBytes;
+            payload_size = size - kScreamHeaderBytes;
+        }
+
+        const int bytes_per_sample = bit_depth / 8;
+        if (bytes_per_sample < 2 || bytes_per_sample > 4) {
+            return;
+        }
+        const size_t frames = payload_size / (static_cast<size_t>(bytes_per_sample) * channels);
+        record_arrival(arrival, size, static_cast<double>(frames) * 1000.0 / sample_rate);
+
+        const float full_scale = static_cast<float>(1u << (bit_depth - 1));
+        for (size_t frame = 0; frame < frames; ++frame) {
+            float peak = 0.0f;
+            for (int ch = 0; ch < channels; ++ch) {
+                const uint8_t* s = payload + (frame * channels + ch) * bytes_per_sample;
+                int32_t value = 0;
+                for (int b = 0; b < bytes_per_sample; ++b) {
+                    const int shift = big_endian ? (bytes_per_sample - 1 - b) * 8 : b * 8;
+                    value |= static_cast<int32_t>(s[b]) << shift;
+                }
+                value <<= (32 - bit_depth);  // sign-extend
+                value >>= (32 - bit_depth);
+                peak = std::max(peak, std::fabs(static_cast<float>(value) / full_scale));
+            }
+            if (peak >= kDetectThreshold) {
+                if (pulse_frames_ == 0 && quiet_frames_ >= kRefractoryFrames) {
+                    onset_ = arrival + std::chrono::microseconds(static_cast<int64_t>(frame * 1000000.0 / sample_rate));
+                    pulse_frames_ = 1;
+                } else if (pulse_frames_ > 0) {
+                    ++pulse_frames_;
+                }
+                quiet_frames_ = 0;
+            } else {
+                if (pulse_frames_ > 0) {
+                    // Falling edge: the pulse length identifies the marker.
+                    const int code = (pulse_frames_ + kMarkerUnitFrames / 2) / kMarkerUnitFrames - 1;
+                    if (code >= 0 && code < kMarkerCodes) {
+                        tracker_.on_marker(onset_, code);
+                    }
+                    pulse_frames_ = 0;
+                }
+                if (quiet_frames_ < kRefractoryFrames) {
+                    ++quiet_frames_;
+                }
+            }
+        }
+    }
+
+    void record_arrival(Clock::time_point arrival, size_t bytes, double packet_ms) {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        if (measuring_) {
+            ++stats_.packets;
+            stats_.bytes += bytes;
+            if (have_arrival_) {
+                const double delta = ms_between(last_arrival_, arrival);
+                stats_.jitter_ms += (std::fabs(delta - last_packet_ms_) - stats_.jitter_ms) / 16.0;
+                stats_.max_gap_ms = std::max(stats_.max_gap_ms, delta);
+                if (delta > 2.5 * last_packet_ms_) {
+                    ++stats_.gaps;
+                }
+            }
+        }
+        have_arrival_ = true;
+        last_arrival_ = arrival;
+        last_packet_ms_ = packet_ms;
+    }
+
+    const std::string sink_id_;
+    const std::string protocol_;
+    const int port_;
+    int fd_ = -1;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> measuring_{false};
+    std::thread thread_;
+    LatencyTracker tracker_;
+
+    int quiet_frames_ = kRefractoryFrames;
+    int pulse_frames_ = 0;
+    Clock::time_point onset_;
+    bool have_seq_ = false;
+    uint16_t last_seq_ = 0;
+    bool have_arrival_ = false;
+    Clock::time_point last_arrival_;
+    double last_packet_ms_ = 0.0;
+
+    std::mutex stats_mutex_;
+    ArrivalStats stats_;
+};
+
+// --- Synthetic sources ------------------------------------------------------
+
+/** @brief Sends a paced Scream or RTP stream with periodic marker pulses from a unique loopback address. */
+class SyntheticSource {
+public:
+    SyntheticSource(int index, int total, std::string protocol, int marker_interval_ms)
+        : index_(index), total_(total), protocol_(std::move(protocol)) {
+        const int packets_per_marker = std::max(1, marker_interval_ms * kSampleRate / 1000 / kFramesPerPacket);
+        marker_period_packets_ = packets_per_marker;
+        // Stagger the sources so their markers never overlap in a sink's mix.
+        marker_phase_ = (index * packets_per_marker) / total;
+        const int subnet = protocol_ == "rtp" ? 2 : 1;
+        bind_ip_ = "127.0." + std::to_string(subnet) + "." + std::to_string(index + 1);
+    }
+
+    ~SyntheticSource() { stop(); }
+
+    const std::string& tag() const { return bind_ip_; }
+    const std::string& protocol() const { return protocol_; }
+    uint64_t late_wakeups() const { return late_wakeups_.load(); }
+
+    void add_target(SinkProbe* probe) { targets_.push_back(probe); }
+
+    bool open() {
+        fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+        if (fd_ < 0) {
+            return false;
+        }
+        sockaddr_in local{};
+        local.sin_family = AF_INET;
+        local.sin_port = 0;
+        ::inet_pton(AF_INET, bind_ip_.c_str(), &local.sin_addr);
+        if (::bind(fd_, reinterpret_cast<sockaddr*>(&local), sizeof(local)) != 0) {
+            std::fprintf(stderr, "Failed to bind source on %s: %s\n", bind_ip_.c_str(), std::strerror(errno));
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+        dest_.sin_family = AF_INET;
+        dest_.sin_port = htons(static_cast<uint16_t>(protocol_ == "rtp" ? kRtpListenPort : kRawScreamPort));
+        dest_.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        return true;
+    }
+
+    void start(Clock::time_point measure_from) {
+        measure_from_ = measure_from;
+        running_ = true;
+        thread_ = std::thread(&SyntheticSource::run, this);
+    }
+
+    void stop() {
+        running_ = false;
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+private:
+    void run() {
+        name_current_thread("lb_src" + std::to_string(index_));
+        const size_t payload_bytes = kFramesPerPacket * kChannels * (kBitDepth / 8);
+        const size_t header_bytes = protocol_ == "rtp" ? 12 : kScreamHeaderBytes;
+        std::vector<uint8_t> packet(header_bytes + payload_bytes, 0);
+        const auto period = std::chrono::microseconds(kFramesPerPacket * 1000000LL / kSampleRate);
+        const double phase_step = 2.0 * M_PI * (220.0 + 20.0 * index_) / kSampleRate;
+        double phase = 0.0;
+        uint16_t seq = 0;
+        uint32_t rtp_timestamp = 0;
+        const uint32_t ssrc = 0x5C000000u + static_cast<uint32_t>(index_);
+
+        uint64_t markers_sent = 0;
+        int marker_frames_left = 0;
+        int marker_code = 0;
+
+        auto next_send = Clock::now();
+        for (uint64_t packet_index = 0; running_; ++packet_index) {
+            std::this_thread::sleep_until(next_send);
+            const bool marker = (packet_index % marker_period_packets_) == static_cast<uint64_t>(marker_phase_);
+            if (marker) {
+                // Consecutive markers at a sink come from consecutive sources, so this cycles the codes.
+                marker_code = static_cast<int>((markers_sent * total_ + index_) % kMarkerCodes);
+                marker_frames_left = kMarkerUnitFrames * (marker_code + 1);
+                ++markers_sent;
+            }
+
+            uint8_t* payload = packet.data() + header_bytes;
+            for (int frame = 0; frame < kFramesPerPacket; ++frame) {
+                float value = kToneAmplitude * static_cast<float>(std::sin(phase));
+                phase += phase_step;
+                if (marker_frames_left > 0) {
+                    value += kMarkerAmplitude;
+                    --marker_frames_left;
+                }
+                const int16_t sample = static_cast<int16_t>(std::lrint(value * 32767.0f));
+                for (int ch = 0; ch < kChannels; ++ch) {
+                    uint8_t* out = payload + (frame * kChannels + ch) * 2;
+                    if (protocol_ == "rtp") {  // L16 is big-endian on the wire
+                        out[0] = static_cast<uint8_t>(static_cast<uint16_t>(sample) >> 8);
+                        out[1] = static_cast<uint8_t>(sample & 0xFF);
+                    } else {
+                        out[0] = static_cast<uint8_t>(sample & 0xFF);
+                        out[1] = static_cast<uint8_t>(static_cast<uint16_t>(sample) >> 8);
+                    }
+                }
+            }
+            if (phase > 2.0 * M_PI) {
+                phase = std::fmod(phase, 2.0 * M_PI);
+            }
+
+            if (protocol_ == "rtp") {
+                packet[0] = 0x80;
+                packet[1] = kRtpPayloadTypeL16;
+                packet[2] = static_cast<uint8_t>(seq >> 8);
+                packet[3] = static_cast<uint8_t>(seq & 0xFF);
+                const uint32_t ts_net = htonl(rtp_timestamp);
+                const uint32_t ssrc_net = htonl(ssrc);
+                std::memcpy(packet.data() + 4, &ts_net, 4);
+                std::memcpy(packet.data() + 8, &ssrc_net, 4);
+                ++seq;
+                rtp_timestamp += kFramesPerPacket;
+            } else {
+                packet[0] = 1;  // 48 kHz base, multiplier 1
+                packet[1] = kBitDepth;
+                packet[2] = kChannels;
+                packet[3] = 0x03;
+                packet[4] = 0x00;
+            }
+
+            if (marker) {
+                const auto now = Clock::now();
+                for (auto* target : targets_) {
+                    target->tracker().expect({now, marker_code, now >= measure_from_});
+                }
+            }
+            ::sendto(fd_, packet.data(), packet.size(), 0, reinterpret_cast<const sockaddr*>(&dest_), sizeof(dest_));
+
+            next_send += period;
+            const auto now = Clock::now();
+            if (now > next_send + std::chrono::milliseconds(50)) {
+                // Fell far behind (host overloaded); resync instead of bursting.
+                ++late_wakeups_;
+                next_send = now;
+            }
+        }
+    }
+
+    const int index_;
+    const int total_;
+    const std::string protocol_;
+    int marker_period_packets_ = 1;
+    int marker_phase_ = 0;
+    std::string bind_ip_;
+    int fd_ = -1;
+    sockaddr_in dest_{};
+    std::vector<SinkProbe*> targets_;
+    Clock::time_point measure_from_;
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> late_wakeups_{0};
+    std::thread thread_;
+};
+
+// --- Engine counters and thread CPU ----------------------------------------
+
+struct EngineCounters {
+    uint64_t sink_underruns = 0;
+    uint64_t sink_overflows = 0;
+    uint64_t lane_underruns = 0;
+    uint64_t lane_dropped = 0;
+    uint64_t timeshift_underruns = 0;
+    uint64_t timeshift_discarded = 0;
+    uint64_t timeshift_late = 0;
+    uint64_t source_discarded = 0;
+
+    EngineCounters operator-(const EngineCounters& o) const {
+        auto sub = [](uint64_t a, uint64_t b) { return a > b ? a - b : 0; };
+        EngineCounters d;
+        d.sink_underruns = sub(sink_underruns, o.sink_underruns);
+        d.sink_overflows = sub(sink_overflows, o.sink_overflows);
+        d.lane_underruns = sub(lane_underruns, o.lane_underruns);
+        d.lane_dropped = sub(lane_dropped, o.lane_dropped);
+        d.timeshift_underruns = sub(timeshift_underruns, o.timeshift_underruns);
+        d.timeshift_discarded = sub(timeshift_discarded, o.timeshift_discarded);
+        d.timeshift_late = sub(timeshift_late, o.timeshift_late);
+        d.source_discarded = sub(source_discarded, o.source_discarded);
+        return d;
+    }
+};
+
+EngineCounters snapshot_engine_counters(AudioManager& manager) {
+    const AudioEngineStats stats = manager.get_audio_engine_stats();
+    EngineCounters counters;
+    for (const auto& sink : stats.sink_stats) {
+        counters.sink_underruns += sink.sink_buffer_underruns;
+        counters.sink_overflows += sink.sink_buffer_overflows;
+        for (const auto& lane : sink.inputs) {
+            counters.lane_underruns += lane.underrun_events;
+            counters.lane_dropped += lane.ready_total_dropped;
+        }
+    }
+    for (const auto& [tag, stream] : stats.stream_stats) {
+        counters.timeshift_underruns += stream.tm_buffer_underruns;
+        counters.timeshift_discarded += stream.tm_packets_discarded;
+        counters.timeshift_late += stream.timeshift_buffer_late_packets;
+    }
+    for (const auto& source : stats.source_stats) {
+        counters.source_discarded += source.discarded_packets;
+    }
+    return counters;
+}
+
+struct ThreadCpu {
+    std::string name;
+    uint64_t ticks = 0;  // utime + stime in clock ticks
+};
+
+std::map<int, ThreadCpu> snapshot_thread_cpu() {
+    std::map<int, ThreadCpu> result;
+    DIR* dir = ::opendir("/proc/self/task");
+    if (!dir) {
+        return result;
+    }
+    while (dirent* entry = ::readdir(dir)) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        const int tid = std::atoi(entry->d_name);
+        const std::string path = std::string("/proc/self/task/") + entry->d_name + "/stat";
+        FILE* fp = std::fopen(path.c_str(), "r");
+        if (!fp) {
+            continue;
+        }
+        char line[1024] = {};
+        const bool read_ok = std::fgets(line, sizeof(line), fp) != nullptr;
+        std::fclose(fp);
+        if (!read_ok) {
+            continue;
+        }
+        // The thread name is in parentheses and may itself contain spaces or parentheses.
+        const char* open = std::strchr(line, '(');
+        const char* close = std::strrchr(line, ')');
+        if (!open || !close || close < open) {
+            continue;
+        }
+        ThreadCpu cpu;
+        cpu.name.assign(open + 1, close);
+        unsigned long long utime = 0;
+        unsigned long long stime = 0;
+        // Fields after the name: state ppid pgrp session tty_nr tpgid flags minflt cminflt majflt cmajflt utime stime
+        if (std::sscanf(close + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu", &utime, &stime) == 2) {
+            cpu.ticks = utime + stime;
+            result[tid] = cpu;
+        }
+    }
+    ::closedir(dir);
+    return result;
+}
+
+// --- Reporting ----------------------------------------------------------------
+
+struct LatencySummary {
+    size_t count = 0;
+    double min = 0, mean = 0, stddev = 0, p50 = 0, p90 = 0, p99 = 0, p999 = 0, max = 0;
+};
+
+LatencySummary summarize(std::vector<double> values) {
+    LatencySummary s;
+    s.count = values.size();
+    if (values.empty()) {
+        return s;
+    }
+    std::sort(values.begin(), values.end());
+    auto pct = [&values](double p) {
+        const size_t idx = std::min(values.size() - 1, static_cast<size_t>(std::ceil(p * values.size())) - 1);
+        return values[idx];
+    };
+    double sum = 0.0;
+    for (double v : values) {
+        sum += v;
+    }
+    s.mean = sum / values.size();
+    double var = 0.0;
+    for (double v : values) {
+        var += (v - s.mean) * (v - s.mean);
+    }
+    s.stddev = std::sqrt(var / values.size());
+    s.min = values.front();
+    s.max = values.back();
+    s.p50 = pct(0.50);
+    s.p90 = pct(0.90);
+    s.p99 = pct(0.99);
+    s.p999 = pct(0.999);
+    return s;
+}
+
+std::string json_escape(const std::string& in) {
+    std::string out;
+    for (char c : in) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+void write_latency_json(FILE* fp, const LatencySummary& s) {
+    std::fprintf(fp,
+                 "{\"count\":%zu,\"min_ms\":%.3f,\"mean_ms\":%.3f,\"stddev_ms\":%.3f,\"p50_ms\":%.3f,"
+                 "\"p90_ms\":%.3f,\"p99_ms\":%.3f,\"p999_ms\":%.3f,\"max_ms\":%.3f}",
+                 s.count, s.min, s.mean, s.stddev, s.p50, s.p90, s.p99, s.p999, s.max);
+}
+
+void print_latency_row(const char* label, const LatencySummary& s) {
+    std::printf("  %-14s n=%-6zu p50=%7.2f  p90=%7.2f  p99=%7.2f  p99.9=%7.2f  max=%7.2f  mean=%7.2f  sd=%6.2f ms\n",
+                label, s.count, s.p50, s.p90, s.p99, s.p999, s.max, s.mean, s.stddev);
+}
+
+std::atomic<bool> g_log_drain_running{false};
+
+void drain_engine_logs(bool verbose) {
+    name_current_thread("lb_logdrain");
+    while (g_log_drain_running) {
+        for (const auto& entry : logging::retrieve_log_entries(100)) {
+            if (verbose) {
+                std::fprintf(stderr, "[engine] %s:%d %s\n", entry.filename.c_str(), entry.line_number,
+                             entry.message.c_str());
+            }
+        }
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    HarnessOptions options;
+    if (!parse_options(argc, argv, options)) {
+        print_usage(argv[0]);
+        return 2;
+    }
+    // The Pulse receiver builds its socket path from XDG_RUNTIME_DIR.
+    if (!std::getenv("XDG_RUNTIME_DIR")) {
+        ::setenv("XDG_RUNTIME_DIR", "/tmp", 0);
+    }
+
+    g_log_drain_running = true;
+    std::thread log_thread(drain_engine_logs, options.verbose);
+
+    auto manager = std::make_unique<AudioManager>();
+    if (!manager->initialize(kRtpListenPort, options.timeshift_sec)) {
+        std::fprintf(stderr, "AudioManager failed to initialize.\n");
+        g_log_drain_running = false;
+        log_thread.join();
+        return 2;
+    }
+
+    // Sinks and their loopback probes.
+    std::vector<std::unique_ptr<SinkProbe>> probes;
+    for (int i = 0; i < options.sinks; ++i) {
+        const std::string sink_id = "lb_sink" + std::to_string(i);
+        const int port = options.sink_base_port + 2 * i;  // RTP sinks also use port + 1 for RTCP
+        auto probe = std::make_unique<SinkProbe>(sink_id, options.sink_protocol, port, options.max_latency_ms);
+        if (!probe->open()) {
+            manager->shutdown();
+            g_log_drain_running = false;
+            log_thread.join();
+            return 2;
+        }
+        probe->start();
+
+        SinkConfig sink;
+        sink.id = sink_id;
+        sink.friendly_name = "Loopback " + sink_id;
+        sink.output_ip = "127.0.0.1";
+        sink.output_port = port;
+        sink.samplerate = kSampleRate;
+        sink.bitdepth = kBitDepth;
+        sink.channels = kChannels;
+        sink.protocol = options.sink_protocol;
+        if (!manager->add_sink(sink)) {
+            std::fprintf(stderr, "add_sink failed for %s\n", sink_id.c_str());
+        }
+        probes.push_back(std::move(probe));
+    }
+
+    // Sources, their engine-side source paths and the source -> sink routing.
+    std::vector<std::unique_ptr<SyntheticSource>> sources;
+    for (int i = 0; i < options.sources; ++i) {
+        std::string protocol = options.source_protocol;
+        if (protocol == "mixed") {
+            protocol = (i % 2 == 0) ? "scream" : "rtp";
+        }
+        auto source = std::make_unique<SyntheticSource>(i, options.sources, protocol, options.marker_interval_ms);
+        if (!source->open()) {
+            manager->shutdown();
+            g_log_drain_running = false;
+            log_thread.join();
+            return 2;
+        }
+
+        SourceConfig config;
+        config.tag = source->tag();
+        config.target_output_channels = kChannels;
+        config.target_output_samplerate = kSampleRate;
+        const std::string instance_id = manager->configure_source(config);
+        if (instance_id.empty()) {
+            std::fprintf(stderr, "configure_source failed for %s\n", config.tag.c_str());
+            continue;
+        }
+        for (int s = 0; s < options.sinks; ++s) {
+            if (options.topology == "spread" && s != i % options.sinks) {
+                continue;
+            }
+            if (manager->connect_source_sink(instance_id, probes[s]->sink_id())) {
+                source->add_target(probes[s].get());
+            }
+        }
+        sources.push_back(std::move(source));
+    }
+
+    std::printf("Loopback harness: %d %s source(s) -> %d %s sink(s), topology=%s, warm-up %.1fs, measuring %.1fs\n",
+                options.sources, options.source_protocol.c_str(), options.sinks, options.sink_protocol.c_str(),
+                options.topology.c_str(), options.warmup_sec, options.duration_sec);
+    std::fflush(stdout);
+
+    const auto start = Clock::now();
+    const auto measure_from = start + std::chrono::microseconds(static_cast<int64_t>(options.warmup_sec * 1e6));
+    const auto measure_until = measure_from + std::chrono::microseconds(static_cast<int64_t>(options.duration_sec * 1e6));
+    for (auto& source : sources) {
+        source->start(measure_from);
+    }
+
+    std::this_thread::sleep_until(measure_from);
+    const EngineCounters counters_before = snapshot_engine_counters(*manager);
+    const auto cpu_before = snapshot_thread_cpu();
+    for (auto& probe : probes) {
+        probe->begin_measurement();
+    }
+
+    std::this_thread::sleep_until(measure_until);
+    const auto cpu_after = snapshot_thread_cpu();
+    const double measured_sec = std::chrono::duration<double>(Clock::now() - measure_from).count();
+    const EngineCounters counters = snapshot_engine_counters(*manager) - counters_before;
+
+    for (auto& source : sources) {
+        source->stop();
+    }
+    // Let markers already in flight reach the probes before tearing the engine down.
+    std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<int64_t>(options.max_latency_ms)));
+    manager->shutdown();
+    manager.reset();
+    for (auto& probe : probes) {
+        probe->stop();
+    }
+    g_log_drain_running = false;
+    log_thread.join();
+
+    // --- Report ---
+    std::vector<double> all_latencies;
+    uint64_t total_missed = 0;
+    uint64_t late_wakeups = 0;
+    for (const auto& source : sources) {
+        late_wakeups += source->late_wakeups();
+    }
+
+    std::printf("\nGlass-to-glass latency (marker sent -> marker received):\n");
+    std::vector<LatencySummary> sink_summaries;
+    for (auto& probe : probes) {
+        auto latencies = probe->tracker().latencies();
+        all_latencies.insert(all_latencies.end(), latencies.begin(), latencies.end());
+        total_missed += probe->tracker().missed();
+        sink_summaries.push_back(summarize(std::move(latencies)));
+        print_latency_row(probe->sink_id().c_str(), sink_summaries.back());
+    }
+    const LatencySummary overall = summarize(all_latencies);
+    print_latency_row("all sinks", overall);
+
+    std::printf("\nSink output timing:\n");
+    for (auto& probe : probes) {
+        const auto stats = probe->arrival_stats();
+        std::printf("  %-14s packets=%-8llu jitter=%6.3f ms  max_gap=%7.2f ms  gaps=%-5llu rtp_lost=%-5llu "
+                    "markers_missed=%-4llu spurious=%llu\n",
+                    probe->sink_id().c_str(), static_cast<unsigned long long>(stats.packets), stats.jitter_ms,
+                    stats.max_gap_ms, static_cast<unsigned long long>(stats.gaps),
+                    static_cast<unsigned long long>(stats.rtp_lost),
+                    static_cast<unsigned long long>(probe->tracker().missed()),
+                    static_cast<unsigned long long>(probe->tracker().spurious()));
+    }
+
+    std::printf("\nEngine counters during measurement:\n");
+    std::printf("  sink underruns=%llu overflows=%llu | input lane underruns=%llu dropped=%llu\n",
+                static_cast<unsigned long long>(counters.sink_underruns),
+                static_cast<unsigned long long>(counters.sink_overflows),
+                static_cast<unsigned long long>(counters.lane_underruns),
+                static_cast<unsigned long long>(counters.lane_dropped));
+    std::printf("  timeshift underruns=%llu discarded=%llu late=%llu | source discarded=%llu | sender late wakeups=%llu\n",
+                static_cast<unsigned long long>(counters.timeshift_underruns),
+                static_cast<unsigned long long>(counters.timeshift_discarded),
+                static_cast<unsigned long long>(counters.timeshift_late),
+                static_cast<unsigned long long>(counters.source_discarded),
+                static_cast<unsigned long long>(late_wakeups));
+
+    // Threads that started after the first snapshot count from zero.
+    const double ticks_per_sec = static_cast<double>(::sysconf(_SC_CLK_TCK));
+    struct ThreadRow {
+        int tid;
+        std::string name;
+        double cpu_percent;
+    };
+    std::vector<ThreadRow> thread_rows;
+    double total_cpu_percent = 0.0;
+    for (const auto& [tid, after] : cpu_after) {
+        const auto before = cpu_before.find(tid);
+        const uint64_t base = before != cpu_before.end() ? before->second.ticks : 0;
+        const double percent = (after.ticks - std::min(after.ticks, base)) / ticks_per_sec / measured_sec * 100.0;
+        total_cpu_percent += percent;
+        thread_rows.push_back({tid, after.name, percent});
+    }
+    std::sort(thread_rows.begin(), thread_rows.end(),
+              [](const ThreadRow& a, const ThreadRow& b) { return a.cpu_percent > b.cpu_percent; });
+    std::printf("\nPer-thread CPU (%% of one core, %zu threads, total %.1f%%):\n", thread_rows.size(), total_cpu_percent);
+    for (const auto& row : thread_rows) {
+        if (row.cpu_percent < 0.05) {
+            continue;
+        }
+        std::printf("  %7d %-16s %6.1f%%\n", row.tid, row.name.c_str(), row.cpu_percent);
+    }
+
+    if (!options.json_path.empty()) {
+        FILE* fp = std::fopen(options.json_path.c_str(), "w");
+        if (!fp) {
+            std::fprintf(stderr, "Failed to write %s\n", options.json_path.c_str());
+        } else {
+            std::fprintf(fp, "{\"config\":{\"sources\":%d,\"sinks\":%d,\"source_protocol\":\"%s\",\"sink_protocol\":\"%s\","
+                             "\"topology\":\"%s\",\"duration_sec\":%.3f,\"warmup_sec\":%.3f,\"marker_interval_ms\":%d},\n",
+                         options.sources, options.sinks, options.source_protocol.c_str(), options.sink_protocol.c_str(),
+                         options.topology.c_str(), measured_sec, options.warmup_sec, options.marker_interval_ms);
+            std::fputs("\"latency\":", fp);
+            write_latency_json(fp, overall);
+            std::fputs(",\n\"sinks\":[", fp);
+            for (size_t i = 0; i < probes.size(); ++i) {
+                const auto stats = probes[i]->arrival_stats();
+                std::fprintf(fp, "%s\n{\"id\":\"%s\",\"protocol\":\"%s\",\"latency\":", i ? "," : "",
+                             json_escape(probes[i]->sink_id()).c_str(), probes[i]->protocol().c_str());
+                write_latency_json(fp, sink_summaries[i]);
+                std::fprintf(fp, ",\"packets\":%llu,\"jitter_ms\":%.3f,\"max_gap_ms\":%.3f,\"gaps\":%llu,"
+                                 "\"rtp_lost\":%llu,\"markers_missed\":%llu,\"spurious_markers\":%llu}",
+                             static_cast<unsigned long long>(stats.packets), stats.jitter_ms, stats.max_gap_ms,
+                             static_cast<unsigned long long>(stats.gaps), static_cast<unsigned long long>(stats.rtp_lost),
+                             static_cast<unsigned long long>(probes[i]->tracker().missed()),
+                             static_cast<unsigned long long>(probes[i]->tracker().spurious()));
+            }
+            std::fprintf(fp, "],\n\"engine\":{\"sink_underruns\":%llu,\"sink_overflows\":%llu,\"lane_underruns\":%llu,"
+                             "\"lane_dropped\":%llu,\"timeshift_underruns\":%llu,\"timeshift_discarded\":%llu,"
+                             "\"timeshift_late\":%llu,\"source_discarded\":%llu,\"sender_late_wakeups\":%llu},\n",
+                         static_cast<unsigned long long>(counters.sink_underruns),
+                         static_cast<unsigned long long>(counters.sink_overflows),
+                         static_cast<unsigned long long>(counters.lane_underruns),
+                         static_cast<unsigned long long>(counters.lane_dropped),
+                         static_cast<unsigned long long>(counters.timeshift_underruns),
+                         static_cast<unsigned long long>(counters.timeshift_discarded),
+                         static_cast<unsigned long long>(counters.timeshift_late),
+                         static_cast<unsigned long long>(counters.source_discarded),
+                         static_cast<unsigned long long>(late_wakeups));
+            std::fprintf(fp, "\"threads\":{\"total_cpu_percent\":%.2f,\"list\":[", total_cpu_percent);
+            for (size_t i = 0; i < thread_rows.size(); ++i) {
+                std::fprintf(fp, "%s\n{\"tid\":%d,\"name\":\"%s\",\"cpu_percent\":%.2f}", i ? "," : "",
+                             thread_rows[i].tid, json_escape(thread_rows[i].name).c_str(), thread_rows[i].cpu_percent);
+            }
+            std::fputs("]}}\n", fp);
+            std::fclose(fp);
+            std::printf("\nWrote JSON report to %s\n", options.json_path.c_str());
+        }
+    }
+
+    if (overall.count == 0) {
+        std::fprintf(stderr, "\nNo markers were measured; check that sources reached the sinks.\n");
+        return 1;
+    }
+    if (options.fail_p99_ms > 0.0 && overall.p99 > options.fail_p99_ms) {
+        std::fprintf(stderr, "\np99 latency %.2f ms exceeds the %.2f ms limit.\n", overall.p99, options.fail_p99_ms);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,444 @@
+/**
+ * @file realtime_checker.cpp
+ * @brief glibc interposers backing SR_RT_SCOPE in test binaries.
+ * @details Link into a test executable built with SCREAMROUTER_RT_CHECKS. The executable's
+ *          definitions of malloc, pthread_mutex_lock, nanosleep, ... take precedence over
+ *          libc's, so every call made through the PLT lands here first. Allocation calls are
+ *          forwarded to glibc's __libc_* entry points; the rest are resolved with dlsym at
+ *          startup so no lookup (and no allocation) happens inside a real-time scope.
+ */
+#include "realtime_checker.h"
+#include "utils/realtime_scope.h"
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <sstream>
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+}
+
+namespace screamrouter {
+namespace audio {
+namespace testing {
+
+namespace {
+
+namespace rt = ::screamrouter::audio::utils::rt;
+
+constexpr int kMaxFrames = 48;
+constexpr size_t kMaxStoredViolations = 256;
+/** @brief record() and the interposer that called it. */
+constexpr int kCheckerFrames = 2;
+
+struct RawViolation {
+    RtViolationKind kind;
+    const char* scope;
+    const char* call;
+    size_t bytes;
+    int depth;
+    void* frames[kMaxFrames];
+};
+
+RawViolation g_violations[kMaxStoredViolations];
+std::atomic<uint64_t> g_violation_count{0};
+std::atomic<bool> g_active{false};
+bool g_abort_on_violation = false;
+
+/** @brief Keeps the checker's own work (backtrace, reporting) out of the checks. */
+struct Suspend {
+    Suspend() { ++rt::thread_state().suspended; }
+    ~Suspend() { --rt::thread_state().suspended; }
+};
+
+const char* kind_name(RtViolationKind kind) {
+    switch (kind) {
+        case RtViolationKind::ALLOCATION: return "allocation";
+        case RtViolationKind::DEALLOCATION: return "deallocation";
+        case RtViolationKind::MUTEX_WAIT: return "mutex wait";
+        case RtViolationKind::CONDITION_WAIT: return "condition wait";
+        case RtViolationKind::SYSCALL: return "blocking syscall";
+    }
+    return "unknown";
+}
+
+__attribute__((noinline)) void record(RtViolationKind kind, const char* call, size_t bytes) {
+    Suspend suspend;
+    const char* scope = rt::thread_state().scope;
+    const uint64_t index = g_violation_count.fetch_add(1, std::memory_order_relaxed);
+    if (index < kMaxStoredViolations) {
+        RawViolation& v = g_violations[index];
+        v.kind = kind;
+        v.scope = scope;
+        v.call = call;
+        v.bytes = bytes;
+        v.depth = backtrace(v.frames, kMaxFrames);
+    }
+    if (g_abort_on_violation) {
+        void* frames[kMaxFrames];
+        const int depth = backtrace(frames, kMaxFrames);
+        std::fprintf(stderr, "[RtChecker] %s (%s, %zu bytes) in real-time scope '%s':\n",
+                     kind_name(kind), call, bytes, scope ? scope : "?");
+        backtrace_symbols_fd(frames, depth, STDERR_FILENO);
+        std::abort();
+    }
+}
+
+inline bool checking() {
+    return g_active.load(std::memory_order_relaxed) && rt::in_realtime_context();
+}
+
+template <typename Fn>
+Fn resolve(const char* name, const char* version = nullptr) {
+    void* symbol = nullptr;
+    if (version) {
+        symbol = dlvsym(RTLD_NEXT, name, version);
+    }
+    if (!symbol) {
+        symbol = dlsym(RTLD_NEXT, name);
+    }
+    if (!symbol) {
+        std::fprintf(stderr, "[RtChecker] cannot resolve %s\n", name);
+        std::abort();
+    }
+    return reinterpret_cast<Fn>(symbol);
+}
+
+struct RealFunctions {
+    int (*mutex_lock)(pthread_mutex_t*) = nullptr;
+    int (*mutex_trylock)(pthread_mutex_t*) = nullptr;
+    int (*cond_wait)(pthread_cond_t*, pthread_mutex_t*) = nullptr;
+    int (*cond_timedwait)(pthread_cond_t*, pthread_mutex_t*, const struct timespec*) = nullptr;
+    int (*nanosleep_fn)(const struct timespec*, struct timespec*) = nullptr;
+    int (*clock_nanosleep_fn)(clockid_t, int, const struct timespec*, struct timespec*) = nullptr;
+    int (*usleep_fn)(useconds_t) = nullptr;
+    int (*sched_yield_fn)() = nullptr;
+    int (*poll_fn)(struct pollfd*, nfds_t, int) = nullptr;
+    int (*select_fn)(int, fd_set*, fd_set*, fd_set*, struct timeval*) = nullptr;
+    int (*epoll_wait_fn)(int, struct epoll_event*, int, int) = nullptr;
+    ssize_t (*read_fn)(int, void*, size_t) = nullptr;
+    ssize_t (*write_fn)(int, const void*, size_t) = nullptr;
+    ssize_t (*send_fn)(int, const void*, size_t, int) = nullptr;
+    ssize_t (*sendto_fn)(int, const void*, size_t, int, const struct sockaddr*, socklen_t) = nullptr;
+    ssize_t (*sendmsg_fn)(int, const struct msghdr*, int) = nullptr;
+    ssize_t (*recv_fn)(int, void*, size_t, int) = nullptr;
+    ssize_t (*recvfrom_fn)(int, void*, size_t, int, struct sockaddr*, socklen_t*) = nullptr;
+    int (*open_fn)(const char*, int, ...) = nullptr;
+    FILE* (*fopen_fn)(const char*, const char*) = nullptr;
+};
+
+RealFunctions g_real;
+
+/** @brief Resolves everything up front; runs before main() and before any test thread. */
+__attribute__((constructor)) void install_checker() {
+    Suspend suspend;
+    g_real.mutex_lock = resolve<decltype(g_real.mutex_lock)>("pthread_mutex_lock");
+    g_real.mutex_trylock = resolve<decltype(g_real.mutex_trylock)>("pthread_mutex_trylock");
+    // pthread_cond_* carry an old and a new symbol version; the unversioned lookup finds the old one.
+    g_real.cond_wait = resolve<decltype(g_real.cond_wait)>("pthread_cond_wait", "GLIBC_2.3.2");
+    g_real.cond_timedwait = resolve<decltype(g_real.cond_timedwait)>("pthread_cond_timedwait", "GLIBC_2.3.2");
+    g_real.nanosleep_fn = resolve<decltype(g_real.nanosleep_fn)>("nanosleep");
+    g_real.clock_nanosleep_fn = resolve<decltype(g_real.clock_nanosleep_fn)>("clock_nanosleep");
+    g_real.usleep_fn = resolve<decltype(g_real.usleep_fn)>("usleep");
+    g_real.sched_yield_fn = resolve<decltype(g_real.sched_yield_fn)>("sched_yield");
+    g_real.poll_fn = resolve<decltype(g_real.poll_fn)>("poll");
+    g_real.select_fn = resolve<decltype(g_real.select_fn)>("select");
+    g_real.epoll_wait_fn = resolve<decltype(g_real.epoll_wait_fn)>("epoll_wait");
+    g_real.read_fn = resolve<decltype(g_real.read_fn)>("read");
+    g_real.write_fn = resolve<decltype(g_real.write_fn)>("write");
+    g_real.send_fn = resolve<decltype(g_real.send_fn)>("send");
+    g_real.sendto_fn = resolve<decltype(g_real.sendto_fn)>("sendto");
+    g_real.sendmsg_fn = resolve<decltype(g_real.sendmsg_fn)>("sendmsg");
+    g_real.recv_fn = resolve<decltype(g_real.recv_fn)>("recv");
+    g_real.recvfrom_fn = resolve<decltype(g_real.recvfrom_fn)>("recvfrom");
+    g_real.open_fn = resolve<decltype(g_real.open_fn)>("open");
+    g_real.fopen_fn = resolve<decltype(g_real.fopen_fn)>("fopen");
+
+    // backtrace() loads libgcc_s on first use; do that here rather than inside a scope.
+    void* warm[4];
+    backtrace(warm, 4);
+
+    const char* abort_env = std::getenv("SCREAMROUTER_RT_ABORT");
+    g_abort_on_violation = abort_env && abort_env[0] == '1';
+    g_active.store(true, std::memory_order_release);
+}
+
+std::string demangle_frame(const char* symbol) {
+    // glibc format: "binary(mangled+0x1f) [0xaddr]"
+    std::string text(symbol);
+    const size_t open = text.find('(');
+    const size_t plus = text.find('+', open);
+    if (open == std::string::npos || plus == std::string::npos || plus == open + 1) {
+        return text;
+    }
+    const std::string mangled = text.substr(open + 1, plus - open - 1);
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+    if (status != 0 || !demangled) {
+        return text;
+    }
+    std::string result = demangled;
+    std::free(demangled);
+    return result;
+}
+
+} // namespace
+
+void rt_reset_violations() {
+    g_violation_count.store(0, std::memory_order_relaxed);
+}
+
+uint64_t rt_violation_count() {
+    return g_violation_count.load(std::memory_order_relaxed);
+}
+
+bool rt_checker_active() {
+    return g_active.load(std::memory_order_acquire);
+}
+
+std::vector<RtViolation> rt_take_violations() {
+    const uint64_t total = g_violation_count.exchange(0, std::memory_order_acq_rel);
+    const size_t stored = static_cast<size_t>(std::min<uint64_t>(total, kMaxStoredViolations));
+    std::vector<RtViolation> result;
+    result.reserve(stored);
+    for (size_t i = 0; i < stored; ++i) {
+        const RawViolation& raw = g_violations[i];
+        RtViolation v;
+        v.kind = raw.kind;
+        v.scope = raw.scope ? raw.scope : "";
+        v.call = raw.call ? raw.call : "";
+        v.bytes = raw.bytes;
+        if (raw.depth > kCheckerFrames) {
+            char** symbols = backtrace_symbols(raw.frames + kCheckerFrames, raw.depth - kCheckerFrames);
+            if (symbols) {
+                for (int f = 0; f < raw.depth - kCheckerFrames; ++f) {
+                    v.stack.push_back(demangle_frame(symbols[f]));
+                }
+                std::free(symbols);
+            }
+        }
+        result.push_back(std::move(v));
+    }
+    return result;
+}
+
+std::string rt_format_violations(const std::vector<RtViolation>& violations) {
+    std::map<std::string, std::pair<size_t, const RtViolation*>> distinct;
+    for (const auto& v : violations) {
+        std::string key = v.call + "|" + v.scope;
+        for (const auto& frame : v.stack) {
+            key += "|" + frame;
+        }
+        auto& entry = distinct[key];
+        if (entry.first++ == 0) {
+            entry.second = &v;
+        }
+    }
+
+    std::ostringstream out;
+    out << violations.size() << " real-time violation(s), " << distinct.size() << " distinct:\n";
+    for (const auto& [key, entry] : distinct) {
+        (void)key;
+        const RtViolation& v = *entry.second;
+        out << "  " << entry.first << "x " << kind_name(v.kind) << " via " << v.call;
+        if (v.bytes) {
+            out << " (" << v.bytes << " bytes)";
+        }
+        out << " in scope '" << v.scope << "'\n";
+        const size_t frames = std::min<size_t>(v.stack.size(), 16);
+        for (size_t f = 0; f < frames; ++f) {
+            out << "      #" << f << " " << v.stack[f] << "\n";
+        }
+    }
+    return out.str();
+}
+
+} // namespace testing
+} // namespace audio
+} // namespace screamrouter
+
+using screamrouter::audio::testing::RtViolationKind;
+using screamrouter::audio::testing::checking;
+using screamrouter::audio::testing::g_real;
+using screamrouter::audio::testing::record;
+
+extern "C" {
+
+// --- Heap ---
+
+void* malloc(size_t size) {
+    if (checking()) record(RtViolationKind::ALLOCATION, "malloc", size);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    if (checking()) record(RtViolationKind::ALLOCATION, "calloc", count * size);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    if (checking()) record(RtViolationKind::ALLOCATION, "realloc", size);
+    return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr) {
+    if (ptr && checking()) record(RtViolationKind::DEALLOCATION, "free", 0);
+    __libc_free(ptr);
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) {
+    if (checking()) record(RtViolationKind::ALLOCATION, "posix_memalign", size);
+    void* ptr = __libc_memalign(alignment, size);
+    if (!ptr) {
+        return ENOMEM;
+    }
+    *out = ptr;
+    return 0;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    if (checking()) record(RtViolationKind::ALLOCATION, "aligned_alloc", size);
+    return __libc_memalign(alignment, size);
+}
+
+void* memalign(size_t alignment, size_t size) {
+    if (checking()) record(RtViolationKind::ALLOCATION, "memalign", size);
+    return __libc_memalign(alignment, size);
+}
+
+// --- Locks ---
+
+int pthread_mutex_lock(pthread_mutex_t* mutex) {
+    if (checking()) {
+        // Taking a free lock is cheap and bounded; only waiting for one is a problem.
+        const int rc = g_real.mutex_trylock(mutex);
+        if (rc != EBUSY) {
+            return rc;
+        }
+        record(RtViolationKind::MUTEX_WAIT, "pthread_mutex_lock", 0);
+    }
+    return g_real.mutex_lock(mutex);
+}
+
+int pthread_cond_wait(pthread_cond_t* cond, pthread_mutex_t* mutex) {
+    if (checking()) record(RtViolationKind::CONDITION_WAIT, "pthread_cond_wait", 0);
+    return g_real.cond_wait(cond, mutex);
+}
+
+int pthread_cond_timedwait(pthread_cond_t* cond, pthread_mutex_t* mutex, const struct timespec* abstime) {
+    if (checking()) record(RtViolationKind::CONDITION_WAIT, "pthread_cond_timedwait", 0);
+    return g_real.cond_timedwait(cond, mutex, abstime);
+}
+
+// --- Blocking syscalls ---
+
+int nanosleep(const struct timespec* req, struct timespec* rem) {
+    if (checking()) record(RtViolationKind::SYSCALL, "nanosleep", 0);
+    return g_real.nanosleep_fn(req, rem);
+}
+
+int clock_nanosleep(clockid_t clock, int flags, const struct timespec* req, struct timespec* rem) {
+    if (checking()) record(RtViolationKind::SYSCALL, "clock_nanosleep", 0);
+    return g_real.clock_nanosleep_fn(clock, flags, req, rem);
+}
+
+int usleep(useconds_t usec) {
+    if (checking()) record(RtViolationKind::SYSCALL, "usleep", 0);
+    return g_real.usleep_fn(usec);
+}
+
+int sched_yield() {
+    if (checking()) record(RtViolationKind::SYSCALL, "sched_yield", 0);
+    return g_real.sched_yield_fn();
+}
+
+int poll(struct pollfd* fds, nfds_t nfds, int timeout) {
+    if (checking()) record(RtViolationKind::SYSCALL, "poll", 0);
+    return g_real.poll_fn(fds, nfds, timeout);
+}
+
+int select(int nfds, fd_set* readfds, fd_set* writefds, fd_set* exceptfds, struct timeval* timeout) {
+    if (checking()) record(RtViolationKind::SYSCALL, "select", 0);
+    return g_real.select_fn(nfds, readfds, writefds, exceptfds, timeout);
+}
+
+int epoll_wait(int epfd, struct epoll_event* events, int maxevents, int timeout) {
+    if (checking()) record(RtViolationKind::SYSCALL, "epoll_wait", 0);
+    return g_real.epoll_wait_fn(epfd, events, maxevents, timeout);
+}
+
+ssize_t read(int fd, void* buf, size_t count) {
+    if (checking()) record(RtViolationKind::SYSCALL, "read", count);
+    return g_real.read_fn(fd, buf, count);
+}
+
+ssize_t write(int fd, const void* buf, size_t count) {
+    if (checking()) record(RtViolationKind::SYSCALL, "write", count);
+    return g_real.write_fn(fd, buf, count);
+}
+
+ssize_t send(int fd, const void* buf, size_t len, int flags) {
+    if (checking()) record(RtViolationKind::SYSCALL, "send", len);
+    return g_real.send_fn(fd, buf, len, flags);
+}
+
+ssize_t sendto(int fd, const void* buf, size_t len, int flags, const struct sockaddr* addr, socklen_t addrlen) {
+    if (checking()) record(RtViolationKind::SYSCALL, "sendto", len);
+    return g_real.sendto_fn(fd, buf, len, flags, addr, addrlen);
+}
+
+ssize_t sendmsg(int fd, const struct msghdr* msg, int flags) {
+    if (checking()) record(RtViolationKind::SYSCALL, "sendmsg", 0);
+    return g_real.sendmsg_fn(fd, msg, flags);
+}
+
+ssize_t recv(int fd, void* buf, size_t len, int flags) {
+    if (checking()) record(RtViolationKind::SYSCALL, "recv", len);
+    return g_real.recv_fn(fd, buf, len, flags);
+}
+
+ssize_t recvfrom(int fd, void* buf, size_t len, int flags, struct sockaddr* addr, socklen_t* addrlen) {
+    if (checking()) record(RtViolationKind::SYSCALL, "recvfrom", len);
+    return g_real.recvfrom_fn(fd, buf, len, flags, addr, addrlen);
+}
+
+int open(const char* path, int flags, ...) {
+    mode_t mode = 0;
+    if (flags & (O_CREAT | O_TMPFILE)) {
+        va_list args;
+        va_start(args, flags);
+        mode = static_cast<mode_t>(va_arg(args, int));
+        va_end(args);
+    }
+    if (checking()) record(RtViolationKind::SYSCALL, "open", 0);
+    return g_real.open_fn(path, flags, mode);
+}
+
+FILE* fopen(const char* path, const char* mode) {
+    if (checking()) record(RtViolationKind::SYSCALL, "fopen", 0);
+    return g_real.fopen_fn(path, mode);
+}
+
+} // extern "C"
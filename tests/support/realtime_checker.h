@@ -0,0 +1,76 @@
+/**
+ * @file realtime_checker.h
+ * @brief Test-side half of SR_RT_SCOPE: reports what real-time code did that it should not.
+ * @details Linking realtime_checker.cpp into a test binary interposes malloc/calloc/realloc/
+ *          free, pthread_mutex_lock, pthread_cond_*wait and a set of blocking syscalls
+ *          (sleeps, poll/select, file and socket I/O). Calls made on a thread inside
+ *          SR_RT_SCOPE are recorded with their call stack; everything else passes through.
+ *          An uncontended mutex lock is allowed, so only lock waits are reported.
+ *
+ *          Set SCREAMROUTER_RT_ABORT=1 to abort at the first violation instead, which is
+ *          handy under a debugger.
+ */
+#ifndef SCREAMROUTER_TESTS_REALTIME_CHECKER_H
+#define SCREAMROUTER_TESTS_REALTIME_CHECKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace screamrouter {
+namespace audio {
+namespace testing {
+
+enum class RtViolationKind {
+    ALLOCATION,
+    DEALLOCATION,
+    MUTEX_WAIT,
+    CONDITION_WAIT,
+    SYSCALL,
+};
+
+/** @brief One recorded violation, symbolized. */
+struct RtViolation {
+    RtViolationKind kind = RtViolationKind::ALLOCATION;
+    /** @brief SR_RT_SCOPE name active at the time. */
+    std::string scope;
+    /** @brief Intercepted function, e.g. "malloc" or "nanosleep". */
+    std::string call;
+    /** @brief Allocation size, or 0. */
+    std::size_t bytes = 0;
+    /** @brief One symbolized frame per entry, innermost first, interceptor frames removed. */
+    std::vector<std::string> stack;
+};
+
+/** @brief Discards everything recorded so far, e.g. after warm-up. */
+void rt_reset_violations();
+
+/** @brief Total violations since the last reset, including ones beyond the storage limit. */
+uint64_t rt_violation_count();
+
+/** @brief Returns and symbolizes the stored violations (the first few hundred) and resets. */
+std::vector<RtViolation> rt_take_violations();
+
+/** @brief Human-readable report with one block per distinct call stack. */
+std::string rt_format_violations(const std::vector<RtViolation>& violations);
+
+/** @brief True when the checker is linked in and its interceptors are active. */
+bool rt_checker_active();
+
+} // namespace testing
+} // namespace audio
+} // namespace screamrouter
+
+/**
+ * @brief Fails the current test if real-time code misbehaved since the last reset.
+ * @details Prints every distinct offending stack.
+ */
+#define EXPECT_NO_RT_VIOLATIONS()                                                           \
+    do {                                                                                    \
+        auto sr_rt_violations = ::screamrouter::audio::testing::rt_take_violations();       \
+        EXPECT_TRUE(sr_rt_violations.empty())                                               \
+            << ::screamrouter::audio::testing::rt_format_violations(sr_rt_violations);      \
+    } while (0)
+
+#endif // SCREAMROUTER_TESTS_REALTIME_CHECKER_H
@@ -0,0 +1,136 @@
+/**
+ * @file test_alsa_timer_scheduler.cpp
+ * @brief Unit tests for the device-clocked ALSA mix scheduler.
+ * @details Drives the delay-locked loop with a simulated sound card whose crystal runs off
+ *          nominal and whose hardware pointer only advances in DMA bursts.
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+
+#include "senders/system/alsa_timer_scheduler.h"
+
+using screamrouter::audio::AlsaTimerScheduler;
+
+namespace {
+
+constexpr unsigned int kRate = 48000;
+constexpr int64_t kTickNs = 24000000; // 1152 frames at 48 kHz
+constexpr uint64_t kBurstFrames = 48; // hw pointer granularity
+
+struct Snapshot {
+    int64_t stamp_ns;
+    uint64_t position;
+};
+
+// What snd_pcm_status reports when polled at t_ns from a device running at ratio * kRate: the
+// pointer only advances in DMA bursts and is stamped when the last burst completed.
+Snapshot device_snapshot(double ratio, int64_t t_ns, int64_t stamp_jitter_ns = 0) {
+    const double frames_per_ns = ratio * kRate * 1e-9;
+    const uint64_t position = static_cast<uint64_t>(frames_per_ns * static_cast<double>(t_ns)) / kBurstFrames * kBurstFrames;
+    const int64_t stamp = static_cast<int64_t>(std::llround(static_cast<double>(position) / frames_per_ns));
+    return {stamp + stamp_jitter_ns, position};
+}
+
+} // namespace
+
+TEST(AlsaTimerSchedulerTest, UnprimedSchedulerWakesImmediately) {
+    AlsaTimerScheduler scheduler;
+    scheduler.reset(kRate, 192.0);
+    EXPECT_FALSE(scheduler.primed());
+    EXPECT_EQ(scheduler.next_wakeup_ns(), 0);
+}
+
+TEST(AlsaTimerSchedulerTest, WakesWhenQueueDrainsToTarget) {
+    AlsaTimerScheduler scheduler;
+    scheduler.reset(kRate, 192.0); // 4 ms
+    const int64_t t0 = 5000000000LL;
+    scheduler.observe(t0, 0, 192.0 + 1152.0);
+    ASSERT_TRUE(scheduler.primed());
+
+    EXPECT_EQ(scheduler.next_wakeup_ns(), t0 + kTickNs);
+
+    // A snapshot half way through the tick predicts the same drain instant.
+    scheduler.observe(t0 + kTickNs / 2, 576, 192.0 + 576.0);
+    EXPECT_NEAR(static_cast<double>(scheduler.next_wakeup_ns()), static_cast<double>(t0 + kTickNs), 1000.0);
+}
+
+TEST(AlsaTimerSchedulerTest, UnderfilledQueueWakesAtObservation) {
+    AlsaTimerScheduler scheduler;
+    scheduler.reset(kRate, 192.0);
+    scheduler.observe(1000, 0, 100.0);
+    EXPECT_EQ(scheduler.next_wakeup_ns(), 1000);
+}
+
+TEST(AlsaTimerSchedulerTest, LocksOntoFastDeviceClock) {
+    constexpr double kTrueRatio = 1.0005; // +500 ppm crystal
+    AlsaTimerScheduler scheduler;
+    scheduler.reset(kRate, 192.0);
+
+    Snapshot snap{};
+    for (int64_t t = 0; t <= 60LL * 1000000000LL; t += kTickNs) {
+        snap = device_snapshot(kTrueRatio, t);
+        scheduler.observe(snap.stamp_ns, snap.position, 600.0);
+    }
+    EXPECT_NEAR(scheduler.rate_ratio(), kTrueRatio, 5e-6);
+
+    // The predicted drain time follows the device, not the nominal rate.
+    const double nominal_ns = (600.0 - 192.0) / kRate * 1e9;
+    EXPECT_NEAR(static_cast<double>(scheduler.next_wakeup_ns() - snap.stamp_ns), nominal_ns / kTrueRatio, 100.0);
+}
+
+TEST(AlsaTimerSchedulerTest, LocksOntoSlowDeviceClockWithJitteredWakeups) {
+    constexpr double kTrueRatio = 0.9997;
+    AlsaTimerScheduler scheduler;
+    scheduler.reset(kRate, 192.0);
+
+    int64_t t = 0;
+    for (int i = 0; i < 3000; ++i) {
+        // Wakeups land anywhere within ±3 ms of the nominal tick; timestamps carry ±20 us of noise.
+        t += kTickNs + ((i * 7919) % 6000 - 3000) * 1000LL;
+        const Snapshot snap = device_snapshot(kTrueRatio, t, ((i * 104729) % 40 - 20) * 1000LL);
+        scheduler.observe(snap.stamp_ns, snap.position, 600.0);
+    }
+    EXPECT_NEAR(scheduler.rate_ratio(), kTrueRatio, 20e-6);
+}
+
+TEST(AlsaTimerSchedulerTest, RatioIsClampedForImplausibleDevices) {
+    AlsaTimerScheduler scheduler;
+    scheduler.reset(kRate, 0.0);
+    for (int64_t t = 0; t <= 30LL * 1000000000LL; t += kTickNs) {
+        const Snapshot snap = device_snapshot(1.2, t);
+        scheduler.observe(t, snap.position, 600.0);
+    }
+    EXPECT_LE(scheduler.rate_ratio(), 1.0 + AlsaTimerScheduler::kMaxRatioDeviation + 1e-12);
+}
+
+TEST(AlsaTimerSchedulerTest, ResyncAndLongGapsKeepLearnedRatio) {
+    constexpr double kTrueRatio = 1.0004;
+    AlsaTimerScheduler scheduler;
+    scheduler.reset(kRate, 192.0);
+    int64_t t = 0;
+    for (; t <= 40LL * 1000000000LL; t += kTickNs) {
+        const Snapshot snap = device_snapshot(kTrueRatio, t);
+        scheduler.observe(snap.stamp_ns, snap.position, 600.0);
+    }
+    const double learned = scheduler.rate_ratio();
+    ASSERT_NEAR(learned, kTrueRatio, 5e-6);
+
+    // An x-run restarts the position count; the loop re-anchors instead of seeing a huge error.
+    scheduler.resync();
+    EXPECT_FALSE(scheduler.primed());
+    const Snapshot restart = device_snapshot(kTrueRatio, kTickNs);
+    scheduler.observe(t, 0, 600.0);
+    scheduler.observe(t + restart.stamp_ns, restart.position, 600.0);
+    EXPECT_NEAR(scheduler.rate_ratio(), learned, 5e-6);
+
+    // A stalled mixer (no observations for seconds) re-anchors the same way.
+    const int64_t later = t + 5LL * 1000000000LL;
+    scheduler.observe(later, 123456789, 600.0);
+    EXPECT_NEAR(scheduler.rate_ratio(), learned, 5e-6);
+
+    // reset() is for a new stream and forgets the ratio.
+    scheduler.reset(kRate, 192.0);
+    EXPECT_DOUBLE_EQ(scheduler.rate_ratio(), 1.0);
+}
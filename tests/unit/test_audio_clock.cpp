@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include "utils/audio_clock.h"
+
+using namespace screamrouter::audio::utils;
+using namespace std::chrono;
+
+TEST(AudioClockTest, UsesSteadyClockByDefault) {
+    ASSERT_FALSE(AudioClock::is_virtual());
+    auto before = steady_clock::now();
+    auto now = AudioClock::now();
+    auto after = steady_clock::now();
+    EXPECT_GE(now, before);
+    EXPECT_LE(now, after);
+}
+
+TEST(AudioClockTest, VirtualClockOnlyMovesWhenAdvanced) {
+    VirtualClock clock;
+    auto t0 = clock.now();
+    std::this_thread::sleep_for(milliseconds(2));
+    EXPECT_EQ(clock.now(), t0);
+
+    clock.advance(milliseconds(5));
+    EXPECT_EQ(clock.now() - t0, milliseconds(5));
+
+    clock.advance(milliseconds(-3));
+    EXPECT_EQ(clock.now() - t0, milliseconds(5));
+}
+
+TEST(AudioClockTest, AdvanceToNeverGoesBackwards) {
+    VirtualClock clock;
+    auto t0 = clock.now();
+    clock.advance_to(t0 + seconds(2));
+    EXPECT_EQ(clock.now(), t0 + seconds(2));
+    clock.advance_to(t0 + seconds(1));
+    EXPECT_EQ(clock.now(), t0 + seconds(2));
+}
+
+TEST(AudioClockTest, DefaultStartIsNotZeroTimePoint) {
+    VirtualClock clock;
+    EXPECT_GT(clock.now(), steady_clock::time_point{});
+}
+
+TEST(AudioClockTest, ScopedInstallRoutesNowToVirtualClock) {
+    VirtualClock clock(steady_clock::time_point{} + hours(5));
+    {
+        ScopedVirtualClock scope(clock);
+        EXPECT_TRUE(AudioClock::is_virtual());
+        EXPECT_EQ(AudioClock::now(), clock.now());
+        clock.advance(microseconds(250));
+        EXPECT_EQ(AudioClock::now(), clock.now());
+    }
+    EXPECT_FALSE(AudioClock::is_virtual());
+    EXPECT_NE(AudioClock::now(), clock.now());
+}
@@ -0,0 +1,139 @@
+/**
+ * @file test_control_api_manager.cpp
+ * @brief Unit tests for ControlApiManager's plugin packet injection.
+ * @details Packets are observed through TimeshiftManager's ingress hook under a VirtualClock,
+ *          so RTP timestamps and receive times can be checked exactly.
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "managers/control_api_manager.h"
+#include "input_processor/timeshift_manager.h"
+#include "input_processor/source_input_processor.h"
+#include "configuration/audio_engine_settings.h"
+#include "utils/audio_clock.h"
+
+// Sentinel logging stub
+namespace screamrouter::audio::utils {
+    void log_sentinel(const char*, const screamrouter::audio::TaggedAudioPacket&, const std::string&) {}
+    void log_sentinel(const char*, const screamrouter::audio::ProcessedAudioChunk&, const std::string&) {}
+}
+
+using namespace screamrouter::audio;
+using namespace std::chrono;
+
+namespace {
+
+constexpr int kChannels = 2;
+constexpr int kSampleRate = 48000;
+constexpr int kBitDepth = 16;
+constexpr size_t kFrameBytes = kChannels * (kBitDepth / 8);
+
+struct SeenPacket {
+    uint32_t rtp_timestamp = 0;
+    steady_clock::time_point received_time{};
+    size_t bytes = 0;
+};
+
+class ControlApiManagerPluginTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        settings = std::make_shared<AudioEngineSettings>();
+        timeshift = std::make_unique<TimeshiftManager>(seconds(10), settings);
+        timeshift->set_ingress_hook([this](const TaggedAudioPacket& packet) {
+            SeenPacket seen;
+            seen.rtp_timestamp = packet.rtp_timestamp.value_or(0);
+            seen.received_time = packet.received_time;
+            seen.bytes = packet.audio_data.size();
+            packets.push_back(seen);
+        });
+
+        SourceProcessorConfig config;
+        config.instance_id = "plugin-instance";
+        config.source_tag = "plugin-source";
+        config.output_channels = kChannels;
+        config.output_samplerate = kSampleRate;
+        sources[config.instance_id] = std::make_unique<SourceInputProcessor>(config, settings);
+
+        api = std::make_unique<ControlApiManager>(manager_mutex, timeshift.get(), sources, nullptr);
+    }
+
+    std::vector<uint8_t> payload(size_t frames) const { return std::vector<uint8_t>(frames * kFrameBytes, 0); }
+
+    std::shared_ptr<AudioEngineSettings> settings;
+    std::unique_ptr<TimeshiftManager> timeshift;
+    std::recursive_mutex manager_mutex;
+    std::map<std::string, std::unique_ptr<SourceInputProcessor>> sources;
+    std::unique_ptr<ControlApiManager> api;
+    std::vector<SeenPacket> packets;
+};
+
+} // namespace
+
+TEST_F(ControlApiManagerPluginTest, SinglePacketAdvancesRtpAndStampsNow) {
+    utils::VirtualClock clock;
+    utils::ScopedVirtualClock scoped_clock(clock);
+
+    ASSERT_TRUE(api->write_plugin_packet("plugin-source", payload(480), kChannels, kSampleRate, kBitDepth,
+                                         0x03, 0x00, true));
+    clock.advance(milliseconds(10));
+    ASSERT_TRUE(api->write_plugin_packet("plugin-source", payload(240), kChannels, kSampleRate, kBitDepth,
+                                         0x03, 0x00, true));
+
+    ASSERT_EQ(packets.size(), 2u);
+    EXPECT_EQ(packets[0].rtp_timestamp, 480u);
+    EXPECT_EQ(packets[1].rtp_timestamp, 720u);
+    EXPECT_EQ(packets[1].received_time - packets[0].received_time, milliseconds(10));
+    EXPECT_EQ(packets[1].received_time, utils::AudioClock::now());
+    EXPECT_EQ(packets[1].bytes, 240u * kFrameBytes);
+}
+
+TEST_F(ControlApiManagerPluginTest, BatchAdvancesRtpPerPacketAndSpacesReceiveTimes) {
+    utils::VirtualClock clock;
+    utils::ScopedVirtualClock scoped_clock(clock);
+
+    ASSERT_TRUE(api->write_plugin_packet("plugin-source", payload(100), kChannels, kSampleRate, kBitDepth,
+                                         0x03, 0x00, true));
+
+    // 480, 960 and 240 frames: 10 ms, 20 ms and 5 ms of audio at 48 kHz.
+    std::vector<std::vector<uint8_t>> batch;
+    batch.push_back(payload(480));
+    batch.push_back(payload(960));
+    batch.push_back(payload(240));
+    const auto call_time = utils::AudioClock::now();
+    ASSERT_EQ(api->write_plugin_packets("plugin-source", std::move(batch), kChannels, kSampleRate, kBitDepth,
+                                        0x03, 0x00, true),
+              3u);
+
+    ASSERT_EQ(packets.size(), 4u);
+    EXPECT_EQ(packets[1].rtp_timestamp, 100u + 480u);
+    EXPECT_EQ(packets[2].rtp_timestamp, 100u + 480u + 960u);
+    EXPECT_EQ(packets[3].rtp_timestamp, 100u + 480u + 960u + 240u);
+
+    // Each packet is stamped when its last frame would have arrived; the last one at the call.
+    EXPECT_EQ(packets[3].received_time, call_time);
+    EXPECT_EQ(duration_cast<microseconds>(packets[3].received_time - packets[2].received_time), milliseconds(5));
+    EXPECT_EQ(duration_cast<microseconds>(packets[2].received_time - packets[1].received_time), milliseconds(20));
+
+    // The counter continues from the end of the batch.
+    ASSERT_TRUE(api->write_plugin_packet("plugin-source", payload(10), kChannels, kSampleRate, kBitDepth,
+                                         0x03, 0x00, true));
+    EXPECT_EQ(packets.back().rtp_timestamp, 100u + 480u + 960u + 240u + 10u);
+}
+
+TEST_F(ControlApiManagerPluginTest, UnknownTagOrStoppedEngineInjectsNothing) {
+    EXPECT_FALSE(api->write_plugin_packet("other-source", payload(480), kChannels, kSampleRate, kBitDepth,
+                                          0x03, 0x00, true));
+    std::vector<std::vector<uint8_t>> batch;
+    batch.push_back(payload(480));
+    EXPECT_EQ(api->write_plugin_packets("plugin-source", std::move(batch), kChannels, kSampleRate, kBitDepth,
+                                        0x03, 0x00, false),
+              0u);
+    EXPECT_TRUE(packets.empty());
+}
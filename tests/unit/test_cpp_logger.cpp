@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include "utils/cpp_logger.h"
+
+using screamrouter::audio::logging::LogEntry;
+using screamrouter::audio::logging::LogLevel;
+using screamrouter::audio::logging::retrieve_log_entries;
+
+namespace {
+
+// Drains everything queued so far and keeps the entries whose message contains @p marker.
+std::vector<LogEntry> drain_matching(const std::string& marker) {
+    std::vector<LogEntry> matching;
+    while (true) {
+        auto batch = retrieve_log_entries(20);
+        if (batch.empty()) {
+            break;
+        }
+        for (auto& entry : batch) {
+            if (entry.message.find(marker) != std::string::npos) {
+                matching.push_back(std::move(entry));
+            }
+        }
+    }
+    return matching;
+}
+
+std::string format_one(const std::string& marker) {
+    auto entries = drain_matching(marker);
+    return entries.size() == 1 ? entries[0].message : "<" + std::to_string(entries.size()) + " entries>";
+}
+
+} // namespace
+
+TEST(CppLoggerTest, FormatsDeferredArguments) {
+    drain_matching("");
+    LOG_CPP_INFO("[fmt1] int=%d unsigned=%u hex=%08x str=%s", -42, 7u, 0xbeefu, "hello");
+    EXPECT_EQ(format_one("[fmt1]"), "[fmt1] int=-42 unsigned=7 hex=0000beef str=hello");
+
+    const uint64_t big = 1ull << 40;
+    LOG_CPP_INFO("[fmt2] %llu %lld %zu %.3f %5.1f|%-4d|%c", static_cast<unsigned long long>(big),
+                 static_cast<long long>(-5), static_cast<size_t>(9), 3.14159, 2.25f, 3, 'x');
+    EXPECT_EQ(format_one("[fmt2]"), "[fmt2] 1099511627776 -5 9 3.142   2.2|3   |x");
+
+    LOG_CPP_INFO("[fmt3] %u %x 100%% %*d", -1, -1, 4, 12);
+    EXPECT_EQ(format_one("[fmt3]"), "[fmt3] 4294967295 ffffffff 100%   12");
+}
+
+TEST(CppLoggerTest, CopiesStringArgumentsAtLogTime) {
+    drain_matching("");
+    {
+        std::string transient = "temporary-value";
+        LOG_CPP_WARNING("[str1] %s / %s", transient.c_str(), transient);
+        transient.assign(transient.size(), 'X');
+    }
+
+    auto entries = drain_matching("[str1]");
+    ASSERT_EQ(entries.size(), 1u);
+    EXPECT_EQ(entries[0].message, "[str1] temporary-value / temporary-value");
+    EXPECT_EQ(entries[0].level, LogLevel::WARNING);
+    EXPECT_EQ(entries[0].filename, "test_cpp_logger.cpp");
+    EXPECT_GT(entries[0].line_number, 0);
+
+    const char* null_str = nullptr;
+    LOG_CPP_INFO("[str2] %s", null_str);
+    EXPECT_EQ(format_one("[str2]"), "[str2] (null)");
+
+    // Char arrays are copied like pointers (and never null-checked).
+    char buffer[16] = "on-stack";
+    LOG_CPP_INFO("[str3] %s %s", buffer, "literal");
+    EXPECT_EQ(format_one("[str3]"), "[str3] on-stack literal");
+}
+
+TEST(CppLoggerTest, NonLiteralFormatIsCopied) {
+    drain_matching("");
+    {
+        std::string format = "[dyn] value=%d";
+        LOG_CPP_INFO(format.c_str(), 5);
+        format.assign(format.size(), '?');
+    }
+    EXPECT_EQ(format_one("[dyn]"), "[dyn] value=5");
+}
+
+TEST(CppLoggerTest, MissingArgumentsKeepSpecText) {
+    drain_matching("");
+    LOG_CPP_INFO("[missing] %d %s", 1);
+    EXPECT_EQ(format_one("[missing]"), "[missing] 1 %s");
+}
+
+TEST(CppLoggerTest, EntriesFromManyThreadsArriveInOrder) {
+    drain_matching("");
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 200;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                LOG_CPP_DEBUG("[mt] thread=%d seq=%d", t, i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto entries = drain_matching("[mt]");
+    ASSERT_EQ(entries.size(), static_cast<size_t>(kThreads * kPerThread));
+    std::vector<int> next_seq(kThreads, 0);
+    for (const auto& entry : entries) {
+        int thread = -1;
+        int seq = -1;
+        ASSERT_EQ(std::sscanf(entry.message.c_str(), "[mt] thread=%d seq=%d", &thread, &seq), 2);
+        ASSERT_GE(thread, 0);
+        ASSERT_LT(thread, kThreads);
+        EXPECT_EQ(seq, next_seq[thread]++);
+    }
+}
+
+TEST(CppLoggerTest, FullRingDropsInsteadOfBlocking) {
+    drain_matching("");
+    const std::string payload(900, 'p');
+    std::thread producer([&payload] {
+        // Far more than one thread ring holds; the producer must never wait for the drainer.
+        for (int i = 0; i < 500; ++i) {
+            LOG_CPP_WARNING("[burst] %d %s", i, payload);
+        }
+    });
+    producer.join();
+
+    auto all = drain_matching("");
+    size_t burst = 0;
+    bool reported_drop = false;
+    for (const auto& entry : all) {
+        if (entry.message.find("[burst]") != std::string::npos) {
+            ++burst;
+        }
+        if (entry.message.find("dropped") != std::string::npos) {
+            reported_drop = true;
+        }
+    }
+    EXPECT_GT(burst, 0u);
+    EXPECT_LT(burst, 500u);
+    EXPECT_TRUE(reported_drop);
+}
@@ -3,14 +3,6 @@
 #include <thread>
 #include "synchronization/global_synchronization_clock.h"
 
-// Mock logging
-namespace screamrouter::audio::logging {
-    enum class LogLevel { DEBUG, INFO, WARNING, ERR };
-    std::atomic<LogLevel> current_log_level{LogLevel::INFO};
-    void log_message(LogLevel, const char*, int, const char*, ...) {}
-    const char* get_base_filename(const char* path) { return path; }
-}
-
 using namespace screamrouter::audio;
 using namespace std::chrono;
 
@@ -0,0 +1,248 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include "utils/mpsc_queue.h"
+
+using screamrouter::audio::utils::MpscQueue;
+
+class MpscQueueTest : public ::testing::Test {
+protected:
+    MpscQueue<int> queue{16};
+};
+
+TEST_F(MpscQueueTest, InitiallyEmpty) {
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.size(), 0u);
+    EXPECT_EQ(queue.capacity(), 16u);
+}
+
+TEST_F(MpscQueueTest, CapacityRoundsUpToPowerOfTwo) {
+    MpscQueue<int> odd(100);
+    EXPECT_EQ(odd.capacity(), 128u);
+}
+
+TEST_F(MpscQueueTest, PushAndPop) {
+    queue.push(42);
+    EXPECT_FALSE(queue.empty());
+    EXPECT_EQ(queue.size(), 1u);
+
+    int value = 0;
+    bool success = queue.try_pop(value);
+    EXPECT_TRUE(success);
+    EXPECT_EQ(value, 42);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(MpscQueueTest, TryPopEmpty) {
+    int value = -1;
+    bool success = queue.try_pop(value);
+    EXPECT_FALSE(success);
+    EXPECT_EQ(value, -1);  // Unchanged
+}
+
+TEST_F(MpscQueueTest, FIFOOrderAcrossWraparound) {
+    int value;
+    for (int round = 0; round < 5; ++round) {
+        for (int i = 0; i < 10; ++i) {
+            queue.push(round * 10 + i);
+        }
+        for (int i = 0; i < 10; ++i) {
+            ASSERT_TRUE(queue.try_pop(value));
+            EXPECT_EQ(value, round * 10 + i);
+        }
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(MpscQueueTest, PushAtCapacityDropsOldest) {
+    for (int i = 0; i < 20; ++i) {
+        queue.push(i);
+    }
+    EXPECT_EQ(queue.size(), 16u);
+    int value;
+    ASSERT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 4);
+}
+
+TEST_F(MpscQueueTest, BlockingPopWakesOnPush) {
+    std::atomic<int> received{-1};
+    std::thread consumer([this, &received]() {
+        int value;
+        if (queue.pop(value)) {
+            received = value;
+        }
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(received, -1);  // Still parked
+    queue.push(7);
+    consumer.join();
+    EXPECT_EQ(received, 7);
+}
+
+TEST_F(MpscQueueTest, StopUnblocksBlockingPop) {
+    std::atomic<bool> popped{false};
+    std::atomic<bool> returned{false};
+
+    std::thread consumer([this, &popped, &returned]() {
+        int value;
+        bool success = queue.pop(value);  // Blocking
+        popped = success;
+        returned = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(returned);  // Should still be blocked
+
+    queue.stop();
+    consumer.join();
+
+    EXPECT_TRUE(returned);
+    EXPECT_FALSE(popped);  // Queue was empty when stopped
+    EXPECT_TRUE(queue.is_stopped());
+}
+
+TEST_F(MpscQueueTest, PushBoundedDropOldest) {
+    using PushResult = MpscQueue<int>::PushResult;
+
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+
+    auto result = queue.push_bounded(4, 3, true);
+    EXPECT_EQ(result, PushResult::DroppedOldest);
+    EXPECT_EQ(queue.size(), 3u);
+
+    int value;
+    queue.try_pop(value);
+    EXPECT_EQ(value, 2);  // Not 1
+}
+
+TEST_F(MpscQueueTest, PushBoundedQueueFull) {
+    using PushResult = MpscQueue<int>::PushResult;
+
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+
+    auto result = queue.push_bounded(4, 3, false);
+    EXPECT_EQ(result, PushResult::QueueFull);
+    EXPECT_EQ(queue.size(), 3u);  // Unchanged
+}
+
+TEST_F(MpscQueueTest, PushBoundedNormal) {
+    using PushResult = MpscQueue<int>::PushResult;
+
+    queue.push(1);
+
+    auto result = queue.push_bounded(2, 3, false);
+    EXPECT_EQ(result, PushResult::Pushed);
+    EXPECT_EQ(queue.size(), 2u);
+}
+
+TEST_F(MpscQueueTest, PushAfterStop) {
+    using PushResult = MpscQueue<int>::PushResult;
+    queue.stop();
+    queue.push(42);  // Should not crash, just ignored
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.push_bounded(43, 0, false), PushResult::QueueStopped);
+}
+
+TEST_F(MpscQueueTest, TryPopBulk) {
+    for (int i = 0; i < 10; ++i) {
+        queue.push(i);
+    }
+    std::vector<int> out;
+    EXPECT_EQ(queue.try_pop_bulk(std::back_inserter(out), 4), 4u);
+    EXPECT_EQ(queue.try_pop_bulk(std::back_inserter(out), 100), 6u);
+    ASSERT_EQ(out.size(), 10u);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(out[i], i);
+    }
+}
+
+// Every producer's items must arrive exactly once and in that producer's order.
+TEST_F(MpscQueueTest, ManyProducersBlockingConsumer) {
+    constexpr int kProducers = 8;
+    constexpr int kPerProducer = 5000;
+    MpscQueue<int> shared(64);
+
+    std::vector<int> next_expected(kProducers, 0);
+    std::atomic<bool> order_ok{true};
+    std::thread consumer([&]() {
+        int value;
+        for (int received = 0; received < kProducers * kPerProducer; ++received) {
+            ASSERT_TRUE(shared.pop(value));
+            const int producer = value / kPerProducer;
+            if (value % kPerProducer != next_expected[producer]) {
+                order_ok = false;
+            }
+            next_expected[producer] = value % kPerProducer + 1;
+        }
+    });
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&shared, p]() {
+            for (int i = 0; i < kPerProducer; ++i) {
+                // Back off instead of evicting so nothing is lost.
+                while (shared.push_bounded(p * kPerProducer + i, 0, false) !=
+                       MpscQueue<int>::PushResult::Pushed) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : producers) {
+        t.join();
+    }
+    consumer.join();
+
+    EXPECT_TRUE(order_ok);
+    for (int p = 0; p < kProducers; ++p) {
+        EXPECT_EQ(next_expected[p], kPerProducer);
+    }
+    EXPECT_TRUE(shared.empty());
+}
+
+TEST_F(MpscQueueTest, ConcurrentDropOldestKeepsQueueBounded) {
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 10000;
+    std::atomic<bool> done{false};
+    std::atomic<int> consumed{0};
+
+    std::thread consumer([&]() {
+        int value;
+        while (!done.load() || !queue.empty()) {
+            if (queue.try_pop(value)) {
+                ++consumed;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::atomic<int> dropped{0};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&]() {
+            for (int i = 0; i < kPerProducer; ++i) {
+                if (queue.push_bounded(i, 8, true) == MpscQueue<int>::PushResult::DroppedOldest) {
+                    ++dropped;
+                }
+                EXPECT_LE(queue.size(), queue.capacity());
+            }
+        });
+    }
+    for (auto& t : producers) {
+        t.join();
+    }
+    done = true;
+    consumer.join();
+
+    // A push that loses a race for the freed slot may evict more than one item but reports
+    // DroppedOldest once, so the drop count is a lower bound.
+    EXPECT_GT(consumed.load(), 0);
+    EXPECT_LE(consumed.load() + dropped.load(), kProducers * kPerProducer);
+}
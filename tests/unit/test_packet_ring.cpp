@@ -1,4 +1,10 @@
 #include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
 #include "utils/packet_ring.h"
 
 using screamrouter::audio::utils::PacketRing;
@@ -33,47 +39,187 @@ TEST_F(PacketRingTest, PopEmpty) {
     EXPECT_EQ(value, -1);  // Unchanged
 }
 
-TEST_F(PacketRingTest, DropOldestOnOverflow) {
-    // Fill to capacity-1 (ring uses one slot as sentinel)
+TEST_F(PacketRingTest, HoldsFullCapacity) {
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.push(i));
+    }
+    EXPECT_EQ(ring.size(), 4u);
+    EXPECT_EQ(ring.drop_count(), 0u);
+}
+
+TEST_F(PacketRingTest, OverflowRejectsNewestAndKeepsQueuedItems) {
     ring.push(1);
     ring.push(2);
     ring.push(3);
-    EXPECT_EQ(ring.size(), 3u);
-    EXPECT_EQ(ring.drop_count(), 0u);
-    
-    // This should cause overflow and drop oldest
     ring.push(4);
-    EXPECT_EQ(ring.size(), 3u);  // Still 3 (capacity-1)
+
+    // The producer must not reclaim a slot the consumer may be reading.
+    EXPECT_FALSE(ring.push(5));
+    EXPECT_EQ(ring.size(), 4u);
     EXPECT_EQ(ring.drop_count(), 1u);
-    
-    // Verify oldest (1) was dropped
+
     int value;
-    ring.pop(value);
-    EXPECT_EQ(value, 2);  // Not 1
-    ring.pop(value);
-    EXPECT_EQ(value, 3);
-    ring.pop(value);
-    EXPECT_EQ(value, 4);
+    for (int expected = 1; expected <= 4; ++expected) {
+        ASSERT_TRUE(ring.pop(value));
+        EXPECT_EQ(value, expected);
+    }
+    EXPECT_FALSE(ring.pop(value));
 }
 
 TEST_F(PacketRingTest, MultipleOverflows) {
-    // Push more items than capacity
     for (int i = 0; i < 10; ++i) {
         ring.push(i);
     }
-    
-    // Should have dropped 7 items (10 pushed, capacity-1 = 3 remain)
-    EXPECT_EQ(ring.drop_count(), 7u);
-    EXPECT_EQ(ring.size(), 3u);
-    
-    // Remaining items should be the last 3 pushed
+
+    EXPECT_EQ(ring.drop_count(), 6u);
+    EXPECT_EQ(ring.size(), 4u);
+
+    int value;
+    for (int expected = 0; expected < 4; ++expected) {
+        ring.pop(value);
+        EXPECT_EQ(value, expected);
+    }
+}
+
+TEST_F(PacketRingTest, OverflowIsReportedToConsumerOnce) {
+    for (int i = 0; i < 7; ++i) {
+        ring.push(i);
+    }
+    EXPECT_EQ(ring.take_overflow(), 3u);
+    EXPECT_EQ(ring.take_overflow(), 0u);
+
     int value;
     ring.pop(value);
-    EXPECT_EQ(value, 7);
-    ring.pop(value);
-    EXPECT_EQ(value, 8);
+    ring.push(100);
+    ring.push(101);
+    EXPECT_EQ(ring.take_overflow(), 1u);
+    EXPECT_EQ(ring.drop_count(), 4u);
+}
+
+TEST_F(PacketRingTest, WrapsAroundManyTimes) {
+    int value;
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(ring.push(i));
+        ASSERT_TRUE(ring.push(i + 1));
+        ASSERT_TRUE(ring.pop(value));
+        EXPECT_EQ(value, i);
+        ASSERT_TRUE(ring.pop(value));
+        EXPECT_EQ(value, i + 1);
+    }
+    EXPECT_EQ(ring.size(), 0u);
+}
+
+TEST(PacketRingCapacityTest, NonPowerOfTwoCapacityIsExact) {
+    PacketRing<int> ring{3};
+    EXPECT_EQ(ring.capacity(), 3u);
+    EXPECT_TRUE(ring.push(1));
+    EXPECT_TRUE(ring.push(2));
+    EXPECT_TRUE(ring.push(3));
+    EXPECT_FALSE(ring.push(4));
+    EXPECT_EQ(ring.size(), 3u);
+}
+
+TEST_F(PacketRingTest, PushBulkAcceptsWhatFits) {
+    std::vector<int> items = {1, 2, 3, 4, 5, 6};
+    EXPECT_EQ(ring.push_bulk(items.begin(), items.end()), 4u);
+    EXPECT_EQ(ring.drop_count(), 2u);
+    EXPECT_EQ(ring.size(), 4u);
+
+    int value;
     ring.pop(value);
-    EXPECT_EQ(value, 9);
+    EXPECT_EQ(value, 1);
+}
+
+TEST_F(PacketRingTest, PopBulkDrainsInOrder) {
+    ring.push(10);
+    ring.push(20);
+    ring.push(30);
+
+    std::vector<int> out;
+    EXPECT_EQ(ring.pop_bulk(std::back_inserter(out), 2), 2u);
+    EXPECT_EQ(out, (std::vector<int>{10, 20}));
+    EXPECT_EQ(ring.pop_bulk(std::back_inserter(out), 8), 1u);
+    EXPECT_EQ(out, (std::vector<int>{10, 20, 30}));
+    EXPECT_EQ(ring.pop_bulk(std::back_inserter(out), 8), 0u);
+}
+
+TEST_F(PacketRingTest, BulkOperationsWrapAround) {
+    int scratch[4];
+    for (int round = 0; round < 50; ++round) {
+        std::vector<int> items = {round * 3, round * 3 + 1, round * 3 + 2};
+        ASSERT_EQ(ring.push_bulk(items.begin(), items.end()), 3u);
+        ASSERT_EQ(ring.pop_bulk(scratch, 4), 3u);
+        EXPECT_EQ(scratch[0], round * 3);
+        EXPECT_EQ(scratch[2], round * 3 + 2);
+    }
+}
+
+// One producer and one consumer hammer the ring; every accepted item must arrive exactly once
+// and in order, and accepted + dropped must equal attempted. Run under TSAN to check the
+// memory ordering (cmake -DCMAKE_CXX_FLAGS=-fsanitize=thread).
+TEST(PacketRingStressTest, SpscOrderingUnderContention) {
+    constexpr uint64_t kItems = 200000;
+    PacketRing<uint64_t> ring{64};
+    std::atomic<bool> producer_done{false};
+    uint64_t accepted = 0;
+
+    std::thread producer([&] {
+        uint64_t batch[5];
+        uint64_t next = 0;
+        while (next < kItems) {
+            if ((next & 7) == 0 && kItems - next >= 5) {
+                for (uint64_t& item : batch) {
+                    item = next++;
+                }
+                accepted += ring.push_bulk(std::begin(batch), std::end(batch));
+            } else if (ring.push(next++)) {
+                ++accepted;
+            }
+            if ((next & 255) == 0) {
+                std::this_thread::yield();
+            }
+        }
+        producer_done.store(true, std::memory_order_release);
+    });
+
+    uint64_t received = 0;
+    uint64_t last = 0;
+    bool ordered = true;
+    std::vector<uint64_t> bulk;
+    bulk.reserve(16);
+    for (;;) {
+        const bool done = producer_done.load(std::memory_order_acquire);
+        bulk.clear();
+        size_t got = 0;
+        if (received & 1) {
+            got = ring.pop_bulk(std::back_inserter(bulk), 16);
+        } else {
+            uint64_t single = 0;
+            if (ring.pop(single)) {
+                bulk.push_back(single);
+                got = 1;
+            }
+        }
+        for (uint64_t value : bulk) {
+            if (received > 0 && value <= last) {
+                ordered = false;
+            }
+            last = value;
+            ++received;
+        }
+        if (got == 0) {
+            if (done && ring.size() == 0) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(received, accepted);
+    EXPECT_EQ(accepted + ring.drop_count(), kItems);
+    EXPECT_EQ(ring.take_overflow(), ring.drop_count());
 }
 
 TEST_F(PacketRingTest, MoveSemantics) {
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "receivers/replay/pcap_reader.h"
+
+using namespace screamrouter::audio;
+
+namespace {
+
+// --- Little capture writer used to build fixtures ---
+struct Bytes {
+    std::vector<uint8_t> data;
+    bool big_endian = false;
+
+    void u8(uint8_t v) { data.push_back(v); }
+    void u16(uint16_t v) {
+        if (big_endian) { u8(v >> 8); u8(v & 0xFF); } else { u8(v & 0xFF); u8(v >> 8); }
+    }
+    void u32(uint32_t v) {
+        if (big_endian) { u16(v >> 16); u16(v & 0xFFFF); } else { u16(v & 0xFFFF); u16(v >> 16); }
+    }
+    void be16(uint16_t v) { u8(v >> 8); u8(v & 0xFF); }
+    void append(const std::vector<uint8_t>& other) { data.insert(data.end(), other.begin(), other.end()); }
+    void pad4() { while (data.size() % 4) u8(0); }
+};
+
+std::vector<uint8_t> ipv4_udp(uint16_t src_port, uint16_t dst_port, const std::vector<uint8_t>& payload,
+                              uint8_t protocol = 17, uint16_t fragment = 0) {
+    Bytes b;
+    const uint16_t total = static_cast<uint16_t>(20 + 8 + payload.size());
+    b.u8(0x45); b.u8(0); b.be16(total); b.be16(1); b.be16(fragment); b.u8(64); b.u8(protocol); b.be16(0);
+    b.u8(10); b.u8(0); b.u8(0); b.u8(7);   // 10.0.0.7
+    b.u8(10); b.u8(0); b.u8(0); b.u8(1);   // 10.0.0.1
+    b.be16(src_port); b.be16(dst_port); b.be16(static_cast<uint16_t>(8 + payload.size())); b.be16(0);
+    b.append(payload);
+    return b.data;
+}
+
+std::vector<uint8_t> ethernet(const std::vector<uint8_t>& ip, bool vlan) {
+    Bytes b;
+    for (int i = 0; i < 12; ++i) b.u8(0);
+    if (vlan) { b.be16(0x8100); b.be16(42); }
+    b.be16(0x0800);
+    b.append(ip);
+    return b.data;
+}
+
+std::string write_temp(const std::string& name, const std::vector<uint8_t>& bytes) {
+    std::string path = ::testing::TempDir() + name;
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return path;
+}
+
+void pcapng_block(Bytes& file, uint32_t type, const std::vector<uint8_t>& body) {
+    const uint32_t total = static_cast<uint32_t>(12 + ((body.size() + 3) & ~size_t(3)));
+    file.u32(type); file.u32(total);
+    file.append(body); file.pad4();
+    file.u32(total);
+}
+
+} // namespace
+
+TEST(PcapReaderTest, ReadsBundledRtpCapture) {
+    PcapReader reader(SCREAMROUTER_REPO_ROOT "/rtp.pcap");
+    EXPECT_FALSE(reader.is_pcapng());
+
+    PcapUdpDatagram datagram;
+    size_t count = 0;
+    std::chrono::nanoseconds previous{0};
+    std::chrono::nanoseconds first{0};
+    while (reader.next(datagram)) {
+        if (count == 0) {
+            first = datagram.timestamp;
+            EXPECT_EQ(datagram.destination_port, 40000);
+            EXPECT_EQ(datagram.payload.size(), 1472u);
+            EXPECT_EQ(datagram.payload[0] & 0xC0, 0x80);  // RTP version 2
+        }
+        EXPECT_GE(datagram.timestamp, previous);
+        previous = datagram.timestamp;
+        ++count;
+    }
+    EXPECT_EQ(count, 399u);
+    EXPECT_EQ(reader.records_skipped(), 0u);
+
+    reader.rewind();
+    ASSERT_TRUE(reader.next(datagram));
+    EXPECT_EQ(datagram.timestamp, first);
+}
+
+TEST(PcapReaderTest, ReadsBigEndianNanosecondPcapWithRawIp) {
+    Bytes file;
+    file.big_endian = true;
+    file.u32(0xA1B23C4D); file.u16(2); file.u16(4); file.u32(0); file.u32(0); file.u32(65535);
+    file.u32(101);  // LINKTYPE_RAW
+    const auto frame = ipv4_udp(5004, 4010, {1, 2, 3});
+    file.u32(10); file.u32(123); file.u32(static_cast<uint32_t>(frame.size())); file.u32(static_cast<uint32_t>(frame.size()));
+    file.append(frame);
+
+    PcapReader reader(write_temp("be_ns.pcap", file.data));
+    PcapUdpDatagram datagram;
+    ASSERT_TRUE(reader.next(datagram));
+    EXPECT_EQ(datagram.timestamp, std::chrono::seconds(10) + std::chrono::nanoseconds(123));
+    EXPECT_EQ(datagram.source_port, 5004);
+    EXPECT_EQ(datagram.destination_port, 4010);
+    EXPECT_EQ(datagram.payload, (std::vector<uint8_t>{1, 2, 3}));
+    const uint8_t* source = reinterpret_cast<const uint8_t*>(&datagram.source_address);
+    EXPECT_EQ(source[0], 10);
+    EXPECT_EQ(source[3], 7);
+    EXPECT_FALSE(reader.next(datagram));
+}
+
+TEST(PcapReaderTest, ReadsPcapngBlocksAndSkipsNonUdp) {
+    Bytes file;
+    // Section header
+    Bytes shb;
+    shb.u32(0x1A2B3C4D); shb.u16(1); shb.u16(0);
+    shb.u32(0xFFFFFFFF); shb.u32(0xFFFFFFFF);
+    pcapng_block(file, 0x0A0D0D0A, shb.data);
+    // Interface: Ethernet with nanosecond resolution
+    Bytes idb;
+    idb.u16(1); idb.u16(0); idb.u32(65535);
+    idb.u16(9); idb.u16(1); idb.u8(9); idb.pad4();
+    idb.u16(0); idb.u16(0);
+    pcapng_block(file, 1, idb.data);
+
+    auto enhanced = [&](uint64_t ticks, const std::vector<uint8_t>& frame) {
+        Bytes epb;
+        epb.u32(0); epb.u32(static_cast<uint32_t>(ticks >> 32)); epb.u32(static_cast<uint32_t>(ticks));
+        epb.u32(static_cast<uint32_t>(frame.size())); epb.u32(static_cast<uint32_t>(frame.size()));
+        epb.append(frame); epb.pad4();
+        pcapng_block(file, 6, epb.data);
+    };
+    enhanced(5000000000ull, ethernet(ipv4_udp(1000, 16401, {9, 9}), true));
+    enhanced(5000000100ull, ethernet(ipv4_udp(1000, 16401, {8}, 6), false));            // TCP
+    enhanced(5000000200ull, ethernet(ipv4_udp(1000, 16401, {7}, 17, 0x2000), false));   // fragment
+    Bytes spb;
+    const auto simple_frame = ethernet(ipv4_udp(1001, 40000, {1, 2, 3, 4, 5}), false);
+    spb.u32(static_cast<uint32_t>(simple_frame.size()));
+    spb.append(simple_frame);
+    pcapng_block(file, 3, spb.data);
+
+    PcapReader reader(write_temp("blocks.pcapng", file.data));
+    EXPECT_TRUE(reader.is_pcapng());
+
+    PcapUdpDatagram datagram;
+    ASSERT_TRUE(reader.next(datagram));
+    EXPECT_EQ(datagram.timestamp, std::chrono::seconds(5));
+    EXPECT_EQ(datagram.destination_port, 16401);
+    EXPECT_EQ(datagram.payload, (std::vector<uint8_t>{9, 9}));
+
+    ASSERT_TRUE(reader.next(datagram));
+    EXPECT_EQ(datagram.destination_port, 40000);
+    EXPECT_EQ(datagram.payload.size(), 5u);
+    EXPECT_EQ(datagram.timestamp, std::chrono::nanoseconds(5000000200ull));
+    EXPECT_EQ(reader.records_skipped(), 2u);
+    EXPECT_FALSE(reader.next(datagram));
+
+    reader.rewind();
+    ASSERT_TRUE(reader.next(datagram));
+    EXPECT_EQ(datagram.payload, (std::vector<uint8_t>{9, 9}));
+}
+
+TEST(PcapReaderTest, RejectsFilesThatAreNotCaptures) {
+    EXPECT_THROW(PcapReader(write_temp("not_a_capture.bin", {'h', 'e', 'l', 'l', 'o', 0, 0, 0})), std::runtime_error);
+    EXPECT_THROW(PcapReader(::testing::TempDir() + "missing.pcap"), std::runtime_error);
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "utils/profiler.h"
+#include "utils/realtime_scope.h"
+#include "realtime_checker.h"
+
+using screamrouter::audio::utils::FunctionProfiler;
+using screamrouter::audio::testing::rt_checker_active;
+using screamrouter::audio::testing::rt_reset_violations;
+using screamrouter::audio::testing::rt_violation_count;
+
+namespace {
+
+FunctionProfiler::Stats find_stats(const std::string& name) {
+    for (const auto& [entry_name, stats] : FunctionProfiler::instance().snapshot()) {
+        if (entry_name == name) {
+            return stats;
+        }
+    }
+    return {};
+}
+
+void profiled_work() {
+    PROFILE_SCOPE("profiler_test_work");
+}
+
+class FunctionProfilerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        FunctionProfiler::instance().set_enabled(true);
+        FunctionProfiler::instance().set_sample_interval(1);
+    }
+    void TearDown() override {
+        FunctionProfiler::instance().set_enabled(true);
+        FunctionProfiler::instance().set_sample_interval(1);
+    }
+};
+
+} // namespace
+
+TEST_F(FunctionProfilerTest, AggregatesAcrossThreads) {
+    constexpr int kThreads = 4;
+    constexpr int kCalls = 1000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([]() {
+            for (int i = 0; i < kCalls; ++i) {
+                profiled_work();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    // The worker threads have exited; their counts must survive in the retired totals.
+    EXPECT_EQ(find_stats("profiler_test_work").count, static_cast<uint64_t>(kThreads * kCalls));
+}
+
+TEST_F(FunctionProfilerTest, ResetClearsLiveAndRetiredCounts) {
+    profiled_work();
+    std::thread([]() { profiled_work(); }).join();
+    EXPECT_EQ(find_stats("profiler_test_work").count, 2u);
+
+    FunctionProfiler::instance().reset();
+    EXPECT_EQ(find_stats("profiler_test_work").count, 0u);
+
+    profiled_work();
+    EXPECT_EQ(find_stats("profiler_test_work").count, 1u);
+}
+
+TEST_F(FunctionProfilerTest, DisabledProfilerRecordsNothing) {
+    FunctionProfiler::instance().set_enabled(false);
+    for (int i = 0; i < 10; ++i) {
+        profiled_work();
+    }
+    EXPECT_EQ(find_stats("profiler_test_work").count, 0u);
+}
+
+TEST_F(FunctionProfilerTest, SamplingScalesCounts) {
+    FunctionProfiler::instance().set_sample_interval(8);
+    for (int i = 0; i < 64; ++i) {
+        profiled_work();
+    }
+    EXPECT_EQ(find_stats("profiler_test_work").count, 64u);
+}
+
+TEST_F(FunctionProfilerTest, SitesWithTheSameNameAreMerged) {
+    { PROFILE_SCOPE("profiler_test_merged"); }
+    { PROFILE_SCOPE("profiler_test_merged"); }
+    EXPECT_EQ(find_stats("profiler_test_merged").count, 2u);
+}
+
+namespace {
+
+// Runs profiled_work() inside SR_RT_SCOPE on a fresh thread and returns the violations it caused.
+uint64_t realtime_violations_on_new_thread(bool attach_first) {
+    uint64_t violations = 0;
+    std::thread([&violations, attach_first]() {
+        if (attach_first) {
+            FunctionProfiler::instance().attach_current_thread();
+        }
+        rt_reset_violations();
+        {
+            SR_RT_SCOPE("profiler_test_thread");
+            profiled_work();
+        }
+        violations = rt_violation_count();
+    }).join();
+    return violations;
+}
+
+} // namespace
+
+TEST_F(FunctionProfilerTest, AttachedThreadRecordsWithoutAllocating) {
+    ASSERT_TRUE(rt_checker_active());
+    profiled_work(); // register the site outside the scope
+    EXPECT_EQ(realtime_violations_on_new_thread(true), 0u);
+    EXPECT_EQ(find_stats("profiler_test_work").count, 2u);
+}
+
+TEST_F(FunctionProfilerTest, UnattachedThreadAllocatesOnFirstRecord) {
+    ASSERT_TRUE(rt_checker_active());
+    profiled_work();
+    EXPECT_GT(realtime_violations_on_new_thread(false), 0u);
+}
@@ -0,0 +1,220 @@
+/**
+ * Tests for the server side of the PulseAudio srbchannel.
+ * The client half below is a direct model of libpulse's srbchannel/ringbuffer/fdsem code
+ * operating on its own mapping of the memfd, so layout or handshake drift shows up here.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include <poll.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "receivers/pulse/pulse_srbchannel.h"
+
+using screamrouter::audio::pulse::SrbChannel;
+
+namespace {
+
+struct ClientSem {
+    int32_t waiting;
+    int32_t signalled;
+    int32_t in_pipe;
+};
+
+struct ClientHeader {
+    int32_t read_count;
+    int32_t write_count;
+    ClientSem read_semdata;
+    ClientSem write_semdata;
+    int32_t capacity;
+    int32_t readbuf_offs;
+    int32_t writebuf_offs;
+};
+
+// libpulse's view after pa_srbchannel_swap(): it writes the server's read ring and reads the
+// server's write ring.
+class FakeClient {
+public:
+    explicit FakeClient(const SrbChannel& server) : size_(server.block_size()) {
+        void* mapped = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, server.memfd(), 0);
+        EXPECT_NE(mapped, MAP_FAILED);
+        base_ = static_cast<uint8_t*>(mapped);
+        server_read_efd_ = server.read_eventfd();
+    }
+    ~FakeClient() { ::munmap(base_, size_); }
+
+    ClientHeader* header() { return reinterpret_cast<ClientHeader*>(base_); }
+
+    size_t write(const uint8_t* data, size_t length) {
+        ClientHeader* h = header();
+        size_t total = 0;
+        while (total < length) {
+            const int used = __atomic_load_n(&h->read_count, __ATOMIC_SEQ_CST);
+            const size_t count = std::min({static_cast<size_t>(h->capacity - write_index_),
+                                           static_cast<size_t>(h->capacity - used), length - total});
+            if (count == 0) {
+                break;
+            }
+            std::memcpy(base_ + h->readbuf_offs + write_index_, data + total, count);
+            __atomic_fetch_add(&h->read_count, static_cast<int>(count), __ATOMIC_SEQ_CST);
+            write_index_ = (write_index_ + static_cast<int>(count)) % h->capacity;
+            total += count;
+        }
+        post(h->read_semdata, server_read_efd_);
+        return total;
+    }
+
+    size_t read(uint8_t* out, size_t max_bytes) {
+        ClientHeader* h = header();
+        size_t total = 0;
+        while (total < max_bytes) {
+            const int available = __atomic_load_n(&h->write_count, __ATOMIC_SEQ_CST);
+            const size_t count = std::min({static_cast<size_t>(available),
+                                           static_cast<size_t>(h->capacity - read_index_), max_bytes - total});
+            if (count == 0) {
+                break;
+            }
+            std::memcpy(out + total, base_ + h->writebuf_offs + read_index_, count);
+            __atomic_fetch_sub(&h->write_count, static_cast<int>(count), __ATOMIC_SEQ_CST);
+            read_index_ = (read_index_ + static_cast<int>(count)) % h->capacity;
+            total += count;
+        }
+        return total;
+    }
+
+private:
+    void post(ClientSem& sem, int efd) {
+        int expected = 0;
+        if (__atomic_compare_exchange_n(&sem.signalled, &expected, 1, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) &&
+            __atomic_load_n(&sem.waiting, __ATOMIC_SEQ_CST) > 0) {
+            __atomic_fetch_add(&sem.in_pipe, 1, __ATOMIC_SEQ_CST);
+            const uint64_t one = 1;
+            ASSERT_EQ(::write(efd, &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+        }
+    }
+
+    size_t size_;
+    uint8_t* base_ = nullptr;
+    int server_read_efd_ = -1;
+    int write_index_ = 0;
+    int read_index_ = 0;
+};
+
+bool eventfd_readable(int efd) {
+    pollfd pfd{efd, POLLIN, 0};
+    return ::poll(&pfd, 1, 0) == 1 && (pfd.revents & POLLIN);
+}
+
+std::vector<uint8_t> pattern(size_t length, uint8_t seed) {
+    std::vector<uint8_t> data(length);
+    std::iota(data.begin(), data.end(), seed);
+    return data;
+}
+
+} // namespace
+
+TEST(PulseSrbChannelTest, LayoutMatchesLibpulse) {
+    auto channel = SrbChannel::create();
+    ASSERT_NE(channel, nullptr);
+    FakeClient client(*channel);
+    ClientHeader* h = client.header();
+
+    const int header_bytes = static_cast<int>((sizeof(ClientHeader) + sizeof(void*) - 1) & ~(sizeof(void*) - 1));
+    EXPECT_EQ(h->readbuf_offs, header_bytes);
+    EXPECT_EQ(h->writebuf_offs % static_cast<int>(sizeof(void*)), 0);
+    EXPECT_GE(h->writebuf_offs, h->readbuf_offs + h->capacity);
+    EXPECT_LE(static_cast<size_t>(h->writebuf_offs + h->capacity), channel->block_size());
+    EXPECT_EQ(static_cast<size_t>(h->capacity), channel->capacity());
+    EXPECT_EQ(h->read_count, 0);
+    EXPECT_EQ(h->write_count, 0);
+}
+
+TEST(PulseSrbChannelTest, ClientToServerRoundTrip) {
+    auto channel = SrbChannel::create();
+    ASSERT_NE(channel, nullptr);
+    FakeClient client(*channel);
+
+    const auto sent = pattern(1000, 7);
+    ASSERT_EQ(client.write(sent.data(), sent.size()), sent.size());
+    EXPECT_EQ(channel->readable(), sent.size());
+
+    std::vector<uint8_t> received(sent.size());
+    EXPECT_EQ(channel->read(received.data(), received.size()), sent.size());
+    EXPECT_EQ(received, sent);
+    EXPECT_EQ(channel->readable(), 0u);
+}
+
+TEST(PulseSrbChannelTest, ServerToClientWrapsAroundAndStopsWhenFull) {
+    auto channel = SrbChannel::create(8192);
+    ASSERT_NE(channel, nullptr);
+    FakeClient client(*channel);
+    const size_t cap = channel->capacity();
+
+    // Fill, then go past the end of the ring a few times.
+    const auto big = pattern(cap + 100, 3);
+    EXPECT_EQ(channel->write(big.data(), big.size()), cap);
+
+    std::vector<uint8_t> out(cap);
+    ASSERT_EQ(client.read(out.data(), cap), cap);
+    EXPECT_TRUE(std::equal(out.begin(), out.end(), big.begin()));
+
+    for (int round = 0; round < 5; ++round) {
+        const auto chunk = pattern(cap * 2 / 3, static_cast<uint8_t>(round));
+        ASSERT_EQ(channel->write(chunk.data(), chunk.size()), chunk.size());
+        std::vector<uint8_t> got(chunk.size());
+        ASSERT_EQ(client.read(got.data(), got.size()), chunk.size());
+        EXPECT_EQ(got, chunk);
+    }
+}
+
+TEST(PulseSrbChannelTest, ClientOnlyKicksEventfdWhenServerSleeps) {
+    auto channel = SrbChannel::create();
+    ASSERT_NE(channel, nullptr);
+    FakeClient client(*channel);
+    const uint8_t byte = 0x42;
+
+    // Not armed: the client flips 'signalled' but makes no syscall.
+    client.write(&byte, 1);
+    EXPECT_FALSE(eventfd_readable(channel->read_eventfd()));
+    EXPECT_FALSE(channel->before_poll());  // Already signalled: caller must not sleep.
+
+    uint8_t out = 0;
+    ASSERT_EQ(channel->read(&out, 1), 1u);
+
+    // Armed: the next write must wake the eventfd.
+    ASSERT_TRUE(channel->before_poll());
+    client.write(&byte, 1);
+    EXPECT_TRUE(eventfd_readable(channel->read_eventfd()));
+    channel->after_poll();
+    EXPECT_FALSE(eventfd_readable(channel->read_eventfd()));
+    EXPECT_EQ(client.header()->read_semdata.waiting, 0);
+    EXPECT_EQ(client.header()->read_semdata.in_pipe, 0);
+}
+
+TEST(PulseSrbChannelTest, DrainingFullRingSignalsClient) {
+    auto channel = SrbChannel::create(8192);
+    ASSERT_NE(channel, nullptr);
+    FakeClient client(*channel);
+    const size_t cap = channel->capacity();
+
+    const auto fill = pattern(cap, 1);
+    ASSERT_EQ(client.write(fill.data(), fill.size()), cap);
+    uint8_t extra = 0;
+    EXPECT_EQ(client.write(&extra, 1), 0u);
+
+    // Pretend the client went to sleep waiting for space.
+    ClientHeader* h = client.header();
+    __atomic_store_n(&h->write_semdata.signalled, 0, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&h->write_semdata.waiting, 1, __ATOMIC_SEQ_CST);
+
+    std::vector<uint8_t> out(16);
+    ASSERT_EQ(channel->read(out.data(), out.size()), out.size());
+    EXPECT_TRUE(eventfd_readable(channel->write_eventfd()));
+    EXPECT_EQ(h->write_semdata.signalled, 1);
+    EXPECT_EQ(client.write(&extra, 1), 1u);
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "utils/realtime_scope.h"
+#include "realtime_checker.h"
+
+using namespace screamrouter::audio::testing;
+
+// Not in the anonymous namespace so the symbol survives into the stack report.
+__attribute__((noinline)) void allocate_in_hot_path(std::vector<int>& out) {
+    SR_RT_SCOPE("test_hot_path");
+    out.resize(out.size() + 4096);
+}
+
+namespace {
+
+bool any_frame_contains(const RtViolation& v, const std::string& needle) {
+    for (const auto& frame : v.stack) {
+        if (frame.find(needle) != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+class RealtimeCheckerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(rt_checker_active());
+        rt_reset_violations();
+    }
+};
+
+TEST_F(RealtimeCheckerTest, AllocationOutsideScopeIsIgnored) {
+    auto p = std::make_unique<std::vector<int>>(1024);
+    p.reset();
+    EXPECT_EQ(rt_violation_count(), 0u);
+}
+
+TEST_F(RealtimeCheckerTest, AllocationInsideScopeIsReportedWithStack) {
+    std::vector<int> data;
+    allocate_in_hot_path(data);
+
+    auto violations = rt_take_violations();
+    ASSERT_FALSE(violations.empty());
+    const RtViolation& v = violations.front();
+    EXPECT_EQ(v.kind, RtViolationKind::ALLOCATION);
+    EXPECT_EQ(v.call, "malloc");
+    EXPECT_EQ(v.scope, "test_hot_path");
+    EXPECT_GE(v.bytes, 4096 * sizeof(int));
+    EXPECT_TRUE(any_frame_contains(v, "allocate_in_hot_path"))
+        << rt_format_violations(violations);
+    EXPECT_EQ(rt_violation_count(), 0u);
+}
+
+TEST_F(RealtimeCheckerTest, FreeInsideScopeIsReported) {
+    std::vector<int> data(64);
+    {
+        SR_RT_SCOPE("test_free");
+        data.clear();
+        data.shrink_to_fit();
+    }
+    auto violations = rt_take_violations();
+    ASSERT_EQ(violations.size(), 1u);
+    EXPECT_EQ(violations[0].kind, RtViolationKind::DEALLOCATION);
+}
+
+TEST_F(RealtimeCheckerTest, AllowSuspendsChecking) {
+    {
+        SR_RT_SCOPE("test_allow");
+        SR_RT_ALLOW("test: reviewed exception");
+        std::vector<int> v(256);
+        (void)v;
+    }
+    EXPECT_EQ(rt_violation_count(), 0u);
+}
+
+TEST_F(RealtimeCheckerTest, OnlyContendedLocksAreReported) {
+    std::mutex m;
+    {
+        SR_RT_SCOPE("test_uncontended");
+        std::lock_guard<std::mutex> lock(m);
+    }
+    EXPECT_EQ(rt_violation_count(), 0u);
+
+    std::atomic<bool> holding{false};
+    std::atomic<bool> release{false};
+    std::thread holder([&] {
+        std::lock_guard<std::mutex> lock(m);
+        holding = true;
+        while (!release) {
+            std::this_thread::yield();
+        }
+    });
+    while (!holding) {
+        std::this_thread::yield();
+    }
+    std::thread waiter([&] {
+        SR_RT_SCOPE("test_contended");
+        std::lock_guard<std::mutex> lock(m);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    release = true;
+    holder.join();
+    waiter.join();
+
+    auto violations = rt_take_violations();
+    ASSERT_EQ(violations.size(), 1u);
+    EXPECT_EQ(violations[0].kind, RtViolationKind::MUTEX_WAIT);
+    EXPECT_EQ(violations[0].scope, "test_contended");
+}
+
+TEST_F(RealtimeCheckerTest, SleepInsideScopeIsReported) {
+    {
+        SR_RT_SCOPE("test_sleep");
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+    }
+    auto violations = rt_take_violations();
+    ASSERT_FALSE(violations.empty());
+    EXPECT_EQ(violations[0].kind, RtViolationKind::SYSCALL);
+}
+
+TEST_F(RealtimeCheckerTest, NestedScopesKeepOutermostName) {
+    {
+        SR_RT_SCOPE("outer");
+        {
+            SR_RT_SCOPE("inner");
+            std::vector<int> data(8);
+            (void)data;
+        }
+    }
+    auto violations = rt_take_violations();
+    ASSERT_EQ(violations.size(), 2u);
+    EXPECT_EQ(violations[0].scope, "outer");
+    EXPECT_EQ(violations[1].scope, "outer");
+}
@@ -5,20 +5,6 @@
 #include "receivers/rtp/rtp_reordering_buffer.h"
 #include "receivers/rtp/sap_listener/sap_types.h"
 
-// Mock Logging
-namespace screamrouter::audio::logging {
-    enum class LogLevel { DEBUG, INFO, WARNING, ERR };
-    void log_message(LogLevel level, const char* file, int line, const char* format, ...) {
-        // No-op or print to stdout for debugging
-        // va_list args; ...
-    }
-    const char* get_base_filename(const char* path) { return path; }
-}
-
-#define LOG_CPP_DEBUG(...)
-#define LOG_CPP_WARNING(...)
-#define LOG_CPP_INFO(...)
-
 int main() {
     using namespace screamrouter::audio;
     
@@ -3,14 +3,6 @@
 #include "receivers/rtp/rtp_reordering_buffer.h"
 #include "receivers/rtp/sap_listener/sap_types.h"
 
-// Mock Logging (required since cpp_logger.cpp is not linked)
-namespace screamrouter::audio::logging {
-    enum class LogLevel { DEBUG, INFO, WARNING, ERR };
-    std::atomic<LogLevel> current_log_level{LogLevel::INFO};
-    void log_message(LogLevel, const char*, int, const char*, ...) {}
-    const char* get_base_filename(const char* path) { return path; }
-}
-
 using namespace screamrouter::audio;
 
 class RtpReorderingBufferTest : public ::testing::Test {
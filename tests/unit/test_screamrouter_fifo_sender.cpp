@@ -0,0 +1,116 @@
+/**
+ * Tests for ScreamrouterFifoSender's backpressure: payloads reach the FIFO whole or not at all.
+ */
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "senders/system/screamrouter_fifo_sender.h"
+
+using screamrouter::audio::ScreamrouterFifoSender;
+using screamrouter::audio::SinkMixerConfig;
+
+namespace {
+
+class ScreamrouterFifoSenderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char dir_template[] = "/tmp/sr_fifo_sender_testXXXXXX";
+        ASSERT_NE(::mkdtemp(dir_template), nullptr);
+        dir_ = dir_template;
+        fifo_path_ = dir_ + "/in.test.48000Hz.2ch.16bit.s16_le";
+        ASSERT_EQ(::mkfifo(fifo_path_.c_str(), 0600), 0);
+        reader_fd_ = ::open(fifo_path_.c_str(), O_RDONLY | O_NONBLOCK);
+        ASSERT_GE(reader_fd_, 0);
+
+        config_.sink_id = "fifo-test";
+        config_.output_ip = fifo_path_;
+        config_.output_samplerate = 48000;
+        config_.output_channels = 2;
+        config_.output_bitdepth = 16;
+    }
+
+    void TearDown() override {
+        if (reader_fd_ >= 0) {
+            ::close(reader_fd_);
+        }
+        ::unlink(fifo_path_.c_str());
+        ::rmdir(dir_.c_str());
+    }
+
+    size_t drain() {
+        std::vector<uint8_t> buf(1 << 16);
+        size_t total = 0;
+        ssize_t r;
+        while ((r = ::read(reader_fd_, buf.data(), buf.size())) > 0) {
+            total += static_cast<size_t>(r);
+        }
+        return total;
+    }
+
+    std::string dir_;
+    std::string fifo_path_;
+    int reader_fd_ = -1;
+    SinkMixerConfig config_;
+};
+
+} // namespace
+
+TEST_F(ScreamrouterFifoSenderTest, StalledReaderGetsWholePayloadsAndDropsAreCounted) {
+    ScreamrouterFifoSender sender(config_);
+    ASSERT_TRUE(sender.setup());
+
+    // 1000-byte payloads never divide the pipe size, so a partial write would show up as a remainder.
+    const std::vector<uint8_t> payload(1000, 0x5A);
+    const std::vector<uint32_t> csrcs;
+    for (int i = 0; i < 400; ++i) {
+        sender.send_payload(payload.data(), payload.size(), csrcs);
+    }
+
+    const auto stats = sender.get_stats();
+    ASSERT_GT(stats.pipe_capacity_bytes, 0u);
+    EXPECT_EQ(stats.payloads_written + stats.payloads_dropped, 400u);
+    EXPECT_GT(stats.payloads_dropped, 0u);
+    EXPECT_EQ(stats.bytes_dropped, stats.payloads_dropped * payload.size());
+
+    const size_t delivered = drain();
+    EXPECT_EQ(delivered, stats.payloads_written * payload.size());
+    EXPECT_EQ(delivered % payload.size(), 0u);
+
+    // Once the reader catches up, payloads flow again.
+    sender.send_payload(payload.data(), payload.size(), csrcs);
+    EXPECT_EQ(sender.get_stats().payloads_written, stats.payloads_written + 1);
+    EXPECT_EQ(drain(), payload.size());
+}
+
+TEST_F(ScreamrouterFifoSenderTest, PipeIsSizedForTheConfiguredFormat) {
+    config_.output_samplerate = 192000;
+    config_.output_channels = 8;
+    config_.output_bitdepth = 32;
+    ScreamrouterFifoSender sender(config_);
+    ASSERT_TRUE(sender.setup());
+
+    // 192 kHz x 8 ch x 4 bytes fills a default 64 KiB pipe in under 11 ms; the sender grows
+    // it as far as pipe-max-size allows.
+    const auto stats = sender.get_stats();
+    EXPECT_GT(stats.pipe_capacity_bytes, 65536u);
+}
+
+TEST_F(ScreamrouterFifoSenderTest, NoReaderMeansNothingIsCounted) {
+    ::close(reader_fd_);
+    reader_fd_ = -1;
+    ScreamrouterFifoSender sender(config_);
+    sender.setup();
+
+    const std::vector<uint8_t> payload(512, 1);
+    sender.send_payload(payload.data(), payload.size(), {});
+    const auto stats = sender.get_stats();
+    EXPECT_EQ(stats.payloads_written, 0u);
+    EXPECT_EQ(stats.payloads_dropped, 0u);
+}
@@ -0,0 +1,289 @@
+/**
+ * Tests for the engine side of the ALSA plugin's shared PCM ring.
+ * FakePlugin below follows sr_ring_create()/sr_ring_write() in alsa_plugin/src/pcm_screamrouter.c,
+ * so a layout or handshake change on one side shows up here.
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "receivers/system/screamrouter_shm_ring.h"
+
+using screamrouter::audio::ScreamrouterShmRing;
+using screamrouter::audio::ScreamrouterShmRingHeader;
+
+namespace {
+
+constexpr uint32_t kFrameBytes = 4; // S16_LE stereo
+
+uint64_t monotonic_ns() {
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+class FakePlugin {
+public:
+    FakePlugin(const std::string& ring_path, uint32_t capacity_frames) : path_(ring_path) {
+        const std::string tmp = path_ + ".new";
+        size_ = sizeof(ScreamrouterShmRingHeader) + static_cast<size_t>(capacity_frames) * kFrameBytes;
+        int fd = ::open(tmp.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0660);
+        EXPECT_GE(fd, 0);
+        EXPECT_EQ(::ftruncate(fd, static_cast<off_t>(size_)), 0);
+        void* mapped = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        EXPECT_NE(mapped, MAP_FAILED);
+        h_ = static_cast<ScreamrouterShmRingHeader*>(mapped);
+        h_->magic = ScreamrouterShmRingHeader::kMagic;
+        h_->version = ScreamrouterShmRingHeader::kVersion;
+        h_->data_offset = sizeof(ScreamrouterShmRingHeader);
+        h_->frame_bytes = kFrameBytes;
+        h_->capacity_frames = capacity_frames;
+        h_->rate = 48000;
+        h_->channels = 2;
+        h_->bit_depth = 16;
+        EXPECT_EQ(::rename(tmp.c_str(), path_.c_str()), 0);
+    }
+
+    ~FakePlugin() {
+        ::munmap(h_, size_);
+        ::unlink(path_.c_str());
+    }
+
+    ScreamrouterShmRingHeader* header() { return h_; }
+
+    bool reader_live() const {
+        const uint64_t heartbeat = __atomic_load_n(&h_->reader_heartbeat_ns, __ATOMIC_ACQUIRE);
+        return heartbeat != 0 && monotonic_ns() - heartbeat < ScreamrouterShmRing::kHeartbeatTimeoutNs;
+    }
+
+    size_t write(const uint8_t* src, size_t frames) {
+        uint8_t* data = reinterpret_cast<uint8_t*>(h_) + h_->data_offset;
+        const uint64_t written = h_->write_frames;
+        const uint64_t read = __atomic_load_n(&h_->read_frames, __ATOMIC_ACQUIRE);
+        const size_t space = h_->capacity_frames - static_cast<size_t>(written - read);
+        const size_t count = std::min(frames, space);
+        if (count < frames) {
+            __atomic_add_fetch(&h_->dropped_frames, static_cast<uint64_t>(frames - count), __ATOMIC_RELAXED);
+        }
+        if (count == 0) {
+            return 0;
+        }
+        for (size_t done = 0; done < count;) {
+            const size_t index = static_cast<size_t>((written + done) % h_->capacity_frames);
+            const size_t chunk = std::min<size_t>(h_->capacity_frames - index, count - done);
+            std::memcpy(data + index * kFrameBytes, src + done * kFrameBytes, chunk * kFrameBytes);
+            done += chunk;
+        }
+        __atomic_store_n(&h_->write_time_ns, monotonic_ns(), __ATOMIC_RELEASE);
+        __atomic_store_n(&h_->write_frames, written + count, __ATOMIC_SEQ_CST);
+        __atomic_add_fetch(&h_->doorbell, 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&h_->reader_waiting, __ATOMIC_SEQ_CST)) {
+            ::syscall(SYS_futex, &h_->doorbell, FUTEX_WAKE, 1, nullptr, nullptr, 0);
+        }
+        return count;
+    }
+
+private:
+    std::string path_;
+    size_t size_ = 0;
+    ScreamrouterShmRingHeader* h_ = nullptr;
+};
+
+std::vector<uint8_t> frames_pattern(size_t frames, uint8_t seed) {
+    std::vector<uint8_t> data(frames * kFrameBytes);
+    std::iota(data.begin(), data.end(), seed);
+    return data;
+}
+
+class ScreamrouterShmRingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char dir_template[] = "/tmp/sr_ring_testXXXXXX";
+        ASSERT_NE(::mkdtemp(dir_template), nullptr);
+        dir_ = dir_template;
+        fifo_path_ = dir_ + "/out.test.48000Hz.2ch.16bit.s16_le";
+        ring_path_ = ScreamrouterShmRing::ring_path_for(fifo_path_);
+    }
+
+    void TearDown() override {
+        ::unlink(ring_path_.c_str());
+        ::rmdir(dir_.c_str());
+    }
+
+    std::string dir_;
+    std::string fifo_path_;
+    std::string ring_path_;
+};
+
+} // namespace
+
+TEST_F(ScreamrouterShmRingTest, RingFileIsHiddenNextToFifo) {
+    EXPECT_EQ(ring_path_, dir_ + "/.out.test.48000Hz.2ch.16bit.s16_le.ring");
+}
+
+TEST_F(ScreamrouterShmRingTest, AttachRejectsMissingAndForeignFiles) {
+    std::string error;
+    EXPECT_EQ(ScreamrouterShmRing::attach(ring_path_, &error), nullptr);
+    EXPECT_FALSE(error.empty());
+
+    FILE* f = std::fopen(ring_path_.c_str(), "wb");
+    ASSERT_NE(f, nullptr);
+    const std::vector<uint8_t> junk(4096, 0xAB);
+    std::fwrite(junk.data(), 1, junk.size(), f);
+    std::fclose(f);
+    EXPECT_EQ(ScreamrouterShmRing::attach(ring_path_), nullptr);
+}
+
+TEST_F(ScreamrouterShmRingTest, AttachAnnouncesReaderAndDetachClearsIt) {
+    FakePlugin plugin(ring_path_, 256);
+    EXPECT_FALSE(plugin.reader_live());
+    {
+        auto ring = ScreamrouterShmRing::attach(ring_path_);
+        ASSERT_NE(ring, nullptr);
+        EXPECT_EQ(ring->frame_bytes(), kFrameBytes);
+        EXPECT_EQ(ring->capacity_frames(), 256u);
+        EXPECT_EQ(ring->rate(), 48000u);
+        EXPECT_EQ(plugin.header()->reader_pid, static_cast<uint32_t>(::getpid()));
+        EXPECT_TRUE(plugin.reader_live());
+    }
+    EXPECT_FALSE(plugin.reader_live());
+}
+
+TEST_F(ScreamrouterShmRingTest, ReadsAcrossWrapAndReportsConsumption) {
+    FakePlugin plugin(ring_path_, 100);
+    auto ring = ScreamrouterShmRing::attach(ring_path_);
+    ASSERT_NE(ring, nullptr);
+
+    for (int round = 0; round < 7; ++round) {
+        const auto sent = frames_pattern(64, static_cast<uint8_t>(round * 3));
+        ASSERT_EQ(plugin.write(sent.data(), 64), 64u);
+        EXPECT_EQ(ring->readable_frames(), 64u);
+
+        std::vector<uint8_t> got(sent.size());
+        ASSERT_EQ(ring->read(got.data(), 64), 64u);
+        EXPECT_EQ(got, sent);
+        EXPECT_EQ(plugin.header()->read_frames, static_cast<uint64_t>(64 * (round + 1)));
+    }
+}
+
+TEST_F(ScreamrouterShmRingTest, WriterNeverOverwritesUnreadFrames) {
+    FakePlugin plugin(ring_path_, 100);
+    auto ring = ScreamrouterShmRing::attach(ring_path_);
+    ASSERT_NE(ring, nullptr);
+
+    const auto sent = frames_pattern(150, 1);
+    EXPECT_EQ(plugin.write(sent.data(), 150), 100u);
+    EXPECT_EQ(ring->readable_frames(), 100u);
+
+    size_t frames = 1000;
+    const uint8_t* view = ring->peek(frames);
+    ASSERT_EQ(frames, 100u);
+    EXPECT_EQ(std::memcmp(view, sent.data(), 100 * kFrameBytes), 0);
+    ring->consume(40);
+    EXPECT_EQ(plugin.write(sent.data(), 150), 40u);
+}
+
+TEST_F(ScreamrouterShmRingTest, ReaderSeesFramesDroppedOnAFullRing) {
+    FakePlugin plugin(ring_path_, 100);
+    auto ring = ScreamrouterShmRing::attach(ring_path_);
+    ASSERT_NE(ring, nullptr);
+    EXPECT_EQ(ring->dropped_frames(), 0u);
+
+    const auto sent = frames_pattern(150, 1);
+    EXPECT_EQ(plugin.write(sent.data(), 150), 100u);
+    EXPECT_EQ(ring->dropped_frames(), 50u);
+    EXPECT_EQ(plugin.write(sent.data(), 20), 0u);
+    EXPECT_EQ(ring->dropped_frames(), 70u);
+
+    ring->consume(100);
+    EXPECT_EQ(plugin.write(sent.data(), 20), 20u);
+    EXPECT_EQ(ring->dropped_frames(), 70u);
+}
+
+TEST_F(ScreamrouterShmRingTest, AttachStartsAtTheLiveEdge) {
+    FakePlugin plugin(ring_path_, 100);
+    const auto stale = frames_pattern(30, 9);
+    plugin.write(stale.data(), 30);
+
+    auto ring = ScreamrouterShmRing::attach(ring_path_);
+    ASSERT_NE(ring, nullptr);
+    EXPECT_EQ(ring->readable_frames(), 0u);
+    EXPECT_EQ(ring->read_position(), 30u);
+}
+
+TEST_F(ScreamrouterShmRingTest, DoorbellWakesSleepingReader) {
+    FakePlugin plugin(ring_path_, 4096);
+    auto ring = ScreamrouterShmRing::attach(ring_path_);
+    ASSERT_NE(ring, nullptr);
+
+    // Nothing published: the wait times out.
+    const auto idle_start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(ring->wait(1, 30));
+    EXPECT_GE(std::chrono::steady_clock::now() - idle_start, std::chrono::milliseconds(20));
+    EXPECT_EQ(plugin.header()->reader_waiting, 0u);
+
+    std::atomic<bool> woke{false};
+    std::thread reader([&] { woke = ring->wait(1024, 5000); });
+    // Let the reader go to sleep, then publish in two steps; only the second satisfies it.
+    while (__atomic_load_n(&plugin.header()->reader_waiting, __ATOMIC_SEQ_CST) == 0) {
+        std::this_thread::yield();
+    }
+    const auto sent = frames_pattern(512, 0);
+    const auto publish_start = std::chrono::steady_clock::now();
+    plugin.write(sent.data(), 512);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    plugin.write(sent.data(), 512);
+    reader.join();
+    EXPECT_LT(std::chrono::steady_clock::now() - publish_start, std::chrono::seconds(1));
+    // The first publish wakes the reader early; a caller loops until its chunk is ready.
+    while (!woke) {
+        woke = ring->wait(1024, 1000);
+    }
+    EXPECT_EQ(ring->readable_frames(), 1024u);
+}
+
+TEST_F(ScreamrouterShmRingTest, FrameTimesFollowTheWriterClock) {
+    FakePlugin plugin(ring_path_, 48000);
+    auto ring = ScreamrouterShmRing::attach(ring_path_);
+    ASSERT_NE(ring, nullptr);
+
+    const auto sent = frames_pattern(4800, 0);
+    plugin.write(sent.data(), 4800);
+    const auto now = std::chrono::steady_clock::now();
+
+    // 4800 frames at 48 kHz: the first frame was written 100 ms before the publish point.
+    const auto first = ring->time_of_frame(0);
+    const auto last = ring->time_of_frame(4800);
+    const auto span = std::chrono::duration_cast<std::chrono::milliseconds>(last - first);
+    EXPECT_NEAR(static_cast<double>(span.count()), 100.0, 2.0);
+    EXPECT_LE(last, now + std::chrono::milliseconds(1));
+}
+
+TEST_F(ScreamrouterShmRingTest, ReplacedRingOrphansTheOldMapping) {
+    FakePlugin plugin(ring_path_, 64);
+    auto ring = ScreamrouterShmRing::attach(ring_path_);
+    ASSERT_NE(ring, nullptr);
+    EXPECT_FALSE(ring->is_orphaned());
+
+    // A reopened stream renames a fresh file over the old one.
+    FakePlugin reopened(ring_path_, 64);
+    EXPECT_TRUE(ring->is_orphaned());
+    auto fresh = ScreamrouterShmRing::attach(ring_path_);
+    ASSERT_NE(fresh, nullptr);
+    EXPECT_FALSE(fresh->is_orphaned());
+}
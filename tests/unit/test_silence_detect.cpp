@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+#include "audio_processor/silence_detect.h"
+
+using screamrouter::audio::is_digital_silence;
+
+TEST(SilenceDetect, EmptyBufferIsSilent) {
+    EXPECT_TRUE(is_digital_silence(static_cast<const uint8_t*>(nullptr), 0));
+}
+
+TEST(SilenceDetect, AllZeroBuffersAreSilent) {
+    // Sizes around the 64-byte vector block and the 8-byte scalar word.
+    for (size_t bytes : {size_t{1}, size_t{7}, size_t{8}, size_t{63}, size_t{64}, size_t{65}, size_t{1152}, size_t{4099}}) {
+        std::vector<uint8_t> buffer(bytes, 0);
+        EXPECT_TRUE(is_digital_silence(buffer.data(), buffer.size())) << "bytes=" << bytes;
+    }
+}
+
+TEST(SilenceDetect, SingleNonZeroByteAnywhereIsDetected) {
+    const size_t bytes = 1152 + 13;
+    std::vector<uint8_t> buffer(bytes + 1, 0);
+    // Offset by one so the vector loads are unaligned.
+    uint8_t* data = buffer.data() + 1;
+    for (size_t pos = 0; pos < bytes; ++pos) {
+        data[pos] = 0x01;
+        ASSERT_FALSE(is_digital_silence(data, bytes)) << "pos=" << pos;
+        data[pos] = 0;
+    }
+    EXPECT_TRUE(is_digital_silence(data, bytes));
+}
+
+TEST(SilenceDetect, Int32Overload) {
+    std::vector<int32_t> samples(960, 0);
+    EXPECT_TRUE(is_digital_silence(samples.data(), samples.size()));
+    samples[959] = -1;
+    EXPECT_FALSE(is_digital_silence(samples.data(), samples.size()));
+    // Only the requested count is inspected.
+    EXPECT_TRUE(is_digital_silence(samples.data(), samples.size() - 1));
+}
@@ -8,9 +8,11 @@
 #include <chrono>
 #include <thread>
 #include <atomic>
+#include <algorithm>
 
 #include "output_mixer/sink_rate_controller.h"
 #include "configuration/audio_engine_settings.h"
+#include "utils/audio_clock.h"
 
 using namespace screamrouter::audio;
 using namespace std::chrono;
@@ -230,6 +232,47 @@ TEST_F(SinkRateControllerTest, RateAdjustmentCallback_LowBuffer) {
     EXPECT_GE(controller->get_smoothed_buffer_level_ms(), 0.0);
 }
 
+// ============================================================================
+// Convergence Tests
+// ============================================================================
+
+TEST_F(SinkRateControllerTest, ClosedLoopBacklogConvergesToTarget) {
+    // The source plays back faster by the commanded ratio, so each measurement interval
+    // drains (ratio - 1) * interval of backlog. Time is virtual so every call is measured.
+    screamrouter::audio::utils::VirtualClock clock;
+    screamrouter::audio::utils::ScopedVirtualClock clock_scope(clock);
+    settings->mixer_tuning.enable_adaptive_buffer_drain = true;
+    settings->mixer_tuning.buffer_tolerance_ms = 10.0;
+    const double interval_ms = settings->mixer_tuning.buffer_measurement_interval_ms;
+    const double block_ms = 5.0;
+    const double upper_band_ms = settings->mixer_tuning.target_buffer_level_ms +
+                                 settings->mixer_tuning.buffer_tolerance_ms;
+
+    auto controller = make_controller();
+    double ratio = 1.0;
+    double max_ratio = 1.0;
+    int commands = 0;
+    controller->set_rate_command_callback([&](const std::string&, double r) {
+        ratio = r;
+        max_ratio = std::max(max_ratio, r);
+        ++commands;
+    });
+
+    double backlog_ms = 150.0;
+    for (int i = 0; i < 1000; ++i) {
+        clock.advance(duration_cast<nanoseconds>(duration<double, std::milli>(interval_ms)));
+        auto metrics = make_metrics(backlog_ms, 1, block_ms);
+        controller->update_drain_ratio(48000, 240, [&metrics]() { return metrics; });
+        backlog_ms -= (ratio - 1.0) * interval_ms;
+    }
+
+    EXPECT_GT(max_ratio, 1.0);
+    EXPECT_LE(max_ratio, settings->mixer_tuning.max_speedup_factor);
+    EXPECT_DOUBLE_EQ(ratio, 1.0) << "controller never settled after " << commands << " commands";
+    EXPECT_LE(backlog_ms, upper_band_ms);
+    EXPECT_GT(backlog_ms, settings->mixer_tuning.target_buffer_level_ms - block_ms);
+}
+
 // ============================================================================
 // Thread Safety Tests
 // ============================================================================
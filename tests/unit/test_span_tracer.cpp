@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "utils/span_tracer.h"
+
+using screamrouter::audio::utils::SpanTracer;
+
+namespace {
+
+std::string dump_to_string(const std::string& name) {
+    const std::string path = ::testing::TempDir() + name;
+    EXPECT_TRUE(SpanTracer::instance().dump(path));
+    std::ifstream in(path);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    std::remove(path.c_str());
+    return contents.str();
+}
+
+size_t count_occurrences(const std::string& haystack, const std::string& needle) {
+    size_t count = 0;
+    for (size_t pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+TEST(SpanTracerTest, DisabledTracerRecordsNothing) {
+    SpanTracer::instance().stop();
+    EXPECT_EQ(SpanTracer::instance().next_flow_id(), 0u);
+    SpanTracer::instance().start();
+    SpanTracer::instance().stop();
+    {
+        SR_TRACE_SPAN("disabled_span");
+    }
+    const std::string json = dump_to_string("span_tracer_disabled.json");
+    EXPECT_EQ(json.find("disabled_span"), std::string::npos);
+    EXPECT_NE(json.find("\"traceEvents\""), std::string::npos);
+}
+
+TEST(SpanTracerTest, FlowLinksSpansAcrossThreads) {
+    SpanTracer::instance().start();
+    const uint64_t flow = SpanTracer::instance().next_flow_id();
+    ASSERT_NE(flow, 0u);
+    {
+        SR_TRACE_SPAN_FLOW("produce", flow);
+    }
+    std::thread consumer([flow] {
+        SR_TRACE_SPAN("consume");
+        SR_TRACE_FLOW(flow);
+    });
+    consumer.join();
+    SpanTracer::instance().stop();
+
+    const std::string json = dump_to_string("span_tracer_flow.json");
+    EXPECT_EQ(count_occurrences(json, "\"name\":\"produce\""), 1u);
+    EXPECT_EQ(count_occurrences(json, "\"name\":\"consume\""), 1u);
+    EXPECT_EQ(count_occurrences(json, "\"ph\":\"s\""), 1u);
+    EXPECT_EQ(count_occurrences(json, "\"ph\":\"f\""), 1u);
+    EXPECT_EQ(count_occurrences(json, "\"id\":" + std::to_string(flow) + ","), 2u);
+    EXPECT_NE(json.find("\"thread_name\""), std::string::npos);
+}
+
+TEST(SpanTracerTest, RingKeepsOnlyNewestEvents) {
+    SpanTracer::instance().start(64);
+    std::thread writer([] {
+        for (int i = 0; i < 1000; ++i) {
+            SR_TRACE_SPAN("burst");
+        }
+    });
+    writer.join();
+    SpanTracer::instance().stop();
+
+    const std::string json = dump_to_string("span_tracer_ring.json");
+    EXPECT_EQ(count_occurrences(json, "\"name\":\"burst\""), 64u);
+}
+
+TEST(SpanTracerTest, NewSessionHidesOlderEvents) {
+    SpanTracer::instance().start();
+    {
+        SR_TRACE_SPAN("old_session");
+    }
+    SpanTracer::instance().start();
+    {
+        SR_TRACE_SPAN("new_session");
+    }
+    SpanTracer::instance().stop();
+
+    const std::string json = dump_to_string("span_tracer_session.json");
+    EXPECT_EQ(json.find("old_session"), std::string::npos);
+    EXPECT_NE(json.find("new_session"), std::string::npos);
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <utility>
+#include <vector>
+#include "audio_processor/speaker_mix_kernels.h"
+
+using screamrouter::audio::SpeakerMixKernel;
+using screamrouter::audio::select_speaker_mix_kernel;
+
+class SpeakerMixKernelsTest : public ::testing::TestWithParam<std::pair<int, int>> {
+protected:
+    // Reference mix: same result the generic tap walk in AudioProcessor::mixSpeakers produces.
+    static std::vector<float> reference_mix(const std::vector<float>& in, int in_ch, int out_ch,
+                                            size_t frames, const std::vector<float>& gains) {
+        std::vector<float> out(frames * out_ch, 0.0f);
+        for (size_t f = 0; f < frames; ++f) {
+            for (int oc = 0; oc < out_ch; ++oc) {
+                float acc = 0.0f;
+                for (int ic = 0; ic < in_ch; ++ic) {
+                    acc += in[f * in_ch + ic] * gains[oc * in_ch + ic];
+                }
+                out[f * out_ch + oc] = acc;
+            }
+        }
+        return out;
+    }
+
+    static std::vector<float> random_vector(size_t n, std::mt19937& rng) {
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+        std::vector<float> v(n);
+        for (auto& x : v) {
+            x = dist(rng);
+        }
+        return v;
+    }
+};
+
+TEST_P(SpeakerMixKernelsTest, MatchesReferenceMix) {
+    const int in_ch = GetParam().first;
+    const int out_ch = GetParam().second;
+    SpeakerMixKernel kernel = select_speaker_mix_kernel(in_ch, out_ch);
+    ASSERT_NE(kernel, nullptr);
+
+    std::mt19937 rng(1234);
+    // Odd frame counts exercise the scalar tails of the vectorized kernels.
+    for (size_t frames : {size_t{0}, size_t{1}, size_t{3}, size_t{7}, size_t{480}, size_t{1023}}) {
+        const auto gains = random_vector(static_cast<size_t>(in_ch * out_ch), rng);
+        const auto in = random_vector(frames * in_ch, rng);
+        std::vector<float> out(frames * out_ch + 4, 123.0f);
+
+        kernel(in.data(), out.data(), frames, gains.data());
+
+        const auto expected = reference_mix(in, in_ch, out_ch, frames, gains);
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_NEAR(out[i], expected[i], 1e-5f) << "frames=" << frames << " sample=" << i;
+        }
+        // Kernels must not write past the last frame.
+        for (size_t i = expected.size(); i < out.size(); ++i) {
+            EXPECT_EQ(out[i], 123.0f);
+        }
+    }
+}
+
+TEST_P(SpeakerMixKernelsTest, OverwritesPreviousOutput) {
+    const int in_ch = GetParam().first;
+    const int out_ch = GetParam().second;
+    SpeakerMixKernel kernel = select_speaker_mix_kernel(in_ch, out_ch);
+    ASSERT_NE(kernel, nullptr);
+
+    const size_t frames = 16;
+    std::vector<float> in(frames * in_ch, 0.0f);
+    std::vector<float> gains(static_cast<size_t>(in_ch * out_ch), 1.0f);
+    std::vector<float> out(frames * out_ch, 5.0f);
+
+    kernel(in.data(), out.data(), frames, gains.data());
+
+    for (float s : out) {
+        EXPECT_EQ(s, 0.0f);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SpecializedPairs,
+    SpeakerMixKernelsTest,
+    ::testing::Values(std::make_pair(1, 2), std::make_pair(2, 2), std::make_pair(2, 6),
+                      std::make_pair(2, 8), std::make_pair(6, 2), std::make_pair(8, 2),
+                      std::make_pair(8, 8)));
+
+TEST(SpeakerMixKernelSelection, UnsupportedPairsUseGenericPath) {
+    EXPECT_EQ(select_speaker_mix_kernel(2, 4), nullptr);
+    EXPECT_EQ(select_speaker_mix_kernel(4, 2), nullptr);
+    EXPECT_EQ(select_speaker_mix_kernel(6, 6), nullptr);
+    EXPECT_EQ(select_speaker_mix_kernel(0, 2), nullptr);
+}
+
+TEST(SpeakerMixKernelSelection, DownmixSevenOneToStereo) {
+    SpeakerMixKernel kernel = select_speaker_mix_kernel(8, 2);
+    ASSERT_NE(kernel, nullptr);
+
+    // FL FR C LFE BL BR SL SR, standard-ish downmix coefficients.
+    const float l_row[8] = {1.0f, 0.0f, 0.707f, 0.0f, 0.707f, 0.0f, 0.707f, 0.0f};
+    const float r_row[8] = {0.0f, 1.0f, 0.707f, 0.0f, 0.0f, 0.707f, 0.0f, 0.707f};
+    std::vector<float> gains(l_row, l_row + 8);
+    gains.insert(gains.end(), r_row, r_row + 8);
+
+    const float frame[8] = {0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f, 0.7f, 0.8f};
+    float out[2] = {};
+    kernel(frame, out, 1, gains.data());
+
+    EXPECT_NEAR(out[0], 0.1f + 0.707f * (0.3f + 0.5f + 0.7f), 1e-5f);
+    EXPECT_NEAR(out[1], 0.2f + 0.707f * (0.3f + 0.6f + 0.8f), 1e-5f);
+}